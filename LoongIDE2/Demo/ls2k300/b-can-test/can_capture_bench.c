@@ -0,0 +1,163 @@
+/*
+ * can_capture_bench.c
+ *
+ * created: 2026-10-17
+ *  author:
+ */
+
+/*
+ * CAN capture ٶȲ.
+ *
+ * ʹܵ CAN  1Mbps, DMA , д capture ring;
+ * ѭ ls2k_can_capture_claim()/release() ֱӶȡ¼, ͳÿ뱨,
+ * ı, ԼʱǷ.
+ *
+ * ⲿ豸ط.  4 ·ʱ bsp.h д BSP_USE_CAN2/3.
+ */
+
+#include "bsp.h"
+
+#if TEST_CAN_CAPTURE_BENCH && BSP_USE_CAN
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ls2k_can.h"
+
+#define BENCH_SECONDS       10
+#define BENCH_RING_COUNT    2048                    // ÿ· capture ring ¼
+#define BENCH_CLAIM_MAX     256
+
+typedef struct
+{
+    const void   *dev;
+    unsigned int  frames;
+    unsigned int  bytes;
+    unsigned int  ts_errors;                        // ʱûе
+    unsigned int  last_ts;
+    CANCapture_t  ring[BENCH_RING_COUNT];
+} can_bench_t;
+
+static can_bench_t can_bench[4];
+
+static int can_bench_start(can_bench_t *cb, const void *dev)
+{
+    CAN_capture_t cap;
+
+    memset(cb, 0, sizeof(can_bench_t) - sizeof(cb->ring));
+    cb->dev = dev;
+
+    ls2k_can_init(dev, NULL);
+
+    ls2k_can_ioctl(dev, IOCTL_CAN_SET_BAUDRATE, (void *)CAN_SPEED_1M);
+    ls2k_can_ioctl(dev, IOCTL_CAN_SET_WORKMODE, (void *)CAN_MODE_RX_DMA);
+
+    cap.ring  = cb->ring;
+    cap.count = BENCH_RING_COUNT;
+    if (ls2k_can_ioctl(dev, IOCTL_CAN_SET_CAPTURE, &cap) != 0)
+    {
+        printk("%s: set capture fail\r\n", ls2k_can_get_device_name(dev));
+        return -1;
+    }
+
+    return ls2k_can_open(dev, NULL);
+}
+
+static void can_bench_stop(can_bench_t *cb)
+{
+    ls2k_can_close(cb->dev, NULL);
+    ls2k_can_ioctl(cb->dev, IOCTL_CAN_SET_CAPTURE, NULL);
+}
+
+/*
+ * ȡеļ¼, ؼ¼
+ */
+static int can_bench_poll(can_bench_t *cb)
+{
+    CANCapture_t *recs;
+    int i, n, total = 0;
+
+    while ((n = ls2k_can_capture_claim(cb->dev, &recs, BENCH_CLAIM_MAX, 0)) > 0)
+    {
+        for (i=0; i<n; i++)
+        {
+            if ((cb->frames > 0) && (recs[i].timestamp < cb->last_ts))
+                cb->ts_errors++;
+
+            cb->last_ts = recs[i].timestamp;
+            cb->bytes += recs[i].len;
+            cb->frames++;
+        }
+
+        ls2k_can_capture_release(cb->dev, n);
+        total += n;
+    }
+
+    return total;
+}
+
+void can_capture_bench(void)
+{
+    const void *devs[4];
+    int i, count = 0;
+    unsigned int start, ms;
+
+#if BSP_USE_CAN0
+    devs[count++] = devCAN0;
+#endif
+#if BSP_USE_CAN1
+    devs[count++] = devCAN1;
+#endif
+#if BSP_USE_CAN2
+    devs[count++] = devCAN2;
+#endif
+#if BSP_USE_CAN3
+    devs[count++] = devCAN3;
+#endif
+
+    for (i=0; i<count; i++)
+    {
+        if (can_bench_start(&can_bench[i], devs[i]) != 0)
+        {
+            printk("%s: open fail\r\n", ls2k_can_get_device_name(devs[i]));
+            return;
+        }
+    }
+
+    printk("CAN capture bench, %i controllers @ 1Mbps, %i s ...\r\n", count, BENCH_SECONDS);
+
+    start = get_clock_ticks();
+    while ((ms = get_clock_ticks() - start) < BENCH_SECONDS * 1000)
+    {
+        for (i=0; i<count; i++)
+            can_bench_poll(&can_bench[i]);
+    }
+
+    for (i=0; i<count; i++)
+    {
+        can_bench_t *cb = &can_bench[i];
+        CAN_stats_t *st = NULL;
+
+        can_bench_poll(cb);
+        ls2k_can_ioctl(cb->dev, IOCTL_CAN_GET_STATS, &st);
+
+        printk("%s: %6u frames/s, %7u bytes/s, dropped %u, hw overrun %u, dma err %u, ts err %u\r\n",
+               ls2k_can_get_device_name(cb->dev),
+               (unsigned int)((unsigned long)cb->frames * 1000 / ms),
+               (unsigned int)((unsigned long)cb->bytes * 1000 / ms),
+               st ? st->rx_cap_dropped : 0,
+               st ? st->err_dover : 0,
+               st ? st->rxbuf_errors : 0,
+               cb->ts_errors);
+
+        can_bench_stop(cb);
+    }
+}
+
+#endif // #if TEST_CAN_CAPTURE_BENCH && BSP_USE_CAN
+
+//-----------------------------------------------------------------------------
+/*
+ * @@ END
+ */
+
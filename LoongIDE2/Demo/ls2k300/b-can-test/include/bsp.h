@@ -124,6 +124,16 @@ extern unsigned apb_frequency;
 
 #define BSP_USE_CAN     (BSP_USE_CAN0 || BSP_USE_CAN1 || BSP_USE_CAN2 || BSP_USE_CAN3)
 
+/*
+ * CAN capture ٶȲ,  can_capture_bench.c
+ */
+#define TEST_CAN_CAPTURE_BENCH  0
+
+/*
+ * CAN  DMA Դ, libbsp.a û trace.c
+ */
+#define BSP_USE_TRACE   0
+
 /**
  * GMAC
  */
@@ -0,0 +1,2501 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_can.c
+ *
+ * created: 2024-08-09
+ *  author: Bian
+ */
+
+#include "bsp.h"
+
+#if BSP_USE_CAN
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <larchintrin.h>
+
+#include "cpu.h"
+#include "ls2k300.h"
+#include "ls2k300_irq.h"
+
+#include "osal.h"
+ 
+#include "ls2k_drv_io.h"
+#include "drv_os_priority.h"
+
+#include "ls2k_can.h"
+#include "ls2k_can_hw.h"
+#include "ls2k_trace.h"
+
+#if CAN_USE_DMA
+#include "ls2k_dma.h"
+
+extern void *aligned_malloc(size_t size, unsigned int align);
+#endif
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+#define CAN_DEBUG       0
+
+#if CAN_DEBUG
+#define debug_prt(...)  printk(__VA_ARGS__)
+#else
+#define debug_prt(...)  do { } while (0)
+#endif
+
+/*
+ * Default RX/TX timeout ms
+ */
+#define RXTX_TIMEOUT 	100
+
+//-----------------------------------------------------------------------------
+// CAN SPEED - calculate from baudrate
+//-----------------------------------------------------------------------------
+
+typedef struct
+{
+    union
+    {
+        struct                      /* ӦüĴ */
+        {
+            unsigned int prop :7;   /* RW bit[6:0] ο */
+            unsigned int ph1 :6;    /* RW bit[12:7] λ1  */
+            unsigned int ph2 :6;    /* RW bit[18:13] λ2  */
+            unsigned int brp :8;    /* RW bit[26:19] λԤƵϵ */
+            unsigned int sjw :5;    /* RW bit[31:27] ͬ */
+        };
+        unsigned int btr32;
+    };
+
+    unsigned int frac;             /* λСƵϵ. */
+    int Sample_pt;                 /* ٷֱ % */
+    int tPTS;                      /* CANCANϵĴʱʱӳ ns */
+
+} CAN_speed_t;
+
+/******************************************************************************
+ * fifo interface
+ */
+
+#define RX_FIFO_LEN		64
+#define TX_FIFO_LEN		64
+
+#if CAN_USE_DMA
+/*
+ * DMA ѭջ, 32 λ. /ʱжһ, ÿ
+ * 512 , ̵ CAN2.0 (T0+T1+2)Ϊ 128 .
+ */
+#define CAN_DMA_WORDS   1024
+#define CAN_DMA_MASK    (CAN_DMA_WORDS - 1)
+#define RX_FIFO_LEN_DMA 256
+#define CAN_DMA_POLL_MS 2           /* CAN_read() ȴʱ */
+#endif
+
+typedef struct
+{
+	int			count;
+	int			ovcount;			/* overwrite count */
+	int			full;				/* 1 = base contain cnt CANMsgs, tail==head */
+	CANMsg_t   *tail, *head;
+	CANMsg_t   *base;
+	char		fifoarea[0];
+} CAN_fifo_t;
+
+/******************************************************************************
+ * ls2k can priv defination
+ */
+typedef struct CAN
+{
+	/*
+     * hardware shortcuts
+	 */
+	HW_CAN_t       *hwCAN;			    /* CAN Ӳ */
+	unsigned int 	irqNum;			    /* жϺ */
+#if USE_EXTINT
+	unsigned int 	irqNum_buf;		    /* жϺ */
+#endif
+
+    /*
+     * ioctl set CAN configures
+     */
+	unsigned int	workmode;
+	unsigned int	baudrate; 			/* Baudrate in HZ */
+	CAN_speed_t     speed;              /* Calculate from Baudrate */
+#if CAN_USE_FD
+	unsigned int	fd_baudrate; 		/* CAN-FD data phase Baudrate */
+	CAN_speed_t     fd_speed;           /* Calculate from fd_baudrate */
+#endif
+    CAN_filter_t    filter;
+    CAN_range_t     range;
+    int             re_tx_threshold;    /* set.CAN_SET_RTXTH */
+    int             timestamp_psc;      /* Inner timestamp prescale */
+    int             rx_timeout;
+    int             tx_timeout;
+
+    unsigned int    r_mode;
+    unsigned int    r_set;
+    unsigned int    r_fltctrl;
+    int             config_update;
+    
+	/*
+     * rx and tx fifos
+	 */
+	CAN_fifo_t		*rxfifo;
+	CAN_fifo_t		*txfifo;
+
+#if CAN_USE_DMA
+    /*
+     * rx with DMA
+     */
+    struct dma_chnl_cfg rx_dma_cfg;     /* DMA  */
+    int             rx_chnl;            /* DMA ͨ, -1: û */
+    unsigned int   *dma_rxbuf;          /* ѭջ */
+    unsigned int    dma_rx_rpos;        /* Ѿλ, , ۼֵ */
+    unsigned int    dma_rx_halves;      /* /жϴ, ÿ DMA д */
+    int             dma_active;         /* 1: ʹ DMA  */
+#endif
+
+    /*
+     * capture ring: жд, һȡ
+     */
+    CANCapture_t   *cap_ring;           /* ṩ, NULL: ʹ */
+    unsigned int    cap_mask;
+    volatile unsigned int cap_head;
+    volatile unsigned int cap_tail;
+    unsigned int    cap_ts;             /* һĵ 32 λʱ */
+
+    /*
+     * run-time info
+     */
+    osal_event_t    p_event;
+
+    unsigned int    status;
+	CAN_stats_t		stats;
+
+    int             initialized;
+    int             opened;
+
+    /*
+     * device name
+     */
+    char            dev_name[16];
+} CAN_t;
+
+//-----------------------------------------------------------------------------
+// Here is CAN interface defination
+//-----------------------------------------------------------------------------
+
+#if BSP_USE_CAN0
+static CAN_t ls2k_CAN0 =
+{
+	.hwCAN       = (HW_CAN_t *)PHYS_TO_UNCACHED(CAN0_BASE),
+#if USE_EXTINT
+    .irqNum      = EXTI0_CAN0_CORE_IRQ,
+    .irqNum_buf  = EXTI0_CAN0_BUF_IRQ,
+#else
+    .irqNum      = INTC0_CAN0_IRQ,
+#endif
+	.initialized = 0,
+	.dev_name    = "can0",
+};
+const void *devCAN0 = (void *)&ls2k_CAN0;
+#endif
+
+#if BSP_USE_CAN1
+static CAN_t ls2k_CAN1 =
+{
+	.hwCAN       = (HW_CAN_t *)PHYS_TO_UNCACHED(CAN1_BASE),
+#if USE_EXTINT
+    .irqNum      = EXTI0_CAN1_CORE_IRQ,
+    .irqNum_buf  = EXTI0_CAN1_BUF_IRQ,
+#else
+    .irqNum      = INTC0_CAN1_IRQ,
+#endif
+	.initialized = 0,
+	.dev_name    = "can1",
+};
+const void *devCAN1 = (void *)&ls2k_CAN1;
+#endif
+
+#if BSP_USE_CAN2
+static CAN_t ls2k_CAN2 =
+{
+	.hwCAN       = (HW_CAN_t *)PHYS_TO_UNCACHED(CAN2_BASE),
+#if USE_EXTINT
+    .irqNum      = EXTI0_CAN2_CORE_IRQ,
+    .irqNum_buf  = EXTI0_CAN2_BUF_IRQ,
+#else
+    .irqNum      = INTC0_CAN2_IRQ,
+#endif
+	.initialized = 0,
+	.dev_name    = "can2",
+};
+const void *devCAN2 = (void *)&ls2k_CAN2;
+#endif
+
+#if BSP_USE_CAN3
+static CAN_t ls2k_CAN3 =
+{
+	.hwCAN       = (HW_CAN_t *)PHYS_TO_UNCACHED(CAN3_BASE),
+#if USE_EXTINT
+    .irqNum      = EXTI0_CAN3_CORE_IRQ,
+    .irqNum_buf  = EXTI0_CAN3_BUF_IRQ,
+#else
+    .irqNum      = INTC0_CAN3_IRQ,
+#endif
+	.initialized = 0,
+	.dev_name    = "can3",
+};
+const void *devCAN3 = (void *)&ls2k_CAN3;
+#endif
+
+/******************************************************************************
+ * FIFO IMPLEMENTATION
+ ******************************************************************************/
+
+static CAN_fifo_t *can_fifo_create(int count)
+{
+	CAN_fifo_t *fifo;
+
+	fifo = osal_malloc(sizeof(CAN_fifo_t) + count * sizeof(CANMsg_t));
+	if (fifo)
+	{
+		fifo->count = count;
+		fifo->full = 0;
+		fifo->ovcount = 0;
+		fifo->base = (CANMsg_t *)&fifo->fifoarea[0];
+		fifo->tail = fifo->head = fifo->base;
+
+		/* clear CAN Messages
+		 */
+		memset(fifo->base, 0, count * sizeof(CANMsg_t));
+	}
+
+	return fifo;
+}
+
+static void can_fifo_free(CAN_fifo_t *fifo)
+{
+	if (fifo)
+	{
+		osal_free(fifo);
+		fifo = NULL;
+	}
+}
+
+static inline int can_fifo_full(CAN_fifo_t *fifo)
+{
+	return fifo->full;
+}
+
+static inline int can_fifo_empty(CAN_fifo_t *fifo)
+{
+	return (!fifo->full) && (fifo->head == fifo->tail);
+}
+
+static void can_fifo_get(CAN_fifo_t *fifo)
+{
+	if (!fifo)
+	{
+    	return;
+    }
+
+	if (can_fifo_empty(fifo))
+	{
+    	return;
+    }
+
+	/*
+     * increment indexes
+	 */
+	fifo->tail = (fifo->tail >= &fifo->base[fifo->count - 1]) ? fifo->base : fifo->tail + 1;
+	fifo->full = 0;
+}
+
+/* Stage 1 - get buffer to fill (never fails if force!=0)
+ */
+static CANMsg_t *can_fifo_put_claim(CAN_fifo_t *fifo, int force)
+{
+	if (!fifo)
+	{
+    	return NULL;
+    }
+
+	if (can_fifo_full(fifo))
+	{
+		if (!force)
+		{
+        	return NULL;
+        }
+
+		/* all buffers already used ==> overwrite the oldest
+		 */
+		fifo->ovcount++;
+		can_fifo_get(fifo);
+	}
+
+	return fifo->head;
+}
+
+/* Stage 2 - increment indexes
+ */
+static void can_fifo_put(CAN_fifo_t *fifo)
+{
+	if (can_fifo_full(fifo))
+	{
+    	return;
+    }
+
+	/*
+     * wrap around the indexes
+	 */
+	fifo->head = (fifo->head >= &fifo->base[fifo->count - 1]) ? fifo->base : fifo->head + 1;
+	if (fifo->head == fifo->tail)
+	{
+    	fifo->full = 1;
+    }
+}
+
+static CANMsg_t *can_fifo_claim_get(CAN_fifo_t *fifo)
+{
+	if (can_fifo_empty(fifo))
+	{
+    	return NULL;
+    }
+
+	/* return oldest message
+	 */
+	return fifo->tail;
+}
+
+/* Get contiguous messages, at most max. return count
+ */
+static int can_fifo_claim_get_n(CAN_fifo_t *fifo, CANMsg_t **msgs, int max)
+{
+    int n;
+
+	if (can_fifo_empty(fifo))
+	{
+    	return 0;
+    }
+
+    if (fifo->head > fifo->tail)
+        n = fifo->head - fifo->tail;
+    else                                /* wrap around, till the end */
+        n = &fifo->base[fifo->count] - fifo->tail;
+
+    *msgs = fifo->tail;
+	return (n < max) ? n : max;
+}
+
+static void can_fifo_get_n(CAN_fifo_t *fifo, int n)
+{
+	fifo->tail += n;
+	if (fifo->tail >= &fifo->base[fifo->count])
+	{
+    	fifo->tail -= fifo->count;
+    }
+
+	fifo->full = 0;
+}
+
+static void can_fifo_clear(CAN_fifo_t *fifo)
+{
+	fifo->full = 0;
+	fifo->ovcount = 0;
+	fifo->head = fifo->tail = fifo->base;
+}
+
+/******************************************************************************
+ * CAN functions
+ ******************************************************************************/
+
+#if CAN_USE_FD
+/*
+ * CAN-FD DLC 9~15 Ӧݳ
+ */
+static const unsigned char can_fd_dlc2len[16] =
+{
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64
+};
+
+static inline int can_dlc_to_len(int dlc, int fdf)
+{
+    if (!fdf)
+        return (dlc <= 8) ? dlc : 8;
+
+    return can_fd_dlc2len[dlc & 0x0F];
+}
+
+/*
+ * ȡ DLC, ʱ㲿ֲ 0
+ */
+static inline int can_len_to_dlc(int len, int fdf)
+{
+    int dlc;
+
+    if (len <= 8)
+        return (len > 0) ? len : 0;
+
+    if (!fdf)
+        return 8;
+
+    for (dlc=9; dlc<15; dlc++)
+    {
+        if (can_fd_dlc2len[dlc] >= len)
+            break;
+    }
+
+    return dlc;
+}
+
+#else
+#define can_dlc_to_len(dlc, fdf)    (((dlc) <= 8) ? (dlc) : 8)
+#define can_len_to_dlc(len, fdf)    (((len) <= 8) ? (len) : 8)
+#endif
+
+/* This function calculates BTR0 and BTR1 values for a given bitrate.
+ *
+ * Set communication parameters.
+ * param: rate Requested baud rate in bits/second.
+ * param: result Pointer to where resulting BTRs will be stored.
+ * return: zero if successful to calculate a baud rate.
+ *
+ *
+ * LS2K300 baudrate:
+ *
+ * λʷƵ=BRP*(PROP+PH1+PH2+1+(FRC/0x100)).
+ *
+ *   : 1 == SYNC_SEG
+ *
+ *   : BRP=4; PROP=2; PH1=3; PH2=4; FRC=8'b01100000;
+ *       DIV=4*(3+4+2+1+0.375) = 41.5.
+ *
+ *       Baudrate =
+ */
+
+#define SYNC_SEG    1           /* ͬ */
+
+#define PROP_MIN    1           /*  */
+#define PH1_MIN     2           /* λ1 */
+#define PH2_MIN     1           /* λ2 */
+#define FRC_MIN     0           /* С */
+
+#define PROP_MAX    0x7F
+#define PH1_MAX     0x3F
+#define PH2_MAX     0x3F
+#define FRC_MAX     0xFF
+
+#define BRP_MIN     0x2
+#define BRP_MAX     0xFF
+
+#define SJW_MIN     0x1
+#define SJW_MAX     0x1F
+
+static int ls2k_can_calc_bittiming(CAN_t *pCAN, int baudrate, int data_phase, CAN_speed_t *result)
+{
+	int error=0, best_error = 2000000000;
+	int nbt=0, best_nbt=0, brp=0, best_brp=0;
+	int prop=0, ph1=0, ph2=0, frc=0, sjw=0;
+    int sampl_pt, tPTS=0, nbt_min, nbt_max, tmp;
+
+    /*
+     * Baudrate limits
+     */
+#if CAN_USE_FD
+    if (data_phase)
+    {
+        if (baudrate > CAN_SPEED_10M)
+            baudrate = CAN_SPEED_10M;
+    }
+    else
+#endif
+    {
+        if (baudrate > CAN_SPEED_1M)
+            baudrate = CAN_SPEED_1M;
+    }
+
+    if (baudrate < CAN_SPEED_10K)
+        baudrate = CAN_SPEED_10K;
+
+    /*
+     * Calculate best_tbit / best_brp / brp
+     */
+    nbt_min = SYNC_SEG + PROP_MIN + PH1_MIN + PH2_MIN;
+    nbt_max = SYNC_SEG + (PH1_MAX * 130) / 100;     // PH2_MAX = PH1_MAX * 30%
+    nbt_max = nbt_max * 120 / 100;                  // PROP_MAX = NBT * 20%
+
+    for (nbt = nbt_min; nbt < nbt_max; nbt++)
+    {
+        brp = apb_frequency / baudrate / nbt;
+        if ((brp < BRP_MIN) || (brp > BRP_MAX))
+        {
+            continue;
+        }
+
+		error = baudrate - apb_frequency / brp / nbt;
+
+		if (error < 0)
+			error = -error;
+
+		if (error <= best_error)
+		{
+			best_error = error;
+			best_nbt = nbt;
+			best_brp = brp;
+		}
+
+        // if ((error == 0) && (nbt >= 20))
+        //     break;
+    }
+
+    /*
+     * Calculate FRC
+     */
+    if (best_error != 0)
+    {
+	    frc = (int)(((double)apb_frequency / baudrate / best_brp - best_nbt) * 0x100);
+    }
+
+    /*
+     * εӳʱ tPTS = 500ns
+     *
+     * ݶεշӳɵڶ㲹, ȡСֵ
+     */
+    if (result)
+        tPTS = (int)result->tPTS;
+    if (tPTS <= 0)
+        tPTS = 500;
+
+    tmp = (tPTS * 100) / (1000000000 / baudrate);
+    if (tmp > 30)
+        tmp = 30;                   /* Total percent max 30% */
+    prop = data_phase ? PROP_MIN : best_nbt * tmp / 100;
+
+    if (best_nbt - prop < SYNC_SEG + PH1_MIN + PH2_MIN)
+        prop = best_nbt - (SYNC_SEG + PH1_MIN + PH2_MIN);
+    if (prop <= 0)
+        prop = 1;
+
+    nbt = best_nbt - prop - SYNC_SEG;       /* remain TQ */
+
+    /*
+     * 
+     */
+    sampl_pt = result ? result->Sample_pt : pCAN->speed.Sample_pt;
+    if (0 == sampl_pt)
+    {
+        sampl_pt = 75;
+    }
+
+	if (nbt <= 10)
+    	sampl_pt = 80;
+	else if (nbt <= 15)
+    	sampl_pt = 70;
+
+    /*
+     * λ2
+     */
+	ph2 = nbt - (sampl_pt * (nbt + SYNC_SEG)) / 100;
+	if (ph2 < 1)
+    	ph2 = 1;
+	if (ph2 > PH2_MAX)
+    	ph2 = PH2_MAX;
+
+    /*
+     * λ1
+     */
+	ph1 = nbt - ph2;
+	if (ph1 > PH1_MAX)
+	{
+		ph1 = PH1_MAX;
+		ph2 = nbt - ph1;
+	}
+
+    /*
+     * SJW
+     */
+    sjw = (ph1 < ph2) ? ph1 : ph2;
+    sjw = (sjw < 4) ? sjw : 4;
+    
+    #if 0
+    {
+        // λʷƵ=BRP*(PROP+PH1+PH2+1+(FRC/0x100)).
+        
+        int baud = apb_frequency / best_brp / (prop + ph1 + ph2 + 1);
+
+        if (baudrate != baud)
+        {
+            printk("need %i : resule %i\r\n", baudrate, baud);
+        }
+        
+    }
+    #endif
+
+    if (result)
+    {
+        result->prop = prop;
+        result->ph1  = ph1;
+        result->ph2  = ph2;
+        result->brp  = best_brp;
+        result->sjw  = sjw;
+        result->frac = frc;
+    }
+
+    return 0;
+}
+
+static int ls2k_can_set_baudrate(CAN_t *pCAN, int baudrate)
+{
+    if (pCAN->baudrate == baudrate)
+        return 0;
+
+    int rt = ls2k_can_calc_bittiming(pCAN, baudrate, 0, &pCAN->speed);
+
+    if (0 == rt)
+    {
+        pCAN->baudrate = baudrate;
+        pCAN->config_update = 1;
+    }
+
+    return rt;
+}
+
+#if CAN_USE_FD
+/*
+ * CAN-FD ݶ,  brs=1 ʱʹ
+ */
+static int ls2k_can_set_fd_baudrate(CAN_t *pCAN, int baudrate)
+{
+    if (pCAN->fd_baudrate == baudrate)
+        return 0;
+
+    int rt = ls2k_can_calc_bittiming(pCAN, baudrate, 1, &pCAN->fd_speed);
+
+    if (0 == rt)
+    {
+        pCAN->fd_baudrate = baudrate;
+        pCAN->config_update = 1;
+    }
+
+    return rt;
+}
+#endif
+
+/*
+ *  filter/range  fltctrl. CANFD ģʽͬʱ CANFD  CAN2.0 
+ */
+static void ls2k_can_update_fltctrl(CAN_t *pCAN)
+{
+    static const unsigned int flt_bits[3][4] =
+    {
+        /* NE, NB, FE, FB */
+        { CAN_FCTRL_FA_NE, CAN_FCTRL_FA_NB, CAN_FCTRL_FA_FE, CAN_FCTRL_FA_FB },
+        { CAN_FCTRL_FB_NE, CAN_FCTRL_FB_NB, CAN_FCTRL_FB_FE, CAN_FCTRL_FB_FB },
+        { CAN_FCTRL_FC_NE, CAN_FCTRL_FC_NB, CAN_FCTRL_FC_FE, CAN_FCTRL_FC_FB },
+    };
+    int i, fd = pCAN->r_mode & CAN_MODE_FDE;
+    unsigned int ctrl = 0;
+
+    for (i=0; i<3; i++)
+    {
+        if (pCAN->filter.filter[i] & CAN_FILTER_STD)
+            ctrl |= flt_bits[i][0] | (fd ? flt_bits[i][2] : 0);
+        if (pCAN->filter.filter[i] & CAN_FILTER_EXT)
+            ctrl |= flt_bits[i][1] | (fd ? flt_bits[i][3] : 0);
+    }
+
+    if (pCAN->range.enable & CAN_RANGE_STD)
+        ctrl |= CAN_FCTRL_FR_NE | (fd ? CAN_FCTRL_FR_FE : 0);
+    if (pCAN->range.enable & CAN_RANGE_EXT)
+        ctrl |= CAN_FCTRL_FR_NB | (fd ? CAN_FCTRL_FR_FB : 0);
+
+    pCAN->r_fltctrl = (pCAN->r_fltctrl & ~0xFFFF) | ctrl;
+
+    if (pCAN->filter.filter[0] || pCAN->filter.filter[1] ||
+        pCAN->filter.filter[2] || pCAN->range.enable)
+        pCAN->r_mode |= CAN_MODE_AFM;
+    else
+        pCAN->r_mode &= ~CAN_MODE_AFM;
+}
+
+static int ls2k_can_set_workmode(CAN_t *pCAN, unsigned int mode)
+{
+    if (pCAN->workmode == mode)
+        return 0;
+
+    pCAN->workmode = mode;
+
+    /*
+     * can.mode register
+     */
+    pCAN->r_mode = CAN_MODE_BUFM;           /* Always use Inner TX Buffer */
+    if (mode & CAN_MODE_RX_ADD_TS1)
+        pCAN->r_mode |= CAN_MODE_RTSOP;
+    if (mode & CAN_MODE_RX_CAN_TS)
+        pCAN->r_mode |= CAN_MODE_ITSM;
+    if (mode & CAN_MODE_RX_NO_ACK)
+        pCAN->r_mode |= CAN_MODE_ACF;
+    if (mode & CAN_MODE_BUS_MONITOR)
+        pCAN->r_mode |= CAN_MODE_BMM;
+    else if (mode & CAN_MODE_SELF_TEST)
+        pCAN->r_mode |= CAN_MODE_STM;
+    if (mode & CAN_MODE_TX_TIMED)
+        pCAN->r_mode |= CAN_MODE_TTTM;
+#if CAN_USE_FD
+    if (mode & CAN_MODE_FD)
+        pCAN->r_mode |= CAN_MODE_FDE;
+#endif
+
+    /*
+     * can.set register
+     */
+    pCAN->r_set = 0;
+    if (mode & CAN_MODE_IGNORE_RTR)
+        pCAN->r_set |= CAN_SET_FDRF;
+    if (mode & CAN_MODE_PROTOCOL_E)
+        pCAN->r_set |= CAN_SET_PEX;
+    if (mode & CAN_MODE_LOOPBACK)
+        pCAN->r_set |= CAN_SET_ILBP;
+#if CAN_USE_FD
+    if ((mode & CAN_MODE_FD) && (mode & CAN_MODE_NON_ISO))
+        pCAN->r_set |= CAN_SET_NISOFD;
+#endif
+    pCAN->re_tx_threshold = mode & CAN_RE_TX_THRESH_MASK;
+    if (pCAN->re_tx_threshold)
+    {
+        pCAN->r_set |= CAN_SET_RTXLE;
+        pCAN->r_set |= pCAN->re_tx_threshold << CAN_SET_RTXTH_SHIFT;
+    }
+
+    /*
+     * Auto Increase RX Buffer Pointer: Always Add
+     */
+    pCAN->r_mode |= CAN_MODE_RXBAM;     
+
+    /*
+     * filter control depends on FDE
+     */
+    ls2k_can_update_fltctrl(pCAN);
+
+    pCAN->config_update = 1;
+    return 0;
+}
+
+static int ls2k_can_set_filter(CAN_t *pCAN, CAN_filter_t *filter)
+{
+    CAN_filter_t default_flt;
+    
+    if (NULL == filter)
+    {
+        filter = &default_flt;
+
+        filter->fltmask[0]  = 0xFFFFFFFF;
+        filter->fltmask[1]  = 0xFFFFFFFF;
+        filter->fltmask[2]  = 0xFFFFFFFF;
+        filter->fltvalue[0] = 0;
+        filter->fltvalue[1] = 0;
+        filter->fltvalue[2] = 0;
+        filter->filter[0] = 0;
+        filter->filter[1] = 0;
+        filter->filter[2] = 0;
+    }
+
+    if ((pCAN->filter.fltmask[0]  != filter->fltmask[0])  ||
+        (pCAN->filter.fltmask[1]  != filter->fltmask[1])  ||
+        (pCAN->filter.fltmask[2]  != filter->fltmask[2])  ||
+        (pCAN->filter.fltvalue[0] != filter->fltvalue[0]) ||
+        (pCAN->filter.fltvalue[1] != filter->fltvalue[1]) ||
+        (pCAN->filter.fltvalue[2] != filter->fltvalue[2]) ||
+        (pCAN->filter.filter[0]   != filter->filter[0])   ||
+        (pCAN->filter.filter[1]   != filter->filter[1])   ||
+        (pCAN->filter.filter[2]   != filter->filter[2]) )
+    {
+        pCAN->hwCAN->fltmaskA = pCAN->filter.fltmask[0]  = filter->fltmask[0];
+        pCAN->hwCAN->fltmaskB = pCAN->filter.fltmask[1]  = filter->fltmask[1];
+        pCAN->hwCAN->fltmaskC = pCAN->filter.fltmask[2]  = filter->fltmask[2];
+        pCAN->hwCAN->fltvalA  = pCAN->filter.fltvalue[0] = filter->fltvalue[0];
+        pCAN->hwCAN->fltvalB  = pCAN->filter.fltvalue[1] = filter->fltvalue[1];
+        pCAN->hwCAN->fltvalC  = pCAN->filter.fltvalue[2] = filter->fltvalue[2];
+        pCAN->filter.filter[0] = filter->filter[0];
+        pCAN->filter.filter[1] = filter->filter[1];
+        pCAN->filter.filter[2] = filter->filter[2];
+        
+        ls2k_can_update_fltctrl(pCAN);
+
+        pCAN->config_update = 1;
+    }
+
+    return 0;
+}
+
+static int ls2k_can_set_range(CAN_t *pCAN, CAN_range_t *range)
+{
+    CAN_range_t default_rng;
+    
+    if (NULL == range)
+    {
+        range = &default_rng;
+        range->rangelo = 0;
+        range->rangehi = 0;
+        range->enable  = 0;
+    }
+
+    if ((pCAN->range.rangelo != range->rangelo) ||
+        (pCAN->range.rangehi != range->rangehi) ||
+        (pCAN->range.enable  != range->enable) )
+    {
+        pCAN->hwCAN->fltrlo = pCAN->range.rangelo = range->rangelo;
+        pCAN->hwCAN->fltrhi = pCAN->range.rangehi = range->rangehi;
+        pCAN->range.enable  = range->enable;
+
+        ls2k_can_update_fltctrl(pCAN);
+
+        pCAN->config_update = 1;
+    }
+
+    return 0;
+}
+
+static int ls2k_can_set_ts_psc(CAN_t *pCAN, unsigned int psc)
+{
+    if (pCAN->timestamp_psc != psc)
+    {
+        pCAN->timestamp_psc = psc;
+        pCAN->hwCAN->ts &= ~CAN_TS_PSC_MASK;
+        pCAN->hwCAN->ts |= psc << CAN_TS_PSC_SHIFT;
+    }
+
+    return 0;
+}
+
+static int ls2k_can_set_capture(CAN_t *pCAN, CAN_capture_t *cap)
+{
+    if ((cap == NULL) || (cap->ring == NULL))
+    {
+        pCAN->cap_ring = NULL;
+        return 0;
+    }
+
+    if ((cap->count < 2) || (cap->count & (cap->count - 1)))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    pCAN->cap_mask = cap->count - 1;
+    pCAN->cap_head = 0;
+    pCAN->cap_tail = 0;
+    pCAN->cap_ts   = 0;
+    pCAN->cap_ring = cap->ring;
+
+    return 0;
+}
+
+static int ls2k_can_get_statics(CAN_t *pCAN, CAN_stats_t **st)
+{
+    pCAN->stats.rx_errors = (pCAN->hwCAN->errcnt >> 16) & 0x1FF;
+    pCAN->stats.tx_errors = pCAN->hwCAN->errcnt & 0x1FF;
+    
+    pCAN->stats.std_rate_errors = pCAN->hwCAN->brerr >> 16;
+    pCAN->stats.fd_rate_errors = pCAN->hwCAN->brerr & 0xFFFF;
+
+    *st = &pCAN->stats;
+
+    return 0;
+}
+
+static int ls2k_can_get_status(CAN_t *pCAN, unsigned int *status)
+{
+    unsigned int rv;
+    
+    *status = pCAN->status;     /* Only record CAN_STATUS_BUF_ERROR */
+    
+    rv = pCAN->hwCAN->status;
+    
+    if (rv & CAN_SR_IDLE)
+        *status |= CAN_STATUS_IDLE;
+    if (rv & CAN_SR_DOR)
+        *status |= CAN_STATUS_RX_OVERFLOW;
+    if (rv & CAN_SR_RXNE)
+        *status |= CAN_STATUS_RXBUF_NOT_EMPTY;
+
+    rv = pCAN->hwCAN->errsr;
+    
+    if (rv & CAN_ERRSR_BUSOFF)
+        *status |= CAN_STATUS_BUS_OFF;
+    if (rv & CAN_ERRSR_ERP)
+        *status |= CAN_STATUS_ERROR_PASSIVE;
+    if (rv & CAN_ERRSR_ERA)
+        *status |= CAN_STATUS_ERROR_ACTIVE;
+
+    return 0;
+}
+
+/******************************************************************************
+ * CAN DMA support
+ ******************************************************************************/
+
+#if CAN_USE_DMA
+static int  ls2k_can_dma_rx_start(CAN_t *pCAN);
+static void ls2k_can_dma_rx_stop(CAN_t *pCAN);
+#endif
+
+/******************************************************************************
+ * CAN Hardware Operating
+ ******************************************************************************/
+
+static inline void ls2k_can_hw_reset(CAN_t *pCAN)
+{
+    pCAN->hwCAN->mode |= CAN_MODE_RST;
+    asm volatile( "nop; nop; nop; nop; nop; nop;" );
+    pCAN->hwCAN->mode &= ~CAN_MODE_RST;
+}
+
+/*
+ * put the CAN-Control to ENABLE mode
+ */
+static int ls2k_can_hw_start(CAN_t *pCAN)
+{
+    unsigned int rv, ien;
+
+	if (pCAN->opened)
+        return 0;
+        
+	if (!pCAN->rxfifo || !pCAN->txfifo)
+    	return -1;
+
+	can_fifo_clear(pCAN->txfifo);           /* empty the TX fifo */
+	can_fifo_clear(pCAN->rxfifo);           /* empty the RX fifo */
+	
+    memset(&pCAN->stats, 0, sizeof(CAN_stats_t));
+
+    pCAN->cap_head = pCAN->cap_tail = 0;
+
+    /*
+     * Set CAN.mode register
+     */
+    rv = pCAN->hwCAN->mode;
+    if (rv != pCAN->r_mode)
+        pCAN->hwCAN->mode = pCAN->r_mode;
+
+    /*
+     * Set CAN.btr register
+     */
+    if (pCAN->speed.btr32)
+    {
+        {
+            pCAN->hwCAN->btrnormal = pCAN->speed.btr32;
+            pCAN->hwCAN->frcdiv &= ~CAN_FRC_NBT_MASK;
+            pCAN->hwCAN->frcdiv |= pCAN->speed.frac;
+        }
+    }
+
+#if CAN_USE_FD
+    /*
+     * Set CAN.btrfd register, and second sample point for data phase
+     */
+    if ((pCAN->r_mode & CAN_MODE_FDE) && pCAN->fd_speed.btr32)
+    {
+        CAN_speed_t *fd = &pCAN->fd_speed;
+
+        pCAN->hwCAN->btrfd = fd->btr32;
+        pCAN->hwCAN->frcdiv &= ~CAN_FRC_DBT_MASK;
+        pCAN->hwCAN->frcdiv |= (fd->frac << CAN_FRC_DBT_SHIFT) & CAN_FRC_DBT_MASK;
+
+        if (pCAN->fd_baudrate > CAN_SPEED_1M)
+        {
+            unsigned int ssp_off = fd->brp * (SYNC_SEG + fd->prop + fd->ph1);
+
+            if (ssp_off > CAN_SSP_CFG_OFF_MASK)
+                ssp_off = CAN_SSP_CFG_OFF_MASK;
+            pCAN->hwCAN->sspcfg = CAN_SSP_CFG_0 | CAN_SSP_CFG_SAT | ssp_off;
+        }
+        else
+        {
+            pCAN->hwCAN->sspcfg = CAN_SSP_CFG_1;
+        }
+    }
+#endif
+
+    /*
+     * Set CAN.mode register
+     */
+    rv = pCAN->hwCAN->fltctrl;
+    if (rv != pCAN->r_fltctrl)
+        pCAN->hwCAN->fltctrl = pCAN->r_fltctrl;
+
+    /*
+     * Set CAN.set register
+     */
+    rv = pCAN->hwCAN->set;
+    if (rv != pCAN->r_set)
+        pCAN->hwCAN->set = pCAN->r_set;
+
+    pCAN->hwCAN->set |= CAN_SET_ENABLE;     /* Enable the CAN Controller */
+
+    /*
+     * Set register for Clear something
+     */
+    pCAN->hwCAN->cmd = 0xFC;
+    pCAN->hwCAN->isr = 0x1FFF;
+    pCAN->hwCAN->ien = 0x1FFF << 16;
+    pCAN->hwCAN->imask = 0x1FFF << 16;
+
+    ien = 0x0EEF;
+
+#if CAN_USE_DMA
+    /*
+     * DMA ʱʹ RX ж, ʧʱʹжϽ
+     */
+    if (pCAN->workmode & CAN_MODE_RX_DMA)
+    {
+        if (ls2k_can_dma_rx_start(pCAN) == 0)
+            ien &= ~(CAN_ISR_RX | CAN_ISR_RXF | CAN_ISR_RBNE);
+        else
+            printk("%s: RX DMA start fail, use interrupt.\r\n", pCAN->dev_name);
+    }
+#endif
+    
+    /*
+     * Enable CAN interrupt
+     */
+    ls2k_interrupt_enable(pCAN->irqNum);
+
+    pCAN->hwCAN->ien |= ien;
+
+    return 0;
+}
+
+/*
+ * put the CAN-Control to DISABLE mode
+ */
+static void ls2k_can_hw_stop(CAN_t *pCAN)
+{
+	/*
+     * Disable Can all interrupts
+	 */
+    pCAN->hwCAN->ien = 0x1FFF << 16;
+    pCAN->hwCAN->isr = 0x1FFF;
+    pCAN->hwCAN->imask = 0x1FFF << 16;
+
+	/*
+     * Disable CAN interrupt
+	 */
+	ls2k_interrupt_disable(pCAN->irqNum);
+
+#if CAN_USE_DMA
+    ls2k_can_dma_rx_stop(pCAN);
+#endif
+
+    pCAN->hwCAN->set &= ~CAN_SET_ENABLE;
+
+    return;
+}
+
+/**
+ * Try to send message "msg", if hardware txfifo is full, then -1 is returned.
+ * Be sure to have disabled CAN interrupts when entering this function.
+ */
+static int ls2k_can_send_msg(CAN_t *pCAN, CANMsg_t *msg)
+{
+    int i, len, words, fdf = 0;
+    MSGT0_t t0;
+    MSGT1_t t1;
+    unsigned int vals[16];      /* Total 64 bytes */
+    unsigned int txsel;
+
+    /*
+     * prepare tx data
+     */
+    t0.value = 0;
+    if (msg->extended)					/* Extended Frame */
+	{
+	    t0.id = msg->id;
+	    t0.xtd = 1;
+	}
+	else								/* Standard Frame */
+	{
+	    t0.id = msg->id << 18;
+	}
+
+	t1.value = 0;
+
+#if CAN_USE_FD
+    if ((pCAN->r_mode & CAN_MODE_FDE) && msg->fdf)
+    {
+        fdf = 1;
+        t1.fdf = 1;
+        t1.brs = msg->brs ? 1 : 0;
+    }
+    else
+#endif
+    {
+        t0.rtr = msg->rtr;              /* Only for CAN 2.0 */
+    }
+
+    t1.dlc = can_len_to_dlc(msg->len, fdf);
+    len = can_dlc_to_len(t1.dlc, fdf);
+    words = (len + 3) / 4;
+
+    if (t0.rtr)
+    {
+        /* CAN2.0 Remote Transmission Request */
+        words = 0;
+    }
+    else if (words > 0)
+    {
+        memset(vals, 0, words * 4);     /* padding zero */
+        memcpy(vals, msg->data, (msg->len < len) ? msg->len : len);
+    }
+
+    /*
+     * Use tx buffer index
+     */
+    txsel = 0;
+
+    pCAN->hwCAN->txsel = txsel;
+
+    pCAN->hwCAN->head0 = t0.value;
+    pCAN->hwCAN->head1 = t1.value;
+
+    for (i=0; i<words; i++)
+        pCAN->hwCAN->txdata[i] = vals[i];
+
+    /*
+     * set transmit command
+     */
+    pCAN->hwCAN->txcmd = 1 << txsel;
+
+    /*
+     * TODO more ?
+     */
+
+	return 0;
+}
+
+/**
+ * Data words followed T0/T1
+ */
+static inline int ls2k_can_data_words(MSGT0_t t0, MSGT1_t t1)
+{
+    int fdf = 0;
+
+#if CAN_USE_FD
+    fdf = t1.fdf;
+#endif
+
+    if (!fdf && t0.rtr)
+        return 0;
+
+    return (can_dlc_to_len(t1.dlc, fdf) + 3) / 4;
+}
+
+/**
+ * Fill message from T0/T1, return data words followed
+ */
+static int ls2k_can_parse_header(CANMsg_t *msg, MSGT0_t t0, MSGT1_t t1)
+{
+    int fdf = 0;
+
+#if CAN_USE_FD
+    fdf = t1.fdf;
+    msg->fdf = t1.fdf;
+    msg->brs = t1.brs;
+    msg->esi = t0.esi;
+#endif
+
+    msg->rtr = fdf ? 0 : t0.rtr;
+    msg->extended = t0.xtd;
+    msg->len = can_dlc_to_len(t1.dlc, fdf);
+    msg->timestamp = t1.timestamp;
+
+    if (msg->extended)                  /* Extended Frame */
+        msg->id = t0.id;
+    else                                /* Standard frame */
+        msg->id = t0.id >> 18;
+
+    /*
+     * CAN2.0 Remote Transmission Request has no data.
+     */
+    return msg->rtr ? 0 : (msg->len + 3) / 4;
+}
+
+/**
+ * Deliver a received message to capture ring or rx fifo.
+ * Data words: n0 words at d0, followed by (words - n0) words at d1.
+ */
+static void ls2k_can_put_message(CAN_t *pCAN, MSGT0_t t0, MSGT1_t t1, int words,
+                                 const unsigned int *d0, int n0, const unsigned int *d1)
+{
+    unsigned char *data;
+
+    if (pCAN->cap_ring)
+    {
+        CANCapture_t *rec;
+        unsigned int head = pCAN->cap_head;
+        int fdf = 0;
+
+        /*
+         * 16 λʱչΪ 32 λ, ǰʱ˳
+         */
+        pCAN->cap_ts += (t1.timestamp - pCAN->cap_ts) & 0xFFFF;
+
+        /*
+         * ring ʱ±, Ƕȡʹõļ¼
+         */
+        if (head - __atomic_load_n(&pCAN->cap_tail, __ATOMIC_ACQUIRE) > pCAN->cap_mask)
+        {
+            pCAN->stats.rx_cap_dropped++;
+            return;
+        }
+
+        rec = &pCAN->cap_ring[head & pCAN->cap_mask];
+        rec->timestamp = pCAN->cap_ts;
+        rec->id    = t0.xtd ? t0.id : t0.id >> 18;
+        rec->flags = t0.xtd ? CAN_CAP_EXT : 0;
+#if CAN_USE_FD
+        fdf = t1.fdf;
+        if (fdf)
+            rec->flags |= CAN_CAP_FDF | (t1.brs ? CAN_CAP_BRS : 0) | (t0.esi ? CAN_CAP_ESI : 0);
+#endif
+        if (!fdf && t0.rtr)
+            rec->flags |= CAN_CAP_RTR;
+        rec->len = can_dlc_to_len(t1.dlc, fdf);
+        data = rec->data;
+    }
+    else
+    {
+        /*
+         * fifo ʱ±,  CAN_read() ڸƵı
+         */
+        CANMsg_t *msg = can_fifo_put_claim(pCAN->rxfifo, 0);
+
+        if (!msg)
+        {
+            pCAN->rxfifo->ovcount++;
+            pCAN->stats.rx_fifo_dropped++;
+            return;
+        }
+
+        ls2k_can_parse_header(msg, t0, t1);
+        data = msg->data;
+    }
+
+    /* little endian: byte k of word j is data[4*j+k] */
+    if (n0 > words)
+        n0 = words;
+    memcpy(data, d0, n0 * 4);
+    if (n0 < words)
+        memcpy(data + n0 * 4, d1, (words - n0) * 4);
+
+    /*
+     * make message available to the user
+     */
+    if (pCAN->cap_ring)
+        __atomic_store_n(&pCAN->cap_head, pCAN->cap_head + 1, __ATOMIC_RELEASE);
+    else
+        can_fifo_put(pCAN->rxfifo);
+}
+
+/**
+ * Receive a message from Inner RX Buffer
+ */
+static int ls2k_can_receive_message(CAN_t *pCAN, int fromDMA)
+{
+    int i, words;
+	MSGT0_t t0;
+	MSGT1_t t1;
+    unsigned int vals[16];      /* Total 64 bytes */
+
+    {
+        /*
+         * Protocol leader
+         */
+        t0.value = pCAN->hwCAN->rxdata;
+        t1.value = pCAN->hwCAN->rxdata;
+    }
+
+    words = ls2k_can_data_words(t0, t1);
+
+    for (i=0; i<words; i++)
+    {
+        /*
+         * Inner buffer Rx data flag
+         */
+        if (!(pCAN->hwCAN->rxsr & CAN_RXSR_MOF))
+            break;
+
+        vals[i] = pCAN->hwCAN->rxdata;
+    }
+
+    for ( ; i<words; i++)
+        vals[i] = 0;
+
+    ls2k_can_put_message(pCAN, t0, t1, words, vals, words, NULL);
+
+    return 0;
+}
+
+#if CAN_USE_DMA
+
+/******************************************************************************
+ * CAN DMA receive
+ *
+ * DMA ѭģʽ,  rxdata ı(T0, T1, )д dma_rxbuf,
+ * ٲÿһε RX ж.
+ *
+ *   1. /жʱ, һνı,  rxfifo;
+ *   2. CAN_read() ȴʱҲ, ıĲ.
+ */
+
+static int ls2k_can_dma_devnum(CAN_t *pCAN)
+{
+    return DMA_CAN0 + (int)((VA_TO_PHYS(pCAN->hwCAN) - CAN0_BASE) / (CAN1_BASE - CAN0_BASE));
+}
+
+/*
+ * DMA ĵǰдλ, 
+ */
+static inline int ls2k_can_dma_rx_head(CAN_t *pCAN)
+{
+    int head = CAN_DMA_WORDS - dma_get_counter(pCAN->rx_chnl);
+
+    if ((head < 0) || (head >= CAN_DMA_WORDS))
+        head = 0;
+
+    return head;
+}
+
+/*
+ * ޷ȷı߽, ջ¿ʼ
+ */
+static void ls2k_can_dma_rx_reset(CAN_t *pCAN)
+{
+    ls2k_can_dma_rx_stop(pCAN);
+    pCAN->hwCAN->cmd = CAN_CMD_RRB;
+    ls2k_can_dma_rx_start(pCAN);
+}
+
+/*
+ *  dma_rxbuf ı, رĸ. ߹ж
+ */
+static int ls2k_can_dma_rx_parse(CAN_t *pCAN)
+{
+    unsigned int *ring = pCAN->dma_rxbuf;
+    unsigned int rpos = pCAN->dma_rx_rpos;
+    unsigned int wpos, avail;
+    int tail = rpos & CAN_DMA_MASK;
+    int words, n, count = 0;
+	MSGT0_t t0;
+	MSGT1_t t1;
+
+    /*
+     * DMA ۼдλ: һι/жϵλ֮, һȦ.
+     * ֻ head - tail ʱ, DMA һȦûһ.
+     */
+    wpos  = pCAN->dma_rx_halves * (CAN_DMA_WORDS / 2);
+    wpos += (ls2k_can_dma_rx_head(pCAN) - wpos) & CAN_DMA_MASK;
+    avail = wpos - rpos;
+
+    /*
+     * DMA Ѿ˻ûнı
+     */
+    if (avail > CAN_DMA_WORDS)
+    {
+        pCAN->stats.rx_dma_overruns++;
+        ls2k_can_dma_rx_reset(pCAN);
+        return 0;
+    }
+
+    if (avail < 2)
+        return 0;
+
+    n = CAN_DMA_WORDS - tail;
+    if ((int)avail <= n)
+    {
+        clean_dcache_nowrite((unsigned long)(ring + tail), avail * 4);
+    }
+    else
+    {
+        clean_dcache_nowrite((unsigned long)(ring + tail), n * 4);
+        clean_dcache_nowrite((unsigned long)ring, (avail - n) * 4);
+    }
+
+    while (avail >= 2)
+    {
+        t0.value = ring[tail];
+        t1.value = ring[(tail + 1) & CAN_DMA_MASK];
+
+        /*
+         * DMA ûд
+         */
+        words = ls2k_can_data_words(t0, t1);
+        if (avail < (unsigned int)words + 2)
+            break;
+
+        tail = (tail + 2) & CAN_DMA_MASK;
+        n = CAN_DMA_WORDS - tail;
+        ls2k_can_put_message(pCAN, t0, t1, words, ring + tail, n, ring);
+
+        tail  = (tail + words) & CAN_DMA_MASK;
+        avail -= words + 2;
+        rpos  += words + 2;
+        count++;
+    }
+
+    pCAN->dma_rx_rpos = rpos;
+    pCAN->stats.rx_msgs += count;
+
+    return count;
+}
+
+static void ls2k_can_dma_rx_callback(struct dma_chnl_cfg *cfg, int bytes, unsigned int status)
+{
+    CAN_t *pCAN = (CAN_t *)cfg->device;
+    int count = 0;
+
+    if (status & (DMA_SR_HALF | DMA_SR_DONE))
+    {
+        if (status & DMA_SR_HALF)
+            pCAN->dma_rx_halves++;
+        if (status & DMA_SR_DONE)
+            pCAN->dma_rx_halves++;
+
+        count = ls2k_can_dma_rx_parse(pCAN);
+    }
+
+    if (status & DMA_SR_ERROR)
+    {
+        pCAN->stats.rxbuf_errors++;
+        pCAN->status |= CAN_STATUS_BUF_ERROR;
+        ls2k_can_dma_rx_reset(pCAN);
+    }
+
+    if ((count > 0) && osal_is_osrunning())
+    {
+        osal_event_send(pCAN->p_event, CAN_RX_EVENT);
+    }
+}
+
+static int ls2k_can_dma_rx_start(CAN_t *pCAN)
+{
+    struct dma_chnl_cfg *cfg = &pCAN->rx_dma_cfg;
+
+    if (pCAN->dma_active)
+        return 0;
+
+    /*
+     * ͨһֱռ, ´ʱʹ
+     */
+    if (pCAN->rx_chnl < 0)
+    {
+        if (dma_claim_channel(ls2k_can_dma_devnum(pCAN), &pCAN->rx_chnl, NULL) != 0)
+        {
+            pCAN->rx_chnl = -1;
+            printk("%s: no idle DMA channel\r\n", pCAN->dev_name);
+            return -1;
+        }
+    }
+
+    /*
+     * жڹر CAN ʱͷ, ʱظʹ
+     */
+    if (!pCAN->dma_rxbuf)
+    {
+        pCAN->dma_rxbuf = (unsigned int *)aligned_malloc(CAN_DMA_WORDS * 4, 64);
+        if (!pCAN->dma_rxbuf)
+            return -1;
+    }
+
+    clean_dcache_nowrite((unsigned long)pCAN->dma_rxbuf, CAN_DMA_WORDS * 4);
+    pCAN->dma_rx_rpos = 0;
+    pCAN->dma_rx_halves = 0;
+
+    memset(cfg, 0, sizeof(struct dma_chnl_cfg));
+    cfg->chNum      = pCAN->rx_chnl;
+    cfg->devNum     = ls2k_can_dma_devnum(pCAN);
+    cfg->device     = pCAN;
+    cfg->memAddr    = (unsigned)(uintptr_t)pCAN->dma_rxbuf;
+    cfg->transbytes = CAN_DMA_WORDS * 4;
+    cfg->cb         = ls2k_can_dma_rx_callback;
+
+    cfg->ccr.tcie = 1;              // trans done int-enable
+    cfg->ccr.htie = 1;              // trans half int-enable
+    cfg->ccr.teie = 1;              // trans error int-enable
+    cfg->ccr.dir  = 0;              // 0: peripheral to mem
+    cfg->ccr.circ = 1;              // circle mode
+    cfg->ccr.pinc = 0;              // 1=auto inc peripheral address
+    cfg->ccr.minc = 1;              // 1=auto inc mem address
+    cfg->ccr.psize = 2;             // peripheral data width: 2=32bits
+    cfg->ccr.msize = 2;             // memory data width:     2=32bits
+    cfg->ccr.priority = 2;          // channel priority: high
+
+    if (dma_start(cfg, 0) != 0)
+        return -1;
+
+    pCAN->dma_active = 1;
+
+    return 0;
+}
+
+static void ls2k_can_dma_rx_stop(CAN_t *pCAN)
+{
+    if (pCAN->dma_active)
+    {
+        dma_stop(pCAN->rx_chnl);
+        pCAN->rx_dma_cfg.ccr.en = 0;
+        pCAN->dma_active = 0;
+    }
+}
+
+#endif // #if CAN_USE_DMA
+
+/**
+ * Interrupt Handler
+ */
+STATIC_DRV int CAN_close(const void *dev, void *arg);
+
+static void ls2k_can_interrupt_handler(int vector, void *arg)
+{
+	unsigned int isr0, isr, ien;
+    int rx_flag=0, tx_flag=0;
+	CANMsg_t *msg;
+    CAN_t *pCAN = (CAN_t *)arg;
+
+    if (NULL == pCAN)
+    {
+        return;
+    }
+
+	pCAN->stats.ints++;
+	ien = pCAN->hwCAN->ien;
+	isr0 = isr = pCAN->hwCAN->isr;
+	isr &= ien;
+
+	while (isr != 0)
+	{
+		/**
+         * Receive Packet
+		 */
+		if (isr & (CAN_ISR_RX | CAN_ISR_RXF | CAN_ISR_RBNE))
+		{
+		    unsigned int rxsr, prop_cnt;
+
+            rxsr = pCAN->hwCAN->rxsr;
+		    prop_cnt = (rxsr & CAN_RXSR_FRC_MASK) >> CAN_RXSR_FRC_SHIFT;
+
+            while (prop_cnt-- > 0) // && !(rxsr & CAN_RXSR_RXE))
+            {
+                ls2k_can_receive_message(pCAN, 0);
+
+			    pCAN->stats.rx_msgs++;
+
+			    /*
+                 * signal the semaphore only once
+			     */
+                rx_flag = 1;
+
+                /*
+                 * continue;
+                 */
+            }
+
+			/*
+             * Re-Enable RX buffer for a new message
+			 */
+		    // pCAN->hwCAN->cmd = CAN_CMD_RELEASERXBUF;
+		    debug_prt("RXI\r\n");
+		}
+
+		/**
+         * Send Packet Done
+		 */
+		if (isr & CAN_ISR_TX)
+		{
+			/*
+             * there is room in tx fifo of HW
+			 */
+			if (!can_fifo_empty(pCAN->txfifo))
+			{
+				/*
+                 * send 1 more messages
+				 */
+				msg = can_fifo_claim_get(pCAN->txfifo);
+
+				if (ls2k_can_send_msg(pCAN, msg))
+				{
+					/* ERROR! We got an TX interrupt telling us tx fifo is empty,
+					 * yet it is not. Complain about this max 10 times
+					 */
+					if (pCAN->stats.txbuf_errors < 10)
+					{
+						TRACE("%s: got TX interrupt but TX fifo in not empty", pCAN->dev_name);
+					}
+
+					pCAN->status |= CAN_STATUS_BUF_ERROR;
+					pCAN->stats.txbuf_errors++;
+				}
+
+				/*
+                 * free software-fifo space taken by sent message
+				 */
+				can_fifo_get(pCAN->txfifo);
+
+				pCAN->stats.tx_msgs++;
+
+				/*
+                 * wake any sleeping thread waiting for "fifo not full"
+				 */
+                tx_flag = 1;
+
+                /*
+                 * continue;
+                 */
+			}
+
+			debug_prt("TXI\r\n");
+		}
+
+		/**
+         * Error & Warn Interrupt
+		 */
+		if (isr & CAN_ISR_EWL)
+		{
+            pCAN->hwCAN->cmd |= CAN_CMD_ERCRST;
+
+			pCAN->stats.err_ewl++;
+			TRACE("%s: EWL", pCAN->dev_name);
+		}
+
+		if (isr & CAN_ISR_DO)
+		{
+		    pCAN->hwCAN->cmd |= CAN_CMD_RRB;
+			pCAN->stats.err_dover++;
+			TRACE("%s: RxOV", pCAN->dev_name);
+		}
+
+		if (isr & CAN_ISR_FCS)
+		{
+			pCAN->stats.err_fcs++;
+			TRACE("%s: FCS", pCAN->dev_name);
+		}
+
+		if (isr & CAN_ISR_AL)
+		{
+            unsigned int alc = pCAN->hwCAN->alc;
+
+            switch (alc & CAN_ALC_ID_MASK)
+            {
+                case CAN_ALC_BASE_ID:
+                    pCAN->stats.alc_base_id++;
+                    pCAN->stats.alc_bit_pos[alc & 0x1F]++;
+                    break;
+
+                case CAN_ALC_SRR_RTR:
+                    pCAN->stats.alc_srr_rtr++;
+                    break;
+
+                case CAN_ALC_IDE:
+                    pCAN->stats.alc_ide++;
+                    break;
+
+                case CAN_ALC_EXTENSION:
+                    pCAN->stats.alc_ext++;
+                    pCAN->stats.alc_bit_pos[alc & 0x1F]++;
+                    break;
+
+                case CAN_ALC_RTR:
+                    pCAN->stats.alc_rtr++;
+                    break;
+            }
+
+            pCAN->stats.err_alost++;
+            TRACE("%s: AL 0x%02x", pCAN->dev_name, alc);
+		}
+
+		if (isr & CAN_ISR_BE)
+		{
+			unsigned int errcode = pCAN->hwCAN->errcapt;
+			errcode &= CAN_ECAPT_TYPE_MASK;
+			errcode >>= CAN_ECAPT_TYPE_SHIFT;
+
+			TRACE("%s: BUSE %02X", pCAN->dev_name, errcode);
+
+			/* Some kind of BUS error, only used for statistics.
+			 * Error Register is decoded and put into can->stats.
+			 */
+			switch (errcode)
+			{
+				case CAN_ETYPE_BIT:
+					pCAN->stats.err_bit++;
+					break;
+				case CAN_ETYPE_FRM:
+					pCAN->stats.err_form++;
+					break;
+				case CAN_ETYPE_STUP:
+					pCAN->stats.err_stuff++;
+					break;
+				case CAN_ETYPE_CRC:
+				    pCAN->stats.err_crc++;
+				    break;
+				case CAN_ETYPE_ACK:
+				    pCAN->stats.err_ack++;
+				    break;
+				default:
+					pCAN->stats.err_other++;
+					break;
+			}
+
+            errcode = pCAN->hwCAN->errcapt;
+            errcode &= CAN_ECAPT_POS_MASK;
+            if (errcode > 9) errcode = 9;
+			pCAN->stats.err_pos[errcode]++;
+			pCAN->stats.err_bus++;
+
+            /**
+             * BUS OFF, shut controller
+             */
+            if (pCAN->hwCAN->errsr & CAN_ERRSR_BUSOFF)
+            {
+                pCAN->status |= CAN_STATUS_BUS_OFF;
+                CAN_close(pCAN, NULL);
+            }
+            else
+            {
+                pCAN->hwCAN->cmd |= CAN_CMD_ERCRST;
+            }
+		}
+
+        if (isr & CAN_ISR_TXBHC)
+        {
+            pCAN->hwCAN->txcmd |= 1 << 16;
+            debug_prt("TXBHC\r\n");
+        }
+
+        /*
+         * write then clear
+         */
+        pCAN->hwCAN->isr = isr0;
+
+        /*
+         * re-read check for loop
+         */
+		isr0 = isr = pCAN->hwCAN->isr;
+		isr &= ien;
+
+	}	/* End of While. */
+
+	/**
+     * signal Binary semaphore, messages available!
+	 */
+    if (osal_is_osrunning())
+    {
+	    if (rx_flag)
+	    {
+	        osal_event_send(pCAN->p_event, CAN_RX_EVENT);
+	    }
+
+        if (tx_flag)
+	    {
+	        osal_event_send(pCAN->p_event, CAN_TX_EVENT);
+	    }
+	}
+}
+
+/******************************************************************************
+ * CAN Driver Implement
+ ******************************************************************************/
+
+extern int ls2k_can_init_hook(const void *dev);
+
+/**
+ * CAN_initialize
+ */
+STATIC_DRV int CAN_initialize(const void *dev, void *arg)
+{
+    CAN_t *pCAN = (CAN_t *)dev;
+
+	if (dev == NULL)
+    {
+        errno = EINVAL;
+    	return -1;
+    }
+
+    if (pCAN->initialized)
+        return 0;
+
+    /*
+     * Ÿ
+     */
+    ls2k_can_init_hook(dev);
+    
+    /*
+     * Clear CAN_t* first
+     */
+    pCAN->workmode = -1;
+    pCAN->baudrate = -1;
+    pCAN->rx_timeout = RXTX_TIMEOUT;
+    pCAN->tx_timeout = RXTX_TIMEOUT;
+    pCAN->timestamp_psc = 0;
+    pCAN->config_update = 0;
+    pCAN->cap_ring = NULL;
+#if CAN_USE_DMA
+    pCAN->rx_chnl = -1;
+    pCAN->dma_rxbuf = NULL;
+    pCAN->dma_active = 0;
+#endif
+
+    memset(&pCAN->speed, 0,  sizeof(CAN_speed_t));
+    memset(&pCAN->filter, 0, sizeof(CAN_filter_t));
+    memset(&pCAN->range, 0,  sizeof(CAN_range_t));
+
+    /*
+     * Reset the CAN Controller, Must reset first
+     */
+	ls2k_can_hw_reset(pCAN);
+
+    /*
+     * Set CAN default configures
+     */
+    pCAN->speed.Sample_pt = 80;
+    pCAN->speed.tPTS = 400;
+#if CAN_USE_FD
+    pCAN->fd_baudrate = -1;
+    memset(&pCAN->fd_speed, 0, sizeof(CAN_speed_t));
+    pCAN->fd_speed.Sample_pt = 75;
+#endif
+
+    ls2k_can_set_workmode(pCAN, 0);
+    ls2k_can_set_baudrate(pCAN, CAN_SPEED_500K);
+#if CAN_USE_FD
+    ls2k_can_set_fd_baudrate(pCAN, CAN_SPEED_2M);
+#endif
+    ls2k_can_set_filter(pCAN, NULL);
+    ls2k_can_set_range(pCAN, NULL);
+    ls2k_can_set_ts_psc(pCAN, 0);
+
+    /*
+     * Event
+     */
+    pCAN->p_event = osal_event_create(pCAN->dev_name, 0);
+    if (NULL == pCAN->p_event)
+    {
+        printk("create CAN event fail.\r\n");
+        return -1;
+    }
+
+	/*
+     * CAN interrupt handler
+	 */
+    ls2k_install_irq_handler(pCAN->irqNum, ls2k_can_interrupt_handler, (void *)pCAN);
+#if !USE_EXTINT
+    ls2k_set_irq_routeip(pCAN->irqNum, INT_ROUTE_IP3);
+#endif
+
+    pCAN->initialized = 1;
+
+    printk("CAN%i controller initialized.\r\n",
+            (VA_TO_PHYS(pCAN->hwCAN) == CAN0_BASE) ? 0 :
+            (VA_TO_PHYS(pCAN->hwCAN) == CAN1_BASE) ? 1 :
+            (VA_TO_PHYS(pCAN->hwCAN) == CAN2_BASE) ? 2 :
+            (VA_TO_PHYS(pCAN->hwCAN) == CAN3_BASE) ? 3 : -1);
+
+	return 0;
+}
+
+/**
+ * CAN_open
+ */
+STATIC_DRV int CAN_open(const void *dev, void *arg)
+{
+    CAN_t *pCAN = (CAN_t *)dev;
+
+	if (dev == NULL)
+    {
+        errno = EINVAL;
+    	return -1;
+    }
+
+    if (!pCAN->initialized)
+    {
+        errno = EIO;
+    	return -1;
+    }
+    
+    if (pCAN->opened)
+        return 0;
+
+	/*
+     * allocate fifos
+	 */
+#if CAN_USE_DMA
+    /*
+     * DMA ÿжϷ, ʹôһЩ rxfifo
+     */
+    if ((pCAN->workmode & CAN_MODE_RX_DMA) &&
+        pCAN->rxfifo && (pCAN->rxfifo->count < RX_FIFO_LEN_DMA))
+    {
+        can_fifo_free(pCAN->rxfifo);
+        pCAN->rxfifo = NULL;
+    }
+#endif
+
+    if (!pCAN->rxfifo)
+    {
+        int count = RX_FIFO_LEN;
+#if CAN_USE_DMA
+        if (pCAN->workmode & CAN_MODE_RX_DMA)
+            count = RX_FIFO_LEN_DMA;
+#endif
+		pCAN->rxfifo = can_fifo_create(count);
+		if (!pCAN->rxfifo)
+		{
+			errno = ENOMEM;
+			return -1;
+		}
+    }
+
+    if (!pCAN->txfifo)
+    {
+		pCAN->txfifo = can_fifo_create(TX_FIFO_LEN);
+		if (!pCAN->txfifo)
+		{
+			can_fifo_free(pCAN->rxfifo);
+			errno = ENOMEM;
+			return -1;
+		}
+    }
+
+	ls2k_can_hw_start(pCAN);
+
+    pCAN->opened = 1;
+	return 0;
+}
+
+/**
+ * CAN_close
+ */
+STATIC_DRV int CAN_close(const void *dev, void *arg)
+{
+    CAN_t *pCAN = (CAN_t *)dev;
+
+	if (dev == NULL)
+    {
+        errno = EINVAL;
+    	return -1;
+    }
+
+    if (!pCAN->opened)
+        return 0;
+
+	/*
+     * Stop CAN contoller, and set to reset mode
+	 */
+	ls2k_can_hw_stop(pCAN);
+
+#if 0
+    /*
+     * Release the Buffer. Ϊжڵ, ͷ. rtthread
+     */
+	can_fifo_free(pCAN->rxfifo);
+	can_fifo_free(pCAN->txfifo);
+#else
+	can_fifo_clear(pCAN->rxfifo);
+	can_fifo_clear(pCAN->txfifo);
+#endif
+
+    pCAN->opened = 0;
+	return 0;
+}
+
+/**
+ * CAN read
+ */
+STATIC_DRV int CAN_read(const void *dev, void *buf, int size, void *arg)
+{
+    int left = size, count;
+    CAN_t *pCAN = (CAN_t *)dev;
+    CANMsg_t *srcmsg, *dstmsg = (CANMsg_t *)buf;
+
+	/* does at least one message fit ?
+	 */
+	if ((dev == NULL) || (buf == NULL) || (left < sizeof(CANMsg_t)))
+    {
+        errno = EINVAL;
+    	return -1;
+    }
+
+    if (!pCAN->opened)
+    {
+        errno = EIO;
+        return -1;
+    }
+
+    /*
+     * messages go to capture ring
+     */
+    if (pCAN->cap_ring)
+    {
+        errno = EBUSY;
+        return -1;
+    }
+
+	while (left >= sizeof(CANMsg_t))
+	{
+		/*
+         * A bus off error may have occured after read
+		 */
+		if (pCAN->hwCAN->errsr & CAN_ERRSR_BUSOFF)
+		{
+		    errno = EIO;
+        	break;
+        }
+
+#if CAN_USE_DMA
+        /*
+         * ûе/жϵı
+         */
+        if (pCAN->dma_active && can_fifo_empty(pCAN->rxfifo))
+        {
+            loongarch_critical_enter();
+            ls2k_can_dma_rx_parse(pCAN);
+            loongarch_critical_exit();
+        }
+#endif
+
+		loongarch_critical_enter();
+		count = can_fifo_claim_get_n(pCAN->rxfifo, &srcmsg, left / sizeof(CANMsg_t));
+		loongarch_critical_exit();
+
+		if (!count)
+		{
+		    int tmo = pCAN->rx_timeout;
+		    unsigned int recv_event, wait_ms = OSAL_WAIT_FOREVER;
+
+			/* No more messages in reception fifo. Wait for incoming packets
+			 * return if no wait OR readed some messages.
+			 */
+			if ((tmo == 0) || (left != size))
+            	break;
+
+#if CAN_USE_DMA
+            if (pCAN->dma_active)
+                wait_ms = CAN_DMA_POLL_MS;
+#endif
+
+			/*
+             * wait for incomming messages...
+			 */
+            recv_event = osal_event_receive(pCAN->p_event,
+                                            CAN_RX_EVENT,
+                                            OSAL_EVENT_FLAG_AND | OSAL_EVENT_FLAG_CLEAR,
+                                            wait_ms );
+
+            if ((recv_event != CAN_RX_EVENT) && (wait_ms == OSAL_WAIT_FOREVER))
+            {
+                break;
+            }
+
+			/*
+             * no errors detected, it must be a message
+			 */
+			continue;
+		}
+
+		/*
+         * got messages, copy them to userspace buffer. RX interrupt does not
+         * overwrite claimed messages, it drops new ones when fifo is full
+		 */
+		memcpy(dstmsg, srcmsg, count * sizeof(CANMsg_t));
+
+		/*
+         * Return borrowed messages, RX interrupt can use them again
+		 */
+        {
+		    loongarch_critical_enter();
+		    can_fifo_get_n(pCAN->rxfifo, count);
+		    loongarch_critical_exit();
+		}
+
+		left -= count * sizeof(CANMsg_t);
+		dstmsg += count;
+	}
+
+    return size - left;
+}
+
+/**
+ * CAN write
+ */
+STATIC_DRV int CAN_write(const void *dev, void *buf, int size, void *arg)
+{
+    int left = size;
+    CAN_t *pCAN = (CAN_t *)dev;
+    CANMsg_t *msg = (CANMsg_t *)buf, *fifo_msg;
+    unsigned int txsr;
+
+	if ((dev == NULL) || (buf == NULL) || (left < sizeof(CANMsg_t)))
+    {
+        errno = EINVAL;
+    	return -1;
+    }
+
+    if (!pCAN->opened)
+    {
+        errno = EIO;
+        return -1;
+    }
+    
+	/*
+     * A bus off may have occured before being send
+	 */
+	if (pCAN->hwCAN->errsr & CAN_ERRSR_BUSOFF)
+    {
+        errno = ENETDOWN;
+    	return -2;
+    }
+
+    /*
+     * is device idle?
+	 */
+    txsr = pCAN->hwCAN->txsr & CAN_TXSR_MASK;
+
+	/**
+     * If no messages in software tx fifo, we will try to send first message
+	 * by putting it directly into the HW TX fifo.
+	 */
+	if ((txsr == CAN_TXSR_IDLE) && can_fifo_empty(pCAN->txfifo))
+	{
+		if (ls2k_can_send_msg(pCAN, msg) == 0)
+		{
+			/* First message put directly into HW TX fifo, This will turn TX interrupt on.
+			 */
+			left -= sizeof(CANMsg_t);
+			msg++;
+
+			pCAN->stats.tx_msgs++;
+		}
+	}
+
+	/**
+     * Put messages into software fifo
+	 */
+	while (left >= sizeof(CANMsg_t))
+	{
+		fifo_msg = can_fifo_put_claim(pCAN->txfifo, 0);
+
+		if (!fifo_msg)
+		{
+		    int tmo = pCAN->tx_timeout;
+		    unsigned int recv_event;
+
+            /* Waiting only if no messages previously sent.
+             * return if no wait OR written some messages.
+			 */
+			if ((tmo == 0) || (left != size))
+            	break;
+
+			/*
+             * wait for messages sent...
+			 */
+            recv_event = osal_event_receive(pCAN->p_event,
+                                            CAN_TX_EVENT,
+                                            OSAL_EVENT_FLAG_AND | OSAL_EVENT_FLAG_CLEAR,
+                                            OSAL_WAIT_FOREVER );
+
+            if (recv_event != CAN_TX_EVENT)
+            {
+                break;
+            }
+
+			/*
+             * did we get woken up by a BUS OFF error?
+			 */
+			if (pCAN->hwCAN->errsr & CAN_ERRSR_BUSOFF)
+			{
+                errno = ENETDOWN;
+				break;
+			}
+
+			if (can_fifo_empty(pCAN->txfifo))
+			{
+				if (!ls2k_can_send_msg(pCAN, msg))
+				{
+					/* First message put directly into HW TX fifo
+					 * This will turn TX interrupt on.
+					 */
+					left -= sizeof(CANMsg_t);
+					msg++;
+
+					pCAN->stats.tx_msgs++;
+				}
+			}
+
+			continue;
+		}
+
+		/* copy message into fifo area
+		 */
+		*fifo_msg = *msg;
+
+		/* tell interrupt handler about the message
+		 */
+		can_fifo_put(pCAN->txfifo);
+
+		/* Prepare insert of next message
+		 */
+		msg++;
+		left -= sizeof(CANMsg_t);
+	}
+
+    return size - left;
+}
+
+/**
+ * CAN control
+ */
+#define CAN_OPENED_BREAK    if (pCAN->opened)  { errno = EBUSY;  rt = -1; break; }
+#define PTR_NULL_BREAK(ptr) if (ptr == NULL)   { errno = EINVAL; rt = -1; break; }
+
+STATIC_DRV int CAN_ioctl(const void *dev, int cmd, void *arg)
+{
+    int rt = 0;
+    unsigned int val;
+    CAN_t *pCAN = (CAN_t *)dev;
+
+	if (dev == NULL)
+    {
+        errno = EINVAL;
+    	return -1;
+    }
+
+	switch (cmd)
+	{
+		case IOCTL_CAN_SET_WORKMODE:
+		    CAN_OPENED_BREAK;
+		    rt = ls2k_can_set_workmode(pCAN, (unsigned int)(uintptr_t)arg);
+		    break;
+
+		case IOCTL_CAN_SET_BAUDRATE:
+		    CAN_OPENED_BREAK;
+		    rt = ls2k_can_set_baudrate(pCAN, (int)(uintptr_t)arg);
+		    break;
+
+#if CAN_USE_FD
+		case IOCTL_CAN_SET_FD_BAUDRATE:
+		    CAN_OPENED_BREAK;
+		    rt = ls2k_can_set_fd_baudrate(pCAN, (int)(uintptr_t)arg);
+		    break;
+#endif
+
+		case IOCTL_CAN_SET_FILTER:
+		    CAN_OPENED_BREAK;
+		    PTR_NULL_BREAK(arg);
+		    rt = ls2k_can_set_filter(pCAN, (CAN_filter_t *)arg);
+		    break;
+
+		case IOCTL_CAN_SET_RANGE:
+		    CAN_OPENED_BREAK;
+		    PTR_NULL_BREAK(arg);
+		    rt = ls2k_can_set_range(pCAN, (CAN_range_t *)arg);
+		    break;
+
+		case IOCTL_CAN_SET_SAMPLEPT:
+            CAN_OPENED_BREAK;
+            pCAN->speed.Sample_pt = (int)(uintptr_t)arg;
+            break;
+
+		case IOCTL_CAN_SET_PROP_NS:
+		    CAN_OPENED_BREAK;
+		    pCAN->speed.tPTS = (int)(uintptr_t)arg;
+		    break;
+
+		case IOCTL_CAN_SET_TS_PSC:
+		    CAN_OPENED_BREAK;
+		    rt = ls2k_can_set_ts_psc(pCAN, (unsigned int)(uintptr_t)arg);
+		    break;
+
+		case IOCTL_CAN_SET_CAPTURE:
+		    CAN_OPENED_BREAK;
+		    rt = ls2k_can_set_capture(pCAN, (CAN_capture_t *)arg);
+		    break;
+
+		case IOCTL_CAN_GET_CUR_TS:
+		    PTR_NULL_BREAK(arg);
+		    *((unsigned int *)arg) = pCAN->hwCAN->ts & CAN_TS_CURRENT_MASK;
+		    break;
+
+		case IOCTL_CAN_GET_STATS:
+		    PTR_NULL_BREAK(arg);
+		    rt = ls2k_can_get_statics(pCAN, (CAN_stats_t **)arg);
+		    break;
+
+		case IOCTL_CAN_GET_STATUS:
+		    PTR_NULL_BREAK(arg);
+		    rt = ls2k_can_get_status(pCAN, (unsigned int *)arg);
+		    break;
+
+		case IOCTL_CAN_SET_RX_TMO:
+		    val = (unsigned int)(uintptr_t)arg;
+		    pCAN->rx_timeout = val < 1000 ? val : 1000;
+		    break;
+
+		case IOCTL_CAN_SET_TX_TMO:
+		    val = (unsigned int)(uintptr_t)arg;
+		    pCAN->tx_timeout = val < 1000 ? val : 1000;
+		    break;
+
+		case IOCTL_CAN_GET_BUFS:
+		    PTR_NULL_BREAK(arg);
+		    *((unsigned int *)arg) = pCAN->rxfifo ? pCAN->rxfifo->count : RX_FIFO_LEN;
+		    break;
+
+		default:
+		    errno = ENOTSUP;
+			rt = -1;
+			break;
+	}
+
+	return rt;
+}
+
+/******************************************************************************
+ * CAN driver operators
+ ******************************************************************************/
+ 
+#if (PACK_DRV_OPS)
+static const driver_ops_t ls2k_can_drv_ops =
+{
+    .init_entry  = CAN_initialize,
+    .open_entry  = CAN_open,
+    .close_entry = CAN_close,
+    .read_entry  = CAN_read,
+    .write_entry = CAN_write,
+    .ioctl_entry = CAN_ioctl,
+};
+
+const driver_ops_t *can_drv_ops = &ls2k_can_drv_ops;
+#endif
+
+/******************************************************************************
+ * device name
+ */
+const char *ls2k_can_get_device_name(const void *pCAN)
+{
+    if (NULL == pCAN)
+        return NULL;
+
+    return ((CAN_t *)pCAN)->dev_name;
+}
+
+/******************************************************************************
+ * capture ring reader
+ */
+int ls2k_can_capture_claim(const void *dev, CANCapture_t **recs, int max, unsigned int timeout_ms)
+{
+    CAN_t *pCAN = (CAN_t *)dev;
+    unsigned int head, tail, n;
+
+    if ((pCAN == NULL) || (recs == NULL) || (max <= 0) || (pCAN->cap_ring == NULL))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    for ( ; ; )
+    {
+        unsigned int wait_ms = timeout_ms, recv_event;
+
+#if CAN_USE_DMA
+        if (pCAN->dma_active)
+        {
+            loongarch_critical_enter();
+            ls2k_can_dma_rx_parse(pCAN);
+            loongarch_critical_exit();
+        }
+#endif
+
+        head = __atomic_load_n(&pCAN->cap_head, __ATOMIC_ACQUIRE);
+        tail = pCAN->cap_tail;
+
+        if (head != tail)
+            break;
+
+        if ((timeout_ms == 0) || !pCAN->opened)
+            return 0;
+
+#if CAN_USE_DMA
+        /*
+         *  DMA ı, Ҫٽ
+         */
+        if (pCAN->dma_active && (wait_ms > CAN_DMA_POLL_MS))
+            wait_ms = CAN_DMA_POLL_MS;
+#endif
+
+        recv_event = osal_event_receive(pCAN->p_event,
+                                        CAN_RX_EVENT,
+                                        OSAL_EVENT_FLAG_AND | OSAL_EVENT_FLAG_CLEAR,
+                                        wait_ms );
+
+        if (recv_event != CAN_RX_EVENT)
+        {
+            if (wait_ms == timeout_ms)
+                return 0;
+            if (timeout_ms != OSAL_WAIT_FOREVER)
+                timeout_ms -= wait_ms;
+        }
+    }
+
+    /*
+     * ļ¼,  ring ĩβΪֹ
+     */
+    n = head - tail;
+    if (n > pCAN->cap_mask + 1 - (tail & pCAN->cap_mask))
+        n = pCAN->cap_mask + 1 - (tail & pCAN->cap_mask);
+    if (n > (unsigned int)max)
+        n = max;
+
+    *recs = &pCAN->cap_ring[tail & pCAN->cap_mask];
+
+    return (int)n;
+}
+
+int ls2k_can_capture_release(const void *dev, int count)
+{
+    CAN_t *pCAN = (CAN_t *)dev;
+    unsigned int tail;
+
+    if ((pCAN == NULL) || (pCAN->cap_ring == NULL) || (count < 0))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    tail = pCAN->cap_tail;
+    if ((unsigned int)count > pCAN->cap_head - tail)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    __atomic_store_n(&pCAN->cap_tail, tail + count, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+#endif // #if BSP_USE_CAN
+
+//-----------------------------------------------------------------------------
+/*
+ * @@ End
+ */
+
+
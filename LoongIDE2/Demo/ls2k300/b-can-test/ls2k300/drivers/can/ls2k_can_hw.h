@@ -0,0 +1,673 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_can_hw.h
+ *
+ * created: 2024-06-11
+ *  author: Bian
+ */
+
+#ifndef _LS2K_CAN_HW_H
+#define _LS2K_CAN_HW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// CAN 豸
+//-------------------------------------------------------------------------------------------------
+
+#define CAN0_BASE		0x16110000
+#define CAN1_BASE		0x16110400
+#define CAN2_BASE		0x16110800
+#define CAN3_BASE		0x16110C00
+
+/*
+ * CAN 
+ */
+typedef struct
+{
+	volatile unsigned int id;				/* 0x00 CR_ID CANFD ID == 0x2babe */
+	volatile unsigned int mode;				/* 0x04 CR_MODE ģʽüĴ */
+	volatile unsigned int set;				/* 0x08 CR_SET üĴ */
+	volatile unsigned int status;			/* 0x0c CR_STAT ״̬Ĵ */
+	volatile unsigned int cmd;				/* 0x10 CR_CMD Ĵ */
+	volatile unsigned int isr;				/* 0x14 INT_STAT ж״̬Ĵ */
+	volatile unsigned int ien;				/* 0x18 INT_ENA жʹܼĴ */
+	volatile unsigned int imask;			/* 0x1c INT_MASK ж״̬μĴ */
+	volatile unsigned int btrnormal;		/* 0x20 BTR_NORM ׼üĴ */
+	volatile unsigned int btrfd;			/* 0x24 BTR_FD FD üĴ */
+	volatile unsigned int errl;				/* 0x28 ERL ֵüĴ */
+	volatile unsigned int errsr;			/* 0x2c FSTAT ״̬Ĵ */
+	volatile unsigned int errcnt;			/* 0x30 ERC Ĵ */
+	volatile unsigned int brerr;			/* 0x34 BRE ʴĴ */
+	volatile unsigned int ctrpres;			/* 0x38 CTR_PRES ԼĴ */
+	volatile unsigned int errcapt;			/* 0x3c ERR_CAPT ׽״̬Ĵ */
+	volatile unsigned int retxcnt;			/* 0x40 RETX_CNT طĴ */
+	volatile unsigned int alc;				/* 0x44 ALC ʧȥٲò׽Ĵ */
+	volatile unsigned int trvdly;			/* 0x48 TRV_DLY ӳٲĴ */
+	volatile unsigned int sspcfg;			/* 0x4c SSP_CFG ڶüĴ */
+	volatile unsigned int rxfrcnt;			/* 0x50 RX_FR_CNT ձļĴ */
+	volatile unsigned int txfrcnt;			/* 0x54 TX_FR_CNT ͱļĴ */
+	volatile unsigned int debug;			/* 0x58 DEBUG ԼĴ */
+	volatile unsigned int ts;				/* 0x5c TS ʱĴ */
+	volatile unsigned int txfrmtst;			/* 0x60 TX_FRM_TST ͱĵԼĴ */
+	volatile unsigned int frcdiv;			/* 0x64 FRC_DIV СƵϵĴ */
+	volatile unsigned int fltmaskA;			/* 0x68 FLT_A_MASK A Ĵ */
+	volatile unsigned int fltvalA;			/* 0x6c FLT_A_VAL A ֵĴ */
+	volatile unsigned int fltmaskB;			/* 0x70 FLT_B_MASK B Ĵ */
+	volatile unsigned int fltvalB;			/* 0x74 FLT_B_VAL B ֵĴ */
+	volatile unsigned int fltmaskC;			/* 0x78 FLT_C_MASK C Ĵ */
+	volatile unsigned int fltvalC;			/* 0x7c FLT_C_VAL C ֵĴ */
+	volatile unsigned int fltrlo;			/* 0x80 FLT_R_LOW ΧֵĴ */
+	volatile unsigned int fltrhi;			/* 0x84 FLT_R_HI ΧֵĴ */
+	volatile unsigned int fltctrl;			/* 0x88 FLT_CTRL ƼĴ */
+	volatile unsigned int rxmeminfo;		/* 0x8c RX_MEM_INFO ջϢĴ */
+	volatile unsigned int rxprt;			/* 0x90 RX_PRT ջָĴ */
+	volatile unsigned int rxsr;				/* 0x94 RX_STAT ջ״̬Ĵ */
+	volatile unsigned int rxdata;			/* 0x98 RX_DATA ݼĴ */
+	volatile unsigned int txsr;				/* 0x9c TX_STAT ͻ״̬Ĵ */
+	volatile unsigned int txcmd;			/* 0xa0 TX_CMD ƼĴ */
+	volatile unsigned int txsel;			/* 0xa4 TX_SEL ͻѡĴ */
+	volatile unsigned int rsv[2];
+	/*
+     * 0xb0~0xf4 ݻ
+     */
+    volatile unsigned int head0;            /* 0xb0 T0 */
+    volatile unsigned int head1;            /* 0xb4 T1 */
+	volatile unsigned int txdata[16];       /* 0xb8~0xf4 16*4 64ֽ */
+
+} HW_CAN_t;
+
+//-----------------------------------------------------------------------------
+
+/*
+ * Message T0
+ */
+typedef struct
+{
+    union
+    {
+        struct
+        {
+	       unsigned int id  :29;	/* bit[0:28] ID, XTD Ϊ1 ʱ[28:0]λΪЧλ; XTD Ϊ0 ʱ[28:18]λΪЧλ. */
+	       unsigned int rtr :1;		/* bit[29] Remote Transmission Request λ, CAN2.0 ֡Ч. */
+	       unsigned int xtd :1;		/* bit[30] Extended Identifier Type λ. */
+	       unsigned int esi :1;		/* bit[31] Error State Indicatorλ, ձбʾӦͽڵĴ״̬, CANFD ֡Ч.*/
+        };
+
+        unsigned int value;
+    };
+} MSGT0_t;
+
+/*
+ * Message T1, 4 bytes
+ */
+
+typedef struct
+{
+    union
+    {
+        struct
+        {
+	       unsigned int timestamp :16;  /* bit[0:15] ʱ. ڽձбʾʱ̵ʱ; 
+                                         *           ڷͱбʾʱ͵ʱ, TTTM Ϊ1 ʱЧ. */
+	       unsigned int dlc :4;		    /* bit[16:19] Data Length Code. ݳ. */
+	       unsigned int brs :1;		    /* bit[20] Bit Rate Shift λ, CANFD ֡Ч.
+                                         *         Ϊ1 ʱл; Ϊ0 ʱĲл. */
+	       unsigned int fdf :1;		    /* bit[21] Flexible Data-rate Format λ.
+                                         *         Ϊ1 ʱΪCANFD ; Ϊ0 ʱΪCAN2.0. */
+	       unsigned int res :2;
+	       unsigned int rxwords :5;		/* bit[24:28] Read Word Counter, ձ(32 λ). XXX ձ */
+        };
+
+        unsigned int value;
+    };
+} MSGT1_t;
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * CANFD ID(CR_ID) OFFSET: 0x00
+ */
+#define CAN_VER_MASK			(0xFFFF<<16)	/* RO bit[31:16] 汾. ڶ. */
+#define CAN_ID_MASK				0xFFFF			/* RW bit[15:0] 豸ID. ĬID Ϊ0xbabe, CR_SET[ENA]=0 ʱид. */
+
+/**
+ * ģʽüĴ(CR_MODE) OFFSET: 0x04
+ */
+#define CAN_MODE_BUFM			bit(13)			/* RW ͻģʽ. 0: ʹⲿ; 1: ʹÿڲͻ. */
+#define CAN_MODE_RTSOP			bit(12)			/* RW ջʱģʽ. 0: ʱڱĽսʱ;
+                                                 *    1: ʱڱĽտʼʱ.
+                                                 */
+#define CAN_MODE_ITSM			bit(10)			/* RW ڲʱģʽ. 0: ʹϵͳʱ; 1: ʹÿڲɵʱ. */
+#define CAN_MODE_RXBAM			bit(9)			/* RW ջԶģʽ. 0: ڶȡջݺָ벻ƶ;
+                                                 *    1: ڶȡջݺָԶ1.
+                                                 */
+#define CAN_MODE_TSTM			bit(8)			/* RW ģʽ. ڴģʽ, ɶԿе. */
+#define CAN_MODE_ACF			bit(7)			/* RW ACK ģʽ. ڴģʽ, ACK, ʹУͨ. */
+#define CAN_MODE_ROM			bit(6)			/* RW Ʋģʽ. Restricted operation mode. 0: ر; 1: . */
+#define CAN_MODE_TTTM			bit(5)			/* RW ʱģʽ. ģʽʹʱ, 0 ͻеıĽָʱ䷢.
+                                                 *    0: ر; 1: .
+                                                 */
+#define CAN_MODE_FDE		    bit(4)			/* RW CANFD ʹ. 0: ֧CANFD ĸʽ; 1: ֧CANFD ĸʽ. */
+#define CAN_MODE_AFM			bit(3)			/* RW չģʽ. ģʽʹʱ, ˺ıĴ뻺.
+                                                 *    0: رսչ; 1: ʹܽչ.
+                                                 */
+#define CAN_MODE_STM			bit(2)			/* RW Բģʽ. ģʽʹʱ, ǷضACK λ, Ϊͳɹ.
+                                                 * 0: ر; 1: .
+                                                 */
+#define CAN_MODE_BMM			bit(1)			/* RW ߼ģʽ. Bus monitoring mode, ģʽ, ߷λ.
+                                                 * 0: ر; 1: .
+                                                 */
+#define CAN_MODE_RST			bit(0)			/* RW λ. д1 򿪸λ; д0 رոλ. */
+
+/**
+ * üĴ(CR_SET) OFFSET: 0x08
+ */
+#define CAN_SET_FDRF			bit(10)			/* RW Զ֡ʹ. ʹʱ, չԶ֡. */
+#define CAN_SET_PEX				bit(8)			/* RW Э⴦. CR_SET[ENA]ر״̬¿ɸд.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: r0 λضλʱ, ֡; 
+                                                 *    1: r0 λضλʱ, ״̬. */
+#define CAN_SET_NISOFD			bit(7)			/* RW NON-ISO CANFD Эʹ. CR_SET[ENA]ر״̬¿ɸд.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: ISO CANFD Э; 1: NON-ISO CANFD Э. */
+#define CAN_SET_ENABLE			bit(6)			/* RW ʹ. 0: ر; 1: . */
+#define CAN_SET_ILBP			bit(5)			/* RW ڲģʽ. ڿͱʱ, ͵ıĴͬһĽջ.
+                                                 *    0: ر; 1: . */
+#define CAN_SET_RTXTH_MASK		0x1E			/* RW bit[4:1] شֵ. ´ֵ. */
+#define CAN_SET_RTXTH_SHIFT		1
+#define CAN_SET_RTXLE			bit(0)			/* RW شֵʹ */
+
+/**
+ * ״̬Ĵ(CR_STAT) OFFSET: 0x0c
+ */
+#define CAN_SR_STCNT			bit(16)			/* RO ֧. 0: ֧; 1: ֧. */
+#define CAN_SR_PEXS				bit(8)			/* RO Э״̬. Эʱ1, CR_CMD[CPEXS]д1 ״̬. */
+#define CAN_SR_IDLE				bit(7)			/* RO ߿б־. ߿лBUS_OFF ״̬ʱΪ1. */
+#define CAN_SR_EWL				bit(6)			/* RO ֵ־. TEC(TX Error Counter)REC(RX Error Counter)ﵽ
+                                                 *    򳬹EWL(Error Warning Limit)ʱΪ1. */
+#define CAN_SR_TX			    bit(5)			/* RO ״̬־. ǰڷ״̬. */
+#define CAN_SR_RX			    bit(4)			/* RO ״̬־. ǰڽ״̬. */
+#define CAN_SR_EFT				bit(3)			/* RO ֡־. ǰڷʹ֡. */
+#define CAN_SR_DOR				bit(1)			/* RO ״̬. ʱ1, CR_CMD[RRB]д1 ״̬,
+                                                 *    ʱ浱ǰձ.
+                                                 */
+#define CAN_SR_RXNE				bit(0)			/* RO ջǿ״̬ */
+
+/**
+ * Ĵ(CR_CMD) OFFSET: 0x10
+ */
+#define CAN_CMD_CPEXS			bit(7)			/* WO ״̬. д1 Э״̬(CR_STAT[PEXS]). */
+#define CAN_CMD_TXFCRST			bit(6)			/* WO ͱļ. ͱļ(TX_FR_CNT). */
+#define CAN_CMD_RXFCRST			bit(5)			/* WO ձļ. ձļ(RX_FR_CNT). */
+#define CAN_CMD_ERCRST			bit(4)			/* WO . ڿBUS_OFF ȴ¼ʱ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    ڽBUS_OFF ǰʱд1, ЧһκʧЧ. */
+#define CAN_CMD_CDO				bit(3)			/* WO ״̬. д1 ״̬. */
+#define CAN_CMD_RRB				bit(2)			/* WO ջͷ. д1 ջָ뼰ձļ,
+                                                 *    ״̬.
+                                                 */
+#define CAN_CMD_RXRPMV			bit(1)			/* WO ջȡָƶ. д1 ջĶȡָ1 λ.
+                                                 *    CR_MODE[RXBAM]Ϊ1 ʱ, ջĶȡָһζȡԶ1 λ.
+                                                 */
+
+//-------------------------------------------------------------------------------------------------
+// CAN ж
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * ж״̬Ĵ(INT_STAT) OFFSET: 0x14
+ */
+#define CAN_ISR_DMAD			bit(12)			/* RW DMA ж״̬. һıĴӽջλ1,
+                                                 *    д1 ж.
+                                                 */
+#define CAN_ISR_OF				bit(11)			/* RW ֡ж״̬. ͹֡ʱλ1, ڷ͹֡ʱд1 ж. */
+#define CAN_ISR_TXBHC			bit(10)			/* RW ͻӲж״̬. ɻʧʱλ1, д1 ж. */
+#define CAN_ISR_RBNE			bit(9)			/* RW ջǿж״̬. ջǿʱλ1, Ϊʱд1 ж. */
+#define CAN_ISR_BS				bit(8)			/* RW λлж״̬. λʷлʱλ1, д1 ж. */
+#define CAN_ISR_RXF				bit(7)			/* RW ջж״̬. ջΪʱλ1, д1 ж. */
+#define CAN_ISR_BE				bit(6)			/* RW ߴж״̬. ߷ʱλ1, д1 ж. */
+#define CAN_ISR_AL				bit(5)			/* RW ʧȥٲж״̬. ״̬ʧȥٲʱλ1, д1 ж. */
+#define CAN_ISR_FCS				bit(4)			/* RW ״̬ıж״̬. ״̬ERROR_ACTIVEERROR_PASSIVE
+                                                 *    BUS_OFF״̬лʱж, д1 ж.
+                                                 */
+#define CAN_ISR_DO				bit(3)			/* RW ж״̬. ջΪʱдݴλ1, д1 ж.
+                                                 *    жǰCR_CMD[RRB]д1 ͷŽջ.
+                                                 */
+#define CAN_ISR_EWL				bit(2)			/* RW 󾯸ֵж״̬. ERROR_ACTIVE״̬TECRECﵽԽEWLʱλ1,
+                                                 *    д1 ж.
+                                                 */
+#define CAN_ISR_TX				bit(1)			/* RW ķж״̬. ĳɹʱλ1, д1 ж. */
+#define CAN_ISR_RX				bit(0)			/* RW Ľж״̬. ĳɹʱλ1, д1 ж. */
+
+/**
+ * жʹܼĴ(INT_ENA) OFFSET: 0x18
+ */
+/*
+ * 28:16 ENA_CLR WO жʹ. д1 жʹ
+ */
+#define CAN_ICLR_DMAD			bit(28)			/* DMAD жʹ; */
+#define CAN_ICLR_OF				bit(27)			/* OFI жʹ; */
+#define CAN_ICLR_TXBHC			bit(26)			/* TXBHCI жʹ; */
+#define CAN_ICLR_RBNE			bit(25)			/* RBNEI жʹ; */
+#define CAN_ICLR_BS				bit(24)			/* BSI жʹ; */
+#define CAN_ICLR_RXF			bit(23)			/* RXFI жʹ; */
+#define CAN_ICLR_BE				bit(22)			/* BEI жʹ; */
+#define CAN_ICLR_AL				bit(21)			/* ALI жʹ; */
+#define CAN_ICLR_FCS			bit(20)			/* FCSI жʹ; */
+#define CAN_ICLR_DO				bit(19)			/* DOI жʹ; */
+#define CAN_ICLR_EWL			bit(18)			/* EWLI жʹ; */
+#define CAN_ICLR_TX				bit(17)			/* TXI жʹ; */
+#define CAN_ICLR_RX				bit(16)			/* RXI жʹ. */
+/*
+ * 12:0 ENA_SET RW жʹλ. д1 λжʹ, ʾǰ״̬
+ */
+#define CAN_ISET_DMAD			bit(12)			/* DMAD жʹλ; */
+#define CAN_ISET_OF				bit(11)			/* OFI жʹλ; */
+#define CAN_ISET_TXBHC			bit(10)			/* TXBHCI жʹλ; */
+#define CAN_ISET_RBNE			bit(9)			/* RBNEI жʹλ; */
+#define CAN_ISET_BS				bit(8)			/* BSI жʹλ; */
+#define CAN_ISET_RXF			bit(7)			/* RXFI жʹλ; */
+#define CAN_ISET_BE				bit(6)			/* BEI жʹλ; */
+#define CAN_ISET_AL				bit(5)			/* ALI жʹλ; */
+#define CAN_ISET_FCS			bit(4)			/* FCSI жʹλ; */
+#define CAN_ISET_DO			    bit(3)			/* DOI жʹλ; */
+#define CAN_ISET_EWL			bit(2)			/* EWLI жʹλ; */
+#define CAN_ISET_TX			    bit(1)			/* TXI жʹλ; */
+#define CAN_ISET_RX			    bit(0)			/* RXI жʹλ. */
+
+/**
+ * ж״̬μĴ(INT_MASK) OFFSET: 0x1c
+ */
+/*
+ * 28:16 MASK_CLR WO ж״̬. д1 ж״̬
+ */
+#define CAN_IMCLR_DMAD			bit(28)			/* DMAD ж״̬; */
+#define CAN_IMCLR_OF			bit(27)			/* OFI ж״̬; */
+#define CAN_IMCLR_TXBHC		    bit(26)			/* TXBHCI ж״̬; */
+#define CAN_IMCLR_RBNE			bit(25)			/* RBNEI ж״̬; */
+#define CAN_IMCLR_BS			bit(24)			/* BSI ж״̬; */
+#define CAN_IMCLR_RXF			bit(23)			/* RXFI ж״̬; */
+#define CAN_IMCLR_BE			bit(22)			/* BEI ж״̬; */
+#define CAN_IMCLR_AL			bit(21)			/* ALI ж״̬; */
+#define CAN_IMCLR_FCS			bit(20)			/* FCSI ж״̬; */
+#define CAN_IMCLR_DO			bit(19)			/* DOI ж״̬; */
+#define CAN_IMCLR_EWL			bit(18)			/* EWLI ж״̬; */
+#define CAN_IMCLR_TX			bit(17)			/* TXI ж״̬; */
+#define CAN_IMCLR_RX			bit(16)			/* RXI ж״̬. */
+/*
+ * 12:0 MASK_SET RW ж״̬λ. д1 λж״̬, ʾǰ״̬
+ */
+#define CAN_IMSET_DMAD			bit(12)			/* DMAD ж״̬λ; */
+#define CAN_IMSET_OF			bit(11)			/* OFI ж״̬λ; */
+#define CAN_IMSET_TXBHC		    bit(10)			/* TXBHCI ж״̬λ; */
+#define CAN_IMSET_RBNE			bit(9)			/* RBNEI ж״̬λ; */
+#define CAN_IMSET_BS			bit(8)			/* BSI ж״̬λ; */
+#define CAN_IMSET_RXF			bit(7)			/* RXFI ж״̬λ; */
+#define CAN_IMSET_BE			bit(6)			/* BEI ж״̬λ; */
+#define CAN_IMSET_AL			bit(5)			/* ALI ж״̬λ; */
+#define CAN_IMSET_FCS			bit(4)			/* FCSI ж״̬λ; */
+#define CAN_IMSET_DO			bit(3)			/* DOI ж״̬λ; */
+#define CAN_IMSET_EWL			bit(2)			/* EWLI ж״̬λ; */
+#define CAN_IMSET_TX			bit(1)			/* TXI ж״̬λ; */
+#define CAN_IMSET_RX			bit(0)			/* RXI ж״̬λ. */
+
+/**
+ * ׼üĴ(BTR_NORM) OFFSET: 0x20
+ */
+#define CAN_BTR_NORM_SJW_MASK	(0x1F<<27)		/* RW bit[31:27] ͬ */
+#define CAN_BTR_NORM_SJW_SHIFT	27
+#define CAN_BTR_NORM_BRP_MASK	(0xFF<<19)		/* RW bit[26:19] λԤƵϵ */
+#define CAN_BTR_NORM_BRP_SHIFT	19
+#define CAN_BTR_NORM_PH2_MASK	(0x3F<<13)		/* RW bit[18:13] λ2  */
+#define CAN_BTR_NORM_PH2_SHIFT	13
+#define CAN_BTR_NORM_PH1_MASK	(0x3F<<7)		/* RW bit[12:7] λ1  */
+#define CAN_BTR_NORM_PH1_SHIFT	7
+#define CAN_BTR_NORM_PROP_MASK	0x7F			/* RW bit[6:0] ο */
+
+/**
+ * FD üĴ(BTR_FD) OFFSET: 0x24
+ */
+#define CAN_BTR_FD_SJW_MASK		(0x1F<<27)		/* RW bit[31:27] ͬ */
+#define CAN_BTR_FD_SJW_SHIFT	27
+#define CAN_BTR_FD_BRP_MASK		(0xFF<<19)		/* RW bit[26:19] λԤƵϵ */
+#define CAN_BTR_FD_BRP_SHIFT	19
+#define CAN_BTR_FD_PH2_MASK		(0x3F<<13)		/* RW bit[18:13] λ2  */
+#define CAN_BTR_FD_PH2_SHIFT	13
+#define CAN_BTR_FD_PH1_MASK		(0x3F<<7)		/* RW bit[12:7] λ1  */
+#define CAN_BTR_FD_PH1_SHIFT	7
+#define CAN_BTR_FD_PROP_MASK	0x7F			/* RW bit[6:0] ο */
+
+/**
+ * ֵüĴ(ERL) OFFSET: 0x28
+ */
+#define CAN_ERRLVL_EWL_MASK		(0xFF<<16)		/* RW bit[23:16] 󾯸ֵ. MODE[TSTM]Ϊ1ʱ޸; ĬֵΪ0x60. */
+#define CAN_ERRLVL_EWL_SHIFT	16
+#define CAN_ERRLVL_ERP_MASK		0xFF			/* RW bit[7:0] 󱻶ֵ. MODE[TSTM]Ϊ1ʱ޸; ĬֵΪ0x80. */
+
+/**
+ * ״̬Ĵ(FSTAT) OFFSET: 0x2c
+ */
+#define CAN_ERRSR_BUSOFF		bit(2)			/* RO BUS_OFF ״̬ */
+#define CAN_ERRSR_ERP			bit(1)			/* RO ERROR_PASSIVE ״̬ */
+#define CAN_ERRSR_ERA			bit(0)			/* RO ERROR_ACTIVE ״̬ */
+
+/**
+ * Ĵ(ERC) OFFSET: 0x30
+ */
+#define CAN_ERRCNT_RX_MASK		(0x1FF<<16)		/* RO bit[24:16] մ */
+#define CAN_ERRCNT_RX_SHIFT		16
+#define CAN_ERRCNT_TX_MASK		0x1FF			/* RO bit[8:0] ʹ */
+
+/**
+ * ʴĴ(BRE) OFFSET: 0x34
+ */
+#define CAN_BRERR_NORM_MASK		0xFFFF0000		/* RO bit[31:16] ʴ */
+#define CAN_BRERR_NORM_SHIFT	16
+#define CAN_BRERR_DATA_MASK		0xFFFF			/* RO bit[15:0] FD ʴ */
+
+/**
+ * ԼĴ(CTR_PRES) OFFSET: 0x38
+ */
+#define CAN_CTRPRES_PRX			bit(10)  		/* WO REC Ԥд. д1 ʱCTR_PRES[CTPV]дREC. */
+#define CAN_CTRPRES_PTX			bit(9)			/* WO TEC Ԥд. д1 ʱCTR_PRES[CTPV]дTEC. */
+#define CAN_CTRPRES_CTPV_MASK	0x1FF			/* WO bit[8:0] Ԥдֵ */
+
+/**
+ * ׽״̬Ĵ(ERR_CAPT) OFFSET: 0x3c
+ */
+#define CAN_ECAPT_TYPE_MASK		(0x07<<5)		/* RO bit[7:5] һ. */
+#define CAN_ECAPT_TYPE_SHIFT	5
+#define CAN_ETYPE_BIT			0			    /*    3'd0: BIT_ERR - Bit Error; */
+#define CAN_ETYPE_CRC			1			    /*    3'd1: CRC_ERR - CRC Error; */
+#define CAN_ETYPE_FRM			2			    /*    3'd2: FRM_ERR - Form Error; */
+#define CAN_ETYPE_ACK			3			    /*    3'd3: ACK_ERR - Acknowledge Error; */
+#define CAN_ETYPE_STUP			4			    /*    3'd4: STUF_ERR - Stuff Error. */
+
+#define CAN_ECAPT_POS_MASK		0x1F			/* RO bit[4:0] һλ. */
+#define CAN_EPOS_SOF			0				/*    5'b00000: POS_SOF - Error in Start of Frame; */
+#define CAN_EPOS_ARB			1				/*    5'b00001: POS_ARB - Error in Arbitration Filed; */
+#define CAN_EPOS_CTRL			2				/*    5'b00010: POS_CTRL - Error in Control field; */
+#define CAN_EPOS_DATA			3				/*    5'b00011: POS_DATA - Error in Data Field; */
+#define CAN_EPOS_CRC			4				/*    5'b00100: POS_CRC - Error in CRC Field; */
+#define CAN_EPOS_ACK			5				/*    5'b00101: POS_ACK - Error in CRC delimiter, ACK field or ACK delimiter */
+#define CAN_EPOS_EOF			6				/*    5'b00110: POS_EOF - Error in End of frame field; */
+#define CAN_EPOS_ERR			7				/*    5'b00111: POS_ERR - Error during Error frame; */
+#define CAN_EPOS_OVRL			8				/*    5'b01000: POS_OVRL - Error in Overload frame; */
+#define CAN_EPOS_OTHER			0x1F			/*    5'b11111: POS_OTHER - Other position of error. */
+
+/**
+ * طĴ(RETX_CNT) OFFSET: 0x40
+ */
+#define CAN_RETX_CNT_MASK		0x0F			/* RO bit[3:0] ǰͱط */
+
+/**
+ * ʧȥٲò׽Ĵ(ALC) OFFSET: 0x44
+ */
+#define CAN_ALC_ID_MASK			(0x07<<5)		/* RO bit[7:5] ʧȥٲ. */
+#define CAN_ALC_ID_SHIFT        5
+#define CAN_ALC_RSVD			(0<<5)			/*    3'd0 - RSVD - δʧȥٲ; */
+#define CAN_ALC_BASE_ID			(1<<5)			/*    3'd1 - BASE_ID - base identifier ʧȥٲ; */
+#define CAN_ALC_SRR_RTR			(2<<5)			/*    3'd2 - SRR_RTR - base identifier ĵһλʧȥٲ
+                                                 *                     (չģʽSRR λ, ׼ģʽRTR λ);
+                                                 */
+#define CAN_ALC_IDE				(3<<5)			/*    3'd3 - IDE - IDE λʧȥٲ; */
+#define CAN_ALC_EXTENSION		(4<<5)			/*    3'd4 - EXTENSION - Identifier extension ʧȥٲ; */
+#define CAN_ALC_RTR				(5<<5)			/*    3'd5 - RTR - չģʽRTR λʧȥٲ. */
+
+#define CAN_ALC_BIT_POS_MASK	0x1F			/* RO bit[4:0] ʧȥٲλ. ALC[ID_FIELD]λBASE_ID EXTENSION . */
+
+/**
+ * ӳٲĴ(TRV_DLY) OFFSET: 0x48
+ */
+#define CAN_TRV_DLY_MASK		0x7F			/* RO bit[6:0] ӳٲֵ. λΪһϵͳʱӵ. */
+
+/**
+ * ڶüĴ(SSP_CFG) OFFSET: 0x4c
+ */
+#define CAN_SSP_CFG_SAT			bit(10)			/* RW ڶӳٱʹ. λΪ1 ʱ, ӳΪ255 ϵͳʱ. */
+#define CAN_SSP_CFG_SRC_MASK	(0x03<<8)		/* RW bit[9:8] ڶӳѡ. */
+#define CAN_SSP_CFG_SRC_SHIFT	8
+#define CAN_SSP_CFG_0			(0<<8)			/*    2'd0: ʹTRV_DLY SSP_CFG[SSP_OFF]֮Ϊڶӳ; */
+#define CAN_SSP_CFG_1			(1<<8)			/*    2'd1: õڶ, ʹñ׼ΪFD λ; */
+#define CAN_SSP_CFG_2			(2<<8)			/*    2'd2: ʹSSP_CFG[SSP_OFF]Ϊڶӳ. */
+
+#define CAN_SSP_CFG_OFF_MASK	0xFF			/* RW bit[7:0] ڶƫ. λΪһϵͳʱӵ. */
+
+/**
+ * ձļĴ(RX_FR_CNT) OFFSET: 0x50
+ */
+/*
+ * 31:0 FR_CNT RO ձļ. CR_STAT[STCNT]ʱЧ.
+ */
+
+/**
+ * ͱļĴ(TX_FR_CNT) OFFSET: 0x54
+ */
+/*
+ * 31:0 FR_CNT RO ͱļ. CR_STAT[STCNT]ʱЧ.
+ */
+
+/**
+ * ԼĴ(DEBUG) OFFSET: 0x58
+ */
+#define CAN_DEBUG_SOF			bit(18)			/* RO Start of frame α־. ǰ״̬Start of frame . */
+#define CAN_DEBUG_OVR			bit(17)			/* RO Overload α־. ǰ״̬Overload . */
+#define CAN_DEBUG_SUSP			bit(16)			/* RO Suspend transmission α־. ǰ״̬Suspend transmission . */
+#define CAN_DEBUG_INT			bit(15)			/* RO Intermission α־. ǰ״̬Intermission . */
+#define CAN_DEBUG_EOF			bit(14)			/* RO End of file α־. ǰ״̬End of file . */
+#define CAN_DEBUG_ACKD			bit(13)			/* RO ACK Delimiter α־. ǰ״̬ACK Delimiter . */
+#define CAN_DEBUG_ACK			bit(12)			/* RO ACK α־. ǰ״̬ACK . */
+#define CAN_DEBUG_CRCD			bit(11)			/* RO CRC Delimiter α־. ǰ״̬CRC Delimiter . */
+#define CAN_DEBUG_CRC			bit(10)			/* RO CRC α־. ǰ״̬CRC . */
+#define CAN_DEBUG_STC			bit(9)			/* RO Stuff Count α־. ǰ״̬Stuff Count . */
+#define CAN_DEBUG_DAT			bit(8)			/* RO Data α־. ǰ״̬Data . */
+#define CAN_DEBUG_CON			bit(7)			/* RO Control α־. ǰ״̬Control . */
+#define CAN_DEBUG_ARB			bit(6)			/* RO Arbitration α־. ǰ״̬Arbitration . */
+
+#define CAN_DEBUG_DSTF_CNT_MASK 0x38			/* RO bit[5:3] de-staff . ǰһde-stuff 8. */
+#define CAN_DEBUG_STF_CNT_MASK	0x07			/* RO bit[2:0] stuff .ǰһstuff 8. */
+
+/**
+ * ʱĴ(TS) OFFSET: 0x5c
+ */
+#define CAN_TS_PSC_MASK			(0x1FF<<16)		/* RW bit[24:16] ڲʱƵϵ */
+#define CAN_TS_PSC_SHIFT		16
+#define CAN_TS_CURRENT_MASK	    0xFFFF			/* RO bit[15:0] ǰʱ */
+
+/**
+ * ͱĵԼĴ(TX_FRM_TST) OFFSET: 0x60
+ */
+#define CAN_TX_FRM_T_TPRM_MASK	0xF8			/* RW bit[7:3] .
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    TX_FRM_TST[SDLC]Ϊ1 ʱ, DLCνڴʱTPRM[3:0]滻;
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    TX_FRM_TST[FCRC]Ϊ1 ʱ, CRC εĵTPRM λڴʱת;
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    TX_FRM_TST[FSTC]Ϊ1 ʱ, Stuff Count TPRM[4:0]򲢽д.
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define CAN_TX_FRM_T_TPRM_SHIFT	3
+
+#define CAN_TX_FRM_T_SDLC		bit(2)			/* RW DLC עʹ */
+#define CAN_TX_FRM_T_FCRC		bit(1)			/* RW CRC עʹ */
+#define CAN_TX_FRM_T_FSTC		bit(0)			/* RW Stuff Count עʹ */
+
+/**
+ * СƵϵĴ(FRC_DIV) OFFSET: 0x64
+ */
+#define CAN_FRC_DBT_MASK		(0xFF<<8)		/* RW bit[15:8] λСƵϵ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *              λʷƵ=BRP*(PH1+PH2+PROP+1+(FRC/0x100)).
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    : BRP=4; PH1=3; PH2=4; PROP=2; FRC=8'b01100000;
+ 	 	 	 	 	 	 	 	 	 	 	 	 *        DIV=4*(3+4+2+1+0.375) = 41.5.
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define CAN_FRC_DBT_SHIFT		8
+
+#define CAN_FRC_NBT_MASK		0xFF			/* RW bit[7:0] λСƵϵͬ */
+
+/**
+ * A Ĵ(FLT_A_MASK) OFFSET: 0x68
+ *
+ * 28:0 MASK_VAL RW A 
+ */
+
+/**
+ * A ֵĴ(FLT_A_VAL) OFFSET: 0x6c
+ *
+ * 28:0 FLT_VAL RW A ֵ
+ */
+
+/**
+ * B Ĵ(FLT_B_MASK) OFFSET: 0x70
+ *
+ * 28:0 MASK_VAL RW B 
+ */
+
+/**
+ * B ֵĴ(FLT_B_VAL) OFFSET: 0x74
+ *
+ * 28:0 FLT_VAL RW B ֵ
+ */
+
+/**
+ * C Ĵ(FLT_C_MASK) OFFSET: 0x78
+ *
+ * 28:0 MASK_VAL RW C 
+ */
+
+/**
+ * C ֵĴ(FLT_C_VAL) OFFSET: 0x7c
+ *
+ * 28:0 FLT_VAL RW C ֵ
+ */
+
+#define CAN_FILTER_MASK         0x1FFFFFFF
+
+/**
+ * ΧֵĴ(FLT_R_LOW) OFFSET: 0x80
+ *
+ * 28:0 LOW_VAL RW Χֵ
+ */
+
+/**
+ * ΧֵĴ(FLT_R_HI) OFFSET: 0x84
+ *
+ * 28:0 HI_VAL RW Χֵ
+ */
+
+/**
+ * ƼĴ(FLT_CTRL) OFFSET: 0x88
+ */
+/* 15:12 FR RW Χʽ֧.
+ */
+#define CAN_FCTRL_FR_FE			bit(15)			/* FE: ΧCANFD ׼ģʽĽʹ; */
+#define CAN_FCTRL_FR_FB			bit(14)			/* FB: ΧCANFD չģʽĽʹ; */
+#define CAN_FCTRL_FR_NE			bit(13)			/* NE: ΧCAN2.0 ׼ģʽĽʹ; */
+#define CAN_FCTRL_FR_NB			bit(12)			/* NB: ΧCAN2.0 չģʽĽʹ. */
+/* 11:8 FC RW C ʽ֧.
+ */
+#define CAN_FCTRL_FC_FE			bit(11)			/* FE: C CANFD ׼ģʽĽʹ; */
+#define CAN_FCTRL_FC_FB			bit(10)			/* FB: C CANFD չģʽĽʹ; */
+#define CAN_FCTRL_FC_NE			bit(9)			/* NE: C CAN2.0 ׼ģʽĽʹ; */
+#define CAN_FCTRL_FC_NB			bit(8)			/* NB: C CAN2.0 չģʽĽʹ. */
+/* 7:4 FB RW B ʽ֧.
+ */
+#define CAN_FCTRL_FB_FE			bit(7)			/* FE: B CANFD ׼ģʽĽʹ; */
+#define CAN_FCTRL_FB_FB			bit(6)			/* FB: B CANFD չģʽĽʹ; */
+#define CAN_FCTRL_FB_NE			bit(5)			/* NE: B CAN2.0 ׼ģʽĽʹ; */
+#define CAN_FCTRL_FB_NB			bit(4)			/* NB: B CAN2.0 չģʽĽʹ. */
+/* 3:0 FA RW A ʽ֧.
+ */
+#define CAN_FCTRL_FA_FE			bit(3)			/* FE: A CANFD ׼ģʽĽʹ; */
+#define CAN_FCTRL_FA_FB			bit(2)			/* FB: A CANFD չģʽĽʹ; */
+#define CAN_FCTRL_FA_NE			bit(1)			/* NE: A CAN2.0 ׼ģʽĽʹ; */
+#define CAN_FCTRL_FA_NB			bit(0)			/* NB: A CAN2.0 չģʽĽʹ. */
+
+/**
+ * ջϢĴ(RX_MEM_INFO) OFFSET: 0x8c
+ */
+#define CAN_RX_MEM_FREE_MASK	(0x1FFF<<16)	/* RO bit[28:16] ջʣ32 λ. */
+#define CAN_RX_MEM_FREE_SHIFT	16
+#define CAN_RX_BUF_SIZE_MASK	0xFFF			/* RO bit[12:0] ջ32 λ. */
+
+/**
+ * ջָĴ(RX_PRT) OFFSET: 0x90
+ */
+#define CAN_RX_RPP_MASK			(0xFFF<<16)		/* RO bit[27:16] ջָλ */
+#define CAN_RX_RPP_SHIFT		16
+#define CAN_RX_WPP_MASK			0xFFF			/* RO bit[11:0] ջдָλ */
+
+/**
+ * ջ״̬Ĵ(RX_STAT) OFFSET: 0x94
+ */
+#define CAN_RXSR_FRC_MASK		(0x7FF<<4)		/* RO bit[14:4] ջ */
+#define CAN_RXSR_FRC_SHIFT		4
+#define CAN_RXSR_MOF			bit(2)			/* RO ջݶα־. λΪ1 ʱ, һΪݶ. */
+#define CAN_RXSR_RXF			bit(1)			/* RO ջ */
+#define CAN_RXSR_RXE			bit(0)			/* RO ջ */
+
+/**
+ * ݼĴ(RX_DATA) OFFSET: 0x98
+ *
+ * 31:0 DATA RO ջݶӿ. CR_MODE[RXBAM]Ϊ1 ʱ, ָԶ1; CR_CMD[RXRPMV]д1 ƶָ.
+ */
+
+/**
+ * ͻ״̬Ĵ(TX_STAT) OFFSET: 0x9c
+ */
+#define CAN_TXSR_BS_MASK		0xFFFF0000		/* RO bit[31:16] ɼ¼һ: */
+#define CAN_TXSR_BS_SHIFT		16
+#define CAN_TXSR_BS_NOTSEND		(0<<16)			/* 2'b00: ״̬Ѵδ; */
+#define CAN_TXSR_BS_OK			(1<<16)			/* 2'b01: ͳɹ; */
+#define CAN_TXSR_BS_FAIL		(2<<16)			/* 2'b10: ʧ; */
+#define CAN_TXSR_BS_CANCEL		(3<<16)			/* 2'b11: ȡ. */
+
+#define CAN_TXSR_MASK			0x700			/* RO bit[10:8] ͻ״̬ */
+#define CAN_TXSR_SHIFT			8
+#define CAN_TXSR_IDLE			(0<<8)			/* 3'd0: ״̬, ޷ȴʱ; */
+#define CAN_TXSR_SCAN_TS		(1<<8)			/* 3'd1: ɨʱ״̬, ɨЧͻбĵʱ; */
+#define CAN_TXSR_SCAN_ID		(2<<8)			/* 3'd2: ɨ~ID~״̬, ɨЧͻбĵ~ID; */
+#define CAN_TXSR_WAIT			(3<<8)			/* 3'd3: ȴ״̬, ȴ߿; */
+#define CAN_TXSR_SEND			(4<<8)			/* 3'd4: ״̬, ķ; */
+#define CAN_TXSR_DONE			(5<<8)			/* 3'd5: ״̬, ĳɹ; */
+#define CAN_TXSR_START_SCAN		(6<<8)			/* 3'd6: ʼɨ״̬, TX_STAT[BRP]˱仯ҷͻ
+                                                 *       ڷ״̬ʱʼɨ.
+                                                 */
+
+#define CAN_TXSR_BRP_MASK		0xFF			/* RO bit[7:0] ȴ. ͵Ļ־. */
+
+/**
+ * ƼĴ(TX_CMD) OFFSET: 0xa0
+ */
+#define CAN_TXCMD_BSC_MASK		(0xFF<<16)		/* WO bit[23:16] ͼ¼. д1 ɼ¼(TX_STAT[BS]). */
+#define CAN_TXCMD_BSC_SHIFT		16
+#define CAN_TXCMD_BCR_MASK		0xFF00			/* WO bit[15:8] ȡ. ȡʹ˵Ļ, ͹λд1,
+                                                 *              ڷͽЧ.
+                                                 */
+#define CAN_TXCMD_BCR_SHIFT		8
+#define CAN_TXCMD_BAR_MASK		0xFF			/* WO bit[7:0] . ӦĻдݺ󼴿Ӧλ
+                                                 *             д1ʹܸû, ͳɹԶ.
+                                                 */
+
+/**
+ * ͻѡĴ(TX_SEL) OFFSET: 0xa4
+ */
+#define CAN_TXSEL_CNT_MASK		0xF0			/* RO bit[7:4] ͻ. дڵķͻ. */
+#define CAN_TXSEL_CNT_SHIFT	    4
+#define CAN_TXSEL_MASK		    0x0F			/* RW bit[3:0] ͻѡ. ѡ񼴽дķͻ, ÿдһ֡.
+                                                 */
+
+/**
+ * ͻݼĴ(TX_DATA) OFFSET: 0xb00xf4
+ *
+ * MODE[TSTM]Ϊ1 ʱжȡ.
+ *
+ * 31:0 DATA RW TX_SEL ѡķͻд.
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LS2K_CAN_HW_H
+
+
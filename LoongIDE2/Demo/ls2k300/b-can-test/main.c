@@ -79,6 +79,7 @@ int main(void)
     {
         int can0_start_transmit(void);
         int can1_start_receive(void);
+        void can_capture_bench(void);
 
         /**
          *  GPIO101  CANFD շоƬ
@@ -88,8 +89,12 @@ int main(void)
         gpio_mux(101, PAD_AS_GPIO);
         gpio_write(101, 0);
 
+      #if TEST_CAN_CAPTURE_BENCH
+        can_capture_bench();
+      #else
         can0_start_transmit();
         can1_start_receive();
+      #endif
     }
     #endif
 
@@ -136,6 +136,11 @@ extern unsigned apb_frequency;
 #define USE_LWIP        1
 #endif
 
+/*
+ * GMAC Դ, libbsp.a û trace.c
+ */
+#define BSP_USE_TRACE   0
+
 /**
  * PWM
  */
@@ -0,0 +1,873 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_gmac_hw.h
+ *
+ * created: 2024-06-08
+ *  author: Bian
+ */
+
+#ifndef _LS2K_GMAC_HW_H
+#define _LS2K_GMAC_HW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// GMAC 豸
+//-------------------------------------------------------------------------------------------------
+
+#define GMAC0_BASE              0x16020000
+#define GMAC1_BASE              0x16030000
+
+typedef struct
+{
+	volatile unsigned int addrhi;
+	volatile unsigned int addrlo;
+} MAC_ADDR_t;
+
+//-------------------------------------------------------------------------------------------------
+// GMAC 
+//-------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+	volatile unsigned int config;				/* 0x0000 Configuration */
+	volatile unsigned int framefilter;			/* 0x0004 GMAC Frame Filter */
+	volatile unsigned int hashhi;				/* 0x0008 Hash Table High */
+	volatile unsigned int hashlo;				/* 0x000C Hash Table Low */
+	volatile unsigned int miictrl;				/* 0x0010 GMII Address */
+	volatile unsigned int miidata;				/* 0x0014 GMII Data */
+	volatile unsigned int flowctrl;				/* 0x0018 Flow Control */
+	volatile unsigned int vlantag;				/* 0x001C VLAN Tag */
+	volatile unsigned int version;				/* 0x0020 Version */
+	volatile unsigned int rsv0;
+	volatile unsigned int wakeupaddr;           /* 0x0028 wake-up frame filter adrress reg */
+	volatile unsigned int pmtctrlstatus;        /* 0x002C PMT control and status register */
+	volatile unsigned int rsv1[2];
+	volatile unsigned int intstatus;			/* 0x0038 Interrupt Status */
+	volatile unsigned int intmask;				/* 0x003C Interrupt Mask */
+	volatile unsigned int addrhi;               /* 0x0040 Mac Addreee High */
+	volatile unsigned int addrlo;               /* 0x0044 Mac Addreee Lo */
+
+    MAC_ADDR_t macaddr[15];						/* 1~15 */
+
+} HW_GMAC_t;
+
+/*
+ * GMAC Config Register 0x0000
+ */
+enum GMAC_Config_R
+{
+    gmac_ctrl_tc            = (1<<24),      /* Transmit Configuration in RGMII ʹRGMII·Ϣ
+                                               =1: ˫ģʽ, ·ٶ, ·Լ·/ϿϢͨRGMIIӿڴPHY */
+
+	gmac_ctrl_wd			= (1<<23),		/* Watchdog Disable, رտŹ.
+	 	 	 	 	 	 	 	 	 	 	   =1: GMACرսն˵ĿŹʱ, Խ16384ֽڵ̫֡*/
+	gmac_ctrl_jd			= (1<<22),		/* Jabber Disable, رJabberʱ.
+											   =1: GMACرշ͹еJabberʱ, Է16384ֽڵ̫֡ */
+	gmac_ctrl_be			= (1<<21),		/* Frame Burst Enable, =1: GMACʹܴе֡ͻģʽ */
+	gmac_ctrl_je			= (1<<20),		/* Jumbo Frame Enable - ֡ʹ, =1: GMACʹܾ֡(9018ֽ)Ľ */
+	gmac_ctrl_ifg_mask		= (0x7<<17), 	/* Inter-Frame Gap - С֡ */
+	gmac_ctrl_ifg_shift		= 17,
+
+	gmac_ctrl_dcrs			= (1<<16),		/* Disable Carrier Sense During Transmission, йرزͻ
+											   =1: GMAC԰˫ģʽCRSźŵļ */
+	gmac_ctrl_mii			= (1<<15),		/* Port Select, 0: GMII (1000Mbps), 1: MII (10/100Mbps) */
+	gmac_ctrl_fes			= (1<<14),		/* Speed, 0: 10Mbps, 1: 100Mbps */
+	gmac_ctrl_do			= (1<<13),		/* Disable Receive Own, رսԼ̫֡.
+											   =1: GMACհ˫ģʽgmii_txen_oЧ̫֡ */
+	gmac_ctrl_lm			= (1<<12),		/* Loopback Mode,  =1: GMII/MIIڻģʽ */
+	gmac_ctrl_dm			= (1<<11),		/* Duplex Mode, ʹȫ˫ģʽ
+											   =1: GMACȫ˫ģʽ, ȫ˫ģʽ¿ͬʱͺͽ̫֡ */
+	gmac_ctrl_ipc			= (1<<10),		/* Checksum Offload, Ужʹ
+											   =1: GMACӲյ̫֡ĸ(payload). IPV4ͷУǷȷ */
+	gmac_ctrl_dr			= (1<<9),		/* Disable Retry, رش
+											   =1: GMACͻʱشͳͻ̫֡, ֻͻ */
+	gmac_ctrl_lud			= (1<<8),		/* Link Up/Down, 0: ·Ͽ, 1: ·  */
+	gmac_ctrl_acs			= (1<<7),		/* Automatic Pad/CRC Stripping, ̫֡Pad/CRCԶȥ
+											   =1: GMACȥյ̫֡PadFCS */
+	gmac_ctrl_bl_mask		= (0x03<<5), 	/* Back-Off Limit - , ƾslotӳʱ */
+	gmac_ctrl_bl_shift		= 5,
+	gmac_ctrl_bl_0			= (0<<5),		// 00: k=min(n,10)
+	gmac_ctrl_bl_1			= (1<<5),		// 01: k=min(n,8)
+	gmac_ctrl_bl_2			= (2<<5),		// 10: k=min(n,4)
+	gmac_ctrl_bl_3			= (3<<5),		// 11: k=min(n,1)
+
+	gmac_ctrl_dc			= (1<<4),		/* Deferral Check, =1: ʹdeferral⹦ */
+	gmac_ctrl_te			= (1<<3),		/* Transmitter Enable, =1: ʹGMAC书 */
+	gmac_ctrl_re			= (1<<2),		/* Receiver Enable, =1: ʹGMACչ */
+};
+
+/*
+ * GMAC Frame Filter Register 0x0004
+ */
+enum GMAC_FrameFilter_R
+{
+	gmac_frmfilter_ra		= (1<<31),		/* Receive All, =1: GMACģѽյ֡Ӧó, Դַ/Ŀַ˻ */
+	gmac_frmfilter_hpf		= (1<<10),		/* Hash or Perfect Filter, ϣȫ
+											   =1: ڹϣ/ȫ˻ƥ̫֡͸Ӧ.
+											   =0: ֻڹϣ˻ƥ̫֡ŷ͸Ӧ.  */
+	gmac_frmfilter_saf		= (1<<9),		/* Source Address Filter Enable, Դַʹ
+											   GMAC COREȽϱȽϽյ̫֡ԴַSAĴеֵ, ƥ, ״̬ĴеSAMatchλΪ.
+											   =1: Դַƥʧ, GMAC CORE̫֡.
+											   =0: ԴַƥGMAC COREմ֡, ƥд״̬Ĵ. */
+	gmac_frmfilter_saif		= (1<<8),		/* SA Inverse Filtering, Դַת.
+											   =1: SAĴԴַƥ̫֡ΪԴַƥʧ.
+											   =0: SAĴԴַƥ̫֡ΪԴַƥʧ.  */
+	gmac_frmfilter_pcf_mask	 = (0x03<<6),	/* bits: 7-6, Pass Control Frames, տ֡ */
+	gmac_frmfilter_pcf_shift = 6,
+	gmac_frmfilter_pcf_0	 = (0<<6),		// 00: GMACп֡;
+	gmac_frmfilter_pcf_1	 = (1<<6),		// 01: GMACճpause֡п֡;
+	gmac_frmfilter_pcf_2	 = (2<<6),		// 10: GMACп֡;
+	gmac_frmfilter_pcf_3	 = (3<<6),		// 11: GMACݵַտ֡ */
+
+	gmac_frmfilter_dbf		= (1<<5),		/* Disable Broadcast Frames, رչ㲥֡. =1: нյĹ㲥֡. =0: й㲥֡.  */
+	gmac_frmfilter_pm		= (1<<4),		/* Pass All Multicast, жಥ֡. =1: жಥ֡. =0: жಥ֡.  */
+	gmac_frmfilter_daif		= (1<<3),		/* DA Inverse Filtering, Ŀַת.
+											   =1: ԵͶಥ֡зĿַƥ.
+											   =0: ԵͶಥ֡Ŀַƥ.  */
+	gmac_frmfilter_hmc		= (1<<2),		/* Hash Multicast, ϣಥ, =1: ԽյĶಥ֡ݹϣݽĿַ */
+	gmac_frmfilter_huc		= (1<<1),		/* Hash Unicast, ϣ; =1: Խյĵ֡ݹϣݽĿַ */
+	gmac_frmfilter_pr		= (1<<0),		/* Promiscuous Mode, ģʽ, =1: ̫֡ */
+};
+
+/*
+ * GMAC Flow Control Register 0x0018
+ */
+enum GMAC_FlowControl_R
+{
+	gmac_flowctrl_pt_mask	= (0xFFFF<<16),		/* bits31~16, Pause Time, ͣʱ, 򱣴Ҫ봫֡еͣʱ */
+	gmac_flowctrl_pt_shift  = 16,
+	gmac_flowctrl_plt_mask	= (0x03<<4),		/* bits5~4, Pause Low Threshold, ͣʱֵ */
+	gmac_flowctrl_plt_shift = 4,
+	gmac_flowctrl_plt_0		= (0<<4),			/* 00: ͣʱ4ʱ */
+	gmac_flowctrl_plt_1		= (1<<4),			/* 01: ͣʱ28ʱ */
+	gmac_flowctrl_plt_2		= (2<<4),			/* 10: ͣʱ144ʱ */
+	gmac_flowctrl_plt_3		= (3<<4),			/* 11: ͣʱ256ʱ */
+												/* һʱΪGMII/MIIӿϴ512ػ64ֽڵʱ */
+	gmac_flowctrl_up		= (1<<3),			/* Unicast Pause Frame Detect, ͣ֡̽,
+												   =1: GMACGMACַ0ָıվַ̽ͣ֡ */
+	gmac_flowctrl_rxfcen	= (1<<2),			/* Receive Flow Control Enable, ʹ,
+												   =1: GMACյͣ֡, Ұָͣ֡ʱͣ֡ķ */
+	gmac_flowctrl_txfcen	= (1<<1),			/* Transmit Flow Control Enable, ʹ,
+												   =1: ȫ˫ģʽ, GMACʹͣ֡ķ; ڰ˫ģʽ, GMACʹܷѹ.  */
+	gmac_flowctrl_fcb_bpa	= (1<<0),			/* Flow Control Busy/Backpressure Activate, æ/ѹ,
+												   =1: ȫ˫ģʽ·ͣ֡ķͻڰ˫ģʽѹ */
+};
+
+/*
+ * GMAC Interrupt Status Register 0x0038
+ */
+enum GMAC_IntStatus_R
+{
+	gmac_intstat_ts				= (1<<9),		/* Set if int generated due to TS (Read Time Stamp Status Register to know details) */
+	gmac_intstat_mmcerr			= (1<<7),		/* MMCУжؼĴκжϲʱ, λΪ1 */
+	gmac_intstat_mmctx			= (1<<6),		/* MMCжϼĴκжʱ, λΪ1 */
+	gmac_intstat_mmcrx			= (1<<5),		/* MMCжϼĴκжʱ, λΪ1 */
+	gmac_intstat_mmc			= (1<<4),		/* MMCж״̬. 7:5κλΪʱ, λΪ1 */
+	gmac_intstat_pmt			= (1<<3),		/* Դж״̬, PowerDownWakeUpʱ, λΪ1 */
+	gmac_intstat_ancomp			= (1<<2),		/* RGMII PHYӿԶЭʱ, λΪ1 */
+	gmac_intstat_linkstatus		= (1<<1),		/* RGMII PHYӿڵ·״̬κα仯ʱ, λΪ1 */
+	gmac_intstat_rgmii			= (1<<0),		/* RGMII PHYӿڵ·״̬κα仯ʱ, λΪ1 */
+};
+
+/*
+ * GMAC Interrupt Mask Register 0x003C
+ */
+enum GMAC_IntMask_R
+{
+	gmac_intmask_timestamp		= (1<<9),		/* =1: ֹʱж */
+	gmac_intmask_pmt			= (1<<3),		/* =1: ֹԴж */
+	gmac_intmask_ancomp			= (1<<2),		/* =1: ֹPCSԶЭж */
+	gmac_intmask_linkchange		= (1<<1),		/* =1: ֹPCS·״̬仯ж */
+	gmac_intmask_rgmii			= (1<<0),		/* =1: ֹRGMIIж */
+};
+
+/*
+ * GMAC Address0 High Register x0040
+ */
+
+/*
+ * GMAC Address0 Low Register 0x0044
+ */
+
+/*
+ * GMAC Address1 High Register 0x0048
+ */
+
+/*
+ * GMAC Address1 Low Register 0x004C
+ */
+
+/*
+ * AN Control Register 0x00C0
+ */
+
+/*
+ * AN Status Register 0x00C4
+ */
+
+/*
+ * Auto-Negotiation Advertisement Register 0x00C8
+ */
+
+/*
+ * Auto-Negotiation Link Partner Ability Register 0x00CC
+ */
+
+/*
+ * Auto-Negotiation Expansion Register 0x00D0
+ */
+
+/*
+ * SGMII/RGMII Status Register 0x00D8
+ */
+
+/*
+ * GMII Address Register 0x0010
+ * GMII Data Register 0x0014
+ */
+enum GMAC_MIICtrl_R
+{
+	gmac_miictrl_phyaddr_mask	= (0x1F<<11),	/* bits15~11, PHY Address. ѡҪ32PHYеĸ */
+	gmac_miictrl_phyaddr_shift	= 11,
+	gmac_miictrl_gmiireg_mask	= (0x1F<<6),	/* bits10~6, GMII Register. ѡҪʵĵPHYĸGMIIüĴ */
+	gmac_miictrl_gmiireg_shift	= 6,
+	gmac_miictrl_csr_mask		= (0x07<<2),	/* bits4~2, CSR Clock Range. MDCʱclk_csr_iʱƵʱ */
+	gmac_miictrl_csr_shift		= 2,			/* (CR)CSR Clock Range: */
+	gmac_miictrl_csr_5			= 0x00000014,	/* 250-300 MHz */
+	gmac_miictrl_csr_4			= 0x00000010,	/* 150-250 MHz */
+	gmac_miictrl_csr_3			= 0x0000000C,	/* 5-60 MHz   */
+	gmac_miictrl_csr_2			= 0x00000008,	/* 20-35 MHz   */
+	gmac_miictrl_csr_1			= 0x00000004,	/* 100-150 MHz */
+	gmac_miictrl_csr_0			= 0x00000000,	/* 60-100 MHz  */
+	gmac_miictrl_wr				= (1<<1),		/* GMII Write. =1: ͨGMII ݼĴPHYд, =0: ͨGMIIݼĴPHYж */
+	gmac_miictrl_busy			= (1<<0),		/* GMII Busy. ԼĴ4ͼĴ5д֮ǰ, λӦΪ0. дĴ4֮ǰλ0.
+                                                   - ڷPHY ļĴʱ, ӦóҪλΪ1, ʾGMIIӿд߶ڽ. */
+
+    gmac_miidata_mask			= 0xFFFF,		/* 򱣴˶PHYйʲ16λ, ߶PHYйдʵ16λ. */
+};
+
+//-------------------------------------------------------------------------------------------------
+// IEEE1588 Registers of GMAC
+//-------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+	volatile unsigned int stamp_ctrl;				/* 0x0700 Time Stamp Control Register */
+	volatile unsigned int sub_second_inc; 			/* 0x0704 Sub-Second Increment Register */
+	volatile unsigned int systm_second; 			/* 0x0708 System Time - Seconds Register */
+	volatile unsigned int systm_nanosecond; 		/* 0x070C System Time - Nanoseconds Register */
+	volatile unsigned int systm_second_upd; 		/* 0x0710 System Time - Seconds Update Register */
+	volatile unsigned int systm_nanosecond_upd; 	/* 0x0714 System Time - Nanoseconds Update Register */
+	volatile unsigned int ts_addend;	 			/* 0x0718 Time Stamp Addend Register */
+	volatile unsigned int tgttm_second; 			/* 0x071C Target Time Seconds Register */
+	volatile unsigned int tgttm_nanosecond; 		/* 0x0720 Target Time Nanoseconds Register */
+	volatile unsigned int systm_hisecond; 			/* 0x0724 System Time - Higher Word Seconds Register */
+	volatile unsigned int ts_status; 				/* 0x0728 Time Stamp Status Register */
+} HW_IEEE1588_t;
+
+//-------------------------------------------------------------------------------------------------
+// DMA registers of GMAC
+//-------------------------------------------------------------------------------------------------
+
+#define GDMA0_BASE			    0x16021000
+#define GDMA1_BASE			    0x16031000
+
+typedef struct
+{
+	volatile unsigned int busmode; 			/* 0x1000 Bus Mode */
+	volatile unsigned int txpoll; 			/* 0x1004 Transmit Poll Demand */
+	volatile unsigned int rxpoll; 			/* 0x1008 Receive Poll Demand */
+	volatile unsigned int rxdesc0; 			/* 0x100C Start of Receive Descriptor List Address */
+	volatile unsigned int txdesc0; 			/* 0x1010 Start of Transmit Descriptor List Address */
+	volatile unsigned int status; 			/* 0x1014 Status */
+	volatile unsigned int control; 			/* 0x1018 Operation Mode */
+	volatile unsigned int intenable; 		/* 0x101C Interrupt Enable */
+	volatile unsigned int mfbocount; 		/* 0x1020 Missed Frame and Buffer Overflow Counter */
+	volatile unsigned int riwt; 			/* 0x1024 Receive Interrupt Watchdog Timer */
+	volatile unsigned int rsv2[8];
+	volatile unsigned int curtxdesc; 		/* 0x1048 Current Host Transmit Descriptor */
+	volatile unsigned int currxdesc; 		/* 0x104C Current Host Receive Descriptor */
+	volatile unsigned int curtxbuf; 		/* 0x1050 Current Host Transmit Buffer Address */
+	volatile unsigned int currxbuf; 		/* 0x1054 Current Host Receive Buffer Address */
+} HW_GDMA_t;
+
+/*
+ * Bus Mode Register of GMAC's DMA 	Offset: 0x00
+ */
+enum GDMA_BusMode_R
+{
+	gdma_busmode_fb			= (1<<16),		/* Fixed Burst ͻ䳤 *//* ûùĴλ */
+	gdma_busmode_pr_mask	= (0x03<<14),	/* Rx:Tx priority ratio, RxDMATxDMAȼ, DAλΪ1ʱ  */
+	gdma_busmode_pr_shift   = 14,
+	gdma_busmode_pr_1		= (0<<14),		/* (PR)TX:RX DMA priority ratio 1:1 */
+	gdma_busmode_pr_2		= (1<<14),		/* (PR)TX:RX DMA priority ratio 2:1 */
+	gdma_busmode_pr_3		= (2<<14),		/* (PR)TX:RX DMA priority ratio 3:1 */
+	gdma_busmode_pr_4		= (3<<14),		/* (PR)TX:RX DMA priority ratio 4:1 */
+	gdma_busmode_pbl_mask	= (0x3f<<8),	/* Programmable Burst Length ɱͻ䳤 *//* ûùĴλ */
+	gdma_busmode_pbl_shift	= 8,
+	gdma_busmode_pbl_256	= 0x01002000,	/* (DmaBurstLengthx8 | DmaBurstLength32) = 256 */
+	gdma_busmode_pbl_128	= 0x01001000,	/* (DmaBurstLengthx8 | DmaBurstLength16) = 128 */
+	gdma_busmode_pbl_64		= 0x01000800,	/* (DmaBurstLengthx8 | DmaBurstLength8)  = 64 */
+	gdma_busmode_pbl_32		= (1<<13), 		/* Dma burst length = 32 */
+	gdma_busmode_pbl_16		= (1<<12), 		/* Dma burst length = 16 */
+	gdma_busmode_pbl_8		= (1<<11), 		/* Dma burst length = 8 */
+	gdma_busmode_pbl_4		= (1<<10), 		/* Dma burst length = 4 */
+	gdma_busmode_pbl_2		= (1<<9),		/* Dma burst length = 2 */
+	gdma_busmode_pbl_1		= (1<<8),		/* Dma burst length = 1 */
+	gdma_busmode_pbl_0		= 0,			/* Dma burst length = 0 */
+	gdma_busmode_desc_8		= (1<<7),		/* Enh Descriptor size, =1: ʹ32ֽڴС, =0: ʹ16ֽڴС */
+	gdma_busmode_dsl_mask	= (0x1F<<2),	/* Descriptor Skip Length, 2ľ. ֵΪ0ʱ, ĬΪDMAС */
+	gdma_busmode_dsl_shift  = 2,
+	gdma_busmode_dsl_16		= (1<<6),
+	gdma_busmode_dsl_8		= (1<<5),
+	gdma_busmode_dsl_4		= (1<<4),
+	gdma_busmode_dsl_2		= (1<<3),
+	gdma_busmode_dsl_1		= (1<<2),
+	gdma_busmode_dsl_0		= 0,
+	gdma_busmode_das		= (1<<1),		/* DMA Arbitration scheme, =0: RxDMATxDMAתٲû, =1: RxDMAȼTxDMAȼ(PRֵ) */
+	gdma_busmode_swreset	= (1<<0),		/* λøDMAλGMACڲĴ߼. λʱλԶ */
+};
+
+/*
+ * Status Register of GMAC's DMA 	Offset: 0x14
+ */
+enum GDMA_Status_R
+{
+	gdma_status_pmti		= (1<<28),		/* GMAC PMT Interrupt, Դģ鴥ж. ֻ */
+	gdma_status_mmci		= (1<<27),		/* GMAC MMC Interrupt, MMCģ鴥ж. ֻ */
+	gdma_status_lifi		= (1<<26),		/* GMAC Line interface Interrupt, GMACģPCSRGMIIģ鴥ж. ֻ */
+	gdma_status_errbit2		= (1<<25),		/* =1: ʴ; =0: ݻʴ */
+	gdma_status_errbit1		= (1<<24),		/* =1: ; =0: д */
+	gdma_status_errbit0		= (1<<23),		/* =1: TxDMAݴз; =0: RxDMAݴз */
+
+	gdma_status_txs_mask	= (0x07<<20),	/* Transmit Process State, ״̬(ο) */
+	gdma_status_txs_shift   = 20,
+	gdma_status_txs_0		= (0<<20),		// 000: ֹͣ; λֹͣ
+	gdma_status_txs_1		= (1<<20),		// 001: ڽ; ȡ
+	gdma_status_txs_2		= (2<<20),		// 010: ڽ; ȴ״̬
+	gdma_status_txs_3		= (3<<20),		// 011: ڽ; ӷͻȡݲ͵FIFO(TxFIFO)
+	gdma_status_txs_4		= (4<<20),		// 100: дʱ״̬
+	gdma_status_txs_5		= (5<<20),		// 101: 
+	gdma_status_txs_6		= (6<<20),		// 110: ; ûߴ仺.
+	gdma_status_txs_7		= (7<<20),		// 111: ; رմ.
+
+	gdma_status_rxs_mask	= (0x07<<17),	/* bits: 19-17, Receive Process State, չ״̬(ο) */
+	gdma_status_rxs_shift   = 17,
+	gdma_status_rxs_0		= (0<<17),		// 000: ֹͣ; λ߽յֹͣ
+	gdma_status_rxs_1		= (1<<17),		// 001: ; ȡ.
+	gdma_status_rxs_2		= (2<<17),		// 010: ;
+	gdma_status_rxs_3		= (3<<17),		// 011: ; ȴհ.
+	gdma_status_rxs_4		= (4<<17),		// 100: ͣ; .
+	gdma_status_rxs_5		= (5<<17),		// 101: ; رս.
+	gdma_status_rxs_6		= (6<<17),		// 110: ʱд״̬.
+	gdma_status_rxs_7		= (7<<17),		// 111: ; ݴӽջ洫䵽ϵͳڴ.
+
+	gdma_status_nis			= (1<<16),		/* Normal Interrupt Summary, жϻ, ʾϵͳǷж */
+	gdma_status_ais			= (1<<15),		/* Abnormal Interrupt Summary, 쳣жϻ, ʾϵͳǷ쳣ж */
+	gdma_status_erxi		= (1<<14),		/* Early Receive Interrupt, ǰж, ʾDMAѾѰĵһдջ */
+	gdma_status_fbei		= (1<<13),		/* Fatal Bus Error Interrupt, ߴж, ʾߴ, Ϣ[25:23]. λúDMAֹͣ߷ʲ */
+	gdma_status_etxi		= (1<<10),		/* Early Transmit Interrupt, ǰж, ʾҪ̫֡Ѿȫ䵽MTLģеĴ FIFO */
+	gdma_status_rxwt		= (1<<9),		/* Receive Watchdog Timeout, տŹʱ, ʾյһС2048ֽڵ̫֡ */
+	gdma_status_rxstop		= (1<<8),		/* Receive Process Stopped, չֹͣ */
+	gdma_status_rxbufu		= (1<<7),		/* Receive Buffer Unavailable, ջ治 */
+	gdma_status_rxi			= (1<<6),		/* Receive Interrupt, ж, ָʾ֡, ֡յ״̬ϢѾд, մ״̬ */
+	gdma_status_txunf		= (1<<5),		/* Transmit Underflow, 仺, ָʾ֡͹вջ */
+	gdma_status_rxovf		= (1<<4),		/* Receive Overflow, ջ, ָʾ֡չнջ */
+	gdma_status_txjt		= (1<<3),		/* Transmit Jabber Timeout */
+	gdma_status_txbufu		= (1<<2),		/* Transmit Buffer Unavailable, 仺治, ʾбеһܱDMA */
+	gdma_status_txstop		= (1<<1),		/* Transmit Process Stopped, ֹͣ */
+	gdma_status_txi			= (1<<0),		/* Transmit Interrupt, ж, ʾ֡ɲҵһ31λλ */
+};
+
+/*
+ * Operation Mode Register of GMAC's DMA 	Offset: 0x18
+ */
+enum GDMA_Ctrl_R
+{
+	gdma_ctrl_notdroptcpcse	= (1<<26),		/* رնTCP/IP Checksum̫֡Ĺ, =1: GMACchecksum̫֡ */
+	gdma_ctrl_rxsf			= (1<<25),		/* Receive Store and Forward, մ洢ת, =1: MTLģֻѾȫ洢ڽFIFOе̫֡ */
+	gdma_ctrl_txsf			= (1<<21),		/* Transmit Store and Forward, ʹ洢ת, =1: ֡ķֻ֡ѾȫMTLĴFIFO */
+	gdma_ctrl_ftxfifo		= (1<<20),		/* Flush Transmit FIFO, ˢFIFO, =1: ߼λΪĬֵ, һᵼ·FIFOȫʧ */
+	gdma_ctrl_ttc_mask		= (0x7<<14),	/* Transmit Threshold Control, ֵ, ֡СֵʱMTLᴫ֡ */
+	gdma_ctrl_ttc_shift		= 14,
+	gdma_ctrl_ttc_64		= (0<<14),		// 000: 64  ֽ
+	gdma_ctrl_ttc_128		= (1<<14),		// 001: 128 ֽ
+	gdma_ctrl_ttc_192		= (2<<14),		// 010: 192 ֽ
+	gdma_ctrl_ttc_256		= (3<<14),		// 011: 256 ֽ
+	gdma_ctrl_ttc_40		= (4<<14),		// 100: 40  ֽ
+	gdma_ctrl_ttc_32		= (5<<14),		// 101: 32  ֽ
+	gdma_ctrl_ttc_24		= (6<<14),		// 110: 24  ֽ
+	gdma_ctrl_ttc_16		= (7<<14),		// 111: 16  ֽ
+	gdma_ctrl_txstart		= (1<<13),		/* Start/Stop Transmission Command, =1: ״̬, =0: ֹͣ״̬ */
+
+	gdma_rxflowctrl_deact   = 0x00401800,   /* (RFD)Rx flow control deact. threhold             [22]:12:11 */
+	gdma_rxflowctrl_deact1K = 0x00000000,   /* (RFD)Rx flow control deact. threhold (1kbytes)   [22]:12:11 */
+	gdma_rxflowctrl_deact2K = 0x00000800,   /* (RFD)Rx flow control deact. threhold (2kbytes)   [22]:12:11 */
+	gdma_rxflowctrl_deact3K = 0x00001000,   /* (RFD)Rx flow control deact. threhold (3kbytes)   [22]:12:11 */
+	gdma_rxflowctrl_deact4K = 0x00001800,   /* (RFD)Rx flow control deact. threhold (4kbytes)   [22]:12:11 */
+	gdma_rxflowctrl_deact5K = 0x00400000,   /* (RFD)Rx flow control deact. threhold (4kbytes)   [22]:12:11 */
+	gdma_rxflowctrl_deact6K = 0x00400800,   /* (RFD)Rx flow control deact. threhold (4kbytes)   [22]:12:11 */
+	gdma_rxflowctrl_deact7K = 0x00401000,   /* (RFD)Rx flow control deact. threhold (4kbytes)   [22]:12:11 */
+	gdma_rxflowctrl_act     = 0x00800600,   /* (RFA)Rx flow control Act. threhold               [23]:10:09 */
+	gdma_rxflowctrl_act1K   = 0x00000000,   /* (RFA)Rx flow control Act. threhold (1kbytes)     [23]:10:09 */
+	gdma_rxflowctrl_act2K   = 0x00000200,   /* (RFA)Rx flow control Act. threhold (2kbytes)     [23]:10:09 */
+	gdma_rxflowctrl_act3K   = 0x00000400,   /* (RFA)Rx flow control Act. threhold (3kbytes)     [23]:10:09 */
+	gdma_rxflowctrl_act4K   = 0x00000300,   /* (RFA)Rx flow control Act. threhold (4kbytes)     [23]:10:09 */
+	gdma_rxflowctrl_act5K   = 0x00800000,   /* (RFA)Rx flow control Act. threhold (5kbytes)     [23]:10:09 */
+	gdma_rxflowctrl_act6K   = 0x00800200,   /* (RFA)Rx flow control Act. threhold (6kbytes)     [23]:10:09 */
+	gdma_rxflowctrl_act7K   = 0x00800400,   /* (RFA)Rx flow control Act. threhold (7kbytes)     [23]:10:09 */
+
+	gdma_ctrl_enhwfc		= (1<<8),		/* Enable HW flow control, =1: ڽFIFOʵӲص·Ч */
+	gdma_ctrl_ferrf			= (1<<7),		/* Forward Error Frames, ֡, =1: մ֡(֡:CRC,ͻ,֡,Źʱ,) */
+	gdma_ctrl_fuszf			= (1<<6),		/* Forward Undersized Frames, =1: FIFOûдС64ֽڵ̫֡ */
+
+	gdma_ctrl_rtc_mask		= (0x3<<3),		/* Receive Threshold Control, ֵ, ֡СֵʱMTLո֡ */
+	gdma_ctrl_rtc_shift		= 3,
+	gdma_ctrl_rtc_64		= (0<<3),		// 00: 64  ֽ
+	gdma_ctrl_rtc_32		= (1<<3),		// 01: 32  ֽ
+	gdma_ctrl_rtc_96		= (2<<3),		// 10: 96  ֽ
+	gdma_ctrl_rtc_128		= (3<<3),		// 11: 128 ֽ
+
+	gdma_ctrl_txopsecf		= (1<<2),		/* TX Operate on Second Frame, =1: DMAڵһ̫֡״̬δдʱԿʼڶ̫֡ */
+	gdma_ctrl_rxstart		= (1<<1),		/* Start/Stop Receive, =1: ս״̬, =0: սֹͣ״̬ */
+};
+
+/*
+ * Interrupt Enable Register of GMAC's DMA 	Offset: 0x1C
+ */
+enum GDMA_IEN_R
+{
+	gdma_ienable_nis		= (1<<16),		/* Normal Interrupt Summary Enable, =1: жʹ, =0: жϲʹ */
+	gdma_ienable_ais		= (1<<15),		/* Abnormal Interrupt Summary Enable, =1: жʹ, =0: жϲʹ */
+	gdma_ienable_erxi		= (1<<14),		/* Early Receive Interrupt Enable, ڽжʹ, =1: ڽжʹ */
+	gdma_ienable_fbei		= (1<<13),		/* Fatal Bus Error Enable, =1: жʹ */
+	gdma_ienable_etxi		= (1<<10),		/* Early Transmit Interrupt Enable, =1: ʹڴж */
+	gdma_ienable_rxwt		= (1<<9),		/* Receive Watchdog Timeout Enable, =1: ʹܽտŹʱж */
+	gdma_ienable_rxstop		= (1<<8),		/* Receive Stopped Enable, =1: ʹֹܽͣж */
+	gdma_ienable_rxbufu		= (1<<7),		/* Receive Buffer Unavailable Enable, =1: ʹܽջж */
+	gdma_ienable_rxi		= (1<<6),		/* Receive Interrupt Enable, =1: ʹܽж */
+	gdma_ienable_txunf		= (1<<5),		/* Underflow Interrupt Enable, =1: ʹܴFIFOж */
+	gdma_ienable_rxovf		= (1<<4),		/* Overflow Interrupt Enable, =1: ʹܽFIFOж */
+	gdma_ienable_txjt		= (1<<3),		/* Transmit Jabber Timeout Enable, =1: ʹJabberʱж */
+	gdma_ienable_txbufu		= (1<<2),		/* Transmit Buffer Unavailable Enable, =1: ʹܴ仺治ж */
+	gdma_ienable_txstop		= (1<<1),		/* Transmit Stopped Enable, =1: ʹֹܴͣж */
+	gdma_ienable_txi		= (1<<0),		/* Transmit Interrupt Enable, =1: ʹܴж */
+
+	gdma_ien_base = (gdma_ienable_nis | gdma_ienable_ais | gdma_ienable_fbei),
+	gdma_ien_rx	  = (gdma_ienable_rxstop | gdma_ienable_rxi | gdma_ienable_rxbufu),
+	gdma_ien_tx	  = (gdma_ienable_txstop | gdma_ienable_txi | gdma_ienable_txbufu | gdma_ienable_txunf),
+};
+
+/*
+ * Receive Interrupt Watchdog Timer Register of GMAC's DMA 	Offset: 0x24
+ */
+#define gdma_riwt_mask			0xFF			/* bits: 7-0, RI Watchdog Timer count, λ 256 ϵͳʱ.
+												    RDES1[31]=1 ʱ, һ֡ɺü, ʱλ RI */
+
+//-------------------------------------------------------------------------------------------------
+// DMA Descriptor
+//-------------------------------------------------------------------------------------------------
+
+#define ENH_DESC        1
+
+/*
+ * Receive Descriptor RDES0 - Status
+ */
+enum RDESC0_Status
+{
+	rxdesc0_stat_own			= (1<<31),		/* OWN, =1: ǰDMA, =0: . DMAģһδʱ, Ὣλ0 */
+	rxdesc0_stat_afm			= (1<<30),		/* Destination Address Filter Fail, Ŀַ˴. =1: ǰ֡ĿַGMACڲ֡Ŀַ */
+	rxdesc0_stat_fl_mask    	= (0x3FFF<<16), /* bit29~16, Frame length ֡, ʾյǰ֡ĳ, ESλΪ0ʱЧ */
+	rxdesc0_stat_fl_shift   	= 16,
+	rxdesc0_stat_es      		= (1<<15),		/* Error Summary Ϣ, ָʾǰ֡Ƿ, ֵΪRDES[0,1,3,4,6,7,11,14]λ(OR)Ľ */
+	rxdesc0_stat_de				= (1<<14),		/* Descriptor Error , =1: ǰָbuffer֡OWNΪ0() */
+	rxdesc0_stat_saf			= (1<<13),		/* Source Address Filter Fail Դַ˴, =1: ǰ֡ԴַGMACڲ֡Դַ */
+	rxdesc0_stat_le				= (1<<12),		/* Length Error ȴ, =1: ǰ֡ĬϳȲ. Frame TypeλΪ1CRC ErrorλΪ0ʱЧ */
+	rxdesc0_stat_oe				= (1<<11),		/* Over Flow Error , =1: ո֡ʱGMACڲRxFIFO */
+	rxdesc0_stat_vlan			= (1<<10),		/* VLAN Tag VLAN־, =1: ֡ΪVLAN */
+	rxdesc0_stat_fs				= (1<<9),		/* First Desciptor һ, =1: ǰָbufferΪǰ֡ĵһbuffer */
+	rxdesc0_stat_ls				= (1<<8),		/* Last Desciptor һ, =1: ǰָbufferΪǰ֡һbuffer */
+	rxdesc0_stat_ipce_gf		= (1<<7),		/* IPC Checksum Error/Giant Frame У/֡.
+	 	 	 	 	 	 	 	 	 	 	 	   =1: IPCУ鹦ʾǰ֡IPv4ͷУֵ֡ڲУֵ.
+	 	 	 	 	 	 	 	 	 	 	 	 	 - δʾǰ֡Ϊһ֡(ȴ1518ֽ) */
+	rxdesc0_stat_lc				= (1<<6),		/* Late Collision ڳͻ, =1: ڰ˫ģʽ, ǰ֡ʱһڳͻ */
+	rxdesc0_stat_ft				= (1<<5),		/* Frame Type ֡, =1: ǰ֡Ϊһ̫ʽ֡, =0: ǰ֡ΪһIEEE802.3ʽ֡ */
+	rxdesc0_stat_rwt			= (1<<4),		/* Receive Watchdog Timeout, =1: ǰʱֵ˽ģ鿴Ź·ʱӵֵ, Ƚ֡ʱ */
+	rxdesc0_stat_re				= (1<<3),		/* Receive Error մ, =1: յǰ֡ʱڲģ. ڲźrxer1rxdv1 */
+	rxdesc0_stat_dbe			= (1<<2),		/* Dribble bit Error λ, =1: ֡Ȳ, ܳΪλ, λֻmiiģʽЧ */
+	rxdesc0_stat_ce				= (1<<1),		/* CRC Error CRCУ, =1: յǰ֡ʱڲCRCУ. λֻlast descriptor(RDES0[8])Ϊ1ʱЧ */
+#if ENH_DESC
+    rxdesc0_stat_extsts   		= (1<<0),   	/* Extended Status Available (RDES4) */
+    rxdesc0_stat_pce			= (1<<0),		/* Payload Checksum Error, ʹ16ֽ IPC ʹʱЧ.
+    											    FT(bit5)/IPCE(bit7) һʾУ:
+    											   - 1 0 0: IPv4/6 ֡, Уȷ
+    											   - 1 0 1: (TCP/UDP/ICMP)У
+    											   - 1 1 x: IP ͷУ
+    											   - 0 x x:  IP ֵ߲֧֡ĸ, ӲûУ */
+#else
+	rxdesc0_stat_rmpce			= (1<<0),		/* RX GMAC Checksum/payload Checksum Error У/У.
+												   =1: յǰ֡ʱڲRX GMACĴ1-15дһƥ䵱ǰ֡Ŀĵַ.
+												   =0: RX GMAC Ĵ0ƥ֡Ŀĵַ. Full Checksum Offload Engineʱ,
+												   =1: ֡TCP/UDP/ICMPУ. λΪ1ʱҲܱʾǰ֡ʵʽܳ֡ڲسȲ. */
+#endif
+};
+
+/*
+ * Receive Descriptor RDES1 - Control, Address
+ */
+enum RDESC1_Control
+{
+	rxdesc1_ctrl_di				= (1<<31),		/* (Disable Rx int on completion) */
+	rxdesc1_ctrl_UDF    		= (1<<30),
+#if ENH_DESC
+	rxdesc1_ctrl_bs2_mask	    = 0x1FFF0000,   /* (TBS2) 	Buffer 2 size, [28:16] */
+	rxdesc1_ctrl_bs2_shift      = 16,
+	rxdesc1_ctrl_rer       	    = (1<<15),   	/* (RER)	End of descriptors ring */
+	rxdesc1_ctrl_rch            = (1<<14),   	/* (RCH)	Second buffer address is chain address */
+	rxdesc1_ctrl_bs1_mask	    = 0x00001FFF,   /* (TBS1) 	Buffer 1 size, [12:0] */
+#else
+	rxdesc1_ctrl_rer			= (1<<25),		/* Receive End of Ring, =1: Ϊһ, һĵַΪĻַ */
+	rxdesc1_ctrl_rch			= (1<<24),		/* Second Address Chained, =1: еĵڶbufferַָһĵַ */
+	rxdesc1_ctrl_bs2_mask		= (0x07FF<<11),	/* bits: 21-11, Receive Buffer Size 2, ʾbuffer2ĴС */
+	rxdesc1_ctrl_bs2_shift	 	= 11,
+	rxdesc1_ctrl_bs1_mask		= (0x07FF<<0),	/* bits: 10-0, Receive Buffer Size 1, ʾbuffer1ĴС */
+#endif
+};
+
+/*
+ * Transmit Descriptor TDES0 - Status
+ */
+enum TDESC0_Status
+{
+    txdesc0_stat_own			= (1<<31),
+#if ENH_DESC
+	txdesc0_stat_ic 			= (1<<30),		/* (IC)		Tx - interrupt on completion */
+	txdesc0_stat_ls				= (1<<29),		/* (LS)		Tx - Last segment of the frame */
+	txdesc0_stat_fs				= (1<<28),		/* (FS)		Tx - First segment of the frame */
+	txdesc0_stat_dc				= (1<<27),		/* (DC)		Tx - Add CRC disabled (first segment only) */
+	txdesc0_stat_dp				= (1<<26),		/* (DP)		Tx - Disable padding */
+	txdesc0_stat_tten			= (1<<25),		/* Time Stamp Enable */
+	txdesc0_stat_cic_mask		= 0x00c00000,   /* Tx checksum offloading control mask [23:22] */
+	txdesc0_stat_cic_shift		= 22,
+	txdesc0_stat_cic_bypass		= 0x00000000,   /* Checksum bypass */
+	txdesc0_stat_ipv4	  		= 0x00400000,	/* IPv4 header checksum */
+	txdesc0_stat_tcp			= 0x00800000,	/* TCP/UDP/ICMP checksum. Pseudo header checksum is assumed to be present */
+	txdesc0_stat_full			= 0x00c00000,	/* TCP/UDP/ICMP checksum fully in hardware including pseudo header */
+	txdesc0_stat_ter		    = (1<<21),		/* (TER)End of descriptors ring */
+	txdesc0_stat_tch			= (1<<20),   	/* (TCH)Second buffer address is chain address */
+#endif
+	txdesc0_stat_UDF    		= (1<<17),
+	txdesc0_stat_ihe			= (1<<16),		/* IP Header Error, =1: ʾڲУģ鷢ָ÷֡IPͷ, ҲԸκ޸ */
+	txdesc0_stat_es				= (1<<15),		/* Error Summary, ָʾǰ֡Ƿ, ֵΪTDES[1,2,8,9,10,11,13,14]λ(OR)Ľ */
+	txdesc0_stat_jt				= (1<<14),		/* Jabber Timeout, =1: ʾGMACģJabberʱ */
+	txdesc0_stat_ff				= (1<<13),		/* Frame Flushed, =1: ʾһˢDMA/MTLڲ֡ˢµ */
+	txdesc0_stat_pce			= (1<<12),		/* Payload Checksum Error, =1: ʾڲУģ֡вУʱ. Уģʱ, λЧ */
+	txdesc0_stat_lc				= (1<<11),		/* Loss of Carrier, =1: ʾڷ͸֡زʧ(gmii_crsźŶδ) */
+	txdesc0_stat_nc				= (1<<10),		/* No Carrier, =1: ʾڷ͹, PHYزźһֱδ */
+	txdesc0_stat_lco			= (1<<9),		/* Late Collision, =1: ʾڰ˫ģʽ, ǰ֡ʱһڳͻ */
+	txdesc0_stat_ec				= (1<<8),		/* Excessive Collison, =1: ʾڷ͵ǰ֡ʱ16γͻ */
+	txdesc0_stat_vf				= (1<<7),		/* VLAN Frame, =1: ʾǰ֡ΪһVLAN֡ */
+	txdesc0_stat_cc_mask		= (0x0F<<3),	/* bits: 6-3, Collsion Count, ʾǰ֡ڳɹ֮ǰͻ */
+	txdesc0_stat_cc_shift   	= 3,
+	txdesc0_stat_ed				= (1<<2),		/* Excessive Deferral, =1: ʾǰ֡ */
+	txdesc0_stat_uf				= (1<<1),		/* Underflow Error, =1: ʾǰ֡ʱ, ݴbufferС򲻿 */
+	txdesc0_stat_db				= (1<<0),		/* Defered Bit, =1: ʾ˴ηͱӳ, ֻڰ˫ģʽЧ */
+};
+
+/*
+ * Transmit Descriptor TDES1 - Control, Address
+ */
+enum TDESC1_Control
+{
+#if ENH_DESC
+	txdesc1_ctrl_bs2_mask	    = 0x1FFF0000,   /* (TBS2)     Buffer 2 size, [28:16] */
+	txdesc1_ctrl_bs2_shift      = 16,
+	txdesc1_ctrl_bs1_mask	    = 0x00001FFF,   /* (TBS1)     Buffer 1 size, [12:0] */
+#else
+	txdesc1_ctrl_ic				= (1<<31),		/* Interrption on Complete, =1: ʾ֡ӷɺ󽫻STATUSĴTIλ(CSR5[0]) */
+	txdesc1_ctrl_ls				= (1<<30),		/* Last Segment, =1: ʾǰbufferһ֡ݵһ(֡Ϊ) */
+	txdesc1_ctrl_fs				= (1<<29),		/* First Segment, =1: ʾǰbufferһ֡ݵĵһ(֡Ϊ) */
+	txdesc1_ctrl_cic_mask		= (0x02<<27),	/* bits: 28-27, Checksum Insertion Control, ڲģǷڷ֡У */
+	txdesc1_ctrl_cic_shift  	= 27,
+	txdesc1_ctrl_cic_ipv4		= (1<<27),
+	txdesc1_ctrl_cic_tcp		= (1<<28),
+	txdesc1_ctrl_cic_all		= (0x02<<27),
+	txdesc1_ctrl_dc				= (1<<26),		/* =1, Disable CRC, =1: GMACӲÿ֡ĽβCRCУ */
+	txdesc1_ctrl_ter			= (1<<25),		/* Transmit End of Ring, =1: ʾΪһ, һĵַΪĻַ */
+	txdesc1_ctrl_tch			= (1<<24),		/* Second Address Chained, =1: ʾеĵڶbufferַָһĵַ  */
+	txdesc1_ctrl_dp				= (1<<23),		/* Dissable Pading, =1: ʾGMACԳС64ֽڵݰп */
+	txdesc1_ctrl_ttse			= (1<<22),		/* Transmit Time Stamp Enable, =1: ʾڲģIEEE1588Ӳʱ, TDES1[29]Ϊ1ʱЧ */
+	txdesc1_ctrl_bs2_mask		= (0x07FF<<11),	/* bits: 21-11, Transmit Buffer Size 2, ʾbuffer2ĴС. TDES1[24]Ϊ1ʱ, Ч */
+	txdesc1_ctrl_bs2_shift 	    = 11,
+	txdesc1_ctrl_bs1_mask		= (0x07FF<<0),	/* bits: 10-0, Transmit Buffer Size 1, ʾbuffer1ĴС. һֱЧ */
+#endif
+};
+
+/*
+ * GMAC DMA Receive and Transmit Descriptor
+ * __attribute__((packed)): ߱ȡṹڱеŻ,ʵռֽж---GCCе﷨
+ */
+
+typedef struct
+{
+	volatile unsigned int status;     	/* Status */
+	volatile unsigned int control;		/* 31-22: Control; 21-11: Buffer 2 lenght; 10-0: Buffer 1 length */
+	volatile unsigned int bufptr;		/* Buffer 1 pointer */
+	volatile unsigned int nextdesc;		/* Next descriptor pointer (Dma-able) in chain structure */
+	volatile unsigned int tmp0;
+	volatile unsigned int tmp1;
+	volatile unsigned int tmp2;
+	volatile unsigned int tmp3;
+} GDMA_DESC_t; // __attribute__((packed));
+
+typedef GDMA_DESC_t 	RX_DESC_t;
+typedef GDMA_DESC_t 	TX_DESC_t;
+
+#if 0
+struct dma_desc
+{
+	/* Receive descriptor */
+	union
+	{
+		struct
+		{
+			/* RDES0 */
+			unsigned int reserved1:1;
+			unsigned int crc_error:1;
+			unsigned int dribbling:1;
+			unsigned int mii_error:1;
+			unsigned int receive_watchdog:1;
+			unsigned int frame_type:1;
+			unsigned int collision:1;
+			unsigned int frame_too_long:1;
+			unsigned int last_descriptor:1;
+			unsigned int first_descriptor:1;
+			unsigned int multicast_frame:1;
+			unsigned int run_frame:1;
+			unsigned int length_error:1;
+			unsigned int partial_frame_error:1;
+			unsigned int descriptor_error:1;
+			unsigned int error_summary:1;
+			unsigned int frame_length:14;
+			unsigned int filtering_fail:1;
+			unsigned int own:1;
+
+			/* RDES1 */
+			unsigned int buffer1_size:11;
+			unsigned int buffer2_size:11;
+			unsigned int reserved2:2;
+			unsigned int second_address_chained:1;
+			unsigned int end_ring:1;
+			unsigned int reserved3:5;
+			unsigned int disable_ic:1;
+		} rx;
+
+		struct		/* -- enhanced -- */
+		{
+			/* RDES0 */
+			unsigned int payload_csum_error:1;
+			unsigned int crc_error:1;
+			unsigned int dribbling:1;
+			unsigned int error_gmii:1;
+			unsigned int receive_watchdog:1;
+			unsigned int frame_type:1;
+			unsigned int late_collision:1;
+			unsigned int ipc_csum_error:1;
+			unsigned int last_descriptor:1;
+			unsigned int first_descriptor:1;
+			unsigned int vlan_tag:1;
+			unsigned int overflow_error:1;
+			unsigned int length_error:1;
+			unsigned int sa_filter_fail:1;
+			unsigned int descriptor_error:1;
+			unsigned int error_summary:1;
+			unsigned int frame_length:14;
+			unsigned int da_filter_fail:1;
+			unsigned int own:1;
+
+			/* RDES1 */
+			unsigned int buffer1_size:13;
+			unsigned int reserved1:1;
+			unsigned int second_address_chained:1;
+			unsigned int end_ring:1;
+			unsigned int buffer2_size:13;
+			unsigned int reserved2:2;
+			unsigned int disable_ic:1;
+		} erx;		/* -- enhanced -- */
+
+		/* Transmit descriptor */
+		struct
+		{
+			/* TDES0 */
+			unsigned int deferred:1;
+			unsigned int underflow_error:1;
+			unsigned int excessive_deferral:1;
+			unsigned int collision_count:4;
+			unsigned int heartbeat_fail:1;
+			unsigned int excessive_collisions:1;
+			unsigned int late_collision:1;
+			unsigned int no_carrier:1;
+			unsigned int loss_carrier:1;
+			unsigned int reserved1:3;
+			unsigned int error_summary:1;
+			unsigned int reserved2:15;
+			unsigned int own:1;
+			/* TDES1 */
+			unsigned int buffer1_size:11;
+			unsigned int buffer2_size:11;
+			unsigned int reserved3:1;
+			unsigned int disable_padding:1;
+			unsigned int second_address_chained:1;
+			unsigned int end_ring:1;
+			unsigned int crc_disable:1;
+			unsigned int reserved4:2;
+			unsigned int first_segment:1;
+			unsigned int last_segment:1;
+			unsigned int interrupt:1;
+		} tx;
+
+		struct 		/* -- enhanced -- */
+		{
+			/* TDES0 */
+			unsigned int deferred:1;
+			unsigned int underflow_error:1;
+			unsigned int excessive_deferral:1;
+			unsigned int collision_count:4;
+			unsigned int vlan_frame:1;
+			unsigned int excessive_collisions:1;
+			unsigned int late_collision:1;
+			unsigned int no_carrier:1;
+			unsigned int loss_carrier:1;
+			unsigned int payload_error:1;
+			unsigned int frame_flushed:1;
+			unsigned int jabber_timeout:1;
+			unsigned int error_summary:1;
+			unsigned int ip_header_error:1;
+			unsigned int time_stamp_status:1;
+			unsigned int reserved1:2;
+			unsigned int second_address_chained:1;
+			unsigned int end_ring:1;
+			unsigned int checksum_insertion:2;
+			unsigned int reserved2:1;
+			unsigned int time_stamp_enable:1;
+			unsigned int disable_padding:1;
+			unsigned int crc_disable:1;
+			unsigned int first_segment:1;
+			unsigned int last_segment:1;
+			unsigned int interrupt:1;
+			unsigned int own:1;
+
+			/* TDES1 */
+			unsigned int buffer1_size:13;
+			unsigned int reserved3:3;
+			unsigned int buffer2_size:13;
+			unsigned int reserved4:3;
+		} etx;		/* -- enhanced -- */
+	} des01;
+	unsigned int des2;
+	unsigned int des3;
+};
+
+/* Transmit checksum insertion control */
+enum tdes_csum_insertion
+{
+	cic_disabled        = 0,	/* Checksum Insertion Control */
+	cic_only_ip         = 1,	/* Only IP header */
+	cic_no_pseudoheader = 2,	/* IP header but pseudoheader is not calculated */
+	cic_full            = 3,	/* IP header and pseudoheader */
+};
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// MII
+//-------------------------------------------------------------------------------------------------
+
+/*
+ * mii status defination
+ */
+typedef enum
+{
+	LINKDOWN	= 0,
+	LINKUP		= 1,
+} mii_sr_t;
+
+typedef enum
+{
+	HALFDUPLEX	= 1,
+	FULLDUPLEX	= 2,
+} link_sr_t;
+
+typedef enum
+{
+	SPEED10     = 1,
+	SPEED100    = 2,
+	SPEED1000   = 3,
+} speed_t;
+
+/*
+ * mac-dma desc mode
+ */
+typedef enum
+{
+	RINGMODE	= 0,
+	CHAINMODE	= 1,
+} desc_mode_t;
+
+//-------------------------------------------------------------------------------------------------
+// macro for operate
+//-------------------------------------------------------------------------------------------------
+
+/*
+ * start gmac-dma
+ */
+#define GDMA_START_RX(hwGDMA) do { hwGDMA->control |= gdma_ctrl_rxstart; } while (0)
+#define GDMA_START_TX(hwGDMA) do { hwGDMA->control |= gdma_ctrl_txstart; } while (0)
+#define GDMA_START(hwGDMA)    do { hwGDMA->control |= (gdma_ctrl_txstart | gdma_ctrl_rxstart); } while (0)
+
+/*
+ * stop gmac-dma
+ */
+#define GDMA_STOP_RX(hwGDMA) do { hwGDMA->control &= ~gdma_ctrl_rxstart; } while (0)
+#define GDMA_STOP_TX(hwGDMA) do { hwGDMA->control &= ~gdma_ctrl_txstart; } while (0)
+#define GDMA_STOP(hwGDMA)    do { hwGDMA->control &= ~(gdma_ctrl_txstart | gdma_ctrl_rxstart); } while (0)
+
+/*
+ * gmac-dma interrupt
+ */
+#define GDMA_INT_EN(hwGDMA)  do { hwGDMA->intenable = (gdma_ien_base | gdma_ien_rx | gdma_ien_tx); } while (0)
+#define GDMA_INT_DIS(hwGDMA) do { hwGDMA->intenable = 0; } while (0)
+
+/* رսж, ѯ */
+#define GDMA_INT_EN_NORX(hwGDMA) do { hwGDMA->intenable = (gdma_ien_base | gdma_ienable_rxstop | gdma_ien_tx); } while (0)
+
+/*
+ * gmac start
+ */
+#define GMAC_START_TX(hwGMAC) do { hwGMAC->config |= gmac_ctrl_te; } while (0)
+#define GMAC_START_RX(hwGMAC) do { hwGMAC->config |= gmac_ctrl_re; } while (0)
+#define GMAC_START(hwGMAC)    do { hwGMAC->config |= (gmac_ctrl_te | gmac_ctrl_re); } while (0)
+
+/*
+ * gmac stop
+ */
+#define GMAC_STOP_TX(hwGMAC) do { hwGMAC->config &= ~gmac_ctrl_te; } while (0)
+#define GMAC_STOP_RX(hwGMAC) do { hwGMAC->config &= ~gmac_ctrl_re; } while (0)
+#define GMAC_STOP(hwGMAC)    do { hwGMAC->config &= ~(gmac_ctrl_te | gmac_ctrl_re); } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LS2K_GMAC_HW_H
+
+/*
+ * @@ END
+ */
+
+
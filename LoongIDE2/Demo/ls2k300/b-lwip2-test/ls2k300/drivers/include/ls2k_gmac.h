@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_gmac.h
+ *
+ * created: 2022-03-10
+ *  author: Bian
+ */
+
+#ifndef _LS2K_GMAC_H
+#define _LS2K_GMAC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------------------------------------------------
+// GMAC devices
+//-----------------------------------------------------------------------------
+
+#if BSP_USE_GMAC0
+extern const void *devGMAC0;
+#endif
+#if BSP_USE_GMAC1
+extern const void *devGMAC1;
+#endif
+
+//-----------------------------------------------------------------------------
+// GMAC Interrupt Callback function
+//-----------------------------------------------------------------------------
+
+typedef int (*net_rx_callback_t)(void);
+typedef int (*net_tx_callback_t)(void);
+
+//-----------------------------------------------------------------------------
+// Ioctl command
+//-----------------------------------------------------------------------------
+
+#define IOCTL_GMAC_START            0x0101      /* start GMAC hardware */
+#define IOCTL_GMAC_STOP             0x0102      /* stop GMAC hardware */
+#define IOCTL_GMAC_RESET            0x0103      /* reset GMAC hardware */
+
+#define IOCTL_GMAC_SET_MACADDR      0x0105      /* set mac address */
+#define IOCTL_GMAC_SET_TIMEOUT      0x0106      /* wait transmit/receive time out */
+
+#define IOCTL_GMAC_IS_RUNNING       0x0107      /* GMAC is running? started or not */
+#define IOCTL_GMAC_SHOW_STATS       0x0108
+
+#define IOCTL_GMAC_SET_TXDONE_CB    0x0109      /* set scatter-gather tx complete callback */
+#define IOCTL_GMAC_SET_RXBUF_ALLOC  0x010A      /* attach external rx buffers, zero copy */
+#define IOCTL_GMAC_SET_RX_COALESCE  0x010B      /* rx interrupt watchdog timer, RIWT */
+#define IOCTL_GMAC_SET_CSUM_OFFLOAD 0x010C      /* IPv4/TCP/UDP/ICMP checksum offload */
+
+//-----------------------------------------------------------------------------
+// GMAC scatter-gather transmit, zero copy
+//-----------------------------------------------------------------------------
+
+#define GMAC_TX_DESC_NUM            16          /* ÿ GMAC ķ */
+#define GMAC_TX_MAX_SEGS            8           /* һ֡ռõķ */
+
+typedef struct
+{
+    void *buf;                                  /* ݶεַ */
+    int   len;                                  /* ݶγ, > 0 */
+} gmac_txseg_t;
+
+/*
+ * ɻص,  GMAC же
+ * :    dev     devGMAC0/devGMAC1
+ *          cookie  ls2k_gmac_send_sg()  cookie
+ */
+typedef void (*gmac_txdone_callback_t)(const void *dev, void *cookie);
+
+//-----------------------------------------------------------------------------
+// GMAC receive into external buffers, zero copy
+//-----------------------------------------------------------------------------
+
+#define GMAC_RX_BUF_SIZE            1536        /* ջ, ⲿСڸֵ */
+
+/*
+ * ջ亯,  IOCTL_GMAC_SET_RXBUF_ALLOC  ls2k_gmac_recv_zerocopy()
+ * е, же.
+ * :    dev     devGMAC0/devGMAC1
+ *          buf     : ַ, ȲС GMAC_RX_BUF_SIZE
+ *
+ * :    cookie, NULL ʾʧ
+ */
+typedef void *(*gmac_rxbuf_alloc_t)(const void *dev, unsigned char **buf);
+
+typedef struct
+{
+    void *cookie;                               /* Ÿ֡Ļ */
+    int   len;                                  /* ֡ */
+    int   csum_ok;                              /* =1: ӲУ IP ͷ TCP/UDP/ICMP  */
+} gmac_rxframe_t;
+
+/*
+ * TODO GMAC ·״̬
+ */
+
+//-----------------------------------------------------------------------------
+// GMAC driver operators
+//-----------------------------------------------------------------------------
+
+#include "ls2k_drv_io.h"
+
+#if (PACK_DRV_OPS)
+
+extern const driver_ops_t *gmac_drv_ops;
+
+#define ls2k_gmac_init(gmac, arg)             gmac_drv_ops->init_entry(gmac, arg)
+#define ls2k_gmac_read(gmac, buf, size, arg)  gmac_drv_ops->read_entry(gmac, buf, size, arg)
+#define ls2k_gmac_write(gmac, buf, size, arg) gmac_drv_ops->write_entry(gmac, buf, size, arg)
+#define ls2k_gmac_ioctl(gmac, cmd, arg)       gmac_drv_ops->ioctl_entry(gmac, cmd, arg)
+
+#else
+
+/*
+ * GMACʼ
+ * :    dev     devGMAC0/devGMAC1
+ *          arg     NULL
+ *
+ * :    0=ɹ
+ */
+int GMAC_initialize(const void *dev, void *arg);
+
+/*
+ * GMACȡյ
+ * :    dev     devGMAC0/devGMAC1
+ *          buf     : char *, ڴŶȡݵĻ
+ *          size    : int, ȡֽ, Ȳܳ buf 
+ *          arg     NULL
+ *
+ * :    ζȡֽ
+ */
+int GMAC_read(const void *dev, void *buf, int size, void *arg);
+
+/*
+ * GMACд͵
+ * :    dev     devGMAC0/devGMAC1
+ *          buf     : char *, ڴŴݵĻ
+ *          size    : int, ͵ֽ, Ȳܳ buf 
+ *          arg     NULL
+ *
+ * :    η͵ֽ
+ */
+int GMAC_write(const void *dev, void *buf, int size, void *arg);
+
+/*
+ * GMAC 
+ * :    dev     devGMAC0/devGMAC1
+ *
+ *      ---------------------------------------------------------------------------------
+ *          cmd                         |   arg
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_START            |   NULL, GMAC豸
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_STOP             |   NULL, ֹͣGMAC豸
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_RESET            |   NULL, λGMAC豸
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_SET_TIMEOUT      |   : unsigned int
+ *                                      |   ;: ý/͵ĳʱȴʱ(ms)
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_IS_RUNNING       |   NULL, GMAC豸Ƿ
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_SHOW_STATS       |   NULL, ӡGMAC豸ͳϢ
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_SET_TXDONE_CB    |   : gmac_txdone_callback_t
+ *                                      |   ;:  ls2k_gmac_send_sg() ķɻص
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_SET_RXBUF_ALLOC  |   : gmac_rxbuf_alloc_t
+ *                                      |   ;: Ϊÿҽⲿ, 
+ *                                      |         IOCTL_GMAC_START ֮ǰ, ֻһ.
+ *                                      |         عҽӳɹ
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_SET_RX_COALESCE  |   : unsigned int, 0~255
+ *                                      |   ;: жϿŹ, λ 256 ϵͳʱ.
+ *                                      |         һ֡ɺʱж, 0: ж
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_SET_CSUM_OFFLOAD |   : int, 1: ʹ; 0: ر
+ *                                      |   ;: ʱӲ IPv4 ͷ TCP/UDP/ICMP У,
+ *                                      |         ʱӲ, У֡.
+ *                                      |          -1 ʾӲ֧
+ *      ---------------------------------------------------------------------------------
+ *
+ * :    0=ɹ
+ */
+int GMAC_ioctl(const void *dev, int cmd, void *arg);
+
+#define ls2k_gmac_init(gmac, arg)             GMAC_initialize(gmac, arg)
+#define ls2k_gmac_read(gmac, buf, size, arg)  GMAC_read(gmac, buf, size, arg)
+#define ls2k_gmac_write(gmac, buf, size, arg) GMAC_write(gmac, buf, size, arg)
+#define ls2k_gmac_ioctl(gmac, cmd, arg)       GMAC_ioctl(gmac, cmd, arg)
+
+#endif
+
+//-----------------------------------------------------------------------------
+// GMAC driver api
+//-----------------------------------------------------------------------------
+
+/*
+ * ȴGMACյ
+ * :    dev     devGMAC0/devGMAC1
+ *          bufptr  : unsigned char **, GMACڲջַ
+ *
+ * :    0=ɹ
+ *
+ * ˵:    1. RTOSµøúʱ, ʹRTOS¼ʵ޵ȴ;
+ *          2. µøúʱ, ȴʱΪIOCTL_GMAC_SET_TIMEOUTõĳʱ
+ */
+int ls2k_gmac_wait_receive_packet(const void *dev, unsigned char **bufptr);
+
+/*
+ * ȴGMACʱ
+ * :    dev     devGMAC0/devGMAC1
+ *          bufptr  : unsigned char **, GMACڲջַ
+ *
+ * :    0=ɹ
+ *
+ * ˵:    1. RTOSµøúʱ, ʹRTOS¼ʵ޵ȴ;
+ *          2. µøúʱ, ȴʱΪIOCTL_GMAC_SET_TIMEOUTõĳʱ
+ */
+int ls2k_gmac_wait_transmit_idle(const void *dev, unsigned char **bufptr);
+
+#define ls2k_gmac_wait_rx_packet(gmac, pbuf)  ls2k_gmac_wait_receive_packet(gmac, pbuf)
+#define ls2k_gmac_wait_tx_idle(gmac, pbuf)    ls2k_gmac_wait_transmit_idle(gmac, pbuf)
+
+/*
+ * ֶηһ֡, 
+ * :    dev     devGMAC0/devGMAC1
+ *          segs    : gmac_txseg_t *, ݶ, ÿռһ
+ *          nsegs   ݶθ, ܳ GMAC_TX_MAX_SEGS
+ *          cookie  ɺ󴫸 IOCTL_GMAC_SET_TXDONE_CB õĻص
+ *
+ * :    >0: η͵ֽ; 0: ; <0: 
+ *
+ * ˵:    1. ǰ, ݶεڴ治ͷŻ޸;
+ *          2.  >0 ʱ, cookie һͨص.
+ */
+int ls2k_gmac_send_sg(const void *dev, const gmac_txseg_t *segs, int nsegs, void *cookie);
+
+/*
+ * ȡһ֡, 
+ * :    dev     devGMAC0/devGMAC1
+ *          cookie  : Ÿ֡ĻӦ cookie
+ *
+ * :    >0: ֡; 0: ûݻ߶һ֡; <0: 
+ *
+ * ˵:    1. Ҫ IOCTL_GMAC_SET_RXBUF_ALLOC ҽⲿ;
+ *          2. ڻʼλ, ȡߵĻɵͷ;
+ *          3. ·Ļ, ʧʱ֡.
+ */
+int ls2k_gmac_recv_zerocopy(const void *dev, void **cookie);
+
+/*
+ * ȡ߽, 
+ * :    dev     devGMAC0/devGMAC1
+ *          frames  : gmac_rxframe_t *, ȡߵ֡
+ *          budget  ȡߵ֡
+ *
+ * :    >=0: ȡߵ֡; <0: ûйҽⲿ
+ *
+ * ˵:    1. һεú, жֻѽһ, Ȼرսж;
+ *          2. ֵС budget ʱջѿ, ´򿪽ж, ߵȴ
+ *             һν¼;  budget ʱӦ.
+ */
+int ls2k_gmac_rx_burst(const void *dev, gmac_rxframe_t *frames, int budget);
+
+//-----------------------------------------------------------------------------
+// GMAC device name
+//-----------------------------------------------------------------------------
+
+const char *ls2k_gmac_get_device_name(const void *pMAC);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LS2K_GMAC_H
+
@@ -70,6 +70,24 @@ void lwip_test(void)
         }
         #endif
 
+        #if (TEST_UDP_TX_BENCH)
+        {
+            udp_tx_bench_init();
+        }
+        #endif
+
+        #if (TEST_MBOX_BENCH)
+        {
+            mbox_bench_init();
+        }
+        #endif
+
+        #if (TEST_RX_INPUT_BENCH)
+        {
+            rx_input_bench_init();
+        }
+        #endif
+
     }
     #endif
 
@@ -0,0 +1,419 @@
+/*
+ * lwip_bench.c
+ *
+ * created: 2026-10-17
+ *  author:
+ */
+
+#include "lwip_test.h"
+
+#if (TEST_UDP_TX_BENCH || TEST_MBOX_BENCH || TEST_RX_INPUT_BENCH)
+
+#include "bsp.h"
+#include "ls2k300.h"
+#include <stdio.h>
+#include <string.h>
+
+#if BSP_USE_OS
+
+#include "lwip/api.h"
+#include "lwip/netbuf.h"
+#include "lwip/netif.h"
+#include "lwip/sys.h"
+#include "lwip/tcpip.h"
+
+#include "osal.h"
+
+#if TEST_UDP_TX_BENCH
+
+//---------------------------------------------------------------------------------------
+
+#define BENCH_UDP_PORT          9064            // Զ̶˿
+#define BENCH_PKT_SIZE          1400            // UDP ݳ
+#define BENCH_RUN_MS            5000            // ÿʱ
+
+extern void ethernetif_set_tx_zerocopy(struct netif *netif, int enable);
+
+/*
+ * ÿ tick  burst .
+ *
+ * CPU% ǵ netconn_send() ʱռʱı, ʹ core locking ʱ
+ * netconn_send() ڱ UDP/IP װ low_level_output().
+ */
+static void udp_tx_bench_run(struct netconn *conn, int zerocopy, int burst)
+{
+    unsigned long start_ticks, cycles_start, cycles_busy = 0, cycles_all;
+    unsigned int pkts = 0, ms, i;
+
+    ethernetif_set_tx_zerocopy(netif_default, zerocopy);
+
+    start_ticks  = get_clock_ticks();
+    cycles_start = get_stable_counter();
+
+    while ((ms = get_clock_ticks() - start_ticks) < BENCH_RUN_MS)
+    {
+        for (i=0; i<burst; i++)
+        {
+            struct netbuf *nb;
+            unsigned int *payload;
+            unsigned long t0;
+            err_t err;
+
+            nb = netbuf_new();
+            if (nb == NULL)
+                break;
+
+            payload = (unsigned int *)netbuf_alloc(nb, BENCH_PKT_SIZE);
+            if (payload == NULL)
+            {
+                netbuf_delete(nb);
+                break;
+            }
+
+            payload[0] = pkts;                  // sequence number
+
+            t0 = get_stable_counter();
+            err = netconn_send(conn, nb);
+            cycles_busy += get_stable_counter() - t0;
+
+            netbuf_delete(nb);
+
+            if (err == ERR_OK)
+                pkts++;
+        }
+
+        osal_task_sleep(1);
+    }
+
+    cycles_all = get_stable_counter() - cycles_start;
+
+    printk("%s burst=%-3i: %u pkts, %u bytes/s, CPU %u%%, %lu counts/pkt\r\n",
+           zerocopy ? "zero-copy" : "copy     ", burst,
+           pkts,
+           (unsigned int)((unsigned long)pkts * BENCH_PKT_SIZE * 1000 / (ms ? ms : 1)),
+           (unsigned int)(cycles_busy * 100 / (cycles_all ? cycles_all : 1)),
+           pkts ? cycles_busy / pkts : 0);
+}
+
+static void udp_tx_bench_thread(void *arg)
+{
+    static const int bursts[] = { 4, 16, 64 };
+    struct netconn *conn;
+    ip_addr_t remote_ip;
+    int i;
+
+    conn = netconn_new(NETCONN_UDP);
+    if (conn == NULL)
+    {
+        printk("failed to create netconn!\r\n");
+        return;
+    }
+
+    ipaddr_aton(remote_IP, &remote_ip);
+    if (netconn_connect(conn, &remote_ip, BENCH_UDP_PORT) != ERR_OK)
+    {
+        printk("failed to connect %s:%i!\r\n", remote_IP, BENCH_UDP_PORT);
+        netconn_delete(conn);
+        return;
+    }
+
+    printk("UDP tx bench, %i bytes payload to %s:%i\r\n",
+           BENCH_PKT_SIZE, remote_IP, BENCH_UDP_PORT);
+
+    for (i=0; i<sizeof(bursts)/sizeof(bursts[0]); i++)
+    {
+        udp_tx_bench_run(conn, 0, bursts[i]);
+        udp_tx_bench_run(conn, 1, bursts[i]);
+    }
+
+    ethernetif_set_tx_zerocopy(netif_default, 1);
+    netconn_delete(conn);
+
+    for (;;)
+    {
+        osal_task_sleep(1000);
+    }
+}
+
+void udp_tx_bench_init(void)
+{
+	sys_thread_new("udp_tx_bench",
+                    udp_tx_bench_thread,
+                    NULL,
+                    DEFAULT_THREAD_STACKSIZE,
+            #ifdef OS_FREERTOS
+                    DEFAULT_THREAD_PRIO - 1
+            #else
+                    DEFAULT_THREAD_PRIO + 1
+            #endif
+                   );
+}
+
+#endif // #if TEST_UDP_TX_BENCH
+
+#if TEST_MBOX_BENCH
+
+//---------------------------------------------------------------------------------------
+
+#define MBOX_BENCH_LOOPS        100000          // ̲߳Դ
+#define MBOX_BENCH_ROUNDS       10000           // Դ
+#define MBOX_BENCH_BURST        32
+
+static sys_mbox_t bench_req, bench_ack;
+static sys_sem_t  bench_sem;
+
+/*
+ * ͬһ post Ȼ tryfetch: л, ֻ䱾Ŀ
+ */
+static void mbox_bench_local(void)
+{
+    unsigned long t0, cycles;
+    void *msg;
+    int i, j;
+
+    t0 = get_stable_counter();
+    for (i=0; i<MBOX_BENCH_LOOPS; i++)
+    {
+        sys_mbox_post(&bench_req, (void *)(unsigned long)(i + 1));
+        sys_arch_mbox_tryfetch(&bench_req, &msg);
+    }
+    cycles = get_stable_counter() - t0;
+
+    printk("post+tryfetch     : %lu counts/msg\r\n", cycles / MBOX_BENCH_LOOPS);
+
+    t0 = get_stable_counter();
+    for (i=0; i<MBOX_BENCH_LOOPS; i+=MBOX_BENCH_BURST)
+    {
+        for (j=0; j<MBOX_BENCH_BURST; j++)
+            sys_mbox_trypost(&bench_req, (void *)(unsigned long)(j + 1));
+        for (j=0; j<MBOX_BENCH_BURST; j++)
+            sys_arch_mbox_tryfetch(&bench_req, &msg);
+    }
+    cycles = get_stable_counter() - t0;
+
+    printk("burst of %-2i       : %lu counts/msg\r\n", MBOX_BENCH_BURST, cycles / MBOX_BENCH_LOOPS);
+}
+
+/*
+ * :  bench_req ȡԭ bench_ack
+ */
+static void mbox_bench_echo_thread(void *arg)
+{
+    void *msg;
+
+    for (;;)
+    {
+        sys_arch_mbox_fetch(&bench_req, &msg, 0);
+        sys_mbox_post(&bench_ack, msg);
+    }
+}
+
+/*
+ * : ÿ䴫ݺ
+ */
+static void mbox_bench_pingpong(void)
+{
+    unsigned long t0, cycles;
+    void *msg;
+    int i;
+
+    t0 = get_stable_counter();
+    for (i=0; i<MBOX_BENCH_ROUNDS; i++)
+    {
+        sys_mbox_post(&bench_req, (void *)(unsigned long)(i + 1));
+        sys_arch_mbox_fetch(&bench_ack, &msg, 0);
+    }
+    cycles = get_stable_counter() - t0;
+
+    printk("task ping-pong    : %lu counts/round\r\n", cycles / MBOX_BENCH_ROUNDS);
+}
+
+static void mbox_bench_callback(void *arg)
+{
+    sys_sem_signal((sys_sem_t *)arg);
+}
+
+/*
+ * tcpip_callback() :  tcpip ̵߳
+ */
+static void mbox_bench_tcpip(void)
+{
+    unsigned long t0, cycles;
+    int i;
+
+    t0 = get_stable_counter();
+    for (i=0; i<MBOX_BENCH_ROUNDS; i++)
+    {
+        if (tcpip_callback(mbox_bench_callback, &bench_sem) != ERR_OK)
+            break;
+        sys_arch_sem_wait(&bench_sem, 0);
+    }
+    cycles = get_stable_counter() - t0;
+
+    printk("tcpip_callback    : %lu counts/round, %i rounds\r\n",
+           i ? cycles / i : 0, i);
+}
+
+static void mbox_bench_thread(void *arg)
+{
+    if ((sys_mbox_new(&bench_req, 64) != ERR_OK) ||
+        (sys_mbox_new(&bench_ack, 64) != ERR_OK) ||
+        (sys_sem_new(&bench_sem, 0) != ERR_OK))
+    {
+        printk("failed to create mbox bench objects!\r\n");
+        return;
+    }
+
+    printk("mbox bench, rdtime counts\r\n");
+
+    mbox_bench_local();
+
+    sys_thread_new("mbox_echo",
+                    mbox_bench_echo_thread,
+                    NULL,
+                    DEFAULT_THREAD_STACKSIZE,
+                    DEFAULT_THREAD_PRIO);
+
+    mbox_bench_pingpong();
+    mbox_bench_tcpip();
+
+    for (;;)
+    {
+        osal_task_sleep(1000);
+    }
+}
+
+void mbox_bench_init(void)
+{
+	sys_thread_new("mbox_bench",
+                    mbox_bench_thread,
+                    NULL,
+                    DEFAULT_THREAD_STACKSIZE,
+                    DEFAULT_THREAD_PRIO);
+}
+
+#endif // #if TEST_MBOX_BENCH
+
+#if TEST_RX_INPUT_BENCH
+
+//---------------------------------------------------------------------------------------
+
+#define RX_BENCH_PORT           9065            // ض˿
+#define RX_BENCH_RUN_MS         5000            // ÿʱ
+#define RX_BENCH_ROUNDS         3
+
+#if LWIP_TCPIP_CORE_LOCKING_INPUT
+extern void ethernetif_set_rx_mailbox(struct netif *netif, int enable);
+#endif
+
+/*
+ * յ UDP , ͳյİֽ.
+ *
+ * 򱾻 9065 ˿ڳ UDP ݲ, ͲȴԲ
+ * ʱ. "mailbox" ÿ֡Ͷݵ tcpip ߳, "core lock" ɽں
+ * .
+ */
+static void rx_input_bench_run(struct netconn *conn, int mailbox)
+{
+    unsigned long start_ticks, cycles_start, cycles_wait = 0, cycles_all;
+    unsigned int pkts = 0, bytes = 0, ms;
+
+#if LWIP_TCPIP_CORE_LOCKING_INPUT
+    ethernetif_set_rx_mailbox(netif_default, mailbox);
+#else
+    mailbox = 1;
+#endif
+
+    start_ticks  = get_clock_ticks();
+    cycles_start = get_stable_counter();
+
+    while ((ms = get_clock_ticks() - start_ticks) < RX_BENCH_RUN_MS)
+    {
+        struct netbuf *nb;
+        unsigned long t0;
+        err_t err;
+
+        t0 = get_stable_counter();
+        err = netconn_recv(conn, &nb);
+        cycles_wait += get_stable_counter() - t0;
+
+        if (err != ERR_OK)
+            continue;
+
+        pkts++;
+        bytes += netbuf_len(nb);
+
+        netconn_sendto(conn, nb, netbuf_fromaddr(nb), netbuf_fromport(nb));
+        netbuf_delete(nb);
+    }
+
+    cycles_all = get_stable_counter() - cycles_start;
+
+    printk("%s: %u pkts, %u pkts/s, %u bytes/s, idle %u%%\r\n",
+           mailbox ? "mailbox  " : "core lock",
+           pkts,
+           (unsigned int)((unsigned long)pkts * 1000 / (ms ? ms : 1)),
+           (unsigned int)((unsigned long)bytes * 1000 / (ms ? ms : 1)),
+           (unsigned int)(cycles_wait * 100 / (cycles_all ? cycles_all : 1)));
+}
+
+static void rx_input_bench_thread(void *arg)
+{
+    struct netconn *conn;
+    int i;
+
+    conn = netconn_new(NETCONN_UDP);
+    if (conn == NULL)
+    {
+        printk("failed to create netconn!\r\n");
+        return;
+    }
+
+    if (netconn_bind(conn, IP_ADDR_ANY, RX_BENCH_PORT) != ERR_OK)
+    {
+        printk("failed to bind port %i!\r\n", RX_BENCH_PORT);
+        netconn_delete(conn);
+        return;
+    }
+
+    netconn_set_recvtimeout(conn, 100);
+
+    printk("RX input bench, UDP echo on port %i\r\n", RX_BENCH_PORT);
+
+    for (i=0; i<RX_BENCH_ROUNDS; i++)
+    {
+        rx_input_bench_run(conn, 1);
+        rx_input_bench_run(conn, 0);
+    }
+
+#if LWIP_TCPIP_CORE_LOCKING_INPUT
+    ethernetif_set_rx_mailbox(netif_default, 0);
+#endif
+    netconn_delete(conn);
+
+    for (;;)
+    {
+        osal_task_sleep(1000);
+    }
+}
+
+void rx_input_bench_init(void)
+{
+	sys_thread_new("rx_input_bench",
+                    rx_input_bench_thread,
+                    NULL,
+                    DEFAULT_THREAD_STACKSIZE,
+            #ifdef OS_FREERTOS
+                    DEFAULT_THREAD_PRIO - 1
+            #else
+                    DEFAULT_THREAD_PRIO + 1
+            #endif
+                   );
+}
+
+#endif // #if TEST_RX_INPUT_BENCH
+
+#endif // #if BSP_USE_OS
+
+#endif // #if (TEST_UDP_TX_BENCH || TEST_MBOX_BENCH || TEST_RX_INPUT_BENCH)
+
@@ -96,6 +96,36 @@ extern int udpsvr_send_data(unsigned char *buf, int buflen);
 
 #endif
 
+/******************************************************************************
+ *  UDP : ƷͺͲƷ
+ */
+#define TEST_UDP_TX_BENCH       0
+#if TEST_UDP_TX_BENCH
+
+extern void udp_tx_bench_init(void);
+
+#endif
+
+/******************************************************************************
+ *  lwIP : 񡢿 tcpip_callback()
+ */
+#define TEST_MBOX_BENCH         0
+#if TEST_MBOX_BENCH
+
+extern void mbox_bench_init(void);
+
+#endif
+
+/******************************************************************************
+ * Խ: ֡Ͷݵ tcpip ̺߳ͽں
+ */
+#define TEST_RX_INPUT_BENCH     0
+#if TEST_RX_INPUT_BENCH
+
+extern void rx_input_bench_init(void);
+
+#endif
+
 /******************************************************************************
  * lwip_test.c
  */
@@ -0,0 +1,157 @@
+/*
+ * adc_stream_bench.c
+ *
+ * created: 2026-10-17
+ *  author:
+ */
+
+/*
+ * ADC ģʽɼ.
+ *
+ * GTIM_CC2  2 ͨ, DMA д ping-pong . ֱ԰ص
+ * ls2k_adc_stream_read() ֽʽ, ͳʵʲʡʧİԼ
+ * ÿĴʱ.
+ */
+
+#include "bsp.h"
+#include "misc_test.h"
+
+#if TEST_ADC_STREAM_BENCH && BSP_USE_ADC
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ls2k300.h"
+#include "ls2k_adc.h"
+#include "osal.h"
+
+#define BENCH_SECONDS       5
+#define BENCH_CHANNELS      2
+#define BENCH_BUF_SAMPLES   2048                    // ÿ 512 
+
+static unsigned int bench_buf[BENCH_BUF_SAMPLES] __attribute__((aligned(64)));
+
+static volatile unsigned int bench_samples;
+static volatile unsigned int bench_sum;
+
+/*
+ * һ: ۼ CH_4 Ĳֵ
+ */
+static void bench_consume(const unsigned int *samples, int count)
+{
+    unsigned int i, sum = 0;
+
+    for (i=0; i<count; i+=BENCH_CHANNELS)
+        sum += samples[i];
+
+    bench_sum += sum;
+    bench_samples += count;
+}
+
+static void bench_stream_cb(const unsigned int *samples, int count, void *arg)
+{
+    bench_consume(samples, count);
+}
+
+static void adc_stream_bench_run(unsigned int rate, int use_cb)
+{
+    ADC_Stream_t stream;
+    ADC_StreamStats_t stats;
+    unsigned long t0, busy = 0;
+    unsigned int start, ms, halves = 0;
+
+    bench_samples = 0;
+    bench_sum = 0;
+
+    stream.TrigSrc     = ADC_TRIG_GTIM_CC2;
+    stream.SampleRate  = rate;
+    stream.Buffer      = bench_buf;
+    stream.BufferSize  = BENCH_BUF_SAMPLES;
+    stream.Callback    = use_cb ? bench_stream_cb : NULL;
+    stream.CallbackArg = NULL;
+
+    if (ls2k_adc_ioctl(devADC, IOCTL_ADC_STREAM_START, &stream) != 0)
+    {
+        printk("adc stream start fail\r\n");
+        return;
+    }
+
+    start = get_clock_ticks();
+    while ((ms = get_clock_ticks() - start) < BENCH_SECONDS * 1000)
+    {
+        if (!use_cb)
+        {
+            const unsigned int *samples;
+            int count;
+
+            count = ls2k_adc_stream_read(&samples, 100);
+            if (count > 0)
+            {
+                t0 = get_stable_counter();
+                bench_consume(samples, count);
+                busy += get_stable_counter() - t0;
+                halves++;
+            }
+        }
+        else
+        {
+            osal_task_sleep(100);
+        }
+    }
+
+    ls2k_adc_ioctl(devADC, IOCTL_ADC_STREAM_STOP, NULL);
+    ls2k_adc_ioctl(devADC, IOCTL_ADC_STREAM_STATS, &stats);
+
+    printk("%s %6u Hz: %6u groups/s, halves %u, overruns %u, dma err %u",
+           use_cb ? "callback" : "queue   ", rate,
+           (unsigned int)((unsigned long)bench_samples / BENCH_CHANNELS * 1000 / ms),
+           stats.halves, stats.overruns, stats.dma_errors);
+
+    if (!use_cb && halves)
+        printk(", %lu counts/half", busy / halves);
+
+    printk("\r\n");
+}
+
+void adc_stream_bench(void)
+{
+    static const unsigned int rates[] = { 1000, 10000, 100000 };
+    ADC_Mode_t mode;
+    int i;
+
+    memset(&mode, 0, sizeof(ADC_Mode_t));
+    mode.OutPhaseSel = ADC_OPHASE_SAME;
+    mode.ClkDivider = 1;
+    mode.ScanMode = 1;
+    mode.ExternalTrigSrc = ADC_TRIG_SWATART;
+    mode.RegularChannelCount = BENCH_CHANNELS;
+    mode.RegularChannels[0] = ADC_CH_4;
+    mode.SampleClocks[0] = ADC_SAMP_8P;
+    mode.RegularChannels[1] = ADC_CH_5;
+    mode.SampleClocks[1] = ADC_SAMP_8P;
+
+    if (ls2k_adc_open(devADC, &mode) != 0)
+    {
+        printk("adc open fail\r\n");
+        return;
+    }
+
+    printk("ADC stream bench, %i channels, %i samples ping-pong, %i s each ...\r\n",
+           BENCH_CHANNELS, BENCH_BUF_SAMPLES, BENCH_SECONDS);
+
+    for (i=0; i<sizeof(rates)/sizeof(rates[0]); i++)
+    {
+        adc_stream_bench_run(rates[i], 1);
+        adc_stream_bench_run(rates[i], 0);
+    }
+
+    ls2k_adc_close(devADC, NULL);
+}
+
+#endif // #if TEST_ADC_STREAM_BENCH && BSP_USE_ADC
+
+//-----------------------------------------------------------------------------
+/*
+ * @@ END
+ */
+
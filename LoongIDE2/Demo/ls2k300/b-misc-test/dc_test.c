@@ -6,15 +6,108 @@
  */
 
 #include "bsp.h"
+#include "misc_test.h"
 
 #if BSP_USE_DC
 
 #include "ls2k_dc.h"
 
+#if TEST_FB_BENCH
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * framebuffer ͼٶȲ, 800x600 RGB565.
+ *
+ * fill:   ȫ fb_fillrect()
+ * copy:    fb_copyrect() Ұ; Լƽ 3 صص
+ * scroll: ̨һ, ÿι; ˢʱϲһΰ
+ * text:   ̨ 78 ַı, ͳÿַ
+ * flip:   ̨ȫ fb_flip()
+ */
+#define BENCH_LOOPS         100
+
+static void fb_bench_report(const char *name, unsigned long pixels, unsigned int ms)
+{
+    printk("%-14s %4u.%02u Mpixel/s\r\n", name,
+           (unsigned int)(pixels / 1000 / (ms ? ms : 1)),
+           (unsigned int)(pixels / 10 / (ms ? ms : 1) % 100));
+}
+
+static void fb_bench(void)
+{
+    int i, xres, yres;
+    unsigned int ticks;
+
+    strcpy(LCD_display_mode, "800x600-16@75");
+
+    if (fb_open() != 0)
+    {
+        printk("fb open fail\r\n");
+        return;
+    }
+
+    xres = fb_get_pixelsx();
+    yres = fb_get_pixelsy();
+
+    printk("framebuffer bench, %ix%i RGB565, %i loops\r\n", xres, yres, BENCH_LOOPS);
+
+    ticks = get_clock_ticks();
+    for (i=0; i<BENCH_LOOPS; i++)
+        fb_fillrect(0, 0, xres-1, yres-1, i & 0x0F);
+    fb_bench_report("fill", (unsigned long)BENCH_LOOPS * xres * yres, get_clock_ticks() - ticks);
+
+    ticks = get_clock_ticks();
+    for (i=0; i<BENCH_LOOPS; i++)
+        fb_copyrect(0, 0, xres/2-1, yres-1, xres/2, 0);
+    fb_bench_report("copy", (unsigned long)BENCH_LOOPS * xres/2 * yres, get_clock_ticks() - ticks);
+
+    ticks = get_clock_ticks();
+    for (i=0; i<BENCH_LOOPS; i++)
+        fb_copyrect(0, 0, xres-4, yres-1, 3, 0);
+    fb_bench_report("copy overlap", (unsigned long)BENCH_LOOPS * (xres-3) * yres, get_clock_ticks() - ticks);
+
+    fb_cons_clear();
+    for (i=0; i<yres/16; i++)               /* Ƶһ */
+        fb_cons_putc('\n');
+
+    ticks = get_clock_ticks();
+    for (i=0; i<BENCH_LOOPS; i++)
+        fb_cons_putc('\n');
+    fb_cons_flush();
+    fb_bench_report("scroll", (unsigned long)BENCH_LOOPS * xres * yres, get_clock_ticks() - ticks);
+
+    ticks = get_clock_ticks();
+    for (i=0; i<BENCH_LOOPS*10; i++)
+        fb_cons_puts("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-=+*/!\r\n");
+    fb_cons_flush();
+    ticks = get_clock_ticks() - ticks;
+    printk("%-14s %6u chars/s\r\n", "text", BENCH_LOOPS * 10 * 78 * 1000 / (ticks ? ticks : 1));
+
+    /*
+     * ں̨ȫػл, ÿ֡ VSync 
+     */
+    ticks = get_clock_ticks();
+    for (i=0; i<BENCH_LOOPS; i++)
+    {
+        fb_fillrect(0, 0, xres-1, yres-1, i & 0x0F);
+        fb_flip(0);
+    }
+    ticks = get_clock_ticks() - ticks;
+    printk("%-14s %4u frames/s\r\n", "redraw+flip", BENCH_LOOPS * 1000 / (ticks ? ticks : 1));
+}
+
+#endif // #if TEST_FB_BENCH
+
 void dc_test(void)
 {
     char buf[32];
 
+#if TEST_FB_BENCH
+    fb_bench();
+#endif
+
     fb_open();
     fb_cons_clear();
 
@@ -0,0 +1,143 @@
+/*
+ * heap_bench.c
+ *
+ * created: 2026-10-17
+ *  author:
+ */
+
+/*
+ * malloc/free ѹ.
+ *
+ * ģ lwIP/ͷ: 󲿷 pbuf СС, , ˳ͷ,
+ * ʱкдƬ. ͳÿ malloc/free ƽ.
+ *
+ * Ա memory_man.c 㷨: bsp.h  BSP_USE_FS=0, ֱ HEAP_USE_TLSF=1 
+ * HEAP_USE_TLSF=0 ; BSP_USE_FS=1 ʱԵ newlib  malloc.
+ *
+ * ϵͬԼ Template/ls2k300/tools/heap_bench.c.
+ */
+
+#include "bsp.h"
+#include "misc_test.h"
+
+#if TEST_HEAP_BENCH
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ls2k300.h"
+
+#define BENCH_SLOTS         1024            // ͬʱеĿ
+#define BENCH_ROUNDS        200000          // /ͷŴ
+#define BENCH_BIG_RATIO     16              // 1/16 Ǵ
+
+#if !BSP_USE_FS
+extern size_t get_heap_free_size(void);
+extern int heap_verify_faulty_blocks(void);
+#endif
+
+static void *bench_slots[BENCH_SLOTS];
+
+static unsigned int bench_seed = 1;
+
+static inline unsigned int bench_rand(void)
+{
+    bench_seed = bench_seed * 1103515245 + 12345;
+    return bench_seed >> 8;
+}
+
+/*
+ * 볤: ̫֡/pbuf Ϊ
+ */
+static size_t bench_size(void)
+{
+    unsigned int r = bench_rand();
+
+    if (r % BENCH_BIG_RATIO == 0)
+        return 4096 + r % 65536;
+
+    switch (r % 4)
+    {
+        case 0:  return 1536 + 16;
+        case 1:  return 64 + r % 192;
+        default: return 16 + r % 1500;
+    }
+}
+
+void heap_bench(void)
+{
+    unsigned long t0, cnt, malloc_sum = 0, malloc_max = 0, free_sum = 0, free_max = 0;
+    unsigned int malloc_cnt = 0, free_cnt = 0, failed = 0, i, k;
+
+#if !BSP_USE_FS
+    size_t free_before = get_heap_free_size();
+#if HEAP_USE_TLSF
+    printk("heap bench (bsp heap, TLSF), free %lu bytes\r\n", (unsigned long)free_before);
+#else
+    printk("heap bench (bsp heap, first-fit), free %lu bytes\r\n", (unsigned long)free_before);
+#endif
+#else
+    printk("heap bench (newlib malloc)\r\n");
+#endif
+
+    memset(bench_slots, 0, sizeof(bench_slots));
+
+    for (i=0; i<BENCH_ROUNDS; i++)
+    {
+        k = bench_rand() % BENCH_SLOTS;
+
+        if (bench_slots[k])
+        {
+            t0 = get_stable_counter();
+            free(bench_slots[k]);
+            cnt = get_stable_counter() - t0;
+
+            bench_slots[k] = NULL;
+            free_sum += cnt;
+            free_cnt++;
+            if (cnt > free_max)
+                free_max = cnt;
+        }
+        else
+        {
+            size_t size = bench_size();
+
+            t0 = get_stable_counter();
+            bench_slots[k] = malloc(size);
+            cnt = get_stable_counter() - t0;
+
+            if (bench_slots[k] == NULL)
+            {
+                failed++;
+                continue;
+            }
+
+            *(unsigned char *)bench_slots[k] = (unsigned char)k;
+            malloc_sum += cnt;
+            malloc_cnt++;
+            if (cnt > malloc_max)
+                malloc_max = cnt;
+        }
+    }
+
+    for (k=0; k<BENCH_SLOTS; k++)
+    {
+        free(bench_slots[k]);
+        bench_slots[k] = NULL;
+    }
+
+    printk("malloc: %u times, avg %lu, max %lu counts, %u failed\r\n",
+           malloc_cnt, malloc_cnt ? malloc_sum / malloc_cnt : 0, malloc_max, failed);
+    printk("free:   %u times, avg %lu, max %lu counts\r\n",
+           free_cnt, free_cnt ? free_sum / free_cnt : 0, free_max);
+
+#if !BSP_USE_FS
+    printk("heap free %lu bytes, %s\r\n", (unsigned long)get_heap_free_size(),
+           get_heap_free_size() == free_before ? "no leak" : "LEAK");
+    heap_verify_faulty_blocks();
+#endif
+}
+
+#endif // #if TEST_HEAP_BENCH
+
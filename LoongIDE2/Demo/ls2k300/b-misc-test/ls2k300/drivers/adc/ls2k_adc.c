@@ -0,0 +1,1103 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_adc.c
+ *
+ * created: 2024-07-28
+ *  author: Bian
+ */
+
+/*
+ * TODO 1. DMA ͨŵʹдϵ
+ *      2. עͨ
+ */
+
+#include "bsp.h"
+
+#if BSP_USE_ADC
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "termios.h"
+#include "cpu.h"
+
+#include "ls2k300.h"
+#include "ls2k300_irq.h"
+#include "ls2k_drv_io.h"
+#include "ls2k_dma.h"
+
+#include "ls2k_adc_hw.h"
+#include "ls2k_adc.h"
+
+#include "osal.h"
+
+//-----------------------------------------------------------------------------
+// Mutex
+//-----------------------------------------------------------------------------
+
+#define ADC_USE_MUTEX   1
+
+#if ADC_USE_MUTEX
+#define LOCK()      osal_mutex_obtain(m_adc_priv.p_mutex, OSAL_WAIT_FOREVER)
+#define UNLOCK()    osal_mutex_release(m_adc_priv.p_mutex)
+#else
+#define LOCK()
+#define UNLOCK()
+#endif
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+typedef struct ADC
+{
+    HW_ADC_t    *hwADC;
+    int          irqVector;             /* Irq vector number */
+
+    ADC_Mode_t   mode;
+    ADC_Inject_t inject;
+
+    struct dma_chnl_cfg dma_cfg;        /* DMA  */
+    volatile int dma_cb_result;         /* DMA жϻص */
+
+    /*
+     * ģʽ
+     */
+    ADC_Stream_t      stream;
+    ADC_StreamStats_t stream_stats;
+    osal_mq_t         stream_mq;        /* ûлصʱ, дİ */
+    HW_TIM_t         *hwTIM;            /* ʱ */
+    int               tim_ch;           /* ʱȽͨ */
+    int               streaming;
+
+#if ADC_USE_MUTEX
+    osal_mutex_t p_mutex;
+#endif
+
+    int          initialized;
+    int          opened;
+    char         dev_name[16];
+} ADC_t;
+
+/**
+ * ADC private struct
+ */
+static ADC_t m_adc_priv =
+{
+    .hwADC       = (HW_ADC_t *)PHYS_TO_UNCACHED(ADC_BASE),
+#if USE_EXTINT
+    .irqVector   = EXTI1_ADC_IRQ,
+#else
+    .irqVector   = INTC0_ADC_IRQ,
+#endif
+    .initialized = 0,
+    .opened      = 0,
+    .dev_name    = "adc",
+};
+
+const void *devADC = (void *)&m_adc_priv;
+
+/**
+ * ADC DMA buffer
+ */
+static unsigned int m_dma_buf[16]; 
+
+extern unsigned int apb_frequency;
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+static int channel_virt_to_real(int vChannel)
+{
+    switch (vChannel)
+    {
+        case ADC_CH_1:  return ADC_Channel_0;
+        case ADC_CH_2:  return ADC_Channel_1;
+        case ADC_CH_3:  return ADC_Channel_2;
+        case ADC_CH_4:  return ADC_Channel_3;
+        case ADC_CH_5:  return ADC_Channel_4;
+        case ADC_CH_6:  return ADC_Channel_5;
+        case ADC_CH_7:  return ADC_Channel_6;
+        case ADC_CH_8:  return ADC_Channel_7;
+    }
+
+    return ADC_Channel_0;
+}
+
+//-----------------------------------------------------------------------------
+
+static void ls2k_adc_dma_callback(struct dma_chnl_cfg *cfg, int bytes, unsigned int status)
+{
+    if (status & DMA_SR_DONE)   // 
+    {
+        m_adc_priv.dma_cb_result = 0;
+    }
+    else if (status)            // DMA_SR_ERROR
+    {
+        m_adc_priv.dma_cb_result = -EIO;
+    }
+
+    return;
+}
+
+/*
+ * ʹ DMA 
+ */
+static int ls2k_adc_set_dma_transfer(ADC_t *pADC, int channelcount)
+{
+    int rx_chnl;
+    struct dma_chnl_cfg *cfg = &pADC->dma_cfg;
+
+    if (dma_get_idle_channel(DMA_ADC, &rx_chnl, NULL) == 0)
+    {
+        memset((void *)cfg, 0, sizeof(struct dma_chnl_cfg));
+
+        cfg->chNum   = rx_chnl;
+        cfg->devNum  = DMA_ADC;
+        cfg->device  = (void *)devADC;
+        cfg->memAddr = (unsigned long)&m_dma_buf[0];
+
+        cfg->transbytes = channelcount * sizeof(int);
+        cfg->cb = ls2k_adc_dma_callback;
+
+    //  cfg->ccr.en    = 0;              // disable the channel first.
+        cfg->ccr.tcie  = 1;              // trans done int-disable
+    //  cfg->ccr.htie  = 0;              // trans half int-disable
+        cfg->ccr.teie  = 1;              // trans error int-disable
+    //  cfg->ccr.dir   = 0;              // 0: peripheral to mem; 1: mem to peripheral.
+        cfg->ccr.circ  = 1;              // not circle mode
+    //  cfg->ccr.mem2mem = 0;            // memory to memory mode
+
+    //  cfg->ccr.pinc  = 0;              // 1=auto inc peripheral address
+        cfg->ccr.minc  = 1;              // 1=auto inc mem address
+        cfg->ccr.psize = 2;              // peripheral data width: 0=8bits, 2=32bits
+        cfg->ccr.msize = 2;              // memory data width:     0=8bits, 2=32bits
+        cfg->ccr.priority = 2;           // channel priority: high
+
+        return 0;
+    }
+
+    cfg->chNum = -1;
+
+    return -1;
+}
+        
+//-----------------------------------------------------------------------------
+     
+/*
+ *  ADC Ĭ
+ */
+static int ls2k_adc_set_mode(ADC_t *pADC, ADC_Mode_t *mode)
+{
+    int i;
+    unsigned int cr1, cr2;
+
+    if (mode == NULL)
+        return -1;
+
+    cr1 = pADC->hwADC->cr1;
+    cr2 = pADC->hwADC->cr2;
+    
+    // LOCK();
+
+    /*
+     *  CR1, CR2, Clear
+     */
+    cr1 &= CR1_CLEAR_MASK_R;
+    cr2 &= CR2_CLEAR_MASK_R;
+
+    /* źλ */
+    if (ADC_OPHASE_BEFORE_1 == mode->OutPhaseSel)
+        cr1 |= ADC_CR1_OPS_CLKBEFORE1;
+    else if (ADC_OPHASE_AFTER_1 == mode->OutPhaseSel)
+        cr1 |= ADC_CR1_OPS_CLKAFTER1;
+
+    /* Ƶϵ */
+    cr1 |= (mode->ClkDivider << ADC_CR1_CLK_SHIFT) & ADC_CR1_CLK_MASK;
+    cr2 |= (mode->ClkDivider << (ADC_CR2_CLK_SHIFT-6)) & ADC_CR2_CLK_MASK;
+
+    if (mode->DiffMode)                 /*  */
+        cr1 |= ADC_CR1_DIFFMOD;
+
+    if (mode->ScanMode)                 /* ɨģʽ */
+        cr1 |= ADC_CR1_SCAN;
+
+#if 0
+    if (mode->ContinuousMode)           /* ת */
+        cr2 |= ADC_CR2_CONT;
+#endif
+
+    if (mode->TrigEdgeDown)             /* ʱӴ: 1=½ */
+        cr2 |= ADC_CR2_EDGE_DOWN;
+
+    /* ͨⲿԴ */
+    switch (mode->ExternalTrigSrc)
+    {
+        case ADC_TRIG_ATIM_CC1: cr2 |= ADC_CR2_EXTSEL_ATIM_CC1; break;
+        case ADC_TRIG_ATIM_CC2: cr2 |= ADC_CR2_EXTSEL_ATIM_CC2; break;
+        case ADC_TRIG_ATIM_CC3: cr2 |= ADC_CR2_EXTSEL_ATIM_CC3; break;
+        case ADC_TRIG_GTIM_CC2: cr2 |= ADC_CR2_EXTSEL_GTIM_CC2; break;
+        case ADC_TRIG_EXTI_11:  cr2 |= ADC_CR2_EXTSEL_EXTI_11;  break;
+        case ADC_TRIG_SWATART:
+        default:                cr2 |= ADC_CR2_EXTSEL_SWATART;  break;
+    }
+
+    if (mode->DataAlignLeft)            /* ת */
+        cr2 |= ADC_CR2_ALIGN_LEFT;
+
+    /*
+     * Set CR1 & CR2
+     */
+    pADC->hwADC->cr1 = cr1;
+    pADC->hwADC->cr2 = cr2;
+    
+    /*
+     * ͨ
+     */
+    adc_set_sq_len(pADC->hwADC, mode->RegularChannelCount);    
+
+    for (i=0; i<mode->RegularChannelCount; i++)
+    {
+        /* ͨ */
+        adc_set_sq(pADC->hwADC, i+1, channel_virt_to_real(mode->RegularChannels[i]));
+
+        /*  */
+        adc_set_samp_time(pADC->hwADC, i+1, mode->SampleClocks[i]);
+    }
+
+    //-----------------------------------------------------
+    //  DMA
+    //-----------------------------------------------------
+    
+    if (mode->RegularChannelCount > 1)
+    {
+        if (ls2k_adc_set_dma_transfer(pADC, mode->RegularChannelCount) == 0)
+        {
+            /*
+             * Use DMA now
+             */
+            pADC->hwADC->cr2 |= ADC_CR2_DMA;
+            
+            adc_set_discnum(pADC->hwADC, mode->RegularChannelCount, 0);
+        }
+        else
+        {
+        	// UNLOCK();
+            return -1;
+        }
+    }
+    else if (pADC->dma_cfg.chNum >= 0)
+    {
+        ls2k_dma_close(NULL, (void *)(long)pADC->dma_cfg.chNum);
+        pADC->dma_cfg.chNum = -1;
+    }
+
+    pADC->mode = *mode;
+    
+    // UNLOCK();
+    return 0;
+}
+
+/*
+ * У
+ */
+static int ls2k_adc_do_calibrate(HW_ADC_t *hwADC)
+{
+    int tmo = 1000;
+    unsigned int cr2;
+
+    hwADC->cr2 |= ADC_CR2_ADON;
+    cr2 = hwADC->cr2;
+
+    cr2 &= ~(ADC_CR2_RSTCAL | ADC_CR2_CAL);
+    cr2 |= ADC_CR2_RSTCAL | ADC_CR2_CAL;
+
+    hwADC->cr2 = cr2;
+
+    while (hwADC->cr2 & (ADC_CR2_RSTCAL | ADC_CR2_CAL))
+    {
+        if (tmo-- <= 0)
+        {
+            printk("adc calibrate timeout = %i\r\n", tmo);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * һͨ
+ */
+static int ls2k_adc_set_1_regular_channel(ADC_t *pADC, int vchnl, int rank, int samptime)
+{
+    int channel = channel_virt_to_real(vchnl);
+
+    if ((samptime < ADC_SAMP_1P) || (samptime > ADC_SAMP_128P))
+        samptime = ADC_SAMP_64P;
+
+    adc_set_samp_time(pADC->hwADC, rank, samptime);
+
+    if (adc_get_sq(pADC->hwADC, rank) != channel)
+    {
+        adc_set_sq(pADC->hwADC, rank, channel);
+    }
+    
+    return 0;
+}
+
+/*
+ * ת
+ */
+static int ls2k_adc_start_trigger_convert(ADC_t *pADC, int Jmode)
+{
+    unsigned int sr = pADC->hwADC->sr;
+    unsigned int cr2 = pADC->hwADC->cr2;
+
+    cr2 |= Jmode ? ADC_CR2_JEXTTRIG : ADC_CR2_EXTTRIG;
+    pADC->hwADC->cr2 = cr2;
+
+    /*
+     * clear EOC
+     */
+    sr &= ~(Jmode ? ADC_SR_JEOC : ADC_SR_EOC);
+    pADC->hwADC->sr = sr;
+
+    /*
+     * start AD convert
+     */
+    pADC->hwADC->cr2 |= Jmode ? ADC_CR2_JSWSTART : ADC_CR2_SWSTART;
+
+    return 0;
+}
+
+/*
+ * ѯ״̬Ĵ, ȴת
+ */
+static int ls2k_adc_wait_convert_done(ADC_t *pADC, unsigned int wait_sr)
+{
+    int tmo = 1000;
+
+    while (!(pADC->hwADC->sr & wait_sr))
+    {
+        if (tmo-- <= 0)
+        {
+            printk("poll adc convert done timeout!\r\n");
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+/*
+ * עͨ
+ */
+static int ls2k_adc_set_inject(ADC_t *pADC, ADC_Inject_t *inject)
+{
+    int i;
+    unsigned int cr1 = pADC->hwADC->cr1;
+    unsigned int cr2 = pADC->hwADC->cr2;
+
+    if (inject == NULL)
+        return -1;
+
+    LOCK();
+    
+    /*
+     *  CR1, CR2, Clear
+     */
+    cr1 &= CR1_CLEAR_MASK_J;
+    cr2 &= CR2_CLEAR_MASK_J;
+
+    /* Զעͨת */
+    if (inject->JTrigAuto)
+        cr1 |= ADC_CR1_JAUTO;
+        
+    /* ע봥ģʽ */
+    if (ADC_JTRIG_END == inject->JTrigMode)
+        cr1 |= 2 << ADC_CR2_JTRIGMOD_SHIFT;
+    else if (ADC_JTRIG_END_RESET == inject->JTrigMode)
+        cr1 |= 1 << ADC_CR2_JTRIGMOD_SHIFT;
+        
+    /* עͨⲿԴ */
+    switch (inject->ExternalJTrigSrc)
+    {
+        case ADC_JTRIG_ATIM_TRGO: cr2 |= ADC_CR2_JEXTSEL_ATIM_TRGO; break;
+        case ADC_JTRIG_ATIM_CC4:  cr2 |= ADC_CR2_JEXTSEL_ATIM_CC4;  break;
+        case ADC_JTRIG_GTIM_TRGO: cr2 |= ADC_CR2_JEXTSEL_GTIM_TRGO; break;
+        case ADC_JTRIG_GTIM_CC1:  cr2 |= ADC_CR2_JEXTSEL_GTIM_CC1;  break;
+        case ADC_JTRIG_EXTI_15:   cr2 |= ADC_CR2_JEXTSEL_EXTI_15;   break;
+        case ADC_JTRIG_JSWSTART:
+        default:                  cr2 |= ADC_CR2_JEXTSEL_JSWSTART;  break;
+    }
+
+    /*
+     * Set CR1 & CR2
+     */
+    pADC->hwADC->cr1 = cr1;
+    pADC->hwADC->cr2 = cr2;
+    
+    /*
+     * עͨ
+     */
+    adc_set_jsq_len(pADC->hwADC, inject->InjectChannelCount);   
+    
+    for (i=0; i<inject->InjectChannelCount; i++)
+    {
+        /* ͨ */
+        adc_set_jsq(pADC->hwADC, i+1, channel_virt_to_real(inject->InjectChannels[i]));
+
+        /* עͨƫ */
+        adc_set_joff(pADC->hwADC, i+1, inject->InjectOffsets[i]);
+        
+        /*  */
+        adc_set_samp_time(pADC->hwADC, i+1, inject->SampleClocks[i]);
+    }
+
+    UNLOCK();
+    return 0;
+}
+
+/*
+ * ȡעһͨת
+ *
+ * : *param     עͨ˳, ת
+ *
+ */
+static int ls2k_adc_get_inject_result(ADC_t *pADC, int *param)
+{
+    if (param)
+    {
+        int rank = *param;
+        *param = adc_get_jsq_result(pADC->hwADC, rank);
+        return 0;
+    }
+    
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+// ģʽ
+//-----------------------------------------------------------------------------
+
+/*
+ * DMA ѭģʽ: жϽǰ, жϽ
+ */
+static void ls2k_adc_stream_deliver(ADC_t *pADC, unsigned int *half)
+{
+    int count = pADC->stream.BufferSize / 2;
+
+    clean_dcache_nowrite((unsigned long)half, count * sizeof(int));
+
+    pADC->stream_stats.halves++;
+
+    if (pADC->stream.Callback)
+    {
+        pADC->stream.Callback(half, count, pADC->stream.CallbackArg);
+    }
+    else
+    {
+        unsigned long msg = (unsigned long)half;
+
+        if (osal_mq_send(pADC->stream_mq, &msg, sizeof(msg)) != 0)
+            pADC->stream_stats.overruns++;
+    }
+}
+
+static void ls2k_adc_stream_dma_callback(struct dma_chnl_cfg *cfg, int bytes, unsigned int status)
+{
+    ADC_t *pADC = &m_adc_priv;
+
+    if (status & DMA_SR_ERROR)
+    {
+        pADC->stream_stats.dma_errors++;
+        return;
+    }
+
+    if (status & DMA_SR_HALF)
+        ls2k_adc_stream_deliver(pADC, pADC->stream.Buffer);
+
+    if (status & DMA_SR_DONE)
+        ls2k_adc_stream_deliver(pADC, pADC->stream.Buffer + pADC->stream.BufferSize / 2);
+}
+
+/*
+ * ôʱ: ͨ ch  PWM ģʽ, ÿڲһ CCx ¼
+ */
+static int ls2k_adc_stream_set_timer(ADC_t *pADC, int trig, unsigned int rate)
+{
+    HW_TIM_t *hwTIM;
+    unsigned int cycles, psc, arr;
+    int ch;
+
+    switch (trig)
+    {
+        case ADC_TRIG_ATIM_CC1: ch = 1; break;
+        case ADC_TRIG_ATIM_CC2: ch = 2; break;
+        case ADC_TRIG_ATIM_CC3: ch = 3; break;
+        case ADC_TRIG_GTIM_CC2: ch = 2; break;
+        default:                return -1;
+    }
+
+    if ((rate == 0) || ((cycles = apb_frequency / rate) < 2))
+        return -1;
+
+    if (trig == ADC_TRIG_GTIM_CC2)
+    {
+        hwTIM = (HW_TIM_t *)PHYS_TO_UNCACHED(GTIM_BASE);
+        OR_REG32(CHIP_CTRL6_BASE, CTRL6_GTIMER_CLK_CTRL);
+    }
+    else
+    {
+        hwTIM = (HW_TIM_t *)PHYS_TO_UNCACHED(ATIM_BASE);
+        OR_REG32(CHIP_CTRL5_BASE, CTRL5_ATIMER_CLK_CTRL);
+    }
+
+    /*
+     * ARR  16 λ, ʱԤƵ
+     */
+    psc = (cycles - 1) >> 16;
+    arr = cycles / (psc + 1) - 1;
+
+    hwTIM->cr1 = 0;
+    hwTIM->psc = psc;
+    hwTIM->arr = arr;
+
+    tim_set_pwm_channel(hwTIM, ch, (arr + 1) / 2);
+
+    if (trig != ADC_TRIG_GTIM_CC2)
+        hwTIM->bdtr |= TIM_BDTR_MOE;    /* ATIM ıȽҪ MOE */
+
+    hwTIM->egr = TIM_EGR_UG;
+
+    pADC->hwTIM  = hwTIM;
+    pADC->tim_ch = ch;
+
+    return 0;
+}
+
+static void ls2k_adc_stream_stop_timer(ADC_t *pADC)
+{
+    if (pADC->hwTIM)
+    {
+        pADC->hwTIM->cr1 &= ~TIM_CR1_CEN;
+        pADC->hwTIM->ccer &= ~TIM_CCER_CCE(pADC->tim_ch);
+        pADC->hwTIM = NULL;
+    }
+}
+
+/*
+ * ʼģʽ. ʱͨת, ÿδתȫͨ
+ */
+static int ls2k_adc_stream_start(ADC_t *pADC, ADC_Stream_t *stream)
+{
+    struct dma_chnl_cfg *cfg = &pADC->dma_cfg;
+    int channelcount = pADC->mode.RegularChannelCount;
+    unsigned int cr2, extsel;
+
+    if (!pADC->opened || pADC->streaming || !stream)
+        return -1;
+
+    /*
+     * clean_dcache_nowrite()  cache , ÿռ cache 
+     */
+    if (!stream->Buffer || ((long)stream->Buffer & (ADC_STREAM_ALIGN - 1)) ||
+        (stream->BufferSize <= 0) || (stream->BufferSize % (channelcount * 2) != 0) ||
+        ((stream->BufferSize / 2 * sizeof(int)) % ADC_STREAM_ALIGN != 0))
+        return -1;
+
+    switch (stream->TrigSrc)
+    {
+        case ADC_TRIG_ATIM_CC1: extsel = ADC_CR2_EXTSEL_ATIM_CC1; break;
+        case ADC_TRIG_ATIM_CC2: extsel = ADC_CR2_EXTSEL_ATIM_CC2; break;
+        case ADC_TRIG_ATIM_CC3: extsel = ADC_CR2_EXTSEL_ATIM_CC3; break;
+        case ADC_TRIG_GTIM_CC2: extsel = ADC_CR2_EXTSEL_GTIM_CC2; break;
+        default:                return -1;
+    }
+
+    if (!stream->Callback)
+    {
+        if (!pADC->stream_mq)
+        {
+            pADC->stream_mq = osal_mq_create("adcstream", OSAL_OPT_FIFO, sizeof(unsigned long), 2);
+            if (!pADC->stream_mq)
+                return -1;
+        }
+
+        osal_mq_flush(pADC->stream_mq);
+    }
+
+    if (ls2k_adc_stream_set_timer(pADC, stream->TrigSrc, stream->SampleRate) != 0)
+        return -1;
+
+    pADC->stream = *stream;
+    memset(&pADC->stream_stats, 0, sizeof(ADC_StreamStats_t));
+
+    /*
+     * ͷŵתõ DMA ͨ, Ϊ ping-pong 
+     */
+    if (cfg->chNum >= 0)
+    {
+        ls2k_dma_close(NULL, (void *)(long)cfg->chNum);
+        cfg->chNum = -1;
+    }
+
+    if (ls2k_adc_set_dma_transfer(pADC, channelcount) != 0)
+    {
+        ls2k_adc_stream_stop_timer(pADC);
+        return -1;
+    }
+
+    cfg->memAddr    = (unsigned long)stream->Buffer;
+    cfg->transbytes = stream->BufferSize * sizeof(int);
+    cfg->cb         = ls2k_adc_stream_dma_callback;
+    cfg->ccr.htie   = 1;
+
+    clean_dcache_nowrite((unsigned long)stream->Buffer, cfg->transbytes);
+
+    /*
+     * ⲿ, ÿδת channelcount ͨ
+     */
+    cr2  = pADC->hwADC->cr2;
+    cr2 &= ~(ADC_CR2_EXTSEL_MASK | ADC_CR2_CONT);
+    cr2 |= extsel | ADC_CR2_EXTTRIG | ADC_CR2_DMA | ADC_CR2_ADON;
+    pADC->hwADC->cr2 = cr2;
+
+    adc_set_discnum(pADC->hwADC, channelcount, 0);
+
+    if (dma_start(cfg, 0) != 0)
+    {
+        ls2k_adc_stream_stop_timer(pADC);
+        return -1;
+    }
+
+    pADC->streaming = 1;
+
+    pADC->hwTIM->cr1 = TIM_CR1_ARPE | TIM_CR1_CEN;
+
+    return 0;
+}
+
+/*
+ * ֹͣģʽ, ָ IOCTL_ADC_SET_MODE 
+ */
+static int ls2k_adc_stream_stop(ADC_t *pADC)
+{
+    ADC_Mode_t mode;
+
+    if (!pADC->streaming)
+        return 0;
+
+    ls2k_adc_stream_stop_timer(pADC);
+
+    pADC->hwADC->cr2 &= ~(ADC_CR2_EXTTRIG | ADC_CR2_DMA);
+
+    ls2k_dma_close(NULL, (void *)(long)pADC->dma_cfg.chNum);
+    pADC->dma_cfg.chNum = -1;
+
+    pADC->streaming = 0;
+
+    mode = pADC->mode;
+    if (ls2k_adc_set_mode(pADC, &mode) != 0)
+        return -1;
+
+    if (pADC->opened)
+    {
+        if ((pADC->mode.RegularChannelCount > 1) && (dma_start(&pADC->dma_cfg, 0) != 0))
+            return -1;
+
+        pADC->hwADC->cr2 |= ADC_CR2_ADON;
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * initialize the device
+ */
+STATIC_DRV int ADC_initialize(const void *dev, void *arg)
+{
+	ADC_t *pADC = &m_adc_priv;
+    ADC_Mode_t *mode = (ADC_Mode_t *)arg;
+    
+    if (pADC->initialized)
+        return 0;
+
+#if ADC_USE_MUTEX
+    pADC->p_mutex = osal_mutex_create(pADC->dev_name, OSAL_OPT_FIFO);
+    if (pADC->p_mutex == NULL)
+    {
+    	return -1;
+    }
+#endif
+
+    if (!mode)
+    {
+        ADC_Mode_t mode1;
+        
+	    mode1.OutPhaseSel = ADC_OPHASE_SAME;
+	    mode1.ClkDivider = 1;
+	    mode1.DiffMode = 0;
+	    mode1.ScanMode = 1;
+	    mode1.ContinuousMode = 0;
+	    mode1.TrigEdgeDown = 0;
+	    mode1.ExternalTrigSrc = ADC_TRIG_SWATART;
+	    mode1.DataAlignLeft = 0;
+
+	    /*
+         * һ. Ƶϵؾ
+         */
+	    mode1.RegularChannelCount = 1;
+	    mode1.RegularChannels[0] = ADC_CH_5;
+	    mode1.SampleClocks[0] = ADC_SAMP_64P;
+        
+        mode = &mode1;
+    }
+
+    pADC->dma_cfg.chNum = -1;
+    
+    if (ls2k_adc_set_mode(pADC, mode) != 0)
+        return -1;
+
+    //-------------------------------------------------------------------------
+    // ж
+    //-------------------------------------------------------------------------
+
+    // TODO
+    
+    pADC->initialized = 1;
+
+    return 0;
+}
+
+/******************************************************************************
+ * open the device
+ */
+STATIC_DRV int ADC_open(const void *dev, void *arg)
+{
+	ADC_t *pADC = &m_adc_priv;
+	ADC_Mode_t *mode = (ADC_Mode_t *)arg;
+
+    if (pADC->opened)
+        return 0;
+        
+    if (!pADC->initialized && !mode)
+        return -1;
+
+    if ((mode) && (ls2k_adc_set_mode(pADC, mode) != 0))
+        return -1;
+
+    LOCK();
+
+    /*
+     * ʹDMAݴ
+     */
+    if (pADC->mode.RegularChannelCount > 1)
+    {
+        if (dma_start(&pADC->dma_cfg, 0) != 0)
+        {
+            UNLOCK();
+            return -1;
+        }
+    }
+
+    /*
+     * У
+     */
+    pADC->hwADC->cr2 |= ADC_CR2_ADON;
+
+    if (ls2k_adc_do_calibrate(pADC->hwADC) != 0)
+    {
+        UNLOCK();
+        return -1;
+    }
+
+    /*
+     * ж
+     */
+    // TODO
+
+    pADC->opened = 1;
+
+    UNLOCK();
+    return 0;
+}
+
+/******************************************************************************
+ * close the device
+ */
+STATIC_DRV int ADC_close(const void *dev, void *arg)
+{
+	ADC_t *pADC = &m_adc_priv;
+    
+    LOCK();
+    ls2k_adc_stream_stop(pADC);
+    pADC->hwADC->cr2 &= ~ADC_CR2_ADON;
+    
+    /*
+     * ж
+     */
+    // TODO
+
+    /*
+     * ֹͣ DMA
+     */
+    if (pADC->mode.RegularChannelCount > 1)
+    {
+        ls2k_dma_close(NULL, (void *)(long)pADC->dma_cfg.chNum);
+        pADC->dma_cfg.chNum = -1;
+    }
+    
+    pADC->opened = 0;
+    UNLOCK();
+    
+    return 0;
+}
+
+/******************************************************************************
+ * read from the device
+ */
+STATIC_DRV int ADC_read(const void *dev, void *buf, int size, void *arg)
+{
+    int ret = 0;
+	ADC_t *pADC = &m_adc_priv;
+    int vchnl = (long)arg;
+    int channelcount;
+
+    if (!pADC->opened || pADC->streaming)
+        return -1;
+
+    if (!buf || ((long)buf & 0x3))
+        return -1;
+
+    LOCK();
+
+    channelcount = pADC->mode.RegularChannelCount;
+
+    /**
+     * һͨ
+     */
+    if ((channelcount == 1) && (vchnl >= ADC_CH_1) && (vchnl <= ADC_CH_8))
+    {
+        unsigned int result;
+
+        ls2k_adc_set_1_regular_channel(pADC, vchnl, 1, ADC_SAMP_64P);
+
+        ls2k_adc_start_trigger_convert(pADC, 0);
+
+        ls2k_adc_wait_convert_done(pADC, ADC_SR_EOC);
+
+        result = pADC->hwADC->dr;
+            
+        *(unsigned int *)buf = result;
+        ret = 4;
+    }
+
+    /**
+     * ͨ, תͨ DMAŵ
+     */
+    else if (channelcount > 1)
+    {
+        int dma_rt = 1;
+        
+        pADC->dma_cb_result = 1;
+
+        ls2k_adc_start_trigger_convert(pADC, 0);
+
+        if (pADC->dma_cfg.ccr.tcie || pADC->dma_cfg.ccr.teie)   /* DMA ж */
+        {
+            /*
+             * ȴ DMA жϻص, timeout?
+             */
+            while (pADC->dma_cb_result == 1)
+                ;
+
+            dma_rt = pADC->dma_cb_result;
+        }
+        else                                                  
+        {
+            dma_rt = dma_wait_done(pADC->dma_cfg.chNum, 1000);  /* ѯ */
+        }
+
+        if (dma_rt == 0)
+        {
+            /*
+             * ָͨת
+             */
+            if ((vchnl >= ADC_CH_1) && (vchnl <= ADC_CH_8))
+            {
+                *(unsigned int *)buf = m_dma_buf[vchnl - 1];
+                ret = 4;
+            }
+            else
+            {
+                unsigned int *p = (unsigned int *)buf;
+                int i, count;
+
+                count = size / sizeof(int);
+                count = (channelcount < count) ? channelcount : count;
+
+                for (i=0; i<count; i++)
+                {
+                    *p++ = m_dma_buf[i];
+                }
+            
+                ret = count * sizeof(int);
+            }
+        }
+        else
+        {
+            // DMA Result ERROR
+        }
+    }
+
+    UNLOCK();
+    return ret;
+}
+
+/******************************************************************************
+ * Driver ioctl handler
+ */
+STATIC_DRV int ADC_ioctl(const void *dev, int cmd, void *arg)
+{
+    int ret = 0;
+	ADC_t *pADC = &m_adc_priv;
+
+    switch (cmd)
+    {
+        case IOCTL_ADC_SET_MODE:
+        {
+            int reopenIt = pADC->opened;
+            if (reopenIt)
+            {
+                ADC_close(NULL, NULL);
+            }
+
+            ret = ls2k_adc_set_mode(pADC, (ADC_Mode_t *)arg);
+
+            if (reopenIt)
+            {
+                ADC_open(NULL, NULL);
+            }
+
+            break;
+        }
+
+        case IOCTL_ADC_CALIBRATE:
+        	LOCK();
+            ls2k_adc_do_calibrate(pADC->hwADC);
+            UNLOCK();
+            break;
+
+        case IOCTL_ADC_SET_INJECT:
+        	LOCK();
+            ret = ls2k_adc_set_inject(pADC, (ADC_Inject_t *)arg);
+            UNLOCK();
+            break;
+
+        case IOCTL_ADC_GET_JRESULT:
+            ret = ls2k_adc_get_inject_result(pADC, (int *)arg);
+            break;
+
+        case IOCTL_ADC_STREAM_START:
+            LOCK();
+            ret = ls2k_adc_stream_start(pADC, (ADC_Stream_t *)arg);
+            UNLOCK();
+            break;
+
+        case IOCTL_ADC_STREAM_STOP:
+            LOCK();
+            ret = ls2k_adc_stream_stop(pADC);
+            UNLOCK();
+            break;
+
+        case IOCTL_ADC_STREAM_STATS:
+            if (arg)
+                *(ADC_StreamStats_t *)arg = pADC->stream_stats;
+            else
+                ret = -1;
+            break;
+            
+        default:
+            ret = -1;
+            break;
+    }
+
+    return ret;
+}
+
+//---------------------------------------------------------------------------------------
+
+#if (PACK_DRV_OPS)
+/******************************************************************************
+ * ADC driver operators
+ */
+static const driver_ops_t ls2k_adc_drv_ops =
+{
+    .init_entry  = ADC_initialize,
+    .open_entry  = ADC_open,
+    .close_entry = ADC_close,
+    .read_entry  = ADC_read,
+    .write_entry = NULL,
+    .ioctl_entry = ADC_ioctl,
+};
+
+const driver_ops_t *adc_drv_ops = &ls2k_adc_drv_ops;
+#endif
+
+/******************************************************************************
+ * Device name
+ */
+const char *ls2k_adc_get_device_name(void)
+{
+    return m_adc_priv.dev_name;
+}
+
+//-----------------------------------------------------------------------------
+// User API
+//-----------------------------------------------------------------------------
+
+int adc_read_1(int channel)
+{
+    unsigned int adc_val;
+
+    if (ADC_read(NULL, &adc_val, 4, (void *)(long)channel) == 4)
+        return (int)adc_val;
+
+    return -1;
+}
+
+/*
+ * ģʽ, ȴһдİ
+ */
+int ls2k_adc_stream_read(const unsigned int **samples, unsigned int timeout_ms)
+{
+    ADC_t *pADC = &m_adc_priv;
+    unsigned long msg;
+
+    if (!samples || !pADC->streaming || pADC->stream.Callback)
+        return -1;
+
+    if (osal_mq_receive(pADC->stream_mq, &msg, sizeof(msg), timeout_ms) != sizeof(msg))
+        return 0;
+
+    *samples = (const unsigned int *)msg;
+
+    return pADC->stream.BufferSize / 2;
+}
+
+#endif // #if BSP_USE_ADC
+
+//-----------------------------------------------------------------------------
+/*
+ * @@ END
+ */
+
+ 
@@ -0,0 +1,748 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_adc_hw.h
+ *
+ * created: 2024-06-09
+ *  author: Bian
+ */
+
+#ifndef _LS2K_ADC_HW_H
+#define _LS2K_ADC_HW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// ADC 豸
+//-------------------------------------------------------------------------------------------------
+
+#define ADC_BASE        0x1611c000
+
+/*
+ * ADC 
+ */
+typedef struct
+{
+	volatile unsigned int sr;			/* 0x00 32 ADC ״̬Ĵ */
+	volatile unsigned int cr1;			/* 0x04 32 ADC ƼĴ1 */
+	volatile unsigned int cr2;			/* 0x08 32 ADC ƼĴ2 */
+	volatile unsigned int smpr1;		/* 0x0C 32 ADC ʱĴ1 */
+	volatile unsigned int smpr2;		/* 0x10 32 ADC ʱĴ2 */
+	volatile unsigned int jofr1;		/* 0x14 32 ADC עͨƫƼĴ1 */
+	volatile unsigned int jofr2;		/* 0x18 32 ADC עͨƫƼĴ2 */
+	volatile unsigned int jofr3;		/* 0x1C 32 ADC עͨƫƼĴ3 */
+	volatile unsigned int jofr4;		/* 0x20 32 ADC עͨƫƼĴ4 */
+	volatile unsigned int htr;			/* 0x24 32 ADC ŹֵĴ */
+	volatile unsigned int ltr;			/* 0x28 32 ADC ŹֵĴ */
+	volatile unsigned int sqr1;			/* 0x2C 32 ADC мĴ1 */
+	volatile unsigned int sqr2;			/* 0x30 32 ADC мĴ2 */
+	volatile unsigned int sqr3;			/* 0x34 32 ADC мĴ3 */
+	volatile unsigned int jsqr;			/* 0x38 32 ADC עмĴ */
+	volatile unsigned int jdr1;			/* 0x3C 32 ADC עݼĴ1 */
+	volatile unsigned int jdr2;			/* 0x40 32 ADC עݼĴ2 */
+	volatile unsigned int jdr3;			/* 0x44 32 ADC עݼĴ3 */
+	volatile unsigned int jdr4;			/* 0x48 32 ADC עݼĴ4 */
+	volatile unsigned int dr;			/* 0x4c 32 ADC ݼĴ */
+} HW_ADC_t;
+
+/*
+ * ADC Channels
+ */
+#define ADC_Channel_0           0x00
+#define ADC_Channel_1           0x01
+#define ADC_Channel_2           0x02
+#define ADC_Channel_3           0x03
+#define ADC_Channel_4           0x08
+#define ADC_Channel_5           0x09
+#define ADC_Channel_6           0x0a
+#define ADC_Channel_7           0x0b
+
+#define ADC_Channel_8           0x18
+#define ADC_Channel_9           0x19
+#define ADC_Channel_10          0x1A
+#define ADC_Channel_11          0x1B
+#define ADC_Channel_12          0x1C
+#define ADC_Channel_13          0x1D
+#define ADC_Channel_14          0x1E
+#define ADC_Channel_15          0x1F
+#define ADC_Channel_16          0x10
+#define ADC_Channel_17          0x11
+
+/**
+ * ADC_SR - ADC ״̬Ĵ
+ */
+#define ADC_SR_START			bit(4)			/* RW ͨʼ־λ. 0: ͨתδʼ, 1: ͨתѿʼ */
+#define ADC_SR_JSTART			bit(3)			/* RW עͨʼ־λ. 0: עͨתδʼ, 1: עͨתѿʼ */
+#define ADC_SR_JEOC				bit(2)			/* RW עͨת־λ. 0: תδ, 1: ת */
+#define ADC_SR_EOC				bit(1)			/* RW ת־λ. 0: תδ, 1: ת */
+#define ADC_SR_AWD				bit(0)			/* RW ģ⿴Ź־λ. 0: ûзģ⿴Ź¼, 1: ģ⿴Ź¼ */
+
+/**
+ * ADC_CR1 - ADC ƼĴ1
+ */
+#define ADC_CR1_OPS_MASK		(0x3<<30)		/* RW bit[31:30] ADC źλ. */
+#define ADC_CR1_OPS_SHIFT		30
+#define ADC_CR1_OPS_CLKSAME		(0<<30)			/* 0: ADCCLK ͬʱ */
+#define ADC_CR1_OPS_CLKBEFORE1	(1<<30)			/* 1: ADCCLK ǰһpclk */
+#define ADC_CR1_OPS_CLKAFTER1	(2<<30)			/* 2: ADCCLK غһpclk */
+#define ADC_CR1_CLK_MASK		(0x3F<<24)		/* RW bit[29:24] ADCCLK Ƶϵ[5:0]λ */
+#define ADC_CR1_CLK_SHIFT		24
+#define ADC_CR1_AWDEN			bit(23)			/* RW ͨģ⿴Ź.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: ڹͨϽģ⿴Ź, 1: ڹͨģ⿴Ź */
+#define ADC_CR1_JAWDEN			bit(22)			/* RW עͨģ⿴Ź.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: עͨϽģ⿴Ź, 1: עͨģ⿴Ź */
+#define ADC_CR1_DIFFMOD			bit(20)			/* RW ģʽʹ, ʱɶԵĶģбȽ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: òģʽ, 1: òģʽ */
+
+#define ADC_CR1_DISCNUM_MASK	(0x7<<13)		/* RW bit[15:13] ģʽͨ, ڼģʽ,
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    յⲿתͨĿ. */
+#define ADC_CR1_DISCNUM_SHIFT	13				// 000: 1 ͨ; 001: 2 ͨ;  ; 111: 8 ͨ
+#define ADC_CR1_JDISCEN			bit(12)			/* RW עͨϵļģʽ, ڿرעͨϵļģʽ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: עͨͣüģʽ, 1: עͨüģʽ
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR1_DISCEN			bit(11)			/* RW ڹͨϵļģʽ, ڿرչͨϵļģʽ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: ͨͣüģʽ, 1: ͨüģʽ
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR1_JAUTO			bit(10)			/* RW Զעͨ鿪ת, ڿرչͨתԶעͨת.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: رԶעͨת, 1: Զעͨת
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR1_AWDSGL			bit(9)			/* RW ɨģʽһһͨʹÿŹ, ڿر
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    AWDCH[4:0]λָͨϵģ⿴Ź.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: еͨʹģ⿴Ź, 1: ڵһͨʹģ⿴Ź
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR1_SCAN			bit(8)			/* RW ɨģʽ. ڿرɨģʽ. ɨģʽ,
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    תADC_SQRxADC_JSQRx Ĵѡеͨ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    ֻһͨתϺ,  ŻEOCIE JEOCIE λEOC JEOC ж.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: رɨģʽ, 1: ʹɨģʽ
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR1_JEOCIE			bit(7)			/* RW עͨжʹ. ڽֹעͨתж.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: ֹJEOC ж, 1: JEOC ж. ӲJEOC λʱж
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR1_AWDIE			bit(6)			/* RW ģ⿴Źжʹ. ڽֹģ⿴Źж. ɨģʽ,
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    Ź⵽Χֵʱ, ֻ˸λʱɨŻֹ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: ֹģ⿴Źж, 1: ģ⿴Źж
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR1_EOCIE			bit(5)			/* RW EOC жʹ. ڽֹתж.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: ֹEOC ж, 1: EOC ж. ӲEOC λʱж
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR1_AWDCH_MASK		0x1F			/* RW bit[4:0] ģ⿴Źͨѡ. ѡģ⿴Źͨ.
+												 *	  00000: ADC ģͨ0
+												 *	  00001: ADC ģͨ1
+												 *	  
+												 *	  00111: ADC ģͨ7
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+
+#define CR1_CLEAR_MASK_R        (~(ADC_CR1_OPS_MASK | \
+                                   ADC_CR1_CLK_MASK | \
+                                   ADC_CR1_AWDEN |   \
+                                   ADC_CR1_DIFFMOD | \
+                                   ADC_CR1_DISCNUM_MASK | \
+                                   ADC_CR1_SCAN |   \
+                                   ADC_CR1_DISCEN | \
+                                   ADC_CR1_EOCIE ))
+
+#define CR1_CLEAR_MASK_J        (~(ADC_CR1_JAWDEN |  \
+                                   ADC_CR1_JDISCEN | \
+                                   ADC_CR1_JAUTO |   \
+                                   ADC_CR1_JEOCIE))
+
+
+static inline int adc_set_discnum(HW_ADC_t *hwADC, int num, int Jmode)
+{
+    unsigned int cr1 = hwADC->cr1;
+    
+    cr1 &= ~(ADC_CR1_DISCNUM_MASK | ADC_CR1_JDISCEN | ADC_CR1_DISCEN);
+    
+    if (num > 0)
+    {
+        cr1 |= ((num - 1) << ADC_CR1_DISCNUM_SHIFT) & ADC_CR1_DISCNUM_MASK;
+        if (Jmode)
+            cr1 |= ADC_CR1_JDISCEN;
+        else
+            cr1 |= ADC_CR1_DISCEN;
+    }
+    
+    hwADC->cr1 = cr1;
+    return 0;
+}
+
+/**
+ * ADC_CR2 - ADC ƼĴ2
+ */
+//#define ADC_CR2_RESET			bit(31)
+#define ADC_CR2_EDGE_DOWN		bit(30)			/* RW ADC ʱӴѡ. 0: ش, 1: ½ش */
+#define ADC_CR2_CLK_MASK		(0xF<<26)		/* RW bit[29:26] ADC ʱӷƵϵ[9:6]λλƷ */
+#define ADC_CR2_CLK_SHIFT		26
+#define ADC_CR2_JTRIGMOD_MASK	(0x3<<24)		/* RW bit[25:24] ע봥ģʽѡ
+												 *    0: ǰתʼעͨת
+												 *    1: ǰתڲһADC λźźʼעͨת
+												 *    2: ڵǰתʼעͨת
+												 */
+#define ADC_CR2_JTRIGMOD_SHIFT	24
+#define ADC_CR2_SWSTART			bit(22)			/* RW ʼתͨ. øλת,
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    תʼӲλ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    extsel[2:0]λѡswstart Ϊ¼,
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    λһͨת.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: λ״̬, 1: ʼתͨ
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR2_JSWSTART		bit(21)			/* RW ʼתעͨ. øλת,λ
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    תʼӲλ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    jextsel[2:0]λѡjswstart Ϊ¼,
+                                                 *    λһעͨת.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: λ״̬, 1: ʼתעͨ
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR2_EXTTRIG			bit(20)			/* RW ͨⲿתģʽλú,
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    ڿֹͨתⲿ¼
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: ⲿ¼ת, 1: ʹⲿ¼ת
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR2_EXTSEL_MASK		(0x7<<17)		/* RW bit[19:17] ѡͨתⲿ¼,
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    Щλѡͨתⲿ¼. */
+#define ADC_CR2_EXTSEL_SHIFT	17				/*    : */
+#define ADC_CR2_EXTSEL_ATIM_CC1 (0<<17)			/*    3'b000: ATIM\_CC1 ¼ */
+#define ADC_CR2_EXTSEL_ATIM_CC2 (1<<17)			/*    3'b001: ATIM\_CC2 ¼ */
+#define ADC_CR2_EXTSEL_ATIM_CC3 (2<<17)			/*    3'b010: ATIM\_CC3 ¼ */
+#define ADC_CR2_EXTSEL_GTIM_CC2 (3<<17)			/*    3'b011: GTIM\_CC2 ¼ */
+#define ADC_CR2_EXTSEL_EXTI_11	(6<<17)			/*    3'b110: EXTI 11 */
+#define ADC_CR2_EXTSEL_SWATART	(7<<17)			/*    3'b111: swstart */
+
+#define ADC_CR2_JEXTTRIG		bit(15)			/* RW עͨⲿתģʽ. λú,
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    ڿֹעͨתⲿ¼
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: ⲿ¼ת, 1: ʹⲿ¼ת
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR2_JEXTSEL_MASK	(0x7<<12)		/* RW bit[14:12] ѡעͨתⲿ¼.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    Щλѡͨתⲿ¼, */
+#define ADC_CR2_JEXTSEL_SHIFT	12				/*    : */
+#define ADC_CR2_JEXTSEL_ATIM_TRGO	(0<<12)		/*    3'b000: ATIM_TRGO ¼ */
+#define ADC_CR2_JEXTSEL_ATIM_CC4	(1<<12)		/*    3'b001: ATIM_CC4 ¼ */
+#define ADC_CR2_JEXTSEL_GTIM_TRGO	(2<<12)		/*    3'b010: GTIM_TRGO ¼ */
+#define ADC_CR2_JEXTSEL_GTIM_CC1	(3<<12)		/*    3'b011: GTIM_CC1 ¼ */
+#define ADC_CR2_JEXTSEL_EXTI_15		(6<<12)		/*    3'b110: EXTI 15 */
+#define ADC_CR2_JEXTSEL_JSWSTART	(7<<12)		/*    3'b111: JSWSTART */
+
+#define ADC_CR2_ALIGN_LEFT		bit(11)			/* RW ݶ. 0: Ҷ, 1:  */
+#define ADC_CR2_DMA				bit(8)			/* RW ֱӴ洢ģʽ. 0: ʹDMA ģʽ, 1: ʹDMA ģʽ */
+#define ADC_CR2_RSTCAL  	    bit(3)		    /* RW λòӲ. У׼Ĵʼ, λ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: У׼Ĵѳʼ, 1: ʼУ׼Ĵ
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+
+#define ADC_CR2_CAL				bit(2)			/* RW AD У׼. λԿʼУ׼,У׼ʱӲ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: У׼, 1: ʼУ׼ */
+#define ADC_CR2_CONT			bit(1)			/* RW ת. λú. ˴λ,
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    תֱλ.
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    0: תģʽ, 1: תģʽ
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+#define ADC_CR2_ADON			bit(0)			/* RW /AD ת. λú. λΪ'0' ʱ,
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    д'1' ADC Ӷϵģʽ»,
+												 *    λΪ'1' ʱ,д'1' ת
+												 *    0: رADC ת/У׼,ϵģʽ
+												 *    1: ADC ת
+												 */
+
+#define CR2_CLEAR_MASK_R        (~(ADC_CR2_EDGE_DOWN | \
+                                   ADC_CR2_CLK_MASK  | \
+                                   ADC_CR2_SWSTART   | \
+                                   ADC_CR2_EXTTRIG   | \
+                                   ADC_CR2_EXTSEL_MASK | \
+                                   ADC_CR2_ALIGN_LEFT  | \
+                                   ADC_CR2_DMA    | \
+                                   ADC_CR2_RSTCAL | \
+                                   ADC_CR2_CAL    | \
+                                   ADC_CR2_CONT   | \
+                                   ADC_CR2_ADON))
+
+#define CR2_CLEAR_MASK_J        (~(ADC_CR2_JTRIGMOD_MASK | \
+                                   ADC_CR2_JSWSTART | \
+                                   ADC_CR2_JEXTTRIG | \
+                                   ADC_CR2_JEXTSEL_MASK))
+
+/**
+ * ADC_SMPR1 - ADC ʱĴ1
+ */
+#if 0
+/*
+ * move to ls2k_adc.h
+ */
+#define ADC_SMP_1P				0				/* 000: 1  */
+#define ADC_SMP_2P				1				/* 001: 2  */
+#define ADC_SMP_4P				2				/* 010: 4  */
+#define ADC_SMP_8P				3				/* 011: 8  */
+#define ADC_SMP_16P				4				/* 100: 16  */
+#define ADC_SMP_32P				5				/* 101: 32  */
+#define ADC_SMP_64P				6				/* 110: 64  */
+#define ADC_SMP_128P			7				/* 111: 128  */
+#endif
+
+#define ADC_SMPR1_SMP18_MASK	(0x7<<21)		/* RW bit[23:21] ͨ18Ĳʱ. Ϊ2  */
+#define ADC_SMPR1_SMP18_SHIFT	21
+#define ADC_SMPR1_SMP17_MASK	(0x7<<18)		/* RW bit[20:18] ͨ17Ĳʱ. */
+#define ADC_SMPR1_SMP17_SHIFT	18
+#define ADC_SMPR1_SMP16_MASK	(0x7<<15)		/* RW bit[17:15] ͨ16Ĳʱ. */
+#define ADC_SMPR1_SMP16_SHIFT	15
+#define ADC_SMPR1_SMP15_MASK	(0x7<<12)		/* RW bit[14:12] ͨ15Ĳʱ. */
+#define ADC_SMPR1_SMP15_SHIFT	12
+#define ADC_SMPR1_SMP14_MASK	(0x7<<9)		/* RW bit[11:9] ͨ14Ĳʱ. */
+#define ADC_SMPR1_SMP14_SHIFT	9
+#define ADC_SMPR1_SMP13_MASK	(0x7<<6)		/* RW bit[8:6] ͨ13Ĳʱ. */
+#define ADC_SMPR1_SMP13_SHIFT	6
+#define ADC_SMPR1_SMP12_MASK	(0x7<<3)		/* RW bit[5:3] ͨ12Ĳʱ. */
+#define ADC_SMPR1_SMP12_SHIFT	3
+#define ADC_SMPR1_SMP11_MASK	(0x7<<0)		/* RW bit[2:0] ͨ11Ĳʱ. */
+#define ADC_SMPR1_SMP11_SHIFT	0
+
+/**
+ * ADC_SMPR2 - ADC ʱĴ2
+ */
+#define ADC_SMPR2_SMP10_MASK	(0x7<<27)		/* RW bit[29:27] ͨ10Ĳʱ. */
+#define ADC_SMPR2_SMP10_SHIFT	27
+#define ADC_SMPR2_SMP9_MASK		(0x7<<24)		/* RW bit[26:24] ͨ9Ĳʱ. */
+#define ADC_SMPR2_SMP9_SHIFT	24
+#define ADC_SMPR2_SMP8_MASK		(0x7<<21)		/* RW bit[23:21] ͨ8Ĳʱ. */
+#define ADC_SMPR2_SMP8_SHIFT	21
+#define ADC_SMPR2_SMP7_MASK		(0x7<<18)		/* RW bit[20:18] ͨ7Ĳʱ. */
+#define ADC_SMPR2_SMP7_SHIFT	18
+#define ADC_SMPR2_SMP6_MASK		(0x7<<15)		/* RW bit[17:15] ͨ6Ĳʱ. */
+#define ADC_SMPR2_SMP6_SHIFT	15
+#define ADC_SMPR2_SMP5_MASK		(0x7<<12)		/* RW bit[14:12] ͨ5Ĳʱ. */
+#define ADC_SMPR2_SMP5_SHIFT	12
+#define ADC_SMPR2_SMP4_MASK		(0x7<<9)		/* RW bit[11:9] ͨ4Ĳʱ. */
+#define ADC_SMPR2_SMP4_SHIFT	9
+#define ADC_SMPR2_SMP3_MASK		(0x7<<6)		/* RW bit[8:6] ͨ3Ĳʱ. */
+#define ADC_SMPR2_SMP3_SHIFT	6
+#define ADC_SMPR2_SMP2_MASK		(0x7<<3)		/* RW bit[5:3] ͨ2Ĳʱ. */
+#define ADC_SMPR2_SMP2_SHIFT	3
+#define ADC_SMPR2_SMP1_MASK		(0x7<<0)		/* RW bit[2:0] ͨ1Ĳʱ. */
+#define ADC_SMPR2_SMP1_SHIFT	0
+
+//-----------------------------------------------------------------------------
+// adcͨĲ.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_set_samp_time(HW_ADC_t *hwADC, int rank, int t)
+{
+	unsigned int mask, val;
+
+    if ((rank > 0) && (rank <= 10))
+	{
+		mask = 0x7 << ((rank - 1) * 3);
+		val  = (t & 0x7) << ((rank - 1) * 3);
+		hwADC->smpr2 &= ~mask;
+		hwADC->smpr2 |= val;
+		return 0;
+	}
+    else if ((rank > 10) && (rank <= 18))
+	{
+		mask = 0x7 << ((rank - 11) * 3);
+		val  = (t & 0x7) << ((rank - 11) * 3);
+		hwADC->smpr1 &= ~mask;
+		hwADC->smpr1 |= val;
+		return 0;
+	}
+
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+// ȡadcͨĲ.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_get_samp_time(HW_ADC_t *hwADC, int rank)
+{
+	if ((rank > 0) && (rank <= 10))
+	{
+		return (int)(hwADC->smpr2 >> ((rank - 1) * 3)) & 0x7;
+	}
+    else if ((rank > 10) && (rank <= 18))
+	{
+		return (int)(hwADC->smpr1 >> ((rank - 11) * 3)) & 0x7;
+	}
+
+	return -1;
+}
+
+/**
+ * ADC_JOFRx (1-4) - ADC עͨƫƼĴx (1-4)
+ */
+#define ADC_JOFFSET_MASK		0xFFF			/* RW bit[11:0] עͨx ƫ. תעͨʱ,
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    Щλڴԭʼת
+ 	 	 	 	 	 	 	 	 	 	 	 	 *    ȥֵ. תĽADC_JDRx Ĵж.
+ 	 	 	 	 	 	 	 	 	 	 	 	 */
+
+//-----------------------------------------------------------------------------
+//  adc עͨƫ.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_set_joff(HW_ADC_t *hwADC, int rank, int off)
+{
+	if (!((rank > 0) && (rank <= 4)))
+		return -1;
+
+	switch (rank)
+	{
+		case 1: hwADC->jofr1 = (unsigned)off & ADC_JOFFSET_MASK; break;
+		case 2: hwADC->jofr2 = (unsigned)off & ADC_JOFFSET_MASK; break;
+		case 3: hwADC->jofr3 = (unsigned)off & ADC_JOFFSET_MASK; break;
+		case 4: hwADC->jofr4 = (unsigned)off & ADC_JOFFSET_MASK; break;
+	}
+
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// ȡ adc עͨƫ.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_get_joff(HW_ADC_t *hwADC, int rank)
+{
+	int ret = -1;
+
+	switch (rank)
+	{
+		case 1: ret = (int)(hwADC->jofr1 & ADC_JOFFSET_MASK); break;
+		case 2: ret = (int)(hwADC->jofr2 & ADC_JOFFSET_MASK); break;
+		case 3: ret = (int)(hwADC->jofr3 & ADC_JOFFSET_MASK); break;
+		case 4: ret = (int)(hwADC->jofr4 & ADC_JOFFSET_MASK); break;
+	}
+
+	return ret;
+}
+
+/**
+ * ADC_HTR - ADC ŹֵĴ
+ */
+#define ADC_HT_MASK				0xFFF			/* RW bit[11:0] ģ⿴Ź߷ֵ */
+
+/**
+ * ADC_LTR - ADC ŹֵĴ
+ */
+#define ADC_LT_MASK				0xFFF			/* RW bit[11:0] ģ⿴Źͷֵ */
+
+/**
+ * ADC_SQR1 - ADC мĴ1
+ */
+#define ADC_SQR1_LEN_MASK		(0xF<<20)		/* RW bit[23:20] ͨг
+												 *    0000: 1 ת
+												 *    0001: 2 ת
+												 *    
+												 *    1111: 16 ת
+												 */
+#define ADC_SQR1_LEN_SHIFT		20
+
+/*
+ * עתĵԴ
+ */
+#define ADC_SQR1_SQ16_MASK		(0x1F<<15)		/* RW bit[19:15] עе16תĵԴ */
+#define ADC_SQR1_SQ16_SHIFT		15
+#define ADC_SQR1_SQ15_MASK		(0x1F<<10)		/* RW bit[14:10] е15תԴ */
+#define ADC_SQR1_SQ15_SHIFT		10
+#define ADC_SQR1_SQ14_MASK		(0x1F<<5)		/* RW bit[9:5] е14תԴ */
+#define ADC_SQR1_SQ14_SHIFT		5
+#define ADC_SQR1_SQ13_MASK		(0x1F<<0)		/* RW bit[4:0] е13תԴ */
+#define ADC_SQR1_SQ13_SHIFT		0
+
+/**
+ * ADC_SQR2 - ADC мĴ1
+ */
+#define ADC_SQR1_SQ12_MASK		(0x1F<<25)		/* RW bit[29:25] е12תԴ */
+#define ADC_SQR1_SQ12_SHIFT		25
+#define ADC_SQR1_SQ11_MASK		(0x1F<<20)		/* RW bit[24:20] е11תԴ */
+#define ADC_SQR1_SQ11_SHIFT		20
+#define ADC_SQR1_SQ10_MASK		(0x1F<<15)		/* RW bit[19:15] е10תԴ */
+#define ADC_SQR1_SQ10_SHIFT		15
+#define ADC_SQR1_SQ9_MASK		(0x1F<<10)		/* RW bit[14:10] е9תԴ */
+#define ADC_SQR1_SQ9_SHIFT		10
+#define ADC_SQR1_SQ8_MASK		(0x1F<<5)		/* RW bit[9:5] е8תԴ */
+#define ADC_SQR1_SQ8_SHIFT		5
+#define ADC_SQR1_SQ7_MASK		(0x1F<<0)		/* RW bit[4:0] е7תԴ */
+#define ADC_SQR1_SQ7_SHIFT		0
+
+/**
+ * ADC_SQR3 - ADC мĴ3
+ */
+#define ADC_SQR1_SQ6_MASK		(0x1F<<25)		/* RW bit[29:25] е6תԴ */
+#define ADC_SQR1_SQ6_SHIFT		25
+#define ADC_SQR1_SQ5_MASK		(0x1F<<20)		/* RW bit[24:20] е5תԴ */
+#define ADC_SQR1_SQ5_SHIFT		20
+#define ADC_SQR1_SQ4_MASK		(0x1F<<15)		/* RW bit[19:15] е4תԴ */
+#define ADC_SQR1_SQ4_SHIFT		15
+#define ADC_SQR1_SQ3_MASK		(0x1F<<10)		/* RW bit[14:10] е3תԴ */
+#define ADC_SQR1_SQ3_SHIFT		10
+#define ADC_SQR1_SQ2_MASK		(0x1F<<5)		/* RW bit[9:5] е2תԴ */
+#define ADC_SQR1_SQ2_SHIFT		5
+#define ADC_SQR1_SQ1_MASK		(0x1F<<0)		/* RW bit[4:0] е1תԴ */
+#define ADC_SQR1_SQ1_SHIFT		0
+
+//-----------------------------------------------------------------------------
+//  adc ͨг.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_set_sq_len(HW_ADC_t *hwADC, int len)
+{
+    if ((len > 0) && (len <= 16))
+	{
+		unsigned int val;
+
+		val = ((len - 1) << ADC_SQR1_LEN_SHIFT) & ADC_SQR1_LEN_MASK;
+		hwADC->sqr1 &= ~ADC_SQR1_LEN_MASK;
+		hwADC->sqr1 |= val;
+
+		return 0;
+	}
+
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+// ȡ adc ͨг.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_get_sq_len(HW_ADC_t *hwADC)
+{
+	int sql = (int)(hwADC->sqr1 & ADC_SQR1_LEN_MASK) >> ADC_SQR1_LEN_SHIFT;
+	return sql + 1;
+}
+
+//-----------------------------------------------------------------------------
+//  adc ͨ.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_set_sq(HW_ADC_t *hwADC, int rank, int channelID)
+{
+	unsigned int mask, val;
+
+	if ((rank > 0) && (rank <= 6))
+	{
+		mask = 0x1F << ((rank - 1) * 5);
+		val  = (channelID & 0x1F) << ((rank - 1) * 5);
+		hwADC->sqr3 &= ~mask;
+		hwADC->sqr3 |= val;
+		return 0;
+	}
+	else if ((rank > 6) && (rank <= 12))
+	{
+		mask = 0x1F << ((rank - 7) * 5);
+		val  = (channelID & 0x1F) << ((rank - 7) * 5);
+		hwADC->sqr2 &= ~mask;
+		hwADC->sqr2 |= val;
+		return 0;
+	}
+	else if ((rank > 12) && (rank <= 16))
+	{
+		mask = 0x1F << ((rank - 13) * 5);
+		val  = (channelID & 0x1F) << ((rank - 13) * 5);
+		hwADC->sqr1 &= ~mask;
+		hwADC->sqr1 |= val;
+		return 0;
+	}
+
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+// ȡ adc ͨ.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_get_sq(HW_ADC_t *hwADC, int rank)
+{
+	if ((rank > 0) && (rank <= 6))
+	{
+		return (int)(hwADC->sqr3 >> ((rank - 1) * 5)) & 0x1F;
+	}
+	else if ((rank > 6) && (rank <= 12))
+	{
+		return (int)(hwADC->sqr2 >> ((rank - 7) * 5)) & 0x1F;
+	}
+	else if ((rank > 12) && (rank <= 16))
+	{
+		return (int)(hwADC->sqr1 >> ((rank - 13) * 5)) & 0x1F;
+	}
+
+	return -1;
+}
+
+/**
+ * ADC_JSQR - ADC עмĴ
+ */
+/*
+ * עͨг
+ */
+#define ADC_JLEN_1				0				/* 00: 1 ת */
+#define ADC_JLEN_2				1				/* 01: 2 ת */
+#define ADC_JLEN_3				2				/* 10: 3 ת */
+#define ADC_JLEN_4				3				/* 11: 4 ת */
+
+#define ADC_JSQR_LEN_MASK		(0x3<<20)		/* RW bit[21:20] עͨг */
+#define ADC_JSQR_LEN_SHIFT		20
+
+#define ADC_JSQR_4_MASK			(0x1F<<15)		/* RW bit[19:15] עе4 תԴ */
+#define ADC_JSQR_4_SHIFT		15
+#define ADC_JSQR_3_MASK			(0x1F<<10)		/* RW bit[14:10] עе3 תԴ */
+#define ADC_JSQR_3_SHIFT		10
+#define ADC_JSQR_2_MASK			(0x1F<<5)		/* RW bit[9:5] עе2 תԴ */
+#define ADC_JSQR_2_SHIFT		5
+#define ADC_JSQR_1_MASK			(0x1F<<0)		/* RW bit[4:0] עе1 תԴ */
+#define ADC_JSQR_1_SHIFT		0
+
+//-----------------------------------------------------------------------------
+//  adc עͨг.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_set_jsq_len(HW_ADC_t *hwADC, int len)
+{
+	if ((len > 0) && (len <= 4))
+	{
+		unsigned int val;
+
+		val = ((len - 1) << ADC_JSQR_LEN_SHIFT) & ADC_JSQR_LEN_MASK;
+		hwADC->jsqr &= ~ADC_JSQR_LEN_MASK;
+		hwADC->jsqr |= val;
+
+		return 0;
+	}
+
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+// ȡ adc עͨг.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_get_jsq_len(HW_ADC_t *hwADC)
+{
+	int ret = (int)(hwADC->jsqr & ADC_JSQR_LEN_MASK) >> ADC_JSQR_LEN_SHIFT;
+	return ret + 1;
+}
+
+//-----------------------------------------------------------------------------
+//  adc עͨ.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_set_jsq(HW_ADC_t *hwADC, int rank, int jchannelID)
+{
+	unsigned int mask, val;
+
+	if ((rank > 0) && (rank <= 4))
+	{
+		mask = 0x1F << ((rank - 1) * 5);
+		val  = (jchannelID & 0x1F) << ((rank - 1) * 5);
+		hwADC->jsqr &= ~mask;
+		hwADC->jsqr |= val;
+
+		return 0;
+	}
+
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+// ȡ adc עͨ.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_get_jsq(HW_ADC_t *hwADC, int rank)
+{
+	if ((rank > 0) && (rank <= 4))
+	{
+		return (int)(hwADC->jsqr >> ((rank - 1) * 5)) & 0x1F;
+	}
+
+	return -1;
+}
+
+/**
+ * ADC_JDRx (1-4) - ADC עݼĴ
+ */
+#define ADC_JDATA_MASK			0xFFFF			/* RO bit[15:0] ADC עת */
+
+/**
+ * ADC_DR - ADC ݼĴ
+ */
+#define ADC_DATA_MASK			0xFFFF			/* RO ADC תܿĵ */
+
+//-----------------------------------------------------------------------------
+// ȡ adc עͨתֵ.  1 ʼ
+//-----------------------------------------------------------------------------
+
+static inline int adc_get_jsq_result(HW_ADC_t *hwADC, int rank)
+{
+	int ret = -1;
+
+	switch (rank)
+	{
+		case 1: ret = (int)(hwADC->jdr1 & ADC_JDATA_MASK); break;
+		case 2: ret = (int)(hwADC->jdr2 & ADC_JDATA_MASK); break;
+		case 3: ret = (int)(hwADC->jdr3 & ADC_JDATA_MASK); break;
+		case 4: ret = (int)(hwADC->jdr4 & ADC_JDATA_MASK); break;
+	}
+
+	return ret;
+}
+
+//-------------------------------------------------------------------------------------------------
+// ADC ʱ. ģʽ ATIM/GTIM ıȽ¼ CCx ͨת
+//-------------------------------------------------------------------------------------------------
+
+#define ATIM_BASE       0x16118000
+#define GTIM_BASE       0x16119000
+
+/*
+ * ATIM/GTIM ʱ, ֻõ PWM Ƚϲ
+ */
+typedef struct
+{
+	volatile unsigned int cr1;			/* 0x00 32 ƼĴ1 */
+	volatile unsigned int cr2;			/* 0x04 32 ƼĴ2 */
+	volatile unsigned int smcr;			/* 0x08 32 ģʽƼĴ */
+	volatile unsigned int dier;			/* 0x0C 32 DMA/жʹܼĴ */
+	volatile unsigned int sr;			/* 0x10 32 ״̬Ĵ */
+	volatile unsigned int egr;			/* 0x14 32 ¼Ĵ */
+	volatile unsigned int ccmr1;		/* 0x18 32 /ȽģʽĴ1 */
+	volatile unsigned int ccmr2;		/* 0x1C 32 /ȽģʽĴ2 */
+	volatile unsigned int ccer;			/* 0x20 32 /ȽʹܼĴ */
+	volatile unsigned int cnt;			/* 0x24 32  */
+	volatile unsigned int psc;			/* 0x28 32 ԤƵ */
+	volatile unsigned int arr;			/* 0x2C 32 ԶװؼĴ */
+	volatile unsigned int rcr;			/* 0x30 32 ظĴ, ATIM */
+	volatile unsigned int ccr[4];		/* 0x34~0x40 32 /ȽϼĴ1~4 */
+	volatile unsigned int bdtr;			/* 0x44 32 ɲĴ, ATIM */
+} HW_TIM_t;
+
+#define TIM_CR1_ARPE			bit(7)			/* RW ԶװԤװ */
+#define TIM_CR1_CEN				bit(0)			/* RW ʹ */
+
+#define TIM_EGR_UG				bit(0)			/* W  ¼, װ PSC/ARR */
+
+#define TIM_CCMR_OCM_MASK		0x70			/* RW Ƚģʽ, ͨ 1/3  bit[6:4], ͨ 2/4  bit[14:12] */
+#define TIM_CCMR_OCM_PWM1		0x60			/*    110: PWM ģʽ1 */
+#define TIM_CCMR_OCPE			0x08			/* RW ȽԤװʹ */
+
+#define TIM_CCER_CCE(n)			bit(((n)-1)*4)	/* RW Ƚͨ n ʹ, n=1~4 */
+
+#define TIM_BDTR_MOE			bit(15)			/* RW ʹ, ATIM */
+
+/*
+ * öʱͨ ch  PWM ģʽ. ch  1 ʼ
+ */
+static inline void tim_set_pwm_channel(HW_TIM_t *hwTIM, int ch, unsigned int pulse)
+{
+	volatile unsigned int *ccmr = (ch <= 2) ? &hwTIM->ccmr1 : &hwTIM->ccmr2;
+	int shift = (ch & 1) ? 0 : 8;
+	unsigned int val;
+
+	val  = *ccmr & ~((TIM_CCMR_OCM_MASK | TIM_CCMR_OCPE | 0x03) << shift);
+	val |= (TIM_CCMR_OCM_PWM1 | TIM_CCMR_OCPE) << shift;
+	*ccmr = val;
+
+	hwTIM->ccr[ch-1] = pulse;
+	hwTIM->ccer |= TIM_CCER_CCE(ch);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LS2K_ADC_HW_H
+
+
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+
+#ifndef __CONSOLE_H__
+#define __CONSOLE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void console_init(unsigned int baudrate);
+
+char console_getch(void);
+ssize_t console_gets(void *buf, size_t nbytes);
+
+void console_putch(char ch);
+ssize_t console_puts(char *buf, size_t nbytes);
+
+/*
+ * printk() ӳ
+ */
+void printk_drain(void);
+void printk_flush(void);
+int printk_start_drain_task(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__CONSOLE_H__*/
+
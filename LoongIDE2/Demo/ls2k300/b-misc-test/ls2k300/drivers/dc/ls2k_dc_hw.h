@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2021-2022 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_dc_hw.h
+ *
+ * created: 2022-03-16
+ *  author: Bian
+ */
+
+#ifndef _LS2K_DC_HW_H
+#define _LS2K_DC_HW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// DC 豸
+//-------------------------------------------------------------------------------------------------
+
+#define DC_BASE	    0x16090000+0x1240
+
+/*
+ * DC 
+ */
+typedef struct 
+{
+	volatile unsigned int config;           /* 0x0000 - 0x1240: üĴ */
+	volatile unsigned int rsv01[7];
+	volatile unsigned int buf_addr;         /* 0x0020 - 0x1260: ַ֡Ĵ0, ͼڴ׵ַ */
+	volatile unsigned int rsv02[7];
+	volatile unsigned int stride;           /* 0x0040 - 0x1280: ʾһеֽ */
+	volatile unsigned int rsv03[7];
+	volatile unsigned int origin;           /* 0x0060 - 0x12A0: ʾԭֽ, һд 0 */
+	volatile unsigned int rsv04[47];
+	volatile unsigned int di_config;        /* 0x0120 - 0x1360: ʾüĴ */
+	volatile unsigned int rsv05[7];
+	volatile unsigned int di_tablelo;       /* 0x0140 - 0x1380: ʾ LOW */
+	volatile unsigned int rsv06[7];
+	volatile unsigned int di_tablehi;       /* 0x0160 - 0x13A0: ʾ HIGH */
+	volatile unsigned int rsv07[7];
+	volatile unsigned int pan_config;       /* 0x0180 - 0x13C0: ҺüĴ */
+	volatile unsigned int rsv08[7];
+	volatile unsigned int pan_timing;       /* 0x01A0 - 0x13E0: ҺʱĴ */
+	volatile unsigned int rsv09[7];
+	volatile unsigned int hdisplay;         /* 0x01C0 - 0x1400: ˮƽʾ */
+	volatile unsigned int rsv10[7];
+	volatile unsigned int hsync;            /* 0x01E0 - 0x1420: ˮƽͬ */
+	volatile unsigned int rsv11[23];
+	volatile unsigned int vdisplay;         /* 0x0240 - 0x1480: ֱʾ */
+	volatile unsigned int rsv12[7];
+	volatile unsigned int vsync;            /* 0x0260 - 0x14A0: ֱͬ */
+	volatile unsigned int rsv13[7];
+	volatile unsigned int scan_pos;         /* 0x0280 - 0x14C0: ǰɨλ */
+	volatile unsigned int rsv14[43];
+	volatile unsigned int int_reg;          /* 0x0330 - 0x1570: жϼĴ */
+	volatile unsigned int rsv15[3];
+	volatile unsigned int dbl_buf_addr;     /* 0x0340 - 0x1580: ַ֡Ĵ1 */
+} HW_DC_t;
+
+#define DC_BURST_SIZE       0x7F    // 0xFF
+
+/*
+ * Config Register
+ */
+#define DC_CFG_RESET            (1<<20)		// 0: reset
+#define DC_CFG_GAMMA_EN         (1<<12)		// 1: enable
+#define DC_CFG_SWITCH_PANEL     (1<<9)		// 1: to switch to another panel. XXX (2 DC)
+#define DC_CFG_OUTPUT_EN        (1<<8)		// 1: enable
+#define DC_CFG_FORMAT_MASK      0x07		// color format
+#define DC_CFG_COLOR_NONE       0
+#define DC_CFG_COLOR_R4G4B4     1
+#define DC_CFG_COLOR_R5G5B5     2
+#define DC_CFG_COLOR_R5G6B5     3
+#define DC_CFG_COLOR_R8G8B8     4
+
+/*
+ * Display Dither Register
+ */
+#define DC_DITHER_ENABLE        (1<<31)	    // 1: enable
+#define DC_DITHER_RED_MASK      0x0F0000	// bit[19:16]
+#define DC_DITHER_RED_SHIFT     16
+#define DC_DITHER_GREEN_MASK    0x000F00	// bit[11:8]
+#define DC_DITHER_GREEN_SHIFT   8
+#define DC_DITHER_BLUE_MASK     0x00000F	// bit[3:0]
+
+/*
+ * Panel Configure Register
+ */
+#define DC_PANEL_CLOCK_POL      (1<<9)		// 1: ʱӼ÷, default=0
+#define DC_PANEL_CLOCK_EN       (1<<8)		// 1: ʱʹ
+#define DC_PANEL_DATA_EN_POL    (1<<1)		// 1: ʹܼ÷ , default=0
+#define DC_PANEL_DATA_EN        (1<<0)		// 1: ʹ
+
+/*
+ * HDisplay Register
+ */
+#define DC_HDISP_TOTAL_MASK     0x0FFF0000	// bit[27:16], ʾһе(ʾ)
+#define DC_HDISP_TOTAL_SHIFT    16
+#define DC_HDISP_DISP_MASK      0x00000FFF	// bit[11:0], ʾһеʾ
+#define DC_HDISP_DISP_SHIFT     0
+
+/*
+ * HSync Register
+ */
+#define DC_HSYNC_POLARITY       (1<<31)		// HSync źŵļ, 1: ȡ, default=0
+#define DC_HSYNC_PULSE          (1<<30)		// HSync źʹ, 1: ʹ
+#define DC_HSYNC_END_MASK       0x0FFF0000	// bit[27:16], HSync źŽ
+#define DC_HSYNC_END_SHIFT      16
+#define DC_HSYNC_START_MASK     0x00000FFF	// bit[11:0], HSync źſʼ
+
+/*
+ * VDisplay Register
+ */
+#define DC_VDISP_TOTAL_MASK     0x07FF0000	// bit[26:16], ʾ()
+#define DC_VDISP_TOTAL_SHIFT    16
+#define DC_VDISP_DISP_MASK      0x000007FF	// bit[10:0], ʾʾ
+
+/*
+ * VSync Register
+ */
+#define DC_VSYNC_POLARITY       (1<<31)		// VSync źŵļ, 1: ȡ, default=0
+#define DC_VSYNC_PULSE          (1<<30)		// VSync źʹ, 1: ʹ
+#define DC_VSYNC_END_MASK       0x0FFF0000	// bit[27:16], VSync źŽ
+#define DC_VSYNC_END_SHIFT      16
+#define DC_VSYNC_START_MASK     0x00000FFF	// bit[11:0], VSync źſʼ
+
+/*
+ * Interrupt Register.  16 λ״̬, д 1 ;  16 λǶӦжʹ
+ */
+#define DC_INT_VSYNC            (1<<2)		// ʾ봹ֱ
+#define DC_INT_HSYNC            (1<<3)		// ʾˮƽ
+#define DC_INT_VSYNC_EN         (1<<18)		// 1: ʹ VSync ж
+#define DC_INT_HSYNC_EN         (1<<19)		// 1: ʹ HSync ж
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LS2K_DC_HW_H
+
+
+
@@ -0,0 +1,2100 @@
+/*
+ * Copyright (C) 2021-2022 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_fb_utils.c
+ *
+ *  Created on: 2014-11-10
+ *      Author: Bian
+ */
+
+#include "bsp.h"
+
+#if BSP_USE_DC
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <larchintrin.h>
+
+#if defined(LS2K300)
+#include "ls2k300.h"
+#elif defined(LS2K500)
+#include "ls2k500.h"
+#elif defined(LS2K1000LA)
+#include "ls2k1000.h"
+#else
+#error "No Loongson SoC defined."
+#endif
+
+#include "cpu.h"
+#include "fb.h"
+#include "osal.h"
+
+#include "ls2k_dc.h"
+#include "font/font_desc.h"
+
+/******************************************************************************
+ * Defined Color, already RGB565
+ */
+#define _BLUE      		(0x14 << 0)
+#define _GREEN      	(0x14 << 6)
+#define _RED        	(0x14 << 11)
+
+#define _BLACK    		(0)
+#define _WHITE    		(_RED | _GREEN | _BLUE)
+
+#define _HALF_BLUE    	(0x0A << 0)
+#define _HALF_GREEN    	(0x0A << 6)
+#define _HALF_RED    	(0x0A << 11)
+
+#define _BRT_BLUE     	(0x1E << 0)
+#define _BRT_GREEN    	(0x1E << 6)
+#define _BRT_RED      	(0x1E << 11)
+
+#define LU_BLACK    	(0)
+#define LU_BLUE      	(_BLUE)
+#define LU_GREEN    	(_GREEN)
+#define LU_CYAN      	(_GREEN | _BLUE)
+#define LU_RED      	(_RED)
+#define LU_VIOLET    	(_RED | _BLUE)
+#define LU_YELLOW    	(_RED | _GREEN)
+#define LU_WHITE    	(_RED | _GREEN | _BLUE)
+#define LU_GREY      	(_HALF_RED | _HALF_GREEN | _HALF_BLUE)
+#define LU_BRT_BLUE		(_HALF_RED | _HALF_GREEN | _BRT_BLUE)
+#define LU_BRT_GREEN  	(_HALF_RED | _BRT_GREEN | _HALF_BLUE)
+#define LU_BRT_CYAN		(_HALF_RED | _BRT_GREEN | _BRT_BLUE)
+#define LU_BRT_RED    	(_BRT_RED | _HALF_GREEN | _HALF_BLUE)
+#define LU_BRT_VIOLET	(_BRT_RED | _HALF_GREEN | _BRT_BLUE)
+#define LU_BRT_YELLOW	(_BRT_RED | _BRT_GREEN | _HALF_BLUE)
+#define LU_BRT_WHITE  	(_BRT_RED | _BRT_GREEN | _BRT_BLUE)
+
+#define LU_BTNFACE		((0x10 << 0) | (0x10 << 6) | (0x10 << 11))
+#define LU_SILVER		((0x18 << 0) | (0x18 << 6) | (0x18 << 11))
+
+/******************************************************************************
+ * ɫ
+ */
+static unsigned short m_color_map[256] =
+{
+	LU_BLACK,        	/* 0 */
+	LU_BLUE,        	/* 1 */
+	LU_GREEN,        	/* 2 */
+	LU_CYAN,        	/* 3 */
+	LU_RED,          	/* 4 */
+	LU_VIOLET,       	/* 5 */
+	LU_YELLOW,        	/* 6 */
+	LU_WHITE,        	/* 7 */
+	LU_GREY,        	/* 8 */
+	LU_BRT_BLUE,      	/* 9 */
+	LU_BRT_GREEN,      	/* 10 */
+	LU_BRT_CYAN,      	/* 11 */
+	LU_BRT_RED,        	/* 12 */
+	LU_BRT_VIOLET,      /* 13 */
+	LU_BRT_YELLOW,      /* 14 */
+	LU_BRT_WHITE,      	/* 15 */
+	LU_BTNFACE,	      	/* 16 */
+	LU_SILVER,      	/* 17 */
+};
+
+/******************************************************************************
+ * Console 
+ */
+#define COL_GAP				0		/* ַ */
+#define ROW_GAP				0		/* ַ */
+
+#define CONS_FONT_WIDTH		8
+#define CONS_FONT_HEIGHT	16
+
+#define LEFT_MARGIN			1
+#define TOP_MARGIN			3
+#define RIGHT_MARGIN		1
+#define BOTTOM_MARGIN		2
+
+/******************************************************************************
+ * Local useful type & variables
+ */
+
+typedef struct
+{
+	void  *dc;                              /* display control device */
+
+	struct fb_fix_screeninfo fixInfo;       // dc->fb_fix
+	struct fb_var_screeninfo varInfo;       // dc->fb_var
+
+	int    bytes_per_pixel;                 /* ÿֽ */
+
+	int    fg_coloridx;                     /* ǰɫ WHITE */
+	int    bg_coloridx;                     /* ɫ BLACK */
+
+	unsigned int Rows;                      /* Ļ */
+	unsigned int Cols;                      /* Ļ */
+
+	unsigned int curCol;                    /* ǰ, 0 to fb->Cols - 1 */
+	unsigned int curRow;                    /* ǰ, 0 to fb->Rows - 1 */
+
+	unsigned char **lineAddr;               /* Ļڴַ */
+
+} FB_SOFTC_t;
+
+static FB_SOFTC_t ls2k_fb, *fb = &ls2k_fb;
+
+/******************************************************************************
+ * FrameBuffer Variables Initialize
+ ******************************************************************************/
+
+/*
+ * macro for r/w buffer
+ */
+#define IN_BOUND(x, y)	    (((x)>=0) && ((x)<fb->varInfo.xres) && ((y)>=0) && ((y)<fb->varInfo.yres))
+
+#define FB_ADDR_OFF(x, y)	(((x)+(y)*fb->varInfo.xres)*fb->bytes_per_pixel)
+
+#define RD_FB16(offset)     (*((volatile unsigned short *)(fb->fixInfo.smem_start+(offset))))
+#define WR_FB16(offset, v)  (*((volatile unsigned short *)(fb->fixInfo.smem_start+(offset)))=(v))
+
+#define WR_FB32(offset, v)  (*((volatile unsigned int *)(fb->fixInfo.smem_start+(offset)))=(v))
+#define WR_FB64(offset, v)  (*((volatile unsigned long *)(fb->fixInfo.smem_start+(offset)))=(v))
+
+/******************************************************************************
+ * /
+ *
+ * ֻüһ, Ȼе fb_fill_span()/fb_copy_span(). β
+ * ְֽڶд, м䰴 64 λ(ʱ LSX  128 λ)д.
+ ******************************************************************************/
+
+#if defined(__loongarch_sx)
+#include <lsxintrin.h>
+#define SPAN_ALIGN      16
+#else
+#define SPAN_ALIGN      8
+#endif
+
+#define SPAN_HEAD(p)    ((SPAN_ALIGN - ((unsigned long)(p) & (SPAN_ALIGN - 1))) & (SPAN_ALIGN - 1))
+
+/*
+ * ɫظ 64 λ. 1/2/4 ֽ
+ */
+static inline unsigned long fb_color64(unsigned int color, int bytes_per_pixel)
+{
+	unsigned long c64;
+
+	switch (bytes_per_pixel)
+	{
+		case 1:  c64 = color & 0xFF;   c64 |= c64 << 8; c64 |= c64 << 16; break;
+		case 2:  c64 = color & 0xFFFF; c64 |= c64 << 16; break;
+		default: c64 = color & 0xFFFFFFFF; break;
+	}
+
+	return c64 | (c64 << 32);
+}
+
+/*
+ *  bytes ֽ. p صַ, framebuffer ׵ַ 8 ֽڶ, Եַ p 
+ * Ӧдֽھ c64 ĵ (p & 7) ֽ
+ */
+static void fb_fill_span(unsigned char *p, size_t bytes, unsigned long c64, unsigned xormode)
+{
+	const unsigned char *pat = (const unsigned char *)&c64;
+	size_t n;
+
+	n = SPAN_HEAD(p);
+	n = (n < bytes) ? n : bytes;
+	bytes -= n;
+
+	for ( ; n > 0; n--, p++)
+	{
+		if (xormode)
+			*p ^= pat[(unsigned long)p & 7];
+		else
+			*p  = pat[(unsigned long)p & 7];
+	}
+
+#if defined(__loongarch_sx)
+	{
+		__m128i v = __lsx_vreplgr2vr_d((long)c64);
+
+		if (xormode)
+		{
+			for ( ; bytes >= 16; bytes -= 16, p += 16)
+			{
+				__lsx_vst(__lsx_vxor_v(__lsx_vld(p, 0), v), p, 0);
+			}
+		}
+		else
+		{
+			for ( ; bytes >= 64; bytes -= 64, p += 64)
+			{
+				__lsx_vst(v, p, 0);
+				__lsx_vst(v, p, 16);
+				__lsx_vst(v, p, 32);
+				__lsx_vst(v, p, 48);
+			}
+
+			for ( ; bytes >= 16; bytes -= 16, p += 16)
+			{
+				__lsx_vst(v, p, 0);
+			}
+		}
+	}
+#endif
+
+	{
+		unsigned long *p64 = (unsigned long *)p;
+
+		if (xormode)
+		{
+			for ( ; bytes >= 8; bytes -= 8)
+			{
+				*p64++ ^= c64;
+			}
+		}
+		else
+		{
+			for ( ; bytes >= 32; bytes -= 32, p64 += 4)
+			{
+				p64[0] = c64;
+				p64[1] = c64;
+				p64[2] = c64;
+				p64[3] = c64;
+			}
+
+			for ( ; bytes >= 8; bytes -= 8)
+			{
+				*p64++ = c64;
+			}
+		}
+
+		p = (unsigned char *)p64;
+	}
+
+	for ( ; bytes > 0; bytes--, p++)
+	{
+		if (xormode)
+			*p ^= pat[(unsigned long)p & 7];
+		else
+			*p  = pat[(unsigned long)p & 7];
+	}
+}
+
+/*
+ * ǰ, dst  src ֮ǰ߲ص
+ */
+static void fb_copy_span_forward(unsigned char *dst, const unsigned char *src, size_t bytes)
+{
+	unsigned long *d64;
+	const unsigned long *s64;
+	size_t n;
+
+	n = SPAN_HEAD(dst);
+	n = (n < bytes) ? n : bytes;
+	bytes -= n;
+
+	while (n-- > 0)
+	{
+		*dst++ = *src++;
+	}
+
+#if defined(__loongarch_sx)
+	for ( ; bytes >= 64; bytes -= 64, dst += 64, src += 64)
+	{
+		__m128i v0 = __lsx_vld(src, 0);
+		__m128i v1 = __lsx_vld(src, 16);
+		__m128i v2 = __lsx_vld(src, 32);
+		__m128i v3 = __lsx_vld(src, 48);
+
+		__lsx_vst(v0, dst, 0);
+		__lsx_vst(v1, dst, 16);
+		__lsx_vst(v2, dst, 32);
+		__lsx_vst(v3, dst, 48);
+	}
+#endif
+
+	d64 = (unsigned long *)dst;
+	s64 = (const unsigned long *)src;
+
+	for ( ; bytes >= 32; bytes -= 32, d64 += 4, s64 += 4)
+	{
+		unsigned long w0 = s64[0], w1 = s64[1], w2 = s64[2], w3 = s64[3];
+
+		d64[0] = w0;
+		d64[1] = w1;
+		d64[2] = w2;
+		d64[3] = w3;
+	}
+
+	for ( ; bytes >= 8; bytes -= 8)
+	{
+		*d64++ = *s64++;
+	}
+
+	dst = (unsigned char *)d64;
+	src = (const unsigned char *)s64;
+
+	while (bytes-- > 0)
+	{
+		*dst++ = *src++;
+	}
+}
+
+/*
+ * β, dst  src ֮ص
+ */
+static void fb_copy_span_backward(unsigned char *dst, const unsigned char *src, size_t bytes)
+{
+	unsigned long *d64;
+	const unsigned long *s64;
+	size_t n;
+
+	dst += bytes;
+	src += bytes;
+
+	n = (unsigned long)dst & (SPAN_ALIGN - 1);
+	n = (n < bytes) ? n : bytes;
+	bytes -= n;
+
+	while (n-- > 0)
+	{
+		*--dst = *--src;
+	}
+
+#if defined(__loongarch_sx)
+	for ( ; bytes >= 64; bytes -= 64)
+	{
+		__m128i v0, v1, v2, v3;
+
+		dst -= 64;
+		src -= 64;
+
+		v3 = __lsx_vld(src, 48);
+		v2 = __lsx_vld(src, 32);
+		v1 = __lsx_vld(src, 16);
+		v0 = __lsx_vld(src, 0);
+
+		__lsx_vst(v3, dst, 48);
+		__lsx_vst(v2, dst, 32);
+		__lsx_vst(v1, dst, 16);
+		__lsx_vst(v0, dst, 0);
+	}
+#endif
+
+	d64 = (unsigned long *)dst;
+	s64 = (const unsigned long *)src;
+
+	for ( ; bytes >= 32; bytes -= 32)
+	{
+		unsigned long w0, w1, w2, w3;
+
+		d64 -= 4;
+		s64 -= 4;
+
+		w3 = s64[3]; w2 = s64[2]; w1 = s64[1]; w0 = s64[0];
+
+		d64[3] = w3;
+		d64[2] = w2;
+		d64[1] = w1;
+		d64[0] = w0;
+	}
+
+	for ( ; bytes >= 8; bytes -= 8)
+	{
+		*--d64 = *--s64;
+	}
+
+	dst = (unsigned char *)d64;
+	src = (const unsigned char *)s64;
+
+	while (bytes-- > 0)
+	{
+		*--dst = *--src;
+	}
+}
+
+/*
+ *  bytes ֽ,  memmove() һص. dst  src  8 ֽڵͬʱ
+ * ޷ֶ,  memmove()
+ */
+static void fb_copy_span(unsigned char *dst, const unsigned char *src, size_t bytes)
+{
+	if ((dst == src) || (bytes == 0))
+	{
+		return;
+	}
+
+	if (((unsigned long)dst ^ (unsigned long)src) & 7)
+	{
+		memmove(dst, src, bytes);
+	}
+	else if ((dst < src) || (dst >= src + bytes))
+	{
+		fb_copy_span_forward(dst, src, bytes);
+	}
+	else
+	{
+		fb_copy_span_backward(dst, src, bytes);
+	}
+}
+
+int fb_get_pixelsx(void)
+{
+	if (fb->dc != NULL)
+	{
+    	return fb->varInfo.xres;
+    }
+
+	return -1;
+}
+
+int fb_get_pixelsy(void)
+{
+	if (fb->dc != NULL)
+	{
+    	return fb->varInfo.yres;
+    }
+
+	return -1;
+}
+
+/******************************************************************************
+ * FrameBuffer Draw Text
+ ******************************************************************************/
+
+/*
+ * ʾһַ
+ */
+void fb_draw_ascii_char(int x, int y, unsigned char *chr)
+{
+	unsigned int   mem_off;
+	unsigned char *font_buf;
+	int		       buflen;
+
+	if (chr == NULL)
+	{
+    	return;
+    }
+
+	font_desc_t *font = get_font_desc((const unsigned char *)chr, false);
+	if (font == NULL)
+	{
+    	return;
+    }
+
+	font_buf = (unsigned char *)font->get_font_data((const unsigned char *)chr, &buflen);
+	if (font_buf == NULL)
+	{
+    	return;
+    }
+
+	unsigned int xormode  = fb->fg_coloridx &  XORMODE;
+	unsigned int coloridx = fb->fg_coloridx & ~XORMODE;
+
+	if (IN_BOUND(x, y) && IN_BOUND(x+font->width-1, y+font->height-1))
+	{
+		unsigned short wr16, rd16;
+		int font_row, font_col;
+
+		for (font_row = 0; font_row < font->height; font_row++)
+		{
+			mem_off = FB_ADDR_OFF(x, (y+font_row));
+			unsigned int offset =  mem_off;
+			unsigned char data  = *font_buf;
+
+			for (font_col = 0; font_col < font->width; font_col++)
+			{
+				if (data & 0x80)
+				{
+					if (xormode)
+					{
+						rd16 = RD_FB16(offset);
+						wr16 = m_color_map[coloridx] ^ rd16;
+					}
+					else
+					{
+                    	wr16 = m_color_map[coloridx];
+                    }
+					WR_FB16(offset, wr16);
+				}
+
+				offset += 2;
+				data <<= 1;
+			}
+
+			font_buf++;
+		}
+	}
+}
+
+/*
+ * ʾһ
+ */
+void fb_draw_gb2312_char(int x, int y, unsigned char *str)
+{
+	unsigned int    mem_off;
+	unsigned char  *temp_buf;
+	unsigned short *font_buf;
+	int             buflen;
+
+	if (str == NULL)
+	{
+    	return;
+    }
+
+	font_desc_t *font = get_font_desc((const unsigned char *)str, false);
+	if (font == NULL)
+	{
+    	return;
+    }
+
+	temp_buf = (unsigned char *)font->get_font_data((const unsigned char *)str, &buflen);
+	if (temp_buf == NULL)
+	{
+    	return;
+    }
+
+	unsigned int xormode = fb->fg_coloridx &  XORMODE;
+	unsigned int coloridx  = fb->fg_coloridx & ~XORMODE;
+
+	font_buf = (unsigned short *)temp_buf;
+
+	if (IN_BOUND(x, y) && IN_BOUND(x+font->width-1, y+font->height-1))
+	{
+		unsigned short wr16, rd16;
+		int font_row, font_col;
+
+		for (font_row = 0; font_row < font->height; font_row++)
+		{
+			mem_off             = FB_ADDR_OFF(x, (y+font_row));
+			unsigned int offset = mem_off;
+			unsigned short data = (*(unsigned char *)font_buf << 8) |
+                                  (*((unsigned char *)font_buf + 1));
+
+			for (font_col = 0; font_col < font->width; font_col++)
+			{
+				if (data & 0x8000)
+				{
+					if (xormode)
+					{
+						rd16 = RD_FB16(offset);
+						wr16 = m_color_map[coloridx] ^ rd16;
+					}
+					else
+					{
+                    	wr16 = m_color_map[coloridx];
+                    }
+					WR_FB16(offset, wr16);
+				}
+
+				offset += 2;
+				data <<= 1;
+			}
+
+			font_buf++;
+		}
+	}
+}
+
+/*
+ * ı
+ */
+void fb_textout(int x, int y, char *str)
+{
+	char *pch = str;
+	int   dx = 0;
+
+	if (fb->dc == NULL)
+	{
+		return;
+	}
+
+	while (*pch)
+	{
+		font_desc_t *ft_desc = get_font_desc((const unsigned char *)pch, false);
+
+		if (ft_desc != NULL)
+		{
+			ft_desc->draw_font(x + dx, y, (const unsigned char *)pch);
+
+			dx  += ft_desc->width + COL_GAP;
+			pch += ft_desc->get_char_size(NULL);
+		}
+		else
+		{
+			dx  += CONS_FONT_WIDTH + COL_GAP;
+			pch += 1;
+		}
+	}
+}
+
+/******************************************************************************
+ * FrameBuffer As Console Output
+ ******************************************************************************/
+
+#define FB_ADDR_ASC(r, c) ((((r)*fb->varInfo.xres*(CONS_FONT_HEIGHT+ROW_GAP))+ \
+						   ((c)*(CONS_FONT_WIDTH+COL_GAP)))*fb->bytes_per_pixel)
+
+/*
+ * ֻ̨дַӰӻ fb->cells, ¼ÿезΧ; ֻƶӰ
+ * Ļʼ cons_origin, ۼƵ pending_scroll.
+ *
+ * fb_cons_flush() ʱȰ framebuffer һ pending_scroll , ֻػ
+ * ַԪ. OS ʱɺ̨ VSync ˢ, ÿ֡һ;  OS ǰ
+ * ÿ fb_cons_putc()/fb_cons_puts() ǰˢ.
+ *
+ * 16 λɫʱַԪչõ RGB565 ģ밴 64 λд, ǰͱһд.
+ */
+
+#define FB_CELL_BLANK		0x0000		/* հ׵Ԫ */
+#define FB_CELL_WIDE_R		0xFFFF		/* ֵҰԪ */
+
+#define FB_CONS_FLUSH_MS	16			/* û VSync жʱˢ */
+
+#define FB_GLYPH_GB_CACHE	64			/* ģ, ֱӳ */
+
+#define FB_CONS_TASK_NAME	"FB_cons"
+#define FB_CONS_STK_SIZE	4096
+
+#if defined(OS_RTTHREAD)
+#define FB_CONS_TASK_PRIO		28
+#define FB_CONS_TASK_SLICE		10
+#elif defined(OS_UCOS)
+#define FB_CONS_TASK_PRIO		60
+#define FB_CONS_TASK_SLICE		10
+#elif defined(OS_FREERTOS)
+#define FB_CONS_TASK_PRIO		28
+#define FB_CONS_TASK_SLICE		0
+#else // Bare-Metal
+#define FB_CONS_TASK_PRIO		0
+#define FB_CONS_TASK_SLICE		0
+#endif
+
+typedef struct
+{
+	unsigned short ch;					/* ASCII  GB2312 (ֽڸ 8 λ) */
+	unsigned char  fg;					/* ǰɫ */
+	unsigned char  bg;					/* ɫ */
+} FB_CELL_t;
+
+typedef struct
+{
+	unsigned short lo;					/* зΧ, lo > hi ʾɾ */
+	unsigned short hi;
+} FB_DIRTY_t;
+
+/*
+ * չģ: ÿ 16 λ, Ϊ 1 Ϊ 0xFFFF
+ */
+typedef struct
+{
+	unsigned long mask[CONS_FONT_HEIGHT][2];				/* 8  */
+} FB_GLYPH_ASC_t;
+
+typedef struct
+{
+	unsigned short code;									/* 0: Ч */
+	unsigned long  mask[CONS_FONT_HEIGHT][4];				/* 16  */
+} FB_GLYPH_GB_t;
+
+typedef struct
+{
+	unsigned long  asc_valid[256/64];
+	FB_GLYPH_ASC_t asc[256];
+	FB_GLYPH_GB_t  gb[FB_GLYPH_GB_CACHE];
+} FB_GLYPH_CACHE_t;
+
+typedef struct
+{
+	FB_CELL_t    *cells;				/* Rows*Cols Ԫ, д */
+	FB_DIRTY_t   *dirty;				/* ÿезΧ */
+	FB_GLYPH_CACHE_t *glyphs;			/* 16 λɫʱģ */
+
+	unsigned int  origin;				/* Ļ 0 жӦ */
+	unsigned int  pending_scroll;		/* δƵĹ */
+	volatile int  dirty_any;
+
+	osal_mutex_t  mutex;
+	osal_task_t   task;
+} FB_CONS_t;
+
+static FB_CONS_t fb_cons;
+
+/*
+ * 4 λ(λ)չ 4  RGB565 
+ */
+#define EXPAND4(n)	((((n) & 8) ? 0x000000000000FFFFUL : 0) | \
+					 (((n) & 4) ? 0x00000000FFFF0000UL : 0) | \
+					 (((n) & 2) ? 0x0000FFFF00000000UL : 0) | \
+					 (((n) & 1) ? 0xFFFF000000000000UL : 0))
+
+static const unsigned long m_expand4[16] =
+{
+	EXPAND4(0),  EXPAND4(1),  EXPAND4(2),  EXPAND4(3),
+	EXPAND4(4),  EXPAND4(5),  EXPAND4(6),  EXPAND4(7),
+	EXPAND4(8),  EXPAND4(9),  EXPAND4(10), EXPAND4(11),
+	EXPAND4(12), EXPAND4(13), EXPAND4(14), EXPAND4(15),
+};
+
+#define CONS_LOCK()		do { if (fb_cons.mutex) osal_mutex_obtain(fb_cons.mutex, OSAL_WAIT_FOREVER); } while (0)
+#define CONS_UNLOCK()	do { if (fb_cons.mutex) osal_mutex_release(fb_cons.mutex); } while (0)
+
+#define CONS_ROW(r)		(fb_cons.cells + (((fb_cons.origin + (r)) % fb->Rows) * fb->Cols))
+#define CONS_DIRTY(r)	(fb_cons.dirty + ((fb_cons.origin + (r)) % fb->Rows))
+
+/*
+ * ԪַתΪֿʹõַ
+ */
+static int fb_cell_to_str(unsigned short ch, unsigned char *str)
+{
+	if (ch > 0xFF)
+	{
+		str[0] = ch >> 8;
+		str[1] = ch & 0xFF;
+		str[2] = 0;
+		return 2;
+	}
+
+	str[0] = ch;
+	str[1] = 0;
+	return 1;
+}
+
+/*
+ * ȡչģ. ûģʱ NULL, հ׵Ԫ
+ */
+static const unsigned long *fb_glyph_get(unsigned short ch)
+{
+	FB_GLYPH_CACHE_t *gc = fb_cons.glyphs;
+	unsigned long (*mask)[4];
+	unsigned char str[4], *font_buf;
+	font_desc_t *font;
+	int buflen, row, wide;
+
+	if ((ch == FB_CELL_BLANK) || (ch == ' '))
+	{
+		return NULL;
+	}
+
+	wide = (ch > 0xFF);
+
+	if (!wide)
+	{
+		if (gc->asc_valid[ch >> 6] & (1UL << (ch & 63)))
+		{
+			return &gc->asc[ch].mask[0][0];
+		}
+	}
+	else
+	{
+		FB_GLYPH_GB_t *g = &gc->gb[(ch ^ (ch >> 6)) & (FB_GLYPH_GB_CACHE - 1)];
+
+		if (g->code == ch)
+		{
+			return &g->mask[0][0];
+		}
+
+		g->code = 0;
+	}
+
+	fb_cell_to_str(ch, str);
+
+	font = get_font_desc(str, false);
+	if ((font == NULL) || (font->height != CONS_FONT_HEIGHT) ||
+		(font->width != (wide ? 2 : 1) * CONS_FONT_WIDTH))
+	{
+		return NULL;
+	}
+
+	font_buf = font->get_font_data(str, &buflen);
+	if (font_buf == NULL)
+	{
+		return NULL;
+	}
+
+	if (!wide)
+	{
+		FB_GLYPH_ASC_t *g = &gc->asc[ch];
+
+		for (row = 0; row < CONS_FONT_HEIGHT; row++)
+		{
+			g->mask[row][0] = m_expand4[font_buf[row] >> 4];
+			g->mask[row][1] = m_expand4[font_buf[row] & 0x0F];
+		}
+
+		gc->asc_valid[ch >> 6] |= 1UL << (ch & 63);
+		return &g->mask[0][0];
+	}
+
+	FB_GLYPH_GB_t *g = &gc->gb[(ch ^ (ch >> 6)) & (FB_GLYPH_GB_CACHE - 1)];
+
+	mask = g->mask;
+	for (row = 0; row < CONS_FONT_HEIGHT; row++)
+	{
+		mask[row][0] = m_expand4[font_buf[row*2] >> 4];
+		mask[row][1] = m_expand4[font_buf[row*2] & 0x0F];
+		mask[row][2] = m_expand4[font_buf[row*2+1] >> 4];
+		mask[row][3] = m_expand4[font_buf[row*2+1] & 0x0F];
+	}
+
+	g->code = ch;
+	return &mask[0][0];
+}
+
+/*
+ * 16 λɫ: ǰͱһ 64 λдһԪ. ռԪ
+ */
+static void fb_cons_draw_cell16(int row, int col, const FB_CELL_t *cell)
+{
+	const unsigned long *mask = fb_glyph_get(cell->ch);
+	unsigned long fg64 = fb_color64(m_color_map[cell->fg], 2);
+	unsigned long bg64 = fb_color64(m_color_map[cell->bg], 2);
+	int i, y, words = (cell->ch > 0xFF) ? 4 : 2;
+
+	y = row * (CONS_FONT_HEIGHT+ROW_GAP);
+
+	for (i = 0; i < CONS_FONT_HEIGHT; i++)
+	{
+		volatile unsigned long *p = (volatile unsigned long *)
+			(fb->lineAddr[y + i] + col * (CONS_FONT_WIDTH+COL_GAP) * 2);
+
+		if (mask == NULL)
+		{
+			p[0] = bg64;
+			p[1] = bg64;
+			if (words == 4)
+			{
+				p[2] = bg64;
+				p[3] = bg64;
+			}
+		}
+		else if (words == 2)
+		{
+			p[0] = (mask[0] & fg64) | (~mask[0] & bg64);
+			p[1] = (mask[1] & fg64) | (~mask[1] & bg64);
+			mask += 2;
+		}
+		else
+		{
+			p[0] = (mask[0] & fg64) | (~mask[0] & bg64);
+			p[1] = (mask[1] & fg64) | (~mask[1] & bg64);
+			p[2] = (mask[2] & fg64) | (~mask[2] & bg64);
+			p[3] = (mask[3] & fg64) | (~mask[3] & bg64);
+			mask += 4;
+		}
+	}
+}
+
+/*
+ * ɫ: 䱳ֿ
+ */
+static void fb_cons_draw_cell(int row, int col, const FB_CELL_t *cell)
+{
+	unsigned char str[4];
+	font_desc_t *font;
+	int i, x, y, width, fg_save;
+
+	x = col * (CONS_FONT_WIDTH+COL_GAP);
+	y = row * (CONS_FONT_HEIGHT+ROW_GAP);
+	width = ((cell->ch > 0xFF) ? 2 : 1) * (CONS_FONT_WIDTH+COL_GAP);
+
+	for (i = 0; i < CONS_FONT_HEIGHT+ROW_GAP; i++)
+	{
+		fb_fill_span(fb->lineAddr[y + i] + x * fb->bytes_per_pixel,
+					 width * fb->bytes_per_pixel,
+					 fb_color64(m_color_map[cell->bg], fb->bytes_per_pixel),
+					 0);
+	}
+
+	if ((cell->ch == FB_CELL_BLANK) || (cell->ch == ' '))
+	{
+		return;
+	}
+
+	fb_cell_to_str(cell->ch, str);
+
+	font = get_font_desc(str, false);
+	if (font != NULL)
+	{
+		fg_save = fb->fg_coloridx;
+		fb->fg_coloridx = cell->fg;
+		font->draw_font(x, y, str);
+		fb->fg_coloridx = fg_save;
+	}
+}
+
+/*
+ * Ļ row  [c1, c2] Ҫػ
+ */
+static void fb_cons_mark(unsigned int row, unsigned int c1, unsigned int c2)
+{
+	FB_DIRTY_t *d = CONS_DIRTY(row);
+
+	if (d->lo > c1) d->lo = c1;
+	if (d->hi < c2) d->hi = c2;
+
+	fb_cons.dirty_any = 1;
+}
+
+static void fb_cons_clear_row(unsigned int row)
+{
+	FB_CELL_t *cell = CONS_ROW(row);
+	unsigned int col;
+
+	for (col = 0; col < fb->Cols; col++)
+	{
+		cell[col].ch = FB_CELL_BLANK;
+		cell[col].fg = fb->fg_coloridx & 0xFF;
+		cell[col].bg = fb->bg_coloridx & 0xFF;
+	}
+
+	fb_cons_mark(row, 0, fb->Cols - 1);
+}
+
+/*
+ * дһԪ, ݲʱ
+ */
+static void fb_cons_set_cell(unsigned int row, unsigned int col, unsigned short ch)
+{
+	FB_CELL_t *cell = CONS_ROW(row) + col;
+	unsigned char fg = fb->fg_coloridx & 0xFF;
+	unsigned char bg = fb->bg_coloridx & 0xFF;
+
+	if ((cell->ch != ch) || (cell->fg != fg) || (cell->bg != bg))
+	{
+		cell->ch = ch;
+		cell->fg = fg;
+		cell->bg = bg;
+		fb_cons_mark(row, col, col);
+	}
+}
+
+/*
+ * : ֻƶӰӻʼ, framebuffer ˢʱһΰ
+ */
+static void fb_cons_scroll(void)
+{
+	fb->curRow++;
+
+	if (fb->curRow > (fb->Rows - 1))
+	{
+		fb_cons.origin = (fb_cons.origin + 1) % fb->Rows;
+		if (fb_cons.pending_scroll < fb->Rows)
+		{
+			fb_cons.pending_scroll++;
+		}
+
+		/* кŲ */
+		fb->curCol = 0;
+		fb->curRow--;
+		fb_cons_clear_row(fb->curRow);
+	}
+}
+
+/*
+ * Ӱӻı仯 framebuffer. ߳
+ */
+static void fb_cons_flush_locked(void)
+{
+	unsigned int row, col, lo, hi;
+	int fast;
+
+	if ((fb->dc == NULL) || (fb_cons.cells == NULL) || !fb_cons.dirty_any)
+	{
+		return;
+	}
+
+	if (fb_cons.pending_scroll >= fb->Rows)
+	{
+		for (row = 0; row < fb->Rows; row++)
+		{
+			fb_cons_mark(row, 0, fb->Cols - 1);
+		}
+	}
+	else if (fb_cons.pending_scroll > 0)
+	{
+		fb_copy_span((unsigned char *)fb->fixInfo.smem_start,
+					 (unsigned char *)fb->fixInfo.smem_start + FB_ADDR_ASC(fb_cons.pending_scroll, 0),
+					 FB_ADDR_ASC(fb->Rows - fb_cons.pending_scroll, 0));
+	}
+
+	fb_cons.pending_scroll = 0;
+	fb_cons.dirty_any = 0;
+
+	fast = (fb_cons.glyphs != NULL) && (fb->bytes_per_pixel == 2) &&
+		   !((unsigned long)fb->fixInfo.smem_start & 7) && !(fb->fixInfo.line_length & 7);
+
+	for (row = 0; row < fb->Rows; row++)
+	{
+		FB_DIRTY_t *d = CONS_DIRTY(row);
+		FB_CELL_t *cell = CONS_ROW(row);
+
+		if (d->lo > d->hi)
+		{
+			continue;
+		}
+
+		lo = d->lo;
+		hi = d->hi;
+		d->lo = 0xFFFF;
+		d->hi = 0;
+
+		/* Ӻм俪ʼ */
+		if ((lo > 0) && (cell[lo].ch == FB_CELL_WIDE_R))
+		{
+			lo--;
+		}
+
+		for (col = lo; col <= hi; col++)
+		{
+			if (cell[col].ch == FB_CELL_WIDE_R)
+			{
+				continue;
+			}
+
+			if (fast)
+				fb_cons_draw_cell16(row, col, &cell[col]);
+			else
+				fb_cons_draw_cell(row, col, &cell[col]);
+		}
+	}
+}
+
+/*
+ * ̨ˢ: ÿ VSync ˢһ
+ */
+static void fb_cons_flush_task(void *arg)
+{
+	for ( ; ; )
+	{
+		if (fb->dc == NULL)
+		{
+			osal_task_sleep(FB_CONS_FLUSH_MS);
+			continue;
+		}
+
+		ls2k_dc_ioctl(fb->dc, IOCTRL_DC_WAIT_VSYNC, (void *)(long)FB_CONS_FLUSH_MS);
+
+		if (fb_cons.dirty_any)
+		{
+			fb_cons_flush();
+		}
+	}
+}
+
+/*
+ * : OS ʱ̨, ˢ
+ */
+static void fb_cons_kick(void)
+{
+	if (osal_is_osrunning())
+	{
+		if (fb_cons.task == NULL)
+		{
+			fb_cons.task = osal_task_create(FB_CONS_TASK_NAME,
+											FB_CONS_STK_SIZE,
+											FB_CONS_TASK_PRIO,
+											FB_CONS_TASK_SLICE,
+											fb_cons_flush_task,
+											NULL);
+		}
+
+		if (fb_cons.task != NULL)
+		{
+			return;
+		}
+	}
+
+	fb_cons_flush_locked();
+}
+
+/*
+ * ѿ̨ framebuffer
+ */
+void fb_cons_flush(void)
+{
+	if (fb->dc == NULL)
+	{
+		return;
+	}
+
+	CONS_LOCK();
+	fb_cons_flush_locked();
+	CONS_UNLOCK();
+}
+
+/*
+ * console һַ, ߳
+ */
+static void fb_cons_putc_locked(char chr)
+{
+	unsigned char uch = (unsigned char)chr;
+
+	/* First parse the character to see if it printable or an acceptable
+	 * control character. */
+	switch (chr)
+	{
+		case '\r':
+			fb->curCol = 0;
+			return;
+
+		case '\n':
+			fb->curCol = 0;
+			fb_cons_scroll();
+			return;
+
+		case '\b':
+			if (fb->curCol > 0)
+			{
+				fb->curCol--;
+			}
+			else if (fb->curRow > 0)
+			{
+				fb->curRow--;
+				fb->curCol = fb->Cols - 1;
+			}
+
+			/* erase the character */
+			if (CONS_ROW(fb->curRow)[fb->curCol].ch == FB_CELL_WIDE_R)
+			{
+				fb_cons_set_cell(fb->curRow, fb->curCol - 1, FB_CELL_BLANK);
+			}
+			fb_cons_set_cell(fb->curRow, fb->curCol, FB_CELL_BLANK);
+			break;
+
+		default:
+			/* drop anything we can't print */
+			if (get_font_desc(&uch, false) == NULL)
+			{
+            	return;
+            }
+
+			/* Ǻֵһʱ */
+			if (CONS_ROW(fb->curRow)[fb->curCol].ch == FB_CELL_WIDE_R)
+			{
+				fb_cons_set_cell(fb->curRow, fb->curCol - 1, FB_CELL_BLANK);
+			}
+			else if ((CONS_ROW(fb->curRow)[fb->curCol].ch > 0xFF) && (fb->curCol + 1 < fb->Cols))
+			{
+				fb_cons_set_cell(fb->curRow, fb->curCol + 1, FB_CELL_BLANK);
+			}
+
+			fb_cons_set_cell(fb->curRow, fb->curCol, uch);
+
+			/* advance to next column */
+			fb->curCol++;
+			if (fb->curCol == fb->Cols)
+			{
+				fb->curCol = 0;
+				fb_cons_scroll();
+			}
+
+			break;
+	}
+}
+
+/*
+ * console һַ
+ */
+void fb_cons_putc(char chr)
+{
+	if ((fb->dc == NULL) || (fb_cons.cells == NULL))
+	{
+    	return;
+    }
+
+	CONS_LOCK();
+	fb_cons_putc_locked(chr);
+	fb_cons_kick();
+	CONS_UNLOCK();
+}
+
+/*
+ * һַ
+ */
+void fb_cons_puts(char *str)
+{
+	char *pch = str;
+
+	if ((fb->dc == NULL) || (fb_cons.cells == NULL))
+	{
+    	return;
+    }
+
+	CONS_LOCK();
+
+	while (*pch)
+	{
+		if (!(*pch & 0x80))
+		{
+			fb_cons_putc_locked(*pch++);
+		}
+
+		/**************************************************
+		 * gb2312 charset display.
+		 */
+		else
+		{
+			font_desc_t *ft_desc = get_font_desc((const unsigned char *)pch, false);
+			if ((ft_desc != NULL) && (pch[1] != 0))
+			{
+				if ((fb->Cols - fb->curCol) < 2)
+				{
+					fb->curCol = 0;
+					fb_cons_scroll();
+				}
+
+				/* ʾһ */
+				if (CONS_ROW(fb->curRow)[fb->curCol].ch == FB_CELL_WIDE_R)
+				{
+					fb_cons_set_cell(fb->curRow, fb->curCol - 1, FB_CELL_BLANK);
+				}
+				if ((fb->curCol + 2 < fb->Cols) && (CONS_ROW(fb->curRow)[fb->curCol + 2].ch == FB_CELL_WIDE_R))
+				{
+					fb_cons_set_cell(fb->curRow, fb->curCol + 2, FB_CELL_BLANK);
+				}
+
+				fb_cons_set_cell(fb->curRow, fb->curCol,
+								 ((unsigned char)pch[0] << 8) | (unsigned char)pch[1]);
+				fb_cons_set_cell(fb->curRow, fb->curCol + 1, FB_CELL_WIDE_R);
+
+				fb->curCol += 2;
+				if (fb->curCol == fb->Cols)
+				{
+					fb->curCol = 0;
+					fb_cons_scroll();
+				}
+			}
+			else
+			{
+				fb_cons_putc_locked('?');
+				fb_cons_putc_locked('?');
+			}
+
+			pch += (pch[1] != 0) ? 2 : 1;
+		}
+	}
+
+	fb_cons_kick();
+
+	CONS_UNLOCK();
+}
+
+/*
+ * ӰӻȫΪհ, ػ
+ */
+static void fb_cons_reset(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < fb->Rows * fb->Cols; i++)
+	{
+		fb_cons.cells[i].ch = FB_CELL_BLANK;
+		fb_cons.cells[i].fg = fb->fg_coloridx & 0xFF;
+		fb_cons.cells[i].bg = fb->bg_coloridx & 0xFF;
+	}
+
+	for (i = 0; i < fb->Rows; i++)
+	{
+		fb_cons.dirty[i].lo = 0xFFFF;
+		fb_cons.dirty[i].hi = 0;
+	}
+
+	fb_cons.origin = 0;
+	fb_cons.pending_scroll = 0;
+	fb_cons.dirty_any = 0;
+}
+
+/*
+ * Ļ
+ */
+void fb_cons_clear(void)
+{
+	if (fb->dc == NULL)
+	{
+		return;
+	}
+
+	CONS_LOCK();
+
+	fb_fill_span((unsigned char *)fb->fixInfo.smem_start,
+				 fb->varInfo.xres * fb->varInfo.yres * fb->bytes_per_pixel,
+				 fb_color64(m_color_map[fb->bg_coloridx], fb->bytes_per_pixel),
+				 0);
+
+	/* ĻѾǿհ, Ӱӻ岻Ҫػ */
+	if (fb_cons.cells != NULL)
+	{
+		fb_cons_reset();
+	}
+
+	CONS_UNLOCK();
+}
+
+/*
+ * ̨Ӱӻ
+ */
+static int fb_cons_open(void)
+{
+	fb_cons.cells  = malloc(sizeof(FB_CELL_t) * fb->Rows * fb->Cols);
+	fb_cons.dirty  = malloc(sizeof(FB_DIRTY_t) * fb->Rows);
+	fb_cons.glyphs = NULL;
+
+	if ((fb_cons.cells == NULL) || (fb_cons.dirty == NULL))
+	{
+		return -1;
+	}
+
+	/* ģֻ 16 λɫʱʹ, 䲻ʱ */
+	if (fb->bytes_per_pixel == 2)
+	{
+		fb_cons.glyphs = calloc(1, sizeof(FB_GLYPH_CACHE_t));
+	}
+
+	if (fb_cons.mutex == NULL)
+	{
+		fb_cons.mutex = osal_mutex_create("FBCons", OSAL_OPT_FIFO);
+	}
+
+	/* ʱĻе */
+	fb_cons_reset();
+
+	return 0;
+}
+
+static void fb_cons_close(void)
+{
+	CONS_LOCK();
+
+	free(fb_cons.cells);
+	free(fb_cons.dirty);
+	free(fb_cons.glyphs);
+
+	fb_cons.cells  = NULL;
+	fb_cons.dirty  = NULL;
+	fb_cons.glyphs = NULL;
+
+	CONS_UNLOCK();
+}
+
+/******************************************************************************
+ * Frame Simple Graphics Functions
+ ******************************************************************************/
+
+union multiptr
+{
+	unsigned char  *p8;
+	unsigned short *p16;
+	unsigned int   *p32;
+};
+
+int fb_is_opened(void)
+{
+    return (fb->dc != NULL) ? 1 : 0;
+}
+
+/*
+ * open the framebuffer
+ */
+int fb_open(void)
+{
+	unsigned y, off;
+
+	/* already open? */
+	if (fb->dc != NULL)
+	{
+    	return 0;
+    }
+
+	/* not Initialized? */
+	if (ls2k_dc_init(devDC0, NULL) != 0)
+    {
+        return -1;
+    }
+
+    if (ls2k_dc_open(devDC0, NULL) != 0)
+    {
+        return -1;
+    }
+
+    fb->dc = (void *)devDC0;
+
+    ls2k_dc_ioctl(devDC0, FBIOGET_FSCREENINFO, &fb->fixInfo);
+    ls2k_dc_ioctl(devDC0, FBIOGET_VSCREENINFO, &fb->varInfo);
+
+	fb->fg_coloridx = 15;
+	fb->bytes_per_pixel = (int)(fb->varInfo.bits_per_pixel + 7) / 8;
+	fb->Rows = (CONS_FONT_HEIGHT>0) ? (fb->varInfo.yres/(CONS_FONT_HEIGHT+ROW_GAP)) : 8;
+	fb->Cols = (CONS_FONT_WIDTH>0)  ? (fb->varInfo.xres/(CONS_FONT_WIDTH+COL_GAP))  : 8;
+
+	fb->lineAddr = malloc(sizeof(uintptr_t) * fb->varInfo.yres);
+
+	if (fb->lineAddr == NULL)
+	{
+		fb_close();
+		return -1;
+	}
+
+	off = 0;
+	for (y = 0; y < fb->varInfo.yres; y++, off += fb->fixInfo.line_length)
+	{
+    	fb->lineAddr[y] = (void *)fb->fixInfo.smem_start + off;
+    }
+
+	if (fb_cons_open() != 0)
+	{
+		fb_close();
+		return -1;
+	}
+
+    DBG_OUT("framebuffer open successful.\r\n");
+
+	return 0;
+}
+
+/*
+ * ʾǰͼ, ֮ĻͼµĻͼϽ.
+ * ʱֻȴ VSync.
+ *
+ * :    wait    1=ȴлЧ󷵻
+ */
+int fb_flip(int wait)
+{
+	unsigned y, off;
+	int rt;
+
+	if (fb->dc == NULL)
+	{
+		return -1;
+	}
+
+	rt = ls2k_dc_ioctl(fb->dc, IOCTRL_DC_FLIP, (void *)(long)wait);
+	if (rt < 0)
+	{
+		return rt;
+	}
+
+	/* ̨ˢͬʱھɻϻ */
+	CONS_LOCK();
+
+	ls2k_dc_ioctl(fb->dc, FBIOGET_FSCREENINFO, &fb->fixInfo);
+
+	off = 0;
+	for (y = 0; y < fb->varInfo.yres; y++, off += fb->fixInfo.line_length)
+	{
+    	fb->lineAddr[y] = (void *)fb->fixInfo.smem_start + off;
+    }
+
+	CONS_UNLOCK();
+
+	return rt;
+}
+
+void fb_close(void)
+{
+	if (fb->dc != NULL)
+	{
+		ls2k_dc_close(fb->dc, NULL);
+
+		fb_cons_close();
+
+        free(fb->lineAddr);
+
+		fb->dc = NULL;
+	}
+}
+
+/*
+ * draw on framebuffer
+ */
+void fb_put_cross(int x, int y, unsigned coloridx)
+{
+	fb_drawline(x - 10, y, x - 2, y, coloridx);
+	fb_drawline(x + 2, y, x + 10, y, coloridx);
+	fb_drawline(x, y - 10, x, y - 2, coloridx);
+	fb_drawline(x, y + 2, x, y + 10, coloridx);
+	fb_drawline(x - 6, y - 9, x - 9, y - 9, coloridx + 1);
+	fb_drawline(x - 9, y - 8, x - 9, y - 6, coloridx + 1);
+	fb_drawline(x - 9, y + 6, x - 9, y + 9, coloridx + 1);
+	fb_drawline(x - 8, y + 9, x - 6, y + 9, coloridx + 1);
+	fb_drawline(x + 6, y + 9, x + 9, y + 9, coloridx + 1);
+	fb_drawline(x + 9, y + 8, x + 9, y + 6, coloridx + 1);
+	fb_drawline(x + 9, y - 6, x + 9, y - 9, coloridx + 1);
+	fb_drawline(x + 8, y - 9, x + 6, y - 9, coloridx + 1);
+}
+
+void fb_put_string(int x, int y, char *str, unsigned coloridx)
+{
+	unsigned int saved_coloridx = fb->fg_coloridx;
+	fb->fg_coloridx = coloridx;
+	fb_textout(x, y, str);
+	fb->fg_coloridx = saved_coloridx;
+}
+
+void fb_put_string_center(int x, int y, char *str, unsigned coloridx)
+{
+	x -= strlen(str) * CONS_FONT_WIDTH  / 2;
+	y -= CONS_FONT_HEIGHT / 2;
+	fb_put_string(x, y, str, coloridx);
+}
+
+void fb_set_color(unsigned coloridx, unsigned value)
+{
+	unsigned int res;
+	unsigned short red, green, blue;
+	struct fb_cmap cmap;
+
+	switch (fb->bytes_per_pixel)
+	{
+		default:
+		case 1:
+			res   = coloridx;
+			red   = (value >> 8) & 0xFF00;
+			green = value & 0xFF00;
+			blue  = (value << 8) & 0xFF00;
+			cmap.start  = coloridx;
+			cmap.len    = 1;
+			cmap.red    = &red;
+			cmap.green  = &green;
+			cmap.blue   = &blue;
+			cmap.transp = NULL;
+			ls2k_dc_ioctl(fb->dc, FBIOPUTCMAP, &cmap);
+			break;
+
+		case 2:
+		case 3:
+		case 4:
+			red   = (value >> 16) & 0xFF;
+			green = (value >>  8) & 0xFF;
+			blue  = value & 0xFF;
+			res   = ((red   >> (8 - fb->varInfo.red.length))   << fb->varInfo.red.offset)   |
+				    ((green >> (8 - fb->varInfo.green.length)) << fb->varInfo.green.offset) |
+				    ((blue  >> (8 - fb->varInfo.blue.length))  << fb->varInfo.blue.offset);
+			break;
+	}
+
+	m_color_map[coloridx] = res;
+}
+
+unsigned fb_get_color(unsigned coloridx)
+{
+	if (coloridx < 255)
+	{
+    	return m_color_map[coloridx];
+    }
+
+    return 0;
+}
+
+void fb_set_bgcolor(unsigned coloridx, unsigned value)
+{
+	fb->bg_coloridx = coloridx;
+	fb_set_color(coloridx & ~XORMODE, value);
+}
+
+void fb_set_fgcolor(unsigned coloridx, unsigned value)
+{
+	fb->fg_coloridx = coloridx;
+	fb_set_color(coloridx & ~XORMODE, value);
+}
+
+static void fb_set_pixel_internal(union multiptr loc, unsigned xormode, unsigned color)
+{
+	switch (fb->bytes_per_pixel)
+	{
+		case 1:
+		default:
+			if (xormode)
+            	*loc.p8 ^= color;
+			else
+            	*loc.p8  = color;
+			break;
+
+		case 2:
+			if (xormode)
+            	*loc.p16 ^= color;
+			else
+            	*loc.p16  = color;
+			break;
+
+		case 3:
+			if (xormode)
+			{
+				*loc.p8++ ^= (color >> 16) & 0xFF;
+				*loc.p8++ ^= (color >>  8) & 0xFF;
+				*loc.p8   ^= color & 0xFF;
+			}
+			else
+			{
+				*loc.p8++ = (color >> 16) & 0xFF;
+				*loc.p8++ = (color >>  8) & 0xFF;
+				*loc.p8   = color & 0xFF;
+			}
+			break;
+
+		case 4:
+			if (xormode)
+            	*loc.p32 ^= color;
+			else
+            	*loc.p32  = color;
+			break;
+	}
+}
+
+void fb_drawpixel(int x, int y, unsigned coloridx)
+{
+	unsigned xormode = 0;
+	union multiptr loc;
+
+	if ((x < 0) || ((unsigned int)x >= fb->varInfo.xres) ||
+	    (y < 0) || ((unsigned int)y >= fb->varInfo.yres))
+	{
+    	return;
+    }
+
+	xormode = coloridx & XORMODE;
+	coloridx &= ~XORMODE;
+
+	loc.p8 = fb->lineAddr[y] + x * fb->bytes_per_pixel;
+	fb_set_pixel_internal(loc, xormode, m_color_map[coloridx]);
+}
+
+void fb_drawpoint(int x, int y, int thickness, unsigned coloridx)
+{
+	if (thickness == 1)
+	{
+		fb_drawpixel(x, y, coloridx);
+	}
+	else
+	{
+		fb_drawpixel(x, y, coloridx);
+		fb_drawpixel(x, y - 1, coloridx);
+		fb_drawpixel(x, y + 1, coloridx);
+		fb_drawpixel(x - 1, y, coloridx);
+		fb_drawpixel(x + 1, y, coloridx);
+	}
+}
+
+void fb_drawline(int x1, int y1, int x2, int y2, unsigned coloridx)
+{
+	int tmp;
+	int dx = x2 - x1;
+	int dy = y2 - y1;
+
+	if (abs(dx) < abs(dy))
+	{
+		if (y1 > y2)
+		{
+			tmp = x1; x1 = x2; x2 = tmp;
+			tmp = y1; y1 = y2; y2 = tmp;
+			dx = -dx; dy = -dy;
+		}
+		x1 <<= 16;
+
+		/* dy is apriori >0 */
+		dx = (dx << 16) / dy;
+		while (y1 <= y2)
+		{
+			fb_drawpixel(x1 >> 16, y1, coloridx);
+			x1 += dx;
+			y1++;
+		}
+	}
+	else
+	{
+		if (x1 > x2)
+		{
+			tmp = x1; x1 = x2; x2 = tmp;
+			tmp = y1; y1 = y2; y2 = tmp;
+			dx = -dx; dy = -dy;
+		}
+		y1 <<= 16;
+
+		dy = dx ? (dy << 16) / dx : 0;
+		while (x1 <= x2)
+		{
+			fb_drawpixel(x1, y1 >> 16, coloridx);
+			y1 += dy;
+			x1++;
+		}
+	}
+}
+
+void fb_drawrect(int x1, int y1, int x2, int y2, unsigned coloridx)
+{
+	fb_drawline(x1, y1, x2, y1, coloridx);
+	fb_drawline(x2, y1, x2, y2, coloridx);
+	fb_drawline(x2, y2, x1, y2, coloridx);
+	fb_drawline(x1, y2, x1, y1, coloridx);
+}
+
+void fb_fillrect(int x1, int y1, int x2, int y2, unsigned coloridx)
+{
+	int tmp;
+	unsigned xormode;
+	union multiptr loc;
+
+	/* Clipping and sanity checking */
+	if (x1 > x2) { tmp = x1; x1 = x2; x2 = tmp; }
+	if (y1 > y2) { tmp = y1; y1 = y2; y2 = tmp; }
+	if (x1 < 0) { x1 = 0; } if ((unsigned int)x1 >= fb->varInfo.xres) { x1 = fb->varInfo.xres - 1; }
+	if (x2 < 0) { x2 = 0; } if ((unsigned int)x2 >= fb->varInfo.xres) { x2 = fb->varInfo.xres - 1; }
+	if (y1 < 0) { y1 = 0; } if ((unsigned int)y1 >= fb->varInfo.yres) { y1 = fb->varInfo.yres - 1; }
+	if (y2 < 0) { y2 = 0; } if ((unsigned int)y2 >= fb->varInfo.yres) { y2 = fb->varInfo.yres - 1; }
+
+	if ((x1 > x2) || (y1 > y2))
+	{
+    	return;
+    }
+
+	xormode = coloridx & XORMODE;
+	coloridx &= ~XORMODE;
+
+	coloridx = m_color_map[coloridx];
+
+	/*
+	 * 1/2/4 ֽذ
+	 */
+	if (fb->bytes_per_pixel != 3)
+	{
+		unsigned long c64 = fb_color64(coloridx, fb->bytes_per_pixel);
+		size_t bytes = (x2 - x1 + 1) * fb->bytes_per_pixel;
+
+		for ( ; y1 <= y2; y1++)
+		{
+			fb_fill_span(fb->lineAddr[y1] + x1 * fb->bytes_per_pixel, bytes, c64, xormode);
+		}
+
+		return;
+	}
+
+	for ( ; y1 <= y2; y1++)
+	{
+		loc.p8 = fb->lineAddr[y1] + x1 * fb->bytes_per_pixel;
+		for (tmp = x1; tmp <= x2; tmp++)
+		{
+			fb_set_pixel_internal(loc, xormode, coloridx);
+			loc.p8 += fb->bytes_per_pixel;
+		}
+	}
+}
+
+/*
+ * ü, ʹ [x1, x2]  [x1+dx, x2+dx]  [0, size-1] ֮
+ */
+static inline void fb_clip_range(int *x1, int *x2, int dx, int size)
+{
+	if (*x1 < 0)         *x1 = 0;
+	if (*x1 < -dx)       *x1 = -dx;
+	if (*x2 >= size)     *x2 = size - 1;
+	if (*x2 >= size - dx) *x2 = size - dx - 1;
+}
+
+/*
+ * copy rectangle to point
+ *
+ * ԴĿصʱ, Ŀ·һпʼ; ͬһ fb_copy_span()
+ * ֤صȷ.
+ */
+void fb_copyrect(int x1, int y1, int x2, int y2, int px, int py)
+{
+	int tmp, dx, dy, y;
+	size_t bytes;
+
+	if (x1 > x2) { tmp = x1; x1 = x2; x2 = tmp; }
+	if (y1 > y2) { tmp = y1; y1 = y2; y2 = tmp; }
+
+	dx = px - x1;
+	dy = py - y1;
+
+    /* if same, do nothing */
+	if ((dx == 0) && (dy == 0))
+	{
+		return;
+	}
+
+	fb_clip_range(&x1, &x2, dx, (int)fb->varInfo.xres);
+	fb_clip_range(&y1, &y2, dy, (int)fb->varInfo.yres);
+
+	if ((x1 > x2) || (y1 > y2))
+	{
+		return;
+	}
+
+	bytes = (x2 - x1 + 1) * fb->bytes_per_pixel;
+
+	if (dy > 0)
+	{
+		for (y = y2; y >= y1; y--)
+		{
+			fb_copy_span(fb->lineAddr[y + dy] + (x1 + dx) * fb->bytes_per_pixel,
+						 fb->lineAddr[y] + x1 * fb->bytes_per_pixel, bytes);
+		}
+	}
+	else
+	{
+		for (y = y1; y <= y2; y++)
+		{
+			fb_copy_span(fb->lineAddr[y + dy] + (x1 + dx) * fb->bytes_per_pixel,
+						 fb->lineAddr[y] + x1 * fb->bytes_per_pixel, bytes);
+		}
+	}
+}
+
+/*
+ * ڴ framebuffer ͬظʽͼƵ LCD[x,y] 
+ *
+ * :    src     ͼ׵ַ
+ *          w, h    ͼ, 
+ *          pitch   ͼÿֽ
+ */
+void fb_blit(int x, int y, const void *src, int w, int h, int pitch)
+{
+	const unsigned char *p = (const unsigned char *)src;
+	int x1 = x, x2 = x + w - 1, y1 = y, y2 = y + h - 1;
+	size_t bytes;
+
+	/* ü: Դͼԭŵ [x,y] */
+	fb_clip_range(&x1, &x2, 0, (int)fb->varInfo.xres);
+	fb_clip_range(&y1, &y2, 0, (int)fb->varInfo.yres);
+
+	if ((src == NULL) || (x1 > x2) || (y1 > y2))
+	{
+		return;
+	}
+
+	p += (y1 - y) * pitch + (x1 - x) * fb->bytes_per_pixel;
+	bytes = (x2 - x1 + 1) * fb->bytes_per_pixel;
+
+	for ( ; y1 <= y2; y1++, p += pitch)
+	{
+		fb_copy_span(fb->lineAddr[y1] + x1 * fb->bytes_per_pixel, p, bytes);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+
+/******************************************************************************
+ * ʾ BMP ͼ
+ ******************************************************************************/
+
+/*
+ * BMP ļʽ
+ */
+
+/* ļͷṹ - 14byte
+ */
+typedef struct
+{
+	char cfType[2];         	/* ļ, Ϊ "BM" (0x4D42)*/
+	char cfSize[4];        		/* ļĴС(ֽ) */
+	char cfReserved[4];     	/* , Ϊ 0 */
+	char cfoffBits[4];      	/* λͼļͷƫ(ֽ)*/
+} __attribute__((packed)) BITMAPFILEHEADER;
+
+/* λͼϢͷṹ - 40byte
+ */
+typedef struct
+{
+	char ciSize[4];         	/* size of BITMAPINFOHEADER */
+	char ciWidth[4];        	/* λͼ() */
+	char ciHeight[4];       	/* λͼ߶() */
+	char ciPlanes[2];       	/* Ŀ豸λƽ, Ϊ1 */
+	char ciBitCount[2];     	/* ÿصλ, 1,4,8,1624 */
+	char ciCompress[4];     	/* λͼеѹ,0=ѹ */
+	char ciSizeImage[4];    	/* ͼС(ֽ) */
+	char ciXPelsPerMeter[4];	/* Ŀ豸ˮƽÿظ */
+	char ciYPelsPerMeter[4];	/* Ŀ豸ֱÿظ */
+	char ciClrUsed[4];      	/* λͼʵʹõɫɫ */
+	char ciClrImportant[4]; 	/* Ҫɫĸ */
+} __attribute__((packed)) BITMAPINFOHEADER;
+
+/*  - 5551
+ */
+typedef struct
+{
+	unsigned short blue:  5;
+	unsigned short green: 5;
+	unsigned short red:   5;
+	unsigned short rev:   1;
+} __attribute__((packed)) PIXEL;
+
+/* 
+ */
+static BITMAPFILEHEADER	FileHead;
+static BITMAPINFOHEADER	InfoHead;
+
+/*
+ * ַת
+ */
+static long chartolong(char *str, int length)
+{
+	long number = 0;
+
+	if ((length > 0) && (length <= 4))
+	{
+		memcpy((void *)&number, (void *)str, length);
+	}
+
+	return number;
+}
+
+/*
+ * ļװʾ BMP ͼ
+ */
+static int fb_showbmp_internal(int x, int y, char *bmpfilename)
+{
+	FILE *fd;
+	int rt, row, ciBitCount, ciWidth, ciHeight;
+	unsigned int BytesPerLine;
+    unsigned long addr;
+	unsigned char *bmpbuf, *buf;
+
+	/******************************************************
+	 * λͼļ
+	 ******************************************************/
+
+	fd = fopen(bmpfilename, "r");
+	if (fd == NULL)
+	{
+		printk("can't open file %s!\r\n", bmpfilename);
+		return -1;
+	}
+
+	/* ȡλͼļͷ */
+    rt = fread((char *)&FileHead, 1, sizeof(BITMAPFILEHEADER), fd);
+	if (rt != sizeof(BITMAPFILEHEADER))
+	{
+		printk("read BMP header error, %s!\r\n", bmpfilename);
+        fclose(fd);
+		return -2;
+	}
+
+	/* жλͼ */
+	if (memcmp(FileHead.cfType, "BM", 2) != 0)
+	{
+		printk("%s is not a BMP file\r\n", bmpfilename);
+        fclose(fd);
+		return -3;
+	}
+
+	/* ȡλͼϢͷ */
+	rt = fread((char *)&InfoHead, 1, sizeof(BITMAPINFOHEADER), fd);
+	if (rt != sizeof(BITMAPINFOHEADER))
+	{
+		printk("read BMP infoheader error, %s!\r\n", bmpfilename);
+        fclose(fd);
+		return -4;
+	}
+
+	ciWidth    = (int)chartolong(InfoHead.ciWidth,    4);
+	ciHeight   = (int)chartolong(InfoHead.ciHeight,   4);
+	ciBitCount = (int)chartolong(InfoHead.ciBitCount, 2);
+
+	if (16 != ciBitCount)
+	{
+		printk("bmp is not 16 bits per pixel. (%d)\r\n", ciBitCount);
+        fclose(fd);
+		return -5;
+	}
+
+    fseek(fd, (int)chartolong(FileHead.cfoffBits, 4), SEEK_SET);
+	BytesPerLine = (ciWidth * ciBitCount + 31) / 32 * 4;
+
+	/******************************************************
+	 * 洢ȫصڴ - ļ
+	 ******************************************************/
+
+	bmpbuf = (unsigned char *)malloc(BytesPerLine*ciHeight);
+	if (NULL == bmpbuf)
+	{
+		printk("no memory to load bmp, size=%i.\r\n", (int)BytesPerLine*ciHeight);
+        fclose(fd);
+		return -6;
+	}
+
+	/* ȫ */
+    rt = fread(bmpbuf, 1, BytesPerLine*ciHeight, fd);
+	if (rt < BytesPerLine*ciHeight)
+	{
+		printk("load bmp to memory error, size=%i.\r\n", (int)BytesPerLine*ciHeight);
+		free(bmpbuf);
+        fclose(fd);
+		return -7;
+	}
+
+	/**************************************************************************
+	 * ʼ
+	 **************************************************************************/
+
+	buf = bmpbuf;
+
+	for (row=ciHeight - 1; row >=0; row--)
+	{
+		PIXEL    *pix;
+		unsigned short val;
+		unsigned int col, datalen, colend;
+		unsigned int curx, cury;
+
+		/* һ */
+		pix = (PIXEL *)buf;
+		for (col=0; col<ciWidth; col++)
+		{
+			val = (pix->red << 11) | (pix->green << 6) | pix->blue;
+			*((unsigned short *)pix) = val;
+			pix++;
+		}
+
+		curx = x;
+		cury = y + row;
+		if ((curx>=0) && (curx<fb->varInfo.xres) && (cury>=0) && (cury<fb->varInfo.yres))
+		{
+			/* ݳȺĿĵַ */
+			colend = ((fb->varInfo.xres-1) <= (curx+ciWidth)) ? (fb->varInfo.xres-1) : (curx+ciWidth);
+			datalen = (colend - curx) * fb->bytes_per_pixel;
+			addr = (unsigned long)fb->fixInfo.smem_start +
+                   (curx + cury * fb->varInfo.xres) * fb->bytes_per_pixel;
+
+			/* һ */
+			memcpy((void *)addr, (void *)buf, datalen);
+		}
+
+		buf += BytesPerLine;
+	}
+
+	free(bmpbuf);
+
+    fclose(fd);
+
+	return 0;
+}
+
+int fb_showbmp(int x, int y, char *bmpfilename)
+{
+	if (fb->dc != NULL)
+	{
+    	return fb_showbmp_internal(x, y, bmpfilename);
+    }
+	else
+	{
+    	return -1;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+#ifdef USE_LVGL
+
+void ls2k_draw_rgb565_pixel(int x, int y, unsigned int color)
+{
+    uintptr_t fbAddr;
+
+    fbAddr = (uintptr_t)fb->lineAddr[y] + x * fb->bytes_per_pixel;
+
+    *((unsigned short *)fbAddr) = color;
+}
+
+#endif
+
+#endif // #ifdef BSP_USE_FB
+
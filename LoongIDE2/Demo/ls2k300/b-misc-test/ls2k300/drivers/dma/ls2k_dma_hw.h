@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_dma_hw.h
+ *
+ * created: 2024-06-11
+ *  author: Bian
+ */
+
+#ifndef _LS2K_DMA_HW_H
+#define _LS2K_DMA_HW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// DMA 豸
+//-------------------------------------------------------------------------------------------------
+
+#define DMA_BASE        0x1612c000
+
+#define CHNL_COUNT      8
+
+/*
+ * DMA 
+ */
+typedef struct
+{
+	volatile unsigned int isr;				/* 0x00 DMA_ISR DMA ж״̬Ĵ */
+	volatile unsigned int iclr;				/* 0x04 DMA_IFCR DMA жϱ־Ĵ */
+
+	struct
+	{
+		volatile unsigned int ccr;			/* 0x08 DMA_CCR DMA ͨüĴ */
+		volatile unsigned int cndtr;		/* 0x0c DMA_CNDTR DMA ͨĴ */
+		volatile unsigned int cpar;			/* 0x10 DMA_CPAR DMA ַͨĴ */
+		volatile unsigned int cmar;			/* 0x14 DMA_CMAR DMA ַͨĴ */
+		volatile unsigned int rsv;			// 0x18
+	} Channels[CHNL_COUNT];
+
+} HW_DMA_t;
+
+
+/**
+ * DMA ж״̬Ĵ(DMA_ISR)
+ *
+ * ƫ:  0x00
+ */
+#define DMA_ISR_TEIF(x)			bit(1<<(4*(x)+3))	/* R ͨx ־. 0: ͨx ޴¼; 1: ͨx д¼. */
+#define DMA_ISR_HTIF(x)			bit(1<<(4*(x)+2))	/* R ͨx ־. 0: ͨx ޴¼; 1: ͨx д¼.
+ 	 	 	 	 	 	 	 	 	 	 	 	 	 * ע: ñ־λڴΪżʱЧ. */
+#define DMA_ISR_TCIF(x)			bit(1<<(4*(x)+1))	/* R ͨx ɱ־. 0: ͨx ޴¼; 1: ͨx д¼. */
+#define DMA_ISR_GIF(x)			bit(1<<(4*(x)+0))	/* R ͨx ȫжϱ־. 0: ͨx ޴//¼; 1: ͨx д//¼. */
+
+//----------------------
+// λұߺ SR
+//----------------------
+
+#define DMA_ISR_TE 			    bit(3)
+#define DMA_ISR_HT 			    bit(2)
+#define DMA_ISR_TC 		        bit(1)
+#define DMA_ISR_G 			    bit(0)
+
+/**
+ * DMA жϱ־Ĵ(DMA_IFCR)
+ *
+ * ƫ:  0x04
+ */
+#define DMA_ICLR_CTEIF(x)		bit(1<<(4*(x)+3))	/* RW ͨx ־. 0: Ч; 1: DMA_ISR ĴжӦĴ¼־. */
+#define DMA_ICLR_CHTIF(x)		bit(1<<(4*(x)+2))	/* RW ͨx ־. 0: Ч; 1: DMA_ISR ĴжӦĴ¼־. */
+#define DMA_ICLR_CTCIF(x)		bit(1<<(4*(x)+1))	/* RW ͨx ɱ־. 0: Ч; 1: DMA_ISR ĴжӦĴ¼־. */
+#define DMA_ICLR_CGIF(x)		bit(1<<(4*(x)+0))	/* RW ͨx ȫжϱ־. 0: Ч; 1: DMA_ISR ĴжӦĴ//¼־. */
+
+/**
+ * DMA ͨx üĴ(DMA_CCRx)
+ *
+ * ƫ:  0x08 + 0x14*x
+ */
+
+#define DMA_CCR_MEM2MEM			bit(14)			/* RW 洢洢ģʽ, λú.
+												 * 0: Ǵ洢(豸)洢(ڴ)ģʽ;
+												 * 1: 洢(ڴ)洢(ڴ)ģʽ.
+												 */
+#define DMA_CCR_PL_MASK			(0x03<<12)		/* RW bit[13:12] ͨȼ, λú. */
+#define DMA_CCR_PL_SHIFT		12
+#define DMA_CCR_PL_LOW			0
+#define DMA_CCR_PL_MID			1
+#define DMA_CCR_PL_HIGH			2
+#define DMA_CCR_PL_HIGHEST		3
+
+#define DMA_CCR_MSIZE_MASK		(0x03<<10)		/* RW bit[11:10] 洢ݿ, λú. */
+#define DMA_CCR_MSIZE_SHIFT		10
+#define DMA_CCR_MSIZE_8b		0
+#define DMA_CCR_MSIZE_16b		1
+#define DMA_CCR_MSIZE_32b		2
+
+#define DMA_CCR_PSIZE_MASK		(0x03<<8)		/* RW bit[9:8] ݿ, λú. */
+#define DMA_CCR_PSIZE_SHIFT		8
+#define DMA_CCR_PSIZE_8b		0
+#define DMA_CCR_PSIZE_16b		1
+#define DMA_CCR_PSIZE_32b		2
+
+#define DMA_CCR_MINC			bit(7)			/* RW 洢ַģʽ, λú. 0: Ч; 1: Ч. */
+#define DMA_CCR_PINC			bit(6)			/* RW ַģʽ, λú. 0: Ч; 1: Ч. */
+#define DMA_CCR_CIRC			bit(5)			/* RW ѭģʽ, λú. 0: Ч; 1: Ч. */
+#define DMA_CCR_DIR				bit(4)			/* RW ݴ䷽, λú. 0: ; 1: Ӵ洢. */
+#define DMA_CCR_TEIE			bit(3)			/* RW жʹ, λú. 0: Ч; 1: Ч. */
+#define DMA_CCR_HTIE			bit(2)			/* RW жʹ, λú. 0: Ч; 1: Ч. */
+#define DMA_CCR_TCIE			bit(1)			/* RW жʹ, λú. 0: Ч; 1: Ч. */
+#define DMA_CCR_EN				bit(0)			/* RW ͨ, λú. 0: Ч; 1: Ч. */
+
+/**
+ * DMA ͨx Ĵ(DMA_CNDTRx)
+ *
+ * ƫ:  0x0c + 0x14 * x
+ */
+/*
+ * 31:0 NDT RW ݴ, Ĵֻͨͣʱд. ͨΪֻ, ʱΪ.
+ * ע: 	DMA δַ֧ΧΪ4294967295, msize/psize Ϊ0 ʱ, NDT Ϊ4294967295;
+ * 		msize/psize һΪ1 ʱ, NDT Ϊ2147483647;
+ * 		msize/psize һΪ1 ʱ, NDT Ϊ1073741823.
+ */
+
+/**
+ * DMA ͨx ַĴ(DMA_CPARx)
+ *
+ * ƫ:  0x10 + 0x14 * x
+ */
+/*
+ * 31:0 PADDR RW ַ, ʼַ. ͨΪֻ.
+ */
+
+/**
+ * DMA ͨx ַĴ(DMA_CMARx)
+ *
+ * ƫ:  0x14 + 0x14 * x
+ */
+/*
+ * 31:0 MADDR RW 洢ַ, 洢ʼַ. ͨΪֻ.
+ */
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/*
+ 	ͨӳ
+
+	 -------------------------------------------------------
+	|  		| 					DMA ͨ					|
+	|  	|-----------------------------------------------|
+    |    	| CH0 | CH1 | CH2 | CH3 | CH4 | CH5 | CH6 | CH7 |
+    |-------|-----|-----|-----|-----|-----|-----|-----|-----|
+	| UART0 | RX* | TX* | RX  | TX  | RX  | TX  | RX  | TX  |
+	| UART1 | RX  | TX  | RX* | TX* | RX  | TX  | RX  | TX  |
+	| UART2 | RX  | TX  | RX  | TX  | RX* | TX* | RX  | TX  |
+	| UART3 | RX  | TX  | RX  | TX  | RX  | TX  | RX* | TX* |
+	| UART4 | RX* | TX* | RX  | TX  | RX  | TX  | RX  | TX  |
+	| UART5 | RX  | TX  | RX* | TX* | RX  | TX  | RX  | TX  |
+	| UART6 | RX  | TX  | RX  | TX  | RX* | TX* | RX  | TX  |
+	| UART7 | RX  | TX  | RX  | TX  | RX  | TX  | RX* | TX* |
+	| UART8 | RX* | TX* | RX  | TX  | RX  | TX  | RX  | TX  |
+	| UART9 | RX  | TX  | RX* | TX* | RX  | TX  | RX  | TX  |
+	| I2C0  | RX* | TX* | RX  | TX  | RX  | TX  | RX  | TX  |
+	| I2C1  | RX  | TX  | RX* | TX* | RX  | TX  | RX  | TX  |
+	| I2C2  | RX  | TX  | RX  | TX  | RX* | TX* | RX  | TX  |
+	| I2C3  | RX  | TX  | RX  | TX  | RX  | TX  | RX* | TX* |
+	| SPI2  | RX* | TX* | RX  | TX  | RX  | TX  | RX  | TX  |
+	| SPI3  | RX  | TX  | RX* | TX* | RX  | TX  | RX  | TX  |
+	| I2S   | RX* | TX* | RX  | TX  | RX  | TX  | RX  | TX  |
+	| ADC   | RX* | RX  | RX  | RX  | RX  | RX  | RX  | RX  |
+	| CAN0  | RX* | RX  | RX  | RX  | RX  | RX  | RX  | RX  |
+	| CAN1  | RX  | RX* | RX  | RX  | RX  | RX  | RX  | RX  |
+	| CAN2  | RX  | RX  | RX* | RX  | RX  | RX  | RX  | RX  |
+	| CAN3  | RX  | RX  | RX  | RX* | RX  | RX  | RX  | RX  |
+	| ATIM  | CH1 | CH2 | CH3 | CH4 | COM | UP  | TRG |  -  |
+	| GTIM  | CH1 | CH2 | CH3 | CH4 |  -  | UP  | TRG |  -  |
+	| BTIM  |  -  |  -  |  -  |  -  |  -  | UP  |  -  |  -  |
+     -------------------------------------------------------
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LS2K_DMA_HW_H
+
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_adc.h
+ *
+ * created: 2024-07-28
+ *  author: Bian
+ */
+
+#ifndef _LS2K_ADC_H
+#define _LS2K_ADC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------------------------------------------------
+// ADC Channels
+//-----------------------------------------------------------------------------
+
+#define ADC_CH_1		        1           /* ͨ 1 */
+#define ADC_CH_2		        2           /* ͨ 2 */
+#define ADC_CH_3		        3		    /* ͨ 3 */
+#define ADC_CH_4		        4		    /* ͨ 4 */
+#define ADC_CH_5		        5		    /* ͨ 5 */
+#define ADC_CH_6		        6		    /* ͨ 6 */
+#define ADC_CH_7		        7		    /* ͨ 7 */
+#define ADC_CH_8		        8		    /* ͨ 8 */
+
+#define REGULAR_COUNT           8           /* ͨ */
+
+#define INJECT_COUNT            4           /* עͨ */
+
+//-----------------------------------------------------------------------------
+// ADC 
+//-----------------------------------------------------------------------------
+
+#define ADC_SAMP_1P			    0		    /* 1  */
+#define ADC_SAMP_2P			    1		    /* 2  */
+#define ADC_SAMP_4P			    2		    /* 4  */
+#define ADC_SAMP_8P			    3		    /* 8  */
+#define ADC_SAMP_16P		    4		    /* 16  */
+#define ADC_SAMP_32P		    5		    /* 32  */
+#define ADC_SAMP_64P		    6		    /* 64  */
+#define ADC_SAMP_128P		    7		    /* 128  */
+
+//-----------------------------------------------------------------------------
+// ADC Regular Channel
+//-----------------------------------------------------------------------------
+
+/*
+ * źλ
+ */
+#define ADC_OPHASE_SAME		    0		    /*  ADCCLK ͬʱ */
+#define ADC_OPHASE_BEFORE_1	    1		    /*  ADCCLK ǰһpclk */
+#define ADC_OPHASE_AFTER_1      2		    /*  ADCCLK غһpclk */
+
+/*
+ * ͨⲿԴ
+ */
+#define ADC_TRIG_SWATART	    0		    /* ⲿ¼ת */
+#define ADC_TRIG_ATIM_CC1       1		    /* ʹⲿ ATIM_CC1 ¼ */
+#define ADC_TRIG_ATIM_CC2       2	      	/* ʹⲿ ATIM_CC2 ¼ */
+#define ADC_TRIG_ATIM_CC3       3		    /* ʹⲿ ATIM_CC3 ¼ */
+#define ADC_TRIG_GTIM_CC2       4		    /* ʹⲿ GTIM_CC2 ¼ */
+#define ADC_TRIG_EXTI_11	    5		    /* ʹⲿ EXTI 11 */
+
+//---------------------------------------------------------
+
+/**
+ * ʼṹ, ͬʱùͨ
+ */
+typedef struct
+{
+	int OutPhaseSel;                        /* źλ */
+	int ClkDivider;                         /* Ƶϵ */
+	int DiffMode;                           /*  */
+	int ScanMode;                           /* ɨģʽ */
+	int ContinuousMode;                     /* ת TODO */
+	int TrigEdgeDown;                       /* ʱӴ: 1=½ */
+	int ExternalTrigSrc;                    /* ͨⲿԴ */
+	int DataAlignLeft;                      /* ת */
+	int RegularChannelCount;                /* ͨ */
+    int RegularChannels[REGULAR_COUNT];     /* ͨ */
+    int SampleClocks[REGULAR_COUNT];        /*  */
+} ADC_Mode_t;
+
+//-----------------------------------------------------------------------------
+// ADC Inject Channel. runtime?
+//-----------------------------------------------------------------------------
+
+/*
+ * ע봥ģʽ
+ */
+#define ADC_JTRIG_IMMEDIATE	    0		    /* ǰתʼעͨת */
+#define ADC_JTRIG_END_RESET     1		    /* ǰתڲһADC λźźʼעͨת */
+#define ADC_JTRIG_END	        2		    /* ڵǰתʼעͨת */
+
+/*
+ * עͨⲿԴ
+ */
+#define ADC_JTRIG_JSWSTART	    0		    /* ⲿ¼ת */
+#define ADC_JTRIG_ATIM_TRGO	    1		    /* ʹⲿ ATIM_TRGO ¼ */
+#define ADC_JTRIG_ATIM_CC4	    2		    /* ʹⲿ ATIM_CC4 ¼ */
+#define ADC_JTRIG_GTIM_TRGO	    3		    /* ʹⲿ GTIM_TRGO ¼ */
+#define ADC_JTRIG_GTIM_CC1	    4		    /* ʹⲿ GTIM_CC1 ¼ */
+#define ADC_JTRIG_EXTI_15		5		    /* ʹⲿ EXTI 15 */
+
+/**
+ * עͨ
+ */
+typedef struct
+{
+    int JTrigAuto;                          /* Զעͨת */
+    int JTrigMode;                          /* ע봥ģʽ */
+    int ExternalJTrigSrc;                   /* עͨⲿԴ */
+	int InjectChannelCount;                 /* עͨ */
+    int InjectChannels[REGULAR_COUNT];      /* עͨ */
+    int InjectOffsets[REGULAR_COUNT];       /* עͨƫ */
+    int SampleClocks[REGULAR_COUNT];        /*  */
+} ADC_Inject_t;
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// IOCTL 
+//-----------------------------------------------------------------------------
+
+#define IOCTL_ADC_SET_MODE      0x01        /* ³ʼADC豸, : ADC_Mode_t* */
+
+#define IOCTL_ADC_CALIBRATE     0x02        /* ִ ADC У, : NULL */
+
+#define IOCTL_ADC_SET_INJECT    0x03        /* ADC ע, : ADC_Inject_t* */
+
+#define IOCTL_ADC_GET_JRESULT   0x04        /* ȡעͨת,
+                                             * : int *, עͨ˳, ת */
+
+#define IOCTL_ADC_STREAM_START  0x05        /* ʼģʽɼ, : ADC_Stream_t* */
+
+#define IOCTL_ADC_STREAM_STOP   0x06        /* ֹͣģʽɼ, : NULL */
+
+#define IOCTL_ADC_STREAM_STATS  0x07        /* ȡģʽͳ, : ADC_StreamStats_t* */
+
+//-----------------------------------------------------------------------------
+// ADC ģʽ
+//-----------------------------------------------------------------------------
+
+/*
+ * ʱıȽ¼ SampleRate ͨת, DMA ѭдû
+ * ping-pong ; ÿд,  Callback Ϣ.
+ *
+ * ڵĲֵͨ˳. ģʽڼ ADC_read()  -1.
+ */
+
+/*
+ * ǰ cache  dcache, Ͱһ cache еݻᶪʧ,
+ * ԻַͰȶ밴 cache ж
+ */
+#define ADC_STREAM_ALIGN    64
+
+/*
+ * ص,  DMA жִ
+ *   samples    дİ׵ַ
+ *   count      ֵ
+ */
+typedef void (*adc_stream_cb_t)(const unsigned int *samples, int count, void *arg);
+
+typedef struct
+{
+    int           TrigSrc;                  /* ADC_TRIG_ATIM_CC1~3  ADC_TRIG_GTIM_CC2 */
+    unsigned int  SampleRate;               /* ͨƵ, Hz */
+    unsigned int *Buffer;                   /* ping-pong , ADC_STREAM_ALIGN ֽڶ */
+    int           BufferSize;               /* ֵ, ǹͨ*2 ,
+                                             * ֽ ADC_STREAM_ALIGN  */
+    adc_stream_cb_t Callback;               /* ص. NULL:  ls2k_adc_stream_read() ȡ */
+    void         *CallbackArg;              /* ص */
+} ADC_Stream_t;
+
+typedef struct
+{
+    unsigned int halves;                    /* дİ */
+    unsigned int overruns;                  /* Ϣ, İ */
+    unsigned int dma_errors;                /* DMA  */
+} ADC_StreamStats_t;
+
+//-----------------------------------------------------------------------------
+// ADC devices
+//-----------------------------------------------------------------------------
+
+#if (BSP_USE_ADC)
+extern const void *devADC;
+#endif
+
+//-----------------------------------------------------------------------------
+// ADC driver implements
+//-----------------------------------------------------------------------------
+
+#include "ls2k_drv_io.h"
+
+#if (PACK_DRV_OPS)
+
+extern const driver_ops_t *adc_drv_ops;
+
+#define ls2k_adc_init(dev, arg)             adc_drv_ops->init_entry(dev, arg)
+#define ls2k_adc_open(dev, arg)             adc_drv_ops->open_entry(dev, arg)
+#define ls2k_adc_close(dev, arg)            adc_drv_ops->close_entry(dev, arg)
+#define ls2k_adc_read(dev, buf, size, arg)  adc_drv_ops->read_entry(dev, buf, size, arg)
+#define ls2k_adc_ioctl(dev, cmd, arg)       adc_drv_ops->ioctl_entry(dev, cmd, arg)
+
+#else
+
+/*
+ * ʼADC
+ * :    dev     NULL  devADC
+ *          arg      ADC_Mode_t*, òΪNULLʱ, ΪĬֵ
+ *
+ * :    0=ɹ
+ */
+int ADC_initialize(const void *dev, void *arg);
+
+/*
+ * ADC. ʹADC, Ϊжģʽ, ʹж
+ * :    dev     NULL  devADC
+ *          arg      NULLADC_Mode_t*, ΪNULLʱ, ADC_Mode_t*
+ *
+ * :    0=ɹ
+ */
+int ADC_open(const void *dev, void *arg);
+
+/*
+ * رADC. ֹͣADC, Ϊжģʽ, رж
+ * :    dev     NULL  devADC
+ *          arg     NULL.
+ *
+ * :    0=ɹ
+ */
+int ADC_close(const void *dev, void *arg);
+
+/*
+ * Ӵڶ()
+ * :    dev     NULL  devADC
+ *          buf      int *. ͨת
+ *          size     int. ͨ鳤*sizeof(int)
+ *          arg      int. ͨ:
+ *                  ͨ>1: 0=ȡȫ; ȡָͨת.
+ *
+ * :    ȡֽ
+ *
+ */
+int ADC_read(const void *dev, void *buf, int size, void *arg);
+
+/*
+ * ADCͿ
+ * :    dev     NULL  devADC
+ *          cmd     IOCTL_ADC_xxx 
+ *          arg
+ *
+ * :    0=ɹ
+ */
+int ADC_ioctl(const void *dev, int cmd, void *arg);
+
+#define ls2k_adc_init(dev, arg)             ADC_initialize(dev, arg)
+#define ls2k_adc_open(dev, arg)             ADC_open(dev, arg)
+#define ls2k_adc_close(dev, arg)            ADC_close(dev, arg)
+#define ls2k_adc_read(dev, buf, size, arg)  ADC_read(dev, buf, size, arg)
+#define ls2k_adc_ioctl(dev, cmd, arg)       ADC_ioctl(dev, cmd, arg)
+
+#endif
+
+//-----------------------------------------------------------------------------
+// ADC device name
+//-----------------------------------------------------------------------------
+
+const char *ls2k_adc_get_device_name(void);
+
+//-----------------------------------------------------------------------------
+// API after open()
+//-----------------------------------------------------------------------------
+
+extern int adc_read_1_fast(int channel, int samptime);
+
+extern int adc_read_1(int channel);
+
+/*
+ * ģʽ, û Callback ʱȴһдİ
+ * :    samples     ذ׵ַ.  DMA д֮ǰ봦
+ *          timeout_ms  ȴ, OSAL_WAIT_FOREVER õȴ
+ *
+ * :    ֵ, 0=ʱ, -1=ûģʽ
+ */
+extern int ls2k_adc_stream_read(const unsigned int **samples, unsigned int timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LS2K_ADC_H
+
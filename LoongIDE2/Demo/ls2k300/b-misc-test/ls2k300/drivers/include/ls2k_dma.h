@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_dma.h
+ *
+ * created: 2024-06-19
+ *  author: 
+ */
+
+#ifndef _LS2K_DMA_H
+#define _LS2K_DMA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * DMA ͨ
+ */
+#define DMA_Channel_0   0x00
+#define DMA_Channel_1   0x01
+#define DMA_Channel_2   0x02
+#define DMA_Channel_3   0x03
+#define DMA_Channel_4   0x04
+#define DMA_Channel_5   0x05
+#define DMA_Channel_6   0x06
+#define DMA_Channel_7   0x07
+
+/**
+ * DMA 
+ */
+#define DMA_UART0       0x01        // RX & TX
+#define DMA_UART1       0x02        // RX & TX
+#define DMA_UART2       0x03        // RX & TX
+#define DMA_UART3       0x04        // RX & TX
+#define DMA_UART4       0x05        // RX & TX
+#define DMA_UART5       0x06        // RX & TX
+#define DMA_UART6       0x07        // RX & TX
+#define DMA_UART7       0x08        // RX & TX
+#define DMA_UART8       0x09        // RX & TX
+#define DMA_UART9       0x0A        // RX & TX
+
+#define DMA_I2C0        0x10        // RX & TX
+#define DMA_I2C1        0x11        // RX & TX
+#define DMA_I2C2        0x12        // RX & TX
+#define DMA_I2C3        0x13        // RX & TX
+
+#define DMA_SPI2        0x20        // RX & TX
+#define DMA_SPI3        0x21        // RX & TX
+
+#define DMA_I2S         0x30        // RX & TX
+
+#define DMA_ADC         0x40        // RX
+
+#define DMA_CAN0        0x50        // RX
+#define DMA_CAN1        0x51        // RX
+#define DMA_CAN2        0x52        // RX
+#define DMA_CAN3        0x53        // RX
+
+#define DMA_MEM         0x54        // any channel for mem2mem
+
+#define DMA_ATIM        0x60        // fixed: CH1 CH2 CH3 CH4 COM UP TRG
+#define DMA_GTIM        0x61        // fixed: CH1 CH2 CH3 CH4  -  UP TRG
+
+//-----------------------------------------------------------------------------
+// DMAжϻص
+//-----------------------------------------------------------------------------
+
+#define DMA_SR_ERROR    (1<<3)      // DMA 
+#define DMA_SR_HALF     (1<<2)      // 
+#define DMA_SR_DONE 	(1<<1)      // 
+
+struct dma_chnl_cfg;
+
+/*
+ * :    chnl    DMAͨ
+ *          status  DMA_SR_ERR | DMA_SR_HALF | DMA_SR_DONE
+ */
+typedef void (*dma_callback_t)(struct dma_chnl_cfg *cfg, int bytes, unsigned int status);
+
+//-----------------------------------------------------------------------------
+
+/**
+ * DMA ͨƼĴ
+ */
+struct dma_ccr
+{
+    unsigned int en       : 1;      // bit[0] DMA_CCR_EN   ͨ
+    unsigned int tcie     : 1;      // bit[1] DMA_CCR_TCIE жʹ
+    unsigned int htie     : 1;      // bit[2] DMA_CCR_HTIE жʹ
+    unsigned int teie     : 1;      // bit[3] DMA_CCR_TEIE жʹ
+    unsigned int dir      : 1;      // bit[4] DMA_CCR_DIR  ݴ䷽: 0: ; 1: Ӵ洢.
+    unsigned int circ     : 1;      // bit[5] DMA_CCR_CIRC ѭģʽ
+    unsigned int pinc     : 1;      // bit[6] DMA_CCR_PINC ַģʽ
+    unsigned int minc     : 1;      // bit[7] DMA_CCR_MINC 洢ַģʽ
+    unsigned int psize    : 2;      // bit[9:8]     ݿ
+    unsigned int msize    : 2;      // bit[11:10]   洢ݿ
+    unsigned int priority : 2;      // bit[13:12]   ͨȼ
+    unsigned int mem2mem  : 1;      // bit[14] DMA_CCR_MEM2MEM 洢ģʽ
+};
+
+/**
+ * DMA ͨ
+ */
+struct dma_chnl_cfg
+{
+    int      chNum;                 // ʹõDMAͨ: DMA_CHNL0~DMA_CHNL7; -1ʱԶҿͨ
+
+    unsigned devNum;                // ⲿ豸: DMA_UART0~DMA_GTIM. mem2mem=1: as memory source address
+    void    *device;                // ⲿ豸.
+    unsigned memAddr;               // ڴַ, 32λ
+    int      transbytes;            // ֽ
+
+    dma_callback_t cb;              // жϻص
+
+    union
+    {
+        unsigned int ccr32;         // CCR ֵ
+        struct dma_ccr ccr;         // DMA : ccr.dir: 1=mem->peripheral
+    };
+};
+
+//-----------------------------------------------------------------------------
+// IOCTL                                arg 
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// DMA function
+//-----------------------------------------------------------------------------
+
+#include "ls2k_drv_io.h"
+
+#if (PACK_DRV_OPS)
+
+extern const driver_ops_t *dma_drv_ops;
+
+#define ls2k_dma_init(dma, arg)             dma_drv_ops->init_entry(dma, arg)
+#define ls2k_dma_open(dma, arg)             dma_drv_ops->open_entry(dma, arg)
+#define ls2k_dma_close(dma, arg)            dma_drv_ops->close_entry(dma, arg)
+
+#else
+
+/*
+ * ʼDMA豸
+ * :    dev     NULL
+ *          arg     NULL
+ *
+ * :    0=ɹ
+ */
+int DMA_initialize(const void *dev, void *arg);
+
+/*
+ * DMAͨ
+ * :    dev     NULL
+ *          arg      struct dma_chnl_cfg *, DMAͨΪָģʽ. òNULL.
+ *
+ * :    0=ɹ
+ */
+int DMA_open(const void *dev, void *arg);
+
+/*
+ * رDMAͨ
+ * :    dev     NULL
+ *          arg      int, DMAͨ.
+ *
+ * :    0=ɹ
+ */
+int DMA_close(const void *dev, void *arg);
+
+#define ls2k_dma_init(dma, arg)             DMA_initialize(dma, arg)
+#define ls2k_dma_open(dma, arg)             DMA_open(dma, arg)
+#define ls2k_dma_close(dma, arg)            DMA_close(dma, arg)
+
+#endif
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// DMA User API
+//-----------------------------------------------------------------------------
+
+/**
+ * ȡеDMAͨ
+ *
+ * :    devNum      DMA_UART0 ~ DMA_GTIM
+ *          rx_chnl     ͨ DMA_CHNL0 ~ DMA_CHNL7
+ *          tx_chnl     ͨ DMA_CHNL0 ~ DMA_CHNL7. ˫ͨʹ
+ *
+ * :    0=ɹ
+ *          
+ */
+int dma_get_idle_channel(int devNum, int *rx_chnl, int *tx_chnl);
+
+/**
+ * еDMAͨ.  dma_get_idle_channel() ͬ, صͨռ,
+ * ֱ dma_release_channel(), ڼ䲻ٷ豸
+ *
+ * :    devNum      DMA_UART0 ~ DMA_GTIM
+ *          rx_chnl     ͨ DMA_CHNL0 ~ DMA_CHNL7
+ *          tx_chnl     ͨ DMA_CHNL0 ~ DMA_CHNL7. ˫ͨʹ
+ *
+ * :    0=ɹ
+ *
+ */
+int dma_claim_channel(int devNum, int *rx_chnl, int *tx_chnl);
+
+/**
+ * ֹͣͷ dma_claim_channel() ͨ
+ *
+ * :    channel     DMA_CHNL0 ~ DMA_CHNL7
+ */
+void dma_release_channel(int channel);
+
+/**
+ * ͨ channel Ƿ
+ *
+ * :    channel     DMA_CHNL0 ~ DMA_CHNL7
+ *
+ * :    1: idle
+ *
+ */
+int dma_channel_is_idle(int channel);
+
+/**
+ * ͨ channel Ƿ
+ *
+ * :    channel     DMA_CHNL0 ~ DMA_CHNL7
+ *
+ * :    1: ready
+ *
+ */
+int dma_channel_is_ready(int channel);
+
+/**
+ * DMA
+ *
+ * :    cfg         DMA ò
+ *          priority    DMA ȼ, <=0 ı
+ *
+ * :    0=ɹ, -1=ʧ
+ *
+ */
+#define DMA_PRIORITY_LOW		0x01
+#define DMA_PRIORITY_MID		0x02
+#define DMA_PRIORITY_HIGH		0x04
+#define DMA_PRIORITY_HIGHEST	0x08
+
+int dma_start(struct dma_chnl_cfg *cfg, int priority);
+
+/**
+ * ͣ DMA ͨ
+ */
+int dma_pause(int channel);
+
+/**
+ * ѾúõDMAͨ
+ *
+ * :    channel     DMA_CHNL0 ~ DMA_CHNL7
+ *          buf         ݵַ
+ *          size        ֽ
+ *          xferbits    , 8/16/32 ֮ⲻ޸ĳʼ
+ *
+ * :    -1=ʧ, 򷵻 size
+ *
+ */
+#define DMA_XFER_8b         8
+#define DMA_XFER_16b        16
+#define DMA_XFER_32b        32
+
+int dma_restart(int channel, char *buf, int size, int xferbits);
+
+/**
+ * ֹͣDMAͨ
+ *
+ * :    channel      DMA_CHNL0 ~ DMA_CHNL7
+ *
+ */
+void dma_stop(int channel);
+
+/**
+ * ȡDMAͨ״̬Ĵ
+ *
+ * :    channel      DMA_CHNL0 ~ DMA_CHNL7
+ *
+ * :    DMAͨ״̬Ĵ(Ӧͨ). -1=û
+ *
+ */
+int dma_get_status(int channel);
+
+/**
+ * ȡDMAͨ
+ *
+ * :    channel      DMA_CHNL0 ~ DMA_CHNL7
+ *
+ * :    DMA_CNDTR Ĵֵ, ѭģʽ㵱ǰĴλ. -1=û
+ *
+ */
+int dma_get_counter(int channel);
+
+/**
+ * ȡDMAͨ״̬Ĵ
+ *
+ * :    channel     DMA_CHNL0 ~ DMA_CHNL7
+ *          timeout     ʱȴ, һ
+ *
+ */
+int dma_wait_done(int channel, int timeout);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LS2K_DMA_H
+
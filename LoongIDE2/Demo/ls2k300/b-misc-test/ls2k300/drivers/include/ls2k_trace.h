@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_trace.h
+ *
+ * created: 2026-10-17
+ *  author:
+ */
+
+#ifndef _LS2K_TRACE_H
+#define _LS2K_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Ƹټ¼.
+ *
+ * TRACE(fmt, ...) ֻʽַĵַ 5  rdtime.d ,
+ * ʽ, жϺշ·г. 󸲸ɵļ¼.
+ *
+ * :
+ *
+ *      1. Ŀ: trace_print()  printk , ں̨е;
+ *      2. :  gdb  ls2k_trace_buf ڴ,  trace_dump() Ӵ
+ *         , Ȼ tools/trace_decode  ELF ļ.
+ *
+ * :
+ *
+ *      1. fmt ַ, ;
+ *      2.  unsigned long , ָ֧;
+ *      3. %s Ĳַֻ, ַָֻ.
+ */
+
+#ifndef BSP_USE_TRACE
+#define BSP_USE_TRACE       1
+#endif
+
+#define TRACE_MAGIC         0x31435254      /* "TRC1" */
+#define TRACE_RECORDS       1024            /*  2  */
+#define TRACE_MAX_ARGS      5
+
+typedef struct
+{
+    volatile unsigned long seq;             /* д+1, 0=Ч */
+    unsigned long stamp;                    /* rdtime.d */
+    const char   *fmt;
+    unsigned long arg[TRACE_MAX_ARGS];
+} trace_rec_t;
+
+/*
+ * ڴ沼 tools/trace_decode.c , ޸ʱͬʱ޸
+ */
+typedef struct
+{
+    unsigned int  magic;                    /* TRACE_MAGIC */
+    unsigned int  records;                  /* ¼ */
+    unsigned int  rec_size;                 /* sizeof(trace_rec_t) */
+    unsigned int  count_1us;                /* rdtime.d ÿ΢ */
+    volatile unsigned long head;            /* һд */
+    unsigned long reserved[5];
+    trace_rec_t   rec[TRACE_RECORDS];
+} trace_buf_t;
+
+extern trace_buf_t ls2k_trace_buf;
+
+#if BSP_USE_TRACE
+
+void trace_event(const char *fmt, unsigned long a0, unsigned long a1,
+                 unsigned long a2, unsigned long a3, unsigned long a4);
+
+#define __TRACE_NARG(...)   __TRACE_NARG_(0, ##__VA_ARGS__, 5, 4, 3, 2, 1, 0)
+#define __TRACE_NARG_(_0, _1, _2, _3, _4, _5, N, ...)   N
+
+#define __TRACE_CAT(a, b)   a##b
+#define __TRACE_SEL(n)      __TRACE_CAT(__TRACE, n)
+
+#define __TRACE0(f)                 trace_event(f, 0, 0, 0, 0, 0)
+#define __TRACE1(f, a)              trace_event(f, (unsigned long)(a), 0, 0, 0, 0)
+#define __TRACE2(f, a, b)           trace_event(f, (unsigned long)(a), (unsigned long)(b), 0, 0, 0)
+#define __TRACE3(f, a, b, c)        trace_event(f, (unsigned long)(a), (unsigned long)(b), \
+                                                (unsigned long)(c), 0, 0)
+#define __TRACE4(f, a, b, c, d)     trace_event(f, (unsigned long)(a), (unsigned long)(b), \
+                                                (unsigned long)(c), (unsigned long)(d), 0)
+#define __TRACE5(f, a, b, c, d, e)  trace_event(f, (unsigned long)(a), (unsigned long)(b), \
+                                                (unsigned long)(c), (unsigned long)(d), (unsigned long)(e))
+
+#define TRACE(fmt, ...)     __TRACE_SEL(__TRACE_NARG(__VA_ARGS__))(fmt, ##__VA_ARGS__)
+
+#else
+
+#define TRACE(fmt, ...)     do { } while (0)
+
+#endif // #if BSP_USE_TRACE
+
+/*
+ *  printk ûļ¼,  max , max<=0 ʱȫ.
+ * ļ¼
+ */
+int trace_print(int max);
+
+/*
+ *  "@TRC ƫ ʮ" ıдӴͬ,
+ *  tools/trace_decode 
+ */
+void trace_dump(void);
+
+/*
+ * м¼
+ */
+void trace_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LS2K_TRACE_H
+
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * norflash.h
+ *
+ * created: 2024-06-23
+ *  author: Bian
+ */
+
+#ifndef _NORFLASH_H
+#define _NORFLASH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------------------------------------------------
+// Device name
+//-----------------------------------------------------------------------------
+
+#define NORFLASH_DEV_NAME       "spi0.norflash"
+
+//-----------------------------------------------------------------------------
+// io control command
+//-----------------------------------------------------------------------------
+
+#define IOCTL_NORFLASH_READ_ID          0x0001
+#define IOCTL_NORFLASH_READ_JDECID      0x0002
+#define IOCTL_NORFLASH_READ_UNIQUEID    0x0004
+#define IOCTL_NORFLASH_ERASE_4K         0x0008      /* sector erase, 4KB */
+#define IOCTL_NORFLASH_ERASE_32K        0x0010      /* block erase, 32KB */
+#define IOCTL_NORFLASH_ERASE_64K        0x0020      /* block erase, 64KB */
+#define IOCTL_NORFLASH_SECTOR_ERASE     0x0040      /* sector erase */
+#define IOCTL_NORFLASH_BULK_ERASE       0x0080      /* chip erase */
+#define IOCTL_NORFLASH_WRITE_PROTECT    0x0100      /* write protect */
+#define IOCTL_NORFLASH_IS_BLANK         0x0200      /* sector empty check */
+#define IOCTL_NORFLASH_GET_MMAP         0x0400      /* memory-mapped read pointer */
+
+/*
+ * IOCTL_NORFLASH_GET_MMAP
+ */
+typedef struct
+{
+    unsigned int offset;                /* : flash ڲַ */
+    unsigned int size;                  /* : Ҫʵֽ */
+    const void  *ptr;                   /* : ָֻ */
+} NORFLASH_mmap_t;
+
+//-----------------------------------------------------------------------------
+// SPI0-NORFLASH driver operators
+//-----------------------------------------------------------------------------
+
+#include "ls2k_drv_io.h"
+
+#if (PACK_DRV_OPS)
+
+extern const driver_ops_t *norflash_drv_ops;
+
+#define ls2k_norflash_init(bus, arg)             norflash_drv_ops->init_entry(bus, arg)
+#define ls2k_norflash_open(bus, arg)             norflash_drv_ops->open_entry(bus, arg)
+#define ls2k_norflash_close(bus, arg)            norflash_drv_ops->close_entry(bus, arg)
+#define ls2k_norflash_read(bus, buf, size, arg)  norflash_drv_ops->read_entry(bus, buf, size, arg)
+#define ls2k_norflash_write(bus, buf, size, arg) norflash_drv_ops->write_entry(bus, buf, size, arg)
+#define ls2k_norflash_ioctl(bus, cmd, arg)       norflash_drv_ops->ioctl_entry(bus, cmd, arg)
+
+#else
+
+/*
+ * ʼNORFLASHоƬ
+ * :    dev     busSPI0
+ *          arg     NULL
+ *
+ * :    0=ɹ
+ */
+int NORFLASH_initialize(const void *bus, void *arg);
+
+/*
+ * NORFLASHоƬ
+ * :    dev     busSPI0
+ *          arg     NULL
+ *
+ * :    0=ɹ
+ */
+int NORFLASH_open(const void *bus, void *arg);
+
+/*
+ * رNORFLASHоƬ
+ * :    dev     busSPI0
+ *          arg     NULL
+ *
+ * :    0=ɹ
+ */
+int NORFLASH_close(const void *bus, void *arg);
+
+/*
+ * NORFLASHоƬ
+ * :    dev     busSPI0
+ *          buf     : unsigned char *, ڴŶȡݵĻ
+ *          size    : int, ȡֽ, Ȳܳ buf 
+ *          arg     : unsigned int *, flashʼַ(NORFLASHڲַ0ʼԱַ)
+ *
+ * :    ȡֽ
+ */
+int NORFLASH_read(const void *bus, void *buf, int size, void *arg);
+
+/*
+ * NORFLASHоƬд
+ * :    dev     busSPI0
+ *          buf     : unsigned char *, ڴŴдݵĻ
+ *          size    : int, дֽ, Ȳܳ buf 
+ *          arg     : unsigned int *, дflashʼַ(NORFLASHڲַ0ʼԱַ)
+ *
+ * :    дֽ
+ *
+ * ˵:    дNORFLASHѾʽ, ȫΪ 0xFF ҳ
+ */
+int NORFLASH_write(const void *bus, void *buf, int size, void *arg);
+
+/*
+ * /NORFLASHоƬͿ
+ * :    dev     busSPI0
+ *
+ *      ---------------------------------------------------------------------------------
+ *          cmd                             |   arg
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_FLASH_FAST_READ_ENABLE    |   NULL. SPIߵFLASHٶģʽ
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_FLASH_FAST_READ_DISABLE   |   NULL. ֹͣSPIߵFLASHٶģʽ
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_NORFLASH_READ_ID          |   : unsigned int *
+ *                                          |   ;: ȡNORFLASHоƬID
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_NORFLASH_ERASE_4K         |   : unsigned long
+ *          IOCTL_NORFLASH_SECTOR_ERASE     |   ;: õַڵ4K
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_NORFLASH_ERASE_32K        |   : unsigned long
+ *                                          |   ;: õַڵ32K
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_NORFLASH_ERASE_64K        |   : ulong nsigned int
+ *                                          |   ;: õַڵ64K
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_NORFLASH_BULK_ERASE       |   NULL, flashоƬ
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_NORFLASH_IS_BLANK         |   NULL, ǷΪ
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_NORFLASH_GET_MMAP         |   : NORFLASH_mmap_t *
+ *                                          |   ;: ٶģʽ,  offset ָֻ,
+ *                                          |         ֱӶ flash Ҫ. Χܳٶռ.
+ *                                          |         NORFLASH_write Ͳڼָ벻ɷ
+ *      ---------------------------------------------------------------------------------
+ *
+ * :    0=ɹ
+ */
+int NORFLASH_ioctl(const void *bus, int cmd, void *arg);
+
+#define ls2k_norflash_init(bus, arg)             NORFLASH_initialize(bus, arg)
+#define ls2k_norflash_open(bus, arg)             NORFLASH_open(bus, arg)
+#define ls2k_norflash_close(bus, arg)            NORFLASH_close(bus, arg)
+#define ls2k_norflash_read(bus, buf, size, arg)  NORFLASH_read(bus, buf, size, arg)
+#define ls2k_norflash_write(bus, buf, size, arg) NORFLASH_write(bus, buf, size, arg)
+#define ls2k_norflash_ioctl(bus, cmd, arg)       NORFLASH_ioctl(bus, cmd, arg)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _NORFLASH_H
+
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k_spi_bus_hw.h
+ *
+ * created: 2024-06-08
+ *  author: Bian
+ */
+
+#ifndef _LS2K_SPI_HW_H
+#define _LS2K_SPI_HW_H
+
+//-------------------------------------------------------------------------------------------------
+// SPI 豸
+//-------------------------------------------------------------------------------------------------
+
+#define SPI0_BASE               0x16010000
+#define SPI1_BASE               0x16018000
+
+#define SPI0_MEM_ADDR			0x10000000		// C 0x11ff,ffff SPI0 MEM 32MB
+#define SPI1_MEM_ADDR			0x12000000		// C 0x13ff,ffff SPI1 MEM 32MB
+
+/*
+ * SPI-Flash 
+ */
+typedef struct
+{
+    volatile unsigned char ctrl;            // 0x00 ƼĴ
+    volatile unsigned char sr;              // 0x01 ״̬Ĵ
+    volatile unsigned char data;            // 0x02 ݼĴ
+    volatile unsigned char er;              // 0x03	ⲿĴ
+    volatile unsigned char param;       	// 0x04	ƼĴ
+    volatile unsigned char softcs;          // 0x05 ƬѡĴ
+    volatile unsigned char timing;          // 0x06 ʱƼĴ
+} HW_SPI_t;
+
+#define SPI_CTRL_IEN            bit(7)      // RW 0 жʹźŸЧ
+#define SPI_CTRL_EN             bit(6)      // RW 0 ϵͳʹźŸЧ
+#define SPI_CTRL_MASTER         bit(4)      // RO 1 masterģʽѡλ, λһֱ1
+#define SPI_CTRL_CPOL           bit(3)      // RW 0 ʱӼλ
+#define SPI_CTRL_CPHA           bit(2)      // RW 0 ʱλλ1 λ෴Ϊ0 ͬ
+#define SPI_CTRL_SPR_MASK       0x03        // RW 0 bit[1:0] sclk_o Ƶ趨Ҫsper spre һʹ
+
+#define SPI_SR_IFLAG            bit(7)      // RW 0 жϱ־λ1 ʾж룬д1 
+#define SPI_SR_WOVERFLOW        bit(6)      // RW 0 дĴ־λΪ1 ʾѾ,д1 
+#define SPI_SR_BUSY             bit(4)      // RO 0 æ״̬, 0: ߿, 1: æ״̬
+#define SPI_SR_WFFULL           bit(3)      // RO 0 дĴ־1 ʾѾ
+#define SPI_SR_WFEMPTY          bit(2)      // RO 1 дĴձ־1 ʾ
+#define SPI_SR_RFFULL           bit(1)      // RO 0 Ĵ־1 ʾѾ
+#define SPI_SR_RFEMPTY          bit(0)      // RO 1 Ĵձ־1 ʾ
+
+#define SPI_ER_ICNT_MASK        0xC0        // RW 0 bit[7:6] ٸֽںж
+#define SPI_ER_ICNT_SHIFT       6
+#define SPI_ER_ICNT_1B			(0<<6)
+#define SPI_ER_ICNT_2B			(1<<6)
+#define SPI_ER_ICNT_3B			(2<<6)
+#define SPI_ER_ICNT_4B			(3<<6)
+#define SPI_ER_MODE             bit(2)      // RW 0 spi ӿģʽ. 0: 뷢ʱͬʱ, 1: 뷢ʱ
+#define SPI_ER_SPRE_MASK        0x03        // RW 0 bit[1:0] spr һ趨Ƶı
+
+/*
+ * SPI Ƶϵ
+ *
+ *  ---------------------------------------------------------------------------------
+ * | 	spre 	| 00 | 00 | 00 | 00 | 01 | 01 | 01  | 01  | 10  |  10  |  10  |  10  |
+ * |	spr  	| 00 | 01 | 10 | 11 | 00 | 01 | 10  | 11  | 00  |  01  |  10  |  11  |
+ * |------------|----|----|----|----|----|----|-----|-----|-----|------|------|------|
+ * |  Ƶϵ	| 2  | 4  | 16 | 32 | 8  | 64 | 128 | 256 | 512 | 1024 | 2048 | 4096 |
+ *  ---------------------------------------------------------------------------------
+ *
+ */
+#define SPI_PARAM_CLKDIV_MASK   0xF0        // RW 2 bit[7:4] ʱӷƵѡƵϵ{spre, spr}ͬ
+#define SPI_PARAM_CLKDIV_SHIFT  4
+#define SPI_PARAM_DUAL_IO       bit(3)      // RW 0 ˫I/O ģʽȼڿٶ
+#define SPI_PARAM_FAST_READ     bit(2)      // RW 0 ٶģʽ
+#define SPI_PARAM_BURST_EN      bit(1)      // RW 0 SPI flash ַ֧ģʽ
+#define SPI_PARAM_MEMORY_EN     bit(0)      // RW 1 SPI flash ʹܣЧʱcsn[0]
+
+#define SPI_SOFT_CSn_MASK       0xF0        // RW bit[7:4] csnֵ
+#define SPI_SOFT_CSn_SHIFT      4
+#define SPI_SOFT_CSn_3          bit(7)
+#define SPI_SOFT_CSn_2          bit(6)
+#define SPI_SOFT_CSn_1          bit(5)
+#define SPI_SOFT_CSn_0          bit(4)
+#define SPI_SOFT_CSEN_MASK      0x0F        // RW bit[3:0] Ϊ1ʱӦλcsn7:4λ
+#define SPI_SOFT_CSEN_3         bit(3)
+#define SPI_SOFT_CSEN_2         bit(2)
+#define SPI_SOFT_CSEN_1         bit(1)
+#define SPI_SOFT_CSEN_0         bit(0)
+
+#define SPI_TIMING_tFAST        bit(2)      // RW 0 SPI flash ģʽ. 0: زSPI , 1: زһSPI 
+#define SPI_TIMING_tCSH_MASK    0x03        // R/W 3 bit[1:0] SPI Flash ƬѡźЧʱ䣬ԷƵʱT
+#define SPI_TIMING_tCSH_1T      0
+#define SPI_TIMING_tCSH_2T      1
+#define SPI_TIMING_tCSH_4T      2
+#define SPI_TIMING_tCSH_8T      3
+
+#endif // _LS2K_SPI_HW_H
+
@@ -0,0 +1,1192 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * ls2k300.h
+ *
+ * created: 2024-06-06
+ *  author: Bian
+ */
+
+#ifndef _LS2K300_H
+#define _LS2K300_H
+
+#include "cpu.h"
+
+#define bit(x)                  (1<<(x))
+
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * ж
+ *
+ * :    vector  жϱ
+ *          arg     װжʱĲ
+ */
+typedef void (*irq_handler_t)(int vector, void *arg);
+
+//-------------------------------------------------------------------------------------------------
+
+/*
+ * ʹչжʱ 128 жϿӦ
+ *
+ * ʹôͳжʱ  64 жϿӦ
+ *
+ */
+#define USE_EXTINT              1           /* 1: ʹչж, 0: ʹôͳж  */
+
+//-------------------------------------------------------------------------------------------------
+// Ĵ Read/Write , ַתΪ loongarch64 uncached
+//-------------------------------------------------------------------------------------------------
+
+/*
+ * 8 Bits
+ */
+#define READ_REG8(addr)         (*(volatile unsigned char *)(PHYS_TO_UNCACHED(addr)))
+#define WRITE_REG8(addr, v)     (*(volatile unsigned char *)(PHYS_TO_UNCACHED(addr))  = (v))
+#define OR_REG8(addr, v)        (*(volatile unsigned char *)(PHYS_TO_UNCACHED(addr)) |= (v))
+#define AND_REG8(addr, v)       (*(volatile unsigned char *)(PHYS_TO_UNCACHED(addr)) &= (v))
+
+/*
+ * 16 Bits
+ */
+#define READ_REG16(addr)        (*(volatile unsigned short *)(PHYS_TO_UNCACHED(addr)))
+#define WRITE_REG16(addr, v)    (*(volatile unsigned short *)(PHYS_TO_UNCACHED(addr))  = (v))
+#define OR_REG16(addr, v)       (*(volatile unsigned short *)(PHYS_TO_UNCACHED(addr)) |= (v))
+#define AND_REG16(addr, v)      (*(volatile unsigned short *)(PHYS_TO_UNCACHED(addr)) &= (v))
+
+/*
+ * 32 Bits
+ */
+#define READ_REG32(addr)        (*(volatile unsigned int *)(PHYS_TO_UNCACHED(addr)))
+#define WRITE_REG32(addr, v)    (*(volatile unsigned int *)(PHYS_TO_UNCACHED(addr))  = (v))
+#define OR_REG32(addr, v)       (*(volatile unsigned int *)(PHYS_TO_UNCACHED(addr)) |= (v))
+#define AND_REG32(addr, v)      (*(volatile unsigned int *)(PHYS_TO_UNCACHED(addr)) &= (v))
+
+/*
+ * 64 Bits
+ */
+#define READ_REG64(addr)        (*(volatile unsigned long *)(PHYS_TO_UNCACHED(addr)))
+#define WRITE_REG64(addr, v)    (*(volatile unsigned long *)(PHYS_TO_UNCACHED(addr))  = (v))
+#define OR_REG64(addr, v)       (*(volatile unsigned long *)(PHYS_TO_UNCACHED(addr)) |= (v))
+#define AND_REG64(addr, v)      (*(volatile unsigned long *)(PHYS_TO_UNCACHED(addr)) &= (v))
+
+//-------------------------------------------------------------------------------------------------
+// ַռ
+//-------------------------------------------------------------------------------------------------
+
+//-------------------------------------------------------------------------------------------------
+// ȫֿƼĴ
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Chip Control0
+ */
+#define CHIP_CTRL0_BASE                 0x16000100
+#define CTRL0_USB_PREFETCH				bit(31)				// RW 0x0 USBӿʹܶԤȡ
+#define CTRL0_USB_FLUSH_WR				bit(30)				// RW 0x0 USBӿдǷread buffer
+#define CTRL0_USB_STOP_WAW				bit(29)				// RW 0x0 USBӿǷһдǰд
+#define CTRL0_USB_STOP_RAW				bit(28)				// RW 0x1 USBӿǷһдǰ
+#define CTRL0_UART1_EN_MASK				(0x0F<<24)			// RW 0x0 bit[27:24] UART1ӦUARTģʽŸùϵ
+#define CTRL0_UART1_EN_SHIFT			24
+#define CTRL0_UART1_8LINES				0
+#define CTRL0_UART1_4LINES				(0x02<<24)			// bit[25]==1: uart7; bit[26]==0 4ģʽ
+#define CTRL0_UART1_2LINES				(0x0E<<24)			// bit[25]==1: uart7; bit[26]==1: uart8; bit[27]==1: uart9
+#define CTRL0_UART0_EN_MASK				(0x0F<<20)			// RW 0x0 bit[23:20] UART0ӦUARTģʽŸùϵ
+#define CTRL0_UART0_EN_SHIFT			20
+#define CTRL0_UART0_8LINES				0
+#define CTRL0_UART0_4LINES				(0x02<<20)			// bit[21]==1: uart4; bit[22]==0 4ģʽ
+#define CTRL0_UART0_2LINES				(0x0E<<20)			// bit[21]==1: uart4; bit[22]==1: uart5; bit[23]==1: uart6
+#define CTRL0_EXTIOINT_EN				bit(19)				// RW 0x0 XXX չжʹܿλ.
+															// 		  1: չж(ͳ/չжͬʱЧ); 0: رչж(ͳжЧ)
+#define CTRL0_RTC_HSPEED				bit(17)				// RW 0x1 RTCֵٷʹλ. 1: ٷ; 0: رտٷ.
+#define CTRL0_OPT_CTRL_EN				bit(16)				// RW 0x0 OTPģʹλ
+#define CTRL0_HPET_INT_SHARE_MASK		(0x0F<<12)			// RW 0x0 bit[15:12] hpet0~3жģʽ:
+															//		  0: жģʽ(31ж); 1: жģʽ(33ж)
+#define CTRL0_DDR4_ECC_EN				bit(9)				// RW 0x0 DDR ECCʹλ
+#define CTRL0_DDR4_SHUT					bit(8)				// RW 0x0 DDRģرտλ
+#define CTRL0_DDR4_LPCONF_EN			bit(7)				// RW 0x0 DDR͹ʹλ
+#define CTRL0_DDR4_LPMC_EN				bit(6)				// RW 0x0 DDR͹λ
+#define CTRL0_DDR4_REGS_DEFAULT			bit(5)				// RW 0x0 ڲд.
+															// 		  0: رշڴĬ·Ӧ,
+															// 		  1: ڴдڲʱ, ڴÿռĬϸӦ, ֹڴʿ
+#define CTRL0_DDR4_REGS_DISABLE			bit(4)				// RW 0x0 DDRÿռر, Ч
+#define CTRL0_GMAC1_TEST_LPBK			bit(3)				// RW 0x0 GMAC1ӿloopbackزģʽʹ: 1: ʹloopbackزģʽ.
+#define CTRL0_GMAC0_TEST_LPBK			bit(2)				// RW 0x0 GMAC0ӿloopbackزģʽʹ: 1: ʹloopbackزģʽ.
+#define CTRL0_GMAC1_MII_SEL				bit(1)				// RW 0x0 GMAC1ӿMIIģʽѡ: 1: MIIӿģʽ; 0: RGMIIӿģʽ
+#define CTRL0_GMAC0_MII_SEL				bit(0)				// RW 0x0 GMAC0ӿMIIģʽѡ: 1: MIIӿģʽ; 0: RGMIIӿģʽ
+
+/**
+ * Chip Control1
+ */
+#define CHIP_CTRL1_BASE   				0x16000104
+#define CTRL1_LIO_IO_WIDTH				bit(25)				// RW 0x0 IOռ16λλλ: 1: 16λģʽ; 0: 8λģʽ.
+#define CTRL1_LIO_IO_COUNT_INIT_MASK	(0x1F<<20)			// RW 0x0 bit[24:20] IOռӳٳʼֵ
+#define CTRL1_LIO_IO_COUNT_INIT_SHIFT	20
+#define CTRL1_LIO_ROM_WIDTH				bit(19)				// RW 0x0 ROMռ16λλλ: 1: 16λģʽ; 0: 8λģʽ.
+#define CTRL1_LIO_ROM_COUNT_INIT_MASK	(0x1F<<14)			// RW 0x0 bit[18:14] ROMռӳٳʼֵ
+#define CTRL1_LIO_ROM_COUNT_INIT_SHIFT	14
+#define CTRL1_LIO_CLK_PERIOD_MASK		(0x03<<12)			// RW 0x0 bit[13:12] LIO߷ʵλӳٵʱ.
+#define CTRL1_LIO_CLK_PERIOD_SHIFT		12					// 00: 4; 01: 1; 10: 2; 11: 4.
+#define CTRL1_LIO_CLK_PERIOD_4			0
+#define CTRL1_LIO_CLK_PERIOD_1			(0x1<<12)
+#define CTRL1_LIO_CLK_PERIOD_2			(0x2<<12)
+#define CTRL1_IODMA_SPARE_MASK			(0xFF<<4)			// RW 0x0 bit[11:4] iodma
+#define CTRL1_IODMA_SPARE_SHIFT			4
+#define CTRL1_USB_FLUSH_IDLE_MASK		0x0F				// RW 0xf bit[3:0] write bufferǰ
+
+/**
+ * Chip Control2
+ */
+#define CHIP_CTRL2_BASE   				0x16000108
+#define CTRL2_PMU_DVFS_CLKDIV_MASK		(0x0F<<4)			// RW 0x0 bit[11:4] PLLʱƵ, λCLKDIV[7]Ϊʹλ(Ч):
+#define CTRL2_PMU_DVFS_CLKDIV_SHIFT		4					//					 ӦPLLʱòCLKDIV[6:0]: 0~127
+#define CTRL2_PMU_STPCLK				bit(2)				// RW 0x0 ʱӹضλ, ߵƽʱӹض.
+#define CTRL2_PMU_DVFS_CLKBYPASS		bit(1)				// RW 0x0 ʱBYPASSλ: 1: ʱBYPASSΪϵͳοʱ; 0: ʱΪPLLʱ.
+#define CTRL2_PMU_DVFS_EN				bit(0)				// RW 0x0 ̬Ƶѹ(DVFS)ʹλ, ߵƽЧ.
+
+/**
+ * Chip Control3
+ */
+#define CHIP_CTRL3_BASE   				0x1600010c
+#define CTRL3_APB_READ_UPGRADE			bit(29)				// RW 0x0 APB豸DMAڲ߶ȼʹλ(ߵƽЧ, Ĭϰ)
+#define CTRL3_DC_READ_UPGRADE			bit(28)				// RW 0x0 dcڲ߶ȼʹλ(ߵƽЧ, Ĭϰ)
+#define CTRL3_GMAC1_READ_UPGRADE		bit(27)				// RW 0x0 GMAC1ڲ߶ȼʹλ(ߵƽЧ, Ĭϰ)
+#define CTRL3_GMAC0_READ_UPGRADE		bit(26)				// RW 0x0 GMAC0ڲ߶ȼʹλ(ߵƽЧ, Ĭϰ)
+#define CTRL3_USB_READ_UPGRADE			bit(25)				// RW 0x0 USB0~1ڲ߶ȼʹλ(ߵƽЧ, Ĭϰ)
+#define CTRL3_APB_WRITE_UPGRADE			bit(21)				// RW 0x0 APB豸DMAڲдȼʹλ(ߵƽЧ, Ĭϰ)
+#define CTRL3_DC_WRITE_UPGRADE			bit(20)				// RW 0x0 dcڲдȼʹλ(ߵƽЧ, Ĭϰ)
+#define CTRL3_GMAC1_WRITE_UPGRADE		bit(19)				// RW 0x0 GMAC1ڲдȼʹλ(ߵƽЧ, Ĭϰ)
+#define CTRL3_GMAC0_WRITE_UPGRADE		bit(18)				// RW 0x0 GMAC0ڲдȼʹλ(ߵƽЧ, Ĭϰ)
+#define CTRL3_USB_WRITE_UPGRADE			bit(17)				// RW 0x0 USB0~1ڲдȼʹλ(ߵƽЧ, Ĭϰ)
+/*
+ * 1: CACHEٷ; 0: رCACHEٷ (IO豸CACHEʹλЧ)
+ */
+#define CTRL3_APB_COHERENT				bit(13)				// RW 0x0 APB豸DMAڲCACHEλ
+#define CTRL3_DC_COHERENT				bit(12)				// RW 0x0 dcڲCACHEλ
+#define CTRL3_GMAC1_COHERENT			bit(11)				// RW 0x0 GMAC1ڲCACHEλ
+#define CTRL3_GMAC0_COHERENT			bit(10)				// RW 0x0 GMAC0ڲCACHEλ
+#define CTRL3_USB_COHERENT				bit(9)				// RW 0x0 USB0~1ڲCACHEλ
+/*
+ * 1: ʹ豸CACHEЧ, öӦ豸coherentλCACHEٷ;
+ * 0: ر豸CACHE, Ӧ豸coherentλЧ, ʱ豸ͨڲߵַλ
+ * 	  (32λ)ѡǷCACHE(1:, 0:ر)
+ */
+#define CTRL3_APB_COHERENT_EN			bit(5)				// RW 0x0 APB豸DMAڲCACHEʹλ
+#define CTRL3_DC_COHERENT_EN			bit(4)				// RW 0x0 dcڲCACHEʹλ
+#define CTRL3_GMAC1_COHERENT_EN			bit(3)				// RW 0x0 GMAC1ڲCACHEʹλ
+#define CTRL3_GMAC0_COHERENT_EN			bit(2)				// RW 0x0 GMAC0豸ڲCACHEʹλ
+#define CTRL3_USB_COHERENT_EN			bit(1)				// RW 0x0 USB0~1豸ڲCACHEʹλ:
+
+/**
+ * Chip Control4
+ */
+#define CHIP_CTRL4_BASE   				0x16000110
+#define CTRL4_PAD_EMMC_MASK				(0x07<<26)			// RW 0x2 bit[28:26] EMMC PADͲ
+#define CTRL4_PAD_EMMC_SHIFT			26
+#define CTRL4_PAD_USB_MASK				(0x03<<24)			// RW 0x1 bit[25:24] USB PADͲ
+#define CTRL4_PAD_USB_SHIFT				24
+#define CTRL4_PAD_TIMER_MASK			(0x03<<22)			// RW 0x1 bit[23:22] TIMER PADͲ
+#define CTRL4_PAD_TIMER_SHIFT			22
+#define CTRL4_PAD_I2S_MASK				(0x03<<20)			// RW 0x1 bit[21:20] I2S PADͲ
+#define CTRL4_PAD_I2S_SHIFT				20
+#define CTRL4_PAD_SPI_MASK				(0x03<<18)			// RW 0x1 bit[19:18] SPI PADͲ
+#define CTRL4_PAD_SPI_SHIFT				18
+#define CTRL4_PAD_SDIO_MASK				(0x03<<16)			// RW 0x2 bit[17:16] SDIO PADͲ
+#define CTRL4_PAD_SDIO_SHIFT			16
+#define CTRL4_PAD_GMAC_MASK				(0x03<<14)			// RW 0x2 bit[15:14] GMAC PADͲ
+#define CTRL4_PAD_GMAC_SHIFT			14
+#define CTRL4_PAD_UART_MASK				(0x03<<12)			// RW 0x0 bit[13:12] UART PADͲ
+#define CTRL4_PAD_UART_SHIFT			12
+#define CTRL4_PAD_DVO_MASK				(0x03<<10)			// RW 0x2 bit[11:10] DVO PADͲ
+#define CTRL4_PAD_DVO_SHIFT				10
+#define CTRL4_PAD_JTAG_MASK				(0x03<<8)			// RW 0x0 bit[9:8] JTAG PADͲ
+#define CTRL4_PAD_JTAG_SHIFT			8
+#define CTRL4_APB_ORDER_EN				bit(5)				// RW 0x0 APB豸DMAڲдִʹλ, ߵƽЧ
+#define CTRL4_DC_ORDER_EN				bit(4)				// RW 0x0 DCڲдִʹλ, ߵƽЧ
+#define CTRL4_GMAC1_ORDER_EN			bit(3)				// RW 0x0 GMAC1ڲдִʹλ, ߵƽЧ
+#define CTRL4_GMAC0_ORDER_EN			bit(2)				// RW 0x0 GMAC0ڲдִʹλ, ߵƽЧ
+#define CTRL4_USB_ORDER_EN				bit(1)				// RW 0x0 USB0~1ڲдִʹλ, ߵƽЧ
+#define CTRL4_CPU_ORDER_EN				bit(0)				// RW 0x0 CPUڲдִʹλ, ߵƽЧ
+
+/**
+ * Chip Control5
+ */
+#define CHIP_CTRL5_BASE   				0x16000114
+/*
+ * 1: ʱſش; 0: ʱſعر.
+ */
+#define CTRL5_ATIMER_CLK_CTRL			bit(31)				// RW 0x1 atimerģʱſ
+#define CTRL5_HPET3_CLK_CTRL			bit(30)				// RW 0xf hpet0~3ģʱſ
+#define CTRL5_HPET2_CLK_CTRL			bit(29)
+#define CTRL5_HPET1_CLK_CTRL			bit(28)
+#define CTRL5_HPET0_CLK_CTRL			bit(27)
+#define CTRL5_I2C3_CLK_CTRL				bit(26)				// RW 0xf i2c0~3ģʱſ
+#define CTRL5_I2C2_CLK_CTRL				bit(25)
+#define CTRL5_I2C1_CLK_CTRL				bit(24)
+#define CTRL5_I2C0_CLK_CTRL				bit(23)
+#define CTRL5_CAN3_CLK_CTRL				bit(22)				// RW 0xf can0~3ģʱſ
+#define CTRL5_CAN2_CLK_CTRL				bit(21)
+#define CTRL5_CAN1_CLK_CTRL				bit(20)
+#define CTRL5_CAN0_CLK_CTRL				bit(19)
+#define CTRL5_SPI3_CLK_CTRL				bit(18)				// RW 0x3 spi2~3ģʱſ
+#define CTRL5_SPI2_CLK_CTRL				bit(17)
+#define CTRL5_DMA_CLK_CTRL				bit(16)				// RW 0x1 dmaģʱſ
+#define CTRL5_OTP_CLK_CTRL				bit(15)				// RW 0x1 otpģʱſ
+#define CTRL5_RTC_CLK_CTRL				bit(14)				// RW 0x1 rtcģʱſ
+#define CTRL5_WDT_CLK_CTRL				bit(13)				// RW 0x1 wdtģʱſ
+#define CTRL5_ADC_CLK_CTRL				bit(12)				// RW 0x1 adcģʱſ
+#define CTRL5_I2S_CLK_CTRL				bit(11)				// RW 0x1 i2sģʱſ
+#define CTRL5_GPIO_CLK_CTRL				bit(10)				// RW 0x1 gpioģʱſ
+#define CTRL5_OTG_CLK_CTRL				bit(9)				// RW 0x1 usb0(otg)ģʱſ
+#define CTRL5_USB_CLK_CTRL				bit(8)				// RW 0x1 usb1ģʱſ
+#define CTRL5_USBM_CLK_CTRL				bit(7)				// RW 0x1 usb0~1ģʱſ
+#define CTRL5_GMAC1_CLK_CTRL			bit(6)				// RW 0x1 gmac1ģʱſ
+#define CTRL5_GMAC0_CLK_CTRL			bit(5)				// RW 0x1 gmac0ģʱſ
+#define CTRL5_DC_CLK_CTRL				bit(4)				// RW 0x1 dcģʱſ
+#define CTRL5_LIO_CLK_CTRL				bit(3)				// RW 0x1 lioģʱſ
+#define CTRL5_SPI1_CLK_CTRL				bit(2)				// RW 0x1 spi1ģʱſ
+#define CTRL5_SPI0_CLK_CTRL				bit(1)				// RW 0x1 spi0ģʱſ
+#define CTRL5_DDR_CLK_CTRL				bit(0)				// RW 0x1 ddrģʱſ
+
+/**
+ * Chip Control6
+ */
+#define CHIP_CTRL6_BASE   				0x16000118
+/*
+ * 1: ʱſش; 0: ʱſعر.
+ */
+#define CTRL6_APBM_CLK_CTRL				bit(28)				// RW 0x1 apbȫģʱſ
+#define CTRL6_SDIOM_CLK_CTRL			bit(27)				// RW 0x1 sdioȫģʱſ
+#define CTRL6_SM4_CLK_CTRL				bit(26)				// RW 0x1 sm4ģʱſ
+#define CTRL6_SM3_CLK_CTRL				bit(25)				// RW 0x1 sm3ģʱſ
+#define CTRL6_DES_CLK_CTRL				bit(24)				// RW 0x1 desģʱſ
+#define CTRL6_AES_CLK_CTRL				bit(23)				// RW 0x1 aesģʱſ
+#define CTRL6_RNG_CLK_CTRL				bit(22)				// RW 0x1 rngģʱſ
+#define CTRL6_SM2_CLK_CTRL				bit(21)				// RW 0x1 sm2ģʱſ
+#define CTRL6_ENCDMA_CLK_CTRL			bit(20)				// RW 0x1 encdmaģʱſ
+#define CTRL6_CANRAM_CLK_CTRL			bit(19)				// RW 0x1 canramģʱſ
+#define CTRL6_CANBUF3_CLK_CTRL			bit(18)				// RW 0xf canbuf0~3ģʱſ
+#define CTRL6_CANBUF2_CLK_CTRL			bit(17)
+#define CTRL6_CANBUF1_CLK_CTRL			bit(16)
+#define CTRL6_CANBUF0_CLK_CTRL			bit(15)
+#define CTRL6_SDIO1_CLK_CTRL			bit(14)				// RW 0x3 sdio0~1ģʱſ
+#define CTRL6_SDIO0_CLK_CTRL			bit(13)
+#define CTRL6_UART9_CLK_CTRL			bit(12)				// RW 0x3ff uart0~9ģʱſ
+#define CTRL6_UART8_CLK_CTRL			bit(11)
+#define CTRL6_UART7_CLK_CTRL			bit(10)
+#define CTRL6_UART6_CLK_CTRL			bit(9)
+#define CTRL6_UART5_CLK_CTRL			bit(8)
+#define CTRL6_UART4_CLK_CTRL			bit(7)
+#define CTRL6_UART3_CLK_CTRL			bit(6)
+#define CTRL6_UART2_CLK_CTRL			bit(5)
+#define CTRL6_UART1_CLK_CTRL			bit(4)
+#define CTRL6_UART0_CLK_CTRL			bit(3)
+#define CTRL6_PWM_CLK_CTRL				bit(2)				// RW 0x1 pwmģʱſ
+#define CTRL6_BTIMER_CLK_CTRL			bit(1)				// RW 0x1 btimerģʱſ
+#define CTRL6_GTIMER_CLK_CTRL			bit(0)				// RW 0x1 gtimerģʱſ
+
+/**
+ * Chip Control7
+ */
+#define CHIP_CTRL7_BASE   				0x1600011c
+/*
+ * 1: λЧ; 0: λЧ.
+ */
+#define CTRL7_ATIMER_RST_CTRL			bit(31)				// RW 0x1 atimerģλ
+#define CTRL7_HPET3_RST_CTRL			bit(30)				// RW 0xf hpet0~3ģλ
+#define CTRL7_HPET2_RST_CTRL			bit(29)
+#define CTRL7_HPET1_RST_CTRL			bit(28)
+#define CTRL7_HPET0_RST_CTRL			bit(27)
+#define CTRL7_I2C3_RST_CTRL				bit(26)				// RW 0xf i2c0~3ģλ
+#define CTRL7_I2C2_RST_CTRL				bit(25)
+#define CTRL7_I2C1_RST_CTRL				bit(24)
+#define CTRL7_I2C0_RST_CTRL				bit(23)
+#define CTRL7_CAN3_RST_CTRL				bit(22)				// RW 0xf can0~3ģλ
+#define CTRL7_CAN2_RST_CTRL				bit(21)
+#define CTRL7_CAN1_RST_CTRL				bit(20)
+#define CTRL7_CAN0_RST_CTRL				bit(19)
+#define CTRL7_SPI3_RST_CTRL				bit(18)				// RW 0x3 spi2~3ģλ
+#define CTRL7_SPI2_RST_CTRL				bit(17)
+#define CTRL7_DMA_RST_CTRL				bit(16)				// RW 0x1 dmaģλ
+#define CTRL7_OTP_RST_CTRL				bit(15)				// RW 0x1 otpģλ
+#define CTRL7_RTC_RST_CTRL				bit(14)				// RW 0x1 rtcģλ
+#define CTRL7_WDT_RST_CTRL				bit(13)				// RW 0x1 wdtģλ
+#define CTRL7_ADC_RST_CTRL				bit(12)				// RW 0x1 adcģλ
+#define CTRL7_I2S_RST_CTRL				bit(11)				// RW 0x1 i2sģλ
+#define CTRL7_GPIO_RST_CTRL				bit(10)				// RW 0x1 gpioģλ
+#define CTRL7_OTG_RST_CTRL				bit(9)				// RW 0x1 usb0(otg)ģλ
+#define CTRL7_USB_RST_CTRL				bit(8)				// RW 0x1 usb1ģλ
+#define CTRL7_USBM_RST_CTRL				bit(7)				// RW 0x1 usbȫģλ
+#define CTRL7_GMAC1_RST_CTRL			bit(6)				// RW 0x1 gmac1ģλ
+#define CTRL7_GMAC0_RST_CTRL			bit(5)				// RW 0x1 gmac0ģλ
+#define CTRL7_DC_RST_CTRL				bit(4)				// RW 0x1 dcģλ
+#define CTRL7_LIO_RST_CTRL				bit(3)				// RW 0x1 lioģλ
+#define CTRL7_SPI1_RST_CTRL				bit(2)				// RW 0x1 spi1ģλ
+#define CTRL7_SPI0_RST_CTRL				bit(1)				// RW 0x1 spi0ģλ
+#define CTRL7_DDR_RST_CTRL				bit(0)				// RW 0x1 ddrģλ
+
+/**
+ * Chip Control8
+ */
+#define CHIP_CTRL8_BASE   				0x16000120
+/*
+ * 1: λЧ; 0: λЧ.
+ */
+#define CTRL8_APBM_RST_CTRL				bit(28)				// RW 0x1 apbȫģλ
+#define CTRL8_SDIOM_RST_CTRL			bit(27)				// RW 0x1 sdioȫģλ
+#define CTRL8_SM4_RST_CTRL				bit(26)				// RW 0x1 sm4ģλ
+#define CTRL8_SM3_RST_CTRL				bit(25)				// RW 0x1 sm3ģλ
+#define CTRL8_DES_RST_CTRL				bit(24)				// RW 0x1 desģλ
+#define CTRL8_AES_RST_CTRL				bit(23)				// RW 0x1 aesģλ
+#define CTRL8_RNG_RST_CTRL				bit(22)				// RW 0x1 rngģλ
+#define CTRL8_SM2_RST_CTRL				bit(21)				// RW 0x1 sm2ģλ
+#define CTRL8_ENCDMA_RST_CTRL			bit(20)				// RW 0x1 encdmaģλ
+#define CTRL8_CANRAM_RST_CTRL			bit(19)				// RW 0x1 canramģλ
+#define CTRL8_CANBUF3_RST_CTRL			bit(18)				// RW 0xf canbuf0~3ģλ
+#define CTRL8_CANBUF2_RST_CTRL			bit(17)
+#define CTRL8_CANBUF1_RST_CTRL			bit(16)
+#define CTRL8_CANBUF0_RST_CTRL			bit(15)
+#define CTRL8_SDIO1_RST_CTRL			bit(14)				// RW 0x3 sdio0~1ģλ
+#define CTRL8_SDIO0_RST_CTRL			bit(13)
+#define CTRL8_UART9_RST_CTRL			bit(12)				// RW 0x3ff uart0~9ģλ
+#define CTRL8_UART8_RST_CTRL			bit(11)
+#define CTRL8_UART7_RST_CTRL			bit(10)
+#define CTRL8_UART6_RST_CTRL			bit(9)
+#define CTRL8_UART5_RST_CTRL			bit(8)
+#define CTRL8_UART4_RST_CTRL			bit(7)
+#define CTRL8_UART3_RST_CTRL			bit(6)
+#define CTRL8_UART2_RST_CTRL			bit(5)
+#define CTRL8_UART1_RST_CTRL			bit(4)
+#define CTRL8_UART0_RST_CTRL			bit(3)
+#define CTRL8_PWM_RST_CTRL				bit(2)				// RW 0x1 pwmģλ
+#define CTRL8_BTIMER_RST_CTRL			bit(1)				// RW 0x1 btimerģλ
+#define CTRL8_GTIMER_RST_CTRL			bit(0)				// RW 0x1 gtimerģλ
+
+/**
+ * Chip Control13
+ */
+#define CHIP_CTRL13_BASE   				0x16000134
+/*
+ * 00: ͨ12;  01: ͨ34;  10: ͨ56;  11: ͨ78.
+ */
+#define CTRL13_UART7_DMA_MAP_MASK		(0x03<<30)			// RW 0x3 bit[31:30] UART7ģDMAͨ
+#define CTRL13_UART7_DMA_MAP_SHIFT		30
+#define CTRL13_UART6_DMA_MAP_MASK		(0x03<<28)			// RW 0x2 bit[29:28] UART6ģDMAͨ
+#define CTRL13_UART6_DMA_MAP_SHIFT		28
+#define CTRL13_UART5_DMA_MAP_MASK		(0x03<<26)			// RW 0x2 bit[27:26] UART5ģDMAͨ
+#define CTRL13_UART5_DMA_MAP_SHIFT		26
+#define CTRL13_UART4_DMA_MAP_MASK		(0x03<<24)			// RW 0x2 bit[25:24] UART4ģDMAͨ
+#define CTRL13_UART4_DMA_MAP_SHIFT		24
+#define CTRL13_UART3_DMA_MAP_MASK		(0x03<<22)			// RW 0x2 bit[23:22] UART3ģDMAͨ
+#define CTRL13_UART3_DMA_MAP_SHIFT		22
+#define CTRL13_UART2_DMA_MAP_MASK		(0x03<<20)			// RW 0x2 bit[21:20] UART2ģDMAͨ
+#define CTRL13_UART2_DMA_MAP_SHIFT		20
+#define CTRL13_UART1_DMA_MAP_MASK		(0x03<<18)			// RW 0x2 bit[19:18] UART1ģDMAͨ
+#define CTRL13_UART1_DMA_MAP_SHIFT		18
+#define CTRL13_UART0_DMA_MAP_MASK		(0x03<<16)			// RW 0x2 bit[17:16] UART0ģDMAͨ
+#define CTRL13_UART0_DMA_MAP_SHIFT		16
+//#define CTRL13_UARTx_DMA_MAP(uart, dma)	((dma)<<((uart)*2+16))	/* uart: 0~7, DMA: 0~3 */
+/*
+ * 00: ѡӽDMAͨ0; 01: ѡӽDMAͨ1; : Ч
+ */
+#define CTRL13_SM3_DMA_MAP_MASK			(0x03<<12)			// RW 0x0 bit[13:12] SM3ģDMAͨ·
+#define CTRL13_SM3_DMA_MAP_SHIFT		12
+#define CTRL13_SM4_R_DMA_MAP_MASK		(0x03<<10)			// RW 0x1 bit[11:10] SM4ģDMAͨ·
+#define CTRL13_SM4_R_DMA_MAP_SHIFT		10
+#define CTRL13_SM4_W_DMA_MAP_MASK		(0x03<<8)			// RW 0x0 bit[9:8] SM4ģдDMAͨ·
+#define CTRL13_SM4_W_DMA_MAP_SHIFT		8
+#define CTRL13_DES_R_DMA_MAP_MASK		(0x03<<6)			// RW 0x1 bit[7:6] DESģDMAͨ·
+#define CTRL13_DES_R_DMA_MAP_SHIFT		6
+#define CTRL13_DES_W_DMA_MAP_MASK		(0x03<<4)			// RW 0x0 bit[5:4] DESģдDMAͨ·
+#define CTRL13_DES_W_DMA_MAP_SHIFT		4
+#define CTRL13_AES_R_DMA_MAP_MASK		(0x03<<2)			// RW 0x1 bit[3:2] AESģDMAͨ·
+#define CTRL13_AES_R_DMA_MAP_SHIFT		2
+#define CTRL13_AES_W_DMA_MAP_MASK		(0x03<<0)			// RW 0x0 bit[1:0] AESģдDMAͨ·
+#define CTRL13_AES_W_DMA_MAP_SHIFT		0
+
+/**
+ * Chip Control14
+ */
+#define CHIP_CTRL14_BASE   				0x16000138
+/*
+ * RX ӦDMAͨΪ000-111: ͨDMAͨ1-8.
+ */
+#define CTRL14_CAN3_DMA_MAP_MASK		(0x03<<30)			// RW 0x3 bit[31:30] CAN3ģDMAͨӳ, XXX 2λ bit[1:0]
+#define CTRL14_CAN3_DMA_MAP_SHIFT		30
+#define CTRL14_CAN2_DMA_MAP_MASK		(0x07<<27)			// RW 0x2 bit[29:27] CAN2ģDMAͨӳ
+#define CTRL14_CAN2_DMA_MAP_SHIFT		27
+#define CTRL14_CAN1_DMA_MAP_MASK		(0x07<<24)			// RW 0x1 bit[26:24] CAN1ģDMAͨӳ
+#define CTRL14_CAN1_DMA_MAP_SHIFT		24
+#define CTRL14_CAN0_DMA_MAP_MASK		(0x07<<21)			// RW 0x0 bit[23:21] CAN0ģDMAͨӳ
+#define CTRL14_CAN0_DMA_MAP_SHIFT		21
+#define CTRL14_ADC_DMA_MAP_MASK			(0x07<<18)			// RW 0x0 bit[20:18] ADCģDMAͨӳ
+#define CTRL14_ADC_DMA_MAP_SHIFT		18
+/*
+ * RXTXӦͨDMAֱͨΪ:
+ * 00: ͨ12;  01: ͨ34; 10: ͨ56;  11: ͨ78.
+ */
+#define CTRL14_I2S_DMA_MAP_MASK			(0x03<<16)			// RW 0x0 bit[17:16] I2SģDMAͨӳ
+#define CTRL14_I2S_DMA_MAP_SHIFT		16
+#define CTRL14_SPI3_DMA_MAP_MASK		(0x03<<14)			// RW 0x1 bit[15:14] SPI3ģDMAͨӳ
+#define CTRL14_SPI3_DMA_MAP_SHIFT		14
+#define CTRL14_SPI2_DMA_MAP_MASK		(0x03<<12)			// RW 0x0 bit[13:12] SPI2ģDMAͨӳ
+#define CTRL14_SPI2_DMA_MAP_SHIFT		12
+#define CTRL14_I2C3_DMA_MAP_MASK		(0x03<<10)			// RW 0x3 bit[11:10] I2C3ģDMAͨӳ
+#define CTRL14_I2C3_DMA_MAP_SHIFT		10
+#define CTRL14_I2C2_DMA_MAP_MASK		(0x03<<8)			// RW 0x2 bit[9:8] I2C2ģDMAͨӳ
+#define CTRL14_I2C2_DMA_MAP_SHIFT		8
+#define CTRL14_I2C1_DMA_MAP_MASK		(0x03<<6)			// RW 0x1 bit[7:6] I2C1ģDMAͨӳ
+#define CTRL14_I2C1_DMA_MAP_SHIFT		6
+#define CTRL14_I2C0_DMA_MAP_MASK		(0x03<<4)			// RW 0x0 bit[5:4] I2C0ģDMAͨӳ
+#define CTRL14_I2C0_DMA_MAP_SHIFT		4
+#define CTRL14_UART9_DMA_MAP_MASK		(0x03<<2)			// RW 0x3 bit[3:2] UART9ģDMAͨӳ
+#define CTRL14_UART9_DMA_MAP_SHIFT		2
+#define CTRL14_UART8_DMA_MAP_MASK		(0x03<<0)			// RW 0x2 bit[1:0] UART8ģDMAͨӳ
+#define CTRL14_UART8_DMA_MAP_SHIFT		0
+
+/**
+ * Chip Control15
+ */
+#define CHIP_CTRL15_BASE   				0x1600013c
+#define CTRL15_ID_READ_DISABLE			bit(31)				// RW 0x0 IDʹ
+#define CTRL15_CAN3_DMA_MAP_HI			bit(0)				// RW 0x0 CAN3ģDMAͨӳ, XXX 1λ.
+
+/**
+ * Chip Sample0
+ */
+#define CHIP_SAMP0_BASE					0x16000140
+#define SAMP0_EMMC_PADTYPE				bit(6)				// RO 0x0 EMMC0 PADƽ. 0:3.3V-IO, 1:1.8V-IO
+#define SAMP0_USB_REFCLKMODE			bit(5)				// RO 0x0 usbοʱģʽ.
+															//		  0:ڲοʱ(ʱƵ20MHz)1:ⲿPAD(ʱƵ20/24MHz)
+#define SAMP0_SDIO1_MODE				bit(4)				// RO 0x0 SDIO1ģʽ. 0=SDIOģʽ, 1=EMMCģʽ
+#define SAMP0_SDIO0_MODE				bit(3)				// RO 0x0 SDIO0ģʽ. 0=SDIOģʽ, 1=EMMCģʽ
+#define SAMP0_CLK_SEL_MASK				(0x03<<1)			// RO 0x0 bit[2:1] оƬڲPLLʱϵѡ
+#define SAMP0_CLK_SEL_HW_LO				0					//		  00: ӲƵʱģʽ, PLLյƵòʱ;
+#define SAMP0_CLK_SEL_HW_HI				(0x01<<1)			//		  01: ӲƵʱģʽ, PLLոƵòʱ;
+#define SAMP0_CLK_SEL_SW				(0x02<<1)			//		  10: ģʽ, PLLѡʱ;
+#define SAMP0_CLK_SEL_BYPASS			(0x03<<1)			//		  11: Ӳbypassģʽ, PLLʱȫʹⲿϵͳʱ.
+#define SAMP0_BOOT_SEL					bit(0)				// RO 0x0 оƬѡʽ: 0: SPI; 1: SDIO.
+
+/**
+ * Chip Sample2
+ */
+#define CHIP_SAMP2_BASE					0x16000148
+#define SAMP2_DDR4_ECC_ADDR_LO_MASK		0xFFFF0000			// RO DDR bit[31:16] ECCַ[15:0]
+#define SAMP2_DDR4_ECC_ADDR_LO_SHIFT	16
+#define SAMP2_DDR4_ECC_COUNT_MASK		0xFFFF				// RO DDR bit[15:0] ECC
+
+/**
+ * Chip Sample3
+ */
+#define CHIP_SAMP3_BASE					0x1600014c
+#define SAMP3_DDR4_ECC_ADDR_HI_MASK		0xFFFF				// RO DDR bit[15:0] ECCַ[31:16]
+
+#define	DDR_ECC_ERR_ADDR				((READ_REG32(CHIP_SAMP2_BASE)>>16) | (READ_REG32(CHIP_SAMP3_BASE)<<16))
+#define	DDR_ECC_ERR_COUNT				(READ_REG32(CHIP_SAMP2_BASE) & SAMP2_DDR4_ECC_COUNT_MASK)
+
+/**
+ * Chip Counter0
+ */
+#define CHIP_HPT_LO_BASE				0x16000150			// RW 0x0 64λ߾ʱӼ32λ
+
+/**
+ * Chip Counter1
+ */
+#define CHIP_HPT_HI_BASE				0x16000154			// RW 0x0 64λ߾ʱӼ32λ
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * NODE PLL ʱüĴ0
+ */
+#define NODE_PLL0_BASE					0x16000400
+#define NODE_PLL0_ODIV_MASK				(0x7F<<24)			// RW 0x0 bit[30:24] NODE PLLƵϵ: 0~127
+#define NODE_PLL0_ODIV_SHIFT			24
+#define NODE_PLL0_LOOPC_MASK			(0x1FF<<15)			// RW 0x0 bit[23:15] PLLƵϵ: 0~511
+#define NODE_PLL0_LOOPC_SHIFT			15
+#define NODE_PLL0_REFC_MASK				(0x7F<<8)			// RW 0x0 bit[14:8] PLLοʱӷƵϵ: 0~127
+#define NODE_PLL0_REFC_SHIFT			8
+#define NODE_PLL0_LOCKED				bit(7)				// RO 0x0 PLL־, 1
+#define NODE_PLL0_PD					bit(5)				// RW 0x0 PLLص, 1ص
+#define NODE_PLL0_BYPASS				bit(4)				// RW 0x0 PLLʱbypass, 1bypass
+#define NODE_PLL0_SOFT_SET				bit(3)				// RW 0x0 PLL, 1
+#define NODE_PLL0_SEL_I2S				bit(2)				// RW 0x0 I2SѡPLLʱ, 1ѡPLLʱ
+#define NODE_PLL0_SEL_GMAC				bit(1)				// RW 0x0 GMACѡPLLʱ, 1ѡPLLʱ
+#define NODE_PLL0_SEL_NODE				bit(0)				// RW 0x0 NODEѡPLLʱ, 1ѡPLLʱ
+
+/**
+ * NODE PLL ʱüĴ1
+ */
+#define NODE_PLL1_BASE					0x16000404
+#define NODE_PLL1_LDO_MASK				(0x07<<22)			// RW 0x3 bit[24:22] PLL LDO, ȱʡֵ
+#define NODE_PLL1_LDO_SHIFT				22
+#define NODE_PLL1_LDO_BYPASS			bit(21)				// RW 0x0 PLL LDO BYPASS, ȱʡֵ
+#define NODE_PLL1_LDO_EN				bit(20)				// RW 0x1 PLL LDO ʹ, ȱʡֵ
+#define NODE_PLL1_ODIV_I2S_MASK			(0x7F<<8)			// RW 0x0 bit[14:8] I2S PLLƵϵ: 0~127
+#define NODE_PLL1_ODIV_I2S_SHIFT		8
+#define NODE_PLL1_ODIV_GMAC_MASK		(0x7F<<0)			// RW 0x0 bit[6:0] GMAC PLLƵϵ: 0~127
+
+/**
+ * DDR PLL ʱüĴ0
+ */
+#define DDR_PLL0_BASE					0x16000408
+#define DDR_PLL0_ODIV_MASK				(0x7F<<24)			// RW 0x0 bit[30:24] DDR PLLƵϵ: 0~127
+#define DDR_PLL0_ODIV_SHIFT				24
+#define DDR_PLL0_LOOPC_MASK				(0x1FF<<15)			// RW 0x0 bit[23:15] PLLƵϵ: 0~511
+#define DDR_PLL0_LOOPC_SHIFT			15
+#define DDR_PLL0_REFC_MASK				(0x7F<<8)			// RW 0x0 bit[14:8] PLLοʱӷƵϵ: 0~127
+#define DDR_PLL0_REFC_SHIFT				8
+#define DDR_PLL0_LOCKED					bit(7)				// RO 0x0 PLL־, 1
+#define DDR_PLL0_PD						bit(5)				// RW 0x0 PLLص, 1ص
+#define DDR_PLL0_BYPASS					bit(4)				// RW 0x0 PLLʱbypass, 1bypass
+#define DDR_PLL0_SOFT_SET				bit(3)				// RW 0x0 PLL, 1
+#define DDR_PLL0_SEL_DEV				bit(2)				// RW 0x0 DEVICEѡPLLʱ, 1ѡPLLʱ
+#define DDR_PLL0_SEL_NETWORK			bit(1)				// RW 0x0 NETWORKѡPLLʱ, 1ѡPLLʱ
+#define DDR_PLL0_SEL_DDR				bit(0)				// RW 0x0 DDRѡPLLʱ, 1ѡPLLʱ
+
+/**
+ * DDR PLL ʱüĴ1
+ */
+#define DDR_PLL1_BASE					0x1600040c
+#define DDR_PLL1_LDO_MASK				(0x07<<22)			// RW 0x3 bit[24:22] PLL LDO, ȱʡֵ
+#define DDR_PLL1_LDO_SHIFT				22
+#define DDR_PLL1_LDO_BYPASS				bit(21)				// RW 0x0 PLL LDO BYPASS, ȱʡֵ
+#define DDR_PLL1_LDO_EN					bit(20)				// RW 0x1 PLL LDO ʹ, ȱʡֵ
+#define DDR_PLL1_MEMDIV_MODE_MASK		(0x03<<18)			// RW 0x1 bit[19:18] DDR ʱӷƵģʽ
+#define DDR_PLL1_MEMDIV_MODE_SHIFT		18
+#define DDR_PLL1_SOFT_MC_RSTn			bit(17)				// RW 0x1 DDRλ
+#define DDR_PLL1_MEMDIV_RSTn			bit(16)				// RW 0x1 DDRƵλ
+#define DDR_PLL1_ODIV_DEV_MASK			(0x7F<<8)			// RW 0x0 bit[14:8] I2S PLLƵϵ: 0~127
+#define DDR_PLL1_ODIV_DEV_SHIFT			8
+#define DDR_PLL1_ODIV_NETWORK_MASK		(0x7F<<0)			// RW 0x0 bit[6:0] NETWORK PLLƵϵ: 0~127
+
+/**
+ * PIX PLL ʱüĴ0
+ */
+#define PIX_PLL0_BASE					0x16000410
+#define PIX_PLL0_ODIV_MASK				(0x7F<<24)			// RW 0x0 bit[30:24] PIX PLLƵϵ: 0~127
+#define PIX_PLL0_ODIV_SHIFT				24
+#define PIX_PLL0_LOOPC_MASK				(0x1FF<<15)			// RW 0x0 bit[23:15] PLLƵϵ: 0~511
+#define PIX_PLL0_LOOPC_SHIFT			15
+#define PIX_PLL0_REFC_MASK				(0x7F<<8)			// RW 0x0 bit[14:8] PLLοʱӷƵϵ: 0~127
+#define PIX_PLL0_REFC_SHIFT				8
+#define PIX_PLL0_LOCKED					bit(7)				// RO 0x0 PLL־, 1
+#define PIX_PLL0_PD						bit(5)				// RW 0x0 PLLص, 1ص
+#define PIX_PLL0_BYPASS					bit(4)				// RW 0x0 PLLʱbypass, 1bypass
+#define PIX_PLL0_SOFT_SET				bit(3)				// RW 0x0 PLL, 1
+#define PIX_PLL0_SEL_GMACBP				bit(1)				// RW 0x0 GMAC-BACKUPѡPLLʱ, 1ѡPLLʱ
+#define PIX_PLL0_SEL_PIX				bit(0)				// RW 0x0 PIXʾѡPLLʱ, 1ѡPLLʱ
+
+/**
+ * PIX PLL ʱüĴ1
+ */
+#define PIX_PLL1_BASE					0x16000414
+#define PIX_PLL1_LDO_MASK				(0x7F<<22)			// RW 0x3 bit[24:22] PLL LDO, ȱʡֵ
+#define PIX_PLL1_LDO_SHIFT				22
+#define PIX_PLL1_LDO_BYPASS				bit(21)				// RW 0x0 PLL LDO BYPASS, ȱʡֵ
+#define PIX_PLL1_LDO_EN					bit(20)				// RW 0x1 PLL LDO ʹ, ȱʡֵ
+#define PIX_PLL1_ODIV_GMACBP_MASK		(0x7F<<0)			// RW 0x0 bit[6:0] GMAC-BACKIP PLLƵϵ: 0~127
+
+/**
+ * 豸ʱӷƵüĴ
+ *
+ * 豸ʱӷƵüĴ, ֱӦַƵģʽ(SDIO Ƶ):
+ * (1) freq_mode=0, 豸ʱӷƵ㹫ʽΪ: fout=fin*(freqscale[2:0]+1)/8;
+ * (2) freq_mode=1, 豸ʱӷƵ㹫ʽΪ: fout=fin/(freqscale[2:0]+1).
+ *
+ */
+#define FREQSCALE_BASE					0x16000420
+#define FREQSCALE_SDIO_MASK				(0x0F<<24)			// RW 0x1 bit[27:24] SDIOʱӷϵ(CLK/freqscale[27:24]):
+#define FREQSCALE_SDIO_SHIFT			24					// 		  -ӦSDIOʱƵϵ: 0~15(0/1Ƶ)
+#define FREQSCALE_I2S_MODE				bit(23)				// RW     i2s_freqscale[3]:JBIGʱӷģʽfreq_mode;
+#define FREQSCALE_I2S_MASK				(0x07<<20)			// RW 0x7 bit[22:20] SDIOʱƵϵ: 0~7
+#define FREQSCALE_I2S_SHIFT				20
+#define FREQSCALE_APB_MODE				bit(19)				// RW     apb_freqscale[3]:APBʱӷģʽfreq_mode;
+#define FREQSCALE_APB_MASK				(0x07<<16)			// RW 0x7 bit[18:16] APBʱƵϵ: 0~7
+#define FREQSCALE_APB_SHIFT				16
+#define FREQSCALE_USB_MODE				bit(15)				// RW     APBʱӷģʽfreq_mode;
+#define FREQSCALE_USB_MASK				(0x07<<12)			// RW 0x7 bit[14:12] APBʱƵϵ: 0~7
+#define FREQSCALE_USB_SHIFT				12
+#define FREQSCALE_BOOT_MODE				bit(11)				// RW	  BOOTʱӷģʽfreq_mode;
+#define FREQSCALE_BOOT_MASK				(0x07<<8)			// RW 0x7 bit[10:8] BOOTʱƵϵ: 0~7
+#define FREQSCALE_BOOT_SHIFT			8
+#define FREQSCALE_PIX_MODE				bit(7)				// RW     USBʱӷģʽfreq_mode;
+#define FREQSCALE_PIX_MASK				(0x07<<4)			// RW 0x7 bit[6:4] USBʱƵϵ: 0~7
+#define FREQSCALE_PIX_SHIFT				4
+#define FREQSCALE_NODE_MODE				bit(3)				// RW     NODEʱӷģʽfreq_mode;
+#define FREQSCALE_NODE_MASK				0x07				// RW 0x7 bit[3:0] NODEʱƵϵ: 0~7
+
+/**
+ * 豸ʱʹüĴ
+ */
+#define DEV_CLKEN_BASE					0x16000424
+#define DEV_CLKEN_GMAC					bit(8)				// RW 0x1 gmacģʱԴѡ: 1: ѡSOC-PLLʱ; 0: ѡGMACBP-PLLʱ
+#define DEV_CLKEN_PIX					bit(6)				// RW 0x1 pixʾģʱʹ: 1: ʱʹ; 0: ʱر
+#define DEV_CLKEN_I2S					bit(5)				// RW 0x1 i2sģʱʹ: 1: ʱʹ; 0: ʱر
+#define DEV_CLKEN_SDIO					bit(4)				// RW 0x1 sdioģʱʹ: 1: ʱʹ; 0: ʱر
+#define DEV_CLKEN_APB					bit(3)				// RW 0x1 bootģʱʹ: 1: ʱʹ; 0: ʱر
+#define DEV_CLKEN_USB					bit(2)				// RW 0x1 usbģʱʹ: 1: ʱʹ; 0: ʱر
+#define DEV_CLKEN_BOOT					bit(1)				// RW 0x1 bootģʱʹ: 1: ʱʹ; 0: ʱر
+#define DEV_CLKEN_NODE					bit(0)				// RW 0x1 nodeģʱʹ: 1: ʱʹ; 0: ʱر
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * GPIO üĴ
+ *
+ * 00: ΪGPIO; 01: һ; 10: ڶ;  11: .
+ *
+ */
+#define GPIO_MUX_BASE                   0x16000490
+#define GPIO_MUX_ADDR(n)                (GPIO_MUX_BASE+(n)*4)
+
+#define GPIO_MUX_0_15					0x16000490			// GPIO0~15üĴ
+#define GPIO_MUX_16_31					0x16000494			// GPIO16~31üĴ
+#define GPIO_MUX_32_47					0x16000498			// GPIO32~47üĴ
+#define GPIO_MUX_48_63					0x1600049c			// GPIO48~63üĴ
+#define GPIO_MUX_64_79					0x160004a0			// GPIO64~79üĴ
+#define GPIO_MUX_80_95					0x160004a4			// GPIO80~95üĴ
+#define GPIO_MUX_96_111					0x160004a8			// GPIO96~111üĴ
+
+/**
+ * USB PHY üĴ
+ */
+#define USB_PHY_CFG0_BASE				0x16000500			// USB PHY üĴ0, USB ӿ0ĵ, ɿUSB-PHY ֲĴ.
+#define USB_PHY_CFG1_BASE				0x16000504			// USB PHY üĴ0, USB ӿ1ĵ, ɿUSB-PHY ֲĴ.
+
+#define USB_PHY_CFG2_BASE				0x16000508
+#define USB_CFG2_OTG_SUSPEND_CONFIG		bit(31)				// R/W 0 OTG˿ڹλ, Ч
+#define USB_CFG2_USB_SUSPEND_CONFIG		bit(30)				// R/W 0 USB˿ڹλ, Ч
+#define USB_CFG2_OTG_SUSPEND_SOFTEN		bit(29)				// R/W 1 OTG˿ڹʹλ, Ч
+#define USB_CFG2_USB_SUSPEND_SOFTEN		bit(28)				// R/W 1 USB˿ڹʹλ, Ч
+#define USB_CFG2_PHY_POR				bit(27)				// R/W 0 USB˿ڸλλ, Ч
+#define USB_CFG2_FS_DATA_MODE			bit(18)				// R/W 0 FSģʽ
+#define USB_CFG2_OTG_PULLDOWN_SOFTEN	bit(17)				// R/W 0 OTG˿ģʽʹ. 0- ر; 1- ʹ.
+#define USB_CFG2_OTG_OPMODE_SOFTEN		bit(16)				// R/W 0 OTG˿ڲģʽʹ. 0- ر; 1- ʹ.
+#define USB_CFG2_OTG_OPMODE0_MASK		(0x03<<14)			// R/W 0 bit[15: 14] OTG˿ڲģʽ
+#define USB_CFG2_OTG_OPMODE0_SHIFT		14
+#define USB_CFG2_DP1_PULLDOWN			bit(11)				// R/W 0 USB˿dp˿ʹ. 1: D+ʹ; 0: D+ر
+#define USB_CFG2_DM1_PULLDOWN			bit(10)				// R/W 0 USB˿dm˿ʹ. 1: D-ʹ; 0: D-ر
+#define USB_CFG2_DP0_PULLDOWN			bit(9)				// R/W 0 OTG˿dp˿ʹ. 1: D+ʹ; 0: D+ر
+#define USB_CFG2_DM0_PULLDOWN			bit(8)				// R/W 0 OTG˿dm˿ʹ. 1: D-ʹ; 0: D-ر
+#define USB_CFG2_PHY_CLKSEL				bit(3)				// R/W 1 USB˿ڲοʱģʽѡλ: 0-24MHzοʱ; 1-20MHzοʱ.
+#define USB_CFG2_USB_RESETn				bit(1)				// R/W 0 USB˿ڸλλ: 0- λЧ; 1- λ.
+#define USB_CFG2_OTG_RESETn				bit(0)				// R/W 0 OTG˿ڸλλ: 0- λЧ; 1- λ.
+
+//-------------------------------------------------------------------------------------------------
+// жü·
+//-------------------------------------------------------------------------------------------------
+
+#if !USE_EXTINT
+
+#define CORE_IPISR 						0x16001000			// RO NA ˵IPI_Status Ĵ
+#define CORE_IPIEN 						0x16001004			// RW 0x0 ˵IPI_Enalbe Ĵ
+#define CORE_IPISET 					0x16001008			// WO NA ˵IPI_Set Ĵ
+#define CORE_IPI_CLR 					0x1600100c			// WO NA ˵IPI_Clear Ĵ
+#define CORE_INTISR0 					0x16001040			// RO NA ·ɸCORE ĵ32 λж״̬
+#define CORE_INTISR1					0x16001048			// RO NA ·ɸCORE ĸ32 λж״̬
+
+#define INTC_CORE_ISR0					CORE_INTISR0		// CORE_INTISR0 ·ɸCOREĵ32λж״̬
+#define INTC_ISR0						0x16001044			// INTISR0 32λж״̬Ĵ
+#define INTC_CORE_ISR1					CORE_INTISR1		// CORE_INTISR1 ·ɸCOREĸ32λж״̬
+#define INTC_ISR1						0x1600104c			// INTISR1 32λж״̬Ĵ
+
+#define INTC_ENTRY_0_7					0x16001400			// ENTRY0_0 8λж·ɼĴ[0--7]
+#define INTC_ENTRY_8_15					0x16001408			// ENTRY8_0 8λж·ɼĴ[8--15]
+#define INTC_ENTRY_16_23				0x16001410			// ENTRY16_0 8λж·ɼĴ[16--23]
+#define INTC_ENTRY_24_31				0x16001418			// ENTRY24_0 8λж·ɼĴ[24--31]
+
+#define INTC0_SR_BASE					0x16001420			// INTISR_0 32λж״̬Ĵ
+#define INTC0_EN_BASE					0x16001424			// INTIEN_0 32λжʹ״̬Ĵ
+#define INTC0_SET_BASE					0x16001428			// INTSET_0 32λʹܼĴ
+#define INTC0_CLR_BASE					0x1600142c			// INTCLR_0 32λжĴ, ʹܼĴ崥ж
+#define INTC0_POL_BASE					0x16001430			// INTPOL_0 32λüĴ(ƽж)
+#define INTC0_EDGE_BASE					0x16001434			// INTEDGE_0 32λʽĴ(1: 崥; 0: ƽ)
+
+#define INTC_ENTRY_32_39				0x16001440			// ENTRY0_1 8λж·ɼĴ[32--39]
+#define INTC_ENTRY_40_47				0x16001448			// ENTRY8_1 8λж·ɼĴ[40--47]
+#define INTC_ENTRY_48_55				0x16001450			// ENTRY16_1 8λж·ɼĴ[48--55]
+#define INTC_ENTRY_56_63				0x16001458			// ENTRY24_1 8λж·ɼĴ[56--63]
+
+#define INTC1_SR_BASE					0x16001460			// INTISR_1 32λж״̬Ĵ
+#define INTC1_EN_BASE					0x16001464			// INTIEN_1 32λжʹ״̬Ĵ
+#define INTC1_SET_BASE					0x16001468			// INTSET_1 32λʹܼĴ
+#define INTC1_CLR_BASE					0x1600146c			// INTCLR_1 32λжĴ, ʹܼĴ崥ж
+#define INTC1_POL_BASE					0x16001470			// INTPOL_1 32λüĴ(ƽж)
+#define INTC1_EDGE_BASE					0x16001474			// INTEDGE_1 32λʽĴ(1: 崥; 0: ƽ)
+
+/*
+ * жϼĴ(n>=0 && n<=1)
+ */
+#define INTC_SR(n)                      (INTC0_SR_BASE  + n*0x40)
+#define INTC_EN(n)                      (INTC0_EN_BASE  + n*0x40)
+#define INTC_SET(n)                     (INTC0_SET_BASE + n*0x40)
+#define INTC_CLR(n)                     (INTC0_CLR_BASE + n*0x40)
+#define INTC_POL(n)                     (INTC0_POL_BASE + n*0x40)
+#define INTC_EDGE(n)                    (INTC0_EDGE_BASE+ n*0x40)
+
+/**
+ * ͳжλ
+ */
+#define INTC0_UART0_BIT					bit(0)
+#define INTC0_UART1_BIT					bit(1)
+#define INTC0_UART_2_5_BIT				bit(2)
+#define INTC0_UART_6_9_BIT				bit(3)
+#define INTC0_I2C_0_1_BIT				bit(4)
+#define INTC0_I2C_2_3_BIT				bit(5)
+#define INTC0_SPI2_BIT					bit(6)
+#define INTC0_SPI3_BIT					bit(7)
+#define INTC0_CAN0_BIT					bit(8)
+#define INTC0_CAN1_BIT					bit(9)
+#define INTC0_CAN2_BIT					bit(10)
+#define INTC0_CAN3_BIT					bit(11)
+#define INTC0_I2S_BIT					bit(12)
+#define INTC0_ATIMER_BIT				bit(13)
+#define INTC0_GTIMER_BIT				bit(14)
+#define INTC0_BTIMER_BIT				bit(15)
+#define INTC0_PWM_0_1_BIT				bit(16)
+#define INTC0_PWM_2_3_BIT				bit(17)
+#define INTC0_ADC_BIT					bit(18)
+#define INTC0_HPET0_BIT					bit(19)
+#define INTC0_HPET1_BIT					bit(20)
+#define INTC0_HPET2_BIT					bit(21)
+#define INTC0_HPET3_BIT					bit(22)
+#define INTC0_DMA0_BIT					bit(23)
+#define INTC0_DMA1_BIT					bit(24)
+#define INTC0_DMA2_BIT					bit(25)
+#define INTC0_DMA3_BIT					bit(26)
+#define INTC0_DMA4_BIT					bit(27)
+#define INTC0_DMA5_BIT					bit(28)
+#define INTC0_DMA6_BIT					bit(29)
+#define INTC0_DMA7_BIT					bit(30)
+#define INTC0_SDIO0_BIT					bit(31)
+
+#define INTC1_SDIO1_BIT					bit(0)
+#define INTC1_SDIO0_DMA_BIT				bit(1)
+#define INTC1_SDIO1_DMA_BIT				bit(2)
+#define INTC1_ENCRYPT_DMA_BIT			bit(3)
+#define INTC1_AES_BIT					bit(4)
+#define INTC1_DES_BIT					bit(5)
+#define INTC1_SM3_BIT					bit(6)
+#define INTC1_SM4_BIT					bit(7)
+#define INTC1_RTC_BIT					bit(8)
+#define INTC1_TOY_BIT					bit(9)
+#define INTC1_RTC_TICK_BIT				bit(10)
+#define INTC1_TOY_TICK_BIT				bit(11)
+#define INTC1_SPI0_BIT					bit(12)
+#define INTC1_SPI1_BIT					bit(13)
+#define INTC1_EHCI_BIT					bit(14)
+#define INTC1_OHCI_BIT					bit(15)
+#define INTC1_OTG_BIT					bit(16)
+#define INTC1_GMAC0_BIT					bit(17)
+#define INTC1_GMAC1_BIT					bit(18)
+#define INTC1_DC_BIT					bit(19)
+#define INTC1_THSENS_BIT				bit(20)
+#define INTC1_GPIO_0_15_BIT				bit(21)
+#define INTC1_GPIO_16_31_BIT			bit(22)
+#define INTC1_GPIO_32_47_BIT			bit(23)
+#define INTC1_GPIO_48_63_BIT			bit(24)
+#define INTC1_GPIO_64_79_BIT			bit(25)
+#define INTC1_GPIO_80_95_BIT			bit(26)
+#define INTC1_GPIO_96_105_BIT			bit(27)
+#define INTC1_DDR_ECC0_BIT				bit(29)
+#define INTC1_DDR_ECC1_BIT				bit(30)
+
+/**
+ * ͳж·, XXX ֽڷ
+ */
+#define I_ENTRY_UART0					0x16001400			// UART00
+#define I_ENTRY_UART1					0x16001401			// UART01
+#define I_ENTRY_UART_2_5				0x16001402			// UART02~05
+#define I_ENTRY_UART_6_9				0x16001403			// UART06~09
+#define I_ENTRY_I2C_0_1					0x16001404			// I2C0~1
+#define I_ENTRY_I2C_2_3					0x16001405			// I2C2~3
+#define I_ENTRY_SPI2					0x16001406			// SPI2
+#define I_ENTRY_SPI3					0x16001407			// SPI3
+#define I_ENTRY_CAN0					0x16001408			// CAN0
+#define I_ENTRY_CAN1					0x16001409			// CAN1
+#define I_ENTRY_CAN2					0x1600140a			// CAN2
+#define I_ENTRY_CAN3					0x1600140b			// CAN3
+#define I_ENTRY_I2S						0x1600140c			// I2S
+#define I_ENTRY_ATIMER					0x1600140d			// ATIMER
+#define I_ENTRY_GTIMER					0x1600140e			// GTIMER
+#define I_ENTRY_BTIMER					0x1600140f			// BTIMER
+#define I_ENTRY_PWM_0_1					0x16001410			// PWM0/1
+#define I_ENTRY_PWM_2_3					0x16001411			// PWM2/3
+#define I_ENTRY_ADC						0x16001412			// ADC
+#define I_ENTRY_HPET0					0x16001413			// HPET0
+#define I_ENTRY_HPET1					0x16001414			// HPET1
+#define I_ENTRY_HPET2					0x16001415			// HPET2
+#define I_ENTRY_HPET3					0x16001416			// HPET3
+#define I_ENTRY_DMA0					0x16001417			// APB-DMA0
+#define I_ENTRY_DMA1					0x16001418			// APB-DMA1
+#define I_ENTRY_DMA2					0x16001419			// APB-DMA2
+#define I_ENTRY_DMA3					0x1600141a			// APB-DMA3
+#define I_ENTRY_DMA4					0x1600141b			// APB-DMA4
+#define I_ENTRY_DMA5					0x1600141c			// APB-DMA5
+#define I_ENTRY_DMA6					0x1600141d			// APB-DMA6
+#define I_ENTRY_DMA7					0x1600141e			// APB-DMA7
+#define I_ENTRY_SDIO0_CTRL				0x1600141f			// SDIO0-CTRL
+
+#define I_ENTRY_SDIO1_CTRL				0x16001440			// SDIO1-CTRL
+#define I_ENTRY_SDIO0_DMA				0x16001441			// SDIO0-DMA
+#define I_ENTRY_SDIO1_DMA				0x16001442			// SDIO1-DMA
+#define I_ENTRY_ENCRYPT_DMA				0x16001443			// ENCYPT-DMA
+#define I_ENTRY_AES						0x16001444			// AES
+#define I_ENTRY_DES						0x16001445			// DES
+#define I_ENTRY_SM3						0x16001446			// SM3
+#define I_ENTRY_SM4						0x16001447			// SM4
+#define I_ENTRY_RTC						0x16001448			// RTC-INT
+#define I_ENTRY_TOY						0x16001449			// TOY-INT
+#define I_ENTRY_RTC_TICK				0x1600144a			// RTC-TICK
+#define I_ENTRY_TOY_TICK				0x1600144b			// TOY-TICK
+#define I_ENTRY_SPI0					0x1600144c			// SPI0
+#define I_ENTRY_SPI1					0x1600144d			// SPI1
+#define I_ENTRY_EHCI					0x1600144e			// ECHI
+#define I_ENTRY_OHCI					0x1600144f			// OHCI
+#define I_ENTRY_OTG						0x16001450			// OTG
+#define I_ENTRY_GMAC0					0x16001451			// GMAC0
+#define I_ENTRY_GMAC1					0x16001452			// GMAC1
+#define I_ENTRY_DC						0x16001453			// DC
+#define I_ENTRY_THSENS					0x16001454			// THSENS
+#define I_ENTRY_GPIO_0_15				0x16001455			// GPIO0~15
+#define I_ENTRY_GPIO_16_31				0x16001456			// GPIO16~31
+#define I_ENTRY_GPIO_32_47				0x16001457			// GPIO32~47
+#define I_ENTRY_GPIO_48_63				0x16001458			// GPIO48~63
+#define I_ENTRY_GPIO_64_79				0x16001459			// GPIO64~79
+#define I_ENTRY_GPIO_80_95				0x1600145a			// GPIO80~95
+#define I_ENTRY_GPIO_96_111				0x1600145b			// GPIO96~111
+#define I_ENTRY_GPIO_112_127			0x1600145c			// GPIO112~127
+#define I_ENTRY_DDR_ECC0				0x1600145d			// DDR-ECC0
+#define I_ENTRY_DDR_ECC1				0x1600145e			// DDR-ECC1
+
+/**
+ * 7:4 ·ɵĴж
+ */
+/*
+#define INT_ROUTE_IP0					0x10				// 0001: LA264 0 жϺ
+#define INT_ROUTE_IP1					0x20				// 0010: LA264 1 жϺ
+#define INT_ROUTE_IP2					0x40				// 0100: LA264 2 жϺ
+#define INT_ROUTE_IP3					0x80				// 1000: LA264 3 жϺ
+ */
+
+#else // #if USE_EXTINT
+
+/**
+ * չж
+ */
+#define EXTIOI_ACK_BASE					0x16001148			// EXTIOI_ACK չж豸Ĵ
+#define EXTIOI_MAP_BASE					0x160014c0			// EXTIOI_MAP չж豸·ɼĴ
+#define EXTIOI_IEN0_BASE				0x16001600			// EXTIOI_IEN0 չж豸ʹܼĴ0
+#define EXTIOI_IEN1_BASE				0x16001604			// EXTIOI_IEN1 չж豸ʹܼĴ1
+#define EXTIOI_IEN2_BASE				0x16001608			// EXTIOI_IEN2 չж豸ʹܼĴ2
+#define EXTIOI_IEN3_BASE				0x1600160c			// EXTIOI_IEN3 չж豸ʹܼĴ3
+#define EXTIOI_POL0_BASE				0x16001640			// EXTIOI_POL0 չжϵƽüĴ0
+#define EXTIOI_POL1_BASE				0x16001644			// EXTIOI_POL1 չжϵƽüĴ1
+#define EXTIOI_POL2_BASE				0x16001648			// EXTIOI_POL2 չжϵƽüĴ2
+#define EXTIOI_POL3_BASE				0x1600164c			// EXTIOI_POL3 չжϵƽüĴ3
+#define EXTIOI_ISR0_BASE				0x16001700			// EXTIOI_ISR0 չж״̬Ĵ0
+#define EXTIOI_ISR1_BASE				0x16001704			// EXTIOI_ISR1 չж״̬Ĵ1
+#define EXTIOI_ISR2_BASE				0x16001708			// EXTIOI_ISR2 չж״̬Ĵ2
+#define EXTIOI_ISR3_BASE				0x1600170c			// EXTIOI_ISR3 չж״̬Ĵ3
+#define EXTIOI_CORE_ISR0_BASE			0x16001800			// EXTIOI_CORE_ISR0 ·COREչж״̬Ĵ0
+#define EXTIOI_CORE_ISR1_BASE			0x16001804			// EXTIOI_CORE_ISR1 ·COREչж״̬Ĵ1
+#define EXTIOI_CORE_ISR2_BASE			0x16001808			// EXTIOI_CORE_ISR2 ·COREչж״̬Ĵ2
+#define EXTIOI_CORE_ISR3_BASE			0x1600180c			// EXTIOI_CORE_ISR3 ·COREչж״̬Ĵ3
+
+/*
+ * չж·ɼĴ
+ */
+#define EXTI_MAP_127_96_MASK			(0x0F<<24)			// bit[27:24] EXT_IOI_ISR[127:96]ͳһ·ɵĴж
+#define EXTI_MAP_127_96_SHIFT			24
+#define EXTI_MAP_95_64_MASK				(0x0F<<16)			// bit[19:16] EXT_IOI_ISR[95:64]ͳһ·ɵĴж
+#define EXTI_MAP_95_64_SHIFT			16
+#define EXTI_MAP_63_32_MASK				(0x0F<<8)			// bit[11:8] EXT_IOI_ISR[63:32]ͳһ·ɵĴж
+#define EXTI_MAP_63_32_SHIFT			8
+#define EXTI_MAP_31_0_MASK				(0x0F<<0)			// bit[3:0] EXT_IOI_ISR[31:0]ͳһ·ɵĴж
+#define EXTI_MAP_31_0_SHIFT				0
+
+#define EXTI_MAP_IP0					0x01				// 0001: LA264 0 жϺ
+#define EXTI_MAP_IP1					0x02				// 0010: LA264 1 жϺ
+#define EXTI_MAP_IP2					0x04				// 0100: LA264 2 жϺ
+#define EXTI_MAP_IP3					0x08				// 1000: LA264 3 жϺ
+
+/**
+ * չжλ
+ */
+#define EXTI0_UART0_BIT					bit(0)
+#define EXTI0_UART1_BIT					bit(1)
+#define EXTI0_UART2_BIT					bit(2)
+#define EXTI0_UART3_BIT					bit(3)
+#define EXTI0_UART4_BIT					bit(4)
+#define EXTI0_UART5_BIT					bit(5)
+#define EXTI0_UART6_BIT					bit(6)
+#define EXTI0_UART7_BIT					bit(7)
+#define EXTI0_UART8_BIT					bit(8)
+#define EXTI0_UART9_BIT					bit(9)
+#define EXTI0_I2C0_BIT					bit(10)
+#define EXTI0_I2C1_BIT					bit(11)
+#define EXTI0_I2C2_BIT					bit(12)
+#define EXTI0_I2C3_BIT					bit(13)
+#define EXTI0_SPI2_BIT					bit(14)
+#define EXTI0_SPI3_BIT					bit(15)
+#define EXTI0_CAN0_CORE_BIT				bit(16)
+#define EXTI0_CAN0_BUF_BIT				bit(17)
+#define EXTI0_CAN1_CORE_BIT				bit(18)
+#define EXTI0_CAN1_BUF_BIT				bit(19)
+#define EXTI0_CAN2_CORE_BIT				bit(20)
+#define EXTI0_CAN2_BUF_BIT				bit(21)
+#define EXTI0_CAN3_CORE_BIT				bit(22)
+#define EXTI0_CAN3_BUF_BIT				bit(23)
+#define EXTI0_I2S_BIT					bit(24)
+#define EXTI0_ATIMER_BIT				bit(25)
+#define EXTI0_GTIMER_BIT				bit(26)
+#define EXTI0_BTIMER_BIT				bit(27)
+#define EXTI0_PWM0_BIT					bit(28)
+#define EXTI0_PWM1_BIT					bit(29)
+#define EXTI0_PWM2_BIT					bit(30)
+#define EXTI0_PWM3_BIT					bit(31)
+
+#define EXTI1_ADC_BIT					bit(32-32)
+#define EXTI1_HPET0_0_BIT				bit(33-32)
+#define EXTI1_HPET0_1_BIT				bit(34-32)
+#define EXTI1_HPET0_2_BIT				bit(35-32)
+#define EXTI1_HPET1_0_BIT				bit(36-32)
+#define EXTI1_HPET1_1_BIT				bit(37-32)
+#define EXTI1_HPET1_2_BIT				bit(38-32)
+#define EXTI1_HPET2_0_BIT				bit(39-32)
+#define EXTI1_HPET2_1_BIT				bit(40-32)
+#define EXTI1_HPET2_2_BIT				bit(41-32)
+#define EXTI1_HPET3_0_BIT				bit(42-32)
+#define EXTI1_HPET3_1_BIT				bit(43-32)
+#define EXTI1_HPET3_2_BIT				bit(44-32)
+#define EXTI1_DMA0_BIT					bit(45-32)
+#define EXTI1_DMA1_BIT					bit(46-32)
+#define EXTI1_DMA2_BIT					bit(47-32)
+#define EXTI1_DMA3_BIT					bit(48-32)
+#define EXTI1_DMA4_BIT					bit(49-32)
+#define EXTI1_DMA5_BIT					bit(50-32)
+#define EXTI1_DMA6_BIT					bit(51-32)
+#define EXTI1_DMA7_BIT					bit(52-32)
+#define EXTI1_SDIO0_CTRL_BIT			bit(53-32)
+#define EXTI1_SDIO1_CTRL_BIT			bit(54-32)
+#define EXTI1_SDIO0_DMA_BIT				bit(55-32)
+#define EXTI1_SDIO1_DMA_BIT				bit(56-32)
+#define EXTI1_ENCRYPT_DMA_BIT			bit(57-32)
+#define EXTI1_AES_BIT					bit(58-32)
+#define EXTI1_DES_BIT					bit(59-32)
+#define EXTI1_SM3_BIT					bit(60-32)
+#define EXTI1_SM4_BIT					bit(61-32)
+#define EXTI1_RTC_0_BIT					bit(62-32)
+#define EXTI1_RTC_1_BIT					bit(63-32)
+
+#define EXTI2_RTC_2_BIT					bit(64-64)
+#define EXTI2_TOY_0_BIT					bit(65-64)
+#define EXTI2_TOY_1_BIT					bit(66-64)
+#define EXTI2_TOY_2_BIT					bit(67-64)
+#define EXTI2_RTC_TICK_BIT				bit(68-64)
+#define EXTI2_TOY_TICK_BIT				bit(69-64)
+#define EXTI2_SPI0_BIT					bit(70-64)
+#define EXTI2_SPI1_BIT					bit(71-64)
+#define EXTI2_EHCI_BIT					bit(72-64)
+#define EXTI2_OHCI_BIT					bit(73-64)
+#define EXTI2_OTG_BIT					bit(74-64)
+#define EXTI2_GMAC0_BIT					bit(75-64)
+#define EXTI2_GMAC1_BIT					bit(76-64)
+#define EXTI2_DC_BIT					bit(77-64)
+#define EXTI2_THSENS_BIT				bit(78-64)
+#define EXTI2_GPIO_0_3_BIT				bit(79-64)
+#define EXTI2_GPIO_4_7_BIT				bit(80-64)
+#define EXTI2_GPIO_8_11_BIT				bit(81-64)
+#define EXTI2_GPIO_12_15_BIT			bit(82-64)
+#define EXTI2_GPIO_16_19_BIT			bit(83-64)
+#define EXTI2_GPIO_20_23_BIT			bit(84-64)
+#define EXTI2_GPIO_24_27_BIT			bit(85-64)
+#define EXTI2_GPIO_28_31_BIT			bit(86-64)
+#define EXTI2_GPIO_32_35_BIT			bit(87-64)
+#define EXTI2_GPIO_36_39_BIT			bit(88-64)
+#define EXTI2_GPIO_40_43_BIT			bit(89-64)
+#define EXTI2_GPIO_44_47_BIT			bit(90-64)
+#define EXTI2_GPIO_48_51_BIT			bit(91-64)
+#define EXTI2_GPIO_52_55_BIT			bit(92-64)
+#define EXTI2_GPIO_56_59_BIT			bit(93-64)
+#define EXTI2_GPIO_60_63_BIT			bit(94-64)
+#define EXTI2_GPIO_64_67_BIT			bit(95-64)
+
+#define EXTI3_GPIO_68_71_BIT			bit(96-96)
+#define EXTI3_GPIO_72_75_BIT			bit(97-96)
+#define EXTI3_GPIO_76_79_BIT			bit(98-96)
+#define EXTI3_GPIO_80_83_BIT			bit(99-96)
+#define EXTI3_GPIO_84_87_BIT			bit(100-96)
+#define EXTI3_GPIO_88_91_BIT			bit(101-96)
+#define EXTI3_GPIO_92_95_BIT			bit(102-96)
+#define EXTI3_GPIO_96_99_BIT			bit(103-96)
+#define EXTI3_GPIO_100_103_BIT			bit(104-96)
+#define EXTI3_GPIO_104_105_BIT			bit(105-96)
+#define EXTI3_DDR_ECC0_BIT				bit(111-96)
+#define EXTI3_DDR_ECC1_BIT				bit(112-96)
+
+#endif // #if USE_EXTINT
+
+//-------------------------------------------------------------------------------------------------
+// GPIO
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * оƬ106 GPIO , ȫŸ.
+ */
+#define GPIO_COUNT                      106
+
+#if 0
+
+#define GPIO_BASE						0x16104000			// GPIO ַ
+
+/**
+ * 0x00C0x80 λƼĴַ(谴ֽʽ, λд)
+ */
+#define GPIO_OEN_BASE					0x16104000			// GPIO_OEN 106 λGPIO ʹ, Ч. ÿλһGPIO .
+#define GPIO_O_BASE						0x16104010			// GPIO_O 106 λGPIO ֵ. ÿλһGPIO .
+#define GPIO_I_BASE						0x16104020			// GPIO_I 106 λGPIO ֵ. ÿλһGPIO .
+#define GPIO_IEN_BASE					0x16104030			// GPIO_INT_EN 106 λGPIO жʹ. ÿλһGPIO .
+#define GPIO_IPOL_BASE					0x16104040			// GPIO_INT_POL 106 λGPIO жϼ. ÿλһGPIO .
+#define GPIO_IEDGE_BASE					0x16104050			// GPIO_INT_EDGE 106 λGPIO жϱ. ÿλһGPIO .
+#define GPIO_ICLR_BASE					0x16104060			// GPIO_INT_CLR 106 λGPIO ж. ÿλһGPIO .
+#define GPIO_ISR_BASE					0x16104070			// GPIO_INT_STS 106 λGPIO ж״̬. ÿλһGPIO .
+#define GPIO_IDUAL_BASE					0x16104080			// GPIO_INT_DUAL 106 λGPIO ж˫ģʽ. ÿλһGPIO .
+#endif
+
+/*
+ *  ʽ
+ *
+ * 	| POL	| EDGE	|	 			|
+ * 	|-------|-------|---------------|
+ *	|  0	|  0	| ͵ƽж	|
+ *	|  1	|  0	| ߵƽж	|
+ * 	|  0	|  1	| ½شж	|
+ *	|  1	|  1	| شж	|
+ *
+ */
+
+/**
+ * 0x800-0xFFF ֽڿƼĴַ(谴ֽʽ, ֽΪλд)
+ */
+#define GPIO_OEN_ADDR					0x16104800			// GPIO_OEN 106 ֽGPIO ʹ, Ч. ÿֽڿһGPIO .
+#define GPIO_O_ADDR						0x16104900			// GPIO_O 106 ֽGPIO ֵ. ÿֽڿһGPIO .
+#define GPIO_I_ADDR						0x16104A00			// GPIO_I 106 ֽGPIO ֵ. ÿֽڿһGPIO .
+#define GPIO_IEN_ADDR					0x16104B00			// GPIO_INT_EN 106 ֽGPIO жʹ. ÿֽڿһGPIO .
+#define GPIO_IPOL_ADDR					0x16104C00			// GPIO_INT_POL 106 ֽGPIO жϼ. ÿֽڿһGPIO .
+#define GPIO_IEDGE_ADDR					0x16104D00			// GPIO_INT_EDGE 106 ֽGPIO жϱ. ÿֽڿһGPIO .
+#define GPIO_ICLR_ADDR					0x16104E00			// GPIO_INT_CLR 106 ֽGPIO ж. ÿֽڿһGPIO .
+#define GPIO_ISR_ADDR					0x16104F00			// GPIO_INT_STS 106 ֽGPIO ж״̬. ÿֽڿһGPIO .
+#define GPIO_IDUAL_ADDR					0x16104F80			// GPIO_INT_DUAL 106 ֽGPIO ж˫ģʽ. ÿֽڿһGPIO .
+
+//-------------------------------------------------------------------------------------------------
+// Ĵ
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * ¶ȴ
+ */
+#define THSENS_INT_HI0					0x16001500			// Thsens_int_ctrl_Hi0 ¶ȴжϿƼĴ0
+#define THSENS_INT_HI1					0x16001504			// Thsens_int_ctrl_Hi1 ¶ȴжϿƼĴ1
+#define THSENS_INT_LO0					0x16001508			// Thsens_int_ctrl_Lo0 ¶ȴжϿƼĴ0
+#define THSENS_INT_LO1					0x1600150c			// Thsens_int_ctrl_Lo1 ¶ȴжϿƼĴ1
+#define THSENS_INT_SR					0x16001510			// Thsens_int_status/clr ¶ȴж״̬/Ĵ
+#define THSENS_VALUE					0x16001514			// Thsens_value ¶ȴֵ(11λЧλ), 㹫ʽΪ: Tval=Thsens_value[10:0]*0.4-275
+#define THSENS_SCALE_HI0				0x16001520			// Thsens_scale_hi0 ¶ȴֵüĴ0
+#define THSENS_SCALE_HI1				0x16001524			// Thsens_scale_hi1 ¶ȴֵüĴ1
+
+/**
+ * оƬʶ
+ */
+#define CHIP_ID4						0x16003fe0			// CHIP_ID4 оƬʶ4
+#define CHIP_ID5						0x16003fe4			// CHIP_ID5 оƬʶ5
+#define CHIP_ID6						0x16003fe8			// CHIP_ID6 оƬʶ6
+#define CHIP_ID7						0x16003fec			// CHIP_ID7 оƬʶ7
+
+#define CHIP_ID0						0x16003ff0			// CHIP_ID0 оƬʶ0
+#define CHIP_ID1						0x16003ff4			// CHIP_ID1 оƬʶ1
+#define CHIP_ID2						0x16003ff8			// CHIP_ID2 оƬʶ2
+#define CHIP_ID3						0x16003ffc			// CHIP_ID3 оƬʶ3
+
+//-------------------------------------------------------------------------------------------------
+// жϺ
+//-------------------------------------------------------------------------------------------------
+
+extern void ls2k_install_irq_handler(int vector, irq_handler_t isr, void *arg);
+extern void ls2k_remove_irq_handler(int vector);
+
+/*
+ * жӳ
+ */
+#define INT_ROUTE_IP0                   0x10                /* ж·ɵ IP0 */
+#define INT_ROUTE_IP1                   0x20                /* ж·ɵ IP1 */
+#define INT_ROUTE_IP2                   0x40                /* ж·ɵ IP2 */
+#define INT_ROUTE_IP3                   0x80                /* ж·ɵ IP3 */
+extern void ls2k_set_irq_routeip(int vector, int route_ip);
+
+/*
+ * жϴ
+ */
+#define INT_TRIGGER_LEVEL               0x04                /* ƽж */
+#define INT_TRIGGER_PULSE               0x08                /* 崥ж */
+extern void ls2k_set_irq_triggermode(int vector, int mode);
+
+extern void ls2k_interrupt_enable(int vector);   			/* жʹж */
+extern void ls2k_interrupt_disable(int vector);  			/* жֹж */
+
+extern int assert_sw_irq(unsigned int irqnum);      		/* Generate a software interrupt */
+extern int negate_sw_irq(unsigned int irqnum);      		/* Clear a software interrupt */
+
+/*
+ * cache.S 
+ */
+extern void flush_cache(void);
+extern void flush_cache_nowrite(void);
+extern void clean_cache(unsigned long kva, unsigned int n);
+
+extern void flush_dcache(void);
+extern void clean_dcache(unsigned long kva, unsigned int n);
+extern void clean_dcache_indexed(unsigned long kva, unsigned int n);
+extern void clean_dcache_nowrite(unsigned long kva, unsigned int n);
+extern void clean_dcache_nowrite_indexed(unsigned long kva, unsigned int n);
+
+extern void clean_icache(unsigned long kva, unsigned int n);
+extern void clean_icache_indexed(unsigned long kva, unsigned int n);
+
+extern void clean_scache(unsigned long kva, unsigned int n);
+extern void clean_scache_indexed(unsigned long kva, unsigned int n);
+extern void clean_scache_nowrite(unsigned long kva, unsigned int n);
+extern void clean_scache_nowrite_indexed(unsigned long kva, unsigned int n);
+
+extern unsigned int get_memory_size(void);
+
+/*
+ * tick.c 
+ */
+extern unsigned long get_clock_ticks(void);
+
+extern void delay_ms(int ms);
+extern void delay_us(int us);
+
+/*
+ * 㶨Ƶʼ (rdtime.d), ÿ΢ hda_1us_count ,  tick.c ʼ
+ */
+extern unsigned int hda_1us_count;
+
+static inline unsigned long get_stable_counter(void)
+{
+    unsigned long val;
+    asm volatile( "rdtime.d %0, $r0 ; " : "=r"(val) );
+    return val;
+}
+
+#endif // _LS2K300_H
+
+/*
+ * @@ END
+ */
@@ -3,22 +3,31 @@
  *
  */
 
+/**
+ * memory manager posix api implement
+ */
+
 #include "bsp.h"
 
 #if !BSP_USE_FS
 
-/*
- * This is as part of newlib glue, when using rtems gcc.
- */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
-#ifdef OS_RTTHREAD
+#if defined(OS_RTTHREAD)
+#include "rtthread.h"
+#elif defined(OS_FREERTOS)
+#include "FreeRTOS.h"
+#else // uCOSIII && OS_PESUDO
+#include "osal.h"
+#endif
 
-//-------------------------------------------------------------------------------------------------
-// RTThread
-//-------------------------------------------------------------------------------------------------
+#if defined(OS_RTTHREAD)
 
-#include <stdlib.h>
-#include "rtthread.h"
+//-----------------------------------------------------------------------------
+// RTThread
+//-----------------------------------------------------------------------------
 
 void *malloc(size_t size)
 {
@@ -30,299 +39,1056 @@ void *calloc(size_t nmemb, size_t size)
     return rt_calloc(nmemb, size);
 }
 
-void *realloc(void *ptr, size_t size)
+void free(void *ptr)
 {
-    return rt_realloc(ptr, size);
+    rt_free(ptr);
 }
 
-void free(void *ptr)
+#elif defined(OS_FREERTOS)
+
+//-----------------------------------------------------------------------------
+// FreeRTOS
+//-----------------------------------------------------------------------------
+
+#include "FreeRTOS.h"
+
+void *malloc(size_t size)
 {
-    rt_free(ptr);
+    return pvPortMalloc(size);
 }
 
-void *aligned_malloc(size_t size, unsigned int align)
+void *calloc(size_t nmemb, size_t size)
 {
-    return rt_malloc_align((rt_size_t)size, (rt_size_t)align);
+    void *ptr = pvPortMalloc(nmemb * size);
+
+    if (ptr)
+    {
+        memset(ptr, 0x00, nmemb * size);
+    }
+
+    return ptr;
 }
 
-void aligned_free(void *addr)
+void free(void *ptr)
 {
-    rt_free_align(addr);
+    vPortFree(ptr);
 }
 
 #else
 
-//-------------------------------------------------------------------------------------------------
-// BareMetal/uCOSIII/FreeRTOS
-//-------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// BareMetal && uCOSIII
+//-----------------------------------------------------------------------------
 
-#include <stdint.h>
-#include <stdlib.h>
-#include <string.h>
+#include "osal.h"
 
-#include <sys/queue.h>
+extern void printk(const char *fmt, ...);
 
-#include "osal.h"
+/*
+ * =1: TLSF (Two-Level Segregated Fit), malloc/free ִʱͿп޹;
+ * =0: ״, ڶԱȲ
+ */
+#ifndef HEAP_USE_TLSF
+#define HEAP_USE_TLSF       1
+#endif
 
-//-------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
 
 #ifndef align_up
-#define align_up(num, align) (((num) + ((align)-1)) & ~((align)-1))
+#define align_up(num, align)    (((num) + ((align)-1)) & ~((align)-1))
 #endif
 
+#define BLOCK_USED_FLAG     (0xdeadbeaf)
+
+#define ALLOC_ALIGNMENT     (sizeof(void *))    /* malloc buffer align 8 bytes */
+
+#define ALLOC_MIN_BYTES     32                  /* min malloc size */
+
+/*
+ * lock alloc with mutex support
+ */
+static osal_mutex_t p_alloc_mutex = NULL;
+
+static size_t heap_total_bytes  = 0;
+static size_t heap_remain_bytes = 0;
+
+//-----------------------------------------------------------------------------
+// OS lock
+//-----------------------------------------------------------------------------
+
+void malloc_create_oslock(void)
+{
+    if (!p_alloc_mutex)
+    {
+        p_alloc_mutex = osal_mutex_create("heap_loc", OSAL_OPT_FIFO);
+    }
+}
+
+static void malloc_oslock()
+{
+    if (osal_is_osrunning())
+    {
+        osal_mutex_obtain(p_alloc_mutex, OSAL_WAIT_FOREVER);
+    }
+}
+
+static void malloc_osunlock()
+{
+    if (osal_is_osrunning())
+    {
+        osal_mutex_release(p_alloc_mutex);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+size_t get_heap_size(void)
+{
+    return heap_total_bytes;
+}
+
+size_t get_heap_free_size(void)
+{
+    return heap_remain_bytes;
+}
+
+#if HEAP_USE_TLSF
+
+//-----------------------------------------------------------------------------
+// TLSF: Two-Level Segregated Fit
+//-----------------------------------------------------------------------------
+
+/*
+ * п鰴ȷּ: һ fl ǳȵλ,  sl  [2^fl, 2^(fl+1)) ȷΪ
+ * SL_INDEX_COUNT . ÿ (fl, sl) һ, λͼ¼Щǿ.
+ * malloc λͼҵһ㹻, free ֻϲڵ, ûѭ.
+ */
+#define SL_INDEX_COUNT_LOG2 5
+#define SL_INDEX_COUNT      (1 << SL_INDEX_COUNT_LOG2)          /* 32 */
+#define ALIGN_SIZE_LOG2     3                                   /* 8 bytes */
+#define FL_INDEX_MAX        31                                  /* block size < 4G */
+#define FL_INDEX_SHIFT      (SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2)
+#define FL_INDEX_COUNT      (FL_INDEX_MAX - FL_INDEX_SHIFT + 1)
+#define SMALL_BLOCK_SIZE    (1 << FL_INDEX_SHIFT)               /* 256 */
+
 /**
  * memory block node struct
+ *
+ * memory physical address: low -high
+ *
+ *   ---------------|------------------|---------------------------|--
+ *  |H| block       |H| block          |H| block                   |H| size=0, used
+ *   ---------------|------------------|---------------------------|--
+ *                   prev_phys -------                             sentinel
  */
 typedef struct blk_node
 {
-    unsigned int flag;                        /* =1: used; =0: blank */
-	size_t       size;
-	void        *block;
-    TAILQ_ENTRY(blk_node) link;         /* doubly linked queue */
+    unsigned int     flag;                  /* =BLOCK_USED_FLAG: used; =0: blank */
+	unsigned int     size;                  /* block bytes, not include node */
+    struct blk_node *prev_phys;             /* ַǰһ, NULL: һ */
+    struct blk_node *next_free;             /*  */
+    struct blk_node *prev_free;
 } blk_node_t;
 
-#define ALLOC_FLAG          0xdeadbeaf
+#define BLOCK_NODE_SZ       (align_up(sizeof(blk_node_t), 8))
 
-#define BLOCK_HEADER_SZ     sizeof(blk_node_t)
+#define NODE_TO_BLOCK(node) ((void *)((unsigned char *)(node) + BLOCK_NODE_SZ))
+#define BLOCK_TO_NODE(ptr)  ((blk_node_t *)((unsigned char *)(ptr) - BLOCK_NODE_SZ))
+#define NEXT_PHYS(node)     ((blk_node_t *)((unsigned char *)(node) + BLOCK_NODE_SZ + (node)->size))
 
-#define MIN_ALLOC_SZ        (BLOCK_HEADER_SZ + 32)
+#define INFO_NODE(node, i) { \
+    printk("  Faulty block[%i] @0x%016lx\r\n", i, (long)node); \
+    printk("    flag  = 0x%08x\r\n", node->flag); \
+    printk("    size  = 0x%08x\r\n", node->size); \
+    printk("    prev  = 0x%016lx\r\n", (long)node->prev_phys); \
+    printk("    next  = 0x%016lx\r\n", (long)NEXT_PHYS(node)); }
 
-//-------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// free memory lists
+//-----------------------------------------------------------------------------
 
-void malloc_lock();
-void malloc_unlock();
+static unsigned int fl_bitmap = 0;
+static unsigned int sl_bitmap[FL_INDEX_COUNT];
+static blk_node_t  *free_blocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
 
-//-------------------------------------------------------------------------------------------------
+static blk_node_t  *heap_first_node = NULL;
+static blk_node_t  *heap_last_node  = NULL;        /* sentinel */
 
-/**
- * free memory queue head
+/*
+ * LoongArch  clz.w/ctz.w ָ
  */
-static TAILQ_HEAD(blk_nodes_q, blk_node) free_list_head;
+static inline int tlsf_fls(unsigned int x)          /* λ 1 λ, 0~31 */
+{
+    return 31 - __builtin_clz(x);
+}
 
-//-------------------------------------------------------------------------------------------------
-// debug view queue
-//-------------------------------------------------------------------------------------------------
+static inline int tlsf_ffs(unsigned int x)          /* λ 1 λ, 0~31 */
+{
+    return __builtin_ctz(x);
+}
 
-#define MALLOC_DEBUG    0
+/*
+ * ڵ
+ */
+static inline void mapping_insert(size_t size, int *fl, int *sl)
+{
+    if (size < SMALL_BLOCK_SIZE)
+    {
+        *fl = 0;
+        *sl = (int)size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT);
+    }
+    else
+    {
+        int t = tlsf_fls((unsigned int)size);
+        *sl = (int)(size >> (t - SL_INDEX_COUNT_LOG2)) ^ SL_INDEX_COUNT;
+        *fl = t - (FL_INDEX_SHIFT - 1);
+    }
+}
 
-#if MALLOC_DEBUG
+/*
+ * 볤ȡһ, һ鶼㹻
+ */
+static inline void mapping_search(size_t size, int *fl, int *sl)
+{
+    if (size >= SMALL_BLOCK_SIZE)
+    {
+        size += (1 << (tlsf_fls((unsigned int)size) - SL_INDEX_COUNT_LOG2)) - 1;
+    }
 
-static void debug_dump_list(void)
+    mapping_insert(size, fl, sl);
+}
+
+static blk_node_t *search_suitable_block(int *fl, int *sl)
 {
-    int i = 0;
-    blk_node_t *block, *tmp;
-    
-    TAILQ_FOREACH_SAFE(block, &free_list_head, link, tmp)
+    unsigned int sl_map, fl_map;
+
+    if (*fl >= FL_INDEX_COUNT)
     {
-        printk("\r\nnode[%i] @0x%016lx\r\n", i++, (long)block);
-        printk("  flag  = 0x%08x\r\n", block->flag);
-        printk("  size  = 0x%08x\r\n", block->size);
-        printk("  block = 0x%016lx\r\n", (long)block->block);
-        printk("  _next = 0x%016lx\r\n", (long)block->link.tqe_next);
-	    printk("  _prev = 0x%016lx\r\n", (long)block->link.tqe_prev);
+        return NULL;
     }
+
+    sl_map = sl_bitmap[*fl] & (~0U << *sl);
+    if (!sl_map)
+    {
+        fl_map = (*fl + 1 < 32) ? (fl_bitmap & (~0U << (*fl + 1))) : 0;
+        if (!fl_map)
+        {
+            return NULL;
+        }
+
+        *fl = tlsf_ffs(fl_map);
+        sl_map = sl_bitmap[*fl];
+    }
+
+    *sl = tlsf_ffs(sl_map);
+
+    return free_blocks[*fl][*sl];
 }
 
-#else
+static void insert_free_block(blk_node_t *node)
+{
+    int fl, sl;
 
-#define debug_dump_list()
+    mapping_insert(node->size, &fl, &sl);
 
-#endif
+    node->flag = 0;
+    node->prev_free = NULL;
+    node->next_free = free_blocks[fl][sl];
+    if (node->next_free)
+        node->next_free->prev_free = node;
 
-//-------------------------------------------------------------------------------------------------
+    free_blocks[fl][sl] = node;
+    fl_bitmap |= 1U << fl;
+    sl_bitmap[fl] |= 1U << sl;
+}
 
-void *malloc(size_t size)
+static void remove_free_block(blk_node_t *node)
 {
-	void *ptr = NULL;
-	blk_node_t *found_block = NULL, *tmp;
+    int fl, sl;
 
-	if (size > 0)
-	{
-		size = align_up(size, sizeof(void *));
+    mapping_insert(node->size, &fl, &sl);
 
-		malloc_lock();
+    if (node->next_free)
+        node->next_free->prev_free = node->prev_free;
+
+    if (node->prev_free)
+    {
+        node->prev_free->next_free = node->next_free;
+    }
+    else
+    {
+        free_blocks[fl][sl] = node->next_free;
+        if (!free_blocks[fl][sl])
+        {
+            sl_bitmap[fl] &= ~(1U << sl);
+            if (!sl_bitmap[fl])
+                fl_bitmap &= ~(1U << fl);
+        }
+    }
+}
 
+//-----------------------------------------------------------------------------
+
+int heap_verify_faulty_blocks(void)
+{
+    blk_node_t *node = heap_first_node, *prev = NULL;
+    int count = 0, i = 0, fl, sl;
+
+    printk("Verify heap blocks:\r\n");
+
+    while (node && (node != heap_last_node))
+    {
         /*
-         * search a usage block
+         * Self is correct
          */
-		TAILQ_FOREACH_SAFE(found_block, &free_list_head, link, tmp)
-		{
-			if (found_block->size >= size + MIN_ALLOC_SZ)
-			{
-				ptr = found_block->block;
-				break;
-			}
-		}
-
-		if (ptr)
-		{
-		    /*
-             * found_block:
-             *   ------------------------------------------------------------------
-             *  |H| block, size >= size + MIN_ALLOC_SZ                             |
-             *   ------------------------------------------------------------------
-             *
-             * after split:
-             *   ---------------|--------------------------------------------------
-             *  | found_block   | new_block                                        |
-             *  |H| block       |H| block                                          |
-             *   ---------------|--------------------------------------------------
-             *
-             * memory physical address: low -high
-             *
-             */
-
-			blk_node_t *new_block = (blk_node_t *)((uintptr_t)(found_block->block) + size);
-			new_block->flag  = 0;
-			new_block->size  = found_block->size - size - BLOCK_HEADER_SZ;
-			new_block->block = (char *)new_block + BLOCK_HEADER_SZ;
-
-			found_block->size = size;
-			found_block->flag = ALLOC_FLAG;
-				
-			/*
-             * queue list:
-             *
-             *              new_block            found_block
-             *          - ----------       - ----------       -...
-             *        J   |          |    J   |          |    J
-             *      J     |          |  J     |          |  J
-             * ...J       | tqe_next |J       | tqe_next |J
-             *             |          |         |          |
-             *             |          |         |          |
-             *              ----------           ----------
-             *
-             * XXX new_block has free memory to malloc
-             */
-
-            TAILQ_INSERT_BEFORE(found_block, new_block, link);
-		}
-
-		malloc_unlock();
-	}
-
-    debug_dump_list();
-
-	return ptr;
+        if (((node->flag != 0) && (node->flag != BLOCK_USED_FLAG)) ||
+            ((size_t)NEXT_PHYS(node) > (size_t)heap_last_node))
+        {
+            count++;
+            if (osal_is_osrunning())
+            {
+                INFO_NODE(node, i);
+            }
+            break;
+        }
+
+        /*
+         * Previous is correct, and two blank blocks never adjoin
+         */
+        if ((node->prev_phys != prev) ||
+            (prev && (prev->flag == 0) && (node->flag == 0)))
+        {
+            count++;
+            if (osal_is_osrunning())
+            {
+                INFO_NODE(node, i);
+            }
+            break;
+        }
+
+        prev = node;
+        i++;
+        node = NEXT_PHYS(node);
+    }
+
+    if (node && (node->prev_phys != prev) && (count == 0))
+    {
+        count++;
+        if (osal_is_osrunning())
+        {
+            INFO_NODE(node, i);
+        }
+    }
+
+    /*
+     * Free lists are correct
+     */
+    for (fl = 0; fl < FL_INDEX_COUNT; fl++)
+    {
+        for (sl = 0; sl < SL_INDEX_COUNT; sl++)
+        {
+            blk_node_t *free_node = free_blocks[fl][sl];
+            int f, s;
+
+            if ((free_node != NULL) != ((sl_bitmap[fl] >> sl) & 1))
+            {
+                printk("  Free list bitmap[%i][%i] error\r\n", fl, sl);
+                count++;
+            }
+
+            while (free_node)
+            {
+                mapping_insert(free_node->size, &f, &s);
+                if ((free_node->flag != 0) || (f != fl) || (s != sl))
+                {
+                    count++;
+                    if (osal_is_osrunning())
+                    {
+                        INFO_NODE(free_node, -1);
+                    }
+                    break;
+                }
+
+                free_node = free_node->next_free;
+            }
+        }
+    }
+
+    if (count == 0)
+    {
+        printk("Not found any fault block\r\n");
+    }
+
+    return -count;
+}
+
+int heap_view_isolated_blocks(void)
+{
+    blk_node_t *node = heap_first_node;
+    int count = 0;
+
+    printk("Seek isolated blocks:\r\n");
+
+    while (node && (node != heap_last_node))
+    {
+        if (node->prev_phys && (NEXT_PHYS(node) != heap_last_node) && (node->flag == 0))
+        {
+            count++;
+            printk("  block @0x%016lx, size = %iB\r\n", (long)node, node->size);
+        }
+
+        node = NEXT_PHYS(node);
+    }
+
+    printk("Total %i isolated blocks\r\n", count);
+
+    return count;
 }
 
+//-----------------------------------------------------------------------------
+// add heap addrss & size. Only can add once
+//-----------------------------------------------------------------------------
+
+int heap_add_region(void *addr, size_t size)
+{
+    unsigned char *first_addr;
+
+    if (!addr || (size < 0x100000) || heap_first_node)
+    {
+        return -1;
+    }
+
+    first_addr = (unsigned char *)align_up((size_t)addr, ALLOC_ALIGNMENT);
+    size -= (size_t)first_addr - (size_t)addr;
+    size &= ~(ALLOC_ALIGNMENT - 1);
+
+    if (size > (1UL << FL_INDEX_MAX))
+    {
+        size = 1UL << FL_INDEX_MAX;
+    }
+
+    /*
+     * one blank block and the sentinel
+     */
+    heap_first_node = (blk_node_t *)first_addr;
+    heap_first_node->size = size - 2 * BLOCK_NODE_SZ;
+    heap_first_node->prev_phys = NULL;
+
+    heap_last_node = NEXT_PHYS(heap_first_node);
+    heap_last_node->flag = BLOCK_USED_FLAG;
+    heap_last_node->size = 0;
+    heap_last_node->prev_phys = heap_first_node;
+
+    heap_total_bytes = size - BLOCK_NODE_SZ;
+    heap_remain_bytes = heap_total_bytes;
+
+    insert_free_block(heap_first_node);
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void dump_heap_list(void)
+{
+    int i = 0;
+    blk_node_t *node = heap_first_node;
+
+    while (node && (node != heap_last_node))
+    {
+        INFO_NODE(node, i);
+
+        i++;
+        node = NEXT_PHYS(node);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// malloc() function
+//-----------------------------------------------------------------------------
+
+void *malloc(size_t size)
+{
+	blk_node_t *found_node, *new_node;
+    int fl, sl;
+
+	if ((size <= 0) || (size >= (1UL << FL_INDEX_MAX)))
+    {
+        return NULL;
+    }
+
+    if (size <= ALLOC_MIN_BYTES)
+    {
+        size = ALLOC_MIN_BYTES;
+    }
+    else
+    {
+        size = align_up(size, ALLOC_ALIGNMENT);
+    }
+
+    mapping_search(size, &fl, &sl);
+
+    malloc_oslock();
+
+    found_node = search_suitable_block(&fl, &sl);
+    if (!found_node)
+    {
+        malloc_osunlock();
+        return NULL;
+    }
+
+    remove_free_block(found_node);
+
+    /*
+     * split the remain to a new blank block, if it is large enough
+     */
+    if (found_node->size >= size + BLOCK_NODE_SZ + ALLOC_MIN_BYTES)
+    {
+        new_node = (blk_node_t *)((size_t)NODE_TO_BLOCK(found_node) + size);
+        new_node->size = found_node->size - size - BLOCK_NODE_SZ;
+        new_node->prev_phys = found_node;
+        NEXT_PHYS(new_node)->prev_phys = new_node;
+
+        found_node->size = size;
+
+        insert_free_block(new_node);
+    }
+
+    found_node->flag = BLOCK_USED_FLAG;
+
+    heap_remain_bytes -= found_node->size + BLOCK_NODE_SZ;
+	malloc_osunlock();
+
+	return NODE_TO_BLOCK(found_node);
+}
+
+//-----------------------------------------------------------------------------
+// free() function
+//-----------------------------------------------------------------------------
+
 void free(void *ptr)
 {
-	if (ptr)
-	{
-		blk_node_t *current_block = (blk_node_t *)((uintptr_t)ptr - BLOCK_HEADER_SZ);
-		blk_node_t *block = NULL, *tmp, *next_block = NULL, *last_block = NULL;
-
-		malloc_lock();
-
-		/*
-         * queue list:
-         *
-         *              last_block           current_block        next_block
-         *          - ----------       - ----------       - ----------        -...
-         *        J   |          |    J   |          |    J    |          |    J
-         *      J     |          |  J     |          |  J      |          |  J
-         * ...J       | tqe_next |J       | tqe_next |J        | tqe_next |J
-         *             |          |         |          |          |          |
-         *             |          |         |          |          |          |
-         *              ----------           ----------            ----------
-         *
+    blk_node_t *found_node, *prev, *next;
+
+    if (!ptr)
+    {
+        return;
+    }
+
+    found_node = BLOCK_TO_NODE(ptr);
+
+    if (((size_t)found_node < (size_t)heap_first_node) ||
+        ((size_t)found_node >= (size_t)heap_last_node) ||
+        (found_node->flag != BLOCK_USED_FLAG))
+    {
+        if (osal_is_osrunning())
+        {
+            printk("fatal error: free memory @0x%016lx\r\n", (long)ptr);
+        }
+        return;
+    }
+
+	malloc_oslock();
+
+    heap_remain_bytes += found_node->size + BLOCK_NODE_SZ;
+    found_node->flag = 0;
+
+    /*
+     * Combine previous block node
+     */
+    prev = found_node->prev_phys;
+    if (prev && (prev->flag == 0))
+    {
+        remove_free_block(prev);
+        prev->size += found_node->size + BLOCK_NODE_SZ;
+        found_node = prev;
+        NEXT_PHYS(found_node)->prev_phys = found_node;
+    }
+
+    /*
+     * Combine next block node, the sentinel is always used
+     */
+    next = NEXT_PHYS(found_node);
+    if (next->flag == 0)
+    {
+        remove_free_block(next);
+        found_node->size += next->size + BLOCK_NODE_SZ;
+        NEXT_PHYS(found_node)->prev_phys = found_node;
+    }
+
+    insert_free_block(found_node);
+
+    malloc_osunlock();
+}
+
+#else // #if HEAP_USE_TLSF
+
+/**
+ * memory block node struct
+ */
+typedef struct blk_node
+{
+    unsigned int     flag;                  /* =1: used; =0: blank */
+	unsigned int     size;
+	void            *block;
+    struct blk_node *prev;
+    struct blk_node *next;
+} blk_node_t;
+
+#define BLOCK_NODE_SZ       (align_up(sizeof(blk_node_t), 8))
+
+
+//-----------------------------------------------------------------------------
+
+#define INFO_NODE(node, i) { \
+    printk("  Faulty block[%i] @0x%016lx\r\n", i, (long)node); \
+    printk("    flag  = 0x%08x\r\n", node->flag); \
+    printk("    size  = 0x%08x\r\n", node->size); \
+    printk("    block = 0x%016lx\r\n", (long)node->block); \
+    printk("    prev  = 0x%016lx\r\n", (long)node->prev);  \
+    printk("    next  = 0x%016lx\r\n", (long)node->next); }
+
+//-----------------------------------------------------------------------------
+// free memory queue head
+//-----------------------------------------------------------------------------
+
+static blk_node_t *heap_list_head = NULL;
+
+//-----------------------------------------------------------------------------
+
+int heap_verify_faulty_blocks(void)
+{
+    blk_node_t *node = heap_list_head, *prev, *next;
+    int count = 0, i = 0;
+
+    printk("Verify heap blocks:\r\n");
+
+    while (node)
+    {
+        prev = node->prev;
+        next = node->next;
+
+        /*
+         * Self is correct
          */
+        if ((size_t)node + BLOCK_NODE_SZ != (size_t)node->block)
+        {
+            count++;
+            if (osal_is_osrunning())
+            {
+                INFO_NODE(node, i);
+            }
+            break;
+        }
 
-		/*
-         * memory physical address: low -high
-         *
-         *   ----------------|---------------|---------------------------------
-         *  | next_block     | current_block | last_block                      |
-         *  |H| block        |H| block       |H| block                         |
-         *   ----------------|---------------|---------------------------------
-         *
+        /*
+         * Previous is correct
          */
+        if (prev && ((size_t)prev + BLOCK_NODE_SZ + prev->size != (size_t)node))
+        {
+            count++;
+            if (osal_is_osrunning())
+            {
+                INFO_NODE(node, i);
+            }
+            break;
+        }
 
-		TAILQ_FOREACH_SAFE(block, &free_list_head, link, tmp)
-		{
-			if (block == current_block)
-			{
-			    current_block->flag = 0;
-
-			    /*
-                 * combine with last block
-                 */
-                if ((last_block != NULL) && (last_block->flag == 0) &&
-                   ((uintptr_t)block->block + block->size == (uintptr_t)last_block))
-                {
-                    block->size += last_block->size + BLOCK_HEADER_SZ;
-                    TAILQ_REMOVE(&free_list_head, last_block, link);
-                }
+        /*
+         * Next is correct
+         */
+        if (next && ((size_t)node + BLOCK_NODE_SZ + node->size != (size_t)next))
+        {
+            count++;
+            if (osal_is_osrunning())
+            {
+                INFO_NODE(node, i);
+            }
+            break;
+        }
 
-			    /*
-                 * combine with next block
-                 */
-                next_block = block->link.tqe_next;
-                if ((next_block != NULL) && (next_block->flag == 0) &&
-                   ((uintptr_t)next_block->block + next_block->size == (uintptr_t)block))
-                {
-                    next_block->size += block->size + BLOCK_HEADER_SZ;
-                    TAILQ_REMOVE(&free_list_head, block, link);
-                }
+        i++;
+        node = node->next;
+    }
+
+    if (count == 0)
+    {
+        printk("Not found any fault block\r\n");
+    }
+
+    return -count;
+}
+
+int heap_view_isolated_blocks(void)
+{
+    blk_node_t *node = heap_list_head;
+    int count = 0;
+
+    printk("Seek isolated blocks:\r\n");
+
+    while (node)
+    {
+        if (node->prev && node->next && (node->flag == 0))
+        {
+            count++;
+            printk("  block @0x%016lx, size = %iB\r\n", (long)node, node->size);
+        }
+
+        node = node->next;
+    }
+
+    printk("Total %i isolated blocks\r\n", count);
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+// add heap addrss & size. Only can add once
+//-----------------------------------------------------------------------------
+
+int heap_add_region(void *addr, size_t size)
+{
+    unsigned char *first_addr;
+
+    if (!addr || (size < 0x100000) || heap_list_head)
+    {
+        return -1;
+    }
+
+    first_addr = (unsigned char *)align_up((size_t)addr, ALLOC_ALIGNMENT);
+
+    heap_list_head = (blk_node_t *)first_addr;
+    heap_list_head->block = (void *)(first_addr + BLOCK_NODE_SZ);
+
+    size &= ~(ALLOC_ALIGNMENT - 1);
+    heap_total_bytes = size - BLOCK_NODE_SZ;
+    heap_remain_bytes = heap_total_bytes;
+
+    heap_list_head->size = heap_total_bytes;
+    heap_list_head->flag = 0;
+    heap_list_head->prev = NULL;
+    heap_list_head->next = NULL;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void dump_heap_list(void)
+{
+    int i = 0;
+    blk_node_t *node = heap_list_head;
+
+    while (node)
+    {
+        INFO_NODE(node, i);
+
+        i++;
+        node = node->next;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// malloc() function
+//-----------------------------------------------------------------------------
+
+void *malloc(size_t size)
+{
+	blk_node_t *found_node = heap_list_head, *new_node = NULL;
+
+	if (size <= 0)
+    {
+        return NULL;
+    }
+
+    if (size <= ALLOC_MIN_BYTES)
+    {
+        size = ALLOC_MIN_BYTES;
+    }
+    else
+    {
+        size = align_up(size, ALLOC_ALIGNMENT);
+    }
+
+    malloc_oslock();
+
+    /*
+     * search a free block, Only match the first. TODO optimal match
+     */
+    while (found_node)
+    {
+        if ((found_node->flag == 0) && (found_node->size >= size + BLOCK_NODE_SZ))
+        {
+            break;
+        }
+
+        found_node = found_node->next;
+    }
+
+    if (!found_node)
+    {
+        malloc_osunlock();
+        return NULL;
+    }
+
+    /*
+     * if found_block's remain size less than ALLOC_MIN_BYTES + BLOCK_NODE_SZ,
+     * then use found_block directly.
+     */
+    if ((found_node->size - (size + BLOCK_NODE_SZ)) < (ALLOC_MIN_BYTES + BLOCK_NODE_SZ))
+    {
+        found_node->flag = BLOCK_USED_FLAG;
+
+        heap_remain_bytes -= found_node->size + BLOCK_NODE_SZ;
+        malloc_osunlock();
+        return found_node->block;
+    }
 
-				break;
-			}
-			
-			last_block = block;
-		}
+	/*
+     * found block:
+     *   ------------------------------------------------------------------
+     *  |H| block, size >= size + NODE_HEAD_SZ                             |
+     *   ------------------------------------------------------------------
+     *
+     * after split:
+     *   ---------------|--------------------------------------------------
+     *  | found node    | new node                                         |
+     *  |H| block       |H| block                                          |
+     *   ---------------|--------------------------------------------------
+     *
+     * memory physical address: low -high
+     *
+     */
+
+	new_node = (blk_node_t *)((size_t)found_node->block + size);
+	new_node->flag  = 0;
+	new_node->block = (unsigned char *)new_node + BLOCK_NODE_SZ;
+	new_node->size  = found_node->size - size - BLOCK_NODE_SZ;
+
+    found_node->flag = BLOCK_USED_FLAG;
+    found_node->size = size;
+
+	/*
+     * list:
+     *
+     *                   found_node           new_node
+     *               - ----------       - ----------       -... next
+     *             J _ | prev     |    J _ | prev     |    J _     node
+     *           J L  |          |  J L  |          |  J L
+     * prev ...J L    |     next |J L    |     next |J L
+     * node ... L      |          |.L      |          |.L
+     *                  |          |         |          |
+     *                   ----------           ----------
+     *
+     * new_block has free memory to alloc more
+     */
+
+    new_node->prev = found_node;
+    new_node->next = found_node->next;
+    if (found_node->next)
+        found_node->next->prev = new_node;
+
+    found_node->next = new_node;
+
+    heap_remain_bytes -= size + BLOCK_NODE_SZ;
+	malloc_osunlock();
+
+	return found_node->block;
+}
+
+//-----------------------------------------------------------------------------
+// free() function
+//-----------------------------------------------------------------------------
+
+void free(void *ptr)
+{
+    blk_node_t *found_node = heap_list_head, *prev, *next;
+
+    if (!ptr)
+    {
+        return;
+    }
 
-        debug_dump_list();
+    /*
+     * search for match block
+     */
+    while (found_node)
+    {
+        if ((found_node->flag == BLOCK_USED_FLAG) && (found_node->block == ptr))
+            break;
+
+        found_node = found_node->next;
+    }
 
-		malloc_unlock();
-	}
+    if (!found_node)
+    {
+        if (osal_is_osrunning())
+        {
+            printk("fatal error: free memory @0x%016lx\r\n", (long)ptr);
+        }
+        return;
+    }
+
+	/*
+     * list:
+     *
+     *               prev node            found node           next node
+     *           - ----------       - ----------       - ----------       -
+     *         J _ | prev     |    J _ | prev     |    J _ | prev     |    J _ ...
+     *       J L  |          |  J L  |          |  J L  |          |  J L
+     *     J L    |     next |J L    |     next |J L    |     next |J L
+     *  ... L      |          |.L      |          |.L      |          |.L
+     *              |          |         |          |         |          |
+     *               ----------           ----------           ----------
+     *
+     */
+
+	/*
+     * memory physical address: low -high
+     *
+     *   ----------------|---------------|---------------------------------
+     *  | prev node      | found node    | next node                       |
+     *  |H| block        |H| block       |H| block                         |
+     *   ----------------|---------------|---------------------------------
+     *
+     */
+
+	malloc_oslock();
+
+    heap_remain_bytes += found_node->size + BLOCK_NODE_SZ;
+    found_node->flag = 0;
+
+    prev = found_node->prev;
+    next = found_node->next;
+
+    /*
+     * Combine previous block node
+     */
+    while (prev && (prev->flag == 0))
+    {
+        prev->size += found_node->size + BLOCK_NODE_SZ;
+        prev->next = found_node->next;
+        if (found_node->next)
+            found_node->next->prev = prev;
+
+        found_node = prev;
+        prev = found_node->prev;
+    }
+
+    /*
+     * Combine next block node
+     */
+    while (next && (next->flag == 0))
+    {
+        found_node->size += next->size + BLOCK_NODE_SZ;
+        next = next->next;
+        found_node->next = next;
+        if (next)
+            next->prev = found_node;
+    }
+
+    malloc_osunlock();
 }
 
+#endif // #if HEAP_USE_TLSF
+
+//-----------------------------------------------------------------------------
+// calloc() function
+//-----------------------------------------------------------------------------
+
 void *calloc(size_t nmemb, size_t size)
 {
     void *ptr = malloc(nmemb * size);
-    
+
     if (ptr)
     {
         memset(ptr, 0x00, nmemb * size);
     }
-    
+
     return ptr;
 }
 
+#endif // OS Functions
+
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// realloc() function
+//-----------------------------------------------------------------------------
+
+#ifdef OS_RTTHREAD
+
+void *realloc(void *ptr, size_t size)
+{
+    return rt_realloc(ptr, size);
+}
+
+void *aligned_malloc(size_t size, unsigned int align)
+{
+    return rt_malloc_align((rt_size_t)size, (rt_size_t)align);
+}
+
+void aligned_free(void *addr)
+{
+    rt_free_align(addr);
+}
+
+#else
+
 void *realloc(void *ptr, size_t size)
 {
+    if (size <= 0)
+    {
+        return NULL;
+    }
+
     void *newptr = malloc(size);
     
     if (newptr)
     {
-        memcpy(newptr, ptr, size);
-        
-        free(ptr);
-        
+        if (ptr)
+        {
+            memcpy(newptr, ptr, size);
+            free(ptr);
+        }
+
         return newptr;
     }
-    
-    free(ptr);
-    
+
+    if (ptr)
+    {
+        free(ptr);      // û뵽ڴ, Ƿͷ?
+    }
+
     return NULL;
 }
 
-//-------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// aligned_malloc() function
+//-----------------------------------------------------------------------------
 
 void *aligned_malloc(size_t size, unsigned int align)
 {
     void *head;
-    void **addr;
+    void **addr=NULL;
+
+    if ((size <= 0) || (align == 0))
+    {
+        return NULL;
+    }
+
+    align = (align + 7) & ~0x7;     // atleast aligned 8
 
     head = (void *)malloc(size + align - 1 + sizeof(void *));
 
-    if (size == 0 || head == NULL)
+    if (head == NULL)
+    {
         return NULL;
+    }
 
-    size_t i = (uintptr_t)head + sizeof(void *);
+    size_t i = (size_t)head + sizeof(void *);
 
-    while (i < (uintptr_t)head + sizeof(void *) + align - 1)
+    while (i < (size_t)head + sizeof(void *) + align - 1)
     {
         if  (i % align == 0)
         {
@@ -333,95 +1099,90 @@ void *aligned_malloc(size_t size, unsigned int align)
         i++;
     }
 
-    addr[-1] = head;
+    if (addr)
+    {
+        addr[-1] = head;
+    }
 
     return addr;
 }
 
+//-----------------------------------------------------------------------------
+// aligned_free() function
+//-----------------------------------------------------------------------------
+
 void aligned_free(void *addr)
 {
-	if (addr)
-	{
-		void *ptr = ((void **)addr)[-1];
-		free(ptr);
-	}
+    if (addr)
+    {
+        void *ptr = ((void **)addr)[-1];
+        free(ptr);
+    }
 }
 
-//-------------------------------------------------------------------------------------------------
+#endif // #ifdef OS_RTTHREAD
 
-/*
- * lock alloc with mutex support
- */
-static osal_mutex_t p_alloc_mutex = NULL;
+//-----------------------------------------------------------------------------
+// aligned_realloc() function
+//-----------------------------------------------------------------------------
 
-void malloc_create_oslock(void)
+void *aligned_realloc(void *ptr, size_t size, unsigned int align)
 {
-    if (!p_alloc_mutex)
+    if (size <= 0)
     {
-        p_alloc_mutex = osal_mutex_create("heap_loc", OSAL_OPT_FIFO);
+        return NULL;
     }
-}
 
-void malloc_lock()
-{
-    if (osal_is_osrunning())
+    void *newptr = aligned_malloc(size, align);
+
+    if (newptr)
     {
-        osal_mutex_obtain(p_alloc_mutex, OSAL_WAIT_FOREVER);
+        if (ptr)
+        {
+            memcpy(newptr, ptr, size);
+
+            aligned_free(ptr);
+        }
+
+        return newptr;
     }
-}
 
-void malloc_unlock()
-{
-    if (osal_is_osrunning())
+    if (ptr)
     {
-        osal_mutex_release(p_alloc_mutex);
+        aligned_free(ptr);      // û뵽ڴ, Ƿͷ?
     }
-}
-
-void malloc_addblock(void *addr, size_t size)
-{
-	blk_node_t *new_memory_block = (void *)align_up((uintptr_t)addr, sizeof(void *));
 
-	new_memory_block->size  = (uintptr_t)addr + size - (uintptr_t)new_memory_block - BLOCK_HEADER_SZ;
-    new_memory_block->block = (void *)new_memory_block + BLOCK_HEADER_SZ;
-    new_memory_block->flag  = 0;
-
-	malloc_lock();
+    return NULL;
+}
 
-    TAILQ_INSERT_HEAD(&free_list_head, new_memory_block, link);
+//-----------------------------------------------------------------------------
+// Ԥ libbsp.a þɽӿڳʼ
+//-----------------------------------------------------------------------------
 
-	malloc_unlock();
-}
+#if !defined(OS_RTTHREAD) && !defined(OS_FREERTOS)
 
 void malloc_init(void)
 {
-    TAILQ_INIT(&free_list_head);
 }
 
-/**
- * 鿴ʣڴ
- */
-size_t get_heap_free_size(void)
+void malloc_addblock(void *addr, size_t size)
 {
-    size_t free_size = 0;
-    blk_node_t *block = NULL, *tmp;
-
-	malloc_lock();
-
-	TAILQ_FOREACH_SAFE(block, &free_list_head, link, tmp)
-	{
-	    if (block->flag == 0)
-            free_size += block->size;
-	}
+    heap_add_region(addr, size);
+}
 
-    malloc_unlock();
+void malloc_lock(void)
+{
+    malloc_oslock();
+}
 
-    return free_size;
+void malloc_unlock(void)
+{
+    malloc_osunlock();
 }
 
-#endif // #ifndef OS_RTTHREAD
+#endif
 
-//-------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
 
 #endif // #if !BSP_USE_FS
 
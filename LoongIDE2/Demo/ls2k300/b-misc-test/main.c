@@ -17,6 +17,8 @@
 #include "ls2k_dc.h"
 #include "ls2k_adc.h"
 
+#include "misc_test.h"
+
 //-----------------------------------------------------------------------------
 // Simple demo of task
 //-----------------------------------------------------------------------------
@@ -104,6 +106,22 @@ int main(void)
     printf("Hello world!\r\n");
     printf("Welcome to Loongson 2K300!\r\n");
 
+    #if TEST_HEAP_BENCH
+    heap_bench();
+    #endif
+
+    #if TEST_NORFLASH_BENCH
+    norflash_bench();
+    #endif
+
+    #if TEST_ADC_STREAM_BENCH
+    adc_stream_bench();
+    #endif
+
+    #if TEST_TRACE_BENCH
+    trace_bench();
+    #endif
+
     #if BSP_USE_DC
     {
         extern void dc_test(void);
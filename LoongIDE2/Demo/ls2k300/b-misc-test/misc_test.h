@@ -0,0 +1,56 @@
+/*
+ * misc_test.h
+ *
+ * created: 2026-10-17
+ *  author:
+ */
+
+#ifndef _MISC_TEST_H
+#define _MISC_TEST_H
+
+/******************************************************************************
+ * malloc/free ѹ,  heap_bench.c
+ */
+#define TEST_HEAP_BENCH         0
+#if TEST_HEAP_BENCH
+
+extern void heap_bench(void);
+
+#endif
+
+/******************************************************************************
+ * SPI0 NOR Flash дٶȲ,  norflash_bench.c
+ */
+#define TEST_NORFLASH_BENCH     0
+#if TEST_NORFLASH_BENCH
+
+extern void norflash_bench(void);
+
+#endif
+
+/******************************************************************************
+ * ADC ʱģʽɼ,  adc_stream_bench.c
+ */
+#define TEST_ADC_STREAM_BENCH   0
+#if TEST_ADC_STREAM_BENCH
+
+extern void adc_stream_bench(void);
+
+#endif
+
+/******************************************************************************
+ * framebuffer ͼҳлٶȲ,  dc_test() ,  dc_test.c
+ */
+#define TEST_FB_BENCH           0
+
+/******************************************************************************
+ * TRACE() ÿ¼Ŀ,  trace_bench.c
+ */
+#define TEST_TRACE_BENCH        0
+#if TEST_TRACE_BENCH
+
+extern void trace_bench(void);
+
+#endif
+
+#endif // _MISC_TEST_H
@@ -0,0 +1,155 @@
+/*
+ * norflash_bench.c
+ *
+ * created: 2026-10-17
+ *  author:
+ */
+
+/*
+ * SPI0 NOR Flash дٶȲ.
+ *
+ * :  / ٶ / IOCTL_NORFLASH_GET_MMAP ֱӷ,  BENCH_READ_SIZE ֽ;
+ * д:  flash β 64K , ʱ䲻.
+ */
+
+#include "bsp.h"
+#include "misc_test.h"
+
+#if TEST_NORFLASH_BENCH && NORFLASH_DRV
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ls2k_spi_bus.h"
+#include "spi/norflash.h"
+
+#define BENCH_BUF_SIZE      0x10000                 // 64K
+#define BENCH_READ_SIZE     0x40000                 // 256K
+#define BENCH_READ_OFFSET   0
+
+/*
+ * NORFLASH_CHIP_SIZE=4M, β 64K ̲
+ */
+#define BENCH_WRITE_OFFSET  (0x400000 - 0x10000)
+
+static unsigned char bench_buf[BENCH_BUF_SIZE] __attribute__((aligned(8)));
+
+static void bench_report(const char *name, unsigned int bytes, unsigned int ms)
+{
+    if (ms == 0)
+        ms = 1;
+
+    printk("%-16s %7u bytes, %5u ms, %6u KB/s\r\n",
+           name, bytes, ms, (unsigned int)((unsigned long)bytes * 1000 / 1024 / ms));
+}
+
+static void bench_read(const char *name)
+{
+    unsigned int offset, ticks;
+
+    ticks = get_clock_ticks();
+
+    for (offset=0; offset<BENCH_READ_SIZE; offset+=BENCH_BUF_SIZE)
+    {
+        unsigned int addr = BENCH_READ_OFFSET + offset;
+
+        if (ls2k_norflash_read(busSPI0, bench_buf, BENCH_BUF_SIZE, &addr) != BENCH_BUF_SIZE)
+        {
+            printk("%s: read 0x%x fail\r\n", name, addr);
+            return;
+        }
+    }
+
+    bench_report(name, BENCH_READ_SIZE, get_clock_ticks() - ticks);
+}
+
+static void bench_mmap_read(void)
+{
+    NORFLASH_mmap_t map;
+    const volatile unsigned long *p;
+    unsigned long sum = 0;
+    unsigned int i, ticks;
+
+    map.offset = BENCH_READ_OFFSET;
+    map.size   = BENCH_READ_SIZE;
+
+    if (ls2k_norflash_ioctl(busSPI0, IOCTL_NORFLASH_GET_MMAP, &map) != 0)
+    {
+        printk("IOCTL_NORFLASH_GET_MMAP fail\r\n");
+        return;
+    }
+
+    ticks = get_clock_ticks();
+
+    p = (const volatile unsigned long *)map.ptr;
+    for (i=0; i<BENCH_READ_SIZE/8; i++)
+        sum += p[i];
+
+    bench_report("mmap (no copy)", BENCH_READ_SIZE, get_clock_ticks() - ticks);
+    printk("checksum 0x%016lx\r\n", sum);
+}
+
+static void bench_write(void)
+{
+    unsigned int addr = BENCH_WRITE_OFFSET, i, ticks;
+    int rt;
+
+    for (i=0; i<BENCH_BUF_SIZE; i++)
+        bench_buf[i] = (unsigned char)(i * 7 + (i >> 8));
+
+    if (ls2k_norflash_ioctl(busSPI0, IOCTL_NORFLASH_ERASE_64K, (void *)(unsigned long)addr) != 0)
+    {
+        printk("erase 0x%x fail\r\n", addr);
+        return;
+    }
+
+    ticks = get_clock_ticks();
+    rt = ls2k_norflash_write(busSPI0, bench_buf, BENCH_BUF_SIZE, &addr);
+    ticks = get_clock_ticks() - ticks;
+
+    if (rt != BENCH_BUF_SIZE)
+    {
+        printk("program 0x%x fail, rt=%i\r\n", addr, rt);
+        return;
+    }
+
+    bench_report("page program", BENCH_BUF_SIZE, ticks);
+
+    /*
+     * verify, дڿٶռ֮, 
+     */
+    memset(bench_buf, 0, BENCH_BUF_SIZE);
+    ls2k_norflash_read(busSPI0, bench_buf, BENCH_BUF_SIZE, &addr);
+
+    for (i=0; i<BENCH_BUF_SIZE; i++)
+    {
+        if (bench_buf[i] != (unsigned char)(i * 7 + (i >> 8)))
+        {
+            printk("verify fail at 0x%x\r\n", addr + i);
+            break;
+        }
+    }
+
+    if (i == BENCH_BUF_SIZE)
+        printk("verify ok\r\n");
+}
+
+void norflash_bench(void)
+{
+    printk("norflash bench\r\n");
+
+    ls2k_norflash_ioctl(busSPI0, IOCTL_FLASH_FAST_READ_DISABLE, NULL);
+    bench_read("command read");
+
+    ls2k_norflash_ioctl(busSPI0, IOCTL_FLASH_FAST_READ_ENABLE, NULL);
+    bench_read("fast read copy");
+
+    bench_mmap_read();
+
+    bench_write();
+
+    ls2k_norflash_ioctl(busSPI0, IOCTL_FLASH_FAST_READ_ENABLE, NULL);
+}
+
+#endif // #if TEST_NORFLASH_BENCH && NORFLASH_DRV
+
@@ -0,0 +1,67 @@
+/*
+ * trace_bench.c
+ *
+ * created: 2026-10-17
+ *  author:
+ */
+
+/*
+ * ÿ¼Ŀ: TRACE()  snprintf() ʽд뻺ĶԱ.
+ *
+ *  rdtime.d ļ,  CPU ʱ,  hda_1us_count Ϊ.
+ */
+
+#include "bsp.h"
+#include "misc_test.h"
+
+#if TEST_TRACE_BENCH
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ls2k300.h"
+#include "ls2k_trace.h"
+
+#define BENCH_LOOPS         100000
+
+void trace_bench(void)
+{
+    static char line[128];
+    unsigned long t0, t_trace, t_fmt;
+    int i;
+
+    trace_reset();
+
+    t0 = get_stable_counter();
+    for (i=0; i<BENCH_LOOPS; i++)
+    {
+        TRACE("GMAC%i rx dropped: desc[%i] status=0x%08x", 0, i & 255, 0x80000300 | i);
+    }
+    t_trace = get_stable_counter() - t0;
+
+    t0 = get_stable_counter();
+    for (i=0; i<BENCH_LOOPS; i++)
+    {
+        snprintf(line, sizeof(line), "GMAC%i rx dropped: desc[%i] status=0x%08x", 0, i & 255, 0x80000300 | i);
+    }
+    t_fmt = get_stable_counter() - t0;
+
+    printk("TRACE:    %lu.%02lu counts/event, %lu ns\r\n",
+           t_trace / BENCH_LOOPS, t_trace * 100 / BENCH_LOOPS % 100,
+           t_trace * 1000 / hda_1us_count / BENCH_LOOPS);
+    printk("snprintf: %lu.%02lu counts/event, %lu ns\r\n",
+           t_fmt / BENCH_LOOPS, t_fmt * 100 / BENCH_LOOPS % 100,
+           t_fmt * 1000 / hda_1us_count / BENCH_LOOPS);
+
+    /* ¼ */
+    trace_print(0);
+    trace_reset();
+}
+
+#endif // #if TEST_TRACE_BENCH
+
+//-----------------------------------------------------------------------------
+/*
+ * @@ END
+ */
+
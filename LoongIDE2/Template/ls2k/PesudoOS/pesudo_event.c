@@ -185,6 +185,7 @@ static struct pesudo_task *pesudo_event_receive_internal(struct pesudo_event *ev
 #if PESUDO_OS_VER >= 3
                         TAILQ_REMOVE(&event->waiting_tasks, task, list4event);
 #endif
+                        pesudoos_task_wakeup(task);
                     }
                     break;
             }
@@ -208,6 +209,7 @@ static struct pesudo_task *pesudo_event_receive_internal(struct pesudo_event *ev
 #if PESUDO_OS_VER >= 3
             TAILQ_REMOVE(&event->waiting_tasks, find_task, list4event);
 #endif
+            pesudoos_task_wakeup(find_task);
         }
     }
 
@@ -268,6 +270,7 @@ int pesudo_event_send(struct pesudo_event *event, uint32_t bits)
                     {
                         task->state |= PT_RECV_EVENT;
                         task->wait_event_bits = use_bits;
+                        pesudoos_task_wakeup(task);
                     }
                     break;
             }
@@ -288,6 +291,7 @@ int pesudo_event_send(struct pesudo_event *event, uint32_t bits)
         {
             find_task->state |= PT_RECV_EVENT;
             find_task->wait_event_bits = use_bits;
+            pesudoos_task_wakeup(find_task);
         }
     }
 
@@ -298,7 +302,17 @@ int pesudo_event_send(struct pesudo_event *event, uint32_t bits)
      */
     if (!RunningInsideISR)
     {
-        pesudo_event_receive_internal(event);
+        /*
+         * ʱѭټһ, ܻ
+         */
+        if (pesudo_event_receive_internal(event))
+        {
+            pesudoos_object_signal();
+        }
+    }
+    else
+    {
+        pesudoos_object_signal();
     }
 
 #endif
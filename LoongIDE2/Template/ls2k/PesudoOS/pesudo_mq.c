@@ -214,6 +214,7 @@ static struct pesudo_task *pesudo_mq_receive_internal(struct pesudo_mq *mq)
 #if PESUDO_OS_VER >= 3
         TAILQ_REMOVE(&mq->waiting_tasks, find_task, list4mq);
 #endif
+        pesudoos_task_wakeup(find_task);
     }
 
     return find_task;
@@ -275,6 +276,7 @@ int pesudo_mq_send(struct pesudo_mq *mq, const void *msg)
     if (find_task)
     {
         find_task->state |= PT_RECV_MQ;
+        pesudoos_task_wakeup(find_task);
     }
 
 #elif PESUDO_OS_VER >= 2
@@ -286,6 +288,10 @@ int pesudo_mq_send(struct pesudo_mq *mq, const void *msg)
     {
         pesudo_mq_receive_internal(mq);
     }
+    else
+    {
+        pesudoos_object_signal();
+    }
 
 #endif
 
@@ -271,6 +271,7 @@ int pesudo_mutex_release(struct pesudo_mutex *mutex)
 #if PESUDO_OS_VER >= 3
             TAILQ_REMOVE(&mutex->waiting_tasks, find_task, list4mutex);
 #endif
+            pesudoos_task_wakeup(find_task);
         }
     }
 
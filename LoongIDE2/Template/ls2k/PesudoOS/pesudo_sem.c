@@ -230,6 +230,7 @@ static struct pesudo_task *pesudo_sem_obtain_internal(struct pesudo_sem *sem)
 #if PESUDO_OS_VER >= 3
         TAILQ_REMOVE(&sem->waiting_tasks, find_task, list4sem);
 #endif
+        pesudoos_task_wakeup(find_task);
     }
 
     return find_task;
@@ -283,6 +284,7 @@ int pesudo_sem_release(struct pesudo_sem *sem)
     {
         find_task->state |= PT_OBTAIN_SEM;
         sem->count--;
+        pesudoos_task_wakeup(find_task);
     }
 
 #elif PESUDO_OS_VER >= 2
@@ -294,6 +296,10 @@ int pesudo_sem_release(struct pesudo_sem *sem)
     {
         pesudo_sem_obtain_internal(sem);
     }
+    else
+    {
+        pesudoos_object_signal();
+    }
 
 #endif
 
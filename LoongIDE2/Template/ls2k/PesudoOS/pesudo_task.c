@@ -75,8 +75,13 @@ struct pesudo_task *pesudo_task_create(const char *name,
     task->first_run_until = get_clock_ticks() + run_after_ms;
     task->ID = (uintptr_t)task;     /* TODO */
 
-    pesudoos_task_list_add(task);
-    
+    if (pesudoos_task_list_add(task) != 0)
+    {
+        free(task->stack_base);
+        free(task);
+        return NULL;
+    }
+
     return task;
 }
 
@@ -127,6 +132,7 @@ void pesudo_task_resume(struct pesudo_task *task)
     if (task && (task->state == PT_STATE_SUSPEND))
     {
         task->state = PT_STATE_READY;
+        pesudoos_task_wakeup(task);
     }
 }
 
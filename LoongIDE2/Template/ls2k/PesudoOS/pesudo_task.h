@@ -19,6 +19,16 @@ extern "C" {
 #include <setjmp.h>
 #include <sys/queue.h>
 
+/*
+ * glibc  sys/queue.h û TAILQ_FOREACH_SAFE
+ */
+#ifndef TAILQ_FOREACH_SAFE
+#define TAILQ_FOREACH_SAFE(var, head, field, tvar)              \
+    for ((var) = TAILQ_FIRST((head));                           \
+         (var) && ((tvar) = TAILQ_NEXT((var), field), 1);       \
+         (var) = (tvar))
+#endif
+
 //-------------------------------------------------------------------------------------
 
 #define PESUDO_TASK_MAX         16          /* δʹ */
@@ -137,6 +147,14 @@ struct pesudo_task
 
     void *user_data;                            /* ûԶ */
 
+    /*
+     * ר
+     */
+    TAILQ_ENTRY(pesudo_task) list4ready;        /*  */
+    volatile uint32_t in_ready;                 /* ھ */
+    uint32_t  wait_index;                       /* ڳʱеλ, 0=ڶ */
+    size_t    wait_until;                       /* ʱѵļֵ ticks */
+
     /*
      * ͳ
      */
@@ -162,6 +180,19 @@ extern struct pesudo_task *current_pesudo_task;
 
 //-----------------------------------------------------------------------------
 
+/**
+ * : ֻھлʱʱŻᱻѭ
+ *
+ * pesudoos_task_wakeup():  , ͷ sem/mutex event/mq ʱ
+ * pesudoos_task_wait():     ticks ʱ,  IDLESLEEP ʱ
+ * pesudoos_object_signal(): жз event/mq/sem, ѭҪһ
+ */
+void pesudoos_task_wakeup(struct pesudo_task *task);
+void pesudoos_task_wait(struct pesudo_task *task, size_t until);
+void pesudoos_object_signal(void);
+
+//-----------------------------------------------------------------------------
+
 struct pesudo_task *pesudo_task_create(const char *name,            /*  */
                                        uint32_t stack_size,         /* ջС */
                                        uint32_t run_after_ms,       /* ӳٴ */
@@ -152,6 +152,8 @@ int pesudo_timer_start(struct pesudo_timer *tmr, uint32_t timeout_ms)
 
         tmr->tmr_task->sleep_until = get_clock_ticks() + tmr->timeout_ms;
         tmr->tmr_task->state = PT_STATE_SLEEP;
+
+        pesudoos_task_wait(tmr->tmr_task, tmr->tmr_task->sleep_until);
     }
 
     return 0;
@@ -67,6 +67,154 @@ extern void process_pesudo_mq_from_isr(void);
  */
 static int task_count = 0;     
 
+//-----------------------------------------------------------------------------
+// кͳʱ
+//-----------------------------------------------------------------------------
+
+/*
+ * : Ⱥ˳
+ */
+static TAILQ_HEAD(__pesudo_ready_list, pesudo_task) pesudo_ready_list = \
+       TAILQ_HEAD_INITIALIZER(pesudo_ready_list);
+
+/*
+ * ʱ:  wait_until С, ± 1 ʼ.
+ *
+ * ÿڶгһ, ڴʱ, ʱʧ.
+ */
+static struct pesudo_task **wait_heap = NULL;
+static uint32_t wait_heap_size = 0;
+static uint32_t wait_heap_cap = 0;
+
+/*
+ * жз event/mq/sem,  event ܻ
+ */
+static volatile int pesudo_object_pending = 0;
+
+/*
+ * Ѽ, жϴжϷ͵ĶʱǷ
+ */
+static uint32_t pesudo_wakeup_count = 0;
+
+static void wait_heap_set(uint32_t index, struct pesudo_task *task)
+{
+    wait_heap[index] = task;
+    task->wait_index = index;
+}
+
+static void wait_heap_up(uint32_t index)
+{
+    struct pesudo_task *task = wait_heap[index];
+
+    while (index > 1)
+    {
+        uint32_t parent = index / 2;
+
+        if (wait_heap[parent]->wait_until <= task->wait_until)
+        {
+            break;
+        }
+
+        wait_heap_set(index, wait_heap[parent]);
+        index = parent;
+    }
+
+    wait_heap_set(index, task);
+}
+
+static void wait_heap_down(uint32_t index)
+{
+    struct pesudo_task *task = wait_heap[index];
+
+    for ( ;; )
+    {
+        uint32_t child = index * 2;
+
+        if (child > wait_heap_size)
+        {
+            break;
+        }
+
+        if ((child < wait_heap_size) &&
+            (wait_heap[child + 1]->wait_until < wait_heap[child]->wait_until))
+        {
+            child++;
+        }
+
+        if (task->wait_until <= wait_heap[child]->wait_until)
+        {
+            break;
+        }
+
+        wait_heap_set(index, wait_heap[child]);
+        index = child;
+    }
+
+    wait_heap_set(index, task);
+}
+
+static void wait_heap_remove(struct pesudo_task *task)
+{
+    uint32_t index = task->wait_index;
+    struct pesudo_task *last;
+
+    if (index == 0)
+    {
+        return;
+    }
+
+    task->wait_index = 0;
+    last = wait_heap[wait_heap_size--];
+
+    if (last != task)
+    {
+        wait_heap_set(index, last);
+        wait_heap_up(index);
+        wait_heap_down(last->wait_index);
+    }
+}
+
+static void ready_list_remove(struct pesudo_task *task)
+{
+    if (task->in_ready)
+    {
+        task->in_ready = 0;
+        TAILQ_REMOVE(&pesudo_ready_list, task, list4ready);
+    }
+}
+
+void pesudoos_task_wait(struct pesudo_task *task, size_t until)
+{
+    task->wait_until = until;
+
+    if (task->wait_index)
+    {
+        wait_heap_up(task->wait_index);
+        wait_heap_down(task->wait_index);
+    }
+    else
+    {
+        wait_heap[++wait_heap_size] = task;
+        wait_heap_up(wait_heap_size);
+    }
+}
+
+void pesudoos_task_wakeup(struct pesudo_task *task)
+{
+    pesudo_wakeup_count++;
+
+    if (!task->in_ready)
+    {
+        task->in_ready = 1;
+        TAILQ_INSERT_TAIL(&pesudo_ready_list, task, list4ready);
+    }
+}
+
+void pesudoos_object_signal(void)
+{
+    pesudo_object_pending = 1;
+}
+
 //-----------------------------------------------------------------------------
 // 
 //-----------------------------------------------------------------------------
@@ -87,9 +235,33 @@ int pesudoos_task_list_add(struct pesudo_task *task)
         }
     }
 
+    /*
+     * ʱѵС
+     */
+    if (task_count + 1 > (int)wait_heap_cap)
+    {
+        uint32_t cap = wait_heap_cap ? wait_heap_cap * 2 : 16;
+        struct pesudo_task **heap;
+
+        heap = (struct pesudo_task **)realloc(wait_heap, (cap + 1) * sizeof(struct pesudo_task *));
+        if (NULL == heap)
+        {
+            errno = ENOMEM;
+            return -1;
+        }
+
+        wait_heap = heap;
+        wait_heap_cap = cap;
+    }
+
     task_count++;
     TAILQ_INSERT_TAIL(&pesudo_task_list, task, list);
 
+    /*
+     * ½ first_run_until ʱ
+     */
+    pesudoos_task_wait(task, task->first_run_until);
+
     return 0;
 }
 
@@ -104,6 +276,9 @@ int pesudoos_task_list_remove(struct pesudo_task *task)
         return -1;
     }
 
+    ready_list_remove(task);
+    wait_heap_remove(task);
+
     task_count--;
     TAILQ_REMOVE(&pesudo_task_list, task, list);
 
@@ -130,182 +305,284 @@ struct pesudo_task *pesudoos_task_list_next(struct pesudo_task *task)
 #define BLOCKED_OBJ     (1)
 #endif
 
-void pesudoos_run(int deadloop)
+/*
+ * Ĭϵѭ, ʲô
+ */
+__attribute__((weak)) void pesudoos_idle_hook(void)
 {
+}
+
+/*
+ * ûʱȴж.
+ *
+ * кͽ idle ֮䷢жҪһʱж (1ms) Ŵ.
+ */
+static inline void pesudoos_idle(void)
+{
+#if defined(__loongarch__)
+    asm volatile( "idle 0" );
+#endif
+}
+
+/*
+ * 񱻻ѻ߳ʱʱ longjmp ֵ, 0: ȴ
+ */
+static int pesudoos_blocked_result(struct pesudo_task *task, uint32_t got, size_t cur_ticks)
+{
+    if (!BLOCKED_OBJ)
+    {
+        return 0;
+    }
+
+    if (task->state & got)                          /* Ѿȡ */
+    {
+        return got;
+    }
+
+    if (task->block_until <= cur_ticks)             /* ʱ */
+    {
+        return -ETIMEDOUT;
+    }
+
+    return 0;
+}
+
+/*
+ * нصѭ: лʱ.
+ *
+ *  1 ʾȴɾ
+ */
+static int pesudoos_task_return(struct pesudo_task *task)
+{
+    size_t cur_ticks;
+
     /*
-     * do some initializing work here
+     * ջǷԽ
      */
+    if (task->stack_base[0] != PESUDO_STACK_MAGIC)
+    {
+        pesudoos_dbg(PESUDOOS_DBG_TASK, "%s's stack is overflow!\r\n", task->task_name);
 
-    for ( ;; )
+        while (1)
+        {
+            asm volatile( "nop" );
+        }
+    }
+
+    /*
+     * пܱ
+     */
+    cur_ticks = get_clock_ticks();
+    task->run_ticks = cur_ticks - task->run_begintick;
+    task->run_begintick = cur_ticks;
+
+    /*
+     * н
+     */
+    if (task->state & PT_STATE_RUNNING)
     {
-        struct pesudo_task *task, *tmp;
+        task->run_count++;
 
-        TAILQ_FOREACH_SAFE(task, &pesudo_task_list, list, tmp)
+        /*
+         * ǲǶʱ: صȷ´ִʱ
+         */
+        if (task->p_timer && task->timer_callback)
         {
-            size_t cur_ticks = get_clock_ticks();
+            task->timer_callback(task);
+        }
+        else if (task->state & PT_WANT_DELETE)
+        {
+            task->state = PT_STATE_SUSPEND;
+            return 1;
+        }
+        else if (task->state & PT_WANT_SUSPEND)
+        {
+            task->state = PT_STATE_SUSPEND;
+        }
+        else
+        {
+            task->state = PT_STATE_READY;
+        }
+    }
 
-            /**
-             * õǰе
-             */
-            current_pesudo_task = task;
+    if (task->state == PT_STATE_READY)
+    {
+        pesudoos_task_wakeup(task);
+    }
+    else if (task->state & PT_STATE_SLEEP)
+    {
+        pesudoos_task_wait(task, task->sleep_until);
+    }
+    else if (IS_BLOCKED(task->state))
+    {
+        pesudoos_task_wait(task, task->block_until);
+    }
 
-            /*
-             * ½ IDLE
-             */
-            if (task->state == PT_STATE_IDLE)
-            {
-                if (task->first_run_until <= cur_ticks)
-                {
-                    task->state = PT_STATE_READY;
-                }
-            }
+    return 0;
+}
 
+/*
+ * о, λ. صȴɾ.
+ *
+ * ָнʱ, ص״ʱ jmp_func_with_stack()
+ * ĵô, ʱĴеľֲѾʧЧ, ֻʹ current_pesudo_task.
+ * ˱, ֻһ jmp_func_with_stack() λ.
+ */
+static __attribute__((noinline))
+struct pesudo_task *pesudoos_dispatch(struct pesudo_task *task, size_t cur_ticks)
+{
+    int resume = 0;
+
+    wait_heap_remove(task);
+
+    /*
+     * ½ IDLE
+     */
+    if (task->state == PT_STATE_IDLE)
+    {
+        if (task->first_run_until > cur_ticks)
+        {
+            pesudoos_task_wait(task, task->first_run_until);
+            return NULL;
+        }
+
+        task->state = PT_STATE_READY;
+    }
+
+    /*
+     * 1st wakeup sleep task
+     */
+    else if (task->state & PT_STATE_SLEEP)
+    {
+        if (task->sleep_until > cur_ticks)
+        {
+            pesudoos_task_wait(task, task->sleep_until);
+            return NULL;
+        }
+
+        if (task->p_timer && task->timer_callback)
+        {
             /*
-             * 1st wakeup sleep task
+             * Timer  sleep ֱӾ: ӳִ
              */
-            if (task->state & PT_STATE_SLEEP)
-            {
-                if (task->sleep_until <= cur_ticks)
-                {
-                    if (task->p_timer && task->timer_callback)
-                    {
-                        /*
-                         * Timer  sleep ֱӾ: ӳִ
-                         */
-                        task->state = PT_STATE_READY;
-                    }
-                    else
-                    {
-                        /*
-                         * pesudo_task_sleep()  sleep
-                         */
-                        longjmp(task->func_exit_pos, 1);
-                    }
-                }
-            }
-
+            task->state = PT_STATE_READY;
+        }
+        else
+        {
             /*
-             * 2nd check timeout of mutexsemeventmq
-             *
-             * There is only one object is blocked anytime, never more.
+             * pesudo_task_sleep()  sleep
              */
+            resume = 1;
+        }
+    }
 
-            else if ((task->state & PT_BLOCKED_MUTEX) && BLOCKED_OBJ)
-            {
-                if (task->state & PT_OBTAIN_MUTEX)          /* Ѿȡ */
-                {
-                    longjmp(task->func_exit_pos, PT_OBTAIN_MUTEX);
-                }
-                else if (task->block_until <= cur_ticks)    /* ʱ */
-                {
-                    longjmp(task->func_exit_pos, -ETIMEDOUT);
-                }
-            }
+    /*
+     * 2nd check timeout of mutexsemeventmq
+     *
+     * There is only one object is blocked anytime, never more.
+     */
+    else if (task->state & PT_BLOCKED_MUTEX)
+    {
+        resume = pesudoos_blocked_result(task, PT_OBTAIN_MUTEX, cur_ticks);
+    }
+    else if (task->state & PT_BLOCKED_SEM)
+    {
+        resume = pesudoos_blocked_result(task, PT_OBTAIN_SEM, cur_ticks);
+    }
+    else if (task->state & PT_BLOCKED_EVENT)
+    {
+        resume = pesudoos_blocked_result(task, PT_RECV_EVENT, cur_ticks);
+    }
+    else if (task->state & PT_BLOCKED_MQ)
+    {
+        resume = pesudoos_blocked_result(task, PT_RECV_MQ, cur_ticks);
+    }
 
-            else if ((task->state & PT_BLOCKED_SEM) && BLOCKED_OBJ)
-            {
-                if (task->state & PT_OBTAIN_SEM)            /* Ѿȡ */
-                {
-                    longjmp(task->func_exit_pos, PT_OBTAIN_SEM);
-                }
-                else if (task->block_until <= cur_ticks)    /* ʱ */
-                {
-                    longjmp(task->func_exit_pos, -ETIMEDOUT);
-                }
-            }
+    if (IS_BLOCKED(task->state) && (resume == 0))
+    {
+        pesudoos_task_wait(task, task->block_until);
+        return NULL;
+    }
 
-            else if ((task->state & PT_BLOCKED_EVENT) && BLOCKED_OBJ)
-            {
-                if (task->state & PT_RECV_EVENT)            /* յ¼ */
-                {
-                    longjmp(task->func_exit_pos, PT_RECV_EVENT);
-                }
-                else if (task->block_until <= cur_ticks)    /* ʱ */
-                {
-                    longjmp(task->func_exit_pos, -ETIMEDOUT);
-                }
-            }
+    /*
+     * 3rd run ready task. 
+     */
+    if ((resume == 0) && (task->state != PT_STATE_READY))
+    {
+        return NULL;
+    }
 
-            else if ((task->state & PT_BLOCKED_MQ) && BLOCKED_OBJ)
-            {
-                if (task->state & PT_RECV_MQ)               /* յϢ */
-                {
-                    longjmp(task->func_exit_pos, PT_RECV_MQ);
-                }
-                else if (task->block_until <= cur_ticks)    /* ʱ */
-                {
-                    longjmp(task->func_exit_pos, -ETIMEDOUT);
-                }
-            }
+    /**
+     * õǰе
+     */
+    current_pesudo_task = task;
+
+    if (setjmp(__mainloop_jmp_pos) == 0)
+    {
+        if (resume)
+        {
+            longjmp(task->func_exit_pos, resume);
+        }
+
+        task->state = PT_STATE_RUNNING;
+        task->run_begintick = cur_ticks;
+
+        jmp_func_with_stack(task->handler,
+                            task->arg,
+                            task->stack_cur_top);
+    }
+
+    /*
+     * н߱
+     */
+    task = current_pesudo_task;
+    current_pesudo_task = NULL;
+
+    return pesudoos_task_return(task) ? task : NULL;
+}
+
+void pesudoos_run(int deadloop)
+{
+    /*
+     * do some initializing work here
+     */
+
+    for ( ;; )
+    {
+        struct pesudo_task *task;
+        size_t cur_ticks = get_clock_ticks();
+        int count = 0;
+
+        /*
+         * ʱ
+         */
+        while ((wait_heap_size > 0) && (wait_heap[1]->wait_until <= cur_ticks))
+        {
+            task = wait_heap[1];
+            wait_heap_remove(task);
+            pesudoos_task_wakeup(task);
+        }
+
+        /*
+         * бֿʼʱѾ, оںһ
+         */
+        TAILQ_FOREACH(task, &pesudo_ready_list, list4ready)
+        {
+            count++;
+        }
+
+        while ((count-- > 0) && ((task = TAILQ_FIRST(&pesudo_ready_list)) != NULL))
+        {
+            ready_list_remove(task);
+
+            task = pesudoos_dispatch(task, cur_ticks);
 
             /*
-             * 3rd run ready task
+             * бɾ
              */
-            else if (task->state == PT_STATE_READY)
+            if (task)
             {
-                task->state = PT_STATE_RUNNING;
-                task->run_begintick = cur_ticks;
-
-                if (setjmp(__mainloop_jmp_pos) == 0)
-                {
-                    jmp_func_with_stack(task->handler,
-                                        task->arg,
-                                        task->stack_cur_top);
-                }
-                else
-                {
-                    /*
-                     * return from blocked
-                     */
-
-                    // do something here?
-
-                }
-
-                /*
-                 * ջǷԽ
-                 */
-                if (task->stack_base[0] != PESUDO_STACK_MAGIC)
-                {
-                    pesudoos_dbg(PESUDOOS_DBG_TASK, "%s's stack is overflow!\r\n", task->task_name);
-                    
-                    while (1)
-                    {
-                        asm volatile( "nop" );
-                    }
-                }
-
-                /*
-                 * пܱ
-                 */
-                cur_ticks = get_clock_ticks();
-                task->run_ticks = cur_ticks - task->run_begintick;
-                task->run_begintick = cur_ticks;
-
-                /*
-                 * н
-                 */
-                if (task->state & PT_STATE_RUNNING)
-                {
-                    task->run_count++;
-
-                    /*
-                     * ǲǶʱ: صȷ´ִʱ
-                     */
-                    if (task->p_timer && task->timer_callback)
-                    {
-                        task->timer_callback(task);
-                    }
-
-                    else if (task->state & PT_WANT_SUSPEND)
-                    {
-                        task->state = PT_STATE_SUSPEND;
-                    }
-                    else
-                    {
-                        task->state = PT_STATE_READY;
-                    }
-                }
+                pesudo_task_delete(task);
             }
 
             /**********************************************
@@ -313,30 +590,34 @@ void pesudoos_run(int deadloop)
              */
         }
 
-        current_pesudo_task = NULL;
+#if PESUDO_OS_VER >= 2
 
         /*
-         * Ƿдɾ
+         * ӳٴжϵ Event MQ Sem. , һٴһ:
+         * ͬһϿܻ
          */
-        TAILQ_FOREACH_SAFE(task, &pesudo_task_list, list, tmp)
+        if (pesudo_object_pending)
         {
-            if ((task->state & PT_STATE_RUNNING) &&
-                (task->state == PT_WANT_DELETE))
+            uint32_t wakeups = pesudo_wakeup_count;
+
+            pesudo_object_pending = 0;
+
+            process_pesudo_event_from_isr();
+            process_pesudo_sem_from_isr();
+            process_pesudo_mq_from_isr();
+
+            if (wakeups != pesudo_wakeup_count)
             {
-                pesudo_task_delete(task);
+                pesudo_object_pending = 1;
             }
         }
 
-#if PESUDO_OS_VER >= 2
+#endif
 
         /*
-         * ӳٴжϵ Event MQ Sem
+         * BSP Ŀд,  printk() 
          */
-        process_pesudo_event_from_isr();
-        process_pesudo_sem_from_isr();
-        process_pesudo_mq_from_isr();
-
-#endif
+        pesudoos_idle_hook();
 
         /*
          * ˳ѭζеִѭ
@@ -345,6 +626,15 @@ void pesudoos_run(int deadloop)
         {
             break;
         }
+
+        /*
+         * ûо, ĳʱҲû
+         */
+        if (TAILQ_EMPTY(&pesudo_ready_list) && !pesudo_object_pending &&
+            ((wait_heap_size == 0) || (wait_heap[1]->wait_until > get_clock_ticks())))
+        {
+            pesudoos_idle();
+        }
     }
 
     current_pesudo_task = NULL;
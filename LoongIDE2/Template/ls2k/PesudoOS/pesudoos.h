@@ -24,10 +24,12 @@ extern "C" {
  *  0.1: a task is blocked with one object, signal from isr process immediately.
  *  0.2: a task is blocked with one object, signal from isr process later.
  *  0.3: blocked task is as list of object, signal from isr process later.
+ *       main loop runs tasks from ready queue, timeouts are kept in a min-heap,
+ *       cpu is idle when nothing is runnable.
  *
  */
 #define PESUDO_OS_MAJOR     0
-#define PESUDO_OS_MINOR     2
+#define PESUDO_OS_MINOR     3
 
 #define PESUDO_OS_VER       (PESUDO_OS_MAJOR * 100 + PESUDO_OS_MINOR)
 
@@ -39,6 +41,11 @@ extern void printk(const char *fmt, ...);
 extern void delay_ms(int ms);
 extern uint64_t get_clock_ticks(void);
 
+/*
+ * ѭÿһֵһ. Ĭǿպ, BSP ¶,  printk
+ */
+extern void pesudoos_idle_hook(void);
+
 //-----------------------------------------------------------------------------
 // PesudoOS Defination
 //-----------------------------------------------------------------------------
@@ -100,6 +100,19 @@
  */
 #define DEFAULT_THREAD_PRIO             8
 
+/**
+ * LWIP_TCPIP_CORE_LOCKING: lwIP API calls take the core lock and run in the
+ * caller's thread instead of posting a message to the tcpip thread.
+ */
+#define LWIP_TCPIP_CORE_LOCKING         (BSP_USE_OS)
+
+/**
+ * LWIP_TCPIP_CORE_LOCKING_INPUT: tcpip_input() takes the core lock and runs
+ * ethernet_input() in the GMAC receive task instead of posting each frame to
+ * the tcpip thread mailbox.
+ */
+#define LWIP_TCPIP_CORE_LOCKING_INPUT   (BSP_USE_OS)
+
 //-----------------------------------------------------------------------------
 
 /**
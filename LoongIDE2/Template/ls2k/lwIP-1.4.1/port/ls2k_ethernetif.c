@@ -33,6 +33,18 @@
 #define IFNAME0 'e'
 #define IFNAME1 '0'
 
+/*
+ * ֡Эջ.
+ *
+ * RTOS ±뾭 tcpip_input():  LWIP_TCPIP_CORE_LOCKING_INPUT ʱڽ
+ * гںֱӵ ethernet_input(), Ͷݵ tcpip ߳.
+ */
+#if BSP_USE_OS
+#define ETHERNETIF_NETIF_INPUT      tcpip_input
+#else
+#define ETHERNETIF_NETIF_INPUT      ethernet_input
+#endif
+
 /*
  * The time to block waiting for input.
  */
@@ -532,7 +544,7 @@ void ls2k_initialize_lwip(unsigned char *ip0, unsigned char *ip1)
               &gateway,
               &ls2k_gmac0_ethernetif,
               &ethernetif_init,
-              &ethernet_input);
+              &ETHERNETIF_NETIF_INPUT);
 
     /******************************************************
      * Registers the default network interface
@@ -570,7 +582,7 @@ void ls2k_initialize_lwip(unsigned char *ip0, unsigned char *ip1)
               &gateway,
               &ls2k_gmac1_ethernetif,
               &ethernetif_init,
-              &ethernet_input);
+              &ETHERNETIF_NETIF_INPUT);
 
     if (added_default)
     {
@@ -25,6 +25,10 @@
 
 #include "ls2k_gmac.h"
 
+#if !defined(LS2K_LWIP_PORT_VERSION) || (LS2K_LWIP_PORT_VERSION != 2)
+#error "lwipopts.h is not the one of this port, check the include paths"
+#endif
+
 //-----------------------------------------------------------------------------
 
 #define netifINTERFACE_TASK_STACK_SIZE      (8*1024)
@@ -34,6 +38,56 @@
 #define IFNAME0 'e'
 #define IFNAME1 '0'
 
+/*
+ * Ͳ: pbuf ÿһʹһ GMAC 
+ */
+#define ETHERNETIF_TX_ZEROCOPY              1
+
+#if ETHERNETIF_TX_ZEROCOPY
+#define TX_RECLAIM_SIZE                     32      /* 2^n,  GMAC  */
+#endif
+
+/*
+ * ղ: GMAC ֱӹҽ pbuf, ȡߺ󲹳µ pbuf
+ */
+#define ETHERNETIF_RX_ZEROCOPY              1
+
+#if ETHERNETIF_RX_ZEROCOPY
+#define ETHERNETIF_RX_BUDGET                16      /* ÿλȡߵ֡ */
+#endif
+
+/*
+ * GMAC Ӳ IPv4/TCP/UDP/ICMP У,  netif رУ
+ */
+#define ETHERNETIF_HW_CHECKSUM              1
+
+/*
+ * ֡Эջķʽ.
+ *
+ * RTOS ¿ LWIP_TCPIP_CORE_LOCKING_INPUT ʱ, ںֱӵ
+ * netif->input (ethernet_input), һֻ֡һ;  netif->input Ϊ
+ * tcpip_input, ÿ֡Ͷݵ tcpip ̵߳.
+ */
+#define ETHERNETIF_RX_DIRECT                (BSP_USE_OS && LWIP_TCPIP_CORE_LOCKING_INPUT)
+
+#if BSP_USE_OS && !ETHERNETIF_RX_DIRECT
+#define ETHERNETIF_NETIF_INPUT              tcpip_input
+#else
+#define ETHERNETIF_NETIF_INPUT              ethernet_input
+#endif
+
+#define HW_CHECK_FLAGS      (NETIF_CHECKSUM_CHECK_IP  | NETIF_CHECKSUM_CHECK_UDP | \
+                             NETIF_CHECKSUM_CHECK_TCP | NETIF_CHECKSUM_CHECK_ICMP)
+
+#define HW_CHECKSUM_FLAGS   (NETIF_CHECKSUM_GEN_IP    | NETIF_CHECKSUM_GEN_UDP   | \
+                             NETIF_CHECKSUM_GEN_TCP   | NETIF_CHECKSUM_GEN_ICMP  | \
+                             HW_CHECK_FLAGS)
+
+/*
+ * ӲûУ֡ ( IP , IP Ƭ) ڼʱУ
+ */
+#define ETHERNETIF_SW_CHECK                 (ETHERNETIF_HW_CHECKSUM && LWIP_CHECKSUM_CTRL_PER_NETIF)
+
 /*
  * The time to block waiting for input.
  */
@@ -65,6 +119,24 @@ struct ethernetif
 #endif
 
     void *dev_gmac;                 // GMAC_t device pointer
+
+#if ETHERNETIF_TX_ZEROCOPY
+    int tx_zerocopy;                // ʱ, 0: ʹøƷ
+    /*
+     * GMAC жϽѷɵ pbuf, ɷͷ
+     */
+    struct pbuf *tx_done[TX_RECLAIM_SIZE];
+    volatile unsigned int tx_done_head;     // жд
+    volatile unsigned int tx_done_tail;     // 
+#if BSP_USE_OS
+    struct tcpip_callback_msg *tx_reclaim_msg;  // Ԥ, жͶ low_level_tx_reclaim_deferred()
+    volatile int tx_reclaim_pending;        // tx_reclaim_msg  tcpip 
+#endif
+#endif
+
+#if ETHERNETIF_RX_DIRECT
+    int rx_mailbox;                 // , 1: ÿ֡Ͷݵ tcpip ߳
+#endif
 };
 
 /**********************************************************
@@ -77,6 +149,9 @@ static struct ethernetif ls2k_gmac0_ethernetif =
 {
     .ethaddr  = NULL,
     .dev_gmac = NULL,
+#if ETHERNETIF_TX_ZEROCOPY
+    .tx_zerocopy = 1,
+#endif
 };
 
 static struct netif ls2k_gmac0_netif;
@@ -95,6 +170,9 @@ static struct ethernetif ls2k_gmac1_ethernetif =
 {
     .ethaddr  = NULL,
     .dev_gmac = NULL,
+#if ETHERNETIF_TX_ZEROCOPY
+    .tx_zerocopy = 1,
+#endif
 };
 
 static struct netif ls2k_gmac1_netif;
@@ -112,6 +190,213 @@ static
 #endif
 void ethernetif_input(void *pParams);
 
+#if ETHERNETIF_TX_ZEROCOPY
+
+/*
+ * ÿηǰͷ tx_done, ֮ɵ֡ͷʱڷе֡,
+ * ټһη͵֡,  GMAC_TX_DESC_NUM + 1 , в.
+ */
+#if (TX_RECLAIM_SIZE <= GMAC_TX_DESC_NUM) || (TX_RECLAIM_SIZE & (TX_RECLAIM_SIZE - 1))
+#error "TX_RECLAIM_SIZE must be 2^n and greater than GMAC_TX_DESC_NUM"
+#endif
+
+static void low_level_tx_reclaim(struct ethernetif *ptr_if);
+
+static struct ethernetif *gmac_to_ethernetif(const void *pMAC)
+{
+#if BSP_USE_GMAC0
+    if (pMAC == devGMAC0)
+        return &ls2k_gmac0_ethernetif;
+#endif
+
+#if BSP_USE_GMAC1
+    if (pMAC == devGMAC1)
+        return &ls2k_gmac1_ethernetif;
+#endif
+
+    return NULL;
+}
+
+#if BSP_USE_OS
+/*
+ *  tcpip ߳ͷѷɵ pbuf.
+ *
+ * ɺ pbuf һֱһη: TCP  ref>1  pbuf ط,
+ * ·ʱطͣ.
+ */
+static void low_level_tx_reclaim_deferred(void *ctx)
+{
+    struct ethernetif *ptr_if = (struct ethernetif *)ctx;
+
+    ptr_if->tx_reclaim_pending = 0;         /* , ֮ɵ֡ٴͶ */
+
+    RW_LOCK(&ptr_if->tx_sem);
+    low_level_tx_reclaim(ptr_if);
+    RW_UNLOCK(&ptr_if->tx_sem);
+}
+#endif
+
+/*
+ * GMAC ɻص, жִ.
+ *
+ * pbuf_free() ܵ free(), жִ,  tcpip ߳ͷ;
+ * ʱ ethernetif_input() һηͷ.
+ */
+static void low_level_tx_done(const void *pMAC, void *cookie)
+{
+    struct ethernetif *ptr_if = gmac_to_ethernetif(pMAC);
+    unsigned int head;
+
+    if ((ptr_if == NULL) || (cookie == NULL))
+        return;
+
+    head = ptr_if->tx_done_head;
+    LWIP_ASSERT("tx_done overflow", head - ptr_if->tx_done_tail < TX_RECLAIM_SIZE);
+
+    ptr_if->tx_done[head & (TX_RECLAIM_SIZE - 1)] = (struct pbuf *)cookie;
+    asm volatile( "dbar 0; " );
+    ptr_if->tx_done_head = head + 1;
+
+#if BSP_USE_OS
+    if (ptr_if->tx_reclaim_msg && !ptr_if->tx_reclaim_pending)
+    {
+        ptr_if->tx_reclaim_pending = 1;
+        if (tcpip_callbackmsg_trycallback_fromisr(ptr_if->tx_reclaim_msg) != ERR_OK)
+        {
+            ptr_if->tx_reclaim_pending = 0;     /* tcpip , һɻͷ */
+        }
+    }
+#endif
+}
+
+/*
+ * ͷѷɵ pbuf,  tx_sem ʱ
+ */
+static void low_level_tx_reclaim(struct ethernetif *ptr_if)
+{
+    unsigned int tail = ptr_if->tx_done_tail;
+
+    while (tail != ptr_if->tx_done_head)
+    {
+        pbuf_free(ptr_if->tx_done[tail & (TX_RECLAIM_SIZE - 1)]);
+        tail++;
+        ptr_if->tx_done_tail = tail;
+    }
+}
+
+/*
+ * ݷ pbuf 
+ *
+ * : >0 ͳɹ; <=0 ҪʹøƷ
+ */
+static int low_level_output_sg(struct ethernetif *ptr_if, struct pbuf *p)
+{
+    gmac_txseg_t segs[GMAC_TX_MAX_SEGS];
+    struct pbuf *q;
+    int nsegs = 0, rt;
+
+    for (q = p; q != NULL; q = q->next)
+    {
+        if (q->len == 0)
+            continue;
+
+        /*
+         * PBUF_ROM/PBUF_REF ڷغܱ޸, ̫ʱ
+         */
+        if ((nsegs >= GMAC_TX_MAX_SEGS) || PBUF_NEEDS_COPY(q))
+            return 0;
+
+        segs[nsegs].buf = q->payload;
+        segs[nsegs].len = q->len;
+        nsegs++;
+    }
+
+    pbuf_ref(p);                        /* ɺ low_level_tx_reclaim() ͷ */
+
+    rt = ls2k_gmac_send_sg(ptr_if->dev_gmac, segs, nsegs, (void *)p);
+    if (rt <= 0)
+    {
+        pbuf_free(p);
+    }
+
+    return rt;
+}
+
+/*
+ * ʱлͷʽ, enable=0 ʱʹøƷ
+ */
+void ethernetif_set_tx_zerocopy(struct netif *netif, int enable)
+{
+    struct ethernetif *ptr_if = (struct ethernetif *)netif->state;
+
+    RW_LOCK(&ptr_if->tx_sem);
+    ptr_if->tx_zerocopy = enable;
+    RW_UNLOCK(&ptr_if->tx_sem);
+}
+
+#endif // #if ETHERNETIF_TX_ZEROCOPY
+
+#if ETHERNETIF_RX_ZEROCOPY
+
+/*
+ * Ϊ GMAC  pbuf,  low_level_init() ͽе.
+ *
+ *  PBUF_RAM ֤һ֡; DMA дλ ETH_PAD_SIZE,
+ * ʹ IP ͷ.
+ */
+static void *low_level_rx_alloc(const void *pMAC, unsigned char **buf)
+{
+    struct pbuf *p;
+
+    p = pbuf_alloc(PBUF_RAW, GMAC_RX_BUF_SIZE + ETH_PAD_SIZE, PBUF_RAM);
+    if (p == NULL)
+    {
+        LINK_STATS_INC(link.memerr);
+        *buf = NULL;
+        return NULL;
+    }
+
+    *buf = (unsigned char *)p->payload + ETH_PAD_SIZE;
+    return (void *)p;
+}
+
+#endif // #if ETHERNETIF_RX_ZEROCOPY
+
+/*
+ * ʱлӲУ, enable=0 ʱʹ lwIP У.
+ *  tcpip ߳е, ߵǰȡں.
+ *
+ * : 0=ɹ; -1: Ӳ֧, ʹУ
+ */
+int ethernetif_set_hw_checksum(struct netif *netif, int enable)
+{
+    struct ethernetif *ptr_if = (struct ethernetif *)netif->state;
+    int rt = 0;
+
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+    if (enable)
+    {
+        /* ȴӲ, ٹر */
+        rt = ls2k_gmac_ioctl(ptr_if->dev_gmac, IOCTL_GMAC_SET_CSUM_OFFLOAD, (void *)1);
+        if (rt == 0)
+        {
+            NETIF_SET_CHECKSUM_CTRL(netif, NETIF_CHECKSUM_ENABLE_ALL & ~HW_CHECKSUM_FLAGS);
+        }
+    }
+    else
+    {
+        /* ȴ, ٹرӲ */
+        NETIF_SET_CHECKSUM_CTRL(netif, NETIF_CHECKSUM_ENABLE_ALL);
+        rt = ls2k_gmac_ioctl(ptr_if->dev_gmac, IOCTL_GMAC_SET_CSUM_OFFLOAD, (void *)0);
+    }
+#else
+    /* lwIP ܰ netif رУ, ӲУû */
+    rt = enable ? -1 : 0;
+#endif
+
+    return rt;
+}
+
 /* netif the already initialized lwip network interface structure
  * for this ethernetif
  */
@@ -167,6 +452,31 @@ static void low_level_init(struct netif *netif)
 
 	ls2k_gmac_init(pMAC, (void *)p_mac_addr);
 
+#if ETHERNETIF_TX_ZEROCOPY
+    ptr_if->tx_done_head = 0;
+    ptr_if->tx_done_tail = 0;
+#if BSP_USE_OS
+    ptr_if->tx_reclaim_pending = 0;
+    if (ptr_if->tx_reclaim_msg == NULL)
+    {
+        /* жв tcpip Ϣ */
+        ptr_if->tx_reclaim_msg = tcpip_callbackmsg_new(low_level_tx_reclaim_deferred, ptr_if);
+    }
+#endif
+    ls2k_gmac_ioctl(pMAC, IOCTL_GMAC_SET_TXDONE_CB, (void *)low_level_tx_done);
+#endif
+
+#if ETHERNETIF_RX_ZEROCOPY
+    ls2k_gmac_ioctl(pMAC, IOCTL_GMAC_SET_RXBUF_ALLOC, (void *)low_level_rx_alloc);
+#endif
+
+#if ETHERNETIF_HW_CHECKSUM
+    if (ethernetif_set_hw_checksum(netif, 1) != 0)
+    {
+        printk("GMAC checksum offload unavailable, use lwIP checksum.\r\n");
+    }
+#endif
+
     /**************************************************************************
      * Create the task that handles the GMAC.
      * return: TaskHandle_t
@@ -224,6 +534,36 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 
     RW_LOCK(&ptr_if->tx_sem);
 
+#if ETHERNETIF_TX_ZEROCOPY
+    low_level_tx_reclaim(ptr_if);
+
+    if (ptr_if->tx_zerocopy)
+    {
+        int rt;
+
+#if ETH_PAD_SIZE
+        pbuf_header(p, -ETH_PAD_SIZE);      /* drop the padding word */
+#endif
+
+        rt = low_level_output_sg(ptr_if, p);
+
+#if ETH_PAD_SIZE
+        pbuf_header(p, ETH_PAD_SIZE);       /* reclaim the padding word */
+#endif
+
+        if (rt > 0)
+        {
+            RW_UNLOCK(&ptr_if->tx_sem);
+            LINK_STATS_INC(link.xmit);
+            return ERR_OK;
+        }
+
+        /*
+         * Ҫ, ʹøƷ
+         */
+    }
+#endif
+
     if (ls2k_gmac_wait_tx_idle(pMAC, &p_txbuf) <= 0)
     {
         RW_UNLOCK(&ptr_if->tx_sem);         /* ͷ豸ʹȨ */
@@ -345,6 +685,229 @@ static struct pbuf *low_level_input(struct netif *netif)
     return p;
 }
 
+#if ETHERNETIF_RX_ZEROCOPY
+/*
+ * һȡ ETHERNETIF_RX_BUDGET ֡, ϵ pbuf ֱӽЭջ
+ *
+ * : ȡߵ֡; <0: ûйҽ pbuf, ʹ low_level_input()
+ */
+static int low_level_input_burst(struct netif *netif, struct pbuf **pbufs, char *csum_ok)
+{
+    struct ethernetif *ptr_if = (struct ethernetif *)netif->state;
+    gmac_rxframe_t frames[ETHERNETIF_RX_BUDGET];
+    int i, count;
+
+    RW_LOCK(&ptr_if->rx_sem);
+    count = ls2k_gmac_rx_burst(ptr_if->dev_gmac, frames, ETHERNETIF_RX_BUDGET);
+    RW_UNLOCK(&ptr_if->rx_sem);
+
+    for (i = 0; i < count; i++)
+    {
+        pbufs[i] = (struct pbuf *)frames[i].cookie;
+        pbuf_realloc(pbufs[i], frames[i].len + ETH_PAD_SIZE);   /* ̵֡,  padding */
+        csum_ok[i] = (char)frames[i].csum_ok;
+        LINK_STATS_INC(link.recv);
+    }
+
+    return count;
+}
+#endif
+
+#if ETHERNETIF_RX_DIRECT
+
+/*
+ * rx_mailbox=1 ʱ tcpip ִ߳
+ */
+static void ethernetif_input_deferred(void *ctx)
+{
+    struct pbuf *p = (struct pbuf *)ctx;
+    struct netif *netif = netif_get_by_index(p->if_idx);
+
+    if ((netif == NULL) || (ethernet_input(p, netif) != ERR_OK))
+    {
+        pbuf_free(p);
+    }
+}
+
+/*
+ * ܶԱ: enable=1 ʱ֡ LWIP_TCPIP_CORE_LOCKING_INPUT=0 ֡
+ * Ͷݵ tcpip ߳
+ */
+void ethernetif_set_rx_mailbox(struct netif *netif, int enable)
+{
+    struct ethernetif *ptr_if = (struct ethernetif *)netif->state;
+
+    ptr_if->rx_mailbox = enable;
+}
+
+#endif // #if ETHERNETIF_RX_DIRECT
+
+#if ETHERNETIF_SW_CHECK
+
+/*
+ * ӲУ֡ 1. Ӳ IP ƬУ鸺, ųһ
+ */
+static int ethernetif_rx_hw_checked(struct pbuf *p, int csum_ok)
+{
+    struct eth_hdr  *ethhdr = (struct eth_hdr *)p->payload;
+    struct ip_hdr   *iphdr;
+
+    if (!csum_ok || (ethhdr->type != PP_HTONS(ETHTYPE_IP)) || (p->len < SIZEOF_ETH_HDR + IP_HLEN))
+        return 0;
+
+    iphdr = (struct ip_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR);
+
+    return (IPH_OFFSET(iphdr) & PP_HTONS(IP_MF | IP_OFFMASK)) == 0;
+}
+
+/*
+ * У鴦һ֡, ںʱ
+ */
+static err_t ethernetif_input_sw_check(struct pbuf *p, struct netif *netif)
+{
+    u16_t flags = netif->chksum_flags;
+    err_t err;
+
+    netif->chksum_flags = flags | HW_CHECK_FLAGS;
+    err = ethernet_input(p, netif);
+    netif->chksum_flags = flags;
+
+    return err;
+}
+
+#if BSP_USE_OS
+/*
+ * ûгںʱ,  tcpip ִ߳
+ */
+static void ethernetif_input_deferred_sw(void *ctx)
+{
+    struct pbuf *p = (struct pbuf *)ctx;
+    struct netif *netif = netif_get_by_index(p->if_idx);
+
+    if ((netif == NULL) || (ethernetif_input_sw_check(p, netif) != ERR_OK))
+    {
+        pbuf_free(p);
+    }
+}
+#endif
+
+#endif // #if ETHERNETIF_SW_CHECK
+
+/*
+ * һ֡ݽЭջ.
+ *
+ * csum_ok=0: ӲûУ֡, netif رУʱҪʱ
+ */
+static void ethernetif_input_packet(struct netif *netif, struct pbuf *p, int csum_ok)
+{
+	struct eth_hdr *ethhdr;
+
+	/* points to packet payload, which starts with an Ethernet header */
+	ethhdr = p->payload;
+	switch (htons(ethhdr->type))
+    {
+	    /* IP or ARP packet? */
+	    case ETHTYPE_IP:
+	    case ETHTYPE_ARP:
+#if PPPOE_SUPPORT
+        /* PPPoE packet? */
+        case ETHTYPE_PPPOEDISC:
+        case ETHTYPE_PPPOE:
+#endif /* PPPOE_SUPPORT */
+#if ETHERNETIF_SW_CHECK
+            if (((netif->chksum_flags & HW_CHECK_FLAGS) != HW_CHECK_FLAGS) &&
+                !ethernetif_rx_hw_checked(p, csum_ok))
+            {
+#if BSP_USE_OS
+  #if ETHERNETIF_RX_DIRECT
+                if (!((struct ethernetif *)netif->state)->rx_mailbox)
+                {
+                    /* ethernetif_input_batch() ں */
+                    if (ethernetif_input_sw_check(p, netif) != ERR_OK)
+                        pbuf_free(p);
+                    break;
+                }
+  #endif
+                p->if_idx = netif_get_index(netif);
+                if (tcpip_try_callback(ethernetif_input_deferred_sw, p) != ERR_OK)
+                {
+                    LINK_STATS_INC(link.drop);
+                    pbuf_free(p);
+                }
+#else
+                if (ethernetif_input_sw_check(p, netif) != ERR_OK)
+                    pbuf_free(p);
+#endif
+                break;
+            }
+#else
+            (void)csum_ok;
+#endif
+
+#if ETHERNETIF_RX_DIRECT
+            if (((struct ethernetif *)netif->state)->rx_mailbox)
+            {
+                p->if_idx = netif_get_index(netif);
+                if (tcpip_try_callback(ethernetif_input_deferred, p) != ERR_OK)
+                {
+                    LINK_STATS_INC(link.drop);
+                    pbuf_free(p);
+                }
+                break;
+            }
+#endif
+
+		    /*
+             * full packet send to tcpip_thread to process, or processed
+             * here under the core lock, see ethernetif_input_batch()
+             */
+		    if (netif->input(p, netif) != ERR_OK)
+            {
+			    LWIP_DEBUGF(NETIF_DEBUG, ("ethernetif_input: IP input error\n"));
+			    pbuf_free(p);
+		    }
+		    break;
+
+        default:
+		    pbuf_free(p);
+		    break;
+	}
+}
+
+/*
+ * һ֡Эջ.
+ *
+ * ETHERNETIF_RX_DIRECT ʱֻȡһں, ڼ tcpip ̺߳
+ * lwIP API ȴ; ĴС ETHERNETIF_RX_BUDGET .
+ */
+static void ethernetif_input_batch(struct netif *netif, struct pbuf **pbufs,
+                                   const char *csum_ok, int count)
+{
+    int i;
+
+#if ETHERNETIF_RX_DIRECT
+    struct ethernetif *ptr_if = (struct ethernetif *)netif->state;
+    int locked = !ptr_if->rx_mailbox;
+
+    if (locked)
+    {
+        LOCK_TCPIP_CORE();
+    }
+#endif
+
+    for (i = 0; i < count; i++)
+    {
+        ethernetif_input_packet(netif, pbufs[i], csum_ok ? csum_ok[i] : 0);
+    }
+
+#if ETHERNETIF_RX_DIRECT
+    if (locked)
+    {
+        UNLOCK_TCPIP_CORE();
+    }
+#endif
+}
+
 /**
  * This function should be called when a packet is ready to be read
  * from the interface. It uses the function low_level_input() that
@@ -360,7 +923,6 @@ static
 void ethernetif_input(void *pParams)
 {
 	struct netif *netif;
-	struct eth_hdr *ethhdr;
 	struct pbuf *p = NULL;
 	netif = (struct netif *)pParams;
 	struct ethernetif *ptr_if = (struct ethernetif *)netif->state;
@@ -386,8 +948,37 @@ void ethernetif_input(void *pParams)
 	for (;;)
 #endif
     {
+#if !BSP_USE_OS && ETHERNETIF_TX_ZEROCOPY
+        low_level_tx_reclaim(ptr_if);           /* : ѯʱͷѷɵ pbuf */
+#endif
+
         unsigned char *p_rxbuf;
-        
+
+#if ETHERNETIF_RX_ZEROCOPY
+        struct pbuf *pbufs[ETHERNETIF_RX_BUDGET];
+        char csum_ok[ETHERNETIF_RX_BUDGET];
+        int count;
+
+        /**************************************************
+         * , ջȡպŵȴ GMAC_RX_EVENT
+         */
+        count = low_level_input_burst(netif, pbufs, csum_ok);
+        if (count >= 0)
+        {
+            ethernetif_input_batch(netif, pbufs, csum_ok, count);
+
+#if BSP_USE_OS
+            if (count < ETHERNETIF_RX_BUDGET)
+            {
+                ls2k_gmac_wait_rx_packet(pMAC, &p_rxbuf);
+            }
+            continue;
+#else
+            return;
+#endif
+        }
+#endif
+
         p = NULL;
         
 		/**************************************************
@@ -409,34 +1000,7 @@ void ethernetif_input(void *pParams)
 #endif
         }
 
-		/* points to packet payload, which starts with an Ethernet header */
-		ethhdr = p->payload;
-		switch (htons(ethhdr->type))
-        {
-		    /* IP or ARP packet? */
-		    case ETHTYPE_IP:
-		    case ETHTYPE_ARP:
-#if PPPOE_SUPPORT
-            /* PPPoE packet? */
-            case ETHTYPE_PPPOEDISC:
-            case ETHTYPE_PPPOE:
-#endif /* PPPOE_SUPPORT */
-			    /*
-                 * full packet send to tcpip_thread to process
-                 */
-			    if (netif->input(p, netif) != ERR_OK)
-                {
-				    LWIP_DEBUGF(NETIF_DEBUG, ("ethernetif_input: IP input error\n"));
-				    pbuf_free(p);
-				    p = NULL;
-			    }
-			    break;
-
-            default:
-			    pbuf_free(p);
-			    p = NULL;
-			    break;
-		}
+        ethernetif_input_batch(netif, &p, NULL, 1);     /* ƽ: ûӲУ */
 	}
 }
 
@@ -539,7 +1103,7 @@ void ls2k_initialize_lwip(unsigned char *ip0, unsigned char *ip1)
               &gateway,
               &ls2k_gmac0_ethernetif,
               &ethernetif_init,
-              &ethernet_input);
+              &ETHERNETIF_NETIF_INPUT);
 
     /******************************************************
      * Registers the default network interface
@@ -577,7 +1141,7 @@ void ls2k_initialize_lwip(unsigned char *ip0, unsigned char *ip1)
               &gateway,
               &ls2k_gmac1_ethernetif,
               &ethernetif_init,
-              &ethernet_input);
+              &ETHERNETIF_NETIF_INPUT);
 
     if (added_default)
     {
@@ -3,6 +3,9 @@
  *
  */
 
+#include <stdio.h>
+#include <string.h>
+
 #include "lwip/opt.h"
 #include "lwip/debug.h"
 #include "lwip/def.h"
@@ -12,6 +15,10 @@
 
 #include "arch/sys_arch.h"
 
+#if !defined(LS2K_LWIP_PORT_VERSION) || (LS2K_LWIP_PORT_VERSION != 2)
+#error "lwipopts.h is not the one of this port, check the include paths"
+#endif
+
 //*****************************************************************************
 // Use OSAL instead
 //*****************************************************************************
@@ -24,26 +31,145 @@
 // message queue
 //-----------------------------------------------------------------------------
 
+/*
+ * Pointer mailbox for the tcpip thread and the netconn receive boxes.
+ *
+ * Multi-producer, single-consumer lock-free ring: a slot whose sequence
+ * equals pos may be written at pos; the writer sets it to pos+1 so it can
+ * be read, and the reader sets it to pos+slots for the next lap.
+ *
+ * Posting and fetching do not call the OS; a semaphore is used only when
+ * the consumer has to wait for a message or a producer for a free slot.
+ */
+#define SYS_MBOX_DEFAULT    8
+
+struct sys_mbox_slot
+{
+    volatile unsigned long seq;
+    void *msg;
+};
+
+struct sys_mbox
+{
+    unsigned long head;                 /* producer position */
+    unsigned long tail;                 /* consumer position */
+    unsigned long mask;                 /* slots - 1 */
+    volatile int  rx_waiting;           /* consumer is waiting on rx_sem */
+    volatile int  tx_waiting;           /* producers waiting on tx_sem */
+    sys_sem_t     rx_sem;
+    sys_sem_t     tx_sem;
+    struct sys_mbox_slot slot[];
+};
+
+static int sys_mbox_put(struct sys_mbox *mb, void *msg)
+{
+    struct sys_mbox_slot *slot;
+    unsigned long pos, seq;
+
+    pos = __atomic_load_n(&mb->head, __ATOMIC_RELAXED);
+
+    for ( ; ; )
+    {
+        slot = &mb->slot[pos & mb->mask];
+        seq  = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+
+        if (seq == pos)
+        {
+            if (__atomic_compare_exchange_n(&mb->head, &pos, pos + 1, 0,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        }
+        else if ((long)(seq - pos) < 0)
+        {
+            return -1;                  /* full */
+        }
+        else
+        {
+            pos = __atomic_load_n(&mb->head, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->msg = msg;
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+
+    /*
+     * Pairs with the fence in sys_arch_mbox_fetch()
+     */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (mb->rx_waiting && __atomic_exchange_n(&mb->rx_waiting, 0, __ATOMIC_RELAXED))
+        osal_sem_release(mb->rx_sem);
+
+    return 0;
+}
+
+static int sys_mbox_get(struct sys_mbox *mb, void **msg)
+{
+    struct sys_mbox_slot *slot = &mb->slot[mb->tail & mb->mask];
+
+    if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != mb->tail + 1)
+        return -1;                      /* empty */
+
+    *msg = slot->msg;
+    __atomic_store_n(&slot->seq, mb->tail + mb->mask + 1, __ATOMIC_RELEASE);
+    mb->tail++;
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (mb->tx_waiting)
+        osal_sem_release(mb->tx_sem);
+
+    return 0;
+}
+
 err_t sys_mbox_new(sys_mbox_t *mbox, int size)
 {
     static unsigned short counter = 0;
     char tname[LWIP_NAME_MAX];
-    sys_mbox_t tmpmbox;
+    struct sys_mbox *mb;
+    unsigned long i, slots = 2;
+
+    if (size <= 0)
+        size = SYS_MBOX_DEFAULT;
+
+    while (slots < (unsigned long)size)
+        slots <<= 1;
+
+    mb = (struct sys_mbox *)osal_malloc(sizeof(struct sys_mbox) +
+                                        slots * sizeof(struct sys_mbox_slot));
+    if (mb == NULL)
+        return ERR_MEM;
+
+    memset(mb, 0, sizeof(struct sys_mbox));
+    mb->mask = slots - 1;
+    for (i=0; i<slots; i++)
+        mb->slot[i].seq = i;
 
     snprintf(tname, LWIP_NAME_MAX, "%s%d", SYS_LWIP_MBOX_NAME, counter);
     counter++;
 
-    tmpmbox = osal_mq_create(tname, OSAL_OPT_FIFO, size, 8);
-    if (tmpmbox == NULL)
+    mb->rx_sem = osal_sem_create(tname, OSAL_OPT_FIFO, 0);
+    mb->tx_sem = osal_sem_create(tname, OSAL_OPT_FIFO, 0);
+    if ((mb->rx_sem == NULL) || (mb->tx_sem == NULL))
+    {
+        if (mb->rx_sem) osal_sem_delete(mb->rx_sem);
+        if (mb->tx_sem) osal_sem_delete(mb->tx_sem);
+        osal_free(mb);
         return ERR_MEM;
+    }
 
-    *mbox = tmpmbox;
+    *mbox = mb;
     return ERR_OK;
 }
 
 void sys_mbox_free(sys_mbox_t *mbox)
 {
-    osal_mq_delete(*mbox);
+    struct sys_mbox *mb = *mbox;
+
+    if (mb)
+    {
+        osal_sem_delete(mb->rx_sem);
+        osal_sem_delete(mb->tx_sem);
+        osal_free(mb);
+    }
 }
 
 /*
@@ -51,20 +177,31 @@ void sys_mbox_free(sys_mbox_t *mbox)
  */
 void sys_mbox_post(sys_mbox_t *mbox, void *msg)
 {
-#ifdef OS_UCOS
-    osal_mq_send(*mbox, (const void *)msg, sizeof(uintptr_t));
-#else
-    osal_mq_send(*mbox, (const void *)&msg, sizeof(uintptr_t));
-#endif
+    struct sys_mbox *mb = *mbox;
+
+    if (sys_mbox_put(mb, msg) == 0)
+        return;
+
+    /*
+     * Full: announce the wait before trying again, see sys_mbox_get()
+     */
+    __atomic_fetch_add(&mb->tx_waiting, 1, __ATOMIC_SEQ_CST);
+
+    while (sys_mbox_put(mb, msg) != 0)
+        osal_sem_obtain(mb->tx_sem, OSAL_WAIT_FOREVER);
+
+    __atomic_fetch_sub(&mb->tx_waiting, 1, __ATOMIC_SEQ_CST);
+
+    /*
+     * One release may wake only one of several waiting producers
+     */
+    if (mb->tx_waiting)
+        osal_sem_release(mb->tx_sem);
 }
 
 err_t sys_mbox_trypost(sys_mbox_t *mbox, void *msg)
 {
-#ifdef OS_UCOS
-    if (osal_mq_send(*mbox, (const void *)msg, sizeof(uintptr_t)) == 0)
-#else
-    if (osal_mq_send(*mbox, (const void *)&msg, sizeof(uintptr_t)) == 0)
-#endif
+    if (sys_mbox_put(*mbox, msg) == 0)
         return ERR_OK;
 
     return ERR_MEM;
@@ -72,14 +209,7 @@ err_t sys_mbox_trypost(sys_mbox_t *mbox, void *msg)
 
 err_t sys_mbox_trypost_fromisr(sys_mbox_t *mbox, void *msg)
 {
-#ifdef OS_UCOS
-    if (osal_mq_send(*mbox, (const void *)msg, sizeof(uintptr_t)) == 0)
-#else
-    if (osal_mq_send(*mbox, (const void *)&msg, sizeof(uintptr_t)) == 0)
-#endif
-        return ERR_OK;
-
-    return ERR_MEM;
+    return sys_mbox_trypost(mbox, msg);
 }
 
 /*
@@ -87,13 +217,42 @@ err_t sys_mbox_trypost_fromisr(sys_mbox_t *mbox, void *msg)
  */
 u32_t sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout)
 {
+    struct sys_mbox *mb = *mbox;
     u32_t ticks = get_clock_ticks();
-    int tmo = (timeout == 0) ? OSAL_WAIT_FOREVER : timeout;
+    u32_t elapsed, tmo;
 
-    if (osal_mq_receive(*mbox, (void *)msg, sizeof(uintptr_t), tmo) < 0)
+    while (sys_mbox_get(mb, msg) != 0)
     {
-        *msg = NULL;
-        return SYS_ARCH_TIMEOUT;
+        tmo = OSAL_WAIT_FOREVER;
+
+        if (timeout != 0)
+        {
+            elapsed = get_clock_ticks() - ticks;
+            if (elapsed >= timeout)
+            {
+                *msg = NULL;
+                return SYS_ARCH_TIMEOUT;
+            }
+
+            tmo = timeout - elapsed;
+        }
+
+        /*
+         * Announce the wait, then check again: a producer that posted
+         * before seeing rx_waiting is caught here
+         */
+        mb->rx_waiting = 1;
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (sys_mbox_get(mb, msg) == 0)
+        {
+            mb->rx_waiting = 0;
+            break;
+        }
+
+        /* may be a stale release, the loop checks again */
+        osal_sem_obtain(mb->rx_sem, tmo);
+        mb->rx_waiting = 0;
     }
 
     /* get elapse msecond */
@@ -106,22 +265,18 @@ u32_t sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout)
 
 u32_t sys_arch_mbox_tryfetch(sys_mbox_t *mbox, void **msg)
 {
-#ifdef OS_UCOS
-    if (osal_mq_receive(*mbox, (void *)msg, sizeof(uintptr_t), 1) < 0)
-#else
-    if (osal_mq_receive(*mbox, (void *)msg, sizeof(uintptr_t), 0) < 0)
-#endif
+    if (sys_mbox_get(*mbox, msg) != 0)
     {
         *msg = NULL;
-        return SYS_ARCH_TIMEOUT;
+        return SYS_MBOX_EMPTY;
     }
 
-    return 1;
+    return 0;
 }
 
 int sys_mbox_valid(sys_mbox_t *mbox)
 {
-    return (int)(size_t)(*mbox);
+    return (*mbox != NULL);
 }
 
 void sys_mbox_set_invalid(sys_mbox_t *mbox)
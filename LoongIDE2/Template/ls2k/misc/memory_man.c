@@ -84,12 +84,545 @@ void free(void *ptr)
 
 extern void printk(const char *fmt, ...);
 
+/*
+ * =1: TLSF (Two-Level Segregated Fit), malloc/free ִʱͿп޹;
+ * =0: ״, ڶԱȲ
+ */
+#ifndef HEAP_USE_TLSF
+#define HEAP_USE_TLSF       1
+#endif
+
 //-----------------------------------------------------------------------------
 
 #ifndef align_up
 #define align_up(num, align)    (((num) + ((align)-1)) & ~((align)-1))
 #endif
 
+#define BLOCK_USED_FLAG     (0xdeadbeaf)
+
+#define ALLOC_ALIGNMENT     (sizeof(void *))    /* malloc buffer align 8 bytes */
+
+#define ALLOC_MIN_BYTES     32                  /* min malloc size */
+
+/*
+ * lock alloc with mutex support
+ */
+static osal_mutex_t p_alloc_mutex = NULL;
+
+static size_t heap_total_bytes  = 0;
+static size_t heap_remain_bytes = 0;
+
+//-----------------------------------------------------------------------------
+// OS lock
+//-----------------------------------------------------------------------------
+
+void malloc_create_oslock(void)
+{
+    if (!p_alloc_mutex)
+    {
+        p_alloc_mutex = osal_mutex_create("heap_loc", OSAL_OPT_FIFO);
+    }
+}
+
+static void malloc_oslock()
+{
+    if (osal_is_osrunning())
+    {
+        osal_mutex_obtain(p_alloc_mutex, OSAL_WAIT_FOREVER);
+    }
+}
+
+static void malloc_osunlock()
+{
+    if (osal_is_osrunning())
+    {
+        osal_mutex_release(p_alloc_mutex);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+size_t get_heap_size(void)
+{
+    return heap_total_bytes;
+}
+
+size_t get_heap_free_size(void)
+{
+    return heap_remain_bytes;
+}
+
+#if HEAP_USE_TLSF
+
+//-----------------------------------------------------------------------------
+// TLSF: Two-Level Segregated Fit
+//-----------------------------------------------------------------------------
+
+/*
+ * п鰴ȷּ: һ fl ǳȵλ,  sl  [2^fl, 2^(fl+1)) ȷΪ
+ * SL_INDEX_COUNT . ÿ (fl, sl) һ, λͼ¼Щǿ.
+ * malloc λͼҵһ㹻, free ֻϲڵ, ûѭ.
+ */
+#define SL_INDEX_COUNT_LOG2 5
+#define SL_INDEX_COUNT      (1 << SL_INDEX_COUNT_LOG2)          /* 32 */
+#define ALIGN_SIZE_LOG2     3                                   /* 8 bytes */
+#define FL_INDEX_MAX        31                                  /* block size < 4G */
+#define FL_INDEX_SHIFT      (SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2)
+#define FL_INDEX_COUNT      (FL_INDEX_MAX - FL_INDEX_SHIFT + 1)
+#define SMALL_BLOCK_SIZE    (1 << FL_INDEX_SHIFT)               /* 256 */
+
+/**
+ * memory block node struct
+ *
+ * memory physical address: low -high
+ *
+ *   ---------------|------------------|---------------------------|--
+ *  |H| block       |H| block          |H| block                   |H| size=0, used
+ *   ---------------|------------------|---------------------------|--
+ *                   prev_phys -------                             sentinel
+ */
+typedef struct blk_node
+{
+    unsigned int     flag;                  /* =BLOCK_USED_FLAG: used; =0: blank */
+	unsigned int     size;                  /* block bytes, not include node */
+    struct blk_node *prev_phys;             /* ַǰһ, NULL: һ */
+    struct blk_node *next_free;             /*  */
+    struct blk_node *prev_free;
+} blk_node_t;
+
+#define BLOCK_NODE_SZ       (align_up(sizeof(blk_node_t), 8))
+
+#define NODE_TO_BLOCK(node) ((void *)((unsigned char *)(node) + BLOCK_NODE_SZ))
+#define BLOCK_TO_NODE(ptr)  ((blk_node_t *)((unsigned char *)(ptr) - BLOCK_NODE_SZ))
+#define NEXT_PHYS(node)     ((blk_node_t *)((unsigned char *)(node) + BLOCK_NODE_SZ + (node)->size))
+
+#define INFO_NODE(node, i) { \
+    printk("  Faulty block[%i] @0x%016lx\r\n", i, (long)node); \
+    printk("    flag  = 0x%08x\r\n", node->flag); \
+    printk("    size  = 0x%08x\r\n", node->size); \
+    printk("    prev  = 0x%016lx\r\n", (long)node->prev_phys); \
+    printk("    next  = 0x%016lx\r\n", (long)NEXT_PHYS(node)); }
+
+//-----------------------------------------------------------------------------
+// free memory lists
+//-----------------------------------------------------------------------------
+
+static unsigned int fl_bitmap = 0;
+static unsigned int sl_bitmap[FL_INDEX_COUNT];
+static blk_node_t  *free_blocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
+
+static blk_node_t  *heap_first_node = NULL;
+static blk_node_t  *heap_last_node  = NULL;        /* sentinel */
+
+/*
+ * LoongArch  clz.w/ctz.w ָ
+ */
+static inline int tlsf_fls(unsigned int x)          /* λ 1 λ, 0~31 */
+{
+    return 31 - __builtin_clz(x);
+}
+
+static inline int tlsf_ffs(unsigned int x)          /* λ 1 λ, 0~31 */
+{
+    return __builtin_ctz(x);
+}
+
+/*
+ * ڵ
+ */
+static inline void mapping_insert(size_t size, int *fl, int *sl)
+{
+    if (size < SMALL_BLOCK_SIZE)
+    {
+        *fl = 0;
+        *sl = (int)size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT);
+    }
+    else
+    {
+        int t = tlsf_fls((unsigned int)size);
+        *sl = (int)(size >> (t - SL_INDEX_COUNT_LOG2)) ^ SL_INDEX_COUNT;
+        *fl = t - (FL_INDEX_SHIFT - 1);
+    }
+}
+
+/*
+ * 볤ȡһ, һ鶼㹻
+ */
+static inline void mapping_search(size_t size, int *fl, int *sl)
+{
+    if (size >= SMALL_BLOCK_SIZE)
+    {
+        size += (1 << (tlsf_fls((unsigned int)size) - SL_INDEX_COUNT_LOG2)) - 1;
+    }
+
+    mapping_insert(size, fl, sl);
+}
+
+static blk_node_t *search_suitable_block(int *fl, int *sl)
+{
+    unsigned int sl_map, fl_map;
+
+    if (*fl >= FL_INDEX_COUNT)
+    {
+        return NULL;
+    }
+
+    sl_map = sl_bitmap[*fl] & (~0U << *sl);
+    if (!sl_map)
+    {
+        fl_map = (*fl + 1 < 32) ? (fl_bitmap & (~0U << (*fl + 1))) : 0;
+        if (!fl_map)
+        {
+            return NULL;
+        }
+
+        *fl = tlsf_ffs(fl_map);
+        sl_map = sl_bitmap[*fl];
+    }
+
+    *sl = tlsf_ffs(sl_map);
+
+    return free_blocks[*fl][*sl];
+}
+
+static void insert_free_block(blk_node_t *node)
+{
+    int fl, sl;
+
+    mapping_insert(node->size, &fl, &sl);
+
+    node->flag = 0;
+    node->prev_free = NULL;
+    node->next_free = free_blocks[fl][sl];
+    if (node->next_free)
+        node->next_free->prev_free = node;
+
+    free_blocks[fl][sl] = node;
+    fl_bitmap |= 1U << fl;
+    sl_bitmap[fl] |= 1U << sl;
+}
+
+static void remove_free_block(blk_node_t *node)
+{
+    int fl, sl;
+
+    mapping_insert(node->size, &fl, &sl);
+
+    if (node->next_free)
+        node->next_free->prev_free = node->prev_free;
+
+    if (node->prev_free)
+    {
+        node->prev_free->next_free = node->next_free;
+    }
+    else
+    {
+        free_blocks[fl][sl] = node->next_free;
+        if (!free_blocks[fl][sl])
+        {
+            sl_bitmap[fl] &= ~(1U << sl);
+            if (!sl_bitmap[fl])
+                fl_bitmap &= ~(1U << fl);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+int heap_verify_faulty_blocks(void)
+{
+    blk_node_t *node = heap_first_node, *prev = NULL;
+    int count = 0, i = 0, fl, sl;
+
+    printk("Verify heap blocks:\r\n");
+
+    while (node && (node != heap_last_node))
+    {
+        /*
+         * Self is correct
+         */
+        if (((node->flag != 0) && (node->flag != BLOCK_USED_FLAG)) ||
+            ((size_t)NEXT_PHYS(node) > (size_t)heap_last_node))
+        {
+            count++;
+            if (osal_is_osrunning())
+            {
+                INFO_NODE(node, i);
+            }
+            break;
+        }
+
+        /*
+         * Previous is correct, and two blank blocks never adjoin
+         */
+        if ((node->prev_phys != prev) ||
+            (prev && (prev->flag == 0) && (node->flag == 0)))
+        {
+            count++;
+            if (osal_is_osrunning())
+            {
+                INFO_NODE(node, i);
+            }
+            break;
+        }
+
+        prev = node;
+        i++;
+        node = NEXT_PHYS(node);
+    }
+
+    if (node && (node->prev_phys != prev) && (count == 0))
+    {
+        count++;
+        if (osal_is_osrunning())
+        {
+            INFO_NODE(node, i);
+        }
+    }
+
+    /*
+     * Free lists are correct
+     */
+    for (fl = 0; fl < FL_INDEX_COUNT; fl++)
+    {
+        for (sl = 0; sl < SL_INDEX_COUNT; sl++)
+        {
+            blk_node_t *free_node = free_blocks[fl][sl];
+            int f, s;
+
+            if ((free_node != NULL) != ((sl_bitmap[fl] >> sl) & 1))
+            {
+                printk("  Free list bitmap[%i][%i] error\r\n", fl, sl);
+                count++;
+            }
+
+            while (free_node)
+            {
+                mapping_insert(free_node->size, &f, &s);
+                if ((free_node->flag != 0) || (f != fl) || (s != sl))
+                {
+                    count++;
+                    if (osal_is_osrunning())
+                    {
+                        INFO_NODE(free_node, -1);
+                    }
+                    break;
+                }
+
+                free_node = free_node->next_free;
+            }
+        }
+    }
+
+    if (count == 0)
+    {
+        printk("Not found any fault block\r\n");
+    }
+
+    return -count;
+}
+
+int heap_view_isolated_blocks(void)
+{
+    blk_node_t *node = heap_first_node;
+    int count = 0;
+
+    printk("Seek isolated blocks:\r\n");
+
+    while (node && (node != heap_last_node))
+    {
+        if (node->prev_phys && (NEXT_PHYS(node) != heap_last_node) && (node->flag == 0))
+        {
+            count++;
+            printk("  block @0x%016lx, size = %iB\r\n", (long)node, node->size);
+        }
+
+        node = NEXT_PHYS(node);
+    }
+
+    printk("Total %i isolated blocks\r\n", count);
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+// add heap addrss & size. Only can add once
+//-----------------------------------------------------------------------------
+
+int heap_add_region(void *addr, size_t size)
+{
+    unsigned char *first_addr;
+
+    if (!addr || (size < 0x100000) || heap_first_node)
+    {
+        return -1;
+    }
+
+    first_addr = (unsigned char *)align_up((size_t)addr, ALLOC_ALIGNMENT);
+    size -= (size_t)first_addr - (size_t)addr;
+    size &= ~(ALLOC_ALIGNMENT - 1);
+
+    if (size > (1UL << FL_INDEX_MAX))
+    {
+        size = 1UL << FL_INDEX_MAX;
+    }
+
+    /*
+     * one blank block and the sentinel
+     */
+    heap_first_node = (blk_node_t *)first_addr;
+    heap_first_node->size = size - 2 * BLOCK_NODE_SZ;
+    heap_first_node->prev_phys = NULL;
+
+    heap_last_node = NEXT_PHYS(heap_first_node);
+    heap_last_node->flag = BLOCK_USED_FLAG;
+    heap_last_node->size = 0;
+    heap_last_node->prev_phys = heap_first_node;
+
+    heap_total_bytes = size - BLOCK_NODE_SZ;
+    heap_remain_bytes = heap_total_bytes;
+
+    insert_free_block(heap_first_node);
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void dump_heap_list(void)
+{
+    int i = 0;
+    blk_node_t *node = heap_first_node;
+
+    while (node && (node != heap_last_node))
+    {
+        INFO_NODE(node, i);
+
+        i++;
+        node = NEXT_PHYS(node);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// malloc() function
+//-----------------------------------------------------------------------------
+
+void *malloc(size_t size)
+{
+	blk_node_t *found_node, *new_node;
+    int fl, sl;
+
+	if ((size <= 0) || (size >= (1UL << FL_INDEX_MAX)))
+    {
+        return NULL;
+    }
+
+    if (size <= ALLOC_MIN_BYTES)
+    {
+        size = ALLOC_MIN_BYTES;
+    }
+    else
+    {
+        size = align_up(size, ALLOC_ALIGNMENT);
+    }
+
+    mapping_search(size, &fl, &sl);
+
+    malloc_oslock();
+
+    found_node = search_suitable_block(&fl, &sl);
+    if (!found_node)
+    {
+        malloc_osunlock();
+        return NULL;
+    }
+
+    remove_free_block(found_node);
+
+    /*
+     * split the remain to a new blank block, if it is large enough
+     */
+    if (found_node->size >= size + BLOCK_NODE_SZ + ALLOC_MIN_BYTES)
+    {
+        new_node = (blk_node_t *)((size_t)NODE_TO_BLOCK(found_node) + size);
+        new_node->size = found_node->size - size - BLOCK_NODE_SZ;
+        new_node->prev_phys = found_node;
+        NEXT_PHYS(new_node)->prev_phys = new_node;
+
+        found_node->size = size;
+
+        insert_free_block(new_node);
+    }
+
+    found_node->flag = BLOCK_USED_FLAG;
+
+    heap_remain_bytes -= found_node->size + BLOCK_NODE_SZ;
+	malloc_osunlock();
+
+	return NODE_TO_BLOCK(found_node);
+}
+
+//-----------------------------------------------------------------------------
+// free() function
+//-----------------------------------------------------------------------------
+
+void free(void *ptr)
+{
+    blk_node_t *found_node, *prev, *next;
+
+    if (!ptr)
+    {
+        return;
+    }
+
+    found_node = BLOCK_TO_NODE(ptr);
+
+    if (((size_t)found_node < (size_t)heap_first_node) ||
+        ((size_t)found_node >= (size_t)heap_last_node) ||
+        (found_node->flag != BLOCK_USED_FLAG))
+    {
+        if (osal_is_osrunning())
+        {
+            printk("fatal error: free memory @0x%016lx\r\n", (long)ptr);
+        }
+        return;
+    }
+
+	malloc_oslock();
+
+    heap_remain_bytes += found_node->size + BLOCK_NODE_SZ;
+    found_node->flag = 0;
+
+    /*
+     * Combine previous block node
+     */
+    prev = found_node->prev_phys;
+    if (prev && (prev->flag == 0))
+    {
+        remove_free_block(prev);
+        prev->size += found_node->size + BLOCK_NODE_SZ;
+        found_node = prev;
+        NEXT_PHYS(found_node)->prev_phys = found_node;
+    }
+
+    /*
+     * Combine next block node, the sentinel is always used
+     */
+    next = NEXT_PHYS(found_node);
+    if (next->flag == 0)
+    {
+        remove_free_block(next);
+        found_node->size += next->size + BLOCK_NODE_SZ;
+        NEXT_PHYS(found_node)->prev_phys = found_node;
+    }
+
+    insert_free_block(found_node);
+
+    malloc_osunlock();
+}
+
+#else // #if HEAP_USE_TLSF
+
 /**
  * memory block node struct
  */
@@ -104,11 +637,6 @@ typedef struct blk_node
 
 #define BLOCK_NODE_SZ       (align_up(sizeof(blk_node_t), 8))
 
-#define BLOCK_USED_FLAG     (0xdeadbeaf)
-
-#define ALLOC_ALIGNMENT     (sizeof(void *))    /* malloc buffer align 8 bytes */
-
-#define ALLOC_MIN_BYTES     32                  /* min malloc size */
 
 //-----------------------------------------------------------------------------
 
@@ -120,20 +648,12 @@ typedef struct blk_node
     printk("    prev  = 0x%016lx\r\n", (long)node->prev);  \
     printk("    next  = 0x%016lx\r\n", (long)node->next); }
 
-/*
- * lock alloc with mutex support
- */
-static osal_mutex_t p_alloc_mutex = NULL;
-
 //-----------------------------------------------------------------------------
 // free memory queue head
 //-----------------------------------------------------------------------------
 
 static blk_node_t *heap_list_head = NULL;
 
-static size_t heap_total_bytes  = 0;
-static size_t heap_remain_bytes = 0;
-
 //-----------------------------------------------------------------------------
 
 int heap_verify_faulty_blocks(void)
@@ -222,34 +742,6 @@ int heap_view_isolated_blocks(void)
     return count;
 }
 
-//-----------------------------------------------------------------------------
-// OS lock
-//-----------------------------------------------------------------------------
-
-void malloc_create_oslock(void)
-{
-    if (!p_alloc_mutex)
-    {
-        p_alloc_mutex = osal_mutex_create("heap_loc", OSAL_OPT_FIFO);
-    }
-}
-
-static void malloc_oslock()
-{
-    if (osal_is_osrunning())
-    {
-        osal_mutex_obtain(p_alloc_mutex, OSAL_WAIT_FOREVER);
-    }
-}
-
-static void malloc_osunlock()
-{
-    if (osal_is_osrunning())
-    {
-        osal_mutex_release(p_alloc_mutex);
-    }
-}
-
 //-----------------------------------------------------------------------------
 // add heap addrss & size. Only can add once
 //-----------------------------------------------------------------------------
@@ -296,16 +788,6 @@ void dump_heap_list(void)
     }
 }
 
-size_t get_heap_size(void)
-{
-    return heap_total_bytes;
-}
-
-size_t get_heap_free_size(void)
-{
-    return heap_remain_bytes;
-}
-
 //-----------------------------------------------------------------------------
 // malloc() function
 //-----------------------------------------------------------------------------
@@ -508,6 +990,8 @@ void free(void *ptr)
     malloc_osunlock();
 }
 
+#endif // #if HEAP_USE_TLSF
+
 //-----------------------------------------------------------------------------
 // calloc() function
 //-----------------------------------------------------------------------------
@@ -29,6 +29,21 @@
 #define MODBUS_CFG_ASCII_EN  		1     	/* Modbus ASCII is supported when 1 */
 #define MODBUS_CFG_RTU_EN    		1     	/* Modbus RTU   is supported when 1 */
 
+#ifndef MODBUS_CFG_TCP_EN
+#define MODBUS_CFG_TCP_EN    		0     	/* Modbus/TCP   is supported when 1, needs the lwIP socket API */
+#endif                                      /* ... and port/mb_tcp.c in the project */
+
+/**************************************************************************************************
+ * MODBUS TCP CONFIGURATION
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_TCP_EN == 1)
+#define MODBUS_CFG_TCP_PORT    		502   	/* Default listening port of the Modbus/TCP server */
+#define MODBUS_CFG_TCP_CONN_MAX		8     	/* Client connections served at the same time, ... */
+                                            /* ... keep below MEMP_NUM_TCP_PCB in lwipopts.h */
+#define MODBUS_CFG_TCP_IDLE_TIMEOUT	60000 	/* Close a connection idle for this long (ms), 0 = never */
+#endif
+
 /**************************************************************************************************
  * MODBUS COMMUNICATION CONFIGURATION
  **************************************************************************************************/
@@ -36,6 +51,17 @@
 #define MODBUS_CFG_CHNL_MAX   		32    	/* Maximum number of Modbus channels. */
 #define MODBUS_CFG_BUF_SIZE   		255   	/* Maximum outgoing message size. */
 
+#ifndef MODBUS_CFG_CRC_TABLE
+#define MODBUS_CFG_CRC_TABLE  		1     	/* CRC-16: 0 = bit by bit, 1 = 256-entry table (512 bytes), */
+#endif                                      /* ... 8 = slice-by-8 (4K bytes) */
+
+/**************************************************************************************************
+ * MODBUS REGISTER MAP
+ **************************************************************************************************/
+
+#define MODBUS_CFG_MAP_EN    		1     	/* Holding/input registers in the tables of mb_data.c ... */
+                                            /* ... are served in bulk, see MODBUS_MAP_t in mb.h */
+
 /**************************************************************************************************
  * MODBUS FLOATING POINT SUPPORT
  **************************************************************************************************/
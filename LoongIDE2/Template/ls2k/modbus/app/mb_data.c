@@ -541,6 +541,72 @@ void modbus_write_file(uint16_t file_nbr, uint16_t record_nbr, uint16_t ix,
 }
 #endif
 
+/**************************************************************************************************
+ * REGISTER MAPS
+ * Description: Holding and input registers served in bulk by FC03, FC04, FC06 and FC16, see
+ *              MODBUS_MAP_t in mb.h.  Registers that no entry covers still go through
+ *              modbus_read_holding_register() and the other functions above.
+ *
+ * Note(s):     1) The entries must be sorted by .Start and must not overlap, modbus_init() checks it.
+ *              2) A register in application memory is read and written without a critical section.
+ *                 Use the callbacks for registers that must change together, like the two halves
+ *                 of a 32-bit counter.
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_MAP_EN == 1)
+
+#define MB_PARAM_REG_START      100
+#define MB_PARAM_REG_NBR        32
+#define MB_CTR_REG_START        (MB_PARAM_REG_START + MB_PARAM_REG_NBR)
+#define MB_CTR_REG_NBR          4
+#define MB_SAMPLE_REG_START     100
+#define MB_SAMPLE_REG_NBR       64
+
+uint16_t mb_param_regs[MB_PARAM_REG_NBR];           /* Holding registers 100..131,  */
+uint16_t mb_sample_regs[MB_SAMPLE_REG_NBR];         /* Input registers 100..163, ֵ */
+
+#if (MODBUS_CFG_FC03_EN == 1) || (MODBUS_CFG_FC06_EN == 1) || (MODBUS_CFG_FC16_EN == 1)
+/*
+ * Holding registers 132..135: RX and TX counters of channel 0, high word first
+ */
+static uint16_t mb_read_counters(uint16_t reg, uint16_t nbr, uint16_t *pval)
+{
+    uint16_t ctr[MB_CTR_REG_NBR], i;
+    size_t   level;
+
+    CPU_CRITICAL_ENTER();
+    ctr[0] = (uint16_t)(mb_devices_tbl[0].RxCtr >> 16);
+    ctr[1] = (uint16_t)(mb_devices_tbl[0].RxCtr & 0x0000FFFF);
+    ctr[2] = (uint16_t)(mb_devices_tbl[0].TxCtr >> 16);
+    ctr[3] = (uint16_t)(mb_devices_tbl[0].TxCtr & 0x0000FFFF);
+    CPU_CRITICAL_EXIT();
+
+    for (i = 0; i < nbr; i++)
+        pval[i] = ctr[reg - MB_CTR_REG_START + i];
+
+    return MODBUS_ERR_NONE;
+}
+
+const MODBUS_MAP_t modbus_holding_register_map[] =
+{
+    { MB_PARAM_REG_START, MB_PARAM_REG_NBR, 0,                  mb_param_regs, NULL,             NULL },
+    { MB_CTR_REG_START,   MB_CTR_REG_NBR,   MODBUS_MAP_RD_ONLY, NULL,          mb_read_counters, NULL },
+};
+
+const uint16_t modbus_holding_register_map_nbr = sizeof(modbus_holding_register_map) / sizeof(MODBUS_MAP_t);
+#endif
+
+#if (MODBUS_CFG_FC04_EN == 1)
+const MODBUS_MAP_t modbus_in_register_map[] =
+{
+    { MB_SAMPLE_REG_START, MB_SAMPLE_REG_NBR, MODBUS_MAP_RD_ONLY, mb_sample_regs, NULL, NULL },
+};
+
+const uint16_t modbus_in_register_map_nbr = sizeof(modbus_in_register_map) / sizeof(MODBUS_MAP_t);
+#endif
+
+#endif // #if (MODBUS_CFG_MAP_EN == 1)
+
 #endif // #if (MODBUS_CFG_SLAVE_EN)
 
 //-----------------------------------------------------------------------------
@@ -237,7 +237,17 @@ void modbus_os_rx_wait(MODBUS_t *p_mb, uint16_t *perr)
         if (p_mb->MasterSlave == MODBUS_MASTER)     // @@ MASTER
         {
             uint8_t rx_byte;
-            int start_time = get_clock_ticks();
+            int start_time;
+
+    #if (MODBUS_CFG_TCP_EN == 1)
+            if (p_mb->Mode == MODBUS_MODE_TCP)      // ȴ socket ϵӦ֡
+            {
+                modbus_tcp_rx_wait(p_mb, perr);
+                return;
+            }
+    #endif
+
+            start_time = get_clock_ticks();
 
             p_mb->RxDoneFlag = 0;
             while (p_mb->RxDoneFlag == 0)           // Receive Done Flag
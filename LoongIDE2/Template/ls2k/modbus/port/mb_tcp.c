@@ -0,0 +1,988 @@
+/**************************************************************************************************
+ * MODBUS TCP LAYER INTERFACE
+ *
+ * Filename: mb_tcp.c
+ * Version:
+ *
+ * Note(s): (1) Modbus/TCP over the lwIP socket API. An ADU is the 7-byte MBAP header followed by
+ *              the PDU (function code + data), without CRC:
+ *
+ *                <transaction id:2> <protocol id:2 = 0> <length:2> <unit id:1> <function code:1> <data>
+ *
+ *              where 'length' counts the unit id and the PDU.
+ *
+ *          (2) Inside the stack a request is handled exactly like an RTU frame: the unit id goes to
+ *              .RxFrameData[0], so modbus_slave_fcxx_handler() and the master's response parsers are
+ *              shared with the serial transports.
+ *
+ *          (3) One server task serves all client connections with select(). A client may send
+ *              several requests without waiting for the replies (pipelining): every complete ADU
+ *              in the receive buffer is executed in order, and the replies are queued in the
+ *              connection's transmit buffer.
+ *
+ *          (4) The server never blocks in send(): what a client does not take yet stays in its
+ *              transmit buffer until select() reports the socket writable, so a client that stops
+ *              reading can't hold up the other connections.
+ **************************************************************************************************/
+
+/**************************************************************************************************
+ * INCLUDE FILES
+ **************************************************************************************************/
+
+#include <string.h>
+
+#include "bsp.h"
+
+#include "osal.h"
+
+#include "../src/mb.h"
+
+#if (MODBUS_CFG_TCP_EN == 1)
+
+#include "lwip/sockets.h"
+
+#if (!LWIP_SOCKET)
+#error "Modbus/TCP requires the lwIP socket API, set LWIP_SOCKET in lwipopts.h."
+#endif
+
+/* Every connection slot, the listening socket and the connection accepted while all slots are
+ * busy (it replaces the one idle the longest) need a netconn and a tcp_pcb. The lwIP defaults
+ * (and the prebuilt liblwip213.a) are too small, use the lwipopts.h of the lwIP port sources.
+ */
+#if (MEMP_NUM_TCP_PCB < MODBUS_CFG_TCP_CONN_MAX + 1) || (MEMP_NUM_NETCONN < MODBUS_CFG_TCP_CONN_MAX + 2)
+#error "MODBUS_CFG_TCP_CONN_MAX is too large for MEMP_NUM_TCP_PCB/MEMP_NUM_NETCONN in lwipopts.h."
+#endif
+
+#ifndef NULL
+#define NULL ((void *)0)
+#endif
+
+/**************************************************************************************************
+ * DEFINES
+ **************************************************************************************************/
+
+#define MB_TCP_TASK_STK_SIZE        8*1024
+#define MB_TCP_TASK_PRIO            5           // same as the serial Rx task
+#define MB_TCP_SELECT_MS            1000        /* Idle connections and exit requests are checked this often */
+#define MB_TCP_TX_TIMEOUT_MS        1000        /* A client that takes none of its replies this long is dropped */
+
+#define MB_TCP_RX_BUF_SIZE          (4 * MODBUS_TCP_ADU_MAX_SIZE)   /* Pipelined requests of one client */
+#define MB_TCP_TX_BUF_SIZE          (4 * MODBUS_TCP_ADU_MAX_SIZE)   /* Replies not taken by the client yet */
+
+/**************************************************************************************************
+ * DATA TYPES
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_SLAVE_EN == 1)
+typedef struct
+{
+    int        Sock;                                /* Client socket, -1 when the slot is free */
+    uint32_t   LastTicks;                           /* get_clock_ticks() of the last request */
+    uint32_t   TxTicks;                             /* get_clock_ticks() when .TxBuf[] last moved */
+    uint16_t   RxBufByteCtr;                        /* Number of bytes in .RxBuf[] */
+    uint16_t   TxBufByteCtr;                        /* Number of bytes in .TxBuf[] */
+    uint8_t    RxBuf[MB_TCP_RX_BUF_SIZE];           /* Requests received, the last one maybe partial */
+    uint8_t    TxBuf[MB_TCP_TX_BUF_SIZE];           /* Replies the client has not taken yet */
+} MODBUS_TCP_CONN_t;
+#endif
+
+/**************************************************************************************************
+ * LOCAL / GLOBAL VARIABLES
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_SLAVE_EN == 1)
+static MODBUS_t          *mb_tcp_server;                    /* Channel that executes the requests */
+static osal_task_t        mb_tcp_task;                      /* modbus tcp server task */
+static int                mb_tcp_listen = -1;
+static volatile int       mb_tcp_stop;                      /* Set by modbus_tcp_server_exit() */
+static volatile int       mb_tcp_stopped;                   /* Set by the task when all is closed */
+
+static MODBUS_TCP_CONN_t  mb_tcp_conns[MODBUS_CFG_TCP_CONN_MAX];
+#endif
+
+/**************************************************************************************************
+ * LOCAL FUNCTION PROTOTYPES
+ **************************************************************************************************/
+
+static MODBUS_t *modbus_tcp_new_channel(uint8_t master_slave);
+static void modbus_tcp_set_sockopt(int sock, uint32_t tx_timeout);
+
+#if (MODBUS_CFG_SLAVE_EN == 1)
+static uint16_t modbus_tcp_slave_request(MODBUS_t *p_mb, const uint8_t *padu, uint16_t adu_len, uint8_t *ptx);
+static int modbus_tcp_conn_execute(MODBUS_TCP_CONN_t *pconn);
+static int modbus_tcp_conn_flush(MODBUS_TCP_CONN_t *pconn);
+static int modbus_tcp_conn_service(MODBUS_TCP_CONN_t *pconn, int readable);
+static void modbus_tcp_conn_close(MODBUS_TCP_CONN_t *pconn);
+static void modbus_tcp_accept(void);
+static void modbus_tcp_server_task(void *p_arg);
+#endif
+
+#if (MODBUS_CFG_MASTER_EN == 1)
+static int modbus_tcp_client_connect(MODBUS_t *p_mb);
+static int modbus_tcp_send(int sock, const uint8_t *pbuf, int len);
+static int modbus_tcp_recv(MODBUS_t *p_mb, uint8_t *pbuf, int len, uint32_t start);
+#endif
+
+/**************************************************************************************************
+ * function:    modbus_tcp_new_channel()
+ * Description: Take the next free entry of mb_devices_tbl[] for a Modbus/TCP channel.
+ * Argument(s): master_slave    MODBUS_MASTER or MODBUS_SLAVE.
+ * Return(s):   The channel, or NULL if all MODBUS_CFG_CHNL_MAX channels are used.
+ *
+ * Caller(s):   modbus_tcp_server_init(),
+ *              modbus_tcp_client_open().
+ * Note(s):     (1) .PtrUART stays NULL, so the serial Rx task and modbus_hw_port_exit() skip the
+ *                  channel.
+ **************************************************************************************************/
+
+static MODBUS_t *modbus_tcp_new_channel(uint8_t master_slave)
+{
+    MODBUS_t *p_mb;
+
+    if (mb_devices_count >= MODBUS_CFG_CHNL_MAX)
+        return (MODBUS_t *)0;
+
+    p_mb = &mb_devices_tbl[mb_devices_count];
+    modbus_set_channel_device(p_mb, NULL);              /* See Note #1. */
+    modbus_set_mode(p_mb, master_slave, MODBUS_MODE_TCP);
+
+    p_mb->TCP_Socket   = -1;
+    p_mb->TCP_TransId  = 0;
+    p_mb->RxBufByteCtr = 0;
+    p_mb->RxBufPtr     = &p_mb->RxBuf[0];
+
+    mb_devices_count++;
+    return p_mb;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_set_sockopt()
+ * Description: Options of every Modbus/TCP connection.
+ * Argument(s): sock        is the connected socket.
+ *              tx_timeout  send timeout in ms, 0 for none. See Note #2.
+ * Return(s):   none.
+ *
+ * Caller(s):   modbus_tcp_accept(),
+ *              modbus_tcp_client_connect().
+ * Note(s):     (1) ADUs are small and each one is waited for: without TCP_NODELAY a reply sent
+ *                  while the previous one is unacknowledged waits for the peer's delayed ACK.
+ *
+ *              (2) Only the client's blocking send() needs a timeout. The server sends with
+ *                  MSG_DONTWAIT, see modbus_tcp_conn_flush().
+ **************************************************************************************************/
+
+static void modbus_tcp_set_sockopt(int sock, uint32_t tx_timeout)
+{
+    struct timeval tv;
+    int opt = 1;
+
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));     /* See Note #1. */
+
+    if (tx_timeout > 0)                                                 /* See Note #2. */
+    {
+        tv.tv_sec  = tx_timeout / 1000;
+        tv.tv_usec = (tx_timeout % 1000) * 1000;
+        setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    }
+}
+
+/**************************************************************************************************
+ * MODBUS TCP SERVER
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_SLAVE_EN == 1)
+
+/**************************************************************************************************
+ * function:    modbus_tcp_server_init()
+ * Description: Open the Modbus/TCP server: a slave channel, a listening socket and the task that
+ *              serves up to MODBUS_CFG_TCP_CONN_MAX client connections.
+ * Argument(s): node_addr   is the unit id the server answers to, see Note #1.
+ *              port        is the TCP port, 0 for MODBUS_CFG_TCP_PORT (502).
+ *              wr_en       MODBUS_WR_EN or MODBUS_WR_DIS.
+ * Return(s):   The server's channel, or NULL on error.
+ *
+ * Caller(s):   Application, after modbus_init() and the lwIP network interface is up.
+ * Note(s):     (1) Requests with unit id 0 or 0xFF (server addressed by its IP only) are executed as
+ *                  if sent to 'node_addr'. Other unit ids get exception 11 (gateway target device
+ *                  failed to respond) instead of leaving the client to time out.
+ *
+ *              (2) Requests run in the server task. Like the serial Rx task, it calls mb_data.c
+ *                  without locking.
+ **************************************************************************************************/
+
+MODBUS_t *modbus_tcp_server_init(uint8_t node_addr, uint16_t port, uint8_t wr_en)
+{
+    struct sockaddr_in addr;
+    MODBUS_t *p_mb;
+    int sock, i, opt = 1;
+
+    if (mb_tcp_task != NULL)
+    {
+        printk("modbus tcp server is already running.\r\n");
+        return (MODBUS_t *)0;
+    }
+
+    sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0)
+    {
+        printk("create modbus tcp socket fail.\r\n");
+        return (MODBUS_t *)0;
+    }
+
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port ? port : MODBUS_CFG_TCP_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if ((bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) ||
+        (listen(sock, MODBUS_CFG_TCP_CONN_MAX) < 0))
+    {
+        printk("modbus tcp server can't listen on port %i.\r\n", port ? port : MODBUS_CFG_TCP_PORT);
+        closesocket(sock);
+        return (MODBUS_t *)0;
+    }
+
+    p_mb = modbus_tcp_new_channel(MODBUS_SLAVE);
+    if (p_mb == (MODBUS_t *)0)
+    {
+        closesocket(sock);
+        return (MODBUS_t *)0;
+    }
+
+    modbus_set_address(p_mb, node_addr);
+    modbus_set_write_enable(p_mb, wr_en);
+
+    for (i = 0; i < MODBUS_CFG_TCP_CONN_MAX; i++)
+    {
+        mb_tcp_conns[i].Sock = -1;
+    }
+
+    mb_tcp_server  = p_mb;
+    mb_tcp_listen  = sock;
+    mb_tcp_stop    = 0;
+    mb_tcp_stopped = 0;
+
+    mb_tcp_task = osal_task_create("Modbus TCP",
+                                   MB_TCP_TASK_STK_SIZE,
+                                   MB_TCP_TASK_PRIO,
+                                   10,
+                                   modbus_tcp_server_task,
+                                   NULL );
+
+    if (NULL == mb_tcp_task)
+    {
+        printk("create modbus tcp server task fail.\r\n");
+        closesocket(sock);
+        mb_tcp_listen = -1;
+        return (MODBUS_t *)0;
+    }
+
+    return p_mb;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_server_exit()
+ * Description: Close all client connections and the listening socket, then delete the task.
+ * Argument(s): none.
+ * Return(s):   none.
+ *
+ * Caller(s):   modbus_exit().
+ * Note(s):     (1) The task closes its sockets itself: deleting it in the middle of an lwIP call
+ *                  could leave the TCP/IP core locked.
+ **************************************************************************************************/
+
+void modbus_tcp_server_exit(void)
+{
+    int i;
+
+    if (mb_tcp_task == NULL)
+        return;
+
+    mb_tcp_stop = 1;                                    /* See Note #1. */
+
+    for (i = 0; (i < 2 * MB_TCP_SELECT_MS / 10) && !mb_tcp_stopped; i++)
+    {
+        osal_msleep(10);
+    }
+
+    osal_task_delete(mb_tcp_task);
+    mb_tcp_task = NULL;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_slave_request()
+ * Description: Execute one request ADU and build its reply ADU.
+ * Argument(s): p_mb        is the server's channel.
+ *              padu        points to the request, MBAP header first.
+ *              adu_len     is the size of the request, MBAP header included.
+ *              ptx         receives the reply (up to MODBUS_TCP_ADU_MAX_SIZE bytes).
+ * Return(s):   The size of the reply, 0 if there is none.
+ *
+ * Caller(s):   modbus_tcp_conn_service().
+ * Note(s):     none.
+ **************************************************************************************************/
+
+static uint16_t modbus_tcp_slave_request(MODBUS_t *p_mb, const uint8_t *padu, uint16_t adu_len, uint8_t *ptx)
+{
+    uint8_t  unit_id = padu[6];
+    uint16_t pdu_len = adu_len - MODBUS_TCP_MBAP_SIZE;
+    bool     do_reply;
+
+#if (MODBUS_CFG_FC08_EN == 1)
+    p_mb->StatMsgCtr++;
+#endif
+
+    if ((unit_id == 0) || (unit_id == MODBUS_TCP_UNIT_ID_NONE))
+        p_mb->RxFrameData[0] = p_mb->NodeAddr;          /* See modbus_tcp_server_init() Note #1. */
+    else
+        p_mb->RxFrameData[0] = unit_id;
+
+    memcpy(&p_mb->RxFrameData[1], &padu[MODBUS_TCP_MBAP_SIZE], pdu_len);
+    p_mb->RxFrameNDataBytes = pdu_len - 1;
+
+    if (p_mb->RxFrameData[0] == p_mb->NodeAddr)
+    {
+        do_reply = modbus_slave_fcxx_handler(p_mb);     /* Execute received command and formulate a response */
+    }
+    else
+    {
+        p_mb->TxFrameData[1]    = p_mb->RxFrameData[1] | 0x80;
+        p_mb->TxFrameData[2]    = MODBUS_ERR_GW_TARGET;
+        p_mb->TxFrameNDataBytes = 1;
+        do_reply = true;
+    }
+
+    if (do_reply == false)
+    {
+#if (MODBUS_CFG_FC08_EN == 1)
+        p_mb->StatNoRespCtr++;
+#endif
+        return 0;
+    }
+
+    pdu_len = p_mb->TxFrameNDataBytes + 1;              /* Function code + data */
+
+    ptx[0] = padu[0];                                   /* Transaction id is echoed */
+    ptx[1] = padu[1];
+    ptx[2] = 0;                                         /* Protocol id */
+    ptx[3] = 0;
+    ptx[4] = (uint8_t)((pdu_len + 1) >> 8);             /* Length: unit id + PDU */
+    ptx[5] = (uint8_t) (pdu_len + 1);
+    ptx[6] = unit_id;
+    memcpy(&ptx[MODBUS_TCP_MBAP_SIZE], &p_mb->TxFrameData[1], pdu_len);
+
+    return MODBUS_TCP_MBAP_SIZE + pdu_len;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_conn_execute()
+ * Description: Execute the complete requests in a connection's receive buffer and queue the replies.
+ * Argument(s): pconn       is the client connection.
+ * Return(s):   0, or -1 if the connection must be closed.
+ *
+ * Caller(s):   modbus_tcp_conn_service().
+ * Note(s):     (1) A wrong protocol id or length means the stream lost its framing: there is no way
+ *                  to find the next ADU, so the connection is closed.
+ *
+ *              (2) Requests wait in .RxBuf[] while .TxBuf[] has no room for a reply, they are
+ *                  executed when the client has taken some of the replies.
+ **************************************************************************************************/
+
+static int modbus_tcp_conn_execute(MODBUS_TCP_CONN_t *pconn)
+{
+    uint16_t pos = 0, len;
+    uint8_t *padu;
+
+    while (pconn->RxBufByteCtr - pos >= MODBUS_TCP_MBAP_SIZE)
+    {
+        padu = &pconn->RxBuf[pos];
+
+        len  = ((uint16_t)padu[4] << 8) + padu[5];      /* Unit id + PDU */
+        if ((padu[2] != 0) || (padu[3] != 0) ||         /* See Note #1. */
+            (len < 2) || (len > MODBUS_TCP_PDU_MAX_SIZE + 1))
+            return -1;
+
+        len += MODBUS_TCP_MBAP_SIZE - 1;                /* Whole ADU */
+        if (pconn->RxBufByteCtr - pos < len)            /* The rest is still on the way */
+            break;
+
+        if (pconn->TxBufByteCtr + MODBUS_TCP_ADU_MAX_SIZE > MB_TCP_TX_BUF_SIZE)
+            break;                                      /* See Note #2. */
+
+        if (pconn->TxBufByteCtr == 0)
+            pconn->TxTicks = (uint32_t)get_clock_ticks();
+
+        pconn->TxBufByteCtr += modbus_tcp_slave_request(mb_tcp_server, padu, len,
+                                                        &pconn->TxBuf[pconn->TxBufByteCtr]);
+        pos += len;
+    }
+
+    if (pos > 0)                                        /* Keep the requests left at the front */
+    {
+        pconn->RxBufByteCtr -= pos;
+        memmove(&pconn->RxBuf[0], &pconn->RxBuf[pos], pconn->RxBufByteCtr);
+    }
+
+    return 0;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_conn_flush()
+ * Description: Send as much of a connection's transmit buffer as the socket takes without waiting.
+ * Argument(s): pconn       is the client connection.
+ * Return(s):   The number of bytes sent, 0 if the socket's send buffer is full, or -1 on error.
+ *
+ * Caller(s):   modbus_tcp_conn_service().
+ * Note(s):     none.
+ **************************************************************************************************/
+
+static int modbus_tcp_conn_flush(MODBUS_TCP_CONN_t *pconn)
+{
+    int rt;
+
+    if (pconn->TxBufByteCtr == 0)
+        return 0;
+
+    rt = send(pconn->Sock, pconn->TxBuf, pconn->TxBufByteCtr, MSG_DONTWAIT);
+    if (rt < 0)
+        return ((errno == EWOULDBLOCK) || (errno == EAGAIN)) ? 0 : -1;
+
+    if (rt > 0)
+    {
+        pconn->TxBufByteCtr -= rt;
+        memmove(&pconn->TxBuf[0], &pconn->TxBuf[rt], pconn->TxBufByteCtr);
+        pconn->TxTicks = (uint32_t)get_clock_ticks();
+    }
+
+    return rt;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_conn_service()
+ * Description: Read what a client sent, execute the complete requests and send the replies.
+ * Argument(s): pconn       is the client connection, readable or writable according to select().
+ *              readable    is nonzero if the socket is readable.
+ * Return(s):   0, or -1 if the connection must be closed.
+ *
+ * Caller(s):   modbus_tcp_server_task().
+ * Note(s):     (1) When all queued replies were sent, the requests held back by a full .TxBuf[]
+ *                  are executed at once. A partial send means the socket's send buffer is full:
+ *                  the rest waits for the socket to become writable.
+ **************************************************************************************************/
+
+static int modbus_tcp_conn_service(MODBUS_TCP_CONN_t *pconn, int readable)
+{
+    int rt;
+
+    if (readable)
+    {
+        rt = recv(pconn->Sock, &pconn->RxBuf[pconn->RxBufByteCtr],
+                  MB_TCP_RX_BUF_SIZE - pconn->RxBufByteCtr, 0);
+        if (rt <= 0)                                    /* Closed by the client or error */
+            return -1;
+
+        pconn->RxBufByteCtr += rt;
+        pconn->LastTicks     = (uint32_t)get_clock_ticks();
+    }
+
+    do
+    {
+        if (modbus_tcp_conn_execute(pconn) < 0)
+            return -1;
+
+        rt = modbus_tcp_conn_flush(pconn);
+        if (rt < 0)
+            return -1;
+    } while ((rt > 0) && (pconn->TxBufByteCtr == 0));  /* See Note #1. */
+
+    return 0;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_conn_close()
+ * Description: Close a client connection and free its slot.
+ * Argument(s): pconn       is the client connection.
+ * Return(s):   none.
+ *
+ * Caller(s):   modbus_tcp_accept(),
+ *              modbus_tcp_server_task().
+ * Note(s):     none.
+ **************************************************************************************************/
+
+static void modbus_tcp_conn_close(MODBUS_TCP_CONN_t *pconn)
+{
+    if (pconn->Sock >= 0)
+    {
+        closesocket(pconn->Sock);
+        pconn->Sock = -1;
+    }
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_accept()
+ * Description: Accept a client connection.
+ * Argument(s): none.
+ * Return(s):   none.
+ *
+ * Caller(s):   modbus_tcp_server_task().
+ * Note(s):     (1) When all slots are in use, the connection idle the longest is closed. A SCADA
+ *                  master that restarts leaves its old connections open; refusing the new one
+ *                  would lock it out until they time out.
+ **************************************************************************************************/
+
+static void modbus_tcp_accept(void)
+{
+    MODBUS_TCP_CONN_t *pconn = NULL, *pidle = NULL;
+    int sock, i;
+
+    sock = accept(mb_tcp_listen, NULL, NULL);
+    if (sock < 0)
+        return;
+
+    for (i = 0; i < MODBUS_CFG_TCP_CONN_MAX; i++)
+    {
+        if (mb_tcp_conns[i].Sock < 0)
+        {
+            pconn = &mb_tcp_conns[i];
+            break;
+        }
+
+        if ((pidle == NULL) || ((int32_t)(mb_tcp_conns[i].LastTicks - pidle->LastTicks) < 0))
+            pidle = &mb_tcp_conns[i];
+    }
+
+    if (pconn == NULL)                                  /* See Note #1. */
+    {
+        modbus_tcp_conn_close(pidle);
+        pconn = pidle;
+    }
+
+    modbus_tcp_set_sockopt(sock, 0);
+
+    pconn->Sock         = sock;
+    pconn->RxBufByteCtr = 0;
+    pconn->TxBufByteCtr = 0;
+    pconn->LastTicks    = (uint32_t)get_clock_ticks();
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_server_task()
+ * Description: Wait with select() on the listening socket and all client connections, and serve
+ *              those that are readable, or writable with replies waiting.
+ * Argument(s): p_arg   is not used.
+ * Return(s):   none.
+ *
+ * Caller(s):   This is a Task.
+ * Note(s):     (1) Clients are served before accept(): a slot freed and reused by accept() must
+ *                  not be taken as readable from the select() result of its previous socket.
+ *
+ *              (2) .RxBuf[] is full only of requests held back by a full .TxBuf[]: nothing more is
+ *                  read until the client takes its replies.
+ *
+ *              (3) A client that takes none of its replies for MB_TCP_TX_TIMEOUT_MS is dropped,
+ *                  it would otherwise keep its slot as long as it keeps the connection open.
+ **************************************************************************************************/
+
+static void modbus_tcp_server_task(void *p_arg)
+{
+    struct timeval tv;
+    fd_set   rdset, wrset;
+    uint32_t now;
+    int      i, maxfd, rt;
+
+    (void)p_arg;
+
+    while (!mb_tcp_stop)
+    {
+        FD_ZERO(&rdset);
+        FD_ZERO(&wrset);
+        FD_SET(mb_tcp_listen, &rdset);
+        maxfd = mb_tcp_listen;
+
+        for (i = 0; i < MODBUS_CFG_TCP_CONN_MAX; i++)
+        {
+            if (mb_tcp_conns[i].Sock >= 0)
+            {
+                if (mb_tcp_conns[i].RxBufByteCtr < MB_TCP_RX_BUF_SIZE)     /* See Note #2. */
+                    FD_SET(mb_tcp_conns[i].Sock, &rdset);
+                if (mb_tcp_conns[i].TxBufByteCtr > 0)
+                    FD_SET(mb_tcp_conns[i].Sock, &wrset);
+                if (mb_tcp_conns[i].Sock > maxfd)
+                    maxfd = mb_tcp_conns[i].Sock;
+            }
+        }
+
+        tv.tv_sec  = MB_TCP_SELECT_MS / 1000;
+        tv.tv_usec = (MB_TCP_SELECT_MS % 1000) * 1000;
+
+        rt = select(maxfd + 1, &rdset, &wrset, NULL, &tv);
+        if (rt < 0)
+        {
+            osal_msleep(10);
+            continue;
+        }
+
+        if (rt > 0)
+        {
+            for (i = 0; i < MODBUS_CFG_TCP_CONN_MAX; i++)     /* See Note #1. */
+            {
+                if ((mb_tcp_conns[i].Sock >= 0) &&
+                    (FD_ISSET(mb_tcp_conns[i].Sock, &rdset) || FD_ISSET(mb_tcp_conns[i].Sock, &wrset)))
+                {
+                    if (modbus_tcp_conn_service(&mb_tcp_conns[i],
+                                                FD_ISSET(mb_tcp_conns[i].Sock, &rdset)) < 0)
+                        modbus_tcp_conn_close(&mb_tcp_conns[i]);
+                }
+            }
+
+            if (FD_ISSET(mb_tcp_listen, &rdset))
+                modbus_tcp_accept();
+        }
+
+        now = (uint32_t)get_clock_ticks();
+        for (i = 0; i < MODBUS_CFG_TCP_CONN_MAX; i++)
+        {
+            if (mb_tcp_conns[i].Sock < 0)
+                continue;
+
+            if ((mb_tcp_conns[i].TxBufByteCtr > 0) &&
+                (now - mb_tcp_conns[i].TxTicks >= MB_TCP_TX_TIMEOUT_MS))   /* See Note #3. */
+                modbus_tcp_conn_close(&mb_tcp_conns[i]);
+#if (MODBUS_CFG_TCP_IDLE_TIMEOUT > 0)
+            else if (now - mb_tcp_conns[i].LastTicks >= MODBUS_CFG_TCP_IDLE_TIMEOUT)
+                modbus_tcp_conn_close(&mb_tcp_conns[i]);
+#endif
+        }
+    }
+
+    for (i = 0; i < MODBUS_CFG_TCP_CONN_MAX; i++)
+    {
+        modbus_tcp_conn_close(&mb_tcp_conns[i]);
+    }
+
+    closesocket(mb_tcp_listen);
+    mb_tcp_listen  = -1;
+    mb_tcp_stopped = 1;
+
+    while (1)                                           /* Deleted by modbus_tcp_server_exit() */
+    {
+        osal_msleep(MB_TCP_SELECT_MS);
+    }
+}
+
+#endif // #if (MODBUS_CFG_SLAVE_EN == 1)
+
+/**************************************************************************************************
+ * MODBUS TCP CLIENT
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_MASTER_EN == 1)
+
+/**************************************************************************************************
+ * function:    modbus_tcp_client_open()
+ * Description: Create a master channel that talks to a Modbus/TCP server. The modbus_master_fcxx()
+ *              functions are used on it as on a serial channel.
+ * Argument(s): ip_addr     is the server's IPv4 address, "a.b.c.d".
+ *              port        is the server's port, 0 for MODBUS_CFG_TCP_PORT (502).
+ *              rx_timeout  amount of time (ms) the master waits for a response.
+ * Return(s):   The channel, or NULL on error.
+ *
+ * Caller(s):   Application, after modbus_init() and the lwIP network interface is up.
+ * Note(s):     (1) The connection is made here, and made again by the next request if it is lost.
+ *              (2) The slave address of a modbus_master_fcxx() call is sent as the unit id.
+ **************************************************************************************************/
+
+MODBUS_t *modbus_tcp_client_open(const char *ip_addr, uint16_t port, uint32_t rx_timeout)
+{
+    MODBUS_t *p_mb;
+    uint32_t  ip;
+
+    ip = inet_addr(ip_addr);
+    if (ip == IPADDR_NONE)
+        return (MODBUS_t *)0;
+
+    p_mb = modbus_tcp_new_channel(MODBUS_MASTER);
+    if (p_mb == (MODBUS_t *)0)
+        return (MODBUS_t *)0;
+
+    modbus_master_timeout_set(p_mb, rx_timeout);
+    p_mb->TCP_ServerIP   = ip;
+    p_mb->TCP_ServerPort = htons(port ? port : MODBUS_CFG_TCP_PORT);
+
+    modbus_tcp_client_connect(p_mb);                    /* See Note #1. */
+
+    return p_mb;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_client_close()
+ * Description: Close the connection of a master channel.
+ * Argument(s): p_mb        is the channel returned by modbus_tcp_client_open().
+ * Return(s):   none.
+ *
+ * Caller(s):   Application,
+ *              modbus_tcp_tx(),
+ *              modbus_tcp_rx_wait().
+ * Note(s):     none.
+ **************************************************************************************************/
+
+void modbus_tcp_client_close(MODBUS_t *p_mb)
+{
+    if ((p_mb != (MODBUS_t *)0) && (p_mb->TCP_Socket >= 0))
+    {
+        closesocket(p_mb->TCP_Socket);
+        p_mb->TCP_Socket = -1;
+    }
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_client_connect()
+ * Description: Connect a master channel to its server.
+ * Argument(s): p_mb        is the channel.
+ * Return(s):   0, or -1 if the server can't be reached.
+ *
+ * Caller(s):   modbus_tcp_client_open(),
+ *              modbus_tcp_tx().
+ * Note(s):     none.
+ **************************************************************************************************/
+
+static int modbus_tcp_client_connect(MODBUS_t *p_mb)
+{
+    struct sockaddr_in addr;
+    int sock;
+
+    sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0)
+        return -1;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = p_mb->TCP_ServerPort;
+    addr.sin_addr.s_addr = p_mb->TCP_ServerIP;
+
+    if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        DBGPRINT("modbus tcp connect fail.\r\n");
+        closesocket(sock);
+        return -1;
+    }
+
+    modbus_tcp_set_sockopt(sock, p_mb->RxTimeout);
+
+    p_mb->TCP_Socket = sock;
+    return 0;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_tx()
+ * Description: Send the request in .TxFrameData[] with a new transaction id.
+ * Argument(s): p_mb        is the channel.
+ * Return(s):   none.
+ *
+ * Caller(s):   modbus_master_tx_command().
+ * Note(s):     (1) Errors are reported by modbus_tcp_rx_wait(), which finds the socket closed.
+ **************************************************************************************************/
+
+void modbus_tcp_tx(MODBUS_t *p_mb)
+{
+    uint8_t  adu[MODBUS_TCP_ADU_MAX_SIZE];
+    uint16_t len = p_mb->TxFrameNDataBytes + 2;         /* Unit id + function code + data */
+
+    if (len > MODBUS_TCP_PDU_MAX_SIZE + 1)
+        return;
+
+    if ((p_mb->TCP_Socket < 0) && (modbus_tcp_client_connect(p_mb) < 0))
+        return;                                         /* See Note #1. */
+
+    p_mb->TCP_TransId++;
+
+    adu[0] = (uint8_t)(p_mb->TCP_TransId >> 8);
+    adu[1] = (uint8_t) p_mb->TCP_TransId;
+    adu[2] = 0;                                         /* Protocol id */
+    adu[3] = 0;
+    adu[4] = (uint8_t)(len >> 8);
+    adu[5] = (uint8_t) len;
+    memcpy(&adu[MODBUS_TCP_MBAP_SIZE - 1], &p_mb->TxFrameData[0], len);
+
+    if (modbus_tcp_send(p_mb->TCP_Socket, adu, MODBUS_TCP_MBAP_SIZE - 1 + len) < 0)
+        modbus_tcp_client_close(p_mb);
+    else
+        p_mb->TxCtr += MODBUS_TCP_MBAP_SIZE - 1 + len;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_send()
+ * Description: Send a whole buffer on a socket, waiting as long as SO_SNDTIMEO allows.
+ * Argument(s): sock        is the connected socket.
+ *              pbuf        points to the data.
+ *              len         is the number of bytes to send.
+ * Return(s):   0 if everything was sent, -1 on error or send timeout.
+ *
+ * Caller(s):   modbus_tcp_tx().
+ * Note(s):     none.
+ **************************************************************************************************/
+
+static int modbus_tcp_send(int sock, const uint8_t *pbuf, int len)
+{
+    int rt;
+
+    while (len > 0)
+    {
+        rt = send(sock, pbuf, len, 0);
+        if (rt <= 0)
+            return -1;
+
+        pbuf += rt;
+        len  -= rt;
+    }
+
+    return 0;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_recv()
+ * Description: Receive 'len' bytes, or what arrives until the channel's .RxTimeout expires.
+ * Argument(s): p_mb        is the channel.
+ *              pbuf        receives the data.
+ *              len         is the number of bytes wanted.
+ *              start       get_clock_ticks() when the wait started.
+ * Return(s):   The number of bytes received, or -1 if the connection failed.
+ *
+ * Caller(s):   modbus_tcp_rx_wait().
+ * Note(s):     none.
+ **************************************************************************************************/
+
+static int modbus_tcp_recv(MODBUS_t *p_mb, uint8_t *pbuf, int len, uint32_t start)
+{
+    struct timeval tv;
+    fd_set   rdset;
+    uint32_t elapsed;
+    int      got = 0, rt;
+
+    while (got < len)
+    {
+        elapsed = (uint32_t)get_clock_ticks() - start;
+        if (elapsed >= p_mb->RxTimeout)
+            break;
+
+        tv.tv_sec  = (p_mb->RxTimeout - elapsed) / 1000;
+        tv.tv_usec = ((p_mb->RxTimeout - elapsed) % 1000) * 1000;
+
+        FD_ZERO(&rdset);
+        FD_SET(p_mb->TCP_Socket, &rdset);
+
+        rt = select(p_mb->TCP_Socket + 1, &rdset, NULL, NULL, &tv);
+        if (rt < 0)
+            return -1;
+        if (rt == 0)
+            break;
+
+        rt = recv(p_mb->TCP_Socket, pbuf + got, len - got, 0);
+        if (rt <= 0)
+            return -1;
+
+        got += rt;
+    }
+
+    return got;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_rx_wait()
+ * Description: Wait for the response to the last request and put its unit id and PDU in .RxBuf[].
+ * Argument(s): p_mb    is the channel.
+ *              perr    is a pointer to a variable that will receive an error code:
+ *                      MODBUS_ERR_NONE        a response was received
+ *                      MODBUS_ERR_TIMED_OUT   no response within .RxTimeout
+ *                      MODBUS_ERR_RX          not connected, or the connection failed
+ * Return(s):   none.
+ *
+ * Caller(s):   modbus_os_rx_wait().
+ * Note(s):     (1) After a timeout the connection is kept. The late response of that request comes
+ *                  first on the next wait, and is skipped because of its transaction id.
+ *
+ *              (2) A frame cut by the timeout can't be resynchronised: the connection is closed
+ *                  and made again by the next request.
+ **************************************************************************************************/
+
+void modbus_tcp_rx_wait(MODBUS_t *p_mb, uint16_t *perr)
+{
+    uint8_t  mbap[MODBUS_TCP_MBAP_SIZE - 1];            /* Unit id goes to .RxBuf[0] */
+    uint32_t start = (uint32_t)get_clock_ticks();
+    uint16_t len;
+    int      rt;
+
+    p_mb->RxBufByteCtr = 0;
+    p_mb->RxBufPtr     = &p_mb->RxBuf[0];
+
+    if (p_mb->TCP_Socket < 0)
+    {
+        *perr = MODBUS_ERR_RX;
+        return;
+    }
+
+    while (1)
+    {
+        rt = modbus_tcp_recv(p_mb, mbap, sizeof(mbap), start);
+        if (rt == 0)
+        {
+            *perr = MODBUS_ERR_TIMED_OUT;               /* See Note #1. */
+            return;
+        }
+
+        if (rt != sizeof(mbap))
+            break;
+
+        len = ((uint16_t)mbap[4] << 8) + mbap[5];
+        if ((mbap[2] != 0) || (mbap[3] != 0) || (len < 2) || (len > MODBUS_TCP_PDU_MAX_SIZE + 1))
+            break;
+
+        if (modbus_tcp_recv(p_mb, p_mb->RxBuf, len, start) != len)
+            break;                                      /* See Note #2. */
+
+        p_mb->RxCtr += sizeof(mbap) + len;
+
+        if ((mbap[0] == (uint8_t)(p_mb->TCP_TransId >> 8)) &&
+            (mbap[1] == (uint8_t) p_mb->TCP_TransId))
+        {
+            p_mb->RxBufByteCtr = len;
+            *perr = MODBUS_ERR_NONE;
+            return;
+        }
+    }
+
+    modbus_tcp_client_close(p_mb);
+    *perr = MODBUS_ERR_RX;
+}
+
+/**************************************************************************************************
+ * function:    modbus_tcp_rx()
+ * Description: Move the response in .RxBuf[] to .RxFrameData[].
+ * Argument(s): p_mb    is the channel.
+ * Return(s):   true if there is a response.
+ *
+ * Caller(s):   modbus_master_rx_reply().
+ * Note(s):     none.
+ **************************************************************************************************/
+
+bool modbus_tcp_rx(MODBUS_t *p_mb)
+{
+    if (p_mb->RxBufByteCtr < 2)                         /* Unit id + function code */
+        return false;
+
+    memcpy(&p_mb->RxFrameData[0], &p_mb->RxBuf[0], p_mb->RxBufByteCtr);
+    p_mb->RxFrameNDataBytes = p_mb->RxBufByteCtr - 2;
+
+    return true;
+}
+
+#endif // #if (MODBUS_CFG_MASTER_EN == 1)
+
+#endif // #if (MODBUS_CFG_TCP_EN == 1)
+
+//-----------------------------------------------------------------------------
+/*
+ * @@ END
+ */
@@ -72,6 +72,10 @@ void modbus_init(uint32_t freq)
 
     mb_devices_count = 0;
 
+#if (MODBUS_CFG_SLAVE_EN == 1) && (MODBUS_CFG_MAP_EN == 1)
+    modbus_slave_map_init();                            /* Check the register maps of mb_data.c */
+#endif
+
     modbus_os_init();                	    /* Initialize OS interface functions */
 
 #if (MODBUS_CFG_RTU_EN == 1)         	    /* MODBUS 'RTU' Initialization */
@@ -99,6 +103,10 @@ void modbus_exit(void)
     modbus_rtu_timer_exit();          	    /* Stop the RTU timer interrupts */
 #endif
 
+#if (MODBUS_CFG_TCP_EN == 1) && (MODBUS_CFG_SLAVE_EN == 1)
+    modbus_tcp_server_exit();               /* Close the Modbus/TCP server and its connections */
+#endif
+
     modbus_hw_port_exit();                  /* Disable all communications */
 
     modbus_os_exit();                 	    /* Stop RTOS services */
@@ -212,6 +220,7 @@ void modbus_master_timeout_set(MODBUS_t *p_mb, uint32_t timeout)
  *              modbus_mode  specifies the type of modbus channel.  The choices are:
  *                           MODBUS_MODE_ASCII
  *                           MODBUS_MODE_RTU
+ *                           MODBUS_MODE_TCP  (channels of mb_tcp.c)
  * Return(s):   none.
  *
  * Caller(s):   Application.
@@ -248,6 +257,12 @@ void modbus_set_mode(MODBUS_t *p_mb, uint8_t master_slave, uint8_t mode)
                 break;
 		#endif
 
+		#if (MODBUS_CFG_TCP_EN == 1)
+            case MODBUS_MODE_TCP:
+            	p_mb->Mode = MODBUS_MODE_TCP;
+                break;
+		#endif
+
             default:
 		#if (MODBUS_CFG_RTU_EN == 1)
             	p_mb->Mode = MODBUS_MODE_RTU;
@@ -569,6 +584,21 @@ void modbus_rtu_rx_byte(MODBUS_t *p_mb, uint8_t rx_byte)
     	p_mb->RxCtr++;                                  /* Increment the number of bytes received */
         *p_mb->RxBufPtr++ = rx_byte;
         p_mb->RxBufByteCtr++;                           /* Increment byte counter to see if we have Rx activity */
+
+        /*
+         * Running CRC, see modbus_rtu_rx_calculate_crc(). It stays two bytes behind because
+         * the last two bytes of the frame are the CRC itself.
+         */
+        if (p_mb->RxBufByteCtr == 1)                    /* First byte of a new frame */
+        {
+            p_mb->RxCRC_Run    = 0xFFFF;
+            p_mb->RxCRC_RunCtr = 0;
+        }
+        else if (p_mb->RxBufByteCtr > 2)
+        {
+            p_mb->RxCRC_Run = modbus_crc16_update(p_mb->RxCRC_Run, p_mb->RxBufPtr - 3, 1);
+            p_mb->RxCRC_RunCtr++;
+        }
     }
 }
 #endif
@@ -140,12 +140,50 @@ typedef struct modbus_
     uint16_t   RxFrameNDataBytes;                   /* Number of bytes in the data field. */
     uint16_t   RxFrameCRC;                          /* Error check value (LRC or CRC-16). */
     uint16_t   RxFrameCRC_Calc;                     /* Error check value computed from packet received */
+#if (MODBUS_CFG_RTU_EN == 1)
+    uint16_t   RxCRC_Run;                           /* CRC-16 of .RxBuf[] updated per byte, 2 bytes behind */
+    uint16_t   RxCRC_RunCtr;                        /* Number of bytes in .RxCRC_Run */
+#endif
+
+#if (MODBUS_CFG_TCP_EN == 1)
+    int        TCP_Socket;                          /* Master: socket connected to the server, -1 if none */
+    uint16_t   TCP_TransId;                         /* Master: MBAP transaction identifier of the last request */
+    uint16_t   TCP_ServerPort;                      /* Master: server port, network byte order */
+    uint32_t   TCP_ServerIP;                        /* Master: server IPv4 address, network byte order */
+#endif
 
     uint8_t    TxFrameData[MODBUS_CFG_BUF_SIZE];    /* Additional data for function requested. */
     uint16_t   TxFrameNDataBytes;                   /* Number of bytes in the data field. */
     uint16_t   TxFrameCRC;                          /* Error check value (LRC or CRC-16). */
 } MODBUS_t;
 
+/**************************************************************************************************
+ * REGISTER MAP
+ *
+ * Note(s): (1) A map is an array of ranges sorted by .Start and not overlapping. The registers of a
+ *              range are either in application memory (.PtrData, one uint16_t per register in CPU
+ *              byte order) or read and written in bulk by callbacks (.PtrData == NULL). A request
+ *              is served range by range, never register by register.
+ *
+ *          (2) The callbacks return MODBUS_ERR_NONE, or MODBUS_ERR_RANGE to reject the request.
+ *              'reg' and 'nbr' always stay inside the range.
+ *
+ *          (3) Registers below MODBUS_CFG_FP_START_IX that no range covers are still served by
+ *              modbus_read_holding_register() and the other functions of mb_data.c.
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_MAP_EN == 1)
+typedef struct modbus_map_
+{
+    uint16_t   Start;                               /* First register of the range */
+    uint16_t   Nbr;                                 /* Number of registers */
+    uint8_t    Flags;                               /* MODBUS_MAP_RD_ONLY */
+    uint16_t  *PtrData;                             /* Application memory, or NULL for the callbacks */
+    uint16_t (*Rd)(uint16_t reg, uint16_t nbr, uint16_t *pval);          /* Bulk read, see Note #2 */
+    uint16_t (*Wr)(uint16_t reg, uint16_t nbr, const uint16_t *pval);    /* Bulk write, NULL if read only */
+} MODBUS_MAP_t;
+#endif
+
 /**************************************************************************************************
  * GLOBAL VARIABLES
  **************************************************************************************************/
@@ -223,6 +261,26 @@ void modbus_os_exit(void);
 void modbus_os_rx_signal(MODBUS_t *p_mb);
 void modbus_os_rx_wait(MODBUS_t *p_mb, uint16_t *perr);
 
+/**************************************************************************************************
+ * MODBUS TCP INTERFACE FUNCTION PROTOTYPES
+ * (defined in mb_tcp.c)
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_TCP_EN == 1)
+#if (MODBUS_CFG_SLAVE_EN == 1)
+MODBUS_t *modbus_tcp_server_init(uint8_t node_addr, uint16_t port, uint8_t wr_en);
+void modbus_tcp_server_exit(void);
+#endif
+
+#if (MODBUS_CFG_MASTER_EN == 1)
+MODBUS_t *modbus_tcp_client_open(const char *ip_addr, uint16_t port, uint32_t rx_timeout);
+void modbus_tcp_client_close(MODBUS_t *p_mb);
+void modbus_tcp_rx_wait(MODBUS_t *p_mb, uint16_t *perr);
+bool modbus_tcp_rx(MODBUS_t *p_mb);
+void modbus_tcp_tx(MODBUS_t *p_mb);
+#endif
+#endif
+
 /**************************************************************************************************
  * COMMON MODBUS ASCII INTERFACE FUNCTION PROTOTYPES
  * (defined in mb_util.c)
@@ -241,6 +299,7 @@ uint8_t modbus_ascii_tx_calculate_lrc(MODBUS_t *p_mb, uint16_t tx_bytes);
  **************************************************************************************************/
 
 #if (MODBUS_CFG_RTU_EN == 1)
+uint16_t modbus_crc16_update(uint16_t crc, const uint8_t *pblock, uint16_t length);
 uint16_t modbus_rtu_tx_calculate_crc(MODBUS_t *p_mb);
 uint16_t modbus_rtu_rx_calculate_crc(MODBUS_t *p_mb);
 #endif
@@ -277,6 +336,18 @@ void modbus_write_holding_register(uint16_t reg, uint16_t reg_val_16, uint16_t *
 void modbus_write_holding_register_float(uint16_t reg, float reg_val_fp, uint16_t *perr);
 #endif
 
+#if (MODBUS_CFG_MAP_EN == 1)
+#if (MODBUS_CFG_FC03_EN == 1) || (MODBUS_CFG_FC06_EN == 1) || (MODBUS_CFG_FC16_EN == 1)
+extern const MODBUS_MAP_t modbus_holding_register_map[];    /* Sorted by .Start */
+extern const uint16_t     modbus_holding_register_map_nbr;
+#endif
+
+#if (MODBUS_CFG_FC04_EN == 1)
+extern const MODBUS_MAP_t modbus_in_register_map[];         /* Sorted by .Start */
+extern const uint16_t     modbus_in_register_map_nbr;
+#endif
+#endif
+
 #if (MODBUS_CFG_FC20_EN == 1)
 uint16_t modbus_read_file(uint16_t file_nbr, uint16_t record_nbr, uint16_t ix,
                           uint8_t record_len, uint16_t *perr);
@@ -321,6 +392,9 @@ void modbus_slave_rx_task(MODBUS_t *p_mb);
 #if (MODBUS_CFG_FC08_EN == 1)
 void modbus_slave_stat_init(MODBUS_t *p_mb);
 #endif
+#if (MODBUS_CFG_MAP_EN == 1)
+void modbus_slave_map_init(void);
+#endif
 #endif
 
 /**************************************************************************************************
@@ -11,6 +11,7 @@
 
 #define MODBUS_MODE_ASCII               0
 #define MODBUS_MODE_RTU                 1
+#define MODBUS_MODE_TCP                 2
 
 #define MODBUS_WR_EN                  	1
 #define MODBUS_WR_DIS                  	0
@@ -25,6 +26,8 @@
 #define MODBUS_SLAVE                    0
 #define MODBUS_MASTER                	1
 
+#define MODBUS_MAP_RD_ONLY             	0x01        /* MODBUS_MAP_t.Flags: FC06/FC16 can't write the range */
+
 #define MODBUS_MASTER_STATE_RX         	0
 #define MODBUS_MASTER_STATE_TX         	1
 #define MODBUS_MASTER_STATE_WAITING  	2
@@ -66,6 +69,7 @@
 #define MODBUS_ERR_ILLEGAL_DATA_ADDR	2
 #define MODBUS_ERR_ILLEGAL_DATA_QTY   	3
 #define MODBUS_ERR_ILLEGAL_DATA_VAL   	4
+#define MODBUS_ERR_GW_TARGET          	11          /* Gateway target device failed to respond */
 
 #define MODBUS_ERR_FC01_01            	101
 #define MODBUS_ERR_FC01_02           	102
@@ -157,6 +161,17 @@
 #define MODBUS_RTU_MIN_MSG_SIZE       	4
 #endif
 
+/**************************************************************************************************
+ * MODBUS TCP CONSTANTS
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_TCP_EN == 1)
+#define MODBUS_TCP_MBAP_SIZE          	7           /* Transaction id, protocol id, length, unit id */
+#define MODBUS_TCP_PDU_MAX_SIZE       	253         /* Function code + data */
+#define MODBUS_TCP_ADU_MAX_SIZE       	(MODBUS_TCP_MBAP_SIZE + MODBUS_TCP_PDU_MAX_SIZE)
+#define MODBUS_TCP_UNIT_ID_NONE       	0xFF        /* Unit id of a server addressed by its IP only */
+#endif
+
 #define MODBUS_CRC16_POLY             	0xA001      /* CRC-16 Generation Polynomial value. */
 
 /*
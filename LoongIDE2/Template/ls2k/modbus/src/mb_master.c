@@ -1333,6 +1333,11 @@ static bool modbus_master_rx_reply(MODBUS_t *p_mb)
         if (p_mb->Mode == MODBUS_MODE_RTU)
             ok = modbus_rtu_rx(p_mb);
 #endif
+
+#if (MODBUS_CFG_TCP_EN == 1)
+        if (p_mb->Mode == MODBUS_MODE_TCP)
+            ok = modbus_tcp_rx(p_mb);
+#endif
     }
 
     return ok;
@@ -1361,6 +1366,11 @@ static void modbus_master_tx_command(MODBUS_t *p_mb)
         if (p_mb->Mode == MODBUS_MODE_RTU)
             modbus_rtu_tx(p_mb);
 #endif
+
+#if (MODBUS_CFG_TCP_EN == 1)
+        if (p_mb->Mode == MODBUS_MODE_TCP)
+            modbus_tcp_tx(p_mb);
+#endif
     }
 }
 
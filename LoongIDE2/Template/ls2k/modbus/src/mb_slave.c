@@ -157,6 +157,207 @@ static void modbus_slave_set_response_error(MODBUS_t *p_mb, uint8_t err_code)
     MBS_TX_FRAME_NBYTES = 1;                      	    /* Nbr of data bytes in exception response is 1. */
 }
 
+/**************************************************************************************************
+ * REGISTER MAP
+ *
+ * Note(s):     1) The number of valid entries of each map is set by modbus_slave_map_init(), a map
+ *                 that fails the check is not used at all.
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_MAP_EN == 1)
+
+#define MBS_MAP_HOLDING_EN  ((MODBUS_CFG_FC03_EN == 1) || (MODBUS_CFG_FC06_EN == 1) || (MODBUS_CFG_FC16_EN == 1))
+
+#if MBS_MAP_HOLDING_EN
+static uint16_t mbs_holding_map_nbr;
+#endif
+
+#if (MODBUS_CFG_FC04_EN == 1)
+static uint16_t mbs_in_map_nbr;
+#endif
+
+/**************************************************************************************************
+ * function:    modbus_slave_map_find()
+ * Description: Binary search of the range that holds a register.
+ * Argument(s): pmap        Is the map, sorted by .Start.
+ *              nbr         Number of entries of the map.
+ *              reg         Is the register to look for.
+ * Return(s):   The entry holding 'reg', or 0 if no entry does.
+ *
+ * Caller(s):   modbus_slave_map_read(),
+ *              modbus_slave_map_write().
+ * Note(s):     none.
+ **************************************************************************************************/
+
+static const MODBUS_MAP_t *modbus_slave_map_find(const MODBUS_MAP_t *pmap, uint16_t nbr, uint16_t reg)
+{
+    uint16_t lo = 0, hi = nbr, mid;
+
+    while (lo < hi)
+    {
+        mid = (uint16_t)((lo + hi) / 2);
+
+        if (reg < pmap[mid].Start)
+            hi = mid;
+        else if (reg - pmap[mid].Start >= pmap[mid].Nbr)
+            lo = mid + 1;
+        else
+            return &pmap[mid];
+    }
+
+    return (const MODBUS_MAP_t *)0;
+}
+
+/**************************************************************************************************
+ * function:    modbus_slave_map_read()
+ * Description: Copy the registers that the map holds from 'reg' on into a response, in big endian.
+ * Argument(s): pmap        Is the map, sorted by .Start.
+ *              nbr         Number of entries of the map.
+ *              reg         Is the first register to read.
+ *              nbr_regs    Is the number of registers requested.
+ *              presp       Is where the first register goes in the response.
+ *              perr        Is a pointer to an error code indicator.
+ * Return(s):   The number of registers copied. 0 if 'reg' is not in the map.
+ *
+ * Caller(s):   modbus_slave_fc03_read_holding_register(),
+ *              modbus_slave_fc04_read_in_register().
+ * Note(s):     1) The copy goes on through adjacent entries and stops at the first gap, the caller
+ *                 serves the registers after the gap.
+ *              2) *perr is MODBUS_ERR_NONE unless a read callback failed.
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_FC03_EN == 1) || (MODBUS_CFG_FC04_EN == 1)
+static uint16_t modbus_slave_map_read(const MODBUS_MAP_t *pmap, uint16_t nbr, uint16_t reg,
+                                      uint16_t nbr_regs, uint8_t *presp, uint16_t *perr)
+{
+    const MODBUS_MAP_t *pend = pmap + nbr;
+    const uint16_t     *pval;
+    uint16_t            buf[125];
+    uint16_t            done = 0, off, n, i;
+
+    *perr = MODBUS_ERR_NONE;
+    pmap  = modbus_slave_map_find(pmap, nbr, reg);
+
+    while ((pmap != (const MODBUS_MAP_t *)0) && (done < nbr_regs))
+    {
+        off = reg - pmap->Start;
+        n   = pmap->Nbr - off;
+        if (n > nbr_regs - done)
+            n = nbr_regs - done;
+
+        if (pmap->PtrData != (uint16_t *)0)                 /* Straight from the application memory */
+        {
+            pval = pmap->PtrData + off;
+        }
+        else                                                /* One callback for the whole range */
+        {
+            *perr = pmap->Rd(reg, n, buf);
+            if (*perr != MODBUS_ERR_NONE)
+                return done;
+            pval = buf;
+        }
+
+        for (i = 0; i < n; i++)                             /* MSB first */
+        {
+            *presp++ = (uint8_t)(pval[i] >> 8);
+            *presp++ = (uint8_t)(pval[i] & 0x00FF);
+        }
+
+        done += n;
+        reg  += n;
+
+        if ((++pmap == pend) || (pmap->Start != reg))       /* See Note #1 */
+            break;
+    }
+
+    return done;
+}
+#endif
+
+/**************************************************************************************************
+ * function:    modbus_slave_map_write()
+ * Description: Write the registers that the map holds from 'reg' on from a request, in big endian.
+ * Argument(s): pmap        Is the map, sorted by .Start.
+ *              nbr         Number of entries of the map.
+ *              reg         Is the first register to write.
+ *              nbr_regs    Is the number of registers in the request.
+ *              prx_data    Is where the value of 'reg' is in the request.
+ *              perr        Is a pointer to an error code indicator.
+ * Return(s):   The number of registers written. 0 if 'reg' is not in the map.
+ *
+ * Caller(s):   modbus_slave_fc06_write_holding_register(),
+ *              modbus_slave_fc16_write_holding_register_multiple().
+ * Note(s):     1) Same as modbus_slave_map_read(), the write stops at the first gap.
+ *              2) Nothing is written when any range on the way is read only, *perr is then
+ *                 MODBUS_ERR_RANGE.
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_FC06_EN == 1) || (MODBUS_CFG_FC16_EN == 1)
+static uint16_t modbus_slave_map_write(const MODBUS_MAP_t *pmap, uint16_t nbr, uint16_t reg,
+                                       uint16_t nbr_regs, const uint8_t *prx_data, uint16_t *perr)
+{
+    const MODBUS_MAP_t *pend = pmap + nbr, *pfirst;
+    uint16_t           *pval;
+    uint16_t            buf[125];
+    uint16_t            done, off, n, i, r;
+
+    *perr  = MODBUS_ERR_NONE;
+    pfirst = modbus_slave_map_find(pmap, nbr, reg);
+    if (pfirst == (const MODBUS_MAP_t *)0)
+        return 0;
+
+    for (pmap = pfirst, r = reg, done = 0; ; )              /* See Note #2 */
+    {
+        if ((pmap->Flags & MODBUS_MAP_RD_ONLY) || ((pmap->PtrData == (uint16_t *)0) && (pmap->Wr == 0)))
+        {
+            *perr = MODBUS_ERR_RANGE;
+            return 0;
+        }
+
+        n = pmap->Nbr - (r - pmap->Start);
+        if (n > nbr_regs - done)
+            n = nbr_regs - done;
+        done += n;
+        r    += n;
+
+        if ((done == nbr_regs) || (++pmap == pend) || (pmap->Start != r))
+            break;
+    }
+
+    nbr_regs = done;
+
+    for (pmap = pfirst, done = 0; done < nbr_regs; pmap++)
+    {
+        off = reg - pmap->Start;
+        n   = pmap->Nbr - off;
+        if (n > nbr_regs - done)
+            n = nbr_regs - done;
+
+        pval = (pmap->PtrData != (uint16_t *)0) ? pmap->PtrData + off : buf;
+
+        for (i = 0; i < n; i++)                             /* MSB first */
+        {
+            pval[i]   = (uint16_t)(((uint16_t)prx_data[0] << 8) | prx_data[1]);
+            prx_data += 2;
+        }
+
+        if (pmap->PtrData == (uint16_t *)0)                 /* One callback for the whole range */
+        {
+            *perr = pmap->Wr(reg, n, buf);
+            if (*perr != MODBUS_ERR_NONE)
+                return done;
+        }
+
+        done += n;
+        reg  += n;
+    }
+
+    return done;
+}
+#endif
+
+#endif  // #if (MODBUS_CFG_MAP_EN == 1)
+
 /**************************************************************************************************
  * function:    modbus_slave_fcxx_handler()
  * Description: This is the main processing function for MODBUS commands. The message integrity is
@@ -496,6 +697,9 @@ static bool modbus_slave_fc03_read_holding_register(MODBUS_t *p_mb)
 {
     uint8_t *presp;
     uint16_t err, reg, nbr_regs, nbr_bytes, reg_val_16;
+#if (MODBUS_CFG_MAP_EN == 1)
+    uint16_t n;
+#endif
 #if (MODBUS_CFG_FP_EN == 1)
     uint8_t *pfp, ix;
     float    reg_val_fp;
@@ -553,6 +757,24 @@ static bool modbus_slave_fc03_read_holding_register(MODBUS_t *p_mb)
     {
         if (reg < MODBUS_CFG_FP_START_IX) 			        /* See if we want an integer register */
         {
+#if (MODBUS_CFG_MAP_EN == 1)
+            n = modbus_slave_map_read(modbus_holding_register_map, mbs_holding_map_nbr, reg, nbr_regs, presp, &err);
+            if (err != MODBUS_ERR_NONE)
+            {
+                p_mb->Err = MODBUS_ERR_FC03_01;
+                modbus_slave_set_response_error(p_mb, MODBUS_ERR_ILLEGAL_DATA_ADDR);
+                return true;
+            }
+
+            if (n > 0)                                      /* Served in bulk from the map */
+            {
+                presp    += n * sizeof(uint16_t);
+                reg      += n;
+                nbr_regs -= n;
+                continue;
+            }
+#endif
+
             reg_val_16 = modbus_read_holding_register(reg, &err);       /* Yes, get its value */
 
             switch (err)
@@ -630,6 +852,9 @@ static bool modbus_slave_fc04_read_in_register(MODBUS_t *p_mb)
 {
     uint8_t *presp;
     uint16_t err, reg, nbr_regs, nbr_bytes, reg_val_16;
+#if (MODBUS_CFG_MAP_EN == 1)
+    uint16_t n;
+#endif
 #if (MODBUS_CFG_FP_EN == 1)
     uint8_t *pfp, ix;
     float    reg_val_fp;
@@ -686,6 +911,24 @@ static bool modbus_slave_fc04_read_in_register(MODBUS_t *p_mb)
     {
         if (reg < MODBUS_CFG_FP_START_IX)                   /* See if we want an integer register */
         {
+#if (MODBUS_CFG_MAP_EN == 1)
+            n = modbus_slave_map_read(modbus_in_register_map, mbs_in_map_nbr, reg, nbr_regs, presp, &err);
+            if (err != MODBUS_ERR_NONE)
+            {
+                p_mb->Err = MODBUS_ERR_FC04_01;
+                modbus_slave_set_response_error(p_mb, MODBUS_ERR_ILLEGAL_DATA_ADDR);
+                return true;
+            }
+
+            if (n > 0)                                      /* Served in bulk from the map */
+            {
+                presp    += n * sizeof(uint16_t);
+                reg      += n;
+                nbr_regs -= n;
+                continue;
+            }
+#endif
+
             reg_val_16 = modbus_read_in_register(reg, &err);            /* Yes, get its value */
             switch (err)
             {
@@ -860,8 +1103,14 @@ static bool modbus_slave_fc06_write_holding_register(MODBUS_t *p_mb)
 #if (MODBUS_CFG_FP_EN == 1)
     if (reg < MODBUS_CFG_FP_START_IX)
     {
-        reg_val_16 = MBS_RX_DATA_REG;
-        modbus_write_holding_register(reg, reg_val_16, &err); /* Write to integer register */
+#if (MODBUS_CFG_MAP_EN == 1)
+        if (modbus_slave_map_write(modbus_holding_register_map, mbs_holding_map_nbr,
+                                   reg, 1, &p_mb->RxFrameData[4], &err) == 0 && err == MODBUS_ERR_NONE)
+#endif
+        {
+            reg_val_16 = MBS_RX_DATA_REG;
+            modbus_write_holding_register(reg, reg_val_16, &err); /* Write to integer register */
+        }
     }
     else
     {
@@ -873,8 +1122,14 @@ static bool modbus_slave_fc06_write_holding_register(MODBUS_t *p_mb)
         modbus_write_holding_register_float(reg, reg_val_fp, &err); /* Write to floating point register */
     }
 #else
-    reg_val_16 = MBS_RX_DATA_REG;
-    modbus_write_holding_register(reg, reg_val_16, &err);           /* Write to integer register */
+#if (MODBUS_CFG_MAP_EN == 1)
+    if (modbus_slave_map_write(modbus_holding_register_map, mbs_holding_map_nbr,
+                               reg, 1, &p_mb->RxFrameData[4], &err) == 0 && err == MODBUS_ERR_NONE)
+#endif
+    {
+        reg_val_16 = MBS_RX_DATA_REG;
+        modbus_write_holding_register(reg, reg_val_16, &err);       /* Write to integer register */
+    }
 
 #endif
 
@@ -1133,6 +1388,9 @@ static bool modbus_slave_fc16_write_holding_register_multiple(MODBUS_t *p_mb)
 {
     uint8_t *prx_data, data_size;
     uint16_t err, reg, reg_val_16, nbr_regs, nbr_bytes;
+#if (MODBUS_CFG_MAP_EN == 1)
+    uint16_t n;
+#endif
 #if (MODBUS_CFG_FP_EN == 1)
     uint8_t *pfp, i;
     float    reg_val_fp;
@@ -1196,6 +1454,29 @@ static bool modbus_slave_fc16_write_holding_register_multiple(MODBUS_t *p_mb)
 
     while (nbr_regs > 0)
     {
+#if (MODBUS_CFG_MAP_EN == 1)
+        if (reg < MODBUS_CFG_FP_START_IX)
+        {
+            n = modbus_slave_map_write(modbus_holding_register_map, mbs_holding_map_nbr,
+                                       reg, nbr_regs, prx_data, &err);
+            if (n > 0 || err != MODBUS_ERR_NONE)            /* Written in bulk through the map */
+            {
+                if (err != MODBUS_ERR_NONE)
+                {
+                    p_mb->Err = MODBUS_ERR_FC16_03;
+                    modbus_slave_set_response_error(p_mb, MODBUS_ERR_ILLEGAL_DATA_ADDR);
+                    return true;
+                }
+
+                p_mb->WrCtr += n;
+                prx_data    += n * sizeof(uint16_t);
+                reg         += n;
+                nbr_regs    -= n;
+                continue;
+            }
+        }
+
+#endif
 #if (MODBUS_CFG_FP_EN == 1)
         if (reg < MODBUS_CFG_FP_START_IX)
         {
@@ -1504,6 +1785,53 @@ void modbus_slave_stat_init(MODBUS_t *p_mb)
 }
 #endif
 
+/**************************************************************************************************
+ * function:    modbus_slave_map_init()
+ * Description: Check the register maps of the application.
+ * Argument(s): none.
+ * Return(s):   none.
+ *
+ * Caller(s):   modbus_init().
+ * Note(s):     1) An entry must have registers, a way to be read, and lie below MODBUS_CFG_FP_START_IX.
+ *                 The entries must be sorted by .Start and must not overlap.
+ **************************************************************************************************/
+
+#if (MODBUS_CFG_MAP_EN == 1)
+static uint16_t modbus_slave_map_check(const MODBUS_MAP_t *pmap, uint16_t nbr, const char *name)
+{
+    uint16_t i;
+
+    (void)name;                                         /* Only printed with MODBUS_DEBUG */
+
+    for (i = 0; i < nbr; i++)
+    {
+        if ((pmap[i].Nbr == 0) ||
+            ((uint32_t)pmap[i].Start + pmap[i].Nbr > MODBUS_CFG_FP_START_IX) ||
+            ((pmap[i].PtrData == (uint16_t *)0) && (pmap[i].Rd == 0)) ||
+            ((i > 0) && ((uint32_t)pmap[i-1].Start + pmap[i-1].Nbr > pmap[i].Start)))
+        {
+            DBGPRINT("modbus %s register map: bad entry %i, map not used.\r\n", name, i);
+            return 0;
+        }
+    }
+
+    return nbr;
+}
+
+void modbus_slave_map_init(void)
+{
+#if MBS_MAP_HOLDING_EN
+    mbs_holding_map_nbr = modbus_slave_map_check(modbus_holding_register_map,
+                                                 modbus_holding_register_map_nbr, "holding");
+#endif
+
+#if (MODBUS_CFG_FC04_EN == 1)
+    mbs_in_map_nbr = modbus_slave_map_check(modbus_in_register_map,
+                                            modbus_in_register_map_nbr, "input");
+#endif
+}
+#endif
+
 /**************************************************************************************************
  * function:    modbus_slave_rx_task()
  * Description: Handle either Modbus ASCII or Modbus RTU received packets.
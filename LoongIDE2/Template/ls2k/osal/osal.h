@@ -70,6 +70,7 @@ typedef void*   osal_sem_t;
 typedef void*   osal_mutex_t;
 typedef void*   osal_mq_t;
 typedef void*   osal_timer_t;
+typedef void*   osal_pool_t;
 
 //-----------------------------------------------------------------------------
 // Task
@@ -155,6 +156,23 @@ void osal_timer_delete(osal_timer_t timer);
 void osal_timer_start(osal_timer_t timer, uint32_t timeout_ms);
 void osal_timer_stop(osal_timer_t timer);
 
+//-----------------------------------------------------------------------------
+// Memory Pool: ̶СĶ
+//-----------------------------------------------------------------------------
+
+osal_pool_t osal_pool_create(const char *name,
+                             uint32_t obj_size,             /* С */
+                             uint32_t count);               /*  */
+
+void osal_pool_delete(osal_pool_t pool);
+
+/*
+ * get/put , ж, же.
+ * get ڳؿʱ NULL; put Ķڸóʱ -OSAL_ERR_INVAL
+ */
+void *osal_pool_get(osal_pool_t pool);
+int osal_pool_put(osal_pool_t pool, void *obj);
+
 //-----------------------------------------------------------------------------
 // Other
 //-----------------------------------------------------------------------------
@@ -179,6 +197,7 @@ void osal_free(void *ptr);
 #define STR_OSAL_CREATE_MUTEX_FAIL  "create osal mutex %s fail"
 #define STR_OSAL_CREATE_MQ_FAIL     "create osal message queue %s fail"
 #define STR_OSAL_CREATE_TIMER_FAIL  "create osal timer %s fail"
+#define STR_OSAL_CREATE_POOL_FAIL   "create osal pool %s fail"
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2021-2024 Suzhou Tiancheng Software Inc. All Rights Reserved.
+ *
+ */
+/*
+ * osal_pool.c
+ *
+ * created: 2026-10-17
+ *  author: 
+ */
+
+/*
+ *  OS , صڴ osal_malloc()/osal_free() ͷ
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "osal.h"
+
+//-----------------------------------------------------------------------------
+// Memory Pool: lock-free freelist
+//-----------------------------------------------------------------------------
+
+/*
+ * жɵ, Ӵڿжͷ 4 ֽ.
+ *
+ * free_head  32 λǰ汾,  32 λ׸ж+1 (0: ؿ),
+ * get/put  CAS  free_head, ÿθ°汾ż 1,  ABA.
+ */
+struct osal_pool
+{
+    volatile uint64_t free_head;
+    unsigned char    *objs;
+    uint32_t          obj_size;
+    uint32_t          count;
+    const char       *name;
+};
+
+#define POOL_OBJ(pool, i)   ((pool)->objs + (size_t)(i) * (pool)->obj_size)
+
+osal_pool_t osal_pool_create(const char *name, uint32_t obj_size, uint32_t count)
+{
+    struct osal_pool *pool;
+    uint32_t i;
+
+    if ((obj_size == 0) || (count == 0))
+    {
+        return NULL;
+    }
+
+    obj_size = (obj_size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+
+    pool = (struct osal_pool *)osal_malloc(sizeof(struct osal_pool) + (size_t)obj_size * count);
+    if (pool == NULL)
+    {
+        LOG_ERR(STR_OSAL_CREATE_POOL_FAIL "\r\n", name);
+        return NULL;
+    }
+
+    pool->objs     = (unsigned char *)pool + sizeof(struct osal_pool);
+    pool->obj_size = obj_size;
+    pool->count    = count;
+    pool->name     = name;
+
+    for (i=0; i<count; i++)
+    {
+        *(uint32_t *)POOL_OBJ(pool, i) = (i + 1 < count) ? i + 2 : 0;
+    }
+
+    pool->free_head = 1;
+
+    return (osal_pool_t)pool;
+}
+
+void osal_pool_delete(osal_pool_t pool)
+{
+    osal_free(pool);
+}
+
+void *osal_pool_get(osal_pool_t pool)
+{
+    struct osal_pool *p_pool = (struct osal_pool *)pool;
+    uint64_t old_head, new_head;
+    uint32_t index;
+
+    if (p_pool == NULL)
+    {
+        return NULL;
+    }
+
+    old_head = __atomic_load_n(&p_pool->free_head, __ATOMIC_ACQUIRE);
+
+    do
+    {
+        index = (uint32_t)old_head;
+        if (index == 0)
+        {
+            return NULL;
+        }
+
+        new_head = ((old_head >> 32) + 1) << 32;
+        new_head |= *(volatile uint32_t *)POOL_OBJ(p_pool, index - 1);
+
+    } while (!__atomic_compare_exchange_n(&p_pool->free_head, &old_head, new_head,
+                                          true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    return POOL_OBJ(p_pool, index - 1);
+}
+
+int osal_pool_put(osal_pool_t pool, void *obj)
+{
+    struct osal_pool *p_pool = (struct osal_pool *)pool;
+    uint64_t old_head, new_head;
+    size_t offset;
+
+    if ((p_pool == NULL) || ((unsigned char *)obj < p_pool->objs))
+    {
+        return -OSAL_ERR_INVAL;
+    }
+
+    offset = (unsigned char *)obj - p_pool->objs;
+    if ((offset % p_pool->obj_size) || (offset / p_pool->obj_size >= p_pool->count))
+    {
+        return -OSAL_ERR_INVAL;
+    }
+
+    old_head = __atomic_load_n(&p_pool->free_head, __ATOMIC_ACQUIRE);
+
+    do
+    {
+        *(volatile uint32_t *)obj = (uint32_t)old_head;
+
+        new_head = ((old_head >> 32) + 1) << 32;
+        new_head |= offset / p_pool->obj_size + 1;
+
+    } while (!__atomic_compare_exchange_n(&p_pool->free_head, &old_head, new_head,
+                                          true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+/*
+ * @@END
+ */
@@ -138,6 +138,7 @@ extern unsigned apb_frequency;
 
 #if BSP_USE_GMAC
 #define USE_LWIP        1
+#define GMAC_RX_DESC_NUM    32          /* rx descriptors of each GMAC */
 #endif
 
 /**
@@ -185,6 +186,13 @@ extern unsigned apb_frequency;
 
 #define BSP_USE_EMMC    0
 
+#else
+
+/*
+ * Heap of memory_man.c: 1 = TLSF, 0 = first-fit
+ */
+#define HEAP_USE_TLSF   1
+
 #endif // #if BSP_USE_FS
 
 /*
@@ -73,6 +73,11 @@ int main(void)
     printk("Hello world!\r\n");
     printk("Welcome to Loongson 2K300!\r\n\r\n");
 
+    /*
+     * printk() ɵȼ, ڵеȴ
+     */
+    printk_start_drain_task();
+
     #if USE_DEMO1
     {
         m_demo1_task = osal_task_create("demotask1",
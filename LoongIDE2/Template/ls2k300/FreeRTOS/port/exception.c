@@ -17,6 +17,7 @@
 #include "ls2k300_irq.h"
 
 extern void printk(const char *fmt, ...);
+extern void printk_flush(void);
 
 //-------------------------------------------------------------------------------------------------
 
@@ -370,6 +371,11 @@ void dump_exception_info_then_dead(int vector, uint64_t *stack)
 
     loongarch_interrupt_disable();
 
+    /*
+     *  printk лû, ֮ printk ֱ
+     */
+    printk_flush();
+
     subcode = (unsigned int)stack[R_ESTAT];
     subcode &= CSR_ESTAT_ESUBCODE_MASK;
     subcode >>= CSR_ESTAT_ESUBCODE_SHIFT;
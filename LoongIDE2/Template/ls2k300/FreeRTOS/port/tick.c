@@ -31,7 +31,7 @@ extern unsigned int cpu_frequency;              /* 
 
 static unsigned int hda_frequency;              /* delay */
 
-static unsigned int hda_1us_count = 30;         /* hda ʱ1usļֵ, Ĭֵ: delay_us */
+unsigned int hda_1us_count = 30;                /* hda ʱ1usļֵ, Ĭֵ: delay_us */
 
 static volatile uint64_t Clock_driver_ticks;    /* Clock ticks since initialization */
 
@@ -94,13 +94,13 @@ void delay_us(int us)
 {
     volatile uint64_t startVal, endVal, curVal;
 
-    asm volatile( "rdtime.d %0, $r0 ; " : "=r"(startVal) );
+    startVal = get_stable_counter();
 
     endVal = startVal + hda_1us_count * us;
     
     while (1)
     {
-        asm volatile( "rdtime.d %0, $r0 ; " : "=r"(curVal) );
+        curVal = get_stable_counter();
 
         /*
          * ֵֹ
@@ -134,6 +134,7 @@ extern unsigned apb_frequency;
 
 #if BSP_USE_GMAC
 #define USE_LWIP        1
+#define GMAC_RX_DESC_NUM    32          /* rx descriptors of each GMAC */
 #endif
 
 /**
@@ -194,6 +195,7 @@ extern unsigned apb_frequency;
 //-----------------------------------------------------------------------------
 
 extern void printk(const char *fmt, ...);
+extern int printk_start_drain_task(void);     /* printk() ɵȼ */
 
 extern void print_hex(char *p, int size);
 
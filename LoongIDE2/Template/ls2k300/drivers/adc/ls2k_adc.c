@@ -64,6 +64,16 @@ typedef struct ADC
     struct dma_chnl_cfg dma_cfg;        /* DMA  */
     volatile int dma_cb_result;         /* DMA жϻص */
 
+    /*
+     * ģʽ
+     */
+    ADC_Stream_t      stream;
+    ADC_StreamStats_t stream_stats;
+    osal_mq_t         stream_mq;        /* ûлصʱ, дİ */
+    HW_TIM_t         *hwTIM;            /* ʱ */
+    int               tim_ch;           /* ʱȽͨ */
+    int               streaming;
+
 #if ADC_USE_MUTEX
     osal_mutex_t p_mutex;
 #endif
@@ -96,6 +106,8 @@ const void *devADC = (void *)&m_adc_priv;
  */
 static unsigned int m_dma_buf[16]; 
 
+extern unsigned int apb_frequency;
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 
@@ -471,6 +483,242 @@ static int ls2k_adc_get_inject_result(ADC_t *pADC, int *param)
     return -1;
 }
 
+//-----------------------------------------------------------------------------
+// ģʽ
+//-----------------------------------------------------------------------------
+
+/*
+ * DMA ѭģʽ: жϽǰ, жϽ
+ */
+static void ls2k_adc_stream_deliver(ADC_t *pADC, unsigned int *half)
+{
+    int count = pADC->stream.BufferSize / 2;
+
+    clean_dcache_nowrite((unsigned long)half, count * sizeof(int));
+
+    pADC->stream_stats.halves++;
+
+    if (pADC->stream.Callback)
+    {
+        pADC->stream.Callback(half, count, pADC->stream.CallbackArg);
+    }
+    else
+    {
+        unsigned long msg = (unsigned long)half;
+
+        if (osal_mq_send(pADC->stream_mq, &msg, sizeof(msg)) != 0)
+            pADC->stream_stats.overruns++;
+    }
+}
+
+static void ls2k_adc_stream_dma_callback(struct dma_chnl_cfg *cfg, int bytes, unsigned int status)
+{
+    ADC_t *pADC = &m_adc_priv;
+
+    if (status & DMA_SR_ERROR)
+    {
+        pADC->stream_stats.dma_errors++;
+        return;
+    }
+
+    if (status & DMA_SR_HALF)
+        ls2k_adc_stream_deliver(pADC, pADC->stream.Buffer);
+
+    if (status & DMA_SR_DONE)
+        ls2k_adc_stream_deliver(pADC, pADC->stream.Buffer + pADC->stream.BufferSize / 2);
+}
+
+/*
+ * ôʱ: ͨ ch  PWM ģʽ, ÿڲһ CCx ¼
+ */
+static int ls2k_adc_stream_set_timer(ADC_t *pADC, int trig, unsigned int rate)
+{
+    HW_TIM_t *hwTIM;
+    unsigned int cycles, psc, arr;
+    int ch;
+
+    switch (trig)
+    {
+        case ADC_TRIG_ATIM_CC1: ch = 1; break;
+        case ADC_TRIG_ATIM_CC2: ch = 2; break;
+        case ADC_TRIG_ATIM_CC3: ch = 3; break;
+        case ADC_TRIG_GTIM_CC2: ch = 2; break;
+        default:                return -1;
+    }
+
+    if ((rate == 0) || ((cycles = apb_frequency / rate) < 2))
+        return -1;
+
+    if (trig == ADC_TRIG_GTIM_CC2)
+    {
+        hwTIM = (HW_TIM_t *)PHYS_TO_UNCACHED(GTIM_BASE);
+        OR_REG32(CHIP_CTRL6_BASE, CTRL6_GTIMER_CLK_CTRL);
+    }
+    else
+    {
+        hwTIM = (HW_TIM_t *)PHYS_TO_UNCACHED(ATIM_BASE);
+        OR_REG32(CHIP_CTRL5_BASE, CTRL5_ATIMER_CLK_CTRL);
+    }
+
+    /*
+     * ARR  16 λ, ʱԤƵ
+     */
+    psc = (cycles - 1) >> 16;
+    arr = cycles / (psc + 1) - 1;
+
+    hwTIM->cr1 = 0;
+    hwTIM->psc = psc;
+    hwTIM->arr = arr;
+
+    tim_set_pwm_channel(hwTIM, ch, (arr + 1) / 2);
+
+    if (trig != ADC_TRIG_GTIM_CC2)
+        hwTIM->bdtr |= TIM_BDTR_MOE;    /* ATIM ıȽҪ MOE */
+
+    hwTIM->egr = TIM_EGR_UG;
+
+    pADC->hwTIM  = hwTIM;
+    pADC->tim_ch = ch;
+
+    return 0;
+}
+
+static void ls2k_adc_stream_stop_timer(ADC_t *pADC)
+{
+    if (pADC->hwTIM)
+    {
+        pADC->hwTIM->cr1 &= ~TIM_CR1_CEN;
+        pADC->hwTIM->ccer &= ~TIM_CCER_CCE(pADC->tim_ch);
+        pADC->hwTIM = NULL;
+    }
+}
+
+/*
+ * ʼģʽ. ʱͨת, ÿδתȫͨ
+ */
+static int ls2k_adc_stream_start(ADC_t *pADC, ADC_Stream_t *stream)
+{
+    struct dma_chnl_cfg *cfg = &pADC->dma_cfg;
+    int channelcount = pADC->mode.RegularChannelCount;
+    unsigned int cr2, extsel;
+
+    if (!pADC->opened || pADC->streaming || !stream)
+        return -1;
+
+    /*
+     * clean_dcache_nowrite()  cache , ÿռ cache 
+     */
+    if (!stream->Buffer || ((long)stream->Buffer & (ADC_STREAM_ALIGN - 1)) ||
+        (stream->BufferSize <= 0) || (stream->BufferSize % (channelcount * 2) != 0) ||
+        ((stream->BufferSize / 2 * sizeof(int)) % ADC_STREAM_ALIGN != 0))
+        return -1;
+
+    switch (stream->TrigSrc)
+    {
+        case ADC_TRIG_ATIM_CC1: extsel = ADC_CR2_EXTSEL_ATIM_CC1; break;
+        case ADC_TRIG_ATIM_CC2: extsel = ADC_CR2_EXTSEL_ATIM_CC2; break;
+        case ADC_TRIG_ATIM_CC3: extsel = ADC_CR2_EXTSEL_ATIM_CC3; break;
+        case ADC_TRIG_GTIM_CC2: extsel = ADC_CR2_EXTSEL_GTIM_CC2; break;
+        default:                return -1;
+    }
+
+    if (!stream->Callback)
+    {
+        if (!pADC->stream_mq)
+        {
+            pADC->stream_mq = osal_mq_create("adcstream", OSAL_OPT_FIFO, sizeof(unsigned long), 2);
+            if (!pADC->stream_mq)
+                return -1;
+        }
+
+        osal_mq_flush(pADC->stream_mq);
+    }
+
+    if (ls2k_adc_stream_set_timer(pADC, stream->TrigSrc, stream->SampleRate) != 0)
+        return -1;
+
+    pADC->stream = *stream;
+    memset(&pADC->stream_stats, 0, sizeof(ADC_StreamStats_t));
+
+    /*
+     * ͷŵתõ DMA ͨ, Ϊ ping-pong 
+     */
+    if (cfg->chNum >= 0)
+    {
+        ls2k_dma_close(NULL, (void *)(long)cfg->chNum);
+        cfg->chNum = -1;
+    }
+
+    if (ls2k_adc_set_dma_transfer(pADC, channelcount) != 0)
+    {
+        ls2k_adc_stream_stop_timer(pADC);
+        return -1;
+    }
+
+    cfg->memAddr    = (unsigned long)stream->Buffer;
+    cfg->transbytes = stream->BufferSize * sizeof(int);
+    cfg->cb         = ls2k_adc_stream_dma_callback;
+    cfg->ccr.htie   = 1;
+
+    clean_dcache_nowrite((unsigned long)stream->Buffer, cfg->transbytes);
+
+    /*
+     * ⲿ, ÿδת channelcount ͨ
+     */
+    cr2  = pADC->hwADC->cr2;
+    cr2 &= ~(ADC_CR2_EXTSEL_MASK | ADC_CR2_CONT);
+    cr2 |= extsel | ADC_CR2_EXTTRIG | ADC_CR2_DMA | ADC_CR2_ADON;
+    pADC->hwADC->cr2 = cr2;
+
+    adc_set_discnum(pADC->hwADC, channelcount, 0);
+
+    if (dma_start(cfg, 0) != 0)
+    {
+        ls2k_adc_stream_stop_timer(pADC);
+        return -1;
+    }
+
+    pADC->streaming = 1;
+
+    pADC->hwTIM->cr1 = TIM_CR1_ARPE | TIM_CR1_CEN;
+
+    return 0;
+}
+
+/*
+ * ֹͣģʽ, ָ IOCTL_ADC_SET_MODE 
+ */
+static int ls2k_adc_stream_stop(ADC_t *pADC)
+{
+    ADC_Mode_t mode;
+
+    if (!pADC->streaming)
+        return 0;
+
+    ls2k_adc_stream_stop_timer(pADC);
+
+    pADC->hwADC->cr2 &= ~(ADC_CR2_EXTTRIG | ADC_CR2_DMA);
+
+    ls2k_dma_close(NULL, (void *)(long)pADC->dma_cfg.chNum);
+    pADC->dma_cfg.chNum = -1;
+
+    pADC->streaming = 0;
+
+    mode = pADC->mode;
+    if (ls2k_adc_set_mode(pADC, &mode) != 0)
+        return -1;
+
+    if (pADC->opened)
+    {
+        if ((pADC->mode.RegularChannelCount > 1) && (dma_start(&pADC->dma_cfg, 0) != 0))
+            return -1;
+
+        pADC->hwADC->cr2 |= ADC_CR2_ADON;
+    }
+
+    return 0;
+}
+
 /******************************************************************************
  * initialize the device
  */
@@ -590,6 +838,7 @@ STATIC_DRV int ADC_close(const void *dev, void *arg)
 	ADC_t *pADC = &m_adc_priv;
     
     LOCK();
+    ls2k_adc_stream_stop(pADC);
     pADC->hwADC->cr2 &= ~ADC_CR2_ADON;
     
     /*
@@ -622,7 +871,7 @@ STATIC_DRV int ADC_read(const void *dev, void *buf, int size, void *arg)
     int vchnl = (long)arg;
     int channelcount;
 
-    if (!pADC->opened)
+    if (!pADC->opened || pADC->streaming)
         return -1;
 
     if (!buf || ((long)buf & 0x3))
@@ -756,6 +1005,25 @@ STATIC_DRV int ADC_ioctl(const void *dev, int cmd, void *arg)
         case IOCTL_ADC_GET_JRESULT:
             ret = ls2k_adc_get_inject_result(pADC, (int *)arg);
             break;
+
+        case IOCTL_ADC_STREAM_START:
+            LOCK();
+            ret = ls2k_adc_stream_start(pADC, (ADC_Stream_t *)arg);
+            UNLOCK();
+            break;
+
+        case IOCTL_ADC_STREAM_STOP:
+            LOCK();
+            ret = ls2k_adc_stream_stop(pADC);
+            UNLOCK();
+            break;
+
+        case IOCTL_ADC_STREAM_STATS:
+            if (arg)
+                *(ADC_StreamStats_t *)arg = pADC->stream_stats;
+            else
+                ret = -1;
+            break;
             
         default:
             ret = -1;
@@ -806,6 +1074,25 @@ int adc_read_1(int channel)
     return -1;
 }
 
+/*
+ * ģʽ, ȴһдİ
+ */
+int ls2k_adc_stream_read(const unsigned int **samples, unsigned int timeout_ms)
+{
+    ADC_t *pADC = &m_adc_priv;
+    unsigned long msg;
+
+    if (!samples || !pADC->streaming || pADC->stream.Callback)
+        return -1;
+
+    if (osal_mq_receive(pADC->stream_mq, &msg, sizeof(msg), timeout_ms) != sizeof(msg))
+        return 0;
+
+    *samples = (const unsigned int *)msg;
+
+    return pADC->stream.BufferSize / 2;
+}
+
 #endif // #if BSP_USE_ADC
 
 //-----------------------------------------------------------------------------
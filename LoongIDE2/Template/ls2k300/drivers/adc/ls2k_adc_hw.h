@@ -680,6 +680,65 @@ static inline int adc_get_jsq_result(HW_ADC_t *hwADC, int rank)
 	return ret;
 }
 
+//-------------------------------------------------------------------------------------------------
+// ADC ʱ. ģʽ ATIM/GTIM ıȽ¼ CCx ͨת
+//-------------------------------------------------------------------------------------------------
+
+#define ATIM_BASE       0x16118000
+#define GTIM_BASE       0x16119000
+
+/*
+ * ATIM/GTIM ʱ, ֻõ PWM Ƚϲ
+ */
+typedef struct
+{
+	volatile unsigned int cr1;			/* 0x00 32 ƼĴ1 */
+	volatile unsigned int cr2;			/* 0x04 32 ƼĴ2 */
+	volatile unsigned int smcr;			/* 0x08 32 ģʽƼĴ */
+	volatile unsigned int dier;			/* 0x0C 32 DMA/жʹܼĴ */
+	volatile unsigned int sr;			/* 0x10 32 ״̬Ĵ */
+	volatile unsigned int egr;			/* 0x14 32 ¼Ĵ */
+	volatile unsigned int ccmr1;		/* 0x18 32 /ȽģʽĴ1 */
+	volatile unsigned int ccmr2;		/* 0x1C 32 /ȽģʽĴ2 */
+	volatile unsigned int ccer;			/* 0x20 32 /ȽʹܼĴ */
+	volatile unsigned int cnt;			/* 0x24 32  */
+	volatile unsigned int psc;			/* 0x28 32 ԤƵ */
+	volatile unsigned int arr;			/* 0x2C 32 ԶװؼĴ */
+	volatile unsigned int rcr;			/* 0x30 32 ظĴ, ATIM */
+	volatile unsigned int ccr[4];		/* 0x34~0x40 32 /ȽϼĴ1~4 */
+	volatile unsigned int bdtr;			/* 0x44 32 ɲĴ, ATIM */
+} HW_TIM_t;
+
+#define TIM_CR1_ARPE			bit(7)			/* RW ԶװԤװ */
+#define TIM_CR1_CEN				bit(0)			/* RW ʹ */
+
+#define TIM_EGR_UG				bit(0)			/* W  ¼, װ PSC/ARR */
+
+#define TIM_CCMR_OCM_MASK		0x70			/* RW Ƚģʽ, ͨ 1/3  bit[6:4], ͨ 2/4  bit[14:12] */
+#define TIM_CCMR_OCM_PWM1		0x60			/*    110: PWM ģʽ1 */
+#define TIM_CCMR_OCPE			0x08			/* RW ȽԤװʹ */
+
+#define TIM_CCER_CCE(n)			bit(((n)-1)*4)	/* RW Ƚͨ n ʹ, n=1~4 */
+
+#define TIM_BDTR_MOE			bit(15)			/* RW ʹ, ATIM */
+
+/*
+ * öʱͨ ch  PWM ģʽ. ch  1 ʼ
+ */
+static inline void tim_set_pwm_channel(HW_TIM_t *hwTIM, int ch, unsigned int pulse)
+{
+	volatile unsigned int *ccmr = (ch <= 2) ? &hwTIM->ccmr1 : &hwTIM->ccmr2;
+	int shift = (ch & 1) ? 0 : 8;
+	unsigned int val;
+
+	val  = *ccmr & ~((TIM_CCMR_OCM_MASK | TIM_CCMR_OCPE | 0x03) << shift);
+	val |= (TIM_CCMR_OCM_PWM1 | TIM_CCMR_OCPE) << shift;
+	*ccmr = val;
+
+	hwTIM->ccr[ch-1] = pulse;
+	hwTIM->ccer |= TIM_CCER_CCE(ch);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include <errno.h>
+#include <larchintrin.h>
 
 #include "cpu.h"
 #include "ls2k300.h"
@@ -30,6 +31,13 @@
 
 #include "ls2k_can.h"
 #include "ls2k_can_hw.h"
+#include "ls2k_trace.h"
+
+#if CAN_USE_DMA
+#include "ls2k_dma.h"
+
+extern void *aligned_malloc(size_t size, unsigned int align);
+#endif
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -79,6 +87,17 @@ typedef struct
 #define RX_FIFO_LEN		64
 #define TX_FIFO_LEN		64
 
+#if CAN_USE_DMA
+/*
+ * DMA ѭջ, 32 λ. /ʱжһ, ÿ
+ * 512 , ̵ CAN2.0 (T0+T1+2)Ϊ 128 .
+ */
+#define CAN_DMA_WORDS   1024
+#define CAN_DMA_MASK    (CAN_DMA_WORDS - 1)
+#define RX_FIFO_LEN_DMA 256
+#define CAN_DMA_POLL_MS 2           /* CAN_read() ȴʱ */
+#endif
+
 typedef struct
 {
 	int			count;
@@ -109,6 +128,10 @@ typedef struct CAN
 	unsigned int	workmode;
 	unsigned int	baudrate; 			/* Baudrate in HZ */
 	CAN_speed_t     speed;              /* Calculate from Baudrate */
+#if CAN_USE_FD
+	unsigned int	fd_baudrate; 		/* CAN-FD data phase Baudrate */
+	CAN_speed_t     fd_speed;           /* Calculate from fd_baudrate */
+#endif
     CAN_filter_t    filter;
     CAN_range_t     range;
     int             re_tx_threshold;    /* set.CAN_SET_RTXTH */
@@ -127,6 +150,27 @@ typedef struct CAN
 	CAN_fifo_t		*rxfifo;
 	CAN_fifo_t		*txfifo;
 
+#if CAN_USE_DMA
+    /*
+     * rx with DMA
+     */
+    struct dma_chnl_cfg rx_dma_cfg;     /* DMA  */
+    int             rx_chnl;            /* DMA ͨ, -1: û */
+    unsigned int   *dma_rxbuf;          /* ѭջ */
+    unsigned int    dma_rx_rpos;        /* Ѿλ, , ۼֵ */
+    unsigned int    dma_rx_halves;      /* /жϴ, ÿ DMA д */
+    int             dma_active;         /* 1: ʹ DMA  */
+#endif
+
+    /*
+     * capture ring: жд, һȡ
+     */
+    CANCapture_t   *cap_ring;           /* ṩ, NULL: ʹ */
+    unsigned int    cap_mask;
+    volatile unsigned int cap_head;
+    volatile unsigned int cap_tail;
+    unsigned int    cap_ts;             /* һĵ 32 λʱ */
+
     /*
      * run-time info
      */
@@ -331,6 +375,37 @@ static CANMsg_t *can_fifo_claim_get(CAN_fifo_t *fifo)
 	return fifo->tail;
 }
 
+/* Get contiguous messages, at most max. return count
+ */
+static int can_fifo_claim_get_n(CAN_fifo_t *fifo, CANMsg_t **msgs, int max)
+{
+    int n;
+
+	if (can_fifo_empty(fifo))
+	{
+    	return 0;
+    }
+
+    if (fifo->head > fifo->tail)
+        n = fifo->head - fifo->tail;
+    else                                /* wrap around, till the end */
+        n = &fifo->base[fifo->count] - fifo->tail;
+
+    *msgs = fifo->tail;
+	return (n < max) ? n : max;
+}
+
+static void can_fifo_get_n(CAN_fifo_t *fifo, int n)
+{
+	fifo->tail += n;
+	if (fifo->tail >= &fifo->base[fifo->count])
+	{
+    	fifo->tail -= fifo->count;
+    }
+
+	fifo->full = 0;
+}
+
 static void can_fifo_clear(CAN_fifo_t *fifo)
 {
 	fifo->full = 0;
@@ -342,6 +417,50 @@ static void can_fifo_clear(CAN_fifo_t *fifo)
  * CAN functions
  ******************************************************************************/
 
+#if CAN_USE_FD
+/*
+ * CAN-FD DLC 9~15 Ӧݳ
+ */
+static const unsigned char can_fd_dlc2len[16] =
+{
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64
+};
+
+static inline int can_dlc_to_len(int dlc, int fdf)
+{
+    if (!fdf)
+        return (dlc <= 8) ? dlc : 8;
+
+    return can_fd_dlc2len[dlc & 0x0F];
+}
+
+/*
+ * ȡ DLC, ʱ㲿ֲ 0
+ */
+static inline int can_len_to_dlc(int len, int fdf)
+{
+    int dlc;
+
+    if (len <= 8)
+        return (len > 0) ? len : 0;
+
+    if (!fdf)
+        return 8;
+
+    for (dlc=9; dlc<15; dlc++)
+    {
+        if (can_fd_dlc2len[dlc] >= len)
+            break;
+    }
+
+    return dlc;
+}
+
+#else
+#define can_dlc_to_len(dlc, fdf)    (((dlc) <= 8) ? (dlc) : 8)
+#define can_len_to_dlc(len, fdf)    (((len) <= 8) ? (len) : 8)
+#endif
+
 /* This function calculates BTR0 and BTR1 values for a given bitrate.
  *
  * Set communication parameters.
@@ -380,7 +499,7 @@ static void can_fifo_clear(CAN_fifo_t *fifo)
 #define SJW_MIN     0x1
 #define SJW_MAX     0x1F
 
-static int ls2k_can_calc_bittiming(CAN_t *pCAN, int baudrate, CAN_speed_t *result)
+static int ls2k_can_calc_bittiming(CAN_t *pCAN, int baudrate, int data_phase, CAN_speed_t *result)
 {
 	int error=0, best_error = 2000000000;
 	int nbt=0, best_nbt=0, brp=0, best_brp=0;
@@ -390,6 +509,14 @@ static int ls2k_can_calc_bittiming(CAN_t *pCAN, int baudrate, CAN_speed_t *resul
     /*
      * Baudrate limits
      */
+#if CAN_USE_FD
+    if (data_phase)
+    {
+        if (baudrate > CAN_SPEED_10M)
+            baudrate = CAN_SPEED_10M;
+    }
+    else
+#endif
     {
         if (baudrate > CAN_SPEED_1M)
             baudrate = CAN_SPEED_1M;
@@ -439,6 +566,8 @@ static int ls2k_can_calc_bittiming(CAN_t *pCAN, int baudrate, CAN_speed_t *resul
 
     /*
      * εӳʱ tPTS = 500ns
+     *
+     * ݶεշӳɵڶ㲹, ȡСֵ
      */
     if (result)
         tPTS = (int)result->tPTS;
@@ -448,7 +577,7 @@ static int ls2k_can_calc_bittiming(CAN_t *pCAN, int baudrate, CAN_speed_t *resul
     tmp = (tPTS * 100) / (1000000000 / baudrate);
     if (tmp > 30)
         tmp = 30;                   /* Total percent max 30% */
-    prop = best_nbt * tmp / 100;
+    prop = data_phase ? PROP_MIN : best_nbt * tmp / 100;
 
     if (best_nbt - prop < SYNC_SEG + PH1_MIN + PH2_MIN)
         prop = best_nbt - (SYNC_SEG + PH1_MIN + PH2_MIN);
@@ -460,7 +589,7 @@ static int ls2k_can_calc_bittiming(CAN_t *pCAN, int baudrate, CAN_speed_t *resul
     /*
      * 
      */
-    sampl_pt = pCAN->speed.Sample_pt;
+    sampl_pt = result ? result->Sample_pt : pCAN->speed.Sample_pt;
     if (0 == sampl_pt)
     {
         sampl_pt = 75;
@@ -528,7 +657,7 @@ static int ls2k_can_set_baudrate(CAN_t *pCAN, int baudrate)
     if (pCAN->baudrate == baudrate)
         return 0;
 
-    int rt = ls2k_can_calc_bittiming(pCAN, baudrate, &pCAN->speed);
+    int rt = ls2k_can_calc_bittiming(pCAN, baudrate, 0, &pCAN->speed);
 
     if (0 == rt)
     {
@@ -539,6 +668,64 @@ static int ls2k_can_set_baudrate(CAN_t *pCAN, int baudrate)
     return rt;
 }
 
+#if CAN_USE_FD
+/*
+ * CAN-FD ݶ,  brs=1 ʱʹ
+ */
+static int ls2k_can_set_fd_baudrate(CAN_t *pCAN, int baudrate)
+{
+    if (pCAN->fd_baudrate == baudrate)
+        return 0;
+
+    int rt = ls2k_can_calc_bittiming(pCAN, baudrate, 1, &pCAN->fd_speed);
+
+    if (0 == rt)
+    {
+        pCAN->fd_baudrate = baudrate;
+        pCAN->config_update = 1;
+    }
+
+    return rt;
+}
+#endif
+
+/*
+ *  filter/range  fltctrl. CANFD ģʽͬʱ CANFD  CAN2.0 
+ */
+static void ls2k_can_update_fltctrl(CAN_t *pCAN)
+{
+    static const unsigned int flt_bits[3][4] =
+    {
+        /* NE, NB, FE, FB */
+        { CAN_FCTRL_FA_NE, CAN_FCTRL_FA_NB, CAN_FCTRL_FA_FE, CAN_FCTRL_FA_FB },
+        { CAN_FCTRL_FB_NE, CAN_FCTRL_FB_NB, CAN_FCTRL_FB_FE, CAN_FCTRL_FB_FB },
+        { CAN_FCTRL_FC_NE, CAN_FCTRL_FC_NB, CAN_FCTRL_FC_FE, CAN_FCTRL_FC_FB },
+    };
+    int i, fd = pCAN->r_mode & CAN_MODE_FDE;
+    unsigned int ctrl = 0;
+
+    for (i=0; i<3; i++)
+    {
+        if (pCAN->filter.filter[i] & CAN_FILTER_STD)
+            ctrl |= flt_bits[i][0] | (fd ? flt_bits[i][2] : 0);
+        if (pCAN->filter.filter[i] & CAN_FILTER_EXT)
+            ctrl |= flt_bits[i][1] | (fd ? flt_bits[i][3] : 0);
+    }
+
+    if (pCAN->range.enable & CAN_RANGE_STD)
+        ctrl |= CAN_FCTRL_FR_NE | (fd ? CAN_FCTRL_FR_FE : 0);
+    if (pCAN->range.enable & CAN_RANGE_EXT)
+        ctrl |= CAN_FCTRL_FR_NB | (fd ? CAN_FCTRL_FR_FB : 0);
+
+    pCAN->r_fltctrl = (pCAN->r_fltctrl & ~0xFFFF) | ctrl;
+
+    if (pCAN->filter.filter[0] || pCAN->filter.filter[1] ||
+        pCAN->filter.filter[2] || pCAN->range.enable)
+        pCAN->r_mode |= CAN_MODE_AFM;
+    else
+        pCAN->r_mode &= ~CAN_MODE_AFM;
+}
+
 static int ls2k_can_set_workmode(CAN_t *pCAN, unsigned int mode)
 {
     if (pCAN->workmode == mode)
@@ -562,6 +749,10 @@ static int ls2k_can_set_workmode(CAN_t *pCAN, unsigned int mode)
         pCAN->r_mode |= CAN_MODE_STM;
     if (mode & CAN_MODE_TX_TIMED)
         pCAN->r_mode |= CAN_MODE_TTTM;
+#if CAN_USE_FD
+    if (mode & CAN_MODE_FD)
+        pCAN->r_mode |= CAN_MODE_FDE;
+#endif
 
     /*
      * can.set register
@@ -573,6 +764,10 @@ static int ls2k_can_set_workmode(CAN_t *pCAN, unsigned int mode)
         pCAN->r_set |= CAN_SET_PEX;
     if (mode & CAN_MODE_LOOPBACK)
         pCAN->r_set |= CAN_SET_ILBP;
+#if CAN_USE_FD
+    if ((mode & CAN_MODE_FD) && (mode & CAN_MODE_NON_ISO))
+        pCAN->r_set |= CAN_SET_NISOFD;
+#endif
     pCAN->re_tx_threshold = mode & CAN_RE_TX_THRESH_MASK;
     if (pCAN->re_tx_threshold)
     {
@@ -585,6 +780,11 @@ static int ls2k_can_set_workmode(CAN_t *pCAN, unsigned int mode)
      */
     pCAN->r_mode |= CAN_MODE_RXBAM;     
 
+    /*
+     * filter control depends on FDE
+     */
+    ls2k_can_update_fltctrl(pCAN);
+
     pCAN->config_update = 1;
     return 0;
 }
@@ -628,46 +828,8 @@ static int ls2k_can_set_filter(CAN_t *pCAN, CAN_filter_t *filter)
         pCAN->filter.filter[1] = filter->filter[1];
         pCAN->filter.filter[2] = filter->filter[2];
         
-        pCAN->r_fltctrl &= ~0x0FFF;
-        
-        if (pCAN->r_mode & CAN_MODE_FDE)
-        {
-            if (filter->filter[0] & CAN_FILTER_STD)
-                pCAN->r_fltctrl |= CAN_FCTRL_FA_FE;
-            else if (filter->filter[0] & CAN_FILTER_EXT)
-                pCAN->r_fltctrl |= CAN_FCTRL_FA_FB;
-
-            if (filter->filter[1] & CAN_FILTER_STD)
-                pCAN->r_fltctrl |= CAN_FCTRL_FB_FE;
-            else if (filter->filter[1] & CAN_FILTER_EXT)
-                pCAN->r_fltctrl |= CAN_FCTRL_FB_FB;
-
-            if (filter->filter[2] & CAN_FILTER_STD)
-                pCAN->r_fltctrl |= CAN_FCTRL_FC_FE;
-            else if (filter->filter[2] & CAN_FILTER_EXT)
-                pCAN->r_fltctrl |= CAN_FCTRL_FC_FB;
-        }
-        else    /* CAN 2.0 */
-        {
-            if (filter->filter[0] & CAN_FILTER_STD)
-                pCAN->r_fltctrl |= CAN_FCTRL_FA_NE;
-            else if (filter->filter[0] & CAN_FILTER_EXT)
-                pCAN->r_fltctrl |= CAN_FCTRL_FA_NB;
-
-            if (filter->filter[1] & CAN_FILTER_STD)
-                pCAN->r_fltctrl |= CAN_FCTRL_FB_NE;
-            else if (filter->filter[1] & CAN_FILTER_EXT)
-                pCAN->r_fltctrl |= CAN_FCTRL_FB_NB;
-
-            if (filter->filter[2] & CAN_FILTER_STD)
-                pCAN->r_fltctrl |= CAN_FCTRL_FC_NE;
-            else if (filter->filter[2] & CAN_FILTER_EXT)
-                pCAN->r_fltctrl |= CAN_FCTRL_FC_NB;
-        }
+        ls2k_can_update_fltctrl(pCAN);
 
-        if (pCAN->filter.filter[0] || pCAN->filter.filter[1] || pCAN->filter.filter[2])
-            pCAN->r_mode |= CAN_MODE_AFM;
-        
         pCAN->config_update = 1;
     }
 
@@ -694,25 +856,7 @@ static int ls2k_can_set_range(CAN_t *pCAN, CAN_range_t *range)
         pCAN->hwCAN->fltrhi = pCAN->range.rangehi = range->rangehi;
         pCAN->range.enable  = range->enable;
 
-        pCAN->r_fltctrl &= ~0xF000;
-
-        if (pCAN->r_mode & CAN_MODE_FDE)
-        {
-            if (range->enable & CAN_RANGE_STD)
-                pCAN->r_fltctrl |= CAN_FCTRL_FR_FE;
-            else if (range->enable & CAN_RANGE_EXT)
-                pCAN->r_fltctrl |= CAN_FCTRL_FR_FB;
-        }
-        else    /* CAN 2.0 */
-        {
-            if (range->enable & CAN_RANGE_STD)
-                pCAN->r_fltctrl |= CAN_FCTRL_FR_NE;
-            else if (range->enable & CAN_RANGE_EXT)
-                pCAN->r_fltctrl |= CAN_FCTRL_FR_NB;
-        }
-
-        if (pCAN->range.enable)
-            pCAN->r_mode |= CAN_MODE_AFM;
+        ls2k_can_update_fltctrl(pCAN);
 
         pCAN->config_update = 1;
     }
@@ -732,6 +876,29 @@ static int ls2k_can_set_ts_psc(CAN_t *pCAN, unsigned int psc)
     return 0;
 }
 
+static int ls2k_can_set_capture(CAN_t *pCAN, CAN_capture_t *cap)
+{
+    if ((cap == NULL) || (cap->ring == NULL))
+    {
+        pCAN->cap_ring = NULL;
+        return 0;
+    }
+
+    if ((cap->count < 2) || (cap->count & (cap->count - 1)))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    pCAN->cap_mask = cap->count - 1;
+    pCAN->cap_head = 0;
+    pCAN->cap_tail = 0;
+    pCAN->cap_ts   = 0;
+    pCAN->cap_ring = cap->ring;
+
+    return 0;
+}
+
 static int ls2k_can_get_statics(CAN_t *pCAN, CAN_stats_t **st)
 {
     pCAN->stats.rx_errors = (pCAN->hwCAN->errcnt >> 16) & 0x1FF;
@@ -776,6 +943,11 @@ static int ls2k_can_get_status(CAN_t *pCAN, unsigned int *status)
  * CAN DMA support
  ******************************************************************************/
 
+#if CAN_USE_DMA
+static int  ls2k_can_dma_rx_start(CAN_t *pCAN);
+static void ls2k_can_dma_rx_stop(CAN_t *pCAN);
+#endif
+
 /******************************************************************************
  * CAN Hardware Operating
  ******************************************************************************/
@@ -792,7 +964,7 @@ static inline void ls2k_can_hw_reset(CAN_t *pCAN)
  */
 static int ls2k_can_hw_start(CAN_t *pCAN)
 {
-    unsigned int rv;
+    unsigned int rv, ien;
 
 	if (pCAN->opened)
         return 0;
@@ -805,6 +977,8 @@ static int ls2k_can_hw_start(CAN_t *pCAN)
 	
     memset(&pCAN->stats, 0, sizeof(CAN_stats_t));
 
+    pCAN->cap_head = pCAN->cap_tail = 0;
+
     /*
      * Set CAN.mode register
      */
@@ -824,6 +998,33 @@ static int ls2k_can_hw_start(CAN_t *pCAN)
         }
     }
 
+#if CAN_USE_FD
+    /*
+     * Set CAN.btrfd register, and second sample point for data phase
+     */
+    if ((pCAN->r_mode & CAN_MODE_FDE) && pCAN->fd_speed.btr32)
+    {
+        CAN_speed_t *fd = &pCAN->fd_speed;
+
+        pCAN->hwCAN->btrfd = fd->btr32;
+        pCAN->hwCAN->frcdiv &= ~CAN_FRC_DBT_MASK;
+        pCAN->hwCAN->frcdiv |= (fd->frac << CAN_FRC_DBT_SHIFT) & CAN_FRC_DBT_MASK;
+
+        if (pCAN->fd_baudrate > CAN_SPEED_1M)
+        {
+            unsigned int ssp_off = fd->brp * (SYNC_SEG + fd->prop + fd->ph1);
+
+            if (ssp_off > CAN_SSP_CFG_OFF_MASK)
+                ssp_off = CAN_SSP_CFG_OFF_MASK;
+            pCAN->hwCAN->sspcfg = CAN_SSP_CFG_0 | CAN_SSP_CFG_SAT | ssp_off;
+        }
+        else
+        {
+            pCAN->hwCAN->sspcfg = CAN_SSP_CFG_1;
+        }
+    }
+#endif
+
     /*
      * Set CAN.mode register
      */
@@ -847,13 +1048,28 @@ static int ls2k_can_hw_start(CAN_t *pCAN)
     pCAN->hwCAN->isr = 0x1FFF;
     pCAN->hwCAN->ien = 0x1FFF << 16;
     pCAN->hwCAN->imask = 0x1FFF << 16;
+
+    ien = 0x0EEF;
+
+#if CAN_USE_DMA
+    /*
+     * DMA ʱʹ RX ж, ʧʱʹжϽ
+     */
+    if (pCAN->workmode & CAN_MODE_RX_DMA)
+    {
+        if (ls2k_can_dma_rx_start(pCAN) == 0)
+            ien &= ~(CAN_ISR_RX | CAN_ISR_RXF | CAN_ISR_RBNE);
+        else
+            printk("%s: RX DMA start fail, use interrupt.\r\n", pCAN->dev_name);
+    }
+#endif
     
     /*
      * Enable CAN interrupt
      */
     ls2k_interrupt_enable(pCAN->irqNum);
 
-    pCAN->hwCAN->ien |= 0x0EEF;
+    pCAN->hwCAN->ien |= ien;
 
     return 0;
 }
@@ -875,6 +1091,10 @@ static void ls2k_can_hw_stop(CAN_t *pCAN)
 	 */
 	ls2k_interrupt_disable(pCAN->irqNum);
 
+#if CAN_USE_DMA
+    ls2k_can_dma_rx_stop(pCAN);
+#endif
+
     pCAN->hwCAN->set &= ~CAN_SET_ENABLE;
 
     return;
@@ -886,17 +1106,16 @@ static void ls2k_can_hw_stop(CAN_t *pCAN)
  */
 static int ls2k_can_send_msg(CAN_t *pCAN, CANMsg_t *msg)
 {
-    int i;
+    int i, len, words, fdf = 0;
     MSGT0_t t0;
     MSGT1_t t1;
-    unsigned int vals[2];       /* Total 8 bytes */
+    unsigned int vals[16];      /* Total 64 bytes */
     unsigned int txsel;
 
     /*
      * prepare tx data
      */
     t0.value = 0;
-    t0.rtr = msg->rtr;                  /* Only for CAN 2.0 */
     if (msg->extended)					/* Extended Frame */
 	{
 	    t0.id = msg->id;
@@ -908,25 +1127,33 @@ static int ls2k_can_send_msg(CAN_t *pCAN, CANMsg_t *msg)
 	}
 
 	t1.value = 0;
-    t1.dlc = (msg->len <= 8) ? msg->len : 8;
-    t1.dlc = ((t1.dlc + 3) / 4) * 4;    /* Multiples of 4 */
 
-    vals[0] = 0;
-    vals[1] = 0;
-
-    if (0 == msg->rtr)
+#if CAN_USE_FD
+    if ((pCAN->r_mode & CAN_MODE_FDE) && msg->fdf)
     {
-        for (i=0; i<t1.dlc; i++)
-        {
-            int j = i / 4;
-            int k = i % 4;
-
-            vals[j] |= (unsigned int)msg->data[i] << (k * 8);
-        }
+        fdf = 1;
+        t1.fdf = 1;
+        t1.brs = msg->brs ? 1 : 0;
     }
     else
+#endif
+    {
+        t0.rtr = msg->rtr;              /* Only for CAN 2.0 */
+    }
+
+    t1.dlc = can_len_to_dlc(msg->len, fdf);
+    len = can_dlc_to_len(t1.dlc, fdf);
+    words = (len + 3) / 4;
+
+    if (t0.rtr)
     {
         /* CAN2.0 Remote Transmission Request */
+        words = 0;
+    }
+    else if (words > 0)
+    {
+        memset(vals, 0, words * 4);     /* padding zero */
+        memcpy(vals, msg->data, (msg->len < len) ? msg->len : len);
     }
 
     /*
@@ -939,11 +1166,8 @@ static int ls2k_can_send_msg(CAN_t *pCAN, CANMsg_t *msg)
     pCAN->hwCAN->head0 = t0.value;
     pCAN->hwCAN->head1 = t1.value;
 
-    if (0 == msg->rtr)
-    {
-        for (i=0; i<(t1.dlc+3)/4; i++)
-            pCAN->hwCAN->txdata[i] = vals[i];
-    }
+    for (i=0; i<words; i++)
+        pCAN->hwCAN->txdata[i] = vals[i];
 
     /*
      * set transmit command
@@ -958,21 +1182,138 @@ static int ls2k_can_send_msg(CAN_t *pCAN, CANMsg_t *msg)
 }
 
 /**
- * Receive a message from DMA or Inner RX Buffer
+ * Data words followed T0/T1
  */
-static int ls2k_can_receive_message(CAN_t *pCAN, int fromDMA)
+static inline int ls2k_can_data_words(MSGT0_t t0, MSGT1_t t1)
 {
-    int i;
-	MSGT0_t t0;
-	MSGT1_t t1;
-	CANMsg_t *msg;
-    unsigned int vals[2];       /* Total 8 bytes */
+    int fdf = 0;
+
+#if CAN_USE_FD
+    fdf = t1.fdf;
+#endif
+
+    if (!fdf && t0.rtr)
+        return 0;
+
+    return (can_dlc_to_len(t1.dlc, fdf) + 3) / 4;
+}
+
+/**
+ * Fill message from T0/T1, return data words followed
+ */
+static int ls2k_can_parse_header(CANMsg_t *msg, MSGT0_t t0, MSGT1_t t1)
+{
+    int fdf = 0;
+
+#if CAN_USE_FD
+    fdf = t1.fdf;
+    msg->fdf = t1.fdf;
+    msg->brs = t1.brs;
+    msg->esi = t0.esi;
+#endif
+
+    msg->rtr = fdf ? 0 : t0.rtr;
+    msg->extended = t0.xtd;
+    msg->len = can_dlc_to_len(t1.dlc, fdf);
+    msg->timestamp = t1.timestamp;
+
+    if (msg->extended)                  /* Extended Frame */
+        msg->id = t0.id;
+    else                                /* Standard frame */
+        msg->id = t0.id >> 18;
+
+    /*
+     * CAN2.0 Remote Transmission Request has no data.
+     */
+    return msg->rtr ? 0 : (msg->len + 3) / 4;
+}
+
+/**
+ * Deliver a received message to capture ring or rx fifo.
+ * Data words: n0 words at d0, followed by (words - n0) words at d1.
+ */
+static void ls2k_can_put_message(CAN_t *pCAN, MSGT0_t t0, MSGT1_t t1, int words,
+                                 const unsigned int *d0, int n0, const unsigned int *d1)
+{
+    unsigned char *data;
+
+    if (pCAN->cap_ring)
+    {
+        CANCapture_t *rec;
+        unsigned int head = pCAN->cap_head;
+        int fdf = 0;
+
+        /*
+         * 16 λʱչΪ 32 λ, ǰʱ˳
+         */
+        pCAN->cap_ts += (t1.timestamp - pCAN->cap_ts) & 0xFFFF;
+
+        /*
+         * ring ʱ±, Ƕȡʹõļ¼
+         */
+        if (head - __atomic_load_n(&pCAN->cap_tail, __ATOMIC_ACQUIRE) > pCAN->cap_mask)
+        {
+            pCAN->stats.rx_cap_dropped++;
+            return;
+        }
+
+        rec = &pCAN->cap_ring[head & pCAN->cap_mask];
+        rec->timestamp = pCAN->cap_ts;
+        rec->id    = t0.xtd ? t0.id : t0.id >> 18;
+        rec->flags = t0.xtd ? CAN_CAP_EXT : 0;
+#if CAN_USE_FD
+        fdf = t1.fdf;
+        if (fdf)
+            rec->flags |= CAN_CAP_FDF | (t1.brs ? CAN_CAP_BRS : 0) | (t0.esi ? CAN_CAP_ESI : 0);
+#endif
+        if (!fdf && t0.rtr)
+            rec->flags |= CAN_CAP_RTR;
+        rec->len = can_dlc_to_len(t1.dlc, fdf);
+        data = rec->data;
+    }
+    else
+    {
+        /*
+         * fifo ʱ±,  CAN_read() ڸƵı
+         */
+        CANMsg_t *msg = can_fifo_put_claim(pCAN->rxfifo, 0);
+
+        if (!msg)
+        {
+            pCAN->rxfifo->ovcount++;
+            pCAN->stats.rx_fifo_dropped++;
+            return;
+        }
+
+        ls2k_can_parse_header(msg, t0, t1);
+        data = msg->data;
+    }
+
+    /* little endian: byte k of word j is data[4*j+k] */
+    if (n0 > words)
+        n0 = words;
+    memcpy(data, d0, n0 * 4);
+    if (n0 < words)
+        memcpy(data + n0 * 4, d1, (words - n0) * 4);
 
     /*
-     * the rx fifo is not empty put 1 message into rxfifo for later use.
-     * get empty (or make room) message
+     * make message available to the user
      */
-    msg = can_fifo_put_claim(pCAN->rxfifo, 1);
+    if (pCAN->cap_ring)
+        __atomic_store_n(&pCAN->cap_head, pCAN->cap_head + 1, __ATOMIC_RELEASE);
+    else
+        can_fifo_put(pCAN->rxfifo);
+}
+
+/**
+ * Receive a message from Inner RX Buffer
+ */
+static int ls2k_can_receive_message(CAN_t *pCAN, int fromDMA)
+{
+    int i, words;
+	MSGT0_t t0;
+	MSGT1_t t1;
+    unsigned int vals[16];      /* Total 64 bytes */
 
     {
         /*
@@ -982,54 +1323,241 @@ static int ls2k_can_receive_message(CAN_t *pCAN, int fromDMA)
         t1.value = pCAN->hwCAN->rxdata;
     }
 
-    msg->rtr = t0.rtr;
-    msg->extended = t0.xtd;
-    msg->len = (t1.dlc <= 8) ? t1.dlc : 8;
+    words = ls2k_can_data_words(t0, t1);
 
-    if (msg->extended)                  /* Extended Frame */
-        msg->id = t0.id;
-    else                                /* Standard frame */
-        msg->id = t0.id >> 18;
+    for (i=0; i<words; i++)
+    {
+        /*
+         * Inner buffer Rx data flag
+         */
+        if (!(pCAN->hwCAN->rxsr & CAN_RXSR_MOF))
+            break;
+
+        vals[i] = pCAN->hwCAN->rxdata;
+    }
+
+    for ( ; i<words; i++)
+        vals[i] = 0;
+
+    ls2k_can_put_message(pCAN, t0, t1, words, vals, words, NULL);
+
+    return 0;
+}
+
+#if CAN_USE_DMA
+
+/******************************************************************************
+ * CAN DMA receive
+ *
+ * DMA ѭģʽ,  rxdata ı(T0, T1, )д dma_rxbuf,
+ * ٲÿһε RX ж.
+ *
+ *   1. /жʱ, һνı,  rxfifo;
+ *   2. CAN_read() ȴʱҲ, ıĲ.
+ */
+
+static int ls2k_can_dma_devnum(CAN_t *pCAN)
+{
+    return DMA_CAN0 + (int)((VA_TO_PHYS(pCAN->hwCAN) - CAN0_BASE) / (CAN1_BASE - CAN0_BASE));
+}
+
+/*
+ * DMA ĵǰдλ, 
+ */
+static inline int ls2k_can_dma_rx_head(CAN_t *pCAN)
+{
+    int head = CAN_DMA_WORDS - dma_get_counter(pCAN->rx_chnl);
+
+    if ((head < 0) || (head >= CAN_DMA_WORDS))
+        head = 0;
+
+    return head;
+}
+
+/*
+ * ޷ȷı߽, ջ¿ʼ
+ */
+static void ls2k_can_dma_rx_reset(CAN_t *pCAN)
+{
+    ls2k_can_dma_rx_stop(pCAN);
+    pCAN->hwCAN->cmd = CAN_CMD_RRB;
+    ls2k_can_dma_rx_start(pCAN);
+}
+
+/*
+ *  dma_rxbuf ı, رĸ. ߹ж
+ */
+static int ls2k_can_dma_rx_parse(CAN_t *pCAN)
+{
+    unsigned int *ring = pCAN->dma_rxbuf;
+    unsigned int rpos = pCAN->dma_rx_rpos;
+    unsigned int wpos, avail;
+    int tail = rpos & CAN_DMA_MASK;
+    int words, n, count = 0;
+	MSGT0_t t0;
+	MSGT1_t t1;
 
-    for (i=0; i<8; i++)
-        msg->data[i] = 0;
+    /*
+     * DMA ۼдλ: һι/жϵλ֮, һȦ.
+     * ֻ head - tail ʱ, DMA һȦûһ.
+     */
+    wpos  = pCAN->dma_rx_halves * (CAN_DMA_WORDS / 2);
+    wpos += (ls2k_can_dma_rx_head(pCAN) - wpos) & CAN_DMA_MASK;
+    avail = wpos - rpos;
 
-    if (0 == msg->rtr)
+    /*
+     * DMA Ѿ˻ûнı
+     */
+    if (avail > CAN_DMA_WORDS)
     {
-        for (i=0; i<(msg->len+3)/4; i++)
-        {
-            {
-                /*
-                 * Inner buffer Rx data flag
-                 */
-                if (pCAN->hwCAN->rxsr & CAN_RXSR_MOF)   
-                {
-                    vals[i] = pCAN->hwCAN->rxdata;
-                }
-            }
-        }
+        pCAN->stats.rx_dma_overruns++;
+        ls2k_can_dma_rx_reset(pCAN);
+        return 0;
+    }
 
-        for (i=0; i<msg->len; i++)
-        {
-            int j = i / 4;
-            int k = i % 4;
+    if (avail < 2)
+        return 0;
 
-            msg->data[i] = (unsigned char)(vals[j] >> (k * 8));
-        }
+    n = CAN_DMA_WORDS - tail;
+    if ((int)avail <= n)
+    {
+        clean_dcache_nowrite((unsigned long)(ring + tail), avail * 4);
     }
-    else                /* CAN2.0 Remote Transmission Request */
+    else
     {
-        // RTR frame has no data.
+        clean_dcache_nowrite((unsigned long)(ring + tail), n * 4);
+        clean_dcache_nowrite((unsigned long)ring, (avail - n) * 4);
     }
 
+    while (avail >= 2)
+    {
+        t0.value = ring[tail];
+        t1.value = ring[(tail + 1) & CAN_DMA_MASK];
+
+        /*
+         * DMA ûд
+         */
+        words = ls2k_can_data_words(t0, t1);
+        if (avail < (unsigned int)words + 2)
+            break;
+
+        tail = (tail + 2) & CAN_DMA_MASK;
+        n = CAN_DMA_WORDS - tail;
+        ls2k_can_put_message(pCAN, t0, t1, words, ring + tail, n, ring);
+
+        tail  = (tail + words) & CAN_DMA_MASK;
+        avail -= words + 2;
+        rpos  += words + 2;
+        count++;
+    }
+
+    pCAN->dma_rx_rpos = rpos;
+    pCAN->stats.rx_msgs += count;
+
+    return count;
+}
+
+static void ls2k_can_dma_rx_callback(struct dma_chnl_cfg *cfg, int bytes, unsigned int status)
+{
+    CAN_t *pCAN = (CAN_t *)cfg->device;
+    int count = 0;
+
+    if (status & (DMA_SR_HALF | DMA_SR_DONE))
+    {
+        if (status & DMA_SR_HALF)
+            pCAN->dma_rx_halves++;
+        if (status & DMA_SR_DONE)
+            pCAN->dma_rx_halves++;
+
+        count = ls2k_can_dma_rx_parse(pCAN);
+    }
+
+    if (status & DMA_SR_ERROR)
+    {
+        pCAN->stats.rxbuf_errors++;
+        pCAN->status |= CAN_STATUS_BUF_ERROR;
+        ls2k_can_dma_rx_reset(pCAN);
+    }
+
+    if ((count > 0) && osal_is_osrunning())
+    {
+        osal_event_send(pCAN->p_event, CAN_RX_EVENT);
+    }
+}
+
+static int ls2k_can_dma_rx_start(CAN_t *pCAN)
+{
+    struct dma_chnl_cfg *cfg = &pCAN->rx_dma_cfg;
+
+    if (pCAN->dma_active)
+        return 0;
+
     /*
-     * make message available to the user
+     * ͨһֱռ, ´ʱʹ
      */
-    can_fifo_put(pCAN->rxfifo);
+    if (pCAN->rx_chnl < 0)
+    {
+        if (dma_claim_channel(ls2k_can_dma_devnum(pCAN), &pCAN->rx_chnl, NULL) != 0)
+        {
+            pCAN->rx_chnl = -1;
+            printk("%s: no idle DMA channel\r\n", pCAN->dev_name);
+            return -1;
+        }
+    }
+
+    /*
+     * жڹر CAN ʱͷ, ʱظʹ
+     */
+    if (!pCAN->dma_rxbuf)
+    {
+        pCAN->dma_rxbuf = (unsigned int *)aligned_malloc(CAN_DMA_WORDS * 4, 64);
+        if (!pCAN->dma_rxbuf)
+            return -1;
+    }
+
+    clean_dcache_nowrite((unsigned long)pCAN->dma_rxbuf, CAN_DMA_WORDS * 4);
+    pCAN->dma_rx_rpos = 0;
+    pCAN->dma_rx_halves = 0;
+
+    memset(cfg, 0, sizeof(struct dma_chnl_cfg));
+    cfg->chNum      = pCAN->rx_chnl;
+    cfg->devNum     = ls2k_can_dma_devnum(pCAN);
+    cfg->device     = pCAN;
+    cfg->memAddr    = (unsigned)(uintptr_t)pCAN->dma_rxbuf;
+    cfg->transbytes = CAN_DMA_WORDS * 4;
+    cfg->cb         = ls2k_can_dma_rx_callback;
+
+    cfg->ccr.tcie = 1;              // trans done int-enable
+    cfg->ccr.htie = 1;              // trans half int-enable
+    cfg->ccr.teie = 1;              // trans error int-enable
+    cfg->ccr.dir  = 0;              // 0: peripheral to mem
+    cfg->ccr.circ = 1;              // circle mode
+    cfg->ccr.pinc = 0;              // 1=auto inc peripheral address
+    cfg->ccr.minc = 1;              // 1=auto inc mem address
+    cfg->ccr.psize = 2;             // peripheral data width: 2=32bits
+    cfg->ccr.msize = 2;             // memory data width:     2=32bits
+    cfg->ccr.priority = 2;          // channel priority: high
+
+    if (dma_start(cfg, 0) != 0)
+        return -1;
+
+    pCAN->dma_active = 1;
 
     return 0;
 }
 
+static void ls2k_can_dma_rx_stop(CAN_t *pCAN)
+{
+    if (pCAN->dma_active)
+    {
+        dma_stop(pCAN->rx_chnl);
+        pCAN->rx_dma_cfg.ccr.en = 0;
+        pCAN->dma_active = 0;
+    }
+}
+
+#endif // #if CAN_USE_DMA
+
 /**
  * Interrupt Handler
  */
@@ -1109,7 +1637,7 @@ static void ls2k_can_interrupt_handler(int vector, void *arg)
 					 */
 					if (pCAN->stats.txbuf_errors < 10)
 					{
-						debug_prt("CAN: got TX interrupt but TX fifo in not empty\r\n");
+						TRACE("%s: got TX interrupt but TX fifo in not empty", pCAN->dev_name);
 					}
 
 					pCAN->status |= CAN_STATUS_BUF_ERROR;
@@ -1144,20 +1672,20 @@ static void ls2k_can_interrupt_handler(int vector, void *arg)
             pCAN->hwCAN->cmd |= CAN_CMD_ERCRST;
 
 			pCAN->stats.err_ewl++;
-			debug_prt("EWL\r\n");
+			TRACE("%s: EWL", pCAN->dev_name);
 		}
 
 		if (isr & CAN_ISR_DO)
 		{
 		    pCAN->hwCAN->cmd |= CAN_CMD_RRB;
 			pCAN->stats.err_dover++;
-			debug_prt("RxOV\r\n");
+			TRACE("%s: RxOV", pCAN->dev_name);
 		}
 
 		if (isr & CAN_ISR_FCS)
 		{
 			pCAN->stats.err_fcs++;
-			debug_prt("FCS\r\n");
+			TRACE("%s: FCS", pCAN->dev_name);
 		}
 
 		if (isr & CAN_ISR_AL)
@@ -1190,7 +1718,7 @@ static void ls2k_can_interrupt_handler(int vector, void *arg)
             }
 
             pCAN->stats.err_alost++;
-            debug_prt("AL\r\n");
+            TRACE("%s: AL 0x%02x", pCAN->dev_name, alc);
 		}
 
 		if (isr & CAN_ISR_BE)
@@ -1199,7 +1727,7 @@ static void ls2k_can_interrupt_handler(int vector, void *arg)
 			errcode &= CAN_ECAPT_TYPE_MASK;
 			errcode >>= CAN_ECAPT_TYPE_SHIFT;
 
-			debug_prt("BUSE %02X\r\n", errcode);
+			TRACE("%s: BUSE %02X", pCAN->dev_name, errcode);
 
 			/* Some kind of BUS error, only used for statistics.
 			 * Error Register is decoded and put into can->stats.
@@ -1318,6 +1846,12 @@ STATIC_DRV int CAN_initialize(const void *dev, void *arg)
     pCAN->tx_timeout = RXTX_TIMEOUT;
     pCAN->timestamp_psc = 0;
     pCAN->config_update = 0;
+    pCAN->cap_ring = NULL;
+#if CAN_USE_DMA
+    pCAN->rx_chnl = -1;
+    pCAN->dma_rxbuf = NULL;
+    pCAN->dma_active = 0;
+#endif
 
     memset(&pCAN->speed, 0,  sizeof(CAN_speed_t));
     memset(&pCAN->filter, 0, sizeof(CAN_filter_t));
@@ -1333,9 +1867,17 @@ STATIC_DRV int CAN_initialize(const void *dev, void *arg)
      */
     pCAN->speed.Sample_pt = 80;
     pCAN->speed.tPTS = 400;
+#if CAN_USE_FD
+    pCAN->fd_baudrate = -1;
+    memset(&pCAN->fd_speed, 0, sizeof(CAN_speed_t));
+    pCAN->fd_speed.Sample_pt = 75;
+#endif
 
     ls2k_can_set_workmode(pCAN, 0);
     ls2k_can_set_baudrate(pCAN, CAN_SPEED_500K);
+#if CAN_USE_FD
+    ls2k_can_set_fd_baudrate(pCAN, CAN_SPEED_2M);
+#endif
     ls2k_can_set_filter(pCAN, NULL);
     ls2k_can_set_range(pCAN, NULL);
     ls2k_can_set_ts_psc(pCAN, 0);
@@ -1394,9 +1936,26 @@ STATIC_DRV int CAN_open(const void *dev, void *arg)
 	/*
      * allocate fifos
 	 */
+#if CAN_USE_DMA
+    /*
+     * DMA ÿжϷ, ʹôһЩ rxfifo
+     */
+    if ((pCAN->workmode & CAN_MODE_RX_DMA) &&
+        pCAN->rxfifo && (pCAN->rxfifo->count < RX_FIFO_LEN_DMA))
+    {
+        can_fifo_free(pCAN->rxfifo);
+        pCAN->rxfifo = NULL;
+    }
+#endif
+
     if (!pCAN->rxfifo)
     {
-		pCAN->rxfifo = can_fifo_create(RX_FIFO_LEN);
+        int count = RX_FIFO_LEN;
+#if CAN_USE_DMA
+        if (pCAN->workmode & CAN_MODE_RX_DMA)
+            count = RX_FIFO_LEN_DMA;
+#endif
+		pCAN->rxfifo = can_fifo_create(count);
 		if (!pCAN->rxfifo)
 		{
 			errno = ENOMEM;
@@ -1462,7 +2021,7 @@ STATIC_DRV int CAN_close(const void *dev, void *arg)
  */
 STATIC_DRV int CAN_read(const void *dev, void *buf, int size, void *arg)
 {
-    int left = size;
+    int left = size, count;
     CAN_t *pCAN = (CAN_t *)dev;
     CANMsg_t *srcmsg, *dstmsg = (CANMsg_t *)buf;
 
@@ -1480,6 +2039,15 @@ STATIC_DRV int CAN_read(const void *dev, void *buf, int size, void *arg)
         return -1;
     }
 
+    /*
+     * messages go to capture ring
+     */
+    if (pCAN->cap_ring)
+    {
+        errno = EBUSY;
+        return -1;
+    }
+
 	while (left >= sizeof(CANMsg_t))
 	{
 		/*
@@ -1491,12 +2059,26 @@ STATIC_DRV int CAN_read(const void *dev, void *buf, int size, void *arg)
         	break;
         }
 
-		srcmsg = can_fifo_claim_get(pCAN->rxfifo);
+#if CAN_USE_DMA
+        /*
+         * ûе/жϵı
+         */
+        if (pCAN->dma_active && can_fifo_empty(pCAN->rxfifo))
+        {
+            loongarch_critical_enter();
+            ls2k_can_dma_rx_parse(pCAN);
+            loongarch_critical_exit();
+        }
+#endif
+
+		loongarch_critical_enter();
+		count = can_fifo_claim_get_n(pCAN->rxfifo, &srcmsg, left / sizeof(CANMsg_t));
+		loongarch_critical_exit();
 
-		if (!srcmsg)
+		if (!count)
 		{
 		    int tmo = pCAN->rx_timeout;
-		    unsigned int recv_event;
+		    unsigned int recv_event, wait_ms = OSAL_WAIT_FOREVER;
 
 			/* No more messages in reception fifo. Wait for incoming packets
 			 * return if no wait OR readed some messages.
@@ -1504,15 +2086,20 @@ STATIC_DRV int CAN_read(const void *dev, void *buf, int size, void *arg)
 			if ((tmo == 0) || (left != size))
             	break;
 
+#if CAN_USE_DMA
+            if (pCAN->dma_active)
+                wait_ms = CAN_DMA_POLL_MS;
+#endif
+
 			/*
              * wait for incomming messages...
 			 */
             recv_event = osal_event_receive(pCAN->p_event,
                                             CAN_RX_EVENT,
                                             OSAL_EVENT_FLAG_AND | OSAL_EVENT_FLAG_CLEAR,
-                                            OSAL_WAIT_FOREVER );
+                                            wait_ms );
 
-            if (recv_event != CAN_RX_EVENT)
+            if ((recv_event != CAN_RX_EVENT) && (wait_ms == OSAL_WAIT_FOREVER))
             {
                 break;
             }
@@ -1524,17 +2111,22 @@ STATIC_DRV int CAN_read(const void *dev, void *buf, int size, void *arg)
 		}
 
 		/*
-         * got message, copy it to userspace buffer
+         * got messages, copy them to userspace buffer. RX interrupt does not
+         * overwrite claimed messages, it drops new ones when fifo is full
 		 */
-		*dstmsg = *srcmsg;
+		memcpy(dstmsg, srcmsg, count * sizeof(CANMsg_t));
 
 		/*
-         * Return borrowed message, RX interrupt can use it again
+         * Return borrowed messages, RX interrupt can use them again
 		 */
-		can_fifo_get(pCAN->rxfifo);
+        {
+		    loongarch_critical_enter();
+		    can_fifo_get_n(pCAN->rxfifo, count);
+		    loongarch_critical_exit();
+		}
 
-		left -= sizeof(CANMsg_t);
-		dstmsg++;
+		left -= count * sizeof(CANMsg_t);
+		dstmsg += count;
 	}
 
     return size - left;
@@ -1571,8 +2163,6 @@ STATIC_DRV int CAN_write(const void *dev, void *buf, int size, void *arg)
     	return -2;
     }
 
-	msg->len = (msg->len > 8) ? 8 : msg->len;
-
     /*
      * is device idle?
 	 */
@@ -1600,8 +2190,6 @@ STATIC_DRV int CAN_write(const void *dev, void *buf, int size, void *arg)
 	 */
 	while (left >= sizeof(CANMsg_t))
 	{
-		msg->len = (msg->len > 8) ? 8 : msg->len;
-
 		fifo_msg = can_fifo_put_claim(pCAN->txfifo, 0);
 
 		if (!fifo_msg)
@@ -1701,6 +2289,13 @@ STATIC_DRV int CAN_ioctl(const void *dev, int cmd, void *arg)
 		    rt = ls2k_can_set_baudrate(pCAN, (int)(uintptr_t)arg);
 		    break;
 
+#if CAN_USE_FD
+		case IOCTL_CAN_SET_FD_BAUDRATE:
+		    CAN_OPENED_BREAK;
+		    rt = ls2k_can_set_fd_baudrate(pCAN, (int)(uintptr_t)arg);
+		    break;
+#endif
+
 		case IOCTL_CAN_SET_FILTER:
 		    CAN_OPENED_BREAK;
 		    PTR_NULL_BREAK(arg);
@@ -1728,6 +2323,11 @@ STATIC_DRV int CAN_ioctl(const void *dev, int cmd, void *arg)
 		    rt = ls2k_can_set_ts_psc(pCAN, (unsigned int)(uintptr_t)arg);
 		    break;
 
+		case IOCTL_CAN_SET_CAPTURE:
+		    CAN_OPENED_BREAK;
+		    rt = ls2k_can_set_capture(pCAN, (CAN_capture_t *)arg);
+		    break;
+
 		case IOCTL_CAN_GET_CUR_TS:
 		    PTR_NULL_BREAK(arg);
 		    *((unsigned int *)arg) = pCAN->hwCAN->ts & CAN_TS_CURRENT_MASK;
@@ -1755,7 +2355,7 @@ STATIC_DRV int CAN_ioctl(const void *dev, int cmd, void *arg)
 
 		case IOCTL_CAN_GET_BUFS:
 		    PTR_NULL_BREAK(arg);
-		    *((unsigned int *)arg) = RX_FIFO_LEN;
+		    *((unsigned int *)arg) = pCAN->rxfifo ? pCAN->rxfifo->count : RX_FIFO_LEN;
 		    break;
 
 		default:
@@ -1796,6 +2396,101 @@ const char *ls2k_can_get_device_name(const void *pCAN)
     return ((CAN_t *)pCAN)->dev_name;
 }
 
+/******************************************************************************
+ * capture ring reader
+ */
+int ls2k_can_capture_claim(const void *dev, CANCapture_t **recs, int max, unsigned int timeout_ms)
+{
+    CAN_t *pCAN = (CAN_t *)dev;
+    unsigned int head, tail, n;
+
+    if ((pCAN == NULL) || (recs == NULL) || (max <= 0) || (pCAN->cap_ring == NULL))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    for ( ; ; )
+    {
+        unsigned int wait_ms = timeout_ms, recv_event;
+
+#if CAN_USE_DMA
+        if (pCAN->dma_active)
+        {
+            loongarch_critical_enter();
+            ls2k_can_dma_rx_parse(pCAN);
+            loongarch_critical_exit();
+        }
+#endif
+
+        head = __atomic_load_n(&pCAN->cap_head, __ATOMIC_ACQUIRE);
+        tail = pCAN->cap_tail;
+
+        if (head != tail)
+            break;
+
+        if ((timeout_ms == 0) || !pCAN->opened)
+            return 0;
+
+#if CAN_USE_DMA
+        /*
+         *  DMA ı, Ҫٽ
+         */
+        if (pCAN->dma_active && (wait_ms > CAN_DMA_POLL_MS))
+            wait_ms = CAN_DMA_POLL_MS;
+#endif
+
+        recv_event = osal_event_receive(pCAN->p_event,
+                                        CAN_RX_EVENT,
+                                        OSAL_EVENT_FLAG_AND | OSAL_EVENT_FLAG_CLEAR,
+                                        wait_ms );
+
+        if (recv_event != CAN_RX_EVENT)
+        {
+            if (wait_ms == timeout_ms)
+                return 0;
+            if (timeout_ms != OSAL_WAIT_FOREVER)
+                timeout_ms -= wait_ms;
+        }
+    }
+
+    /*
+     * ļ¼,  ring ĩβΪֹ
+     */
+    n = head - tail;
+    if (n > pCAN->cap_mask + 1 - (tail & pCAN->cap_mask))
+        n = pCAN->cap_mask + 1 - (tail & pCAN->cap_mask);
+    if (n > (unsigned int)max)
+        n = max;
+
+    *recs = &pCAN->cap_ring[tail & pCAN->cap_mask];
+
+    return (int)n;
+}
+
+int ls2k_can_capture_release(const void *dev, int count)
+{
+    CAN_t *pCAN = (CAN_t *)dev;
+    unsigned int tail;
+
+    if ((pCAN == NULL) || (pCAN->cap_ring == NULL) || (count < 0))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    tail = pCAN->cap_tail;
+    if ((unsigned int)count > pCAN->cap_head - tail)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    __atomic_store_n(&pCAN->cap_tail, tail + count, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
 #endif // #if BSP_USE_CAN
 
 //-----------------------------------------------------------------------------
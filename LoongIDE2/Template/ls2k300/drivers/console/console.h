@@ -18,6 +18,13 @@ ssize_t console_gets(void *buf, size_t nbytes);
 void console_putch(char ch);
 ssize_t console_puts(char *buf, size_t nbytes);
 
+/*
+ * printk() ӳ
+ */
+void printk_drain(void);
+void printk_flush(void);
+int printk_start_drain_task(void);
+
 #ifdef __cplusplus
 }
 #endif
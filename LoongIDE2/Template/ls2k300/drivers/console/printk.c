@@ -10,6 +10,11 @@
 #include <string.h>
 #include <stdarg.h>
 
+#include "bsp.h"
+#include "osal.h"
+
+#include "ls2k300.h"
+
 #include "console.h"
 
 //-----------------------------------------------------------------------------
@@ -20,6 +25,313 @@
 
 #define PRINTK_BUF_SIZE     511
 
+/*
+ * ӳ: printk() ֻıд뻷λ,  printk_drain() .
+ *
+ *  PesudoOS ѭ printk_start_drain_task() ĵȼʼ
+ *  printk_drain() ֮ǰ, printk() Ȼͬ.
+ */
+#define PRINTK_DEFERRED     1
+
+#if PRINTK_DEFERRED
+
+#define PRINTK_SLOTS        256                 /*  2  */
+#define PRINTK_SLOT_SIZE    64
+#define PRINTK_SLOT_TEXT    (PRINTK_SLOT_SIZE - 20)
+
+#define PRINTK_TIMESTAMP    1                   /* ʱ */
+
+#define PRINTK_DRAIN_MS     10
+
+#if defined(OS_RTTHREAD)
+#define PRINTK_TASK_PRIO    30
+#define PRINTK_TASK_SLICE   10
+#elif defined(OS_UCOS)
+#define PRINTK_TASK_PRIO    61
+#define PRINTK_TASK_SLICE   10
+#elif defined(OS_FREERTOS)
+#define PRINTK_TASK_PRIO    30
+#define PRINTK_TASK_SLICE   0
+#else // Bare-Metal
+#define PRINTK_TASK_PRIO    0
+#define PRINTK_TASK_SLICE   0
+#endif
+
+/*
+ * ߡߵλ.
+ *
+ * ÿһ:  == pos ʱۿ, дλ pos ļ¼; дΪ
+ * pos+1 ʾԶ; Ϊ pos+PRINTK_SLOTS һȦʹ.
+ *
+ * һ¼ռ nslots , һ CAS ƶ head ռЩ,
+ * ж printk() ʱȴκ.
+ */
+typedef struct
+{
+    volatile unsigned long seq;
+    unsigned long  stamp;                       /* ײ: rdtime.d */
+    unsigned short len;                         /* ۵ı */
+    unsigned short nslots;                      /* ײ: ¼ռõĲ */
+    char           text[PRINTK_SLOT_TEXT];
+} printk_slot_t;
+
+static printk_slot_t printk_ring[PRINTK_SLOTS];
+
+static unsigned long printk_head;               /* λ */
+static unsigned long printk_tail;               /* λ */
+
+static volatile int  printk_inited;
+static volatile int  printk_deferred;           /* 1: , ӳ */
+static volatile int  printk_emergency;          /* 1: 쳣ͬ */
+static int           printk_draining;
+static int           printk_line_start = 1;
+
+static unsigned int  printk_dropped;            /* ļ¼ */
+static unsigned int  printk_dropped_shown;
+
+static osal_task_t   printk_task = NULL;
+
+static void printk_ring_init(void)
+{
+    unsigned long i;
+
+    for (i=0; i<PRINTK_SLOTS; i++)
+    {
+        printk_ring[i].seq = i;
+    }
+
+    printk_head = 0;
+    printk_tail = 0;
+
+    __atomic_store_n(&printk_inited, 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * дһ¼, ʱ -1
+ */
+static int printk_ring_put(const char *str, int len)
+{
+    unsigned long pos, seq, stamp;
+    int i, nslots;
+
+    stamp  = get_stable_counter();
+    nslots = (len + PRINTK_SLOT_TEXT - 1) / PRINTK_SLOT_TEXT;
+
+    pos = __atomic_load_n(&printk_head, __ATOMIC_RELAXED);
+
+    for ( ; ; )
+    {
+        for (i=0; i<nslots; i++)
+        {
+            seq = __atomic_load_n(&printk_ring[(pos + i) & (PRINTK_SLOTS - 1)].seq, __ATOMIC_ACQUIRE);
+            if (seq != pos + i)
+            {
+                break;
+            }
+        }
+
+        if (i < nslots)
+        {
+            if ((long)(seq - (pos + i)) < 0)    /* ûб:  */
+            {
+                __atomic_fetch_add(&printk_dropped, 1, __ATOMIC_RELAXED);
+                return -1;
+            }
+
+            /* ռ */
+            pos = __atomic_load_n(&printk_head, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        if (__atomic_compare_exchange_n(&printk_head, &pos, pos + nslots, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+
+    /*
+     * ײύ, ߿ײʱѾɶ
+     */
+    for (i=nslots-1; i>=0; i--)
+    {
+        printk_slot_t *slot = &printk_ring[(pos + i) & (PRINTK_SLOTS - 1)];
+        int n = len - i * PRINTK_SLOT_TEXT;
+
+        if (n > PRINTK_SLOT_TEXT)
+        {
+            n = PRINTK_SLOT_TEXT;
+        }
+
+        memcpy(slot->text, str + i * PRINTK_SLOT_TEXT, n);
+        slot->len    = n;
+        slot->nslots = i ? 0 : nslots;
+        slot->stamp  = stamp;
+
+        __atomic_store_n(&slot->seq, pos + i + 1, __ATOMIC_RELEASE);
+    }
+
+    return 0;
+}
+
+/*
+ * ύļ¼. ֻ֤߱һ
+ */
+static void printk_ring_output(void)
+{
+    char buf[48];
+    int  i, n;
+
+    for ( ; ; )
+    {
+        printk_slot_t *slot = &printk_ring[printk_tail & (PRINTK_SLOTS - 1)];
+
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != printk_tail + 1)
+        {
+            break;
+        }
+
+#if PRINTK_TIMESTAMP
+        if (printk_line_start)
+        {
+            unsigned long us = slot->stamp / hda_1us_count;
+
+            n = snprintf(buf, sizeof(buf), "[%5lu.%06lu] ", us / 1000000, us % 1000000);
+            console_puts(buf, (size_t)n);
+        }
+#endif
+
+        n = slot->nslots;
+        for (i=0; i<n; i++)
+        {
+            printk_slot_t *s = &printk_ring[(printk_tail + i) & (PRINTK_SLOTS - 1)];
+
+            console_puts(s->text, (size_t)s->len);
+
+            if (i == n - 1)
+            {
+                printk_line_start = (s->text[s->len - 1] == '\n');
+            }
+
+            __atomic_store_n(&s->seq, printk_tail + i + PRINTK_SLOTS, __ATOMIC_RELEASE);
+        }
+
+        printk_tail += n;
+    }
+
+    if (printk_dropped != printk_dropped_shown)
+    {
+        n = snprintf(buf, sizeof(buf), "[printk: %u messages dropped]\r\n",
+                     printk_dropped - printk_dropped_shown);
+        console_puts(buf, (size_t)n);
+        printk_dropped_shown = printk_dropped;
+        printk_line_start = 1;
+    }
+}
+
+/*
+ * ѻ. һεú printk() תΪӳ.
+ *
+ *  PesudoOS ѭȼ; еʱֱӷ.
+ */
+void printk_drain(void)
+{
+    if (!printk_inited)
+    {
+        printk_ring_init();
+    }
+
+    if (__atomic_exchange_n(&printk_draining, 1, __ATOMIC_ACQUIRE))
+    {
+        return;
+    }
+
+    printk_deferred = 1;
+    printk_ring_output();
+
+    __atomic_store_n(&printk_draining, 0, __ATOMIC_RELEASE);
+}
+
+#if defined(OS_PESUDO)
+/*
+ * PesudoOS ѭÿһһ
+ */
+void pesudoos_idle_hook(void)
+{
+    printk_drain();
+}
+#endif
+
+/*
+ * : 쳣е, ȴĵ; ֮ printk() ͬ
+ */
+void printk_flush(void)
+{
+    printk_emergency = 1;
+
+    if (printk_inited)
+    {
+        printk_ring_output();
+    }
+}
+
+static void printk_drain_task(void *arg)
+{
+    for ( ; ; )
+    {
+        printk_drain();
+        osal_task_sleep(PRINTK_DRAIN_MS);
+    }
+}
+
+/*
+ * RTOS ʹ: ȼ
+ */
+int printk_start_drain_task(void)
+{
+    if (printk_task)
+    {
+        return 0;
+    }
+
+    if (!printk_inited)
+    {
+        printk_ring_init();
+    }
+
+    printk_task = osal_task_create("printk",
+                                   4096,
+                                   PRINTK_TASK_PRIO,
+                                   PRINTK_TASK_SLICE,
+                                   printk_drain_task,
+                                   NULL);
+
+    if (printk_task == NULL)
+    {
+        return -1;
+    }
+
+    /* ֮ǰҲ뻺 */
+    printk_deferred = 1;
+
+    return 0;
+}
+
+#endif // #if PRINTK_DEFERRED
+
+static void printk_output(char *str, int len)
+{
+#if PRINTK_DEFERRED
+    if (printk_deferred && !printk_emergency)
+    {
+        printk_ring_put(str, len);
+        return;
+    }
+#endif
+
+    console_puts(str, (size_t)len);
+}
+
 void printk(const char *fmt, ...)
 {
     int slen;
@@ -40,7 +352,7 @@ void printk(const char *fmt, ...)
 
         if ((slen > 0) && (slen <= PRINTK_BUF_SIZE))
         {
-            console_puts(printk_buf, (size_t)slen);
+            printk_output(printk_buf, slen);
         }
     }
     else
@@ -49,7 +361,7 @@ void printk(const char *fmt, ...)
 
         if ((slen > 0) && (slen <= PRINTK_BUF_SIZE))
         {
-            console_puts((char *)fmt, (size_t)slen);
+            printk_output((char *)fmt, slen);
         }
     }
 
@@ -0,0 +1,152 @@
+/*
+ * trace.c
+ *
+ * created: 2026-10-17
+ *  author:
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bsp.h"
+
+#include "ls2k300.h"
+#include "console.h"
+#include "ls2k_trace.h"
+
+//-----------------------------------------------------------------------------
+// Ƹټ¼
+//-----------------------------------------------------------------------------
+
+/*
+ * ̬ʼ, ûκμ¼ʱڴתҲԽ.
+ * count_1us  tick.c Ĭֵ, д¼תʱΪ hda_1us_count
+ */
+trace_buf_t ls2k_trace_buf =
+{
+    .magic     = TRACE_MAGIC,
+    .records   = TRACE_RECORDS,
+    .rec_size  = sizeof(trace_rec_t),
+    .count_1us = 30,
+};
+
+static unsigned long trace_tail;            /* trace_print() λ */
+
+#if BSP_USE_TRACE
+
+/*
+ * дһ¼: һԭӼȡ, дǰдһ seq.
+ * ߿ seq ǰһ²ʹ¼
+ */
+void trace_event(const char *fmt, unsigned long a0, unsigned long a1,
+                 unsigned long a2, unsigned long a3, unsigned long a4)
+{
+    unsigned long idx;
+    trace_rec_t *rec;
+
+    idx = __atomic_fetch_add(&ls2k_trace_buf.head, 1, __ATOMIC_RELAXED);
+    rec = &ls2k_trace_buf.rec[idx & (TRACE_RECORDS - 1)];
+
+    rec->seq = 0;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    rec->stamp  = get_stable_counter();
+    rec->fmt    = fmt;
+    rec->arg[0] = a0;
+    rec->arg[1] = a1;
+    rec->arg[2] = a2;
+    rec->arg[3] = a3;
+    rec->arg[4] = a4;
+
+    __atomic_store_n(&rec->seq, idx + 1, __ATOMIC_RELEASE);
+
+    ls2k_trace_buf.count_1us = hda_1us_count;
+}
+
+#endif // #if BSP_USE_TRACE
+
+int trace_print(int max)
+{
+    unsigned long head, us;
+    trace_rec_t rec;
+    char buf[160];
+    int n, count = 0;
+
+    head = __atomic_load_n(&ls2k_trace_buf.head, __ATOMIC_ACQUIRE);
+
+    /* ǵļ¼ */
+    if (head - trace_tail > TRACE_RECORDS)
+    {
+        printk("[trace: %lu records lost]\r\n", head - trace_tail - TRACE_RECORDS);
+        trace_tail = head - TRACE_RECORDS;
+    }
+
+    while ((trace_tail != head) && ((max <= 0) || (count < max)))
+    {
+        trace_rec_t *p = &ls2k_trace_buf.rec[trace_tail & (TRACE_RECORDS - 1)];
+
+        rec.seq = __atomic_load_n(&p->seq, __ATOMIC_ACQUIRE);
+        if (rec.seq == 0)
+        {
+            break;                          /* д */
+        }
+
+        memcpy(&rec.stamp, (const void *)&p->stamp, sizeof(rec) - sizeof(rec.seq));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if ((rec.seq == trace_tail + 1) && (p->seq == rec.seq))
+        {
+            us = rec.stamp / hda_1us_count;
+            n  = snprintf(buf, sizeof(buf), "<%5lu.%06lu> ", us / 1000000, us % 1000000);
+            snprintf(buf + n, sizeof(buf) - n, rec.fmt,
+                     rec.arg[0], rec.arg[1], rec.arg[2], rec.arg[3], rec.arg[4]);
+            printk("%s\r\n", buf);
+            count++;
+        }
+
+        trace_tail++;
+    }
+
+    return count;
+}
+
+void trace_dump(void)
+{
+    const unsigned char *p = (const unsigned char *)&ls2k_trace_buf;
+    static const char hex[] = "0123456789abcdef";
+    char line[8 + 8 + 2 + 64 * 2 + 2];
+    unsigned int off, i;
+    int n;
+
+    ls2k_trace_buf.count_1us = hda_1us_count;
+
+    for (off = 0; off < sizeof(ls2k_trace_buf); off += 64)
+    {
+        n = snprintf(line, sizeof(line), "@TRC %06x ", off);
+
+        for (i = 0; (i < 64) && (off + i < sizeof(ls2k_trace_buf)); i++)
+        {
+            line[n++] = hex[p[off + i] >> 4];
+            line[n++] = hex[p[off + i] & 0x0F];
+        }
+
+        line[n++] = '\r';
+        line[n++] = '\n';
+
+        console_puts(line, (size_t)n);
+    }
+}
+
+void trace_reset(void)
+{
+    memset(ls2k_trace_buf.rec, 0, sizeof(ls2k_trace_buf.rec));
+
+    ls2k_trace_buf.head = 0;
+    trace_tail = 0;
+}
+
+//-----------------------------------------------------------------------------
+/*
+ * @@ End
+ */
+
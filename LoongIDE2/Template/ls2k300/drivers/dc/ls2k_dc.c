@@ -20,8 +20,10 @@
 #include <ctype.h>
 
 #include "ls2k300.h"
+#include "ls2k300_irq.h"
 #include "ls2k_gpio.h"
 
+#include <larchintrin.h>
 #include "cpu.h"
 #include "fb.h"
 
@@ -34,10 +36,22 @@
 #include "osal.h"
 
 //-----------------------------------------------------------------------------
-// ʹ˫
+// ֡: 1=, 2=˫, 3=. ܴ DC_MAX_BUFFERS
+//
+// Ĭϵ.  1 ʱ ( bsp.h ж), ̨ڵһ
+// IOCTRL_DC_FLIP ʱŷ, лҳĳֻռһ֡.
 //-----------------------------------------------------------------------------
 
-#define DC_DOUBLE_BUFFER    1
+#ifndef DC_FB_BUFFERS
+#define DC_FB_BUFFERS       1
+#endif
+
+#if (DC_FB_BUFFERS < 1) || (DC_FB_BUFFERS > DC_MAX_BUFFERS)
+#error "DC_FB_BUFFERS must be 1..DC_MAX_BUFFERS."
+#endif
+
+#define DC_VSYNC_EVENT      0x01
+#define DC_VSYNC_TIMEOUT    100             /* ȴ VSync ĺ, һ֡ */
 
 //-----------------------------------------------------------------------------
 // ʹָڴַ
@@ -55,13 +69,20 @@ typedef struct
 
 	osal_mutex_t p_mutex;                   /* mutex */
 	
-	struct fb_fix_screeninfo fb_fix;        /* framebuffer standard device */
+	struct fb_fix_screeninfo fb_fix;        /* framebuffer standard device, smem_start ǻͼ */
 	struct fb_var_screeninfo fb_var;        /* framebuffer standard device */
 
-#if DC_DOUBLE_BUFFER
-    char *fb_1st_buffer;
-	char *fb_2nd_buffer;
-#endif
+	int   irqNum;
+	osal_event_t p_event;                   /* VSync ¼ */
+
+	char *fb_buffers[DC_FB_BUFFERS];        /* ֡ */
+	int   fb_count;                         /* ѷ֡ */
+	int   fb_front;                         /* ʾĻ */
+	volatile int fb_pending;                /* ȴһ VSync ʾĻ, -1= */
+	int   fb_draw;                          /* ͼ */
+
+	volatile unsigned int vsync_count;      /* VSync  */
+	unsigned int flip_timeouts;             /* ûеȵ VSync, ֱлĴ */
 
 	int initialized;				        /* Ƿʼ */
 	int started;				            /* Ƿ */
@@ -442,8 +463,8 @@ static int ls2k_dc_hw_initialize(DC_softc_t *dc)
 
 	/* Frame Buffer Memory Address.
 	 */
-	dc->hwDC->buf_addr     = VA_TO_PHYS(dc->fb_fix.smem_start);
-	dc->hwDC->dbl_buf_addr = VA_TO_PHYS(dc->fb_fix.smem_start);
+	dc->hwDC->buf_addr     = VA_TO_PHYS(dc->fb_buffers[dc->fb_front]);
+	dc->hwDC->dbl_buf_addr = VA_TO_PHYS(dc->fb_buffers[dc->fb_front]);
 
 	/* panel_config
 	 */
@@ -502,6 +523,9 @@ static int ls2k_dc_start(DC_softc_t *dc)
     	return -1;
     }
 
+	dc->hwDC->int_reg = DC_INT_VSYNC_EN | DC_INT_VSYNC;
+	ls2k_interrupt_enable(dc->irqNum);
+
 	dc->started = 1;
 
 	return 0;
@@ -512,12 +536,257 @@ static int ls2k_dc_start(DC_softc_t *dc)
  */
 static void ls2k_dc_stop(DC_softc_t *dc)
 {
+	ls2k_interrupt_disable(dc->irqNum);
+	dc->hwDC->int_reg = DC_INT_VSYNC;
+
 	dc->hwDC->config &= ~DC_CFG_OUTPUT_EN;
 	delay_us(100);
 
 	dc->started = 0;
 }
 
+/******************************************************************************
+ * VSync ҳл
+ *
+ * fb_draw  fb_front ʱֱʾĻϻͼ(巽ʽ). 
+ * ls2k_dc_flip() , ͼһ VSync ждַ֡Ĵ,
+ * ͼлһȲʾҲڵȴʾĻ.
+ ******************************************************************************/
+
+static void ls2k_dc_set_scanout(DC_softc_t *dc, int index)
+{
+	unsigned int addr = VA_TO_PHYS(dc->fb_buffers[index]);
+
+	dc->hwDC->buf_addr     = addr;
+	dc->hwDC->dbl_buf_addr = addr;
+	dc->fb_front = index;
+}
+
+static void ls2k_dc_interrupt_handler(int vector, void *arg)
+{
+	DC_softc_t *dc = (DC_softc_t *)arg;
+	unsigned int status;
+
+	status = dc->hwDC->int_reg;
+	dc->hwDC->int_reg = status;             /* д 1  */
+
+	if (status & DC_INT_VSYNC)
+	{
+		if (dc->fb_pending >= 0)
+		{
+			ls2k_dc_set_scanout(dc, dc->fb_pending);
+			dc->fb_pending = -1;
+		}
+
+		dc->vsync_count++;
+		osal_event_send(dc->p_event, DC_VSYNC_EVENT);
+	}
+}
+
+/*
+ * ȴһ VSync
+ */
+static int ls2k_dc_wait_vsync(DC_softc_t *dc, unsigned int timeout_ms)
+{
+	unsigned int count = dc->vsync_count;
+
+	while (dc->vsync_count == count)
+	{
+		if (osal_event_receive(dc->p_event,
+							   DC_VSYNC_EVENT,
+							   OSAL_EVENT_FLAG_AND | OSAL_EVENT_FLAG_CLEAR,
+							   timeout_ms) != DC_VSYNC_EVENT)
+		{
+			return (dc->vsync_count == count) ? -ETIMEDOUT : 0;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * ȴύлЧ. û VSync жʱл, 
+ */
+static void ls2k_dc_wait_flip_done(DC_softc_t *dc)
+{
+	while (dc->fb_pending >= 0)
+	{
+		if (ls2k_dc_wait_vsync(dc, DC_VSYNC_TIMEOUT) != 0)
+		{
+			loongarch_critical_enter();
+			if (dc->fb_pending >= 0)
+			{
+				ls2k_dc_set_scanout(dc, dc->fb_pending);
+				dc->fb_pending = -1;
+				dc->flip_timeouts++;
+			}
+			loongarch_critical_exit();
+		}
+	}
+}
+
+/*
+ * һлΪͼ
+ */
+static int ls2k_dc_next_free_buffer(DC_softc_t *dc)
+{
+	int i, index;
+
+	for (i=1; i<dc->fb_count; i++)
+	{
+		index = (dc->fb_draw + i) % dc->fb_count;
+
+		if ((index != dc->fb_front) && (index != dc->fb_pending))
+		{
+			return index;
+		}
+	}
+
+	return -1;
+}
+
+extern void *aligned_malloc(size_t size, unsigned int align);
+
+/*
+ * 䲢 index ֡
+ */
+static int ls2k_dc_alloc_buffer(DC_softc_t *dc, int index)
+{
+#if FIXED_DC_MEMADDR
+	/*
+	 * ʹָڴַ
+	 */
+	dc->fb_buffers[index] = (char *)DC_MEMORY_ADDRESS +
+	                        index * ((dc->fb_fix.smem_len + 0x3FF) & ~0x3FF);
+
+#else
+	/*
+	 * FIXME alloc framebuffer memory dynamic.
+	 */
+	dc->fb_buffers[index] = (char *)aligned_malloc(dc->fb_fix.smem_len, 0x400);
+	if (dc->fb_buffers[index] == NULL)
+	{
+		return -1;
+	}
+#endif
+
+	/*
+	 * clear the memory buffer
+	 */
+	memset((void *)dc->fb_buffers[index], 0, dc->fb_fix.smem_len);
+
+	return 0;
+}
+
+/*
+ * ̨, ֡ʱл
+ */
+static int ls2k_dc_alloc_back_buffers(DC_softc_t *dc)
+{
+	int i;
+
+	for (i=dc->fb_count; i<DC_FB_BUFFERS; i++)
+	{
+		if (ls2k_dc_alloc_buffer(dc, i) != 0)
+		{
+			break;
+		}
+	}
+
+	dc->fb_count = i;
+
+	if (dc->fb_count < 2)
+	{
+		printk("framebuffer alloc back buffer fail!\n");
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+/*
+ * ύͼ, һ VSync ʱʾ
+ *
+ * :    wait    1=ȴлЧ󷵻
+ *
+ * :    µĻͼ
+ */
+static int ls2k_dc_flip(DC_softc_t *dc, int wait)
+{
+	int next;
+
+	if (DC_FB_BUFFERS < 2)
+	{
+		if (wait)
+		{
+			ls2k_dc_wait_vsync(dc, DC_VSYNC_TIMEOUT);
+		}
+
+		return 0;
+	}
+
+	if ((dc->fb_count < 2) && (ls2k_dc_alloc_back_buffers(dc) != 0))
+	{
+		return -ENOMEM;
+	}
+
+	/*
+	 * һύлûЧ
+	 */
+	ls2k_dc_wait_flip_done(dc);
+
+	if (dc->fb_draw == dc->fb_front)
+	{
+		next = ls2k_dc_next_free_buffer(dc);
+	}
+	else
+	{
+#if FB_BUF_CACHED
+		clean_dcache((unsigned long)dc->fb_buffers[dc->fb_draw], dc->fb_fix.smem_len);
+#endif
+
+		dc->fb_pending = dc->fb_draw;
+
+		next = ls2k_dc_next_free_buffer(dc);
+		if ((next < 0) || wait)
+		{
+			ls2k_dc_wait_flip_done(dc);
+			if (next < 0)
+			{
+				next = ls2k_dc_next_free_buffer(dc);
+			}
+		}
+	}
+
+	dc->fb_draw = next;
+	dc->fb_fix.smem_start = dc->fb_buffers[next];
+
+	return next;
+}
+
+static int ls2k_dc_get_buffers(DC_softc_t *dc, DC_buffers_t *info)
+{
+	int i;
+
+	if (NULL == info)
+	{
+		return -1;
+	}
+
+	info->count   = dc->fb_count;
+	info->front   = dc->fb_front;
+	info->draw    = dc->fb_draw;
+	info->vsyncs  = dc->vsync_count;
+	info->timeouts = dc->flip_timeouts;
+
+	for (i=0; i<DC_MAX_BUFFERS; i++)
+	{
+		info->buffers[i] = (i < dc->fb_count) ? dc->fb_buffers[i] : NULL;
+	}
+
+	return 0;
+}
+
 /******************************************************************************
  * clear the memory buffer
  */
@@ -610,7 +879,6 @@ static int get_var_screen_info(DC_softc_t *dc, struct fb_var_screeninfo *info)
  * framebuffer driver implement
  ******************************************************************************/
 
-extern void *aligned_malloc(size_t size, unsigned int align);
 extern int ls2k_dc_init_hook(const void *dev);
 
 STATIC_DRV int DC_initialize(const void *dev, void *arg)
@@ -619,13 +887,6 @@ STATIC_DRV int DC_initialize(const void *dev, void *arg)
 	int xres, yres, refreshrate=60, colordepth=16;
 	unsigned int mem_len;
 
-#if !FIXED_DC_MEMADDR
-	char *fb_buffer = NULL;
-#endif
-#if DC_DOUBLE_BUFFER
-	char *fb_dbl_buffer = NULL;
-#endif
-
     if (pDC->initialized)
     {
         return 0;
@@ -664,46 +925,21 @@ STATIC_DRV int DC_initialize(const void *dev, void *arg)
 	pDC->fb_fix.line_length = xres * colordepth / 8;
 	pDC->fb_fix.smem_len = mem_len;
 
-#if FIXED_DC_MEMADDR
-	/*
-	 * ʹָڴַ
-	 */
-	pDC->fb_fix.smem_start = (char *)DC_MEMORY_ADDRESS;
-
-#else
 	/*
-	 * FIXME alloc framebuffer memory dynamic.
+	 * ̨ڵһлʱ
 	 */
-	fb_buffer = (char *)aligned_malloc(pDC->fb_fix.smem_len, 0x400);
-	if (fb_buffer == NULL)
+	if (ls2k_dc_alloc_buffer(pDC, 0) != 0)
 	{
 	    printk("framebuffer alloc memory fail!\n");
 		return -1;
 	}
 
-  #if DC_DOUBLE_BUFFER
-  	fb_dbl_buffer = (char *)aligned_malloc(pDC->fb_fix.smem_len, 0x400);
-
-    pDC->fb_1st_buffer = fb_buffer;
-    pDC->fb_2nd_buffer = fb_dbl_buffer;
-  #endif
-
-	/*
-	 * 256 byte aligned
-	 */
-	pDC->fb_fix.smem_start = fb_buffer;
-
-#endif
-
-	/*
-	 * clear the memory buffer
-	 */
-    memset((void *)pDC->fb_fix.smem_start, 0, pDC->fb_fix.smem_len);
+	pDC->fb_count = 1;
 
-#if DC_DOUBLE_BUFFER
-    if (fb_dbl_buffer)
-	    memset((void *)fb_dbl_buffer, 0, pDC->fb_fix.smem_len);
-#endif
+	pDC->fb_front   = 0;
+	pDC->fb_pending = -1;
+	pDC->fb_draw    = 0;
+	pDC->fb_fix.smem_start = pDC->fb_buffers[0];
 
 	/*
 	 * TODO only 16 color mode of R5G6B5
@@ -739,6 +975,27 @@ STATIC_DRV int DC_initialize(const void *dev, void *arg)
 		return -1;
 	}
 
+	/*
+	 * VSync ж
+	 */
+	pDC->p_event = osal_event_create("DCEvent", 0);
+	if (pDC->p_event == NULL)
+	{
+		printk("DC create event fail!\n");
+		return -1;
+	}
+
+#if USE_EXTINT
+	pDC->irqNum = EXTI2_DC_IRQ;
+#else
+	pDC->irqNum = INTC1_DC_IRQ;
+#endif
+
+	ls2k_install_irq_handler(pDC->irqNum, ls2k_dc_interrupt_handler, (void *)pDC);
+#if !USE_EXTINT
+	ls2k_set_irq_routeip(pDC->irqNum, INT_ROUTE_IP3);
+#endif
+
 	pDC->initialized = 1;
 
     DBG_OUT("display control controller initialized.\r\n");
@@ -901,6 +1158,20 @@ STATIC_DRV int DC_ioctl(const void *dev, int cmd, void *arg)
 			break;
 		}
 
+		case IOCTRL_DC_GET_BUFFERS:
+			rt = ls2k_dc_get_buffers(pDC, (DC_buffers_t *)arg);
+			break;
+
+		case IOCTRL_DC_FLIP:
+			LOCK(pDC);
+			rt = ls2k_dc_flip(pDC, (int)(long)arg);
+			UNLOCK(pDC);
+			break;
+
+		case IOCTRL_DC_WAIT_VSYNC:
+			rt = ls2k_dc_wait_vsync(pDC, arg ? (unsigned int)(long)arg : DC_VSYNC_TIMEOUT);
+			break;
+
 		case IOCTRL_LCD_POWERON:
 			break;
 
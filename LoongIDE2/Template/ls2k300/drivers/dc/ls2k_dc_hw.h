@@ -52,7 +52,11 @@ typedef struct
 	volatile unsigned int vdisplay;         /* 0x0240 - 0x1480: ֱʾ */
 	volatile unsigned int rsv12[7];
 	volatile unsigned int vsync;            /* 0x0260 - 0x14A0: ֱͬ */
-	volatile unsigned int rsv13[55];
+	volatile unsigned int rsv13[7];
+	volatile unsigned int scan_pos;         /* 0x0280 - 0x14C0: ǰɨλ */
+	volatile unsigned int rsv14[43];
+	volatile unsigned int int_reg;          /* 0x0330 - 0x1570: жϼĴ */
+	volatile unsigned int rsv15[3];
 	volatile unsigned int dbl_buf_addr;     /* 0x0340 - 0x1580: ַ֡Ĵ1 */
 } HW_DC_t;
 
@@ -123,6 +127,14 @@ typedef struct
 #define DC_VSYNC_END_SHIFT      16
 #define DC_VSYNC_START_MASK     0x00000FFF	// bit[11:0], VSync źſʼ
 
+/*
+ * Interrupt Register.  16 λ״̬, д 1 ;  16 λǶӦжʹ
+ */
+#define DC_INT_VSYNC            (1<<2)		// ʾ봹ֱ
+#define DC_INT_HSYNC            (1<<3)		// ʾˮƽ
+#define DC_INT_VSYNC_EN         (1<<18)		// 1: ʹ VSync ж
+#define DC_INT_HSYNC_EN         (1<<19)		// 1: ʹ HSync ж
+
 #ifdef __cplusplus
 }
 #endif
@@ -32,6 +32,7 @@
 
 #include "cpu.h"
 #include "fb.h"
+#include "osal.h"
 
 #include "ls2k_dc.h"
 #include "font/font_desc.h"
@@ -158,6 +159,285 @@ static FB_SOFTC_t ls2k_fb, *fb = &ls2k_fb;
 #define WR_FB32(offset, v)  (*((volatile unsigned int *)(fb->fixInfo.smem_start+(offset)))=(v))
 #define WR_FB64(offset, v)  (*((volatile unsigned long *)(fb->fixInfo.smem_start+(offset)))=(v))
 
+/******************************************************************************
+ * /
+ *
+ * ֻüһ, Ȼе fb_fill_span()/fb_copy_span(). β
+ * ְֽڶд, м䰴 64 λ(ʱ LSX  128 λ)д.
+ ******************************************************************************/
+
+#if defined(__loongarch_sx)
+#include <lsxintrin.h>
+#define SPAN_ALIGN      16
+#else
+#define SPAN_ALIGN      8
+#endif
+
+#define SPAN_HEAD(p)    ((SPAN_ALIGN - ((unsigned long)(p) & (SPAN_ALIGN - 1))) & (SPAN_ALIGN - 1))
+
+/*
+ * ɫظ 64 λ. 1/2/4 ֽ
+ */
+static inline unsigned long fb_color64(unsigned int color, int bytes_per_pixel)
+{
+	unsigned long c64;
+
+	switch (bytes_per_pixel)
+	{
+		case 1:  c64 = color & 0xFF;   c64 |= c64 << 8; c64 |= c64 << 16; break;
+		case 2:  c64 = color & 0xFFFF; c64 |= c64 << 16; break;
+		default: c64 = color & 0xFFFFFFFF; break;
+	}
+
+	return c64 | (c64 << 32);
+}
+
+/*
+ *  bytes ֽ. p صַ, framebuffer ׵ַ 8 ֽڶ, Եַ p 
+ * Ӧдֽھ c64 ĵ (p & 7) ֽ
+ */
+static void fb_fill_span(unsigned char *p, size_t bytes, unsigned long c64, unsigned xormode)
+{
+	const unsigned char *pat = (const unsigned char *)&c64;
+	size_t n;
+
+	n = SPAN_HEAD(p);
+	n = (n < bytes) ? n : bytes;
+	bytes -= n;
+
+	for ( ; n > 0; n--, p++)
+	{
+		if (xormode)
+			*p ^= pat[(unsigned long)p & 7];
+		else
+			*p  = pat[(unsigned long)p & 7];
+	}
+
+#if defined(__loongarch_sx)
+	{
+		__m128i v = __lsx_vreplgr2vr_d((long)c64);
+
+		if (xormode)
+		{
+			for ( ; bytes >= 16; bytes -= 16, p += 16)
+			{
+				__lsx_vst(__lsx_vxor_v(__lsx_vld(p, 0), v), p, 0);
+			}
+		}
+		else
+		{
+			for ( ; bytes >= 64; bytes -= 64, p += 64)
+			{
+				__lsx_vst(v, p, 0);
+				__lsx_vst(v, p, 16);
+				__lsx_vst(v, p, 32);
+				__lsx_vst(v, p, 48);
+			}
+
+			for ( ; bytes >= 16; bytes -= 16, p += 16)
+			{
+				__lsx_vst(v, p, 0);
+			}
+		}
+	}
+#endif
+
+	{
+		unsigned long *p64 = (unsigned long *)p;
+
+		if (xormode)
+		{
+			for ( ; bytes >= 8; bytes -= 8)
+			{
+				*p64++ ^= c64;
+			}
+		}
+		else
+		{
+			for ( ; bytes >= 32; bytes -= 32, p64 += 4)
+			{
+				p64[0] = c64;
+				p64[1] = c64;
+				p64[2] = c64;
+				p64[3] = c64;
+			}
+
+			for ( ; bytes >= 8; bytes -= 8)
+			{
+				*p64++ = c64;
+			}
+		}
+
+		p = (unsigned char *)p64;
+	}
+
+	for ( ; bytes > 0; bytes--, p++)
+	{
+		if (xormode)
+			*p ^= pat[(unsigned long)p & 7];
+		else
+			*p  = pat[(unsigned long)p & 7];
+	}
+}
+
+/*
+ * ǰ, dst  src ֮ǰ߲ص
+ */
+static void fb_copy_span_forward(unsigned char *dst, const unsigned char *src, size_t bytes)
+{
+	unsigned long *d64;
+	const unsigned long *s64;
+	size_t n;
+
+	n = SPAN_HEAD(dst);
+	n = (n < bytes) ? n : bytes;
+	bytes -= n;
+
+	while (n-- > 0)
+	{
+		*dst++ = *src++;
+	}
+
+#if defined(__loongarch_sx)
+	for ( ; bytes >= 64; bytes -= 64, dst += 64, src += 64)
+	{
+		__m128i v0 = __lsx_vld(src, 0);
+		__m128i v1 = __lsx_vld(src, 16);
+		__m128i v2 = __lsx_vld(src, 32);
+		__m128i v3 = __lsx_vld(src, 48);
+
+		__lsx_vst(v0, dst, 0);
+		__lsx_vst(v1, dst, 16);
+		__lsx_vst(v2, dst, 32);
+		__lsx_vst(v3, dst, 48);
+	}
+#endif
+
+	d64 = (unsigned long *)dst;
+	s64 = (const unsigned long *)src;
+
+	for ( ; bytes >= 32; bytes -= 32, d64 += 4, s64 += 4)
+	{
+		unsigned long w0 = s64[0], w1 = s64[1], w2 = s64[2], w3 = s64[3];
+
+		d64[0] = w0;
+		d64[1] = w1;
+		d64[2] = w2;
+		d64[3] = w3;
+	}
+
+	for ( ; bytes >= 8; bytes -= 8)
+	{
+		*d64++ = *s64++;
+	}
+
+	dst = (unsigned char *)d64;
+	src = (const unsigned char *)s64;
+
+	while (bytes-- > 0)
+	{
+		*dst++ = *src++;
+	}
+}
+
+/*
+ * β, dst  src ֮ص
+ */
+static void fb_copy_span_backward(unsigned char *dst, const unsigned char *src, size_t bytes)
+{
+	unsigned long *d64;
+	const unsigned long *s64;
+	size_t n;
+
+	dst += bytes;
+	src += bytes;
+
+	n = (unsigned long)dst & (SPAN_ALIGN - 1);
+	n = (n < bytes) ? n : bytes;
+	bytes -= n;
+
+	while (n-- > 0)
+	{
+		*--dst = *--src;
+	}
+
+#if defined(__loongarch_sx)
+	for ( ; bytes >= 64; bytes -= 64)
+	{
+		__m128i v0, v1, v2, v3;
+
+		dst -= 64;
+		src -= 64;
+
+		v3 = __lsx_vld(src, 48);
+		v2 = __lsx_vld(src, 32);
+		v1 = __lsx_vld(src, 16);
+		v0 = __lsx_vld(src, 0);
+
+		__lsx_vst(v3, dst, 48);
+		__lsx_vst(v2, dst, 32);
+		__lsx_vst(v1, dst, 16);
+		__lsx_vst(v0, dst, 0);
+	}
+#endif
+
+	d64 = (unsigned long *)dst;
+	s64 = (const unsigned long *)src;
+
+	for ( ; bytes >= 32; bytes -= 32)
+	{
+		unsigned long w0, w1, w2, w3;
+
+		d64 -= 4;
+		s64 -= 4;
+
+		w3 = s64[3]; w2 = s64[2]; w1 = s64[1]; w0 = s64[0];
+
+		d64[3] = w3;
+		d64[2] = w2;
+		d64[1] = w1;
+		d64[0] = w0;
+	}
+
+	for ( ; bytes >= 8; bytes -= 8)
+	{
+		*--d64 = *--s64;
+	}
+
+	dst = (unsigned char *)d64;
+	src = (const unsigned char *)s64;
+
+	while (bytes-- > 0)
+	{
+		*--dst = *--src;
+	}
+}
+
+/*
+ *  bytes ֽ,  memmove() һص. dst  src  8 ֽڵͬʱ
+ * ޷ֶ,  memmove()
+ */
+static void fb_copy_span(unsigned char *dst, const unsigned char *src, size_t bytes)
+{
+	if ((dst == src) || (bytes == 0))
+	{
+		return;
+	}
+
+	if (((unsigned long)dst ^ (unsigned long)src) & 7)
+	{
+		memmove(dst, src, bytes);
+	}
+	else if ((dst < src) || (dst >= src + bytes))
+	{
+		fb_copy_span_forward(dst, src, bytes);
+	}
+	else
+	{
+		fb_copy_span_backward(dst, src, bytes);
+	}
+}
+
 int fb_get_pixelsx(void)
 {
 	if (fb->dc != NULL)
@@ -317,119 +597,538 @@ void fb_draw_gb2312_char(int x, int y, unsigned char *str)
 }
 
 /*
- * ı
+ * ı
+ */
+void fb_textout(int x, int y, char *str)
+{
+	char *pch = str;
+	int   dx = 0;
+
+	if (fb->dc == NULL)
+	{
+		return;
+	}
+
+	while (*pch)
+	{
+		font_desc_t *ft_desc = get_font_desc((const unsigned char *)pch, false);
+
+		if (ft_desc != NULL)
+		{
+			ft_desc->draw_font(x + dx, y, (const unsigned char *)pch);
+
+			dx  += ft_desc->width + COL_GAP;
+			pch += ft_desc->get_char_size(NULL);
+		}
+		else
+		{
+			dx  += CONS_FONT_WIDTH + COL_GAP;
+			pch += 1;
+		}
+	}
+}
+
+/******************************************************************************
+ * FrameBuffer As Console Output
+ ******************************************************************************/
+
+#define FB_ADDR_ASC(r, c) ((((r)*fb->varInfo.xres*(CONS_FONT_HEIGHT+ROW_GAP))+ \
+						   ((c)*(CONS_FONT_WIDTH+COL_GAP)))*fb->bytes_per_pixel)
+
+/*
+ * ֻ̨дַӰӻ fb->cells, ¼ÿезΧ; ֻƶӰ
+ * Ļʼ cons_origin, ۼƵ pending_scroll.
+ *
+ * fb_cons_flush() ʱȰ framebuffer һ pending_scroll , ֻػ
+ * ַԪ. OS ʱɺ̨ VSync ˢ, ÿ֡һ;  OS ǰ
+ * ÿ fb_cons_putc()/fb_cons_puts() ǰˢ.
+ *
+ * 16 λɫʱַԪչõ RGB565 ģ밴 64 λд, ǰͱһд.
+ */
+
+#define FB_CELL_BLANK		0x0000		/* հ׵Ԫ */
+#define FB_CELL_WIDE_R		0xFFFF		/* ֵҰԪ */
+
+#define FB_CONS_FLUSH_MS	16			/* û VSync жʱˢ */
+
+#define FB_GLYPH_GB_CACHE	64			/* ģ, ֱӳ */
+
+#define FB_CONS_TASK_NAME	"FB_cons"
+#define FB_CONS_STK_SIZE	4096
+
+#if defined(OS_RTTHREAD)
+#define FB_CONS_TASK_PRIO		28
+#define FB_CONS_TASK_SLICE		10
+#elif defined(OS_UCOS)
+#define FB_CONS_TASK_PRIO		60
+#define FB_CONS_TASK_SLICE		10
+#elif defined(OS_FREERTOS)
+#define FB_CONS_TASK_PRIO		28
+#define FB_CONS_TASK_SLICE		0
+#else // Bare-Metal
+#define FB_CONS_TASK_PRIO		0
+#define FB_CONS_TASK_SLICE		0
+#endif
+
+typedef struct
+{
+	unsigned short ch;					/* ASCII  GB2312 (ֽڸ 8 λ) */
+	unsigned char  fg;					/* ǰɫ */
+	unsigned char  bg;					/* ɫ */
+} FB_CELL_t;
+
+typedef struct
+{
+	unsigned short lo;					/* зΧ, lo > hi ʾɾ */
+	unsigned short hi;
+} FB_DIRTY_t;
+
+/*
+ * չģ: ÿ 16 λ, Ϊ 1 Ϊ 0xFFFF
+ */
+typedef struct
+{
+	unsigned long mask[CONS_FONT_HEIGHT][2];				/* 8  */
+} FB_GLYPH_ASC_t;
+
+typedef struct
+{
+	unsigned short code;									/* 0: Ч */
+	unsigned long  mask[CONS_FONT_HEIGHT][4];				/* 16  */
+} FB_GLYPH_GB_t;
+
+typedef struct
+{
+	unsigned long  asc_valid[256/64];
+	FB_GLYPH_ASC_t asc[256];
+	FB_GLYPH_GB_t  gb[FB_GLYPH_GB_CACHE];
+} FB_GLYPH_CACHE_t;
+
+typedef struct
+{
+	FB_CELL_t    *cells;				/* Rows*Cols Ԫ, д */
+	FB_DIRTY_t   *dirty;				/* ÿезΧ */
+	FB_GLYPH_CACHE_t *glyphs;			/* 16 λɫʱģ */
+
+	unsigned int  origin;				/* Ļ 0 жӦ */
+	unsigned int  pending_scroll;		/* δƵĹ */
+	volatile int  dirty_any;
+
+	osal_mutex_t  mutex;
+	osal_task_t   task;
+} FB_CONS_t;
+
+static FB_CONS_t fb_cons;
+
+/*
+ * 4 λ(λ)չ 4  RGB565 
+ */
+#define EXPAND4(n)	((((n) & 8) ? 0x000000000000FFFFUL : 0) | \
+					 (((n) & 4) ? 0x00000000FFFF0000UL : 0) | \
+					 (((n) & 2) ? 0x0000FFFF00000000UL : 0) | \
+					 (((n) & 1) ? 0xFFFF000000000000UL : 0))
+
+static const unsigned long m_expand4[16] =
+{
+	EXPAND4(0),  EXPAND4(1),  EXPAND4(2),  EXPAND4(3),
+	EXPAND4(4),  EXPAND4(5),  EXPAND4(6),  EXPAND4(7),
+	EXPAND4(8),  EXPAND4(9),  EXPAND4(10), EXPAND4(11),
+	EXPAND4(12), EXPAND4(13), EXPAND4(14), EXPAND4(15),
+};
+
+#define CONS_LOCK()		do { if (fb_cons.mutex) osal_mutex_obtain(fb_cons.mutex, OSAL_WAIT_FOREVER); } while (0)
+#define CONS_UNLOCK()	do { if (fb_cons.mutex) osal_mutex_release(fb_cons.mutex); } while (0)
+
+#define CONS_ROW(r)		(fb_cons.cells + (((fb_cons.origin + (r)) % fb->Rows) * fb->Cols))
+#define CONS_DIRTY(r)	(fb_cons.dirty + ((fb_cons.origin + (r)) % fb->Rows))
+
+/*
+ * ԪַתΪֿʹõַ
+ */
+static int fb_cell_to_str(unsigned short ch, unsigned char *str)
+{
+	if (ch > 0xFF)
+	{
+		str[0] = ch >> 8;
+		str[1] = ch & 0xFF;
+		str[2] = 0;
+		return 2;
+	}
+
+	str[0] = ch;
+	str[1] = 0;
+	return 1;
+}
+
+/*
+ * ȡչģ. ûģʱ NULL, հ׵Ԫ
+ */
+static const unsigned long *fb_glyph_get(unsigned short ch)
+{
+	FB_GLYPH_CACHE_t *gc = fb_cons.glyphs;
+	unsigned long (*mask)[4];
+	unsigned char str[4], *font_buf;
+	font_desc_t *font;
+	int buflen, row, wide;
+
+	if ((ch == FB_CELL_BLANK) || (ch == ' '))
+	{
+		return NULL;
+	}
+
+	wide = (ch > 0xFF);
+
+	if (!wide)
+	{
+		if (gc->asc_valid[ch >> 6] & (1UL << (ch & 63)))
+		{
+			return &gc->asc[ch].mask[0][0];
+		}
+	}
+	else
+	{
+		FB_GLYPH_GB_t *g = &gc->gb[(ch ^ (ch >> 6)) & (FB_GLYPH_GB_CACHE - 1)];
+
+		if (g->code == ch)
+		{
+			return &g->mask[0][0];
+		}
+
+		g->code = 0;
+	}
+
+	fb_cell_to_str(ch, str);
+
+	font = get_font_desc(str, false);
+	if ((font == NULL) || (font->height != CONS_FONT_HEIGHT) ||
+		(font->width != (wide ? 2 : 1) * CONS_FONT_WIDTH))
+	{
+		return NULL;
+	}
+
+	font_buf = font->get_font_data(str, &buflen);
+	if (font_buf == NULL)
+	{
+		return NULL;
+	}
+
+	if (!wide)
+	{
+		FB_GLYPH_ASC_t *g = &gc->asc[ch];
+
+		for (row = 0; row < CONS_FONT_HEIGHT; row++)
+		{
+			g->mask[row][0] = m_expand4[font_buf[row] >> 4];
+			g->mask[row][1] = m_expand4[font_buf[row] & 0x0F];
+		}
+
+		gc->asc_valid[ch >> 6] |= 1UL << (ch & 63);
+		return &g->mask[0][0];
+	}
+
+	FB_GLYPH_GB_t *g = &gc->gb[(ch ^ (ch >> 6)) & (FB_GLYPH_GB_CACHE - 1)];
+
+	mask = g->mask;
+	for (row = 0; row < CONS_FONT_HEIGHT; row++)
+	{
+		mask[row][0] = m_expand4[font_buf[row*2] >> 4];
+		mask[row][1] = m_expand4[font_buf[row*2] & 0x0F];
+		mask[row][2] = m_expand4[font_buf[row*2+1] >> 4];
+		mask[row][3] = m_expand4[font_buf[row*2+1] & 0x0F];
+	}
+
+	g->code = ch;
+	return &mask[0][0];
+}
+
+/*
+ * 16 λɫ: ǰͱһ 64 λдһԪ. ռԪ
+ */
+static void fb_cons_draw_cell16(int row, int col, const FB_CELL_t *cell)
+{
+	const unsigned long *mask = fb_glyph_get(cell->ch);
+	unsigned long fg64 = fb_color64(m_color_map[cell->fg], 2);
+	unsigned long bg64 = fb_color64(m_color_map[cell->bg], 2);
+	int i, y, words = (cell->ch > 0xFF) ? 4 : 2;
+
+	y = row * (CONS_FONT_HEIGHT+ROW_GAP);
+
+	for (i = 0; i < CONS_FONT_HEIGHT; i++)
+	{
+		volatile unsigned long *p = (volatile unsigned long *)
+			(fb->lineAddr[y + i] + col * (CONS_FONT_WIDTH+COL_GAP) * 2);
+
+		if (mask == NULL)
+		{
+			p[0] = bg64;
+			p[1] = bg64;
+			if (words == 4)
+			{
+				p[2] = bg64;
+				p[3] = bg64;
+			}
+		}
+		else if (words == 2)
+		{
+			p[0] = (mask[0] & fg64) | (~mask[0] & bg64);
+			p[1] = (mask[1] & fg64) | (~mask[1] & bg64);
+			mask += 2;
+		}
+		else
+		{
+			p[0] = (mask[0] & fg64) | (~mask[0] & bg64);
+			p[1] = (mask[1] & fg64) | (~mask[1] & bg64);
+			p[2] = (mask[2] & fg64) | (~mask[2] & bg64);
+			p[3] = (mask[3] & fg64) | (~mask[3] & bg64);
+			mask += 4;
+		}
+	}
+}
+
+/*
+ * ɫ: 䱳ֿ
+ */
+static void fb_cons_draw_cell(int row, int col, const FB_CELL_t *cell)
+{
+	unsigned char str[4];
+	font_desc_t *font;
+	int i, x, y, width, fg_save;
+
+	x = col * (CONS_FONT_WIDTH+COL_GAP);
+	y = row * (CONS_FONT_HEIGHT+ROW_GAP);
+	width = ((cell->ch > 0xFF) ? 2 : 1) * (CONS_FONT_WIDTH+COL_GAP);
+
+	for (i = 0; i < CONS_FONT_HEIGHT+ROW_GAP; i++)
+	{
+		fb_fill_span(fb->lineAddr[y + i] + x * fb->bytes_per_pixel,
+					 width * fb->bytes_per_pixel,
+					 fb_color64(m_color_map[cell->bg], fb->bytes_per_pixel),
+					 0);
+	}
+
+	if ((cell->ch == FB_CELL_BLANK) || (cell->ch == ' '))
+	{
+		return;
+	}
+
+	fb_cell_to_str(cell->ch, str);
+
+	font = get_font_desc(str, false);
+	if (font != NULL)
+	{
+		fg_save = fb->fg_coloridx;
+		fb->fg_coloridx = cell->fg;
+		font->draw_font(x, y, str);
+		fb->fg_coloridx = fg_save;
+	}
+}
+
+/*
+ * Ļ row  [c1, c2] Ҫػ
+ */
+static void fb_cons_mark(unsigned int row, unsigned int c1, unsigned int c2)
+{
+	FB_DIRTY_t *d = CONS_DIRTY(row);
+
+	if (d->lo > c1) d->lo = c1;
+	if (d->hi < c2) d->hi = c2;
+
+	fb_cons.dirty_any = 1;
+}
+
+static void fb_cons_clear_row(unsigned int row)
+{
+	FB_CELL_t *cell = CONS_ROW(row);
+	unsigned int col;
+
+	for (col = 0; col < fb->Cols; col++)
+	{
+		cell[col].ch = FB_CELL_BLANK;
+		cell[col].fg = fb->fg_coloridx & 0xFF;
+		cell[col].bg = fb->bg_coloridx & 0xFF;
+	}
+
+	fb_cons_mark(row, 0, fb->Cols - 1);
+}
+
+/*
+ * дһԪ, ݲʱ
+ */
+static void fb_cons_set_cell(unsigned int row, unsigned int col, unsigned short ch)
+{
+	FB_CELL_t *cell = CONS_ROW(row) + col;
+	unsigned char fg = fb->fg_coloridx & 0xFF;
+	unsigned char bg = fb->bg_coloridx & 0xFF;
+
+	if ((cell->ch != ch) || (cell->fg != fg) || (cell->bg != bg))
+	{
+		cell->ch = ch;
+		cell->fg = fg;
+		cell->bg = bg;
+		fb_cons_mark(row, col, col);
+	}
+}
+
+/*
+ * : ֻƶӰӻʼ, framebuffer ˢʱһΰ
+ */
+static void fb_cons_scroll(void)
+{
+	fb->curRow++;
+
+	if (fb->curRow > (fb->Rows - 1))
+	{
+		fb_cons.origin = (fb_cons.origin + 1) % fb->Rows;
+		if (fb_cons.pending_scroll < fb->Rows)
+		{
+			fb_cons.pending_scroll++;
+		}
+
+		/* кŲ */
+		fb->curCol = 0;
+		fb->curRow--;
+		fb_cons_clear_row(fb->curRow);
+	}
+}
+
+/*
+ * Ӱӻı仯 framebuffer. ߳
  */
-void fb_textout(int x, int y, char *str)
+static void fb_cons_flush_locked(void)
 {
-	char *pch = str;
-	int   dx = 0;
+	unsigned int row, col, lo, hi;
+	int fast;
 
-	if (fb->dc == NULL)
+	if ((fb->dc == NULL) || (fb_cons.cells == NULL) || !fb_cons.dirty_any)
 	{
 		return;
 	}
 
-	while (*pch)
+	if (fb_cons.pending_scroll >= fb->Rows)
 	{
-		font_desc_t *ft_desc = get_font_desc((const unsigned char *)pch, false);
+		for (row = 0; row < fb->Rows; row++)
+		{
+			fb_cons_mark(row, 0, fb->Cols - 1);
+		}
+	}
+	else if (fb_cons.pending_scroll > 0)
+	{
+		fb_copy_span((unsigned char *)fb->fixInfo.smem_start,
+					 (unsigned char *)fb->fixInfo.smem_start + FB_ADDR_ASC(fb_cons.pending_scroll, 0),
+					 FB_ADDR_ASC(fb->Rows - fb_cons.pending_scroll, 0));
+	}
 
-		if (ft_desc != NULL)
+	fb_cons.pending_scroll = 0;
+	fb_cons.dirty_any = 0;
+
+	fast = (fb_cons.glyphs != NULL) && (fb->bytes_per_pixel == 2) &&
+		   !((unsigned long)fb->fixInfo.smem_start & 7) && !(fb->fixInfo.line_length & 7);
+
+	for (row = 0; row < fb->Rows; row++)
+	{
+		FB_DIRTY_t *d = CONS_DIRTY(row);
+		FB_CELL_t *cell = CONS_ROW(row);
+
+		if (d->lo > d->hi)
 		{
-			ft_desc->draw_font(x + dx, y, (const unsigned char *)pch);
+			continue;
+		}
 
-			dx  += ft_desc->width + COL_GAP;
-			pch += ft_desc->get_char_size(NULL);
+		lo = d->lo;
+		hi = d->hi;
+		d->lo = 0xFFFF;
+		d->hi = 0;
+
+		/* Ӻм俪ʼ */
+		if ((lo > 0) && (cell[lo].ch == FB_CELL_WIDE_R))
+		{
+			lo--;
 		}
-		else
+
+		for (col = lo; col <= hi; col++)
 		{
-			dx  += CONS_FONT_WIDTH + COL_GAP;
-			pch += 1;
+			if (cell[col].ch == FB_CELL_WIDE_R)
+			{
+				continue;
+			}
+
+			if (fast)
+				fb_cons_draw_cell16(row, col, &cell[col]);
+			else
+				fb_cons_draw_cell(row, col, &cell[col]);
 		}
 	}
 }
 
-/******************************************************************************
- * FrameBuffer As Console Output
- ******************************************************************************/
-
-#define FB_ADDR_ASC(r, c) ((((r)*fb->varInfo.xres*(CONS_FONT_HEIGHT+ROW_GAP))+ \
-						   ((c)*(CONS_FONT_WIDTH+COL_GAP)))*fb->bytes_per_pixel)
-
 /*
- * clear a row of framebuffer
+ * ̨ˢ: ÿ VSync ˢһ
  */
-static void fb_cons_clear_row(int row)
+static void fb_cons_flush_task(void *arg)
 {
-	unsigned long mem_off, wr64;
-	unsigned short wr16;
-	int i, count;
-
-	/* clear the desired row */
-	mem_off = FB_ADDR_ASC(row, 0);
-	wr16 = m_color_map[fb->bg_coloridx];
-
-#ifdef __loongarch64
-    wr64  = ((unsigned long)wr16 << 48) |
-            ((unsigned long)wr16 << 32) |
-            ((unsigned long)wr16 << 16) |
-             (unsigned long)wr16;
-    count = ((fb->varInfo.xres * (CONS_FONT_HEIGHT+ROW_GAP)) * 2) / sizeof(unsigned long);
-
-	for (i = 0; i < count; i++)
+	for ( ; ; )
 	{
-		WR_FB64(mem_off, wr64);
-		mem_off += sizeof(unsigned long);
-	}
+		if (fb->dc == NULL)
+		{
+			osal_task_sleep(FB_CONS_FLUSH_MS);
+			continue;
+		}
 
-#else
-    count = ((fb->varInfo.xres * (CONS_FONT_HEIGHT+ROW_GAP)) * 2) / sizeof(unsigned short);
+		ls2k_dc_ioctl(fb->dc, IOCTRL_DC_WAIT_VSYNC, (void *)(long)FB_CONS_FLUSH_MS);
 
-	for (i = 0; i < count; i++)
-	{
-		WR_FB16(mem_off, wr16);
-		mem_off += sizeof(unsigned short);
+		if (fb_cons.dirty_any)
+		{
+			fb_cons_flush();
+		}
 	}
-#endif
 }
 
 /*
- * : ֱӰframe buffer
+ * : OS ʱ̨, ˢ
  */
-static void fb_cons_scroll(void)
+static void fb_cons_kick(void)
 {
-	/*
-	 * XXX: ȷϵַ 8 ֽڶ!
-	 */
-	unsigned int count;
-	size_t *pdst, *psrc;
-
-	fb->curRow++;
-
-	if (fb->curRow > (fb->Rows - 1))
+	if (osal_is_osrunning())
 	{
-		pdst  = (unsigned long *)fb->fixInfo.smem_start;
-		psrc  = (unsigned long *)(fb->fixInfo.smem_start + FB_ADDR_ASC(1, 0));
-		count = (unsigned int)(fb->varInfo.xres*(fb->varInfo.yres-(CONS_FONT_HEIGHT+ROW_GAP))*2/sizeof(size_t));
+		if (fb_cons.task == NULL)
+		{
+			fb_cons.task = osal_task_create(FB_CONS_TASK_NAME,
+											FB_CONS_STK_SIZE,
+											FB_CONS_TASK_PRIO,
+											FB_CONS_TASK_SLICE,
+											fb_cons_flush_task,
+											NULL);
+		}
 
-		for (int i=0; i<count; i++)
+		if (fb_cons.task != NULL)
 		{
-			*pdst++ = *psrc++;
+			return;
 		}
+	}
 
-		/* кŲ */
-		fb->curCol = 0;
-		fb->curRow--;
-		fb_cons_clear_row(fb->curRow);
+	fb_cons_flush_locked();
+}
+
+/*
+ * ѿ̨ framebuffer
+ */
+void fb_cons_flush(void)
+{
+	if (fb->dc == NULL)
+	{
+		return;
 	}
+
+	CONS_LOCK();
+	fb_cons_flush_locked();
+	CONS_UNLOCK();
 }
 
 /*
- * console һַ
+ * console һַ, ߳
  */
-void fb_cons_putc(char chr)
+static void fb_cons_putc_locked(char chr)
 {
-	int x, y;
-	font_desc_t *ft_desc;
+	unsigned char uch = (unsigned char)chr;
 
 	/* First parse the character to see if it printable or an acceptable
 	 * control character. */
@@ -445,42 +1144,42 @@ void fb_cons_putc(char chr)
 			return;
 
 		case '\b':
-			fb->curCol--;
-			if (fb->curCol < 0)
+			if (fb->curCol > 0)
+			{
+				fb->curCol--;
+			}
+			else if (fb->curRow > 0)
 			{
 				fb->curRow--;
-				if (fb->curRow < 0)
-				{
-                	fb->curRow = 0;
-                }
-				fb->curCol = fb->Cols- 1;
+				fb->curCol = fb->Cols - 1;
 			}
 
-			/* erase the character, write a SPACE */
-			chr = 20;
-			x = fb->curCol*(CONS_FONT_WIDTH+COL_GAP);
-			y = fb->curRow*(CONS_FONT_HEIGHT+ROW_GAP);
-
-			ft_desc = get_font_desc((const unsigned char *)&chr, false);
-			if (ft_desc != NULL)
+			/* erase the character */
+			if (CONS_ROW(fb->curRow)[fb->curCol].ch == FB_CELL_WIDE_R)
 			{
-				ft_desc->draw_font(x, y, (const unsigned char *)&chr);
+				fb_cons_set_cell(fb->curRow, fb->curCol - 1, FB_CELL_BLANK);
 			}
-
+			fb_cons_set_cell(fb->curRow, fb->curCol, FB_CELL_BLANK);
 			break;
 
 		default:
 			/* drop anything we can't print */
-			ft_desc = get_font_desc((const unsigned char *)&chr, false);
-			if (ft_desc == NULL)
+			if (get_font_desc(&uch, false) == NULL)
 			{
             	return;
             }
 
-			/* get aligned to the first printable character */
-			x = fb->curCol*(CONS_FONT_WIDTH+COL_GAP);
-			y = fb->curRow*(CONS_FONT_HEIGHT+ROW_GAP);
-			ft_desc->draw_font(x, y, (const unsigned char *)&chr);
+			/* Ǻֵһʱ */
+			if (CONS_ROW(fb->curRow)[fb->curCol].ch == FB_CELL_WIDE_R)
+			{
+				fb_cons_set_cell(fb->curRow, fb->curCol - 1, FB_CELL_BLANK);
+			}
+			else if ((CONS_ROW(fb->curRow)[fb->curCol].ch > 0xFF) && (fb->curCol + 1 < fb->Cols))
+			{
+				fb_cons_set_cell(fb->curRow, fb->curCol + 1, FB_CELL_BLANK);
+			}
+
+			fb_cons_set_cell(fb->curRow, fb->curCol, uch);
 
 			/* advance to next column */
 			fb->curCol++;
@@ -494,24 +1193,41 @@ void fb_cons_putc(char chr)
 	}
 }
 
+/*
+ * console һַ
+ */
+void fb_cons_putc(char chr)
+{
+	if ((fb->dc == NULL) || (fb_cons.cells == NULL))
+	{
+    	return;
+    }
+
+	CONS_LOCK();
+	fb_cons_putc_locked(chr);
+	fb_cons_kick();
+	CONS_UNLOCK();
+}
+
 /*
  * һַ
  */
 void fb_cons_puts(char *str)
 {
-	int   x, y;
 	char *pch = str;
 
-	if (fb->dc == NULL)
+	if ((fb->dc == NULL) || (fb_cons.cells == NULL))
 	{
     	return;
     }
 
+	CONS_LOCK();
+
 	while (*pch)
 	{
 		if (!(*pch & 0x80))
 		{
-			fb_cons_putc(*pch++);
+			fb_cons_putc_locked(*pch++);
 		}
 
 		/**************************************************
@@ -520,7 +1236,7 @@ void fb_cons_puts(char *str)
 		else
 		{
 			font_desc_t *ft_desc = get_font_desc((const unsigned char *)pch, false);
-			if (ft_desc != NULL)
+			if ((ft_desc != NULL) && (pch[1] != 0))
 			{
 				if ((fb->Cols - fb->curCol) < 2)
 				{
@@ -529,9 +1245,18 @@ void fb_cons_puts(char *str)
 				}
 
 				/* ʾһ */
-				x = fb->curCol*(CONS_FONT_WIDTH+COL_GAP);
-				y = fb->curRow*(CONS_FONT_HEIGHT+ROW_GAP);
-				ft_desc->draw_font(x, y, (const unsigned char *)pch);
+				if (CONS_ROW(fb->curRow)[fb->curCol].ch == FB_CELL_WIDE_R)
+				{
+					fb_cons_set_cell(fb->curRow, fb->curCol - 1, FB_CELL_BLANK);
+				}
+				if ((fb->curCol + 2 < fb->Cols) && (CONS_ROW(fb->curRow)[fb->curCol + 2].ch == FB_CELL_WIDE_R))
+				{
+					fb_cons_set_cell(fb->curRow, fb->curCol + 2, FB_CELL_BLANK);
+				}
+
+				fb_cons_set_cell(fb->curRow, fb->curCol,
+								 ((unsigned char)pch[0] << 8) | (unsigned char)pch[1]);
+				fb_cons_set_cell(fb->curRow, fb->curCol + 1, FB_CELL_WIDE_R);
 
 				fb->curCol += 2;
 				if (fb->curCol == fb->Cols)
@@ -542,13 +1267,42 @@ void fb_cons_puts(char *str)
 			}
 			else
 			{
-				fb_cons_putc('?');
-				fb_cons_putc('?');
+				fb_cons_putc_locked('?');
+				fb_cons_putc_locked('?');
 			}
 
-			pch += 2;
+			pch += (pch[1] != 0) ? 2 : 1;
 		}
 	}
+
+	fb_cons_kick();
+
+	CONS_UNLOCK();
+}
+
+/*
+ * ӰӻȫΪհ, ػ
+ */
+static void fb_cons_reset(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < fb->Rows * fb->Cols; i++)
+	{
+		fb_cons.cells[i].ch = FB_CELL_BLANK;
+		fb_cons.cells[i].fg = fb->fg_coloridx & 0xFF;
+		fb_cons.cells[i].bg = fb->bg_coloridx & 0xFF;
+	}
+
+	for (i = 0; i < fb->Rows; i++)
+	{
+		fb_cons.dirty[i].lo = 0xFFFF;
+		fb_cons.dirty[i].hi = 0;
+	}
+
+	fb_cons.origin = 0;
+	fb_cons.pending_scroll = 0;
+	fb_cons.dirty_any = 0;
 }
 
 /*
@@ -556,31 +1310,71 @@ void fb_cons_puts(char *str)
  */
 void fb_cons_clear(void)
 {
-	int i, fbsize;
-	unsigned short wr16;
-	unsigned long wr64;
+	if (fb->dc == NULL)
+	{
+		return;
+	}
 
-	fbsize = fb->varInfo.xres*fb->varInfo.yres*fb->bytes_per_pixel;
-	wr16 = m_color_map[fb->bg_coloridx];
+	CONS_LOCK();
 
-#ifdef __loongarch64
-    wr64  = ((unsigned long)wr16 << 48) |
-            ((unsigned long)wr16 << 32) |
-            ((unsigned long)wr16 << 16) |
-             (unsigned long)wr16;
+	fb_fill_span((unsigned char *)fb->fixInfo.smem_start,
+				 fb->varInfo.xres * fb->varInfo.yres * fb->bytes_per_pixel,
+				 fb_color64(m_color_map[fb->bg_coloridx], fb->bytes_per_pixel),
+				 0);
 
-	for (i = 0; i < fbsize; i += sizeof(unsigned long))
+	/* ĻѾǿհ, Ӱӻ岻Ҫػ */
+	if (fb_cons.cells != NULL)
 	{
-    	WR_FB64(i, wr64);
-    }
+		fb_cons_reset();
+	}
 
-#else
-	for (i = 0; i < fbsize; i += sizeof(unsigned short))
+	CONS_UNLOCK();
+}
+
+/*
+ * ̨Ӱӻ
+ */
+static int fb_cons_open(void)
+{
+	fb_cons.cells  = malloc(sizeof(FB_CELL_t) * fb->Rows * fb->Cols);
+	fb_cons.dirty  = malloc(sizeof(FB_DIRTY_t) * fb->Rows);
+	fb_cons.glyphs = NULL;
+
+	if ((fb_cons.cells == NULL) || (fb_cons.dirty == NULL))
 	{
-    	WR_FB16(i, wr16);
-    }
+		return -1;
+	}
 
-#endif
+	/* ģֻ 16 λɫʱʹ, 䲻ʱ */
+	if (fb->bytes_per_pixel == 2)
+	{
+		fb_cons.glyphs = calloc(1, sizeof(FB_GLYPH_CACHE_t));
+	}
+
+	if (fb_cons.mutex == NULL)
+	{
+		fb_cons.mutex = osal_mutex_create("FBCons", OSAL_OPT_FIFO);
+	}
+
+	/* ʱĻе */
+	fb_cons_reset();
+
+	return 0;
+}
+
+static void fb_cons_close(void)
+{
+	CONS_LOCK();
+
+	free(fb_cons.cells);
+	free(fb_cons.dirty);
+	free(fb_cons.glyphs);
+
+	fb_cons.cells  = NULL;
+	fb_cons.dirty  = NULL;
+	fb_cons.glyphs = NULL;
+
+	CONS_UNLOCK();
 }
 
 /******************************************************************************
@@ -647,17 +1441,63 @@ int fb_open(void)
     	fb->lineAddr[y] = (void *)fb->fixInfo.smem_start + off;
     }
 
+	if (fb_cons_open() != 0)
+	{
+		fb_close();
+		return -1;
+	}
+
     DBG_OUT("framebuffer open successful.\r\n");
 
 	return 0;
 }
 
+/*
+ * ʾǰͼ, ֮ĻͼµĻͼϽ.
+ * ʱֻȴ VSync.
+ *
+ * :    wait    1=ȴлЧ󷵻
+ */
+int fb_flip(int wait)
+{
+	unsigned y, off;
+	int rt;
+
+	if (fb->dc == NULL)
+	{
+		return -1;
+	}
+
+	rt = ls2k_dc_ioctl(fb->dc, IOCTRL_DC_FLIP, (void *)(long)wait);
+	if (rt < 0)
+	{
+		return rt;
+	}
+
+	/* ̨ˢͬʱھɻϻ */
+	CONS_LOCK();
+
+	ls2k_dc_ioctl(fb->dc, FBIOGET_FSCREENINFO, &fb->fixInfo);
+
+	off = 0;
+	for (y = 0; y < fb->varInfo.yres; y++, off += fb->fixInfo.line_length)
+	{
+    	fb->lineAddr[y] = (void *)fb->fixInfo.smem_start + off;
+    }
+
+	CONS_UNLOCK();
+
+	return rt;
+}
+
 void fb_close(void)
 {
 	if (fb->dc != NULL)
 	{
 		ls2k_dc_close(fb->dc, NULL);
 
+		fb_cons_close();
+
         free(fb->lineAddr);
 
 		fb->dc = NULL;
@@ -912,6 +1752,22 @@ void fb_fillrect(int x1, int y1, int x2, int y2, unsigned coloridx)
 
 	coloridx = m_color_map[coloridx];
 
+	/*
+	 * 1/2/4 ֽذ
+	 */
+	if (fb->bytes_per_pixel != 3)
+	{
+		unsigned long c64 = fb_color64(coloridx, fb->bytes_per_pixel);
+		size_t bytes = (x2 - x1 + 1) * fb->bytes_per_pixel;
+
+		for ( ; y1 <= y2; y1++)
+		{
+			fb_fill_span(fb->lineAddr[y1] + x1 * fb->bytes_per_pixel, bytes, c64, xormode);
+		}
+
+		return;
+	}
+
 	for ( ; y1 <= y2; y1++)
 	{
 		loc.p8 = fb->lineAddr[y1] + x1 * fb->bytes_per_pixel;
@@ -924,117 +1780,96 @@ void fb_fillrect(int x1, int y1, int x2, int y2, unsigned coloridx)
 }
 
 /*
- * copy rectangle to point, destination is out of source
+ * ü, ʹ [x1, x2]  [x1+dx, x2+dx]  [0, size-1] ֮
  */
-static void fb_copyrect_internal(int x1, int y1, int x2, int y2, int px, int py)
+static inline void fb_clip_range(int *x1, int *x2, int dx, int size)
 {
-	unsigned int src_off, dst_off;
-	unsigned short color;
-	int x, y, dx, dy;
-
-	dx = px - x1;
-	dy = py - y1;
-
-	for (y=y1; y<=y2; y++)
-	{
-		if ((y < 0) || (y >= fb->varInfo.yres) || (y + dy < 0) || (y + dy >= fb->varInfo.yres))
-		{
-        	continue;
-        }
-
-		for (x=x1; x<=x2; x++)
-		{
-			if ((x < 0) || (x >= fb->varInfo.xres) || (x + dx < 0) || (x + dx >= fb->varInfo.xres))
-			{
-            	continue;
-            }
-
-			src_off = FB_ADDR_OFF(x, y);
-			color   = RD_FB16(src_off);
-			dst_off = FB_ADDR_OFF(x + dx, y + dy);
-			WR_FB16(dst_off, color);
-		}
-	}
+	if (*x1 < 0)         *x1 = 0;
+	if (*x1 < -dx)       *x1 = -dx;
+	if (*x2 >= size)     *x2 = size - 1;
+	if (*x2 >= size - dx) *x2 = size - dx - 1;
 }
 
 /*
  * copy rectangle to point
+ *
+ * ԴĿصʱ, Ŀ·һпʼ; ͬһ fb_copy_span()
+ * ֤صȷ.
  */
 void fb_copyrect(int x1, int y1, int x2, int y2, int px, int py)
 {
-    int _x2 = px + x2 - x1;
-    int _y2 = py + y2 - y1;
+	int tmp, dx, dy, y;
+	size_t bytes;
+
+	if (x1 > x2) { tmp = x1; x1 = x2; x2 = tmp; }
+	if (y1 > y2) { tmp = y1; y1 = y2; y2 = tmp; }
+
+	dx = px - x1;
+	dy = py - y1;
 
     /* if same, do nothing */
-    if ((px == x1) && (py == y1))
-    {
-        return;
-    }
+	if ((dx == 0) && (dy == 0))
+	{
+		return;
+	}
 
-    /* -> vertical & down */
-    else if ((px == x1) && (py > y1) && (py <= y2))
-    {
-        fb_copyrect_internal(x1, py, x2, y2,     px, py * 2 - y1);
-		fb_copyrect_internal(x1, y1, x2, py - 1, px, py);
-    }
+	fb_clip_range(&x1, &x2, dx, (int)fb->varInfo.xres);
+	fb_clip_range(&y1, &y2, dy, (int)fb->varInfo.yres);
 
-    /* -> vertical & up */
-    else if ((px == x1) && (py < y1) && (_y2 >= y1))
-    {
-        fb_copyrect_internal(x1, y1, x2, _y2,     px, py);
-		fb_copyrect_internal(x1, _y2 - 1, x2, y2, px, py - y1 + _y2 - 1);
-    }
+	if ((x1 > x2) || (y1 > y2))
+	{
+		return;
+	}
 
-    /* -> horizontal & right */
-    else if ((py == y1) && (px > x1) && (px <= x2))
-    {
-        fb_copyrect_internal(px, y1, x2, y2,     px * 2 - x1, py);
-		fb_copyrect_internal(x1, y1, px - 1, y2, px, py);
-    }
+	bytes = (x2 - x1 + 1) * fb->bytes_per_pixel;
 
-    /* -> horizontal & left */
-    else if ((py == y1) && (px < x1) && (_x2 >= x1))
-    {
-        fb_copyrect_internal(x1, y1, _x2, y2,     px, py);
-		fb_copyrect_internal(_x2 + 1, y1, x2, y2, px - x1 + _x2 + 1, py);
-    }
+	if (dy > 0)
+	{
+		for (y = y2; y >= y1; y--)
+		{
+			fb_copy_span(fb->lineAddr[y + dy] + (x1 + dx) * fb->bytes_per_pixel,
+						 fb->lineAddr[y] + x1 * fb->bytes_per_pixel, bytes);
+		}
+	}
+	else
+	{
+		for (y = y1; y <= y2; y++)
+		{
+			fb_copy_span(fb->lineAddr[y + dy] + (x1 + dx) * fb->bytes_per_pixel,
+						 fb->lineAddr[y] + x1 * fb->bytes_per_pixel, bytes);
+		}
+	}
+}
 
-    /* -> right & down */
-	else if (((px > x1 ) && (px <= x2)) && ((py > y1) && (py <= y2)))
-    {
-		fb_copyrect_internal(px, py, x2, y2,     px * 2 - x1, py * 2 - y1);
-		fb_copyrect_internal(x1, py, px - 1, y2, px, py * 2 - y1);
-		fb_copyrect_internal(x1, y1, x2, py - 1, px, py);
-    }
+/*
+ * ڴ framebuffer ͬظʽͼƵ LCD[x,y] 
+ *
+ * :    src     ͼ׵ַ
+ *          w, h    ͼ, 
+ *          pitch   ͼÿֽ
+ */
+void fb_blit(int x, int y, const void *src, int w, int h, int pitch)
+{
+	const unsigned char *p = (const unsigned char *)src;
+	int x1 = x, x2 = x + w - 1, y1 = y, y2 = y + h - 1;
+	size_t bytes;
 
-    /* -> right & up */
-	else if (((px > x1 ) && (px <= x2)) && ((_y2 >= y1) && (_y2 < y2)))
-    {
-		fb_copyrect_internal(px, y1, x2, _y2,     px * 2 - x1, py);
-		fb_copyrect_internal(x1, y1, px - 1, _y2, px, py);
-		fb_copyrect_internal(x1, _y2 + 1, x2, y2, px, py - y1 + _y2 + 1);
-    }
+	/* ü: Դͼԭŵ [x,y] */
+	fb_clip_range(&x1, &x2, 0, (int)fb->varInfo.xres);
+	fb_clip_range(&y1, &y2, 0, (int)fb->varInfo.yres);
 
-    /* -> left & up */
-	else if (((_x2 >= x1 ) && (_x2 < x2)) && ((_y2 >= y1) && (_y2 < y2)))
-    {
-		fb_copyrect_internal(x1, y1, _x2, _y2,     px, py);
-		fb_copyrect_internal(_x2 + 1, y1, x2, _y2, px - x1 + _x2 + 1, py);
-		fb_copyrect_internal(x1, _y2 + 1, x2, y2,  px, py - y1 + _y2 + 1);
-    }
+	if ((src == NULL) || (x1 > x2) || (y1 > y2))
+	{
+		return;
+	}
 
-    /* -> left & down */
-	else if (((_x2 >= x1 ) && (_x2 < x2)) && ((py > y1) && (py <= y2)))
-    {
-		fb_copyrect_internal(x1, py, _x2, y2,     px, py * 2 - y1);
-		fb_copyrect_internal(_x2 + 1, py, x2, y2, px - x1 + _x2 + 1, py * 2 - y1);
-		fb_copyrect_internal(x1, y1, x2, py - 1,  px, py);
-    }
+	p += (y1 - y) * pitch + (x1 - x) * fb->bytes_per_pixel;
+	bytes = (x2 - x1 + 1) * fb->bytes_per_pixel;
 
-    else
-    {
-    	fb_copyrect_internal(x1, y1, x2, y2, px, py);
-    }
+	for ( ; y1 <= y2; y1++, p += pitch)
+	{
+		fb_copy_span(fb->lineAddr[y1] + x1 * fb->bytes_per_pixel, p, bytes);
+	}
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 #include <stddef.h>
 #include <string.h>
 #include <errno.h>
+#include <larchintrin.h>
 
 #include "bsp.h"
 
@@ -57,6 +58,7 @@ typedef struct
     int  idle;                      /* 1==idle */
 #endif
 
+    int  owner;                     /* dma_claim_channel()  devNum, -1: û */
     char dev_name[16];              /* 豸 */
 } DMA_CHNL_t;
 
@@ -166,9 +168,9 @@ static unsigned int peripheral_number_to_address(struct dma_chnl_cfg *cfg)
         case DMA_ADC:   addr = 0x1611c04c; break;   // RX
 
         case DMA_CAN0:  addr = 0x16110098; break;   // RX
-        case DMA_CAN1:  addr = 0x16111098; break;   // RX
-        case DMA_CAN2:  addr = 0x16112098; break;   // RX
-        case DMA_CAN3:  addr = 0x16113098; break;   // RX
+        case DMA_CAN1:  addr = 0x16110498; break;   // RX
+        case DMA_CAN2:  addr = 0x16110898; break;   // RX
+        case DMA_CAN3:  addr = 0x16110c98; break;   // RX
 
         case DMA_ATIM:  addr = 0x16118000; break;   // fixed: CH1 CH2 CH3 CH4 COM UP TRG
         case DMA_GTIM:  addr = 0x16119000; break;   // fixed: CH1 CH2 CH3 CH4  -  UP TRG
@@ -403,6 +405,18 @@ static int ls2k_dma_channel_config(int channel, unsigned int devNum)
     return 0;
 }
  
+/*
+ * ͨ, ûб dma_claim_channel() 
+ */
+static inline int ls2k_dma_channel_free(int channel)
+{
+#if DMA_STATEMACHINE
+    return (dma_channels[channel].state == DMA_STATE_IDLE) && (dma_channels[channel].owner < 0);
+#else
+    return dma_channels[channel].idle && (dma_channels[channel].owner < 0);
+#endif
+}
+
 static int ls2k_dma_get_idle_channel_number(int devNum, int *rx_chnl, int *tx_chnl)
 {
     int i;
@@ -431,12 +445,7 @@ static int ls2k_dma_get_idle_channel_number(int devNum, int *rx_chnl, int *tx_ch
         case DMA_I2S:
             for (i=0; i<CHNL_COUNT/2; i++)
             {
-    #if DMA_STATEMACHINE
-                if ((dma_channels[i*2  ].state == DMA_STATE_IDLE) &&
-                    (dma_channels[i*2+1].state == DMA_STATE_IDLE))
-    #else
-                if (dma_channels[i*2].idle && dma_channels[i*2+1].idle)
-    #endif
+                if (ls2k_dma_channel_free(i*2) && ls2k_dma_channel_free(i*2+1))
                 {
                     if (rx_chnl) *rx_chnl = i*2;
                     if (tx_chnl) *tx_chnl = i*2 + 1;
@@ -453,11 +462,7 @@ static int ls2k_dma_get_idle_channel_number(int devNum, int *rx_chnl, int *tx_ch
         case DMA_MEM:           // mem2mem
             for (i=0; i<CHNL_COUNT; i++)
             {
-    #if DMA_STATEMACHINE
-                if (dma_channels[i].state == DMA_STATE_IDLE)
-    #else
-                if (dma_channels[i].idle)
-    #endif
+                if (ls2k_dma_channel_free(i))
                 {
                     if (rx_chnl) *rx_chnl = i;
                     return 0;
@@ -467,15 +472,8 @@ static int ls2k_dma_get_idle_channel_number(int devNum, int *rx_chnl, int *tx_ch
 
         case DMA_ATIM:          // fixed: CH1 CH2 CH3 CH4 COM UP TRG
         case DMA_GTIM:          // fixed: CH1 CH2 CH3 CH4  -  UP TRG
-    #if DMA_STATEMACHINE
-            if ((dma_channels[0].state == DMA_STATE_IDLE) &&
-                (dma_channels[1].state == DMA_STATE_IDLE) &&
-                (dma_channels[2].state == DMA_STATE_IDLE) &&
-                (dma_channels[3].state == DMA_STATE_IDLE))
-    #else
-            if (dma_channels[0].idle && dma_channels[1].idle &&
-                dma_channels[2].idle && dma_channels[3].idle)
-    #endif
+            if (ls2k_dma_channel_free(0) && ls2k_dma_channel_free(1) &&
+                ls2k_dma_channel_free(2) && ls2k_dma_channel_free(3))
             {
                 return 0;
             }
@@ -676,6 +674,7 @@ STATIC_DRV int DMA_initialize(const void *dma, void *arg)
     #else
         dmachnl->idle = 1;
     #endif
+        dmachnl->owner = -1;
 
         switch (i)
         {
@@ -927,6 +926,46 @@ int dma_get_idle_channel(int devNum, int *rx_chnl, int *tx_chnl)
     return ls2k_dma_get_idle_channel_number(devNum, rx_chnl, tx_chnl);
 }
 
+/*
+ * еDMAͨ, Һռڹжʱ
+ */
+int dma_claim_channel(int devNum, int *rx_chnl, int *tx_chnl)
+{
+    int ret;
+
+    if (!m_dma_initialized)
+    {
+        DMA_initialize(NULL, NULL);
+    }
+
+    loongarch_critical_enter();
+
+    ret = ls2k_dma_get_idle_channel_number(devNum, rx_chnl, tx_chnl);
+    if (ret == 0)
+    {
+        if (rx_chnl && (*rx_chnl >= 0))
+            dma_channels[*rx_chnl].owner = devNum;
+        if (tx_chnl && (*tx_chnl >= 0))
+            dma_channels[*tx_chnl].owner = devNum;
+    }
+
+    loongarch_critical_exit();
+
+    return ret;
+}
+
+/*
+ * ֹͣͷ dma_claim_channel() ͨ
+ */
+void dma_release_channel(int channel)
+{
+    if ((channel >= 0) && (channel < CHNL_COUNT))
+    {
+        DMA_close(NULL, (void *)(long)channel);
+        dma_channels[channel].owner = -1;
+    }
+}
+
 /*
  * ͨ channel Ƿ
  */
@@ -1047,9 +1086,11 @@ int dma_start(struct dma_chnl_cfg *cfg, int priority)
     }
 
     /*
-     * 2nd ȷͨǷ. 
+     * 2nd ȷͨǷ. 豸ͨʹ
      */
-    if (!dma_channel_is_idle(cfg->chNum))
+    if (!dma_channel_is_idle(cfg->chNum) ||
+        ((dma_channels[cfg->chNum].owner >= 0) &&
+         (dma_channels[cfg->chNum].owner != (int)cfg->devNum)))
     {
         int rx_channel, tx_channel;
 
@@ -1217,6 +1258,19 @@ int dma_get_status(int channel)
     return ls2k_dma_channel_get_sr(channel);
 }
 
+/**
+ * ȡDMAͨ
+ */
+int dma_get_counter(int channel)
+{
+    if (dma_channel_is_ready(channel))
+    {
+        return (int)hwDMA->Channels[channel].cndtr;
+    }
+
+    return -1;
+}
+
 /**
  * ȡDMAͨ״̬Ĵ
  */
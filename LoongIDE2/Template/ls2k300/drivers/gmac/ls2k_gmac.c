@@ -34,6 +34,7 @@
 
 #include "ls2k_gmac_hw.h"
 #include "ls2k_gmac.h"
+#include "ls2k_trace.h"
 
 #include "osal.h"
 
@@ -47,12 +48,16 @@
 #ifndef ETHER_MAX_LEN
 #define ETHER_MAX_LEN           1518            // should defined by tcp/ip stack
 #endif
-#define MAX_BUF_SIZE			1536			// 48*32, reference by ETHER_MAX_LEN=1518
+#define MAX_BUF_SIZE			GMAC_RX_BUF_SIZE	// 48*32, reference by ETHER_MAX_LEN=1518
+
+#ifndef GMAC_RX_DESC_NUM
+#define GMAC_RX_DESC_NUM        32              //  bsp.h 
+#endif
 
 #define DMA_DESC_SIZE           (sizeof(GDMA_DESC_t))
 
-#define NUM_TX_DMA_DESC 		16				// TX ,  TX һ
-#define NUM_RX_DMA_DESC 		16				// RX ,  RX һ
+#define NUM_TX_DMA_DESC 		GMAC_TX_DESC_NUM	// TX ,  TX һ
+#define NUM_RX_DMA_DESC 		GMAC_RX_DESC_NUM	// RX ,  RX һ
 
 #define TX_BUF_SIZE				MAX_BUF_SIZE	// TX С
 #define RX_BUF_SIZE				MAX_BUF_SIZE	// RX С
@@ -93,6 +98,18 @@ typedef struct
 	unsigned char *rx_buf[NUM_RX_DMA_DESC];	    /* RX ָ */
 	unsigned char *tx_buf[NUM_TX_DMA_DESC];	    /* TX ָ */
 
+	void         *tx_cookie[NUM_TX_DMA_DESC];   /* ls2k_gmac_send_sg() ֡һ */
+	gmac_txdone_callback_t tx_done_cb;          /* ֶηɻص */
+
+	void         *rx_cookie[NUM_RX_DMA_DESC];   /* ⲿջ, NULL: ʹ̬ */
+	gmac_rxbuf_alloc_t rx_alloc;                /* ⲿջ亯 */
+
+	int           rx_napi;                      /* ʹ ls2k_gmac_rx_burst() ѯ */
+	volatile int  rx_polling;                   /* =1: жѹر, ѯ */
+	unsigned int  rx_riwt;                      /* RI Ź, 0: ʹ */
+
+	int           csum_offload;                 /* Ӳ/ IPv4/TCP/UDP/ICMP У */
+
     osal_event_t  p_event;
 
 	unsigned int  interrupts;	                /* Statistics ͳ */
@@ -109,6 +126,7 @@ typedef struct
 	unsigned int  rx_length_err;
 	unsigned int  rx_crc_err;
 	unsigned int  rx_dropped;
+	unsigned int  rx_csum_err;
 
 	unsigned int  tx_pkts;
 	unsigned int  tx_buffer_unavailable;
@@ -224,6 +242,29 @@ static inline void GDMA_INIT_DESC(GMAC_t *pMAC)
 	GDMA_INIT_TXDESC(pMAC);
 }
 
+/*
+ *  GDMA ж. ѯʱжϱֹر,  ls2k_gmac_rx_burst() 
+ */
+static inline void GDMA_INT_RESTORE(GMAC_t *pMAC)
+{
+	if (pMAC->rx_polling)
+		GDMA_INT_EN_NORX(pMAC->hwGDMA);
+	else
+		GDMA_INT_EN(pMAC->hwGDMA);
+}
+
+/*
+ * УͲ, һ֡ÿҪ
+ */
+static inline unsigned int GDMA_TXDESC_CIC(GMAC_t *pMAC)
+{
+#if ENH_DESC
+	return pMAC->csum_offload ? txdesc0_stat_full : txdesc0_stat_cic_bypass;
+#else
+	return pMAC->csum_offload ? (txdesc1_ctrl_cic_ipv4 | txdesc1_ctrl_cic_tcp) : 0;
+#endif
+}
+
 static inline void GDMA_INIT_RXDESC_CUR(GMAC_t *pMAC)
 {
 	int i;
@@ -262,6 +303,15 @@ static inline void GDMA_INIT_DESC_CUR(GMAC_t *pMAC)
 	GDMA_INIT_TXDESC_CUR(pMAC);
 }
 
+/*
+ * , Ѿжϻ
+ */
+static inline int GDMA_TXDESC_IS_FREE(TX_DESC_t *desc)
+{
+	return ((READ_REG32(&desc->status) & txdesc0_stat_own) == 0) &&
+		   ((READ_REG32(&desc->control) & txdesc1_ctrl_bs1_mask) == 0);
+}
+
 //***************************************************************************************
 // MII r/w interface
 //***************************************************************************************
@@ -759,6 +809,39 @@ static void ls2k_gmac_set_workmode(GMAC_t *pMAC)
 				 gmac_flowctrl_txfcen);			// Disable Transmit Flow Control
 		pMAC->hwGMAC->flowctrl = val;
 	}
+
+	if (pMAC->csum_offload)
+		pMAC->hwGMAC->config |= gmac_ctrl_ipc;	// Checksum Offload
+	else
+		pMAC->hwGMAC->config &= ~gmac_ctrl_ipc;
+}
+
+//***************************************************************************************
+// checksum offload engine
+//***************************************************************************************
+
+/*
+ * ӲûУжģʱ IPC λд 1,  -1
+ */
+static int ls2k_gmac_set_csum_offload(GMAC_t *pMAC, int enable)
+{
+	if (enable)
+	{
+		pMAC->hwGMAC->config |= gmac_ctrl_ipc;
+		if ((pMAC->hwGMAC->config & gmac_ctrl_ipc) == 0)
+		{
+			pMAC->csum_offload = 0;
+			return -1;
+		}
+		pMAC->csum_offload = 1;
+	}
+	else
+	{
+		pMAC->csum_offload = 0;
+		pMAC->hwGMAC->config &= ~gmac_ctrl_ipc;
+	}
+
+	return 0;
 }
 
 //***************************************************************************************
@@ -1174,6 +1257,17 @@ static int ls2k_init_tx_desc_queue(GMAC_t *pMAC)
 	 */
 	for (i = 0; i < NUM_TX_DMA_DESC; i++)
 	{
+		/* give back the frames of ls2k_gmac_send_sg() not finished
+		 */
+		if (pMAC->tx_cookie[i] != NULL)
+		{
+			if (pMAC->tx_done_cb != NULL)
+			{
+				pMAC->tx_done_cb((const void *)pMAC, pMAC->tx_cookie[i]);
+			}
+			pMAC->tx_cookie[i] = NULL;
+		}
+
 		/* tx descriptor
 		 */
 		desc = (TX_DESC_t *)desc_ptr;
@@ -1277,12 +1371,19 @@ static int ls2k_init_rx_desc_queue(GMAC_t *pMAC)
 			desc->control = rxdesc1_ctrl_rer;
 		}
 
-		/* rx buffer
+		/* rx buffer, ѹҽӵⲿ
 		 */
-    	pMAC->rx_desc[i]->bufptr = VA_TO_PHYS(buf_ptr);		// ջַ
-    	pMAC->rx_buf[i] = (void *)buf_ptr;					// ջ
+		if (pMAC->rx_cookie[i] == NULL)
+		{
+    		pMAC->rx_buf[i] = (void *)buf_ptr;				// ջ
+    	}
+    	pMAC->rx_desc[i]->bufptr = VA_TO_PHYS(pMAC->rx_buf[i]);	// ջַ
 
         pMAC->rx_desc[i]->control |= ETHER_MAX_LEN;
+        if (pMAC->rx_riwt)
+        {
+            pMAC->rx_desc[i]->control |= rxdesc1_ctrl_di;   // RI ɿŹ
+        }
         pMAC->rx_desc[i]->status = rxdesc0_stat_own;        // set as owned by dma
 
         desc_ptr += DMA_DESC_SIZE;
@@ -1360,6 +1461,106 @@ STATIC_DRV int GMAC_initialize(const void *dev, void *arg)
 // Receive one packet
 //***************************************************************************************
 
+/*
+ * ͳƽմ,  1 ʾһ֡
+ */
+static int ls2k_gmac_rx_status_ok(GMAC_t *pMAC, unsigned int status)
+{
+#if ENH_DESC
+    /*
+     * IPC ʹʱ, ES ҲУʹ. ֻУʹʱͳ;
+     *  IP ֡Ӳֵ֧ĸ(FT=0)ճ
+     */
+    if (pMAC->csum_offload && (status & rxdesc0_stat_es) &&
+        ((status & (rxdesc0_stat_de | rxdesc0_stat_oe | rxdesc0_stat_lc |
+                    rxdesc0_stat_rwt | rxdesc0_stat_re | rxdesc0_stat_ce)) == 0))
+    {
+        if (status & rxdesc0_stat_ft)
+        {
+            pMAC->rx_csum_err++;
+            return 0;
+        }
+
+        return ((status & rxdesc0_stat_fs) == rxdesc0_stat_fs) &&
+               ((status & rxdesc0_stat_ls) == rxdesc0_stat_ls);
+    }
+#endif
+
+    if (status & rxdesc0_stat_es)   /* RX Error Summary */
+    {
+        pMAC->rx_errors++;
+    }
+
+    if (status & rxdesc0_stat_le)   /* RX Length Error */
+    {
+        pMAC->rx_length_err++;
+    }
+
+    if (status & rxdesc0_stat_ce)  /* RX CRC Error */
+    {
+        pMAC->rx_crc_err++;
+    }
+
+    return ((status & rxdesc0_stat_es) == 0) &&
+           ((status & rxdesc0_stat_fs) == rxdesc0_stat_fs) &&
+           ((status & rxdesc0_stat_ls) == rxdesc0_stat_ls);
+}
+
+/*
+ * ӲУ IP ͷ͸زҶȷ,  1.
+ * FT=0 ʱӲûУ鸺 ( IP ֡, ֵ֧ĸ, IP Ƭ), ҪЭջУ
+ */
+static inline int ls2k_gmac_rx_csum_ok(GMAC_t *pMAC, unsigned int status)
+{
+#if ENH_DESC
+    const unsigned int err_bits = rxdesc0_stat_es | rxdesc0_stat_ipce_gf | rxdesc0_stat_pce;
+#else
+    const unsigned int err_bits = rxdesc0_stat_es | rxdesc0_stat_ipce_gf | rxdesc0_stat_rmpce;
+#endif
+
+    return pMAC->csum_offload && (status & rxdesc0_stat_ft) && ((status & err_bits) == 0);
+}
+
+/*
+ *  rx_head  DMA, rx_head ǰ
+ */
+static void ls2k_gmac_rearm_rx_desc(GMAC_t *pMAC)
+{
+    RX_DESC_t *desc = pMAC->rx_desc[pMAC->rx_head];
+
+    desc->control = ETHER_MAX_LEN + 18;
+    if (pMAC->descmode == CHAINMODE)
+    {
+    	desc->control |= rxdesc1_ctrl_rch;
+    }
+    else if (pMAC->rx_head == NUM_RX_DMA_DESC - 1)
+    {
+        desc->control |= rxdesc1_ctrl_rer;
+    }
+
+    if (pMAC->rx_riwt)
+    {
+        desc->control |= rxdesc1_ctrl_di;                       // RI ɿŹ
+    }
+
+    desc->bufptr = VA_TO_PHYS(pMAC->rx_buf[pMAC->rx_head]);	    // Physical address
+    asm volatile( "dbar 0; " );
+    desc->status = rxdesc0_stat_own;                            // set as owned by dma
+
+    /* Now force the DMA to start receive
+     */
+    pMAC->hwGDMA->rxpoll = 1;
+
+    /*
+     * increment the buffer index
+     */
+    pMAC->rx_head++;
+    if (pMAC->rx_head >= NUM_RX_DMA_DESC)
+    {
+        pMAC->rx_head = 0;
+    }
+}
+
 static int ls2k_gmac_recv_packet_internal(GMAC_t *pMAC, unsigned char *buf, int size)
 {
     int rx_len;
@@ -1382,29 +1583,12 @@ static int ls2k_gmac_recv_packet_internal(GMAC_t *pMAC, unsigned char *buf, int
      * When current receice desc is not ownered by DMA
      */
 
-    if (status & rxdesc0_stat_es)   /* RX Error Summary */
-    {
-        pMAC->rx_errors++;
-    }
-
-    if (status & rxdesc0_stat_le)   /* RX Length Error */
-    {
-        pMAC->rx_length_err++;
-    }
-
-    if (status & rxdesc0_stat_ce)  /* RX CRC Error */
-    {
-        pMAC->rx_crc_err++;
-    }
-
     buf_ptr = (unsigned long)pMAC->rx_buf[pMAC->rx_head];
 
     /******************************************************
      * If no errors, accept packet
      */
-    if (((status & rxdesc0_stat_es) == 0) &&
-        ((status & rxdesc0_stat_fs) == rxdesc0_stat_fs) &&
-        ((status & rxdesc0_stat_ls) == rxdesc0_stat_ls))
+    if (ls2k_gmac_rx_status_ok(pMAC, status))
     {
         pMAC->rx_pkts++;
 
@@ -1419,13 +1603,13 @@ static int ls2k_gmac_recv_packet_internal(GMAC_t *pMAC, unsigned char *buf, int
          */
         if (buf_ptr != (unsigned long)buf)
         {
-            printk("gmac rx error!\r\n");
+            TRACE("GMAC%i rx error: desc[%i] buffer mismatch", pMAC->unitNumber, pMAC->rx_head);
             // memcpy((void *)buf, (void *)buf_ptr, rx_len);
         }
     }
     else	// has error!
     {
-        printk("gmac rx dropped!, desc[%i]->status=0x%08x\r\n", pMAC->rx_head, status);
+        TRACE("GMAC%i rx dropped: desc[%i] status=0x%08x", pMAC->unitNumber, pMAC->rx_head, status);
         pMAC->rx_dropped++;
         rx_len = 0;
     }
@@ -1433,36 +1617,218 @@ static int ls2k_gmac_recv_packet_internal(GMAC_t *pMAC, unsigned char *buf, int
     /**************************************************
      * set up the receive dma buffer
      */
+    ls2k_gmac_rearm_rx_desc(pMAC);
 
-    pMAC->rx_desc[pMAC->rx_head]->control = ETHER_MAX_LEN + 18;
-    if (pMAC->descmode == CHAINMODE)
+    return rx_len;
+}
+
+//***************************************************************************************
+// Receive one packet, zero copy
+//***************************************************************************************
+
+/*
+ * ÿҽһⲿ. ȡһ֡ʱȷµĻ,
+ * ʧ֡ʹԭ, ջʼûпյ.
+ */
+static int ls2k_gmac_attach_rx_buffers(GMAC_t *pMAC, gmac_rxbuf_alloc_t alloc_fn)
+{
+    int i, attached = 0;
+
+    if ((alloc_fn == NULL) || (pMAC->rx_alloc != NULL) || pMAC->started)
     {
-    	pMAC->rx_desc[pMAC->rx_head]->control |= rxdesc1_ctrl_rch;
+        return -1;
     }
-    else if (pMAC->rx_head == NUM_RX_DMA_DESC - 1)
+
+    pMAC->rx_alloc = alloc_fn;
+
+    for (i = 0; i < NUM_RX_DMA_DESC; i++)
     {
-        pMAC->rx_desc[pMAC->rx_head]->control |= rxdesc1_ctrl_rer;
+        unsigned char *buf = NULL;
+        void *cookie;
+
+        cookie = alloc_fn((const void *)pMAC, &buf);
+        if ((cookie == NULL) || (buf == NULL))
+        {
+            continue;                   /* ̬, ʱ */
+        }
+
+        clean_dcache((unsigned long)buf, RX_BUF_SIZE);
+
+        pMAC->rx_cookie[i] = cookie;
+        pMAC->rx_buf[i] = buf;
+        pMAC->rx_desc[i]->bufptr = VA_TO_PHYS(buf);
+        attached++;
     }
 
-    pMAC->rx_desc[pMAC->rx_head]->status = rxdesc0_stat_own;        // set as owned by dma
-    pMAC->rx_desc[pMAC->rx_head]->bufptr = VA_TO_PHYS(buf_ptr);	    // Physical address
+    asm volatile( "dbar 0; " );
 
-    /* Now force the DMA to start receive
-     */
-    pMAC->hwGDMA->rxpoll = 1;
+    return attached;
+}
 
-    /*
-     * increment the buffer index
-     */
-    pMAC->rx_head++;
-    if (pMAC->rx_head >= NUM_RX_DMA_DESC)
+int ls2k_gmac_recv_zerocopy(const void *dev, void **cookie)
+{
+	GMAC_t *pMAC = (GMAC_t *)dev;
+    unsigned int status;
+    unsigned char *buf = NULL;
+    void *new_cookie;
+    int index, rx_len = 0;
+
+    if ((pMAC == NULL) || (cookie == NULL) || (pMAC->rx_alloc == NULL))
     {
-        pMAC->rx_head = 0;
+        return -1;
+    }
+
+    *cookie = NULL;
+
+    index  = pMAC->rx_head;
+    status = READ_REG32(&pMAC->rx_desc[index]->status);
+    if (status & rxdesc0_stat_own)
+    {
+        return 0;
+    }
+
+    if (ls2k_gmac_rx_status_ok(pMAC, status))
+    {
+        rx_len = (status & rxdesc0_stat_fl_mask) >> 16;
+
+        /* Ȳ, ٽ
+         */
+        new_cookie = pMAC->rx_alloc(dev, &buf);
+        if ((new_cookie != NULL) && (buf != NULL))
+        {
+            clean_dcache((unsigned long)buf, RX_BUF_SIZE);
+
+            if (pMAC->rx_cookie[index] != NULL)
+            {
+                clean_dcache((unsigned long)pMAC->rx_buf[index], rx_len);
+
+                *cookie = pMAC->rx_cookie[index];
+                pMAC->rx_cookie[index] = new_cookie;
+                pMAC->rx_buf[index] = buf;
+            }
+            else
+            {
+                /* ʹþ̬
+                 */
+                memcpy(buf, pMAC->rx_buf[index], rx_len);
+                *cookie = new_cookie;
+            }
+
+            pMAC->rx_pkts++;
+        }
+        else
+        {
+            pMAC->rx_dropped++;
+            rx_len = 0;
+        }
     }
+    else
+    {
+        pMAC->rx_dropped++;
+    }
+
+    ls2k_gmac_rearm_rx_desc(pMAC);
 
     return rx_len;
 }
 
+//***************************************************************************************
+// Receive packets in batch, NAPI style
+//***************************************************************************************
+
+static void ls2k_gmac_set_rx_polling(GMAC_t *pMAC, int polling)
+{
+    loongarch_critical_enter();
+    pMAC->rx_polling = polling;
+    GDMA_INT_RESTORE(pMAC);
+    loongarch_critical_exit();
+}
+
+static inline int ls2k_gmac_rx_ring_empty(GMAC_t *pMAC)
+{
+    return (READ_REG32(&pMAC->rx_desc[pMAC->rx_head]->status) & rxdesc0_stat_own) != 0;
+}
+
+/*
+ * жֻѽ񲢹رսж, ɽһȡ߶֡.
+ * ջȡպ´򿪽ж.
+ */
+int ls2k_gmac_rx_burst(const void *dev, gmac_rxframe_t *frames, int budget)
+{
+	GMAC_t *pMAC = (GMAC_t *)dev;
+    int count = 0, len;
+    unsigned int status;
+    void *cookie;
+
+    if ((pMAC == NULL) || (frames == NULL) || (budget <= 0) || (pMAC->rx_alloc == NULL))
+    {
+        return -1;
+    }
+
+    pMAC->rx_napi = 1;
+
+    for (;;)
+    {
+        while ((count < budget) && !ls2k_gmac_rx_ring_empty(pMAC))
+        {
+            status = READ_REG32(&pMAC->rx_desc[pMAC->rx_head]->status);
+            len = ls2k_gmac_recv_zerocopy(dev, &cookie);
+            if (len > 0)
+            {
+                frames[count].cookie = cookie;
+                frames[count].len = len;
+                frames[count].csum_ok = ls2k_gmac_rx_csum_ok(pMAC, status);
+                count++;
+            }
+        }
+
+        /* : жϱֹر, ߼ѯ
+         */
+        if (count >= budget)
+        {
+            return count;
+        }
+
+        /* ջѿ: 򿪽жϺټһ, ֹʧڼ䵽֡
+         */
+        ls2k_gmac_set_rx_polling(pMAC, 0);
+
+        if (ls2k_gmac_rx_ring_empty(pMAC))
+        {
+            return count;
+        }
+
+        ls2k_gmac_set_rx_polling(pMAC, 1);
+    }
+}
+
+/*
+ * жϿŹ:  RDES1[31], һ֡ɺʱ riwt*256 ϵͳʱӲ RI,
+ * ڼ䵽֡ϲΪһж.
+ */
+static int ls2k_gmac_set_rx_coalesce(GMAC_t *pMAC, unsigned int riwt)
+{
+    int i;
+
+    if (riwt > gdma_riwt_mask)
+    {
+        return -1;
+    }
+
+    pMAC->rx_riwt = riwt;
+    pMAC->hwGDMA->riwt = riwt;
+
+    for (i = 0; i < NUM_RX_DMA_DESC; i++)
+    {
+        if (riwt)
+            OR_REG32(&pMAC->rx_desc[i]->control, rxdesc1_ctrl_di);
+        else
+            AND_REG32(&pMAC->rx_desc[i]->control, ~rxdesc1_ctrl_di);
+    }
+
+    return 0;
+}
+
 //***************************************************************************************
 // ls2k_gmac_read()
 //***************************************************************************************
@@ -1517,7 +1883,7 @@ static int ls2k_gmac_send_packet_internal(GMAC_t *pMAC, unsigned char *buf, int
      */
     if (buf_ptr != (unsigned long)buf)
     {
-        printk("gmac tx error!\r\n");
+        TRACE("GMAC%i tx error: desc[%i] buffer mismatch", pMAC->unitNumber, pMAC->tx_head);
         // memcpy((void *)buf_ptr, (void *)buf, tx_len);
     }
 
@@ -1528,11 +1894,13 @@ static int ls2k_gmac_send_packet_internal(GMAC_t *pMAC, unsigned char *buf, int
 #if ENH_DESC
     pMAC->tx_desc[pMAC->tx_head]->status |= txdesc0_stat_ic |		// Interrption on Complete
     									    txdesc0_stat_ls |		// Last  Segment
-    									    txdesc0_stat_fs;		// First Segment
+    									    txdesc0_stat_fs |		// First Segment
+    									    GDMA_TXDESC_CIC(pMAC);	// Checksum Insertion
 #else
     pMAC->tx_desc[pMAC->tx_head]->control |= txdesc1_ctrl_ic |		// Interrption on Complete
     									     txdesc1_ctrl_ls |		// Last  Segment
-    									     txdesc1_ctrl_fs;		// First Segment
+    									     txdesc1_ctrl_fs |		// First Segment
+    									     GDMA_TXDESC_CIC(pMAC);	// Checksum Insertion
 #endif
 	if (pMAC->descmode == CHAINMODE)							    // chain mode
 	{
@@ -1553,7 +1921,7 @@ static int ls2k_gmac_send_packet_internal(GMAC_t *pMAC, unsigned char *buf, int
 	pMAC->tx_desc[pMAC->tx_head]->bufptr = VA_TO_PHYS(buf_ptr);		// Physical address
 
 #if GMAC_DEBUG
-    DBG_OUT("tramsfer desc[%i], datalen=%i\r\n", pMAC->tx_head, tx_len);
+    TRACE("GMAC%i tx desc[%i] len=%i", pMAC->unitNumber, pMAC->tx_head, tx_len);
 #endif
 
     pMAC->tx_pkts++;
@@ -1594,6 +1962,136 @@ STATIC_DRV int GMAC_write(const void *dev, void *buf, int size, void *arg)
     return ls2k_gmac_send_packet_internal(pMAC, (unsigned char *)buf, size);
 }
 
+//***************************************************************************************
+// Send one packet, scatter-gather
+//***************************************************************************************
+
+int ls2k_gmac_send_sg(const void *dev, const gmac_txseg_t *segs, int nsegs, void *cookie)
+{
+	GMAC_t *pMAC = (GMAC_t *)dev;
+    int i, index, first, tx_len = 0;
+    TX_DESC_t *desc;
+    unsigned int flags;
+
+    if ((pMAC == NULL) || (segs == NULL) || (nsegs <= 0) || (nsegs > GMAC_TX_MAX_SEGS))
+    {
+        return -1;
+    }
+
+    /******************************************************
+     * ÿʹһ, ȷ㹻Ŀ
+     */
+    index = pMAC->tx_head;
+    for (i=0; i<nsegs; i++)
+    {
+        if ((segs[i].buf == NULL) || (segs[i].len <= 0) ||
+            (segs[i].len > (int)txdesc1_ctrl_bs1_mask))
+        {
+            return -1;
+        }
+
+        if (!GDMA_TXDESC_IS_FREE(pMAC->tx_desc[index]))
+        {
+            return 0;
+        }
+
+        tx_len += segs[i].len;
+
+        index++;
+        if (index >= NUM_TX_DMA_DESC)
+        {
+            index = 0;
+        }
+    }
+
+    if (tx_len > ETHER_MAX_LEN)
+    {
+        return -1;
+    }
+
+    /******************************************************
+     * дڼر GDMA ж, ֹжϻδдɵ
+     */
+    GDMA_INT_DIS(pMAC->hwGDMA);
+
+    first = pMAC->tx_head;
+
+    for (i=0; i<nsegs; i++)
+    {
+        index = pMAC->tx_head;
+        desc  = pMAC->tx_desc[index];
+
+        /* write back the data to memory before dma read it
+         */
+        clean_dcache((unsigned long)segs[i].buf, (unsigned int)segs[i].len);
+
+#if ENH_DESC
+        flags = (i > 0) ? txdesc0_stat_own : 0;     // һ󽻸 DMA
+        flags |= GDMA_TXDESC_CIC(pMAC);             // Checksum Insertion
+        if (i == 0)
+            flags |= txdesc0_stat_fs;               // First Segment
+        if (i == nsegs - 1)
+            flags |= txdesc0_stat_ls |              // Last  Segment
+                     txdesc0_stat_ic;               // Interrption on Complete
+        if (pMAC->descmode == CHAINMODE)
+            flags |= txdesc0_stat_tch;
+        else if (index == NUM_TX_DMA_DESC - 1)
+            flags |= txdesc0_stat_ter;              // last of ring mode
+
+        desc->bufptr  = VA_TO_PHYS(segs[i].buf);    // Physical address
+        desc->status  = flags;
+        desc->control = segs[i].len & txdesc1_ctrl_bs1_mask;
+#else
+        flags = segs[i].len & txdesc1_ctrl_bs1_mask;
+        flags |= GDMA_TXDESC_CIC(pMAC);             // Checksum Insertion
+        if (i == 0)
+            flags |= txdesc1_ctrl_fs;               // First Segment
+        if (i == nsegs - 1)
+            flags |= txdesc1_ctrl_ls |              // Last  Segment
+                     txdesc1_ctrl_ic;               // Interrption on Complete
+        if (pMAC->descmode == CHAINMODE)
+            flags |= txdesc1_ctrl_tch;
+        else if (index == NUM_TX_DMA_DESC - 1)
+            flags |= txdesc1_ctrl_ter;              // last of ring mode
+
+        desc->bufptr  = VA_TO_PHYS(segs[i].buf);    // Physical address
+        desc->control = flags;
+        desc->status  = (i > 0) ? txdesc0_stat_own : 0;
+#endif
+
+        /* һʱ cookie
+         */
+        pMAC->tx_cookie[index] = (i == nsegs - 1) ? cookie : NULL;
+
+        pMAC->tx_head++;
+        if (pMAC->tx_head >= NUM_TX_DMA_DESC)
+        {
+            pMAC->tx_head = 0;
+        }
+    }
+
+    /******************************************************
+     * ֡׼ú, ٰѵһ DMA
+     */
+    asm volatile( "dbar 0; " );
+    pMAC->tx_desc[first]->status |= txdesc0_stat_own;
+    asm volatile( "dbar 0; " );
+
+#if GMAC_DEBUG
+    TRACE("GMAC%i tx sg desc[%i] segs=%i len=%i", pMAC->unitNumber, first, nsegs, tx_len);
+#endif
+
+    pMAC->tx_pkts++;
+
+    /* Now force the DMA to start transmission
+     */
+    pMAC->hwGDMA->txpoll = 1;
+
+    GDMA_INT_RESTORE(pMAC);
+
+    return tx_len;
+}
+
 //***************************************************************************************
 // Show interface statistics
 //***************************************************************************************
@@ -1608,6 +2106,7 @@ static void ls2k_gmac_stats(GMAC_t *pMAC)
     printk("    RX Length Error:%-8u\r\n", pMAC->rx_length_err);
     printk("    RX CRC Error:%-8u\r\n", pMAC->rx_crc_err);
     printk("    RX dropped:%-8u\r\n", pMAC->rx_dropped);
+    printk("    RX Checksum Error:%-8u\r\n", pMAC->rx_csum_err);
     printk("TX Packets:%-8u\r\n", pMAC->tx_pkts);
     printk("    TX Error Summary:%-8u\r\n", pMAC->tx_errors);
     printk("    TX IP Header Error:%-8u\r\n", pMAC->tx_ipheader_err);
@@ -1675,7 +2174,7 @@ int ls2k_gmac_wait_receive_packet(const void *dev, unsigned char **bufptr)
 
 int ls2k_gmac_wait_transmit_idle(const void *dev, unsigned char **bufptr)
 {
-    unsigned int status, recv_event;
+    unsigned int recv_event;
 	GMAC_t *pMAC = (GMAC_t *)dev;
 
     if ((pMAC == NULL) || (bufptr == NULL))
@@ -1686,8 +2185,7 @@ int ls2k_gmac_wait_transmit_idle(const void *dev, unsigned char **bufptr)
     /*
      * Exsisting idle tx buffer, return immediately
      */
-    status = READ_REG32(&pMAC->tx_desc[pMAC->tx_head]->status);
-    if ((status & txdesc0_stat_own) == 0)
+    if (GDMA_TXDESC_IS_FREE(pMAC->tx_desc[pMAC->tx_head]))
     {
         *bufptr = pMAC->tx_buf[pMAC->tx_head];
         return ETHER_MAX_LEN;
@@ -1711,8 +2209,7 @@ int ls2k_gmac_wait_transmit_idle(const void *dev, unsigned char **bufptr)
     /*
      * Confirm idle tx buffer
      */
-    status = READ_REG32(&pMAC->tx_desc[pMAC->tx_head]->status);
-    if ((status & txdesc0_stat_own) == 0)
+    if (GDMA_TXDESC_IS_FREE(pMAC->tx_desc[pMAC->tx_head]))
     {
         *bufptr = pMAC->tx_buf[pMAC->tx_head];
         return ETHER_MAX_LEN;
@@ -1767,6 +2264,22 @@ STATIC_DRV int GMAC_ioctl(const void *dev, int cmd, void *arg)
     		ls2k_gmac_stats(pMAC);
     		break;
 
+        case IOCTL_GMAC_SET_TXDONE_CB:      /* scatter-gather tx complete callback */
+            pMAC->tx_done_cb = (gmac_txdone_callback_t)arg;
+            break;
+
+        case IOCTL_GMAC_SET_RXBUF_ALLOC:    /* attach external rx buffers */
+            rt = ls2k_gmac_attach_rx_buffers(pMAC, (gmac_rxbuf_alloc_t)arg);
+            break;
+
+        case IOCTL_GMAC_SET_RX_COALESCE:    /* rx interrupt watchdog timer */
+            rt = ls2k_gmac_set_rx_coalesce(pMAC, (unsigned int)(unsigned long)arg);
+            break;
+
+        case IOCTL_GMAC_SET_CSUM_OFFLOAD:   /* checksum offload engine on/off */
+            rt = ls2k_gmac_set_csum_offload(pMAC, (int)(long)arg);
+            break;
+
     	default:
     		break;
     }
@@ -1825,9 +2338,7 @@ static void ls2k_gmac_irq_handler(int vector, void *arg)
 	 */
 	if (dma_status & gdma_status_fbei)
 	{
-#if (GMAC_DEBUG)
-		DBG_OUT("%s", "Fatal Error: gmac-dma Bus Error Interrutp! Restart it.\r\n");
-#endif
+		TRACE("GMAC%i dma fatal bus error, restart", pMAC->unitNumber);
 		pMAC->dma_fatal_err++;
         ls2k_gmac_do_reset(pMAC);
 	    return;
@@ -1872,6 +2383,10 @@ static void ls2k_gmac_irq_handler(int vector, void *arg)
 
 	    if (rx_flag)
 	    {
+	        if (pMAC->rx_napi)
+	        {
+	            pMAC->rx_polling = 1;           /* ջȡ֮ǰٲж */
+	        }
 	        osal_event_send(pMAC->p_event, GMAC_RX_EVENT);
 	    }
 	}
@@ -1887,9 +2402,7 @@ static void ls2k_gmac_irq_handler(int vector, void *arg)
 	 */
 	if (dma_status & gdma_status_rxstop)
 	{
-#if (GMAC_DEBUG)
-		DBG_OUT("%s", "Warning: gmac-dma Receive Process Stopped!\n");
-#endif
+		TRACE("GMAC%i dma rx process stopped", pMAC->unitNumber);
 		pMAC->rx_stopped++;
 #if !defined(DUAL_NIC_REDUNDANCY)
 		GDMA_STOP_RX(pMAC->hwGDMA);
@@ -1941,6 +2454,17 @@ static void ls2k_gmac_irq_handler(int vector, void *arg)
             	pMAC->tx_collsions += (sr & txdesc0_stat_cc_mask) >> 3;
             }
 
+	        /* ֶη͵֡Ѿ,  cookie
+	         */
+	        if (pMAC->tx_cookie[pMAC->tx_tail] != NULL)
+	        {
+	            if (pMAC->tx_done_cb != NULL)
+	            {
+	                pMAC->tx_done_cb((const void *)pMAC, pMAC->tx_cookie[pMAC->tx_tail]);
+	            }
+	            pMAC->tx_cookie[pMAC->tx_tail] = NULL;
+	        }
+
 	        pMAC->tx_tail++;
 
 	        if (pMAC->tx_tail >= NUM_TX_DMA_DESC)
@@ -1975,9 +2499,7 @@ static void ls2k_gmac_irq_handler(int vector, void *arg)
 	 */
 	if (dma_status & gdma_status_txstop)
 	{
-#if (GMAC_DEBUG)
-		DBG_OUT("%s", "Warning: gmac-dma Transmit Process Stopped!\r\n");
-#endif
+		TRACE("GMAC%i dma tx process stopped", pMAC->unitNumber);
 		pMAC->tx_stopped++;
 #if !defined(DUAL_NIC_REDUNDANCY)
 		GDMA_STOP_TX(pMAC->hwGDMA);
@@ -1993,7 +2515,7 @@ static void ls2k_gmac_irq_handler(int vector, void *arg)
 
 	/* open gdma interrupt
 	 */
-	GDMA_INT_EN(pMAC->hwGDMA);
+	GDMA_INT_RESTORE(pMAC);
 
 	return;
 }
@@ -289,7 +289,8 @@ typedef struct
 	volatile unsigned int control; 			/* 0x1018 Operation Mode */
 	volatile unsigned int intenable; 		/* 0x101C Interrupt Enable */
 	volatile unsigned int mfbocount; 		/* 0x1020 Missed Frame and Buffer Overflow Counter */
-	volatile unsigned int rsv2[9];
+	volatile unsigned int riwt; 			/* 0x1024 Receive Interrupt Watchdog Timer */
+	volatile unsigned int rsv2[8];
 	volatile unsigned int curtxdesc; 		/* 0x1048 Current Host Transmit Descriptor */
 	volatile unsigned int currxdesc; 		/* 0x104C Current Host Receive Descriptor */
 	volatile unsigned int curtxbuf; 		/* 0x1050 Current Host Transmit Buffer Address */
@@ -463,6 +464,12 @@ enum GDMA_IEN_R
 	gdma_ien_tx	  = (gdma_ienable_txstop | gdma_ienable_txi | gdma_ienable_txbufu | gdma_ienable_txunf),
 };
 
+/*
+ * Receive Interrupt Watchdog Timer Register of GMAC's DMA 	Offset: 0x24
+ */
+#define gdma_riwt_mask			0xFF			/* bits: 7-0, RI Watchdog Timer count, λ 256 ϵͳʱ.
+												    RDES1[31]=1 ʱ, һ֡ɺü, ʱλ RI */
+
 //-------------------------------------------------------------------------------------------------
 // DMA Descriptor
 //-------------------------------------------------------------------------------------------------
@@ -497,6 +504,12 @@ enum RDESC0_Status
 	rxdesc0_stat_ce				= (1<<1),		/* CRC Error CRCУ, =1: յǰ֡ʱڲCRCУ. λֻlast descriptor(RDES0[8])Ϊ1ʱЧ */
 #if ENH_DESC
     rxdesc0_stat_extsts   		= (1<<0),   	/* Extended Status Available (RDES4) */
+    rxdesc0_stat_pce			= (1<<0),		/* Payload Checksum Error, ʹ16ֽ IPC ʹʱЧ.
+    											    FT(bit5)/IPCE(bit7) һʾУ:
+    											   - 1 0 0: IPv4/6 ֡, Уȷ
+    											   - 1 0 1: (TCP/UDP/ICMP)У
+    											   - 1 1 x: IP ͷУ
+    											   - 0 x x:  IP ֵ߲֧֡ĸ, ӲûУ */
 #else
 	rxdesc0_stat_rmpce			= (1<<0),		/* RX GMAC Checksum/payload Checksum Error У/У.
 												   =1: յǰ֡ʱڲRX GMACĴ1-15дһƥ䵱ǰ֡Ŀĵַ.
@@ -830,6 +843,9 @@ typedef enum
 #define GDMA_INT_EN(hwGDMA)  do { hwGDMA->intenable = (gdma_ien_base | gdma_ien_rx | gdma_ien_tx); } while (0)
 #define GDMA_INT_DIS(hwGDMA) do { hwGDMA->intenable = 0; } while (0)
 
+/* رսж, ѯ */
+#define GDMA_INT_EN_NORX(hwGDMA) do { hwGDMA->intenable = (gdma_ien_base | gdma_ienable_rxstop | gdma_ien_tx); } while (0)
+
 /*
  * gmac start
  */
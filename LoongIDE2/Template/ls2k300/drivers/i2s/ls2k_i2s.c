@@ -81,6 +81,8 @@ typedef struct I2S
 
 	struct i2s_data *tx_list;			/* DMA send buffer list */
 	struct i2s_data *rx_list;			/* DMA receive buffer list */
+	int tx_count;						/* tx_list еĻ */
+	int rx_count;						/* rx_list еĻ */
 
 	int sent_bytes;						/* ѷֽ */
 	int received_bytes;					/* ѽֽ */
@@ -97,6 +99,8 @@ typedef struct I2S
     osal_event_t    p_event;
 #endif
 
+    osal_pool_t     p_node_pool;            /* ݻбڵ, ж */
+
 	int	 	 initialized;
 	int	 	 opened;
 	char	 dev_name[16];
@@ -116,6 +120,8 @@ static I2S_t m_i2s_priv =
 
 	.tx_list = 0,
 	.rx_list = 0,
+	.tx_count = 0,
+	.rx_count = 0,
 	.f_data_cb = NULL,
 	.tx_data_device = NULL,
 	.rx_data_device = NULL,
@@ -137,6 +143,13 @@ const void *devI2S = (void *)&m_i2s_priv;
 // ݻ
 //-----------------------------------------------------------------------------
 
+/*
+ * ÿбŶӵĻ:  DMA  1 , Ԥ 1 , 
+ * I2S_read()/I2S_write() . ڵذͺͽб, 
+ */
+#define I2S_LIST_DEPTH      8
+#define I2S_LIST_NODES      (2 * I2S_LIST_DEPTH)
+
 struct i2s_data
 {
 	char  *buffer;
@@ -152,7 +165,10 @@ static int add_tx_data_to_list(I2S_t *pI2S, char *buf, int len)
 {
 	struct i2s_data *item, *tmp;
 
-	item = (struct i2s_data *)malloc(sizeof(struct i2s_data));
+	if (pI2S->tx_count >= I2S_LIST_DEPTH)
+		return -1;
+
+	item = (struct i2s_data *)osal_pool_get(pI2S->p_node_pool);
 	if (item)
 	{
 		item->buffer  = buf;
@@ -160,6 +176,10 @@ static int add_tx_data_to_list(I2S_t *pI2S, char *buf, int len)
 		item->last = NULL;
 		item->next = NULL;
 
+		loongarch_critical_enter();
+		pI2S->tx_count++;
+		loongarch_critical_exit();
+
 		if (pI2S->tx_list)
 		{
 			/*
@@ -197,10 +217,11 @@ static int remove_tx_data_from_list(I2S_t *pI2S)
 	{
 		loongarch_critical_enter();
 		pI2S->tx_list = item->next;
+		pI2S->tx_count--;
 		loongarch_critical_exit();
 
         aligned_free(item->buffer);
-		free(item);
+		osal_pool_put(pI2S->p_node_pool, item);
 	}
 
 	return 0;
@@ -218,10 +239,11 @@ static int remove_all_tx_data_from_list(I2S_t *pI2S)
 	{
 		loongarch_critical_enter();
 		pI2S->tx_list = item->next;
+		pI2S->tx_count--;
 		loongarch_critical_exit();
 
         aligned_free(item->buffer);
-		free(item);
+		osal_pool_put(pI2S->p_node_pool, item);
 
 		item = pI2S->tx_list;
 	}
@@ -236,7 +258,10 @@ static int add_rx_data_to_list(I2S_t *pI2S, char *buf, int len)
 {
 	struct i2s_data *item, *tmp;
 
-	item = (struct i2s_data *)malloc(sizeof(struct i2s_data));
+	if (pI2S->rx_count >= I2S_LIST_DEPTH)
+		return -1;
+
+	item = (struct i2s_data *)osal_pool_get(pI2S->p_node_pool);
 	if (item)
 	{
 		item->buffer  = buf;
@@ -244,6 +269,10 @@ static int add_rx_data_to_list(I2S_t *pI2S, char *buf, int len)
 		item->last = NULL;
 		item->next = NULL;
 
+		loongarch_critical_enter();
+		pI2S->rx_count++;
+		loongarch_critical_exit();
+
 		if (pI2S->rx_list)
 		{
 			/*
@@ -280,10 +309,11 @@ static int remove_rx_data_from_list(I2S_t *pI2S)
 	{
 		loongarch_critical_enter();
 		pI2S->rx_list = item->next;
+		pI2S->rx_count--;
 		loongarch_critical_exit();
 
         aligned_free(item->buffer);
-		free(item);
+		osal_pool_put(pI2S->p_node_pool, item);
 	}
 
 	return 0;
@@ -300,10 +330,11 @@ static int remove_all_rx_data_from_list(I2S_t *pI2S)
 	{
 		loongarch_critical_enter();
 		pI2S->rx_list = item->next;
+		pI2S->rx_count--;
 		loongarch_critical_exit();
 
         aligned_free(item->buffer);
-		free(item);
+		osal_pool_put(pI2S->p_node_pool, item);
 
 		item = pI2S->rx_list;
 	}
@@ -670,7 +701,12 @@ static int ls2k_i2s_read_next_data(I2S_t *pI2S)
 		}
 
         data_len *= frameBytes;
-		add_tx_data_to_list(pI2S, data, data_len);
+		if (add_tx_data_to_list(pI2S, data, data_len) < 0)
+		{
+			aligned_free(data);
+			errno = ENOMEM;
+			return -1;
+		}
     }
 
     if (pI2S->cur_mode.workmode & I2S_WORK_CAPTURE)
@@ -697,7 +733,12 @@ static int ls2k_i2s_read_next_data(I2S_t *pI2S)
 		}
 
         data_len *= frameBytes;
-		add_rx_data_to_list(pI2S, data, data_len);
+		if (add_rx_data_to_list(pI2S, data, data_len) < 0)
+		{
+			aligned_free(data);
+			errno = ENOMEM;
+			return -1;
+		}
     }
 
     debug("read next %i bytes\r\n", data_len);
@@ -881,6 +922,8 @@ STATIC_DRV int I2S_initialize(const void *dev, void *arg)
     pI2S->p_event = osal_event_create("I2SEvent", 0);
 #endif
 
+    pI2S->p_node_pool = osal_pool_create("I2SNode", sizeof(struct i2s_data), I2S_LIST_NODES);
+
 	pI2S->initialized = 1;
 
 	return 0;
@@ -976,7 +1019,11 @@ STATIC_DRV int I2S_read(const void *dev, void *buf, int size, void *arg)
 	if (!pI2S->opened || !(pI2S->cur_mode.workmode & I2S_WORK_CAPTURE))
 		return -1;
 
-	add_rx_data_to_list(pI2S, buf, size);
+	if (add_rx_data_to_list(pI2S, buf, size) < 0)
+	{
+		errno = ENOMEM;
+		return -ENOMEM;
+	}
 
 	ls2k_i2s_start_work(pI2S);
 
@@ -1000,7 +1047,11 @@ STATIC_DRV int I2S_write(const void *dev, void *buf, int size, void *arg)
 	if (!pI2S->opened || !(pI2S->cur_mode.workmode & I2S_WORK_PLAYBACK))
 		return -1;
 
-	add_tx_data_to_list(pI2S, buf, size);
+	if (add_tx_data_to_list(pI2S, buf, size) < 0)
+	{
+		errno = ENOMEM;
+		return -ENOMEM;
+	}
 
 	ls2k_i2s_start_work(pI2S);
 
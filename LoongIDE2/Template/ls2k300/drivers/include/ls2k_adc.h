@@ -136,6 +136,54 @@ typedef struct
 #define IOCTL_ADC_GET_JRESULT   0x04        /* ȡעͨת,
                                              * : int *, עͨ˳, ת */
 
+#define IOCTL_ADC_STREAM_START  0x05        /* ʼģʽɼ, : ADC_Stream_t* */
+
+#define IOCTL_ADC_STREAM_STOP   0x06        /* ֹͣģʽɼ, : NULL */
+
+#define IOCTL_ADC_STREAM_STATS  0x07        /* ȡģʽͳ, : ADC_StreamStats_t* */
+
+//-----------------------------------------------------------------------------
+// ADC ģʽ
+//-----------------------------------------------------------------------------
+
+/*
+ * ʱıȽ¼ SampleRate ͨת, DMA ѭдû
+ * ping-pong ; ÿд,  Callback Ϣ.
+ *
+ * ڵĲֵͨ˳. ģʽڼ ADC_read()  -1.
+ */
+
+/*
+ * ǰ cache  dcache, Ͱһ cache еݻᶪʧ,
+ * ԻַͰȶ밴 cache ж
+ */
+#define ADC_STREAM_ALIGN    64
+
+/*
+ * ص,  DMA жִ
+ *   samples    дİ׵ַ
+ *   count      ֵ
+ */
+typedef void (*adc_stream_cb_t)(const unsigned int *samples, int count, void *arg);
+
+typedef struct
+{
+    int           TrigSrc;                  /* ADC_TRIG_ATIM_CC1~3  ADC_TRIG_GTIM_CC2 */
+    unsigned int  SampleRate;               /* ͨƵ, Hz */
+    unsigned int *Buffer;                   /* ping-pong , ADC_STREAM_ALIGN ֽڶ */
+    int           BufferSize;               /* ֵ, ǹͨ*2 ,
+                                             * ֽ ADC_STREAM_ALIGN  */
+    adc_stream_cb_t Callback;               /* ص. NULL:  ls2k_adc_stream_read() ȡ */
+    void         *CallbackArg;              /* ص */
+} ADC_Stream_t;
+
+typedef struct
+{
+    unsigned int halves;                    /* дİ */
+    unsigned int overruns;                  /* Ϣ, İ */
+    unsigned int dma_errors;                /* DMA  */
+} ADC_StreamStats_t;
+
 //-----------------------------------------------------------------------------
 // ADC devices
 //-----------------------------------------------------------------------------
@@ -216,7 +264,7 @@ int ADC_ioctl(const void *dev, int cmd, void *arg);
 #define ls2k_adc_open(dev, arg)             ADC_open(dev, arg)
 #define ls2k_adc_close(dev, arg)            ADC_close(dev, arg)
 #define ls2k_adc_read(dev, buf, size, arg)  ADC_read(dev, buf, size, arg)
-#define ls2k_adc_ioctl(dev, cmd, arg)       ADC_ioctl(de, cmd, arg)
+#define ls2k_adc_ioctl(dev, cmd, arg)       ADC_ioctl(dev, cmd, arg)
 
 #endif
 
@@ -234,6 +282,15 @@ extern int adc_read_1_fast(int channel, int samptime);
 
 extern int adc_read_1(int channel);
 
+/*
+ * ģʽ, û Callback ʱȴһдİ
+ * :    samples     ذ׵ַ.  DMA д֮ǰ봦
+ *          timeout_ms  ȴ, OSAL_WAIT_FOREVER õȴ
+ *
+ * :    ֵ, 0=ʱ, -1=ûģʽ
+ */
+extern int ls2k_adc_stream_read(const unsigned int **samples, unsigned int timeout_ms);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,7 @@ extern "C" {
  *
  *      ls2k_can_ioctl(devCANx, IOCTL_CAN_SET_WORKMODE, mode);
  *      ls2k_can_ioctl(devCANx, IOCTL_CAN_SET_BAUDRATE, CAN_SPEED_500K);
+ *      ls2k_can_ioctl(devCANx, IOCTL_CAN_SET_FD_BAUDRATE, CAN_SPEED_2M);  // CAN_MODE_FD
  *      ls2k_can_ioctl(devCANx, IOCTL_CAN_SET_FILTER, CAN_filter_t*);
  *      ls2k_can_ioctl(devCANx, IOCTL_CAN_SET_RANGE, CAN_range_t*);
  *
@@ -82,6 +83,9 @@ extern "C" {
 //  if can.mode.FDE = 1 then data[] length max is 64
 //  else data[] length max is 8. (CAN2.0 format)
 //
+//  CAN-FD valid length: 0~8, 12, 16, 20, 24, 32, 48, 64. When writing other
+//  length, it is rounded up to the next valid length and padded with zero.
+//
 //-----------------------------------------------------------------------------
 
 typedef struct
@@ -91,10 +95,14 @@ typedef struct
     char          extended;         /* whether extended message package */
     unsigned char len;              /* length of data */
 #if CAN_USE_FD
+    char          fdf;              /* CAN-FD frame, only when CAN_MODE_FD */
+    char          brs;              /* CAN-FD bit rate switch: data phase use fd baudrate */
+    char          esi;              /* CAN-FD error state indicator, RX only */
     unsigned char data[64];         /* data for transfer */
 #else
     unsigned char data[8];
 #endif
+    unsigned int  timestamp;        /* RX inner timestamp, 16 bits */
 } CANMsg_t;
 
 //*****************************************************************************
@@ -126,6 +134,43 @@ typedef struct
     int enable;                     /* CAN_RANGE_STD | CAN_RANGE_EXT */
 } CAN_range_t;
 
+//-----------------------------------------------------------------------------
+// CAN capture, for bus logging
+//
+//  Every RX message is stamped with inner timestamp and written into a
+//  caller-supplied ring, instead of the driver rx fifo. Readers access the
+//  records in place with ls2k_can_capture_claim()/ls2k_can_capture_release().
+//
+//  The hardware timestamp is 16 bits, it is extended to 32 bits in software,
+//  so set IOCTL_CAN_SET_TS_PSC that two messages are less than 65536 ticks apart.
+//-----------------------------------------------------------------------------
+
+#define CAN_CAP_EXT         0x01    /* extended message */
+#define CAN_CAP_RTR         0x02    /* CAN2.0 Remote Transmission Request */
+#define CAN_CAP_FDF         0x04    /* CAN-FD message */
+#define CAN_CAP_BRS         0x08    /* CAN-FD bit rate switch */
+#define CAN_CAP_ESI         0x10    /* CAN-FD error state indicator */
+
+typedef struct
+{
+    unsigned int  timestamp;        /* inner timestamp, extended to 32 bits */
+    unsigned int  id;               /* CAN message id */
+    unsigned char len;              /* length of data */
+    unsigned char flags;            /* CAN_CAP_EXT | CAN_CAP_RTR | ... */
+    unsigned char rsv[2];
+#if CAN_USE_FD
+    unsigned char data[64];
+#else
+    unsigned char data[8];
+#endif
+} CANCapture_t;
+
+typedef struct
+{
+    CANCapture_t *ring;             /* caller-supplied ring, NULL: stop capture */
+    unsigned int  count;            /* records of ring, must be power of 2 */
+} CAN_capture_t;
+
 //-----------------------------------------------------------------------------
 // CAN STATUS
 //-----------------------------------------------------------------------------
@@ -173,6 +218,10 @@ typedef struct
     int std_rate_errors;            /* from register BRE */
     int fd_rate_errors;
 
+    int rx_cap_dropped;             /* capture ring full */
+    int rx_fifo_dropped;            /* rx fifo full, new message dropped */
+    int rx_dma_overruns;            /* DMA overwrote unparsed messages, rx buffer reset */
+
 } CAN_stats_t;
 
 /*
@@ -197,7 +246,7 @@ typedef struct
 #define CAN_MODE_FD             0x0010      /* CAN work as CAN-FD, else CAN2.0 */
 #endif
 #if CAN_USE_DMA
-#define CAN_MODE_RX_DMA         0x0020      /* RX message with DMA */
+#define CAN_MODE_RX_DMA         0x0020      /* RX message with circular DMA, no per-message interrupt */
 #endif
 #define CAN_MODE_RX_ADD_TS1     0x0040      /* RX message add timestamp @ RX beginning */
 #define CAN_MODE_RX_CAN_TS      0x0080      /* RX message timestamp use can timer */
@@ -265,9 +314,13 @@ typedef struct
 #define IOCTL_CAN_SET_SAMPLEPT	0x0010      /* int           - Set CAN sample-point */
 #define IOCTL_CAN_SET_PROP_NS	0x0020      /* int           - Set CAN propagate delay ns */
 #define IOCTL_CAN_SET_TS_PSC	0x0040      /* unsigned int  - Set CAN inner Timestamp prescale */
+#if CAN_USE_FD
+#define IOCTL_CAN_SET_FD_BAUDRATE 0x0080    /* unsigned int  - CAN-FD data phase baudrate, up to CAN_SPEED_10M */
+#endif
 
 #define IOCTL_CAN_SET_RX_TMO    0x0100      /* unsigned int - ms, 0: NO_TIMEOUT=BLOCK MODE */
 #define IOCTL_CAN_SET_TX_TMO    0x0200      /* unsigned int - ms, 0: NO_TIMEOUT=BLOCK MODE */
+#define IOCTL_CAN_SET_CAPTURE   0x0400      /* CAN_capture_t* - see struct above, NULL: stop capture */
 
 #define IOCTL_CAN_GET_CUR_TS    0x1000      /* unsigned int* - Get CAN current inner Timestamp */
 #define IOCTL_CAN_GET_STATS     0x2000      /* CAN_stats_t** - see struct above */
@@ -354,6 +407,11 @@ int CAN_close(const void *dev, void *arg);
  *
  * ˵:    CANʹжϽ, յݴڲ, Ǵӻȡ.
  *          עݻ.
+ *
+ *          CAN_MODE_RX_DMA ʱ DMA ѭ, /ʱһν; 
+ *          һθƻеı,  buf Ӧɶ CANMsg_t.
+ *
+ *          IOCTL_CAN_SET_CAPTURE д capture ring,  -1, errno=EBUSY.
  */
 int CAN_read(const void *dev, void *buf, int size, void *arg);
 
@@ -398,6 +456,33 @@ int CAN_ioctl(const void *dev, int cmd, void *arg);
 
 const char *ls2k_can_get_device_name(const void *pCAN);
 
+//-----------------------------------------------------------------------------
+// CAN capture
+//-----------------------------------------------------------------------------
+
+/*
+ * ȡ capture ring ļ¼, 
+ * :    dev         devCAN0~devCAN3
+ *          recs        صһ¼ĵַ
+ *          max         ȡõļ¼
+ *          timeout_ms  ûм¼ʱȴʱ, 0: ȴ; OSAL_WAIT_FOREVER: һֱȴ
+ *
+ * :    ¼, 0=ʱ, -1=û capture ring
+ *
+ * ˵:    ring ʱֻص ring ĩβļ¼, ٴεȡʣµļ¼.
+ *          ¼ ls2k_can_capture_release() 黹.
+ */
+int ls2k_can_capture_claim(const void *dev, CANCapture_t **recs, int max, unsigned int timeout_ms);
+
+/*
+ * 黹 ls2k_can_capture_claim() ȡõļ¼
+ * :    dev         devCAN0~devCAN3
+ *          count       黹ļ¼, ȡõļ¼
+ *
+ * :    0=ɹ
+ */
+int ls2k_can_capture_release(const void *dev, int count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,26 @@ extern const void *devDC0;
 #define IOCTRL_LCD_POWERON		0x46B2
 #define IOCTRL_LCD_POWEROFF		0x46B3
 
+#define IOCTRL_DC_GET_BUFFERS	0x46B4		/* ȡ֡Ϣ, : DC_buffers_t* */
+#define IOCTRL_DC_FLIP			0x46B5		/* һ VSync ʱʾǰͼ, лͼ,
+											 * : int, 1=ȴлЧ; µĻͼ.
+											 * ֮ FBIOGET_FSCREENINFO  smem_start µĻͼ.
+											 * һεʱ̨;  DC_FB_BUFFERS=1 (Ĭ)
+											 * ʱֻȴ VSync */
+#define IOCTRL_DC_WAIT_VSYNC	0x46B6		/* ȴһ VSync, : unsigned int ʱ, 0=Ĭ */
+
+#define DC_MAX_BUFFERS			3
+
+typedef struct
+{
+	int   count;							/* ѷ֡ */
+	int   front;							/* ʾĻ */
+	int   draw;								/* ͼ */
+	unsigned int vsyncs;					/* VSync  */
+	unsigned int timeouts;					/* ûеȵ VSync ֱлĴ */
+	char *buffers[DC_MAX_BUFFERS];
+} DC_buffers_t;
+
 //-----------------------------------------------------------------------------
 // FrameBuffer driver operators
 //-----------------------------------------------------------------------------
@@ -99,6 +119,7 @@ extern char LCD_display_mode[];             /* likely LCD_480x272 */
 
 extern int fb_open(void);                   /* ʼframebuffer */
 extern void fb_close(void);                 /* رframebuffer  */
+extern int fb_flip(int wait);               /* ʾͼ岢лһ, wait=1 ȴлЧ */
 
 extern int fb_get_pixelsx(void);            /* LCDXֱ */
 extern int fb_get_pixelsy(void);            /* LCDYֱ */
@@ -118,6 +139,7 @@ extern void fb_set_fgcolor(unsigned coloridx, unsigned value);  /* 
 extern void fb_cons_putc(char chr);                             /* LCD̨һַ */
 extern void fb_cons_puts(char *str);                            /* LCD̨һַ */
 extern void fb_cons_clear(void);                                /* ִLCD̨ */
+extern void fb_cons_flush(void);                                /* LCD̨Ļ */
 
 /* ı
  */
@@ -138,6 +160,7 @@ extern void fb_drawline(int x1, int y1, int x2, int y2, unsigned coloridx);   /*
 extern void fb_drawrect(int x1, int y1, int x2, int y2, unsigned coloridx);   /* LCD[x1,y1][x2,y2]ָɫο */
 extern void fb_fillrect(int x1, int y1, int x2, int y2, unsigned coloridx);   /* LCD[x1,y1][x2,y2]ָɫο */
 extern void fb_copyrect(int x1, int y1, int x2, int y2, int px, int py);	  /* LCD[x1,y1][x2,y2]ͼ[x1,y1ƶ[px, py]λ */
+extern void fb_blit(int x, int y, const void *src, int w, int h, int pitch); /* ڴw*hͼƵLCD[x,y], pitchͼÿֽ */
 
 /*
  * shorten name
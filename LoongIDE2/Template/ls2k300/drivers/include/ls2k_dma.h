@@ -71,13 +71,14 @@ extern "C" {
 //-----------------------------------------------------------------------------
 
 #define DMA_SR_ERROR    (1<<3)      // DMA 
+#define DMA_SR_HALF     (1<<2)      // 
 #define DMA_SR_DONE 	(1<<1)      // 
 
 struct dma_chnl_cfg;
 
 /*
  * :    chnl    DMAͨ
- *          status  DMA_SR_ERR | DMA_SR_DONE
+ *          status  DMA_SR_ERR | DMA_SR_HALF | DMA_SR_DONE
  */
 typedef void (*dma_callback_t)(struct dma_chnl_cfg *cfg, int bytes, unsigned int status);
 
@@ -193,6 +194,26 @@ int DMA_close(const void *dev, void *arg);
  */
 int dma_get_idle_channel(int devNum, int *rx_chnl, int *tx_chnl);
 
+/**
+ * еDMAͨ.  dma_get_idle_channel() ͬ, صͨռ,
+ * ֱ dma_release_channel(), ڼ䲻ٷ豸
+ *
+ * :    devNum      DMA_UART0 ~ DMA_GTIM
+ *          rx_chnl     ͨ DMA_CHNL0 ~ DMA_CHNL7
+ *          tx_chnl     ͨ DMA_CHNL0 ~ DMA_CHNL7. ˫ͨʹ
+ *
+ * :    0=ɹ
+ *
+ */
+int dma_claim_channel(int devNum, int *rx_chnl, int *tx_chnl);
+
+/**
+ * ֹͣͷ dma_claim_channel() ͨ
+ *
+ * :    channel     DMA_CHNL0 ~ DMA_CHNL7
+ */
+void dma_release_channel(int channel);
+
 /**
  * ͨ channel Ƿ
  *
@@ -269,6 +290,16 @@ void dma_stop(int channel);
  */
 int dma_get_status(int channel);
 
+/**
+ * ȡDMAͨ
+ *
+ * :    channel      DMA_CHNL0 ~ DMA_CHNL7
+ *
+ * :    DMA_CNDTR Ĵֵ, ѭģʽ㵱ǰĴλ. -1=û
+ *
+ */
+int dma_get_counter(int channel);
+
 /**
  * ȡDMAͨ״̬Ĵ
  *
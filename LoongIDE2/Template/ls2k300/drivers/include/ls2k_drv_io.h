@@ -37,7 +37,10 @@ typedef void (*irq_handler_t)(int vector, void *arg);
 //  SPI/I2C ĺԭ
 //-----------------------------------------------------------------------------
 
-#define SUPPORT_SPI_DUAL_IO     0
+/*
+ * SPI ṩȫ˫д rw_bytes()
+ */
+#define SUPPORT_SPI_DUAL_IO     1
 
 typedef int (*I2C_init_t)(const void *bus);
 typedef int (*I2C_send_start_t)(const void *bus, unsigned Addr);
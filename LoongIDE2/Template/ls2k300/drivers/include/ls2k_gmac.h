@@ -48,6 +48,54 @@ typedef int (*net_tx_callback_t)(void);
 #define IOCTL_GMAC_IS_RUNNING       0x0107      /* GMAC is running? started or not */
 #define IOCTL_GMAC_SHOW_STATS       0x0108
 
+#define IOCTL_GMAC_SET_TXDONE_CB    0x0109      /* set scatter-gather tx complete callback */
+#define IOCTL_GMAC_SET_RXBUF_ALLOC  0x010A      /* attach external rx buffers, zero copy */
+#define IOCTL_GMAC_SET_RX_COALESCE  0x010B      /* rx interrupt watchdog timer, RIWT */
+#define IOCTL_GMAC_SET_CSUM_OFFLOAD 0x010C      /* IPv4/TCP/UDP/ICMP checksum offload */
+
+//-----------------------------------------------------------------------------
+// GMAC scatter-gather transmit, zero copy
+//-----------------------------------------------------------------------------
+
+#define GMAC_TX_DESC_NUM            16          /* ÿ GMAC ķ */
+#define GMAC_TX_MAX_SEGS            8           /* һ֡ռõķ */
+
+typedef struct
+{
+    void *buf;                                  /* ݶεַ */
+    int   len;                                  /* ݶγ, > 0 */
+} gmac_txseg_t;
+
+/*
+ * ɻص,  GMAC же
+ * :    dev     devGMAC0/devGMAC1
+ *          cookie  ls2k_gmac_send_sg()  cookie
+ */
+typedef void (*gmac_txdone_callback_t)(const void *dev, void *cookie);
+
+//-----------------------------------------------------------------------------
+// GMAC receive into external buffers, zero copy
+//-----------------------------------------------------------------------------
+
+#define GMAC_RX_BUF_SIZE            1536        /* ջ, ⲿСڸֵ */
+
+/*
+ * ջ亯,  IOCTL_GMAC_SET_RXBUF_ALLOC  ls2k_gmac_recv_zerocopy()
+ * е, же.
+ * :    dev     devGMAC0/devGMAC1
+ *          buf     : ַ, ȲС GMAC_RX_BUF_SIZE
+ *
+ * :    cookie, NULL ʾʧ
+ */
+typedef void *(*gmac_rxbuf_alloc_t)(const void *dev, unsigned char **buf);
+
+typedef struct
+{
+    void *cookie;                               /* Ÿ֡Ļ */
+    int   len;                                  /* ֡ */
+    int   csum_ok;                              /* =1: ӲУ IP ͷ TCP/UDP/ICMP  */
+} gmac_rxframe_t;
+
 /*
  * TODO GMAC ·״̬
  */
@@ -120,6 +168,23 @@ int GMAC_write(const void *dev, void *buf, int size, void *arg);
  *      ---------------------------------------------------------------------------------
  *          IOCTL_GMAC_SHOW_STATS       |   NULL, ӡGMAC豸ͳϢ
  *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_SET_TXDONE_CB    |   : gmac_txdone_callback_t
+ *                                      |   ;:  ls2k_gmac_send_sg() ķɻص
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_SET_RXBUF_ALLOC  |   : gmac_rxbuf_alloc_t
+ *                                      |   ;: Ϊÿҽⲿ, 
+ *                                      |         IOCTL_GMAC_START ֮ǰ, ֻһ.
+ *                                      |         عҽӳɹ
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_SET_RX_COALESCE  |   : unsigned int, 0~255
+ *                                      |   ;: жϿŹ, λ 256 ϵͳʱ.
+ *                                      |         һ֡ɺʱж, 0: ж
+ *      ---------------------------------------------------------------------------------
+ *          IOCTL_GMAC_SET_CSUM_OFFLOAD |   : int, 1: ʹ; 0: ر
+ *                                      |   ;: ʱӲ IPv4 ͷ TCP/UDP/ICMP У,
+ *                                      |         ʱӲ, У֡.
+ *                                      |          -1 ʾӲ֧
+ *      ---------------------------------------------------------------------------------
  *
  * :    0=ɹ
  */
@@ -163,6 +228,47 @@ int ls2k_gmac_wait_transmit_idle(const void *dev, unsigned char **bufptr);
 #define ls2k_gmac_wait_rx_packet(gmac, pbuf)  ls2k_gmac_wait_receive_packet(gmac, pbuf)
 #define ls2k_gmac_wait_tx_idle(gmac, pbuf)    ls2k_gmac_wait_transmit_idle(gmac, pbuf)
 
+/*
+ * ֶηһ֡, 
+ * :    dev     devGMAC0/devGMAC1
+ *          segs    : gmac_txseg_t *, ݶ, ÿռһ
+ *          nsegs   ݶθ, ܳ GMAC_TX_MAX_SEGS
+ *          cookie  ɺ󴫸 IOCTL_GMAC_SET_TXDONE_CB õĻص
+ *
+ * :    >0: η͵ֽ; 0: ; <0: 
+ *
+ * ˵:    1. ǰ, ݶεڴ治ͷŻ޸;
+ *          2.  >0 ʱ, cookie һͨص.
+ */
+int ls2k_gmac_send_sg(const void *dev, const gmac_txseg_t *segs, int nsegs, void *cookie);
+
+/*
+ * ȡһ֡, 
+ * :    dev     devGMAC0/devGMAC1
+ *          cookie  : Ÿ֡ĻӦ cookie
+ *
+ * :    >0: ֡; 0: ûݻ߶һ֡; <0: 
+ *
+ * ˵:    1. Ҫ IOCTL_GMAC_SET_RXBUF_ALLOC ҽⲿ;
+ *          2. ڻʼλ, ȡߵĻɵͷ;
+ *          3. ·Ļ, ʧʱ֡.
+ */
+int ls2k_gmac_recv_zerocopy(const void *dev, void **cookie);
+
+/*
+ * ȡ߽, 
+ * :    dev     devGMAC0/devGMAC1
+ *          frames  : gmac_rxframe_t *, ȡߵ֡
+ *          budget  ȡߵ֡
+ *
+ * :    >=0: ȡߵ֡; <0: ûйҽⲿ
+ *
+ * ˵:    1. һεú, жֻѽһ, Ȼرսж;
+ *          2. ֵС budget ʱջѿ, ´򿪽ж, ߵȴ
+ *             һν¼;  budget ʱӦ.
+ */
+int ls2k_gmac_rx_burst(const void *dev, gmac_rxframe_t *frames, int budget);
+
 //-----------------------------------------------------------------------------
 // GMAC device name
 //-----------------------------------------------------------------------------
@@ -136,6 +136,7 @@ int I2S_close(const void *dev, void *arg);
  *          arg
  *
  * :    ȡֽ
+ *          -ENOMEM: ѾŶ 8 , ǰĴɺٵ
  *
  */
 int I2S_read(const void *dev, void *buf, int size, void *arg);
@@ -148,6 +149,7 @@ int I2S_read(const void *dev, void *buf, int size, void *arg);
  *          arg
  *
  * :    ͵ֽ
+ *          -ENOMEM: ѾŶ 8 , ǰĴɺٵ
  *
  */
 int I2S_write(const void *dev, void *buf, int size, void *arg);
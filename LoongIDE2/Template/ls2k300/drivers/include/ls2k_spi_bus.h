@@ -40,6 +40,10 @@ extern const libspi_ops_t *spi_drv_ops;
 #define ls2k_spi_send_addr(bus, addr, rw)   spi_drv_ops->send_addr(bus, addr, rw)
 #define ls2k_spi_read_bytes(bus, buf, len)  spi_drv_ops->read_bytes(bus, buf, len)
 #define ls2k_spi_write_bytes(bus, buf, len) spi_drv_ops->write_bytes(bus, buf, len)
+#if SUPPORT_SPI_DUAL_IO
+#define ls2k_spi_rw_bytes(bus, \
+                txbuf, txlen, rxbuf, rxlen)   spi_drv_ops->rw_bytes(bus, txbuf, txlen, rxbuf, rxlen)
+#endif
 #define ls2k_spi_ioctl(bus, cmd, arg)       spi_drv_ops->ioctl(bus, cmd, arg)
 
 #else
@@ -97,6 +101,22 @@ int SPI_read_bytes(const void *bus, unsigned char *buf, int len);
  */
 int SPI_write_bytes(const void *bus, unsigned char *buf, int len);
 
+/*
+ * ȫ˫дSPI豸
+ * :    txbuf    unsigned char *, . Ϊ NULL ʱֽ
+ *          txlen    int, ͵ֽ
+ *          rxbuf    unsigned char *, ڴŶȡݵĻ. Ϊ NULL ʱ
+ *          rxlen    int, ȡֽ
+ *
+ * :    δֽ,  txlen  rxlen нϴֵ
+ *
+ * ˵:    ͺͽͬʱ,  n ֽǷ͵ n ֽʱص
+ */
+#if SUPPORT_SPI_DUAL_IO
+int SPI_read_write_bytes(const void *bus, unsigned char *txbuf, int txlen,
+                                    unsigned char *rxbuf, int rxlen);
+#endif
+
 /*
  * SPI߷Ϳ
  * :
@@ -126,6 +146,10 @@ int SPI_ioctl(const void *bus, int cmd, void *arg);
 #define ls2k_spi_send_addr(bus, addr, rw)   SPI_send_addr(bus, addr, rw)
 #define ls2k_spi_read_bytes(bus, buf, len)  SPI_read_bytes(bus, buf, len)
 #define ls2k_spi_write_bytes(bus, buf, len) SPI_write_bytes(bus, buf, len)
+#if SUPPORT_SPI_DUAL_IO
+#define ls2k_spi_rw_bytes(bus, \
+                txbuf, txlen, rxbuf, rxlen)   SPI_read_write_bytes(bus, txbuf, txlen, rxbuf, rxlen)
+#endif
 #define ls2k_spi_ioctl(bus, cmd, arg)       SPI_ioctl(bus, cmd, arg)
 
 #endif
@@ -69,10 +69,6 @@ extern const libspi_ops_t *spiio_drv_ops;
 #define ls2k_spiio_send_addr(bus, addr, rw)   spiio_drv_ops->send_addr(bus, addr, rw)
 #define ls2k_spiio_read_bytes(bus, buf, len)  spiio_drv_ops->read_bytes(bus, buf, len)
 #define ls2k_spiio_write_bytes(bus, buf, len) spiio_drv_ops->write_bytes(bus, buf, len)
-#if SUPPORT_SPI_DUAL_IO
-#define ls2k_spiio_rw_bytes(bus, \
-                txbuf, txlen, rxbuf, rxlen)   spiio_drv_ops->rw_bytes(bus, txbuf, txlen, rxbuf, rxlen)
-#endif
 #define ls2k_spiio_ioctl(bus, cmd, arg)       spiio_drv_ops->ioctl(bus, cmd, arg)
 
 #else
@@ -130,14 +126,6 @@ int SPIIO_read_bytes(const void *bus, unsigned char *buf, int len);
  */
 int SPIIO_write_bytes(const void *bus, unsigned char *buf, int len);
 
-/**
- * ȫ˫д
- */
-#if SUPPORT_SPI_DUAL_IO
-int SPIIO_read_write_bytes(const void *bus, unsigned char *txbuf, int txlen,
-                                      unsigned char *rxbuf, int rxlen);
-#endif
-
 /*
  * SPI߷Ϳ
  * :
@@ -160,10 +148,6 @@ int SPIIO_ioctl(const void *bus, int cmd, void *arg);
 #define ls2k_spiio_send_addr(bus, addr, rw)   SPIIO_send_addr(bus, addr, rw)
 #define ls2k_spiio_read_bytes(bus, buf, len)  SPIIO_read_bytes(bus, buf, len)
 #define ls2k_spiio_write_bytes(bus, buf, len) SPIIO_write_bytes(bus, buf, len)
-#if SUPPORT_SPI_DUAL_IO
-#define ls2k_spiio_rw_bytes(bus, \
-                txbuf, txlen, rxbuf, rxlen)   SPIIO_read_write_bytes(bus, txbuf, txlen, rxbuf, rxlen)
-#endif
 #define ls2k_spiio_ioctl(bus, cmd, arg)       SPIIO_ioctl(bus, cmd, arg)
 
 #endif
@@ -84,6 +84,47 @@ extern const void *devUART9;
 
 #define IOCTL_UART_PRINT_RXTX_MODE  0x1003
 
+/*
+ * ж/DMA ģʽڲշ.  UART_open() ֮ǰ, ȡ 2^n
+ */
+#define IOCTL_UART_SET_RXBUF_SIZE   0x1004      // int: ջֽ
+
+#define IOCTL_UART_SET_TXBUF_SIZE   0x1005      // int: ͻֽ
+
+#define IOCTL_UART_SET_OVERFLOW     0x1006      // int: ʱĴʽ, see below
+
+#define IOCTL_UART_GET_STATS        0x1007      // UART_stats_t *
+
+#define IOCTL_UART_CLEAR_STATS      0x1008
+
+/*
+ * ʱĴʽ
+ *
+ * :
+ *   OVERWRITE: ɵ, (Ĭ)
+ *   DROP_NEW:  е, յ
+ *   BLOCK:     رսж,  UART FIFO , ֱ UART_read() ȡ;
+ *              ֻжϽ, DMA ʱ BLOCK  -1
+ *
+ * (жģʽ):
+ *   DROP_NEW:  д뷢ͻɵݺ, ֵС size
+ *   OVERWRITE/BLOCK: UART_write() ȴͻпռ, ֱȫд
+ */
+#define UART_OVERFLOW_OVERWRITE     0
+#define UART_OVERFLOW_DROP_NEW      1
+#define UART_OVERFLOW_BLOCK         2
+
+/*
+ * IOCTL_UART_GET_STATS
+ */
+typedef struct
+{
+    unsigned int rx_overflows;          /* ջ DMA δȡݵĴ */
+    unsigned int rx_dropped;            /* ˶Ľֽ */
+    unsigned int tx_dropped;            /* 򻺳ûдķֽ */
+    unsigned int hw_errors;             /* ·(/ż/֡) */
+} UART_stats_t;
+
 /*
  * շʽ: DMA or INT else POLL
  *
@@ -100,6 +141,14 @@ extern const void *devUART9;
 #define UART_RX_POLL        0x10        /* receive use POLL */
 #define UART_TX_POLL        0x20        /* transfer use POLL */
 
+/*
+ * DMA ģʽ:
+ *   ʹѭ DMA , /ʱƵջ, UART_read() ʱҲḴ;
+ *   ֱӴ UART_write()  buf  DMA , ɺ󷵻.
+ *
+ *   ÿռһ DMA ͨ, ȫ 8 ͨ๩ 4 ʹ. ûпͨʱ
+ *   ioctl  -1, ÷򱣳ԭĹʽ. ͬʱ DMA  INT ʱ DMA .
+ */
 #define UART_WORK_DMA       (UART_RX_DMA  | UART_TX_DMA)
 #define UART_WORK_INT       (UART_RX_INT  | UART_TX_INT)
 #define UART_WORK_POLL      (UART_RX_POLL | UART_TX_POLL)
@@ -156,7 +205,7 @@ int UART_close(const void *dev, void *arg);
  *          buf      char *, ڴŶȡݵĻ
  *          size     int, ȡֽ, Ȳܳ buf 
  *          arg      int.
- *                  ڹжģʽ:
+ *                  ڹжϻDMAģʽ:
  *                    >0:   ֵĳʱȴ
  *                    =0:   
  *                  ڹڲѯģʽ:
@@ -165,7 +214,7 @@ int UART_close(const void *dev, void *arg);
  *
  * :    ȡֽ
  *
- * ˵:    ڹжģʽ: Ƕڲݽջ
+ * ˵:    ڹжϻDMAģʽ: Ƕڲݽջ
  *          ڹڲѯģʽ: ֱӶԴ豸ж
  */
 int UART_read(const void *dev, void *buf, int size, void *arg);
@@ -179,7 +228,9 @@ int UART_read(const void *dev, void *buf, int size, void *arg);
  *
  * :    ͵ֽ
  *
- * ˵:    ڹжģʽ: ддڲݷͻ
+ * ˵:    ڹжģʽ: ддڲݷͻ, ʱ
+ *                              IOCTL_UART_SET_OVERFLOW õȴ򷵻
+ *          ڹDMAģʽ:  ֱӶ buf DMA, ɺ󷵻
  *          ڹڲѯģʽ: дֱӶԴ豸д
  */
 int UART_write(const void *dev, void *buf, int size, void *arg);
@@ -190,6 +241,15 @@ int UART_write(const void *dev, void *buf, int size, void *arg);
  *          cmd         IOCTL_UART_SET_MODE
  *          arg          struct termios *, ѴΪָģʽ.
  *
+ *          cmd         IOCTL_UART_SET_RXBUF_SIZE / IOCTL_UART_SET_TXBUF_SIZE
+ *          arg          int, ֽ. ڴ򿪺÷ -1
+ *
+ *          cmd         IOCTL_UART_SET_OVERFLOW
+ *          arg          int, UART_OVERFLOW_OVERWRITE/DROP_NEW/BLOCK
+ *
+ *          cmd         IOCTL_UART_GET_STATS
+ *          arg          UART_stats_t *, ͳ
+ *
  * :    0=ɹ
  */
 int UART_ioctl(const void *dev, int cmd, void *arg);
@@ -36,6 +36,17 @@ extern "C" {
 #define IOCTL_NORFLASH_BULK_ERASE       0x0080      /* chip erase */
 #define IOCTL_NORFLASH_WRITE_PROTECT    0x0100      /* write protect */
 #define IOCTL_NORFLASH_IS_BLANK         0x0200      /* sector empty check */
+#define IOCTL_NORFLASH_GET_MMAP         0x0400      /* memory-mapped read pointer */
+
+/*
+ * IOCTL_NORFLASH_GET_MMAP
+ */
+typedef struct
+{
+    unsigned int offset;                /* : flash ڲַ */
+    unsigned int size;                  /* : Ҫʵֽ */
+    const void  *ptr;                   /* : ָֻ */
+} NORFLASH_mmap_t;
 
 //-----------------------------------------------------------------------------
 // SPI0-NORFLASH driver operators
@@ -103,7 +114,7 @@ int NORFLASH_read(const void *bus, void *buf, int size, void *arg);
  *
  * :    дֽ
  *
- * ˵:    дNORFLASHѾʽ
+ * ˵:    дNORFLASHѾʽ, ȫΪ 0xFF ҳ
  */
 int NORFLASH_write(const void *bus, void *buf, int size, void *arg);
 
@@ -134,6 +145,11 @@ int NORFLASH_write(const void *bus, void *buf, int size, void *arg);
  *      ---------------------------------------------------------------------------------
  *          IOCTL_NORFLASH_IS_BLANK         |   NULL, ǷΪ
  *      ---------------------------------------------------------------------------------
+ *          IOCTL_NORFLASH_GET_MMAP         |   : NORFLASH_mmap_t *
+ *                                          |   ;: ٶģʽ,  offset ָֻ,
+ *                                          |         ֱӶ flash Ҫ. Χܳٶռ.
+ *                                          |         NORFLASH_write Ͳڼָ벻ɷ
+ *      ---------------------------------------------------------------------------------
  *
  * :    0=ɹ
  */
@@ -208,23 +208,94 @@ static int ls2k_spi_set_tfr_mode(SPI_bus_t *pSPI, SPI_mode_t *new_mode)
 	return 0;
 }
 
-static int ls2k_spi_wait_tx_done(SPI_bus_t *pSPI)
+/*
+ * շ FIFO . δصֽڲֵ,  FIFO Ͳ
+ */
+#define SPI_FIFO_DEPTH      4
+
+/*
+ * ֻʱ͵ֽ
+ */
+#define SPI_DUMMY_BYTE      0x5A
+
+/*
+ * ȫ˫ len ֽ.
+ *
+ *  FIFO δ;ֽ < SPI_FIFO_DEPTH ʱд, Ȼ FIFO
+ * еȫֽ, ʹ FIFO ʼձ, ÿֽڵȴһδ.
+ *
+ * txbuf == NULL:  SPI_DUMMY_BYTE; txlen ֽ֮ͬ SPI_DUMMY_BYTE
+ * rxbuf == NULL: յ;    rxlen ֮յֽͬ
+ */
+static int ls2k_spi_burst_transfer(SPI_bus_t *pSPI,
+                                   unsigned char *rxbuf, int rxlen,
+                                   const unsigned char *txbuf, int txlen)
 {
-	register unsigned int tmo = 0;
+    HW_SPI_t *hw = pSPI->hwSPI;
+    int len, tx_cnt = 0, rx_cnt = 0;
+    unsigned int tmo = 0;
+    unsigned char rx_val;
 
-	/*
-	 * Wait for SPI to terminate
-	 */
-	while ((pSPI->hwSPI->sr & SPI_SR_IFLAG) == 0)
-	{
-		if (tmo++ > DEFAULT_TIMEOUT)
-		{
-			printk("SPI tmo!\r\n");
-			return -ETIMEDOUT;
-		}
-	}
+    len = rxlen > txlen ? rxlen : txlen;
+    if (len <= 0)
+        return 0;
 
-	return 0;
+    /* Discard stale data, clear interrupt and txoverflow flag */
+    while ((hw->sr & SPI_SR_RFEMPTY) == 0)
+    {
+        rx_val = hw->data;
+    }
+
+    hw->sr = SPI_SR_IFLAG | SPI_SR_WOVERFLOW;
+
+    while (rx_cnt < len)
+    {
+        int progress = 0;
+
+        /*
+         * fill tx fifo
+         */
+        while ((tx_cnt < len) &&
+               (tx_cnt - rx_cnt < SPI_FIFO_DEPTH) &&
+               ((hw->sr & SPI_SR_WFFULL) == 0))
+        {
+            hw->data = (txbuf && (tx_cnt < txlen)) ? txbuf[tx_cnt] : SPI_DUMMY_BYTE;
+            tx_cnt++;
+            progress = 1;
+        }
+
+        /*
+         * drain rx fifo
+         */
+        while ((rx_cnt < tx_cnt) && ((hw->sr & SPI_SR_RFEMPTY) == 0))
+        {
+            rx_val = hw->data;
+            if (rxbuf && (rx_cnt < rxlen))
+                rxbuf[rx_cnt] = rx_val;
+            rx_cnt++;
+            progress = 1;
+        }
+
+        if (progress)
+        {
+            tmo = 0;
+        }
+        else if (tmo++ > DEFAULT_TIMEOUT * SPI_FIFO_DEPTH)
+        {
+            printk("SPI rw tmo.\r\n");
+            hw->sr = SPI_SR_IFLAG | SPI_SR_WOVERFLOW;
+            return -ETIMEDOUT;
+        }
+    }
+
+    (void)rx_val;
+
+    /*
+     * Clear Interrupt and txoverflow flag
+     */
+    hw->sr = SPI_SR_IFLAG | SPI_SR_WOVERFLOW;
+
+    return len;
 }
 
 static int ls2k_spi_read_write_bytes(SPI_bus_t *pSPI,
@@ -232,58 +303,7 @@ static int ls2k_spi_read_write_bytes(SPI_bus_t *pSPI,
 						             const unsigned char *txbuf,
 						             int len)
 {
-	int rt, rw_cnt = 0;
-	unsigned char rx_val;
-
-	/* Clear interrupt and txoverflow flag */
-	pSPI->hwSPI->sr |= (SPI_SR_IFLAG | SPI_SR_WOVERFLOW);
-
-	/* Allow interrupt */
-	pSPI->hwSPI->ctrl |= SPI_CTRL_IEN;
-
-	while (len-- > 0)
-	{
-		if (txbuf == NULL)
-		{
-			/* write dummy char while read. */
-			pSPI->hwSPI->data = 0x5A;
-		}
-		else
-		{
-			pSPI->hwSPI->data = *(unsigned char *)txbuf;
-			txbuf++;
-		}
-
-		/*
-		 * wait until end of transfer
-		 */
-		rt = ls2k_spi_wait_tx_done(pSPI);
-
-		if (0 != rt)
-		{
-			printk("SPI rw tmo.\r\n");
-			return -rt;
-		}
-
-		rx_val = pSPI->hwSPI->data;
-		if (rxbuf != NULL)
-		{
-			(*(unsigned char *)rxbuf) = rx_val;
-			rxbuf++;
-		}
-
-		/*
-		 * Clear Interrupt and txoverflow flag
-		 */
-		pSPI->hwSPI->sr |= (SPI_SR_IFLAG | SPI_SR_WOVERFLOW);
-
-		rw_cnt++;
-	}
-
-	/* Disable interrupt */
-	pSPI->hwSPI->ctrl &= ~SPI_CTRL_IEN;
-
-	return rw_cnt;
+    return ls2k_spi_burst_transfer(pSPI, rxbuf, len, txbuf, len);
 }
 
 /******************************************************************************
@@ -370,6 +390,21 @@ STATIC_DRV int SPI_write_bytes(const void *bus, unsigned char *buf, int len)
 	return ls2k_spi_read_write_bytes(pSPI, NULL, buf, len);
 }
 
+#if SUPPORT_SPI_DUAL_IO
+/*
+ * full-duplex transfer, clock max(txlen, rxlen) bytes
+ */
+STATIC_DRV int SPI_read_write_bytes(const void *bus, unsigned char *txbuf, int txlen,
+                                    unsigned char *rxbuf, int rxlen)
+{
+    SPI_bus_t *pSPI = (SPI_bus_t *)bus;
+
+    VALID_ARG_BUS(bus);
+
+	return ls2k_spi_burst_transfer(pSPI, rxbuf, rxlen, txbuf, txlen);
+}
+#endif
+
 /*
  * according chip-select to send begin r/w op
  */
@@ -508,6 +543,9 @@ static const libspi_ops_t ls2k_spi_drv_ops =
     .send_addr   = SPI_send_addr,
     .read_bytes  = SPI_read_bytes,
     .write_bytes = SPI_write_bytes,
+#if SUPPORT_SPI_DUAL_IO
+    .rw_bytes    = SPI_read_write_bytes,
+#endif
     .ioctl       = SPI_ioctl,
 };
 const libspi_ops_t *spi_drv_ops = &ls2k_spi_drv_ops;
@@ -409,6 +409,37 @@ static int Norflash_wait_ms(const void *bus, unsigned int ms)
 	return -ETIMEDOUT;
 }
 
+/*
+ * wait for page-program done.
+ *
+ * ҳͨ 0.4~0.7ms,  1ms ˯ߵȴ˷һϵʱ,  20us ѯ
+ */
+#define PP_POLL_US          20
+#define PP_TIMEOUT_US       5000
+
+static int Norflash_wait_program(const void *bus)
+{
+	int us;
+
+	for (us=0; us<PP_TIMEOUT_US; us+=PP_POLL_US)
+	{
+		int busy = Norflash_is_busy(bus);
+
+		if (busy == 0)
+		{
+			return 0;
+		}
+		else if (busy < 0)
+		{
+			return -EIO;
+		}
+
+		delay_us(PP_POLL_US);
+	}
+
+	return -ETIMEDOUT;
+}
+
 /*
  * set spi-flash writable.
  */
@@ -652,6 +683,55 @@ lbl_done:
 	return rt;
 }
 
+/*
+ * copy from memory-mapped flash window.
+ *
+ *  uncached ַ, ÿηʶһ SPI ,  8 ֽڶԼٷʴ
+ */
+static void Norflash_copy64(unsigned char *dst, const unsigned char *src, int size)
+{
+	/* head: align src to 8 bytes */
+	while ((size > 0) && ((unsigned long)src & 7))
+	{
+		*dst++ = *src++;
+		size--;
+	}
+
+	if (((unsigned long)dst & 7) == 0)
+	{
+		unsigned long *d = (unsigned long *)dst;
+		const volatile unsigned long *s = (const volatile unsigned long *)src;
+
+		for ( ; size >= 32; size -= 32, d += 4, s += 4)
+		{
+			unsigned long v0 = s[0], v1 = s[1], v2 = s[2], v3 = s[3];
+			d[0] = v0; d[1] = v1; d[2] = v2; d[3] = v3;
+		}
+
+		for ( ; size >= 8; size -= 8)
+		{
+			*d++ = *s++;
+		}
+
+		dst = (unsigned char *)d;
+		src = (const unsigned char *)s;
+	}
+	else
+	{
+		for ( ; size >= 8; size -= 8, dst += 8, src += 8)
+		{
+			unsigned long v = *(const volatile unsigned long *)src;
+			memcpy(dst, &v, 8);
+		}
+	}
+
+	/* tail */
+	while (size-- > 0)
+	{
+		*dst++ = *src++;
+	}
+}
+
 /*
  * check special spi-mem is blank
  */
@@ -680,7 +760,7 @@ static int Norflash_check_isblank(const void *bus, unsigned int addr, int *size)
 	 * byte -> int -> byte to fast
 	 */
 	ptr = (void *)(unsigned long)(off + FLASH_BOOT_BASE);
-	while (cnt-- > 0)
+	while ((cnt > 0) && ((unsigned long)ptr & 7))
 	{
 		if ((unsigned char)*ptr != 0xFF)
 		{
@@ -688,6 +768,24 @@ static int Norflash_check_isblank(const void *bus, unsigned int addr, int *size)
 			break;
 		}
 		ptr++;
+		cnt--;
+	}
+
+	for ( ; bblank && (cnt >= 8); cnt -= 8, ptr += 8)
+	{
+		if (*(volatile unsigned long *)ptr != ~0UL)
+		{
+			bblank = 0;
+		}
+	}
+
+	while (bblank && (cnt-- > 0))
+	{
+		if ((unsigned char)*ptr != 0xFF)
+		{
+			bblank = 0;
+		}
+		ptr++;
 	}
 
 	*size = bblank;
@@ -696,6 +794,113 @@ lbl_done:
 	return rt;
 }
 
+/*
+ * fill page-program buffer: cmd + address + data, not cross page.
+ *
+ * رҳдֽ. ȫΪ 0xFF ʱ *blank=1, Ѳ flash Ҫ
+ */
+#define PP_CMD_SIZE     4
+
+static int Norflash_fill_page(unsigned char *pagebuf, unsigned int offset,
+                              const unsigned char *data, int size, int *blank)
+{
+	int i, cnt;
+
+	cnt = m_chipParam.page_size - (offset % m_chipParam.page_size);
+	if (cnt > size)
+	{
+		cnt = size;
+	}
+
+	pagebuf[0] = SPI_MEM_CMD_PP;
+	pagebuf[1] = (offset >> 16) & 0xff;
+	pagebuf[2] = (offset >>  8) & 0xff;
+	pagebuf[3] = (offset >>  0) & 0xff;
+
+	memcpy(pagebuf + PP_CMD_SIZE, data, cnt);
+
+	*blank = m_chipParam.erase_before_program;
+	for (i=0; (i<cnt) && *blank; i++)
+	{
+		if (data[i] != m_chipParam.empty_state)
+		{
+			*blank = 0;
+		}
+	}
+
+	return cnt;
+}
+
+/*
+ * send write-enable and page-program, don't wait done.
+ */
+static int Norflash_page_program(const void *bus, unsigned char *pagebuf, int cnt)
+{
+	int rt, ret_cnt;
+
+	/**************************************************
+	 * First we must set flash write enable
+	 * Here also has set the transfer mode.
+	 **************************************************/
+
+	rt = Norflash_set_write_en(bus);
+	CHECK_DONE(rt);
+
+	/**************************************************
+	 * Second we can do page-program
+	 **************************************************/
+
+	/* start transfer */
+	rt = ls2k_spi_send_start(bus, NORFLASH_CS);
+	CHECK_DONE(rt);
+
+	/* set transfer mode */
+	rt = -ls2k_spi_ioctl(bus, IOCTL_SPI_I2C_SET_TFRMODE, &m_devMode);
+	CHECK_DONE(rt);
+
+	/* address device */
+	rt = ls2k_spi_send_addr(bus, NORFLASH_CS, true);
+	CHECK_DONE(rt);
+
+	/*
+	 * send "page program" command, address and data
+	 */
+	ret_cnt = ls2k_spi_write_bytes(bus, pagebuf, PP_CMD_SIZE + cnt);
+	if (ret_cnt < 0)
+	{
+    	rt = ret_cnt;
+    }
+
+lbl_done:
+	/* terminate transfer */
+	ls2k_spi_send_stop(bus, NORFLASH_CS);
+
+	return rt;
+}
+
+/*
+ * get read-only pointer of memory-mapped flash, no copy.
+ */
+static int Norflash_get_mmap(const void *bus, NORFLASH_mmap_t *map)
+{
+	int rt;
+
+	if ((map->size == 0) ||
+		(map->offset >= FLASH_BOOT_LIMIT) ||
+		(map->size > FLASH_BOOT_LIMIT - map->offset))
+	{
+		return -EADDRNOTAVAIL;
+	}
+
+	rt = -ls2k_spi_ioctl(bus, IOCTL_FLASH_FAST_READ_ENABLE, NULL);
+	if (rt == 0)
+	{
+		map->ptr = (const void *)(unsigned long)(map->offset + FLASH_BOOT_BASE);
+	}
+
+	return rt;
+}
+
 /**********************************************************************
  * spi flash driver impelememt
  **********************************************************************/
@@ -719,9 +924,9 @@ STATIC_DRV int NORFLASH_initialize(const void *bus, void *arg)
 
 STATIC_DRV int NORFLASH_write(const void *bus, void *buf, int size, void *arg)
 {
-	int rt=0, cmd_size;
-	int curr_cnt, bytes_sent = 0, ret_cnt = 0;
-	unsigned char cmdbuf[4], *pchbuf;
+	int rt=0, blank;
+	int curr_cnt, bytes_sent = 0;
+	unsigned char pagebuf[PP_CMD_SIZE + SPI_FLASH_PAGE_SIZE], *pchbuf;
 	unsigned int  memory_en, offset;
 
     if ((bus == NULL) || (buf == NULL) || (arg == NULL))
@@ -763,88 +968,43 @@ STATIC_DRV int NORFLASH_write(const void *bus, void *buf, int size, void *arg)
 
 	/******************************************************************
 	 * begin to write data, PP = 256 bytes.
+	 *
+	 * ݷͬһ, һ SPI ䷢. ҳ,
+	 *  flash æʱ׼һҳ, Ȼٲѯæ־.
 	 ******************************************************************/
 
+	curr_cnt = Norflash_fill_page(pagebuf, offset, pchbuf, size, &blank);
+
 	while (size > bytes_sent)
 	{
-		/*
-		 * mention: curr_cnt / page_size / off.
-		 */
-		curr_cnt = size - bytes_sent;
-		if ((m_chipParam.page_size > 0) &&
-			(offset / m_chipParam.page_size) !=
-			((offset+curr_cnt+1) / m_chipParam.page_size))
+		int busy = 0;
+
+		if (!blank)
 		{
-			curr_cnt = m_chipParam.page_size - (offset % m_chipParam.page_size);
+			rt = Norflash_page_program(bus, pagebuf, curr_cnt);
+			CHECK_DONE(rt);
+			busy = 1;
 		}
 
-		/**************************************************
-		 * First we must set flash write enable
-		 * Here also has set the transfer mode.
-		 **************************************************/
-
-		rt = Norflash_set_write_en(bus);
-		CHECK_DONE(rt);
-
-		/**************************************************
-		 * Second we can do page-program
-		 **************************************************/
-
-		/* start transfer */
-		rt = ls2k_spi_send_start(bus, NORFLASH_CS);
-		CHECK_DONE(rt);
-
-		/* set transfer mode */
-		rt = -ls2k_spi_ioctl(bus, IOCTL_SPI_I2C_SET_TFRMODE, &m_devMode);
-		CHECK_DONE(rt);
-
-		/* address device */
-		rt = ls2k_spi_send_addr(bus, NORFLASH_CS, true);
-		CHECK_DONE(rt);
-
-		/*
-		 * send "page program" command and address
-		 * remove the mem_size check
-		 */
-		cmdbuf[0] = SPI_MEM_CMD_PP;
-		cmdbuf[1] = (offset >> 16) & 0xff;
-		cmdbuf[2] = (offset >>  8) & 0xff;
-		cmdbuf[3] = (offset >>  0) & 0xff;
-		cmd_size  = 4;
-
-		ret_cnt = ls2k_spi_write_bytes(bus, cmdbuf, cmd_size);
-		if (ret_cnt < 0)
-		{
-        	rt = ret_cnt;
-        }
-		CHECK_DONE(rt);
+		/* adjust bytecount to be sent and pointers */
+		bytes_sent += curr_cnt;
+		offset     += curr_cnt;
+		pchbuf     += curr_cnt;
 
 		/*
-		 * send write data
+		 * flash is programming, fill next page
 		 */
-		ret_cnt = ls2k_spi_write_bytes(bus, pchbuf, curr_cnt);
-		if (ret_cnt < 0)
+		if (size > bytes_sent)
 		{
-        	rt = ret_cnt;
-        }
-		CHECK_DONE(rt);
-
-		/* terminate transfer */
-		rt = ls2k_spi_send_stop(bus, NORFLASH_CS);
-		CHECK_DONE(rt);
-
-		/**************************************************
-		 * Delay for page-program done
-		 **************************************************/
+			curr_cnt = Norflash_fill_page(pagebuf, offset, pchbuf, size - bytes_sent, &blank);
+		}
 
 		/* poll flash sr-busy flag, until device is finished */
-		rt = Norflash_wait_ms(bus, 5);
-		CHECK_DONE(rt);
-
-		/* adjust bytecount to be sent and pointers */
-		bytes_sent += curr_cnt;
-		offset     += curr_cnt;
-		pchbuf     += curr_cnt;
+		if (busy)
+		{
+			rt = Norflash_wait_program(bus);
+			CHECK_DONE(rt);
+		}
 	}
 
 	/*
@@ -909,16 +1069,9 @@ STATIC_DRV int NORFLASH_read(const void *bus, void *buf, int size, void *arg)
     if ((offset + size < FLASH_BOOT_LIMIT) &&   /* XXX bytes ٶռ */
         (SPI_PARAM_MEMORY_EN & memory_en))      /* ٶ */
     {
-		unsigned char *ptr;
-		ptr = (void *)(unsigned long)(offset + FLASH_BOOT_BASE);
-
-    	while (size-- > 0)
-    	{
-    		*pchbuf++ = *ptr++;			/* is here need delay ? */
-    		ret_cnt++;
-    	}
+		Norflash_copy64(pchbuf, (const unsigned char *)(offset + FLASH_BOOT_BASE), size);
 
-    	return ret_cnt;
+    	return size;
     }
     else if (memory_en)
     {
@@ -1083,6 +1236,11 @@ STATIC_DRV int NORFLASH_ioctl(const void *bus, int cmd, void *arg)
 			rt = -ENOTSUP;
 			break;
 
+		case IOCTL_NORFLASH_GET_MMAP:
+		    ARG_NULL_BREAK(arg);
+			rt = Norflash_get_mmap(bus, (NORFLASH_mmap_t *)arg);
+			break;
+
 		default:
 			if (cmd & IOCTL_NORFLASH_IS_BLANK)
 			{
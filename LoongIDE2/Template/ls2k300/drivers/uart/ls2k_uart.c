@@ -39,26 +39,41 @@
 /*
  * ʹ DMA
  */
-#define UART_USE_DMA    0
+#define UART_USE_DMA    1
 
 #if UART_USE_DMA
 #include "ls2k_dma.h"
+
+extern void *aligned_malloc(size_t size, unsigned int align);
+extern void aligned_free(void *addr);
 #endif
 
 //-----------------------------------------------------------------------------
 
 #if UART_USE_DMA || UART_USE_INT
 
-#define DMA_BUF_SIZE    64
+/*
+ * DMA ѭջ, /ʱжһ
+ */
+#define DMA_BUF_SIZE    1024        /*  2  */
+#define DMA_BUF_MASK    (DMA_BUF_SIZE - 1)
+
+#define UART_DMA_RX_EVENT   0x01    /* /жȡ */
+#define UART_DMA_TX_EVENT   0x02    /* DMA  */
+#define UART_DMA_POLL_MS    2       /* ȴʱݵļ */
 
+/*
+ * Ĭշ,  2^n. IOCTL_UART_SET_RXBUF_SIZE øʱʹ malloc
+ */
 #define UART_BUF_SIZE   1024
 
 typedef struct
 {
-    char  Buf[UART_BUF_SIZE];
-    int   Count;
-    char *pHead;
-    char *pTail;
+    char         *Buf;                  /* DefBuf or malloc'ed */
+    unsigned int  Size;                 /* 2^n */
+    volatile unsigned int Head;         /* дλ, ֻ */
+    volatile unsigned int Tail;         /* λ, ֻ */
+    char          DefBuf[UART_BUF_SIZE];
 } UART_buf_t;
 
 #endif
@@ -75,10 +90,22 @@ typedef struct
 #if UART_USE_DMA || UART_USE_INT
     UART_buf_t RxData;                  /* RX Buffer */
     UART_buf_t TxData;                  /* TX Buffer */
+    int           overflow;             /* UART_OVERFLOW_XXX */
+    volatile int  rx_blocked;           /* BLOCK ģʽջ, ѹرսж */
 #endif
 
-#if UART_USE_DMA
+    UART_stats_t  stats;
 
+#if UART_USE_DMA
+    struct dma_chnl_cfg rx_dma_cfg;     /* DMA  */
+    struct dma_chnl_cfg tx_dma_cfg;
+    int           rx_chnl;              /* DMA ͨ, -1: û */
+    int           tx_chnl;
+    char         *dma_rxbuf;            /* ѭջ */
+    unsigned int  dma_rx_rpos;          /* ѭջȡߵλ, ۼֵ */
+    unsigned int  dma_rx_halves;        /* /жϴ, ÿ DMA д */
+    volatile int  dma_tx_busy;          /*  DMA  */
+    osal_event_t  p_event;              /* UART_DMA_RX_EVENT | UART_DMA_TX_EVENT */
 #endif
 
     int  initialized;
@@ -87,75 +114,196 @@ typedef struct
 } UART_t;
 
 //-------------------------------------------------------------------------------------------------
-// Buffer: cycle mode, drop the most oldest data when add
+// Buffer: single producer / single consumer ring, size is 2^n
 //-------------------------------------------------------------------------------------------------
 
 #if UART_USE_DMA || UART_USE_INT
 
 /*
- *  UART_BUF_SIZE ַ.
+ * Head/Tail ļ, ȡģ Size õλ, Head - Tail ݳ.
  *
  * ֽ: 0  1  2  3  4  5        ...
  *       __ __ xx xx xx xx __ __ ...
  *             ^           ^
- *             pHead       |
- *                         pTail
+ *             Tail        |
+ *                         Head
+ *
+ * : ж(DMA), UART_read() ;
+ * : UART_write() , ж.
  *
- * if full or empty: pHead==pTail;
+ * ֻ OVERWRITE ģʽ߻ƶ Tail,  Tail  CAS .
  */
 
 static void initialize_buffer(UART_buf_t *data)
 {
-    data->Count = 0;
-    data->pHead = data->pTail = data->Buf;
+    if (data->Buf == NULL)
+    {
+        data->Buf  = data->DefBuf;
+        data->Size = UART_BUF_SIZE;
+    }
+
+    data->Head = data->Tail = 0;
 }
 
 /*
- * If oveflow, overwrite always
+ * û, ȡ 2^n
  */
-static int enqueue_to_buffer(UART_buf_t *data, char *buf, int len)
+static int resize_buffer(UART_buf_t *data, int size)
 {
-    int i;
+    unsigned int n = 16;
+    char *p;
 
-    for (i=0; i<len; i++)
-    {
-        *data->pTail = buf[i];
-        data->Count++;
-        data->pTail++;
-        if (data->pTail >= data->Buf + UART_BUF_SIZE)
-            data->pTail = data->Buf;
-    }
+    if ((size <= 0) || (size > 0x1000000))
+        return -1;
 
-    /*
-     * if overflow, override the lastest data
-     */
-    if (data->Count > UART_BUF_SIZE)    // overflow
-    {
-        data->Count = UART_BUF_SIZE;
-        data->pHead = data->pTail;
-    }
+    while (n < (unsigned int)size)
+        n <<= 1;
+
+    if (n <= UART_BUF_SIZE)
+        p = data->DefBuf;
+    else if ((p = osal_malloc(n)) == NULL)
+        return -1;
+
+    if ((data->Buf != NULL) && (data->Buf != data->DefBuf))
+        osal_free(data->Buf);
+
+    data->Buf  = p;
+    data->Size = n;
+    data->Head = data->Tail = 0;
+
+    return 0;
+}
+
+static inline unsigned int buffer_count(UART_buf_t *data)
+{
+    return __atomic_load_n(&data->Head, __ATOMIC_ACQUIRE) -
+           __atomic_load_n(&data->Tail, __ATOMIC_ACQUIRE);
+}
+
+/*
+ *  len ֽ, Ǿ. رֽ
+ */
+static int enqueue_to_buffer(UART_buf_t *data, const char *buf, int len)
+{
+    unsigned int head = data->Head;
+    unsigned int room = data->Size - (head - __atomic_load_n(&data->Tail, __ATOMIC_ACQUIRE));
+    unsigned int pos, n1;
+
+    if ((unsigned int)len > room)
+        len = room;
+
+    if (len <= 0)
+        return 0;
+
+    pos = head & (data->Size - 1);
+    n1  = data->Size - pos;
+    if (n1 > (unsigned int)len)
+        n1 = len;
+
+    memcpy(data->Buf + pos, buf, n1);
+    if (n1 < (unsigned int)len)
+        memcpy(data->Buf, buf + n1, len - n1);
+
+    __atomic_store_n(&data->Head, head + len, __ATOMIC_RELEASE);
 
     return len;
 }
 
+/*
+ * ɵ count ֽ,  OVERWRITE ģʽµ. ضֽ
+ */
+static int discard_from_buffer(UART_buf_t *data, int count)
+{
+    unsigned int tail = __atomic_load_n(&data->Tail, __ATOMIC_ACQUIRE);
+    unsigned int n;
+
+    do
+    {
+        n = data->Head - tail;
+        if (n > (unsigned int)count)
+            n = count;
+    } while (!__atomic_compare_exchange_n(&data->Tail, &tail, tail + n, 0,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    return n;
+}
+
+/*
+ *  len ֽ. ڼ Tail ƶ()ʱ¶ȡ
+ */
 static int dequeue_from_buffer(UART_buf_t *data, char *buf, int len)
 {
-    int i, count;
+    unsigned int tail, count, pos, n1;
 
-    count = len < data->Count ? len : data->Count;
+    tail = __atomic_load_n(&data->Tail, __ATOMIC_ACQUIRE);
 
-    for (i=0; i<count; i++)
+    for (;;)
     {
-        buf[i] = *data->pHead;
-        data->Count--;
-        data->pHead++;
-        if (data->pHead >= data->Buf + UART_BUF_SIZE)
-            data->pHead = data->Buf;
+        count = __atomic_load_n(&data->Head, __ATOMIC_ACQUIRE) - tail;
+        if (count > (unsigned int)len)
+            count = len;
+
+        if (count == 0)
+            return 0;
+
+        pos = tail & (data->Size - 1);
+        n1  = data->Size - pos;
+        if (n1 > count)
+            n1 = count;
+
+        memcpy(buf, data->Buf + pos, n1);
+        if (n1 < count)
+            memcpy(buf + n1, data->Buf, count - n1);
+
+        if (__atomic_compare_exchange_n(&data->Tail, &tail, tail + count, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            break;
     }
 
     return count;
 }
 
+/*
+ * յݰ overflow ʽ浽 RxData. ȡߵֽ,
+ * ֻ BLOCK ģʽС len, ʣɵ߱
+ */
+static int ls2k_uart_rx_enqueue(UART_t *pUART, const char *buf, int len)
+{
+    UART_buf_t *data = &pUART->RxData;
+    unsigned int room = data->Size - buffer_count(data);
+    int lost = 0;
+
+    if ((unsigned int)len > room)
+    {
+        pUART->stats.rx_overflows++;
+
+        switch (pUART->overflow)
+        {
+            case UART_OVERFLOW_DROP_NEW:
+                lost = len - room;
+                len  = room;
+                break;
+
+            case UART_OVERFLOW_BLOCK:
+                return enqueue_to_buffer(data, buf, room);
+
+            default:                    /* UART_OVERFLOW_OVERWRITE */
+                if ((unsigned int)len > data->Size)
+                {
+                    lost = len - data->Size;
+                    buf += lost;
+                    len  = data->Size;
+                }
+                lost += discard_from_buffer(data, len - room);
+                break;
+        }
+
+        pUART->stats.rx_dropped += lost;
+    }
+
+    return enqueue_to_buffer(data, buf, len) + lost;
+}
+
 #endif // #if UART_USE_DMA || UART_USE_INT
 
 //-------------------------------------------------------------------------------------------------
@@ -228,6 +376,7 @@ static int ls2k_uart_negate_DTR(UART_t *pUART)
 #if 1
 static inline void ls2k_uart_reset(UART_t *pUART)
 {
+    pUART->stats.hw_errors++;
     pUART->hwUART->R2.fcr = UART_FCR_FIFO_EN |
                             UART_FCR_RxRESET |
                             UART_FCR_TxRESET |
@@ -238,6 +387,7 @@ static inline void ls2k_uart_reset(UART_t *pUART)
 #else
 #define ls2k_uart_reset(pUART) \
     do { \
+        pUART->stats.hw_errors++; \
         pUART->hwUART->R2.fcr = UART_FCR_FIFO_EN | \
                                 UART_FCR_RxRESET | \
                                 UART_FCR_TxRESET | \
@@ -356,6 +506,402 @@ static inline int ls2k_uart_wait_txfifo_empty(UART_t *pUART)
    
 #if UART_USE_DMA
 
+/*
+ * : DMA ѭģʽ,  UART ݲд dma_rxbuf.
+ *
+ *   1. /жʱ, ݸƵ RxData;
+ *   2. UART_read() ÿβѯʱҲһ, (·)
+ *       dma_rxbuf .
+ *
+ * : DMA ֱӴӵߵĻ, UART_write() ȴɺ󷵻.
+ */
+
+static int ls2k_uart_poll_write_string(UART_t *pUART, char *buf, int len);
+
+static int ls2k_uart_dma_devnum(UART_t *pUART)
+{
+    return DMA_UART0 + (int)((VA_TO_PHYS(pUART->hwUART) - UART0_BASE) / (UART1_BASE - UART0_BASE));
+}
+
+/*
+ * DMA ĵǰдλ
+ */
+static inline int ls2k_uart_dma_rx_head(UART_t *pUART)
+{
+    int head = DMA_BUF_SIZE - dma_get_counter(pUART->rx_chnl);
+
+    if ((head < 0) || (head >= DMA_BUF_SIZE))
+        head = 0;
+
+    return head;
+}
+
+/*
+ * DMA ۼдλ: һι/жϵλ֮, һȦ.
+ * ֻ head - tail ʱ, DMA һȦûһ.
+ */
+static inline unsigned int ls2k_uart_dma_rx_wpos(UART_t *pUART)
+{
+    unsigned int wpos = pUART->dma_rx_halves * (DMA_BUF_SIZE / 2);
+
+    return wpos + ((ls2k_uart_dma_rx_head(pUART) - wpos) & DMA_BUF_MASK);
+}
+
+/*
+ *  dma_rxbuf յݸƵ RxData, . ߹ж
+ */
+static void ls2k_uart_dma_rx_drain(UART_t *pUART)
+{
+    unsigned int rpos = pUART->dma_rx_rpos;
+    unsigned int avail = ls2k_uart_dma_rx_wpos(pUART) - rpos;
+    int tail, n;
+
+    /*
+     * DMA Ѿ˻ûȡߵ: µİ¿ʼ,
+     * ǵֽڼ rx_dropped
+     */
+    if (avail > DMA_BUF_SIZE)
+    {
+        pUART->stats.rx_overflows++;
+        pUART->stats.rx_dropped += avail - DMA_BUF_SIZE / 2;
+        rpos += avail - DMA_BUF_SIZE / 2;
+        avail = DMA_BUF_SIZE / 2;
+    }
+
+    if (avail == 0)
+        return;
+
+    /*
+     * DMA ģʽʹ BLOCK, ȫȡ
+     */
+    tail = rpos & DMA_BUF_MASK;
+    n = DMA_BUF_SIZE - tail;
+    if ((unsigned int)n > avail)
+        n = avail;
+
+    clean_dcache_nowrite((unsigned long)pUART->dma_rxbuf + tail, n);
+    ls2k_uart_rx_enqueue(pUART, pUART->dma_rxbuf + tail, n);
+
+    if (avail > (unsigned int)n)
+    {
+        clean_dcache_nowrite((unsigned long)pUART->dma_rxbuf, avail - n);
+        ls2k_uart_rx_enqueue(pUART, pUART->dma_rxbuf, avail - n);
+    }
+
+    pUART->dma_rx_rpos = rpos + avail;
+}
+
+static void ls2k_uart_dma_rx_callback(struct dma_chnl_cfg *cfg, int bytes, unsigned int status)
+{
+    UART_t *pUART = (UART_t *)cfg->device;
+
+    if (status & (DMA_SR_HALF | DMA_SR_DONE))
+    {
+        if (status & DMA_SR_HALF)
+            pUART->dma_rx_halves++;
+        if (status & DMA_SR_DONE)
+            pUART->dma_rx_halves++;
+
+        ls2k_uart_dma_rx_drain(pUART);
+
+        if (osal_is_osrunning())
+            osal_event_send(pUART->p_event, UART_DMA_RX_EVENT);
+    }
+
+    if (status & DMA_SR_ERROR)
+    {
+        pUART->dma_rx_rpos = ls2k_uart_dma_rx_wpos(pUART);
+    }
+}
+
+static void ls2k_uart_dma_tx_callback(struct dma_chnl_cfg *cfg, int bytes, unsigned int status)
+{
+    UART_t *pUART = (UART_t *)cfg->device;
+
+    if (status & (DMA_SR_DONE | DMA_SR_ERROR))
+    {
+        pUART->hwUART->R1.ien &= ~UART_IEN_TXDMA;
+        pUART->dma_tx_busy = 0;
+
+        if (osal_is_osrunning())
+            osal_event_send(pUART->p_event, UART_DMA_TX_EVENT);
+    }
+}
+
+/*
+ * һ DMA ͨ
+ */
+static int ls2k_uart_dma_get_channels(UART_t *pUART)
+{
+    if ((pUART->rx_chnl >= 0) && (pUART->tx_chnl >= 0))
+        return 0;
+
+    if (!pUART->p_event)
+    {
+        pUART->p_event = osal_event_create(pUART->dev_name, 0);
+        if (!pUART->p_event)
+            return -1;
+    }
+
+    /*
+     * ͨһֱռõ ls2k_uart_dma_release_channels(), 豸뵽
+     */
+    if (dma_claim_channel(ls2k_uart_dma_devnum(pUART),
+                          &pUART->rx_chnl, &pUART->tx_chnl) != 0)
+    {
+        pUART->rx_chnl = pUART->tx_chnl = -1;
+        printk("%s: no idle DMA channel\r\n", pUART->dev_name);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int ls2k_uart_dma_rx_start(UART_t *pUART)
+{
+    struct dma_chnl_cfg *cfg = &pUART->rx_dma_cfg;
+
+    if (pUART->hwUART->R1.ien & UART_IEN_RXDMA)
+        return 0;
+
+    if (ls2k_uart_dma_get_channels(pUART) != 0)
+        return -1;
+
+    if (!pUART->dma_rxbuf)
+    {
+        pUART->dma_rxbuf = (char *)aligned_malloc(DMA_BUF_SIZE, 64);
+        if (!pUART->dma_rxbuf)
+            return -1;
+    }
+
+    clean_dcache_nowrite((unsigned long)pUART->dma_rxbuf, DMA_BUF_SIZE);
+    pUART->dma_rx_rpos = 0;
+    pUART->dma_rx_halves = 0;
+
+    memset(cfg, 0, sizeof(struct dma_chnl_cfg));
+    cfg->chNum      = pUART->rx_chnl;
+    cfg->devNum     = ls2k_uart_dma_devnum(pUART);
+    cfg->device     = pUART;
+    cfg->memAddr    = (unsigned)(uintptr_t)pUART->dma_rxbuf;
+    cfg->transbytes = DMA_BUF_SIZE;
+    cfg->cb         = ls2k_uart_dma_rx_callback;
+
+    cfg->ccr.tcie = 1;              // trans done int-enable
+    cfg->ccr.htie = 1;              // trans half int-enable
+    cfg->ccr.teie = 1;              // trans error int-enable
+    cfg->ccr.dir  = 0;              // 0: peripheral to mem
+    cfg->ccr.circ = 1;              // circle mode
+    cfg->ccr.pinc = 0;              // 1=auto inc peripheral address
+    cfg->ccr.minc = 1;              // 1=auto inc mem address
+    cfg->ccr.psize = 0;             // peripheral data width: 0=8bits
+    cfg->ccr.msize = 0;             // memory data width:     0=8bits
+    cfg->ccr.priority = 2;          // channel priority: high
+
+    if (dma_start(cfg, 0) != 0)
+        return -1;
+
+    pUART->hwUART->R1.ien |= UART_IEN_RXDMA;
+
+    return 0;
+}
+
+static void ls2k_uart_dma_rx_stop(UART_t *pUART)
+{
+    if (pUART->hwUART->R1.ien & UART_IEN_RXDMA)
+    {
+        pUART->hwUART->R1.ien &= ~UART_IEN_RXDMA;
+
+        dma_stop(pUART->rx_chnl);
+        pUART->rx_dma_cfg.ccr.en = 0;
+
+        loongarch_critical_enter();
+        ls2k_uart_dma_rx_drain(pUART);
+        loongarch_critical_exit();
+    }
+
+    if (pUART->dma_rxbuf)
+    {
+        aligned_free(pUART->dma_rxbuf);
+        pUART->dma_rxbuf = NULL;
+    }
+}
+
+static void ls2k_uart_dma_wait_tx_done(UART_t *pUART)
+{
+    while (pUART->dma_tx_busy)
+    {
+        /*
+         * жϷ¼; ûнʱ, ѯ
+         */
+        if (osal_is_osrunning())
+            osal_event_receive(pUART->p_event, UART_DMA_TX_EVENT,
+                               OSAL_EVENT_FLAG_AND | OSAL_EVENT_FLAG_CLEAR, 10);
+        else
+            delay_us(10);
+    }
+}
+
+static void ls2k_uart_dma_tx_stop(UART_t *pUART)
+{
+    ls2k_uart_dma_wait_tx_done(pUART);
+
+    if (pUART->tx_dma_cfg.ccr.en)
+    {
+        dma_stop(pUART->tx_chnl);
+        pUART->tx_dma_cfg.ccr.en = 0;
+    }
+}
+
+static void ls2k_uart_dma_release_channels(UART_t *pUART)
+{
+    if (!(pUART->hwUART->R1.ien & UART_IEN_RXDMA) && !pUART->tx_dma_cfg.ccr.en)
+    {
+        if (pUART->rx_chnl >= 0)
+            dma_release_channel(pUART->rx_chnl);
+        if (pUART->tx_chnl >= 0)
+            dma_release_channel(pUART->tx_chnl);
+
+        pUART->rx_chnl = pUART->tx_chnl = -1;
+    }
+}
+
+static int ls2k_uart_dma_set_using(UART_t *pUART, int rx_dma, int tx_dma)
+{
+    int ret = 0;
+
+    if (rx_dma)
+    {
+        if (ls2k_uart_dma_rx_start(pUART) != 0)
+            ret = -1;
+    }
+    else
+    {
+        ls2k_uart_dma_rx_stop(pUART);
+    }
+
+    if (tx_dma)
+    {
+        if (ls2k_uart_dma_get_channels(pUART) != 0)
+            ret = -1;
+    }
+    else
+    {
+        ls2k_uart_dma_tx_stop(pUART);
+    }
+
+    ls2k_uart_dma_release_channels(pUART);
+
+    return ret;
+}
+
+/*
+ * UART DMA write: ֱӴ buf 
+ */
+static int ls2k_uart_dma_write_string(UART_t *pUART, char *buf, int len)
+{
+    struct dma_chnl_cfg *cfg = &pUART->tx_dma_cfg;
+
+    if (len <= 0)
+        return 0;
+
+    ls2k_uart_dma_wait_tx_done(pUART);
+
+    if (pUART->hwUART->lsr & UART_LSR_ERROR)
+    {
+        ls2k_uart_reset(pUART);
+    }
+
+    clean_dcache((unsigned long)buf, len);
+
+    pUART->dma_tx_busy = 1;
+
+    if (!cfg->ccr.en)
+    {
+        memset(cfg, 0, sizeof(struct dma_chnl_cfg));
+        cfg->chNum      = pUART->tx_chnl;
+        cfg->devNum     = ls2k_uart_dma_devnum(pUART);
+        cfg->device     = pUART;
+        cfg->memAddr    = (unsigned)(uintptr_t)buf;
+        cfg->transbytes = len;
+        cfg->cb         = ls2k_uart_dma_tx_callback;
+
+        cfg->ccr.tcie = 1;          // trans done int-enable
+        cfg->ccr.teie = 1;          // trans error int-enable
+        cfg->ccr.dir  = 1;          // 1: mem to peripheral
+        cfg->ccr.minc = 1;          // 1=auto inc mem address
+        cfg->ccr.psize = 0;         // peripheral data width: 0=8bits
+        cfg->ccr.msize = 0;         // memory data width:     0=8bits
+        cfg->ccr.priority = 2;      // channel priority: high
+
+        if (dma_start(cfg, 0) != 0)
+        {
+            pUART->dma_tx_busy = 0;
+            return ls2k_uart_poll_write_string(pUART, buf, len);
+        }
+    }
+    else if (dma_restart(pUART->tx_chnl, buf, len, DMA_XFER_8b) != 0)
+    {
+        pUART->dma_tx_busy = 0;
+        return ls2k_uart_poll_write_string(pUART, buf, len);
+    }
+
+    pUART->hwUART->R1.ien |= UART_IEN_TXDMA;
+
+    /*
+     * buf ڵ, ɺ󷵻
+     */
+    ls2k_uart_dma_wait_tx_done(pUART);
+
+    return len;
+}
+
+/*
+ * UART DMA read strings
+ */
+static int ls2k_uart_dma_read_string(UART_t *pUART, char *buf, int len, int timeout)
+{
+    int count = 0;
+    unsigned int wait_ms, recv_event;
+
+    for ( ; ; )
+    {
+        loongarch_critical_enter();
+        ls2k_uart_dma_rx_drain(pUART);
+        count += dequeue_from_buffer(&pUART->RxData, buf + count, len - count);
+        loongarch_critical_exit();
+
+        if (count >= len)
+            break;
+
+        if (timeout <= 0)
+        {
+            if (count == 0)
+                errno = ETIMEDOUT;
+            break;
+        }
+
+        /*
+         * /жȡʱ; ݲж,
+         * ÿ UART_DMA_POLL_MS һ
+         */
+        wait_ms = (timeout < UART_DMA_POLL_MS) ? timeout : UART_DMA_POLL_MS;
+        if (osal_is_osrunning())
+            recv_event = osal_event_receive(pUART->p_event, UART_DMA_RX_EVENT,
+                                            OSAL_EVENT_FLAG_AND | OSAL_EVENT_FLAG_CLEAR,
+                                            wait_ms);
+        else
+        {
+            delay_us(wait_ms * 1000);
+            recv_event = 0;
+        }
+
+        if (recv_event != UART_DMA_RX_EVENT)
+            timeout -= wait_ms;
+    }
+
+    return count;
+}
+
 #endif // #if UART_USE_DMA
 
 //-------------------------------------------------------------------------------------------------
@@ -381,7 +927,7 @@ static void ls2k_uart_int_wait_tx_done(UART_t *pUART)
 {
     if (pUART->RxTxMode & UART_TX_INT)
     {
-        while (pUART->TxData.Count > 0)
+        while (buffer_count(&pUART->TxData) > 0)
             delay_us(10);
     }
 
@@ -401,6 +947,7 @@ static void ls2k_uart_interrupt_process(UART_t *pUART)
     do
     {
         int i, count = 0;
+        unsigned int isr_id;
         volatile unsigned char ien = pUART->hwUART->R1.ien;
 
         if (pUART->hwUART->lsr & UART_LSR_ERROR)
@@ -410,16 +957,34 @@ static void ls2k_uart_interrupt_process(UART_t *pUART)
         }
 
         ien &= ~(UART_IEN_ITx | UART_IEN_IRx);
-        if (pUART->RxTxMode & UART_RX_INT)
-            ien |= UART_IEN_IRx;
 
         /*
-         * յ 0xc1
+         * յ 0xc1, ճʱ
          */
-        if ((pUART->hwUART->R2.isr & UART_ISR_MASK) == UART_ISR_RxTRIG)
+        isr_id = pUART->hwUART->R2.isr & UART_ISR_MASK;
+        if ((isr_id == UART_ISR_RxTRIG) || (isr_id == UART_ISR_RxTMO))
         {
+            int room = UART_FIFO_SIZE;
+
+            /*
+             * BLOCK: ֻȡŵµ, Ųʱرսж,
+             *         FIFO ,  UART_read() ´
+             */
+            if (pUART->overflow == UART_OVERFLOW_BLOCK)
+            {
+                unsigned int space = pUART->RxData.Size - buffer_count(&pUART->RxData);
+                if (space < room)
+                    room = space;
+
+                if (room == 0)
+                {
+                    pUART->rx_blocked = 1;
+                    pUART->stats.rx_overflows++;
+                }
+            }
+
             /* Fetch received characters */
-            for (i=0; i<UART_FIFO_SIZE; ++i)
+            for (i=0; i<room; ++i)
             {
                 if (pUART->hwUART->lsr & UART_LSR_DR)
                     buf[i] = (char)pUART->hwUART->R0.dat;
@@ -430,14 +995,17 @@ static void ls2k_uart_interrupt_process(UART_t *pUART)
             /*
              * Enqueue fetched characters to buffer
              */
-            enqueue_to_buffer(&pUART->RxData, buf, i);
+            ls2k_uart_rx_enqueue(pUART, buf, i);
         }
 
+        if ((pUART->RxTxMode & UART_RX_INT) && !pUART->rx_blocked)
+            ien |= UART_IEN_IRx;
+
         /* check if we need transmit characters go on
          */
         if ((pUART->hwUART->R2.isr & UART_ISR_MASK) == UART_ISR_TxEMPTY)
         {
-            if (pUART->TxData.Count > 0)
+            if (buffer_count(&pUART->TxData) > 0)
             {
                 /* Dequeue transmitted characters from buffer
                  */
@@ -614,10 +1182,6 @@ static int ls2k_uart_int_set_using(UART_t *pUART, int rx_int, int tx_int)
          */
         if (!(rx_old || tx_old))
         {
-    #if UART_USE_DMA
-
-    #endif
-
             ls2k_uart_wait_txfifo_empty(pUART);
 
             if (rx_int) pUART->RxTxMode |= UART_RX_INT;     // for install isr
@@ -647,6 +1211,30 @@ static int ls2k_uart_int_set_using(UART_t *pUART, int rx_int, int tx_int)
     return 0;
 }
 
+/*
+ * 򿪷ж, жϼ TxData
+ */
+static void ls2k_uart_int_kick_tx(UART_t *pUART)
+{
+    loongarch_critical_enter();
+    pUART->hwUART->R1.ien |= UART_IEN_ITx;
+    loongarch_critical_exit();
+}
+
+/*
+ * BLOCK ģʽݺ´򿪽ж
+ */
+static void ls2k_uart_int_unblock_rx(UART_t *pUART)
+{
+    if (pUART->rx_blocked)
+    {
+        loongarch_critical_enter();
+        pUART->rx_blocked = 0;
+        pUART->hwUART->R1.ien |= UART_IEN_IRx;
+        loongarch_critical_exit();
+    }
+}
+
 /*
  * UART Interrupt write strings
  */
@@ -667,7 +1255,7 @@ static int ls2k_uart_int_write_string(UART_t *pUART, char *buf, int len)
         ien = pUART->hwUART->R1.ien;
         
         ien &= ~(UART_IEN_IRx | UART_IEN_ITx);
-        if (pUART->RxTxMode | UART_RX_INT)
+        if ((pUART->RxTxMode & UART_RX_INT) && !pUART->rx_blocked)
             ien |= UART_IEN_IRx;
 
         sent = len <= UART_FIFO_SIZE ? len : UART_FIFO_SIZE;
@@ -684,13 +1272,26 @@ static int ls2k_uart_int_write_string(UART_t *pUART, char *buf, int len)
         pUART->hwUART->R1.ien = ien;
     }
 
-    /* add remain data to transmit cached buffer
+    /* add remain data to transmit cached buffer, wait for room if full
      */
-    if (sent < len)
+    while (sent < len)
     {
-    	loongarch_critical_enter();
-        sent += enqueue_to_buffer(&pUART->TxData, buf + sent, len - sent);
-        loongarch_critical_exit();
+        int n = enqueue_to_buffer(&pUART->TxData, buf + sent, len - sent);
+
+        sent += n;
+        if (n > 0)
+            ls2k_uart_int_kick_tx(pUART);
+
+        if (sent >= len)
+            break;
+
+        if (pUART->overflow == UART_OVERFLOW_DROP_NEW)
+        {
+            pUART->stats.tx_dropped += len - sent;
+            break;
+        }
+
+        osal_msleep(1);
     }
 
     return sent;
@@ -708,17 +1309,13 @@ static int ls2k_uart_int_read_string(UART_t *pUART, char *buf, int len, int time
     /*
      * 1st read out received data from rx buffer
      */
-    if (pUART->RxData.Count > 0)
-    {
-        loongarch_critical_enter();
-        count = dequeue_from_buffer(&pUART->RxData, buf, len);
-        loongarch_critical_exit();
-    }
+    count = dequeue_from_buffer(&pUART->RxData, buf, len);
+    ls2k_uart_int_unblock_rx(pUART);
 
     /*
      * 2nd wait to read with time out
      */
-    while ((count < len) && (pUART->RxTxMode | UART_RX_INT))
+    while ((count < len) && (pUART->RxTxMode & UART_RX_INT))
     {
         /*
          * wait or not
@@ -734,12 +1331,8 @@ static int ls2k_uart_int_read_string(UART_t *pUART, char *buf, int len, int time
         /*
          * if received, accept it
          */
-        if (pUART->RxData.Count > 0)
-        {
-            loongarch_critical_enter();
-            count += dequeue_from_buffer(&pUART->RxData, buf + count, len - count);
-            loongarch_critical_exit();
-        }
+        count += dequeue_from_buffer(&pUART->RxData, buf + count, len - count);
+        ls2k_uart_int_unblock_rx(pUART);
     }
 
     return count;
@@ -862,9 +1455,47 @@ static int ls2k_uart_poll_inbyte_blocking(UART_t *pUART)
 static int ls2k_uart_set_rxtx_mode(UART_t *pUART, int rxtx)
 {
     unsigned int new_mode = 0;
+    int ret = 0;
 
 #if UART_USE_DMA
 
+    int rx_dma = (rxtx & UART_RX_DMA) ? 1 : 0;
+    int tx_dma = (rxtx & UART_TX_DMA) ? 1 : 0;
+
+    /*
+     * ̨ʹòѯģʽ
+     */
+    if (pUART == (UART_t *)ConsolePort)
+        rx_dma = tx_dma = 0;
+
+    /*
+     * DMA ֹͣ, BLOCK ģʽֻжϽ
+     */
+    if (rx_dma && (pUART->overflow == UART_OVERFLOW_BLOCK))
+    {
+        errno = EINVAL;
+        ret = -1;
+        rx_dma = 0;
+    }
+
+    if (ls2k_uart_dma_set_using(pUART, rx_dma, tx_dma) != 0)
+    {
+        ret = -1;
+        rx_dma = (pUART->hwUART->R1.ien & UART_IEN_RXDMA) ? 1 : 0;
+        tx_dma = (pUART->tx_chnl >= 0) && tx_dma;
+    }
+
+    if (rx_dma)
+    {
+        new_mode |= UART_RX_DMA;
+        rxtx &= ~UART_RX_INT;               /* DMA  */
+    }
+    if (tx_dma)
+    {
+        new_mode |= UART_TX_DMA;
+        rxtx &= ~UART_TX_INT;
+    }
+
 #endif
 
 #if UART_USE_INT
@@ -883,7 +1514,7 @@ static int ls2k_uart_set_rxtx_mode(UART_t *pUART, int rxtx)
 
     pUART->RxTxMode = new_mode;
 
-    return 0;
+    return ret;
 }
 
 static int ls2k_uart_get_rxtx_mode(UART_t *pUART)
@@ -994,8 +1625,18 @@ STATIC_DRV int UART_initialize(const void *dev, void *arg)
 
 #endif
 
-#if UART_USE_DMA
+#if UART_USE_DMA || UART_USE_INT
+    initialize_buffer(&pUART->RxData);
+    initialize_buffer(&pUART->TxData);
+    pUART->rx_blocked = 0;
+#endif
 
+#if UART_USE_DMA
+    pUART->rx_chnl = -1;
+    pUART->tx_chnl = -1;
+    pUART->dma_rxbuf = NULL;
+    pUART->dma_tx_busy = 0;
+    pUART->p_event = NULL;
 #endif
 
     if (pUART == ConsolePort)
@@ -1054,6 +1695,7 @@ STATIC_DRV int UART_open(const void *dev, void *arg)
 #if UART_USE_DMA || UART_USE_INT
     initialize_buffer(&pUART->RxData);
     initialize_buffer(&pUART->TxData);
+    pUART->rx_blocked = 0;
 #endif
 
 #if UART_USE_INT
@@ -1061,6 +1703,12 @@ STATIC_DRV int UART_open(const void *dev, void *arg)
         ls2k_uart_int_install_isr(pUART);
 #endif
 
+#if UART_USE_DMA
+    if (pUART->RxTxMode & UART_WORK_DMA)
+        ls2k_uart_dma_set_using(pUART, pUART->RxTxMode & UART_RX_DMA,
+                                       pUART->RxTxMode & UART_TX_DMA);
+#endif
+
     pUART->opened = 1;
     return 0;
 }
@@ -1087,7 +1735,8 @@ STATIC_DRV int UART_close(const void *dev, void *arg)
 #endif
 
 #if UART_USE_DMA
-
+    if (pUART->RxTxMode & UART_WORK_DMA)
+        ls2k_uart_dma_set_using(pUART, 0, 0);
 #endif
 
 #if UART_USE_INT
@@ -1119,11 +1768,19 @@ STATIC_DRV int UART_read(const void *dev, void *buf, int size, void *arg)
         
 #if UART_USE_DMA
 
+    if ((pUART->RxTxMode & UART_RX_DMA) && (pUART->hwUART->R1.ien & UART_IEN_RXDMA))
+    {
+        return ls2k_uart_dma_read_string(pUART, (char *)buf, size, (long)arg);
+    }
+
 #endif
 
 #if UART_USE_INT
 
-    if ((pUART->RxTxMode & UART_RX_INT) && (pUART->hwUART->R1.ien & UART_IEN_IRx))
+    /*
+     * BLOCK ģʽջʱжϹر IRx, Դӻȡ, ߺ´
+     */
+    if (pUART->RxTxMode & UART_RX_INT)
     {
         return ls2k_uart_int_read_string(pUART, (char *)buf, size, (long)arg);
     }
@@ -1182,6 +1839,12 @@ STATIC_DRV int UART_write(const void *dev, void *buf, int size, void *arg)
 
 #if UART_USE_DMA
 
+    if ((pUART->RxTxMode & UART_TX_DMA) && (pUART->tx_chnl >= 0))
+    {
+        count = ls2k_uart_dma_write_string(pUART, (char *)buf, size);
+    }
+    else
+
 #endif
 
 #if UART_USE_INT
@@ -1239,7 +1902,46 @@ STATIC_DRV int UART_ioctl(const void *dev, int cmd, void *arg)
         case IOCTL_UART_PRINT_RXTX_MODE:
             ls2k_uart_print_rxtx_mode(pUART);
             break;
-            
+
+#if UART_USE_DMA || UART_USE_INT
+        case IOCTL_UART_SET_RXBUF_SIZE:
+        case IOCTL_UART_SET_TXBUF_SIZE:
+            if (pUART->opened)
+            {
+                errno = EBUSY;
+                ret = -1;
+            }
+            else
+                ret = resize_buffer(cmd == IOCTL_UART_SET_RXBUF_SIZE ?
+                                    &pUART->RxData : &pUART->TxData, (long)arg);
+            break;
+
+        case IOCTL_UART_SET_OVERFLOW:
+            if (((long)arg < UART_OVERFLOW_OVERWRITE) || ((long)arg > UART_OVERFLOW_BLOCK))
+                ret = -1;
+#if UART_USE_DMA
+            else if (((long)arg == UART_OVERFLOW_BLOCK) && (pUART->RxTxMode & UART_RX_DMA))
+            {
+                errno = EINVAL;
+                ret = -1;
+            }
+#endif
+            else
+                pUART->overflow = (long)arg;
+            break;
+#endif
+
+        case IOCTL_UART_GET_STATS:
+            if (arg == NULL)
+                ret = -1;
+            else
+                memcpy(arg, &pUART->stats, sizeof(UART_stats_t));
+            break;
+
+        case IOCTL_UART_CLEAR_STATS:
+            memset(&pUART->stats, 0, sizeof(UART_stats_t));
+            break;
+
         default:
             break;
     }
@@ -1173,6 +1173,18 @@ extern unsigned long get_clock_ticks(void);
 extern void delay_ms(int ms);
 extern void delay_us(int us);
 
+/*
+ * 㶨Ƶʼ (rdtime.d), ÿ΢ hda_1us_count ,  tick.c ʼ
+ */
+extern unsigned int hda_1us_count;
+
+static inline unsigned long get_stable_counter(void)
+{
+    unsigned long val;
+    asm volatile( "rdtime.d %0, $r0 ; " : "=r"(val) );
+    return val;
+}
+
 #endif // _LS2K300_H
 
 /*
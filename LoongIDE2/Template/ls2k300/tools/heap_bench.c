@@ -0,0 +1,352 @@
+/*
+ * heap_bench.c
+ *
+ * created: 2026-10-17
+ *  author:
+ *
+ * ϶Ա misc/memory_man.c  TLSF ״ֶ,  malloc/free 
+ * ʱƬ.
+ *
+ * :    gcc -O2 -DHEAP_USE_TLSF=1 -I../BareMetal/include -I../../ls2k/osal \
+ *              -o heap_bench_tlsf heap_bench.c
+ *          gcc -O2 -DHEAP_USE_TLSF=0 -I../BareMetal/include -I../../ls2k/osal \
+ *              -o heap_bench_ff heap_bench.c
+ *
+ * ÷:    heap_bench_tlsf [ͷŴ] [ MB ]
+ *
+ * ģ lwIP/ͷ: 󲿷 pbuf СС, , ˳ͷ.
+ * ͬʱеĿٵ, ÿӽһµĶ. нʱԳ
+ * п, ͳʣռ뵽, õƬ; Ȼȫͷ, Ƿ
+ * й©У.
+ *
+ * ÿдУֽ, ͷǰ, ֮صʱᷢ. дʱ 1.
+ *
+ * memory_man.c ֱӰ, malloc/free ȸӰ C .
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+//-----------------------------------------------------------------------------
+// ϴ bsp.h/osal.h Ķ
+//-----------------------------------------------------------------------------
+
+#define _BSP_H                              /* ʹĿ bsp.h/osal.h */
+#define _OSAL_H
+
+#define BSP_USE_FS          0
+
+#ifndef HEAP_USE_TLSF
+#define HEAP_USE_TLSF       1
+#endif
+
+#define OSAL_WAIT_FOREVER   0xFFFFFFFF
+#define OSAL_OPT_FIFO       0x0001
+
+typedef void *osal_mutex_t;
+
+static osal_mutex_t osal_mutex_create(const char *name, uint32_t opt)
+{
+    (void)name;
+    (void)opt;
+    return NULL;
+}
+
+static int osal_mutex_obtain(osal_mutex_t mutex, uint32_t timeout_ms)
+{
+    (void)mutex;
+    (void)timeout_ms;
+    return 0;
+}
+
+static int osal_mutex_release(osal_mutex_t mutex)
+{
+    (void)mutex;
+    return 0;
+}
+
+static int osal_is_osrunning(void)
+{
+    return 0;
+}
+
+static int printk_quiet;
+
+void printk(const char *fmt, ...)
+{
+    va_list ap;
+
+    if (printk_quiet)
+        return;
+
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+}
+
+#define malloc              heap_malloc
+#define calloc              heap_calloc
+#define realloc             heap_realloc
+#define free                heap_free
+
+#include "../../ls2k/misc/memory_man.c"
+
+#undef malloc
+#undef calloc
+#undef realloc
+#undef free
+
+//-----------------------------------------------------------------------------
+// 
+//-----------------------------------------------------------------------------
+
+#define BENCH_BIG_RATIO     16              /* 1/16 Ǵ */
+
+struct bench_slot
+{
+    unsigned char *ptr;
+    size_t         size;
+};
+
+static unsigned int bench_seed = 1;
+
+static inline unsigned int bench_rand(void)
+{
+    bench_seed = bench_seed * 1103515245 + 12345;
+    return bench_seed >> 8;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*
+ * 볤: ̫֡/pbuf Ϊ,  b-misc-test/heap_bench.c ͬ
+ */
+static size_t bench_size(void)
+{
+    unsigned int r = bench_rand();
+
+    if (r % BENCH_BIG_RATIO == 0)
+        return 4096 + r % 65536;
+
+    switch (r % 4)
+    {
+        case 0:  return 1536 + 16;
+        case 1:  return 64 + r % 192;
+        default: return 16 + r % 1500;
+    }
+}
+
+static int bench_check(const struct bench_slot *slot)
+{
+    unsigned char fill = (unsigned char)((size_t)slot->ptr >> 3);
+    size_t i;
+
+    for (i = 0; i < slot->size; i++)
+    {
+        if (slot->ptr[i] != fill)
+            return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * ʣռ뵽
+ */
+static size_t bench_largest(void)
+{
+    size_t lo = 0, hi = get_heap_free_size();
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo + 1) / 2;
+        void *p = heap_malloc(mid);
+
+        if (p)
+        {
+            heap_free(p);
+            lo = mid;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+
+    return lo;
+}
+
+/*
+ * ӽ, ÿβԶµĶѿʼ
+ */
+static int bench_run(int slots, long rounds, size_t heap_bytes)
+{
+    uint64_t t0, cnt, malloc_sum = 0, malloc_max = 0, free_sum = 0, free_max = 0;
+    unsigned long malloc_cnt = 0, free_cnt = 0, failed = 0;
+    size_t free_before, free_left, largest;
+    struct bench_slot *slot;
+    void *heap;
+    long i;
+    int k, errors = 0;
+
+    heap = aligned_alloc(64, heap_bytes);
+    slot = calloc(slots, sizeof(struct bench_slot));
+    if (!heap || !slot || heap_add_region(heap, heap_bytes) != 0)
+    {
+        printf("heap init failed\n");
+        return 1;
+    }
+
+    free_before = get_heap_free_size();
+
+    for (i = 0; i < rounds; i++)
+    {
+        k = bench_rand() % slots;
+
+        if (slot[k].ptr)
+        {
+            if (bench_check(&slot[k]) != 0)
+                errors++;
+
+            t0 = now_ns();
+            heap_free(slot[k].ptr);
+            cnt = now_ns() - t0;
+
+            slot[k].ptr = NULL;
+            free_sum += cnt;
+            free_cnt++;
+            if (cnt > free_max)
+                free_max = cnt;
+        }
+        else
+        {
+            size_t size = bench_size();
+
+            t0 = now_ns();
+            slot[k].ptr = heap_malloc(size);
+            cnt = now_ns() - t0;
+
+            if (slot[k].ptr == NULL)
+            {
+                failed++;
+                continue;
+            }
+
+            slot[k].size = size;
+            memset(slot[k].ptr, (unsigned char)((size_t)slot[k].ptr >> 3), size);
+
+            malloc_sum += cnt;
+            malloc_cnt++;
+            if (cnt > malloc_max)
+                malloc_max = cnt;
+        }
+    }
+
+    free_left = get_heap_free_size();
+    largest = bench_largest();
+
+    for (k = 0; k < slots; k++)
+    {
+        if (slot[k].ptr)
+        {
+            if (bench_check(&slot[k]) != 0)
+                errors++;
+            heap_free(slot[k].ptr);
+        }
+    }
+
+    if (get_heap_free_size() != free_before)
+    {
+        printf("heap free %lu bytes, expect %lu, LEAK\n",
+               (unsigned long)get_heap_free_size(), (unsigned long)free_before);
+        errors++;
+    }
+
+    printf("%6d %10lu %8.0f %8lu %8.0f %8lu %8lu %6.1f%%\n", slots,
+           malloc_cnt,
+           malloc_cnt ? (double)malloc_sum / malloc_cnt : 0.0,
+           (unsigned long)malloc_max,
+           free_cnt ? (double)free_sum / free_cnt : 0.0,
+           (unsigned long)free_max,
+           failed,
+           free_left ? 100.0 - 100.0 * largest / free_left : 0.0);
+    fflush(stdout);
+
+    if (errors)
+    {
+        printf("%d block(s) corrupted or leaked\n", errors);
+        return 1;
+    }
+
+    printk_quiet = 1;
+    errors = heap_verify_faulty_blocks();
+    printk_quiet = 0;
+
+    if (errors != 0)
+    {
+        printf("heap verify: %d faulty block(s)\n", -errors);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    static const int counts[] = { 16, 64, 256, 1024, 4096 };
+    long rounds = 200000;
+    size_t heap_mb = 64;
+    int i, status, result = 0;
+
+    if (argc > 1)
+        rounds = atol(argv[1]);
+    if (argc > 2)
+        heap_mb = (size_t)atol(argv[2]);
+    if ((rounds <= 0) || (heap_mb < 1))
+    {
+        printf("usage: %s [rounds] [heap MB]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%s heap, %lu MB, %ld rounds, time in ns\n",
+           HEAP_USE_TLSF ? "TLSF" : "first-fit", (unsigned long)heap_mb, rounds);
+    printf("%6s %10s %8s %8s %8s %8s %8s %7s\n",
+           "slots", "mallocs", "m.avg", "m.max", "f.avg", "f.max", "failed", "frag");
+
+    for (i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++)
+    {
+        pid_t pid;
+
+        fflush(stdout);
+        pid = fork();
+
+        if (pid == 0)
+        {
+            bench_seed = 1;
+            _exit(bench_run(counts[i], rounds, heap_mb << 20));
+        }
+
+        if ((pid < 0) || (waitpid(pid, &status, 0) < 0) ||
+            !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+        {
+            result = 1;
+        }
+    }
+
+    return result;
+}
+
+/*
+ * @@ End
+ */
@@ -0,0 +1,258 @@
+/*
+ * mb_crc_bench.c
+ *
+ * created: 2026-10-17
+ *  author:
+ *
+ * Ϻ˶ modbus/src/mb_util.c  CRC-16  LRC, ٶ.
+ *
+ * :    gcc -O2 -DMODBUS_CFG_CRC_TABLE=8 -I../../ls2k/modbus/src -o mb_crc_bench \
+ *              mb_crc_bench.c ../../ls2k/modbus/src/mb_util.c
+ *
+ * MODBUS_CFG_CRC_TABLE ȡ 0/1/8 ֱ, ԭλĽֽڱȽ:
+ *
+ *      1. ȡݵͷֶ;
+ *      2. modbus_rtu_rx_byte() ͺֽڵֽۼ;
+ *      3. Сдʮַ LRC.
+ *
+ * вһʱ 1.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "mb.h"
+
+//-----------------------------------------------------------------------------
+// ԭλʵ
+//-----------------------------------------------------------------------------
+
+static uint16_t ref_crc16(const uint8_t *pblock, int length)
+{
+    uint16_t crc = 0xFFFF;
+    uint8_t  shiftctr;
+    bool     flag;
+
+    while (length > 0)
+    {
+        length--;
+        crc ^= (uint16_t)*pblock++;
+        shiftctr = 8;
+        do
+        {
+            flag = (crc & 0x0001) ? true : false;
+            crc >>= 1;
+            if (flag == true)
+                crc ^= MODBUS_CRC16_POLY;
+
+            shiftctr--;
+        } while (shiftctr > 0);
+    }
+
+    return crc;
+}
+
+static uint8_t ref_hex_to_bin(const uint8_t *phex)
+{
+    uint8_t value, high = phex[0], low = phex[1];
+
+    if (high <= '9')
+        value  = (uint8_t)(high - '0');
+    else if (high <= 'F')
+        value  = (uint8_t)(high - 'A' + 10);
+    else
+        value  = (uint8_t)(high - 'a' + 10);
+    value <<= 4;
+
+    if (low <= '9')
+        value += (uint8_t)(low - '0');
+    else if (low <= 'F')
+        value += (uint8_t)(low - 'A' + 10);
+    else
+        value += (uint8_t)(low - 'a' + 10);
+
+    return value;
+}
+
+static uint8_t ref_lrc(const uint8_t *phex, int len)
+{
+    uint8_t lrc = 0;
+
+    while (len-- > 0)
+    {
+        lrc  += ref_hex_to_bin(phex);
+        phex += 2;
+    }
+
+    return (uint8_t)(~lrc + 1);
+}
+
+//-----------------------------------------------------------------------------
+
+static MODBUS_t mb;
+static int errors;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void check(const char *what, int len, unsigned int got, unsigned int want)
+{
+    if (got != want)
+    {
+        if (errors < 10)
+            printf("%s: len %d, got 0x%04X, want 0x%04X\n", what, len, got, want);
+        errors++;
+    }
+}
+
+static void test_crc(void)
+{
+    uint8_t buf[MODBUS_CFG_BUF_SIZE];
+    int i, n, len, cut;
+
+    for (n = 0; n < 100000; n++)
+    {
+        len = rand() % (MODBUS_CFG_BUF_SIZE + 1);
+        for (i = 0; i < len; i++)
+            buf[i] = (uint8_t)rand();
+
+        check("block", len, modbus_crc16_update(0xFFFF, buf, len), ref_crc16(buf, len));
+
+        cut = len ? rand() % len : 0;
+        check("split", len,
+              modbus_crc16_update(modbus_crc16_update(0xFFFF, buf, cut), buf + cut, len - cut),
+              ref_crc16(buf, len));
+    }
+}
+
+/*
+ * ͬ modbus_rtu_rx_byte()  modbus_rtu_rx_calculate_crc()
+ */
+static void test_rtu_rx(void)
+{
+    uint16_t crc;
+    unsigned int i, n, len;
+
+    for (n = 0; n < 20000; n++)
+    {
+        len = 4 + rand() % (MODBUS_CFG_BUF_SIZE - 4 + 1);
+
+        for (i = 0; i < len; i++)
+        {
+            mb.RxBuf[i] = (uint8_t)rand();
+
+            if (i + 2 < len)                /* ֡,  CRC */
+            {
+                mb.RxFrameData[i] = mb.RxBuf[i];
+                mb.TxFrameData[i] = mb.RxBuf[i];
+            }
+
+            if (i == 0)
+            {
+                mb.RxCRC_Run    = 0xFFFF;
+                mb.RxCRC_RunCtr = 0;
+            }
+            else if (i >= 2)
+            {
+                mb.RxCRC_Run = modbus_crc16_update(mb.RxCRC_Run, &mb.RxBuf[i - 2], 1);
+                mb.RxCRC_RunCtr++;
+            }
+        }
+
+        mb.RxFrameNDataBytes = len - 4;
+
+        crc = ref_crc16(mb.RxBuf, len - 2);
+        check("rx running", len, modbus_rtu_rx_calculate_crc(&mb), crc);
+
+        mb.RxCRC_RunCtr = 0;                /* ûۼʱ֡ */
+        check("rx block", len, modbus_rtu_rx_calculate_crc(&mb), crc);
+
+        mb.TxFrameNDataBytes = len - 4;
+        check("tx", len, modbus_rtu_tx_calculate_crc(&mb), crc);
+    }
+}
+
+static void test_lrc(void)
+{
+    static const char hex[] = "0123456789ABCDEFabcdef";
+    int i, n, len;
+
+    for (n = 0; n < 20000; n++)
+    {
+        len = 1 + rand() % ((MODBUS_CFG_BUF_SIZE - 5) / 2);
+
+        mb.RxBuf[0] = ':';
+        for (i = 0; i < len * 2; i++)
+            mb.RxBuf[1 + i] = hex[rand() % (sizeof(hex) - 1)];
+
+        mb.RxBufByteCtr = len * 2 + 5;
+        check("rx lrc", len, modbus_ascii_rx_calculate_lrc(&mb), ref_lrc(&mb.RxBuf[1], len));
+
+        memcpy(mb.TxBuf, mb.RxBuf, len * 2 + 1);
+        check("tx lrc", len, modbus_ascii_tx_calculate_lrc(&mb, len * 2 + 1), ref_lrc(&mb.TxBuf[1], len));
+    }
+}
+
+static void bench(int len)
+{
+    static uint8_t buf[MODBUS_CFG_BUF_SIZE];
+    volatile uint16_t sink;
+    uint64_t t0, t_ref, t_new;
+    int i, loops = 20000000 / len;
+
+    for (i = 0; i < len; i++)
+        buf[i] = (uint8_t)rand();
+
+    t0 = now_ns();
+    for (i = 0; i < loops; i++)
+    {
+        buf[0] = (uint8_t)i;
+        sink = ref_crc16(buf, len);
+    }
+    t_ref = now_ns() - t0;
+
+    t0 = now_ns();
+    for (i = 0; i < loops; i++)
+    {
+        buf[0] = (uint8_t)i;
+        sink = modbus_crc16_update(0xFFFF, buf, len);
+    }
+    t_new = now_ns() - t0;
+
+    (void)sink;
+
+    printf("%6d %12.2f %12.2f\n", len,
+           (double)t_ref / loops / len, (double)t_new / loops / len);
+}
+
+int main(void)
+{
+    srand(1);
+
+    test_crc();
+    test_rtu_rx();
+    test_lrc();
+
+    printf("MODBUS_CFG_CRC_TABLE=%d: %s\n", MODBUS_CFG_CRC_TABLE,
+           errors ? "FAILED" : "all results match the bitwise CRC-16 and LRC");
+
+    printf("%6s %12s %12s\n", "bytes", "bitwise ns/B", "current ns/B");
+    bench(8);
+    bench(64);
+    bench(MODBUS_CFG_BUF_SIZE);
+
+    return errors ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+/*
+ * @@ End
+ */
+
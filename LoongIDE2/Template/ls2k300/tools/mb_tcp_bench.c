@@ -0,0 +1,462 @@
+/*
+ * mb_tcp_bench.c
+ *
+ * created: 2026-10-17
+ *  author:
+ *
+ *  BSD socket  lwIP,  modbus/port/mb_tcp.c ķͿͻ,
+ * Э鴦ٶ.
+ *
+ * :    gcc -O2 -I../BareMetal/include -I../../ls2k/osal -I../../ls2k/lwip-2.1.3/include \
+ *              -o mb_tcp_bench mb_tcp_bench.c -lpthread
+ *
+ * ÷:    mb_tcp_bench [TCP ˿]
+ *
+ *      1. վ FC03/FC04/FC06 д, Ԫŷ쳣 11;
+ *      2. 64 Ͳг 37 ֽڵС, Ӧ˳;
+ *      3. ЭŴʱر;
+ *      4.  MODBUS_CFG_TCP_CONN_MAX ʱ, رտõ;
+ *      5. һͻֻӦʱ, ӵӦӳ, Լ
+ *         MB_TCP_TX_TIMEOUT_MS 󱻹ر;
+ *      6. 125 ĴĶ, һһÿ 32 ٶ.
+ *
+ * modbus ԴֱӰ,  pthread . дʱ 1.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+//-----------------------------------------------------------------------------
+// ϴ bsp.h/osal.h/lwip/sockets.h Ķ
+//-----------------------------------------------------------------------------
+
+#define _BSP_H                              /* ʹĿ bsp.h/osal.h/lwIP */
+#define _OSAL_H
+#define LWIP_HDR_SOCKETS_H
+
+#define BSP_USE_OS          1
+#define MODBUS_CFG_TCP_EN   1
+
+#define LWIP_SOCKET         1
+#define MEMP_NUM_TCP_PCB    16              /*  lwIP port  lwipopts.h ͬ */
+#define MEMP_NUM_NETCONN    20
+
+#define closesocket         close
+#define IPADDR_NONE         INADDR_NONE
+
+#define printk              printf
+
+typedef void *osal_task_t;
+
+static unsigned long get_clock_ticks(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000UL + ts.tv_nsec / 1000000;
+}
+
+struct bench_task
+{
+    void (*entry)(void *arg);
+    void  *arg;
+};
+
+static void *bench_task_entry(void *arg)
+{
+    struct bench_task task = *(struct bench_task *)arg;
+
+    free(arg);
+    task.entry(task.arg);
+    return NULL;
+}
+
+static osal_task_t osal_task_create(const char *name, uint32_t stack_size, uint32_t prio,
+                                    uint32_t slice, void (*entry)(void *arg), void *arg)
+{
+    struct bench_task *task = malloc(sizeof(struct bench_task));
+    pthread_t thread;
+
+    (void)name;
+    (void)stack_size;
+    (void)prio;
+    (void)slice;
+
+    task->entry = entry;
+    task->arg   = arg;
+    if (pthread_create(&thread, NULL, bench_task_entry, task) != 0)
+    {
+        free(task);
+        return NULL;
+    }
+
+    return (osal_task_t)thread;
+}
+
+static void osal_task_delete(osal_task_t task)
+{
+    pthread_cancel((pthread_t)task);
+    pthread_join((pthread_t)task, NULL);
+}
+
+static void osal_msleep(unsigned int ms)
+{
+    usleep(ms * 1000);
+}
+
+#define osal_enter_critical_section()   0
+#define osal_leave_critical_section(l)  (void)(l)
+
+#include "../../ls2k/modbus/src/mb.c"
+#include "../../ls2k/modbus/src/mb_util.c"
+#include "../../ls2k/modbus/src/mb_slave.c"
+#include "../../ls2k/modbus/src/mb_master.c"
+#include "../../ls2k/modbus/app/mb_data.c"
+#include "../../ls2k/modbus/port/mb_os.c"
+#include "../../ls2k/modbus/port/mb_tcp.c"
+
+/*
+ *  mb_bsp.c, ûд
+ */
+uint8_t  mb_devices_count = 0;
+MODBUS_t mb_devices_tbl[MODBUS_CFG_CHNL_MAX];
+uint16_t mb_rtu_frequency = 0;
+uint32_t mb_rtu_timer_count = 0;
+
+void modbus_hw_port_exit(void) { }
+void modbus_rtu_timer_init(void) { }
+void modbus_rtu_timer_exit(void) { }
+void modbus_rtu_timer_restart(MODBUS_t *p_mb) { (void)p_mb; }
+void modbus_tx_bytes(MODBUS_t *p_mb) { (void)p_mb; }
+
+void modbus_hw_port_config(MODBUS_t *p_mb, uint32_t baud, uint8_t bits, uint8_t parity, uint8_t stops)
+{
+    (void)p_mb;
+    (void)baud;
+    (void)bits;
+    (void)parity;
+    (void)stops;
+}
+
+int modbus_rx_1byte(MODBUS_t *p_mb, uint8_t *rx_byte, int timeout)
+{
+    (void)p_mb;
+    (void)rx_byte;
+    (void)timeout;
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// 
+//-----------------------------------------------------------------------------
+
+#define BENCH_REQ_SIZE      12              /* FC03  ADU */
+#define BENCH_REGS          125
+#define BENCH_RSP_SIZE      (MODBUS_TCP_MBAP_SIZE + 2 + 2 * BENCH_REGS)
+#define BENCH_ROUNDS        20000
+
+static int bench_port = 15020;
+static int bench_fails;
+
+#define CHECK(c)    do { if (!(c)) { printf("FAIL line %d: %s\n", __LINE__, #c); bench_fails++; } } while (0)
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int bench_connect(int rcvbuf)
+{
+    struct sockaddr_in addr;
+    int sock, opt = 1;
+
+    sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (rcvbuf > 0)
+        setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(bench_port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror("connect");
+        exit(1);
+    }
+
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+    return sock;
+}
+
+/*
+ * FC03 ּĴ
+ */
+static int bench_request(uint8_t *buf, uint16_t trans_id, uint8_t unit_id, uint16_t start, uint16_t count)
+{
+    buf[0]  = (uint8_t)(trans_id >> 8);
+    buf[1]  = (uint8_t) trans_id;
+    buf[2]  = 0;
+    buf[3]  = 0;
+    buf[4]  = 0;
+    buf[5]  = 6;
+    buf[6]  = unit_id;
+    buf[7]  = 3;
+    buf[8]  = (uint8_t)(start >> 8);
+    buf[9]  = (uint8_t) start;
+    buf[10] = (uint8_t)(count >> 8);
+    buf[11] = (uint8_t) count;
+    return BENCH_REQ_SIZE;
+}
+
+static int bench_recv(int sock, uint8_t *buf, int len)
+{
+    int got = 0, rt;
+
+    while (got < len)
+    {
+        rt = recv(sock, buf + got, len - got, 0);
+        if (rt <= 0)
+            break;
+        got += rt;
+    }
+
+    return got;
+}
+
+static void bench_master(MODBUS_t *cli)
+{
+    uint16_t regs[4];
+
+    CHECK(modbus_master_fc03_read_holding_register(cli, 1, 0, regs, 4) == MODBUS_ERR_NONE);
+    CHECK(regs[0] == 0xDEAD && regs[1] == 0xBEAF && regs[2] == 0x55AA && regs[3] == 0xAA55);
+
+    CHECK(modbus_master_fc04_read_in_register(cli, 1, 0, regs, 4) == MODBUS_ERR_NONE);
+    CHECK(regs[0] == 0x5555 && regs[3] == 0xA5A5);
+
+    CHECK(modbus_master_fc06_write_holding_register(cli, 1, 0, 0x1234) == MODBUS_ERR_NONE);
+
+    /* 쳣 11: վյĹ벻ͬ */
+    CHECK(modbus_master_fc03_read_holding_register(cli, 7, 0, regs, 1) == MODBUS_ERR_FC);
+}
+
+static void bench_pipelined(void)
+{
+    uint8_t buf[64 * BENCH_REQ_SIZE], rsp[16], unit_id;
+    int sock, i, n;
+
+    sock = bench_connect(0);
+
+    for (i = 0; i < 64; i++)
+    {
+        unit_id = (i % 3 == 0) ? 0xFF : (i % 3 == 1) ? 1 : 0;
+        bench_request(&buf[i * BENCH_REQ_SIZE], 1000 + i, unit_id, i % 4, 1);
+    }
+
+    for (i = 0; i < (int)sizeof(buf); i += 37)
+    {
+        n = (sizeof(buf) - i < 37) ? sizeof(buf) - i : 37;
+        send(sock, &buf[i], n, 0);
+        usleep(200);
+    }
+
+    for (i = 0; i < 64; i++)
+    {
+        unit_id = (i % 3 == 0) ? 0xFF : (i % 3 == 1) ? 1 : 0;
+        CHECK(bench_recv(sock, rsp, 11) == 11);
+        CHECK(((rsp[0] << 8) | rsp[1]) == 1000 + i && rsp[5] == 5 && rsp[7] == 3 && rsp[8] == 2);
+        CHECK(rsp[6] == unit_id);
+    }
+
+    bench_request(buf, 77, 9, 0, 1);                /* Ԫ */
+    send(sock, buf, BENCH_REQ_SIZE, 0);
+    CHECK(bench_recv(sock, rsp, 9) == 9 && rsp[6] == 9 && rsp[7] == 0x83 && rsp[8] == MODBUS_ERR_GW_TARGET);
+
+    bench_request(buf, 78, 1, 0, 1);                /* ЭŴ */
+    buf[3] = 1;
+    send(sock, buf, BENCH_REQ_SIZE, 0);
+    CHECK(bench_recv(sock, rsp, 1) == 0);
+
+    close(sock);
+}
+
+static void bench_conn_max(void)
+{
+    int socks[MODBUS_CFG_TCP_CONN_MAX + 4];
+    int count = MODBUS_CFG_TCP_CONN_MAX + 4;
+    uint8_t buf[BENCH_REQ_SIZE], rsp[16];
+    int i, rt;
+
+    for (i = 0; i < count; i++)
+    {
+        socks[i] = bench_connect(0);
+        bench_request(buf, i, 1, 0, 1);
+        send(socks[i], buf, BENCH_REQ_SIZE, 0);
+        CHECK(bench_recv(socks[i], rsp, 11) == 11);
+        usleep(20000);
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        bench_request(buf, 100 + i, 1, 0, 1);
+        send(socks[i], buf, BENCH_REQ_SIZE, 0);
+        rt = bench_recv(socks[i], rsp, 11);
+        if (i < count - MODBUS_CFG_TCP_CONN_MAX)    /* ļر */
+            CHECK(rt == 0);
+        else
+            CHECK(rt == 11);
+        close(socks[i]);
+    }
+}
+
+/*
+ * һͻֻ, һһһ
+ */
+static void bench_stalled(void)
+{
+    uint8_t buf[BENCH_REQ_SIZE], rsp[BENCH_RSP_SIZE];
+    double t0, t1, t_end, lat, lat_max = 0;
+    int stalled, sock, sent = 0, got = 0, rt, i;
+    struct timeval tv = { 0, 100000 };
+
+    stalled = bench_connect(4096);
+
+    t0 = now_s();
+    while (now_s() - t0 < 0.5)                      /*  socket  */
+    {
+        bench_request(buf, sent, 1, 0, BENCH_REGS);
+        if (send(stalled, buf, BENCH_REQ_SIZE, MSG_DONTWAIT) == BENCH_REQ_SIZE)
+            sent++;
+        else
+            usleep(1000);
+    }
+
+    sock  = bench_connect(0);
+    t_end = now_s() + (MB_TCP_TX_TIMEOUT_MS + MB_TCP_SELECT_MS) / 1000.0 + 1;
+
+    for (i = 0; now_s() < t_end; i++)
+    {
+        bench_request(buf, i, 1, 0, BENCH_REGS);
+        t1 = now_s();
+        send(sock, buf, BENCH_REQ_SIZE, 0);
+        if (bench_recv(sock, rsp, BENCH_RSP_SIZE) != BENCH_RSP_SIZE)
+        {
+            bench_fails++;
+            break;
+        }
+
+        lat = now_s() - t1;
+        if (lat > lat_max)
+            lat_max = lat;
+        usleep(1000);
+    }
+
+    printf("stalled client: %d requests queued, %d requests on another connection, max %.1f ms\n",
+           sent, i, lat_max * 1000);
+    CHECK(lat_max * 1000 < MB_TCP_TX_TIMEOUT_MS / 10);
+
+    /* ʱӦѹر, 껺еӦӽ */
+    setsockopt(stalled, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    while ((rt = recv(stalled, rsp, sizeof(rsp), 0)) > 0)
+        got += rt;
+    CHECK(rt == 0 || errno == ECONNRESET);
+    CHECK(got < sent * BENCH_RSP_SIZE);
+
+    close(stalled);
+    close(sock);
+}
+
+static void bench_speed(void)
+{
+    uint8_t buf[32 * BENCH_REQ_SIZE], rsp[BENCH_RSP_SIZE];
+    double t0, t1, t2;
+    int sock, i, k;
+
+    sock = bench_connect(0);
+
+    t0 = now_s();
+    for (i = 0; i < BENCH_ROUNDS; i++)
+    {
+        bench_request(buf, i, 1, 0, BENCH_REGS);
+        send(sock, buf, BENCH_REQ_SIZE, 0);
+        if (bench_recv(sock, rsp, BENCH_RSP_SIZE) != BENCH_RSP_SIZE)
+        {
+            bench_fails++;
+            break;
+        }
+    }
+
+    t1 = now_s();
+    for (i = 0; i < BENCH_ROUNDS; i += 32)
+    {
+        for (k = 0; k < 32; k++)
+            bench_request(&buf[k * BENCH_REQ_SIZE], i + k, 1, 0, BENCH_REGS);
+        send(sock, buf, sizeof(buf), 0);
+        for (k = 0; k < 32; k++)
+        {
+            if (bench_recv(sock, rsp, BENCH_RSP_SIZE) != BENCH_RSP_SIZE)
+            {
+                bench_fails++;
+                break;
+            }
+        }
+    }
+
+    t2 = now_s();
+    printf("%d regs: lockstep %.0f req/s, 32 in flight %.0f req/s\n",
+           BENCH_REGS, BENCH_ROUNDS / (t1 - t0), BENCH_ROUNDS / (t2 - t1));
+
+    close(sock);
+}
+
+int main(int argc, char **argv)
+{
+    MODBUS_t *srv, *cli;
+    uint16_t regs[2];
+
+    if (argc > 1)
+        bench_port = atoi(argv[1]);
+
+    modbus_init(1000);
+
+    srv = modbus_tcp_server_init(1, bench_port, MODBUS_WR_EN);
+    if (srv == NULL)
+        return 1;
+    usleep(100000);
+
+    cli = modbus_tcp_client_open("127.0.0.1", bench_port, 1000);
+    CHECK(cli != NULL && cli->TCP_Socket >= 0);
+    if (cli == NULL)
+        return 1;
+
+    bench_master(cli);
+    bench_pipelined();
+    bench_conn_max();
+    bench_stalled();
+    bench_speed();
+
+    modbus_tcp_client_close(cli);                   /* һ */
+    CHECK(modbus_master_fc03_read_holding_register(cli, 1, 0, regs, 2) == MODBUS_ERR_NONE);
+
+    modbus_tcp_server_exit();
+    CHECK(modbus_master_fc03_read_holding_register(cli, 1, 0, regs, 2) != MODBUS_ERR_NONE);
+
+    printf("%s, %d failure(s)\n", bench_fails ? "FAILED" : "PASSED", bench_fails);
+    return bench_fails ? 1 : 0;
+}
+
+/*
+ * @@ End
+ */
@@ -0,0 +1,243 @@
+/*
+ * pesudoos_bench.c
+ *
+ * created: 2026-10-17
+ *  author:
+ *
+ * ϲ PesudoOS ĵӳĹϵ.
+ *
+ * :    gcc -O2 -U_FORTIFY_SOURCE -I../../ls2k/PesudoOS -o pesudoos_bench \
+ *              pesudoos_bench.c ../../ls2k/PesudoOS/pesudo*.c
+ *
+ * ÷:    pesudoos_bench [ÿԺ]
+ *
+ * źŵ, ڸԵźŵϻʱ˯.
+ * ͳƴ pesudo_sem_release() ʼеʱ, Լÿ.
+ *
+ * û jmp_func_with_stack(),  x86_64/aarch64 ʵ.
+ * glibc  longjmp_chk ջ, Աȥ _FORTIFY_SOURCE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "pesudoos.h"
+
+//-----------------------------------------------------------------------------
+// ϴ BSP ĺ
+//-----------------------------------------------------------------------------
+
+unsigned int RunningInsideISR = 0;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+uint64_t get_clock_ticks(void)
+{
+    return now_ns() / 1000000;
+}
+
+void delay_ms(int ms)
+{
+    usleep(ms * 1000);
+}
+
+void printk(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+}
+
+/*
+ * void jmp_func_with_stack(void (*func)(void *), void *arg, size_t stack);
+ *
+ *  stack ϵ func(arg), ʱָԭĶջ.
+ *
+ * صַԭջָ뱣ջ:  longjmp ָʱ,
+ * ѭջϵλѾø.
+ */
+#if defined(__x86_64__)
+__asm__ (
+    "    .text                              \n"
+    "    .globl  jmp_func_with_stack        \n"
+    "jmp_func_with_stack:                   \n"
+    "    popq    %rcx                       \n"
+    "    andq    $-16, %rdx                 \n"
+    "    movq    %rsp, -8(%rdx)             \n"
+    "    movq    %rcx, -16(%rdx)            \n"
+    "    leaq    -16(%rdx), %rsp            \n"
+    "    movq    %rdi, %rax                 \n"
+    "    movq    %rsi, %rdi                 \n"
+    "    callq   *%rax                      \n"
+    "    movq    (%rsp), %rcx               \n"
+    "    movq    8(%rsp), %rsp              \n"
+    "    jmpq    *%rcx                      \n"
+);
+#elif defined(__aarch64__)
+__asm__ (
+    "    .text                              \n"
+    "    .globl  jmp_func_with_stack        \n"
+    "jmp_func_with_stack:                   \n"
+    "    and     x2, x2, #-16               \n"
+    "    mov     x9, sp                     \n"
+    "    stp     x9, x30, [x2, #-16]!       \n"
+    "    mov     sp, x2                     \n"
+    "    mov     x16, x0                    \n"
+    "    mov     x0, x1                     \n"
+    "    blr     x16                        \n"
+    "    ldp     x9, x30, [sp]              \n"
+    "    mov     sp, x9                     \n"
+    "    ret                                \n"
+);
+#else
+#error "jmp_func_with_stack() is not implemented for this host"
+#endif
+
+//-----------------------------------------------------------------------------
+// 
+//-----------------------------------------------------------------------------
+
+#define BENCH_WAIT_MS       1000000         /* ĵȴʱ */
+
+static struct pesudo_sem *sem_ping, *sem_pong;
+
+static uint64_t release_ns;                 /* pesudo_sem_release() ʱ */
+static uint64_t lat_sum, lat_max;
+static unsigned long rounds;
+
+static void ping_task(void *arg)
+{
+    (void)arg;
+
+    release_ns = now_ns();
+    pesudo_sem_release(sem_pong);
+    pesudo_sem_obtain(sem_ping, 1000);
+}
+
+static void pong_task(void *arg)
+{
+    (void)arg;
+
+    if (pesudo_sem_obtain(sem_pong, 1000) == 0)
+    {
+        uint64_t lat = now_ns() - release_ns;
+
+        lat_sum += lat;
+        if (lat > lat_max)
+            lat_max = lat;
+        rounds++;
+
+        pesudo_sem_release(sem_ping);
+    }
+}
+
+static void blocked_task(void *arg)
+{
+    pesudo_sem_obtain((struct pesudo_sem *)arg, BENCH_WAIT_MS);
+}
+
+static void sleep_task(void *arg)
+{
+    (void)arg;
+
+    pesudo_task_sleep(BENCH_WAIT_MS);
+}
+
+/*
+ * ӽ, ÿβԶӿյʼ
+ */
+static void bench_run(int tasks, int ms)
+{
+    uint64_t begin, end;
+    int i;
+
+    sem_ping = pesudo_sem_create("ping", PESUDO_OPT_FIFO, 0);
+    sem_pong = pesudo_sem_create("pong", PESUDO_OPT_FIFO, 0);
+
+    /* ȴ, ǰ */
+    for (i = 2; i < tasks; i++)
+    {
+        if (i & 1)
+            pesudo_task_create("sleep", 0, 0, sleep_task, NULL);
+        else
+            pesudo_task_create("block", 0, 0, blocked_task,
+                               pesudo_sem_create("bg", PESUDO_OPT_FIFO, 0));
+    }
+
+    pesudo_task_create("pong", 0, 0, pong_task, NULL);
+    pesudo_task_create("ping", 0, 0, ping_task, NULL);
+
+    begin = now_ns();
+    end = begin + (uint64_t)ms * 1000000;
+
+    while (now_ns() < end)
+    {
+        pesudoos_run(0);
+    }
+
+    end = now_ns();
+
+    printf("%6d %12.0f %10.0f %10.0f\n", tasks,
+           rounds * 1e9 / (double)(end - begin),
+           rounds ? (double)lat_sum / rounds : 0.0,
+           (double)lat_max);
+}
+
+int main(int argc, char **argv)
+{
+    static const int counts[] = { 2, 8, 32, 128, 512, 2048 };
+    int i, ms = 500;
+
+    if (argc > 1)
+    {
+        ms = atoi(argv[1]);
+        if (ms <= 0)
+            ms = 500;
+    }
+
+    printf("%6s %12s %10s %10s\n", "tasks", "rounds/s", "avg ns", "max ns");
+
+    for (i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++)
+    {
+        pid_t pid;
+
+        fflush(stdout);
+
+        pid = fork();
+        if (pid == 0)
+        {
+            bench_run(counts[i], ms);
+            fflush(stdout);
+            _exit(0);
+        }
+        else if (pid > 0)
+        {
+            waitpid(pid, NULL, 0);
+        }
+        else
+        {
+            perror("fork");
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+/*
+ * @@ End
+ */
+
@@ -0,0 +1,461 @@
+/*
+ * trace_decode.c
+ *
+ * created: 2026-10-17
+ *  author:
+ *
+ * Ͻ ls2k_trace_buf ת,  drivers/include/ls2k_trace.h.
+ *
+ * :    gcc -O2 -o trace_decode trace_decode.c
+ *
+ * ÷:    trace_decode <elf ļ> <תļ>
+ *
+ * תļ:
+ *
+ *      1. ڴת,  gdb :
+ *         dump binary memory trace.bin &ls2k_trace_buf ((char *)&ls2k_trace_buf)+sizeof(ls2k_trace_buf)
+ *      2. ־: trace_dump()  "@TRC ƫ " , к.
+ *
+ * ʽַ %s  ELF ļѷж.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define TRACE_MAGIC         0x31435254
+#define TRACE_HDR_SIZE      64
+#define TRACE_MAX_ARGS      5
+
+//-----------------------------------------------------------------------------
+// ELF64 little-endian
+//-----------------------------------------------------------------------------
+
+typedef struct
+{
+    uint64_t addr;
+    uint64_t size;
+    const unsigned char *data;
+} section_t;
+
+static unsigned char *elf_image;
+static size_t         elf_size;
+static section_t     *sections;
+static int            section_count;
+
+static uint16_t rd16(const unsigned char *p) { return p[0] | (p[1] << 8); }
+static uint32_t rd32(const unsigned char *p) { return rd16(p) | ((uint32_t)rd16(p + 2) << 16); }
+static uint64_t rd64(const unsigned char *p) { return rd32(p) | ((uint64_t)rd32(p + 4) << 32); }
+
+static unsigned char *load_file(const char *name, size_t *size)
+{
+    unsigned char *buf;
+    FILE *fp;
+    long len;
+
+    fp = fopen(name, "rb");
+    if (fp == NULL)
+    {
+        perror(name);
+        return NULL;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    buf = malloc(len + 1);
+    if ((buf == NULL) || (fread(buf, 1, len, fp) != (size_t)len))
+    {
+        fprintf(stderr, "%s: read fail\n", name);
+        fclose(fp);
+        free(buf);
+        return NULL;
+    }
+
+    buf[len] = 0;
+    *size = (size_t)len;
+
+    fclose(fp);
+    return buf;
+}
+
+static int elf_load(const char *name)
+{
+    uint64_t shoff;
+    int i, shentsize, shnum;
+
+    elf_image = load_file(name, &elf_size);
+    if (elf_image == NULL)
+    {
+        return -1;
+    }
+
+    if ((elf_size < 64) || memcmp(elf_image, "\177ELF", 4) ||
+        (elf_image[4] != 2) || (elf_image[5] != 1))
+    {
+        fprintf(stderr, "%s: not a little-endian ELF64 file\n", name);
+        return -1;
+    }
+
+    shoff     = rd64(elf_image + 0x28);
+    shentsize = rd16(elf_image + 0x3A);
+    shnum     = rd16(elf_image + 0x3C);
+
+    if (shoff + (uint64_t)shentsize * shnum > elf_size)
+    {
+        fprintf(stderr, "%s: bad section table\n", name);
+        return -1;
+    }
+
+    sections = calloc(shnum, sizeof(section_t));
+
+    for (i = 0; i < shnum; i++)
+    {
+        const unsigned char *sh = elf_image + shoff + (uint64_t)i * shentsize;
+        uint32_t type  = rd32(sh + 0x04);
+        uint64_t flags = rd64(sh + 0x08);
+        uint64_t off   = rd64(sh + 0x18);
+
+        /* SHT_PROGBITS  SHF_ALLOC */
+        if ((type != 1) || !(flags & 0x2) || (off > elf_size))
+        {
+            continue;
+        }
+
+        sections[section_count].addr = rd64(sh + 0x10);
+        sections[section_count].size = rd64(sh + 0x20);
+        sections[section_count].data = elf_image + off;
+
+        if (off + sections[section_count].size <= elf_size)
+        {
+            section_count++;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * ĿַתΪ ELF еַ
+ */
+static const char *elf_string(uint64_t addr)
+{
+    int i;
+
+    for (i = 0; i < section_count; i++)
+    {
+        section_t *s = &sections[i];
+
+        if ((addr >= s->addr) && (addr < s->addr + s->size) &&
+            memchr(s->data + (addr - s->addr), 0, s->size - (addr - s->addr)))
+        {
+            return (const char *)s->data + (addr - s->addr);
+        }
+    }
+
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// תļ
+//-----------------------------------------------------------------------------
+
+static int hexval(int c)
+{
+    if ((c >= '0') && (c <= '9')) return c - '0';
+    if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+    if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+    return -1;
+}
+
+/*
+ * ־е "@TRC ƫ " תΪ
+ */
+static unsigned char *parse_text_dump(const unsigned char *text, size_t *size)
+{
+    const char *p = (const char *)text;
+    unsigned char *buf = NULL;
+    size_t cap = 0, len = 0;
+
+    while ((p = strstr(p, "@TRC ")) != NULL)
+    {
+        unsigned long off;
+        char *end;
+        int hi, lo;
+
+        off = strtoul(p + 5, &end, 16);
+        p = end;
+        while (*p == ' ')
+            p++;
+
+        while (((hi = hexval(p[0])) >= 0) && ((lo = hexval(p[1])) >= 0))
+        {
+            if (off >= cap)
+            {
+                cap = (off + 1) * 2;
+                buf = realloc(buf, cap);
+                memset(buf + len, 0, cap - len);
+            }
+
+            buf[off++] = (unsigned char)((hi << 4) | lo);
+            if (off > len)
+                len = off;
+
+            p += 2;
+        }
+    }
+
+    *size = len;
+    return buf;
+}
+
+//-----------------------------------------------------------------------------
+// ʽַһ¼
+//-----------------------------------------------------------------------------
+
+static void print_record(const char *fmt, const uint64_t *arg)
+{
+    char spec[32];
+    int  argi = 0;
+
+    while (*fmt)
+    {
+        const char *start = fmt;
+        int len = 0;
+
+        if (*fmt != '%')
+        {
+            putchar(*fmt++);
+            continue;
+        }
+
+        fmt++;
+        if (*fmt == '%')
+        {
+            putchar('%');
+            fmt++;
+            continue;
+        }
+
+        while (*fmt && strchr("-+ #0", *fmt))
+            fmt++;
+        while ((*fmt >= '0') && (*fmt <= '9'))
+            fmt++;
+        if (*fmt == '.')
+        {
+            fmt++;
+            while ((*fmt >= '0') && (*fmt <= '9'))
+                fmt++;
+        }
+        while (*fmt && strchr("hlzjt", *fmt))
+        {
+            if (*fmt == 'l' || *fmt == 'z' || *fmt == 'j' || *fmt == 't')
+                len++;
+            fmt++;
+        }
+
+        if ((*fmt == 0) || (fmt - start >= (int)sizeof(spec) - 4))
+        {
+            fputs(start, stdout);
+            return;
+        }
+
+        /* ȥ, ͳһ long long  int  */
+        {
+            const char *q;
+            int n = 0;
+
+            for (q = start; q < fmt; q++)
+            {
+                if (!strchr("hlzjt", *q))
+                    spec[n++] = *q;
+            }
+
+            if (len && strchr("diouxX", *fmt))
+            {
+                spec[n++] = 'l';
+                spec[n++] = 'l';
+            }
+
+            spec[n++] = *fmt;
+            spec[n] = 0;
+        }
+
+        {
+            uint64_t v = (argi < TRACE_MAX_ARGS) ? arg[argi] : 0;
+            argi++;
+
+            switch (*fmt)
+            {
+                case 's':
+                {
+                    const char *s = elf_string(v);
+                    if (s)
+                        printf(spec, s);
+                    else
+                        printf("<0x%llx>", (unsigned long long)v);
+                    break;
+                }
+
+                case 'p':
+                    printf("0x%llx", (unsigned long long)v);
+                    break;
+
+                case 'c':
+                    printf(spec, (int)v);
+                    break;
+
+                case 'd': case 'i':
+                    if (len)
+                        printf(spec, (long long)v);
+                    else
+                        printf(spec, (int)v);
+                    break;
+
+                case 'o': case 'u': case 'x': case 'X':
+                    if (len)
+                        printf(spec, (unsigned long long)v);
+                    else
+                        printf(spec, (unsigned int)v);
+                    break;
+
+                default:                    /* ָ֧ */
+                    printf("<%s?>", spec);
+                    break;
+            }
+        }
+
+        fmt++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+typedef struct
+{
+    uint64_t seq;
+    uint64_t stamp;
+    uint64_t fmt;
+    uint64_t arg[TRACE_MAX_ARGS];
+} record_t;
+
+static int cmp_record(const void *a, const void *b)
+{
+    const record_t *ra = a, *rb = b;
+    return (ra->seq > rb->seq) - (ra->seq < rb->seq);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned char *dump, *bin;
+    size_t dump_size, bin_size;
+    uint32_t records, rec_size, count_1us;
+    uint64_t head;
+    record_t *recs;
+    int i, n = 0;
+
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <elf file> <trace dump>\n", argv[0]);
+        return 1;
+    }
+
+    if (elf_load(argv[1]) != 0)
+    {
+        return 1;
+    }
+
+    dump = load_file(argv[2], &dump_size);
+    if (dump == NULL)
+    {
+        return 1;
+    }
+
+    if ((dump_size >= 4) && (rd32(dump) == TRACE_MAGIC))
+    {
+        bin = dump;
+        bin_size = dump_size;
+    }
+    else
+    {
+        bin = parse_text_dump(dump, &bin_size);
+    }
+
+    if ((bin == NULL) || (bin_size < TRACE_HDR_SIZE) || (rd32(bin) != TRACE_MAGIC))
+    {
+        fprintf(stderr, "%s: no trace buffer found\n", argv[2]);
+        return 1;
+    }
+
+    records   = rd32(bin + 4);
+    rec_size  = rd32(bin + 8);
+    count_1us = rd32(bin + 12);
+    head      = rd64(bin + 16);
+
+    if ((rec_size < sizeof(record_t)) || (count_1us == 0))
+    {
+        fprintf(stderr, "%s: bad trace header\n", argv[2]);
+        return 1;
+    }
+
+    if (TRACE_HDR_SIZE + (uint64_t)records * rec_size > bin_size)
+    {
+        records = (uint32_t)((bin_size - TRACE_HDR_SIZE) / rec_size);
+    }
+
+    recs = calloc(records ? records : 1, sizeof(record_t));
+
+    for (i = 0; i < (int)records; i++)
+    {
+        const unsigned char *p = bin + TRACE_HDR_SIZE + (uint64_t)i * rec_size;
+        record_t *r = &recs[n];
+        int k;
+
+        r->seq = rd64(p);
+        if ((r->seq == 0) || (r->seq > head))
+        {
+            continue;                       /* Чд */
+        }
+
+        r->stamp = rd64(p + 8);
+        r->fmt   = rd64(p + 16);
+        for (k = 0; k < TRACE_MAX_ARGS; k++)
+        {
+            r->arg[k] = rd64(p + 24 + k * 8);
+        }
+
+        n++;
+    }
+
+    qsort(recs, n, sizeof(record_t), cmp_record);
+
+    if ((n > 0) && (recs[0].seq > 1))
+    {
+        printf("[%llu earlier records overwritten]\n", (unsigned long long)(recs[0].seq - 1));
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        uint64_t us = recs[i].stamp / count_1us;
+        const char *fmt = elf_string(recs[i].fmt);
+
+        printf("<%5llu.%06llu> ", (unsigned long long)(us / 1000000), (unsigned long long)(us % 1000000));
+
+        if (fmt)
+            print_record(fmt, recs[i].arg);
+        else
+            printf("<fmt 0x%llx>", (unsigned long long)recs[i].fmt);
+
+        putchar('\n');
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+/*
+ * @@ End
+ */
+
@@ -134,6 +134,7 @@ extern unsigned apb_frequency;
 
 #if BSP_USE_GMAC
 #define USE_LWIP        1
+#define GMAC_RX_DESC_NUM    32          /* rx descriptors of each GMAC */
 #endif
 
 /**
@@ -186,6 +187,13 @@ extern unsigned apb_frequency;
  */
 #define BSP_USE_SHELL   0
 
+#else
+
+/*
+ * Heap of memory_man.c: 1 = TLSF, 0 = first-fit
+ */
+#define HEAP_USE_TLSF   1
+
 #endif // #if BSP_USE_FS
 
 //*****************************************************************************
@@ -194,6 +202,7 @@ extern unsigned apb_frequency;
 //-----------------------------------------------------------------------------
 
 extern void printk(const char *fmt, ...);
+extern int printk_start_drain_task(void);     /* printk() ɵȼ */
 
 extern void print_hex(char *p, int size);
 
@@ -15,7 +15,7 @@
 
 #include "osal.h"
 
-#define SYS_MBOX_NULL   	(osal_mq_t)NULL
+#define SYS_MBOX_NULL   	(sys_mbox_t)NULL
 #define SYS_SEM_NULL    	(osal_sem_t)NULL
 
 #define SYS_MBOX_SIZE       sizeof(size_t)
@@ -26,7 +26,7 @@
 
 typedef osal_sem_t      	sys_sem_t;
 typedef osal_mutex_t    	sys_mutex_t;
-typedef osal_mq_t       	sys_mbox_t;
+typedef struct sys_mbox *	sys_mbox_t;       /* see sys_arch.c */
 typedef osal_task_t     	sys_thread_t;
 
 #endif /* __ARCH_SYS_ARCH_H__ */
@@ -40,6 +40,13 @@
 
 #include "bsp.h"
 
+/*
+ *  port İ汾. sys_mbox_t, struct netif  memp شС lwipopts.h 仯,
+ * port Դ lwipopts.h һ; ls2k-share е liblwip213.a 
+ * lwip-2.1.3 ͷļҲͬһ汾 port .
+ */
+#define LS2K_LWIP_PORT_VERSION          2
+
 //-----------------------------------------------------------------------------
 // Thread Support
 //-----------------------------------------------------------------------------
@@ -100,6 +107,20 @@
  */
 #define DEFAULT_THREAD_PRIO             8
 
+/**
+ * LWIP_TCPIP_CORE_LOCKING: lwIP API calls take the core lock and run in the
+ * caller's thread instead of posting a message to the tcpip thread.
+ */
+#define LWIP_TCPIP_CORE_LOCKING         1
+
+/**
+ * LWIP_TCPIP_CORE_LOCKING_INPUT: the GMAC receive task takes the core lock
+ * and passes received frames to netif->input itself, a whole batch under one
+ * lock, instead of posting each frame to the tcpip thread mailbox.
+ * See ls2k_ethernetif.c.
+ */
+#define LWIP_TCPIP_CORE_LOCKING_INPUT   (BSP_USE_OS)
+
 //-----------------------------------------------------------------------------
 
 /**
@@ -180,6 +201,16 @@
  */
 #define TCP_MSS                 		(1500 - 40)
 
+/**
+ * MEMP_NUM_TCP_PCB: the number of simultaneously active TCP connections.
+ * MEMP_NUM_NETCONN: the number of struct netconns, one per socket.
+ * lwIP defaults to 5 and 4, too few for a server with several clients, e.g.
+ * the Modbus/TCP server (modbus/port/mb_tcp.c, MODBUS_CFG_TCP_CONN_MAX).
+ * The socket numbers also size fd_set for select().
+ */
+#define MEMP_NUM_TCP_PCB                16
+#define MEMP_NUM_NETCONN                (MEMP_NUM_TCP_PCB + 4)
+
 /**
  * LWIP_UDP==1: Turn on UDP.
  */
@@ -243,6 +274,13 @@
  */
 #define LWIP_NETCONN                    (BSP_USE_OS)
 
+/**
+ * LWIP_CHECKSUM_CTRL_PER_NETIF==1: Checksum generation/check can be enabled/disabled
+ * per netif. The GMAC netif turns off the IPv4/TCP/UDP/ICMP software checksums
+ * when the hardware checksum offload engine is enabled, see ethernetif_set_hw_checksum().
+ */
+#define LWIP_CHECKSUM_CTRL_PER_NETIF    1
+
 /**
  *  #define LWIP_DEBUG: Enable LWIP Debug
  */